@@ -2,15 +2,28 @@
 #define IDENTIFIER_AND_TIME_SORTED_CONTAINER_H
 
 #include "entry_container.h"
+#include "interned_identifier_index.h"
 #include <algorithm>
+#include <atomic>
+#include <deque>
 #include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 namespace containers
 {
 
 /**
  * A container class for storing and retrieving entries sorted first by an associated identifier and then by
- * time
+ * time. Identifiers may be interned via internEntryId(), after which the entries associated with an identifier
+ * can be retrieved through the interned handle by way of a hash index, without constructing or comparing
+ * identifiers. The index is maintained only by the non-const member functions of this class, so that look-ups
+ * through interned handles are read-only; the entries of identifiers which have not yet been indexed, such as
+ * those interned after their entries were added, are found by searching the entry map until the container is
+ * next modified. Once the series of entries associated with an identifier holds the maximum number of entries,
+ * entries which arrive in increasing order of time overwrite the oldest entry of the series in place, so that
+ * the series is stored in a circular buffer and both the append and the eviction take constant time
  */
 template<typename EntryType,
          typename IdType = std::size_t,
@@ -96,6 +109,8 @@ public:
      * Constructor
      */
     IdentifierAndTimeSortedContainer(void)
+    : m_bIndexStale(false),
+      m_numIndexedInternedEntryIds(0)
     {
 
     }
@@ -104,6 +119,8 @@ public:
      * Copy constructor
      */
     IdentifierAndTimeSortedContainer(const tIdentifierAndTimeSortedContainer &container)
+    : m_bIndexStale(false),
+      m_numIndexedInternedEntryIds(0)
     {
         operator = (container);
     }
@@ -112,6 +129,8 @@ public:
      * Move constructor
      */
     IdentifierAndTimeSortedContainer(tIdentifierAndTimeSortedContainer &&container)
+    : m_bIndexStale(false),
+      m_numIndexedInternedEntryIds(0)
     {
         operator = (std::move(container));
     }
@@ -164,7 +183,29 @@ public:
         {
             auto time = (pEntry->*getTime)();
             auto entryId = (pEntry->*getEntryId)();
-            auto &&entries = m_entries[entryId];
+            auto &&entries = getOrCreateEntries(entryId);
+            if (isAppendable(entries, time))
+            {
+                if (entries.size() == this->getMaxSize())
+                {
+                    // overwrite the oldest entry
+                    auto &&head = m_heads[&entries];
+                    destroyEntry(entries[head]);
+                    entries[head] = pEntry;
+                    if (++head == entries.size())
+                        m_heads.erase(&entries);
+                }
+                else
+                {
+                    linearize(entries);
+                    entries.push_back(pEntry);
+                    evictOldestEntries(entries);
+                }
+
+                return bSuccess;
+            }
+
+            linearize(entries);
             auto &&itEntry = std::lower_bound(entries.cbegin(),
                                               entries.cend(),
                                               time,
@@ -191,8 +232,9 @@ public:
             }
 
             entries.insert(itEntry, pEntry);
-            while (entries.size() > this->getMaxSize())
-                deleteEntry(entries.front());
+            evictOldestEntries(entries);
+            if (entries.empty())
+                eraseEntries(m_entries.find(entryId));
         }
 
         return bSuccess;
@@ -205,7 +247,33 @@ public:
     {
         auto time = (entry.*getTime)();
         auto entryId = (entry.*getEntryId)();
-        auto &&entries = m_entries[entryId];
+        auto &&entries = getOrCreateEntries(entryId);
+        if (isAppendable(entries, time))
+        {
+            if (entries.size() == this->getMaxSize())
+            {
+                // recycle the oldest entry
+                auto &&head = m_heads[&entries];
+                auto *pEntry = entries[head];
+                if (pEntry != nullptr)
+                    *pEntry = entry;
+                else
+                    entries[head] = (entry.*clone)();
+
+                if (++head == entries.size())
+                    m_heads.erase(&entries);
+            }
+            else
+            {
+                linearize(entries);
+                entries.push_back((entry.*clone)());
+                evictOldestEntries(entries);
+            }
+
+            return;
+        }
+
+        linearize(entries);
         auto &&itEntry = std::lower_bound(entries.cbegin(),
                                           entries.cend(),
                                           time,
@@ -217,32 +285,10 @@ public:
 
         if (pEntry == nullptr || (pEntry->*getTime)() != time)
         {
-            if (entries.size() >= this->getMaxSize())
-            {
-                if (itEntry == entries.cend())
-                {
-                    // perform a simple rotation and assign the current entry to the back
-                    std::rotate(entries.begin(),
-                                entries.begin() + 1,
-                                entries.end());
-
-                    pEntry = entries.back();
-                    if (pEntry != nullptr)
-                        *pEntry = entry;
-                }
-                else
-                {
-                    entries.emplace(itEntry, (entry.*clone)());
-                    while (entries.size() > this->getMaxSize())
-                    {
-                        deleteEntry(entries.front());
-                    }
-                }
-            }
-            else
-            {
-                entries.emplace(itEntry, (entry.*clone)());
-            }
+            entries.emplace(itEntry, (entry.*clone)());
+            evictOldestEntries(entries);
+            if (entries.empty())
+                eraseEntries(m_entries.find(entryId));
         }
         else if (pEntry != nullptr)
         {
@@ -260,19 +306,17 @@ public:
         // delete this object's current entries before cloning
         deleteEntries();
 
-        // clone or copy entries from the input container
+        // clone or copy entries from the input container, oldest first
         auto &&itEntries = container.m_entries.cbegin();
         while (itEntries != container.m_entries.cend())
         {
             auto &&entries = itEntries->second;
-            auto &&itEntry = entries.cbegin();
-            while (itEntry != entries.cend())
+            auto head = container.getHead(entries);
+            for (std::size_t i = 0; i < entries.size(); ++i)
             {
-                auto *pEntry = *itEntry;
+                auto *pEntry = getEntryAt(entries, head, i);
                 if (pEntry != nullptr)
                     addEntry(*pEntry);
-
-                ++itEntry;
             }
 
             ++itEntries;
@@ -287,13 +331,18 @@ public:
         auto &&itEntries = m_entries.find(entryId);
         if (itEntries != m_entries.cend())
         {
-            auto &&entries = itEntries->second;
-            while (!entries.empty())
+            for (auto *pEntry : itEntries->second)
             {
-                deleteEntry(entries.front());
+                if (pEntry != nullptr)
+                {
+                    if (deleter == nullptr)
+                        delete pEntry;
+                    else
+                        (*deleter)(pEntry);
+                }
             }
 
-            m_entries.erase(itEntries);
+            eraseEntries(itEntries);
         }
     }
 
@@ -326,6 +375,7 @@ public:
         if (itEntries != m_entries.cend())
         {
             auto &&entries = itEntries->second;
+            linearize(entries);
             auto &&itEntry = std::lower_bound(entries.cbegin(),
                                               entries.cend(),
                                               startTime,
@@ -363,7 +413,7 @@ public:
             }
 
             if (entries.empty())
-                itEntries = m_entries.erase(itEntries);
+                itEntries = eraseEntries(itEntries);
         }
 
         return itEntries;
@@ -428,6 +478,9 @@ public:
         }
 
         m_entries.clear();
+        m_heads.clear();
+        m_index.clear();
+        m_bIndexStale = false;
     }
 
     /**
@@ -443,6 +496,7 @@ public:
             if (itEntries != m_entries.cend())
             {
                 auto &&entries = itEntries->second;
+                linearize(entries);
                 auto &&itEntry = std::find(entries.cbegin(),
                                            entries.cend(),
                                            pEntry);
@@ -457,7 +511,7 @@ public:
                     pEntry = nullptr;
                     entries.erase(itEntry);
                     if (entries.empty())
-                        m_entries.erase(itEntries);
+                        eraseEntries(itEntries);
                 }
             }
         }
@@ -490,11 +544,7 @@ public:
     {
         auto &&itEntries = m_entries.find(entryId);
         if (itEntries != m_entries.cend())
-        {
-            entries.insert(entries.cend(),
-                           itEntries->second.cbegin(),
-                           itEntries->second.cend());
-        }
+            appendSeries(itEntries->second, entries);
     }
 
     /**
@@ -526,39 +576,24 @@ public:
         auto &&itEntries = m_entries.find(entryId);
         bool bSuccess = (itEntries != m_entries.cend());
         if (bSuccess)
-        {
-            auto &&itEntry = std::lower_bound(itEntries->second.cbegin(),
-                                              itEntries->second.cend(),
-                                              startTime,
-                                              m_comparator);
-            auto &&itEntryEnd = std::upper_bound(itEntry,
-                                                 itEntries->second.cend(),
-                                                 endTime,
-                                                 m_comparator);
-            if (itEntryEnd == itEntry)
-                itEntryEnd = itEntries->second.cend();
+            bSuccess = findEntries(itEntries->second, startTime, endTime, entries);
 
-            bSuccess = (itEntry != itEntryEnd);
-            if (bSuccess)
-            {
-                while (bSuccess && itEntry != itEntryEnd)
-                {
-                    auto *pEntry = *itEntry;
-                    bSuccess = (pEntry != nullptr);
-                    if (bSuccess)
-                    {
-                        auto time = (pEntry->*getTime)();
-                        if (time >= startTime &&
-                            time <= endTime)
-                        {
-                            entries.push_back(pEntry);
-                        }
-                    }
+        return bSuccess;
+    }
 
-                    ++itEntry;
-                }
-            }
-        }
+    /**
+     * Retrieve all entries associated with the specified interned entry id tagged between the specified
+     * starting and ending times; upon success, returns true and entries are appended to input argument
+     */
+    virtual bool getEntries(const InternedIdentifier &entryId,
+                            TimeType startTime,
+                            TimeType endTime,
+                            std::vector<EntryType *> &entries) const final
+    {
+        auto *pEntries = findEntries(entryId);
+        bool bSuccess = (pEntries != nullptr);
+        if (bSuccess)
+            bSuccess = findEntries(*pEntries, startTime, endTime, entries);
 
         return bSuccess;
     }
@@ -568,6 +603,16 @@ public:
      */
     inline virtual std::map<IdType, std::vector<EntryType *>> &getEntries(void) final
     {
+        // the map may be modified through the returned reference, so the hash index is discarded and look-ups
+        // search the entry map until the index is rebuilt by the next modification of this container, after
+        // which the returned reference must no longer be used to modify the map; each series is first restored
+        // to contiguous order, oldest first
+        for (auto &&itEntries = m_entries.begin(); itEntries != m_entries.end(); ++itEntries)
+            linearize(itEntries->second);
+
+        m_index.clear();
+        m_bIndexStale = true;
+
         return m_entries;
     }
 
@@ -576,7 +621,11 @@ public:
      */
     inline virtual std::map<IdType, std::vector<EntryType *>> getEntries(void) const final
     {
-        return m_entries;
+        std::map<IdType, std::vector<EntryType *>> entries;
+        for (auto &&itEntries = m_entries.cbegin(); itEntries != m_entries.cend(); ++itEntries)
+            appendSeries(itEntries->second, entries[itEntries->first]);
+
+        return entries;
     }
 
     /**
@@ -586,21 +635,22 @@ public:
                                 TimeType time) const final
     {
         auto &&itEntries = m_entries.find(entryId);
-        bool bSuccess = (itEntries != m_entries.cend());
-        if (bSuccess)
-        {
-            auto &&entries = itEntries->second;
-            auto &&itEntry = std::lower_bound(entries.cbegin(),
-                                              entries.cend(),
-                                              time,
-                                              m_comparator);
-            if (itEntry != entries.cend())
-            {
-                auto *pEntry = *itEntry;
-                if (pEntry != nullptr && (pEntry->*getTime)() == time)
-                    return pEntry;
-            }
-        }
+        if (itEntries != m_entries.cend())
+            return findEntry(itEntries->second, time);
+
+        return nullptr;
+    }
+
+    /**
+     * Retrieve an entry tagged at the specified time with the given interned entry id; returns non-null upon
+     * success
+     */
+    virtual EntryType *getEntry(const InternedIdentifier &entryId,
+                                TimeType time) const final
+    {
+        auto *pEntries = findEntries(entryId);
+        if (pEntries != nullptr)
+            return findEntry(*pEntries, time);
 
         return nullptr;
     }
@@ -629,11 +679,19 @@ public:
     {
         auto &&itEntries = m_entries.find(entryId);
         if (itEntries != m_entries.cend())
-        {
-            auto &&entries = itEntries->second;
-            if (!entries.empty())
-                return entries.back();
-        }
+            return findLatestEntry(itEntries->second);
+
+        return nullptr;
+    }
+
+    /**
+     * Retrieve the latest entry associated with the specified interned entry id; returns non-null upon success
+     */
+    virtual EntryType *getLatestEntry(const InternedIdentifier &entryId) const final
+    {
+        auto *pEntries = findEntries(entryId);
+        if (pEntries != nullptr)
+            return findLatestEntry(*pEntries);
 
         return nullptr;
     }
@@ -666,29 +724,56 @@ public:
     {
         auto &&itEntries = m_entries.find(entryId);
         if (itEntries != m_entries.cend())
+            return findMostRecentAvailableEntry(itEntries->second, time);
+
+        return nullptr;
+    }
+
+    /**
+     * Retrieve the most recently available entry associated with the specified interned entry id; returns
+     * non-null upon success
+     */
+    virtual EntryType *getMostRecentAvailableEntry(const InternedIdentifier &entryId,
+                                                   double time) const final
+    {
+        auto *pEntries = findEntries(entryId);
+        if (pEntries != nullptr)
+            return findMostRecentAvailableEntry(*pEntries, time);
+
+        return nullptr;
+    }
+
+    /**
+     * Get the number of entry ids whose entries are held in this container's hash index
+     */
+    inline virtual std::size_t getNumIndexedEntryIds(void) const final
+    {
+        return m_index.size();
+    }
+
+    /**
+     * Intern an entry id; the returned handle remains valid for the lifetime of the program and may be used
+     * with any instance of this container type
+     */
+    static InternedIdentifier internEntryId(const IdType &entryId)
+    {
+        InternedIdentifier internedEntryId;
+        if (!findInternedEntryId(entryId, internedEntryId))
         {
-            auto &&entries = itEntries->second;
-            if (!entries.empty())
+            auto &&registry = getInternedEntryIdRegistry();
+            std::lock_guard<std::shared_mutex> lock(registry.m_mutex);
+            auto &&itIndex = registry.m_indices.find(entryId);
+            if (itIndex == registry.m_indices.cend())
             {
-                auto &&itEntry = std::lower_bound(entries.cbegin(),
-                                                  entries.cend(),
-                                                  time,
-                                                  m_comparator);
-                if (itEntry == entries.cend())
-                    --itEntry;
-
-                for (;; --itEntry)
-                {
-                    auto *pEntry = *itEntry;
-                    if (pEntry != nullptr && (pEntry->*getTime)() <= time)
-                        return pEntry;
-                    else if (itEntry == entries.cbegin())
-                        break;
-                }
+                itIndex = registry.m_indices.emplace(entryId, registry.m_entryIds.size()).first;
+                registry.m_entryIds.push_back(entryId);
+                registry.m_numEntryIds.store(registry.m_entryIds.size(), std::memory_order_release);
             }
+
+            internedEntryId = InternedIdentifier(itIndex->second);
         }
 
-        return nullptr;
+        return internedEntryId;
     }
 
     /**
@@ -698,15 +783,7 @@ public:
     {
         auto &&itEntries = m_entries.find(entryId);
         if (itEntries != m_entries.cend())
-        {
-            auto &&entries = itEntries->second;
-            while (!entries.empty())
-            {
-                removeEntry(entries.front());
-            }
-
-            m_entries.erase(itEntries);
-        }
+            eraseEntries(itEntries);
     }
 
     /**
@@ -738,6 +815,7 @@ public:
         if (itEntries != m_entries.cend())
         {
             auto &&entries = itEntries->second;
+            linearize(entries);
             auto &&itEntry = std::lower_bound(entries.cbegin(),
                                               entries.cend(),
                                               startTime,
@@ -767,7 +845,7 @@ public:
             }
 
             if (entries.empty())
-                itEntries = m_entries.erase(itEntries);
+                itEntries = eraseEntries(itEntries);
         }
 
         return itEntries;
@@ -779,6 +857,9 @@ public:
     inline virtual void removeEntries(void) override
     {
         m_entries.clear();
+        m_heads.clear();
+        m_index.clear();
+        m_bIndexStale = false;
     }
 
     /**
@@ -794,6 +875,7 @@ public:
             if (itEntries != m_entries.cend())
             {
                 auto &&entries = itEntries->second;
+                linearize(entries);
                 auto &&itEntry = std::find(entries.cbegin(),
                                            entries.cend(),
                                            pEntry);
@@ -802,7 +884,7 @@ public:
                 {
                     entries.erase(itEntry);
                     if (entries.empty())
-                        m_entries.erase(itEntries);
+                        eraseEntries(itEntries);
                 }
             }
         }
@@ -838,6 +920,18 @@ public:
         return 0;
     }
 
+    /**
+     * Return the number of entries associated with the given interned entry id contained within this object
+     */
+    virtual std::size_t size(const InternedIdentifier &entryId) const
+    {
+        auto *pEntries = findEntries(entryId);
+        if (pEntries != nullptr)
+            return pEntries->size();
+
+        return 0;
+    }
+
     /**
      * Swap function
      */
@@ -845,21 +939,456 @@ public:
     {
         EntryContainer<EntryType>::swap(container);
 
+        std::swap(m_bIndexStale, container.m_bIndexStale);
         std::swap(m_comparator, container.m_comparator);
         m_entries.swap(container.m_entries);
+        m_heads.swap(container.m_heads);
+        m_index.swap(container.m_index);
+        std::swap(m_numIndexedInternedEntryIds, container.m_numIndexedInternedEntryIds);
     }
 
 protected:
 
+    /**
+     * A registry of interned entry ids
+     */
+    struct InternedEntryIdRegistry
+    {
+        /**
+         * the interned entry ids, in the order in which they were interned
+         */
+        std::deque<IdType> m_entryIds;
+
+        /**
+         * a map of interned entry ids to their indices
+         */
+        std::map<IdType, std::size_t> m_indices;
+
+        /**
+         * mutex which serializes interning with respect to look-ups, which may proceed concurrently
+         */
+        std::shared_mutex m_mutex;
+
+        /**
+         * the number of interned entry ids, readable without acquiring the mutex
+         */
+        std::atomic<std::size_t> m_numEntryIds{0};
+    };
+
+    /**
+     * Append a series of entries to the input argument, oldest first
+     */
+    void appendSeries(const std::vector<EntryType *> &series,
+                      std::vector<EntryType *> &entries) const
+    {
+        auto head = getHead(series);
+        entries.insert(entries.cend(), series.cbegin() + head, series.cend());
+        entries.insert(entries.cend(), series.cbegin(), series.cbegin() + head);
+    }
+
+    /**
+     * Destroy an entry
+     */
+    inline static void destroyEntry(EntryType *pEntry)
+    {
+        if (pEntry != nullptr)
+        {
+            if (deleter == nullptr)
+                delete pEntry;
+            else
+                (*deleter)(pEntry);
+        }
+    }
+
+    /**
+     * Erase the entries associated with an entry id from the entry map, removing them from the hash index;
+     * returns an iterator to the element which follows those erased
+     */
+    typename std::map<IdType, std::vector<EntryType *>>::iterator
+    eraseEntries(typename std::map<IdType, std::vector<EntryType *>>::iterator itEntries)
+    {
+        InternedIdentifier internedEntryId;
+        if (!m_bIndexStale && m_index.size() > 0 && findInternedEntryId(itEntries->first, internedEntryId))
+            m_index.erase(internedEntryId);
+
+        m_heads.erase(&itEntries->second);
+
+        return m_entries.erase(itEntries);
+    }
+
+    /**
+     * Delete the oldest entries of a series in excess of the maximum size of this container
+     */
+    void evictOldestEntries(std::vector<EntryType *> &entries)
+    {
+        if (entries.size() > this->getMaxSize())
+        {
+            auto &&itEntryEnd = entries.begin() + (entries.size() - this->getMaxSize());
+            std::for_each(entries.begin(), itEntryEnd, &destroyEntry);
+            entries.erase(entries.begin(), itEntryEnd);
+        }
+    }
+
+    /**
+     * Retrieve the entries tagged at the specified time from a series of entries sorted by time; returns
+     * non-null upon success
+     */
+    EntryType *findEntry(const std::vector<EntryType *> &entries,
+                         TimeType time) const
+    {
+        auto head = getHead(entries);
+        auto &&index = lowerBound(entries, head, time);
+        if (index != entries.size())
+        {
+            auto *pEntry = getEntryAt(entries, head, index);
+            if (pEntry != nullptr && (pEntry->*getTime)() == time)
+                return pEntry;
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * Retrieve the entries tagged between the specified starting and ending times from a series of entries
+     * sorted by time; upon success, returns true and entries are appended to input argument
+     */
+    bool findEntries(const std::vector<EntryType *> &series,
+                     TimeType startTime,
+                     TimeType endTime,
+                     std::vector<EntryType *> &entries) const
+    {
+        auto head = getHead(series);
+        auto &&index = lowerBound(series, head, startTime);
+        auto &&indexEnd = upperBound(series, head, endTime, index);
+        if (indexEnd == index)
+            indexEnd = series.size();
+
+        bool bSuccess = (index != indexEnd);
+        if (bSuccess)
+        {
+            while (bSuccess && index != indexEnd)
+            {
+                auto *pEntry = getEntryAt(series, head, index);
+                bSuccess = (pEntry != nullptr);
+                if (bSuccess)
+                {
+                    auto time = (pEntry->*getTime)();
+                    if (time >= startTime &&
+                        time <= endTime)
+                    {
+                        entries.push_back(pEntry);
+                    }
+                }
+
+                ++index;
+            }
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Retrieve the series of entries associated with the specified interned entry id; returns non-null upon
+     * success
+     */
+    const std::vector<EntryType *> *findEntries(const InternedIdentifier &entryId) const
+    {
+        // the index holds the series of every id interned before it was last updated, so a miss for such an id
+        // is definitive
+        const std::vector<EntryType *> *pEntries = nullptr;
+        bool bIndexed = false;
+        if (!m_bIndexStale)
+        {
+            pEntries = m_index.find(entryId);
+            bIndexed = entryId.getIndex() < m_numIndexedInternedEntryIds;
+        }
+
+        if (pEntries == nullptr && !bIndexed)
+        {
+            // fall back to a search of the entry map by id, which finds the entries of ids that have not yet
+            // been indexed
+            auto *pEntryId = getInternedEntryId(entryId);
+            if (pEntryId != nullptr)
+            {
+                auto &&itEntries = m_entries.find(*pEntryId);
+                if (itEntries != m_entries.cend())
+                    pEntries = &itEntries->second;
+            }
+        }
+
+        return pEntries;
+    }
+
+    /**
+     * Retrieve the latest entry from a series of entries sorted by time; returns non-null upon success
+     */
+    EntryType *findLatestEntry(const std::vector<EntryType *> &entries) const
+    {
+        if (!entries.empty())
+            return getEntryAt(entries, getHead(entries), entries.size() - 1);
+
+        return nullptr;
+    }
+
+    /**
+     * Retrieve the most recently available entry from a series of entries sorted by time; returns non-null
+     * upon success
+     */
+    EntryType *findMostRecentAvailableEntry(const std::vector<EntryType *> &entries,
+                                            double time) const
+    {
+        if (!entries.empty())
+        {
+            auto head = getHead(entries);
+            auto &&index = lowerBound(entries, head, time);
+            if (index == entries.size())
+                --index;
+
+            for (;; --index)
+            {
+                auto *pEntry = getEntryAt(entries, head, index);
+                if (pEntry != nullptr && (pEntry->*getTime)() <= time)
+                    return pEntry;
+                else if (index == 0)
+                    break;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * Retrieve the entry of a series at the specified index, counted from the oldest entry
+     * @param head the index within the series of its oldest entry
+     */
+    inline static EntryType *getEntryAt(const std::vector<EntryType *> &entries,
+                                        std::size_t head,
+                                        std::size_t index)
+    {
+        index += head;
+        if (index >= entries.size())
+            index -= entries.size();
+
+        return entries[index];
+    }
+
+    /**
+     * Get the index within a series of its oldest entry
+     */
+    inline std::size_t getHead(const std::vector<EntryType *> &entries) const
+    {
+        if (!m_heads.empty())
+        {
+            auto &&itHead = m_heads.find(&entries);
+            if (itHead != m_heads.cend())
+                return itHead->second;
+        }
+
+        return 0;
+    }
+
+    /**
+     * Retrieve the entry id associated with an interned handle; returns null if the handle is invalid
+     */
+    static const IdType *getInternedEntryId(const InternedIdentifier &entryId)
+    {
+        auto &&registry = getInternedEntryIdRegistry();
+        std::shared_lock<std::shared_mutex> lock(registry.m_mutex);
+        if (entryId.getIndex() < registry.m_entryIds.size())
+            return &registry.m_entryIds[entryId.getIndex()];
+
+        return nullptr;
+    }
+
+    /**
+     * Find the interned handle of an entry id without interning it; returns true if the entry id has been
+     * interned
+     */
+    static bool findInternedEntryId(const IdType &entryId,
+                                    InternedIdentifier &internedEntryId)
+    {
+        auto &&registry = getInternedEntryIdRegistry();
+        std::shared_lock<std::shared_mutex> lock(registry.m_mutex);
+        auto &&itIndex = registry.m_indices.find(entryId);
+        bool bSuccess = (itIndex != registry.m_indices.cend());
+        if (bSuccess)
+            internedEntryId = InternedIdentifier(itIndex->second);
+
+        return bSuccess;
+    }
+
+    /**
+     * Get the registry of interned entry ids
+     */
+    static InternedEntryIdRegistry &getInternedEntryIdRegistry(void)
+    {
+        static InternedEntryIdRegistry registry;
+
+        return registry;
+    }
+
+    /**
+     * Retrieve the series of entries associated with the specified entry id, creating an empty series if none
+     * exists; the hash index is first brought up to date, and a new series is indexed only if its entry id has
+     * been interned
+     */
+    std::vector<EntryType *> &getOrCreateEntries(const IdType &entryId)
+    {
+        updateIndex();
+
+        auto &&result = m_entries.emplace(entryId, std::vector<EntryType *>());
+        InternedIdentifier internedEntryId;
+        if (result.second && findInternedEntryId(entryId, internedEntryId))
+            m_index.insert(internedEntryId, &result.first->second);
+
+        return result.first->second;
+    }
+
+    /**
+     * Determines whether or not an entry tagged at the specified time follows all of the entries of a series
+     */
+    inline bool isAppendable(const std::vector<EntryType *> &entries,
+                             TimeType time) const
+    {
+        if (entries.empty())
+            return this->getMaxSize() > 0;
+
+        auto *pEntry = getEntryAt(entries, getHead(entries), entries.size() - 1);
+
+        return pEntry != nullptr && (pEntry->*getTime)() < time;
+    }
+
+    /**
+     * Restore a series of entries to contiguous order, oldest first
+     */
+    inline void linearize(std::vector<EntryType *> &entries)
+    {
+        if (!m_heads.empty())
+        {
+            auto &&itHead = m_heads.find(&entries);
+            if (itHead != m_heads.end())
+            {
+                std::rotate(entries.begin(),
+                            entries.begin() + itHead->second,
+                            entries.end());
+                m_heads.erase(itHead);
+            }
+        }
+    }
+
+    /**
+     * Find the index, counted from the oldest entry, of the first entry of a series not tagged before the
+     * specified time
+     * @param head the index within the series of its oldest entry
+     */
+    std::size_t lowerBound(const std::vector<EntryType *> &entries,
+                           std::size_t head,
+                           TimeType time) const
+    {
+        std::size_t index = 0, count = entries.size();
+        while (count > 0)
+        {
+            auto step = count / 2;
+            if (m_comparator(getEntryAt(entries, head, index + step), time))
+            {
+                index += step + 1;
+                count -= step + 1;
+            }
+            else
+                count = step;
+        }
+
+        return index;
+    }
+
+    /**
+     * Find the index, counted from the oldest entry, of the first entry of a series tagged after the specified
+     * time, searching from the specified index
+     * @param head the index within the series of its oldest entry
+     */
+    std::size_t upperBound(const std::vector<EntryType *> &entries,
+                           std::size_t head,
+                           TimeType time,
+                           std::size_t index) const
+    {
+        std::size_t count = entries.size() - index;
+        while (count > 0)
+        {
+            auto step = count / 2;
+            if (!m_comparator(time, getEntryAt(entries, head, index + step)))
+            {
+                index += step + 1;
+                count -= step + 1;
+            }
+            else
+                count = step;
+        }
+
+        return index;
+    }
+
+    /**
+     * Bring the hash index up to date with the entry map; the index is rebuilt if the entry map has been exposed
+     * for modification, and otherwise the series of entry ids interned since the index was last updated are
+     * indexed
+     */
+    void updateIndex(void)
+    {
+        auto &&registry = getInternedEntryIdRegistry();
+        if (m_bIndexStale ||
+            registry.m_numEntryIds.load(std::memory_order_acquire) != m_numIndexedInternedEntryIds)
+        {
+            std::shared_lock<std::shared_mutex> lock(registry.m_mutex);
+            if (m_bIndexStale)
+            {
+                m_index.clear();
+                m_numIndexedInternedEntryIds = 0;
+            }
+
+            for (auto i = m_numIndexedInternedEntryIds; i < registry.m_entryIds.size(); ++i)
+            {
+                auto &&itEntries = m_entries.find(registry.m_entryIds[i]);
+                if (itEntries != m_entries.end())
+                    m_index.insert(InternedIdentifier(i), &itEntries->second);
+            }
+
+            m_numIndexedInternedEntryIds = registry.m_entryIds.size();
+            m_bIndexStale = false;
+        }
+    }
+
+    /**
+     * flag indicating that the entry map may have been modified externally, in which case the hash index is
+     * not used until it is rebuilt upon the next modification of this container
+     */
+    bool m_bIndexStale;
+
     /**
      * this object's entry comparator
      */
     EntryComparator m_comparator;
 
     /**
-     * this container's entries sorted first by entry id and then time
+     * this container's entries sorted first by entry id and then time; once a series has filled and begun to
+     * overwrite its oldest entries, its entries are stored circularly beginning at the index held in m_heads
      */
     std::map<IdType, std::vector<EntryType *>> m_entries;
+
+    /**
+     * the index of the oldest entry within each series whose storage has wrapped, keyed by the address of the
+     * series; series which are absent begin at index zero
+     */
+    std::unordered_map<const std::vector<EntryType *> *, std::size_t> m_heads;
+
+    /**
+     * a hash index of interned entry ids to this container's series of entries
+     */
+    InternedIdentifierIndex<std::vector<EntryType *> *> m_index;
+
+    /**
+     * the number of interned entry ids which have been considered for inclusion in the hash index
+     */
+    std::size_t m_numIndexedInternedEntryIds;
 };
 
 }
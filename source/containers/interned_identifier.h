@@ -0,0 +1,70 @@
+#ifndef INTERNED_IDENTIFIER_H
+#define INTERNED_IDENTIFIER_H
+
+#include <cstddef>
+#include <limits>
+
+namespace containers
+{
+
+/**
+ * A handle to an interned entry identifier; entries associated with an interned identifier can be retrieved
+ * from a container without constructing or comparing the identifier itself
+ */
+class InternedIdentifier final
+{
+public:
+
+    /**
+     * Constructor
+     * @param index the index assigned to the identifier when interned; a default-constructed handle is invalid
+     */
+    explicit InternedIdentifier(std::size_t index = std::numeric_limits<std::size_t>::max())
+    : m_index(index)
+    {
+
+    }
+
+    /**
+     * Equality operator
+     */
+    inline bool operator == (const InternedIdentifier &identifier) const
+    {
+        return m_index == identifier.m_index;
+    }
+
+    /**
+     * Inequality operator
+     */
+    inline bool operator != (const InternedIdentifier &identifier) const
+    {
+        return !operator == (identifier);
+    }
+
+    /**
+     * Get the index assigned to the identifier when interned
+     */
+    inline std::size_t getIndex(void) const
+    {
+        return m_index;
+    }
+
+    /**
+     * Query whether or not this handle refers to an interned identifier
+     */
+    inline bool isValid(void) const
+    {
+        return m_index != std::numeric_limits<std::size_t>::max();
+    }
+
+private:
+
+    /**
+     * the index assigned to the identifier when interned
+     */
+    std::size_t m_index;
+};
+
+}
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef INTERNED_IDENTIFIER_INDEX_H
+#define INTERNED_IDENTIFIER_INDEX_H
+
+#include "interned_identifier.h"
+#include "reflective.h"
+#include "swappable.h"
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace containers
+{
+
+/**
+ * An open-addressing hash table which maps interned identifiers to values; collisions are resolved by linear
+ * probing, and erasure shifts subsequent entries of a probe sequence backward rather than leaving tombstones
+ */
+template<typename ValueType>
+class InternedIdentifierIndex final
+: virtual private attributes::abstract::Reflective,
+  public attributes::interfaces::Swappable<InternedIdentifierIndex<ValueType>>
+{
+public:
+
+    /**
+     * Constructor
+     */
+    InternedIdentifierIndex(void)
+    : m_shift(std::numeric_limits<std::uint64_t>::digits),
+      m_size(0)
+    {
+
+    }
+
+    /**
+     * Copy constructor
+     */
+    InternedIdentifierIndex(const InternedIdentifierIndex<ValueType> &index) = default;
+
+    /**
+     * Move constructor
+     */
+    InternedIdentifierIndex(InternedIdentifierIndex<ValueType> &&index)
+    : m_shift(std::numeric_limits<std::uint64_t>::digits),
+      m_size(0)
+    {
+        index.swap(*this);
+    }
+
+    /**
+     * Destructor
+     */
+    virtual ~InternedIdentifierIndex(void) override
+    {
+
+    }
+
+    /**
+     * Copy assignment operator
+     */
+    InternedIdentifierIndex<ValueType> &operator = (const InternedIdentifierIndex<ValueType> &index) = default;
+
+    /**
+     * Move assignment operator
+     */
+    InternedIdentifierIndex<ValueType> &operator = (InternedIdentifierIndex<ValueType> &&index)
+    {
+        if (&index != this)
+        {
+            index.swap(*this);
+        }
+
+        return *this;
+    }
+
+    /**
+     * Remove all values from this index
+     */
+    void clear(void)
+    {
+        m_keys.clear();
+        m_shift = std::numeric_limits<std::uint64_t>::digits;
+        m_size = 0;
+        m_values.clear();
+    }
+
+    /**
+     * Remove the value associated with the specified identifier; returns true if a value was removed
+     */
+    bool erase(const InternedIdentifier &identifier)
+    {
+        auto slot = findSlot(identifier.getIndex());
+        bool bSuccess = (identifier.isValid() && slot < m_keys.size() && m_keys[slot] == identifier.getIndex());
+        if (bSuccess)
+        {
+            // shift subsequent members of the probe sequence back into the vacated slot, so that each remains
+            // reachable from its home slot
+            auto &&mask = m_keys.size() - 1;
+            for (auto next = (slot + 1) & mask; m_keys[next] != EMPTY; next = (next + 1) & mask)
+            {
+                auto &&home = getHomeSlot(m_keys[next]);
+                if (((next - home) & mask) >= ((next - slot) & mask))
+                {
+                    m_keys[slot] = m_keys[next];
+                    m_values[slot] = m_values[next];
+                    slot = next;
+                }
+            }
+
+            m_keys[slot] = EMPTY;
+            m_values[slot] = ValueType();
+            --m_size;
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Retrieve the value associated with the specified identifier; returns a value-initialized object if the
+     * identifier is not present
+     */
+    ValueType find(const InternedIdentifier &identifier) const
+    {
+        auto &&slot = findSlot(identifier.getIndex());
+        if (slot < m_keys.size() && m_keys[slot] == identifier.getIndex())
+            return m_values[slot];
+
+        return ValueType();
+    }
+
+    /**
+     * Get the name of this class
+     */
+    inline virtual std::string getClassName(void) const override
+    {
+        return "InternedIdentifierIndex";
+    }
+
+    /**
+     * Associate a value with the specified identifier, replacing any existing value
+     */
+    void insert(const InternedIdentifier &identifier,
+                const ValueType &value)
+    {
+        if (identifier.isValid())
+        {
+            // keep the load factor at or below one half
+            if (2 * (m_size + 1) > m_keys.size())
+                rehash(m_keys.empty() ? MINIMUM_CAPACITY : 2 * m_keys.size());
+
+            auto &&slot = findSlot(identifier.getIndex());
+            if (m_keys[slot] == EMPTY)
+            {
+                m_keys[slot] = identifier.getIndex();
+                ++m_size;
+            }
+
+            m_values[slot] = value;
+        }
+    }
+
+    /**
+     * Return the number of values in this index
+     */
+    inline std::size_t size(void) const
+    {
+        return m_size;
+    }
+
+    /**
+     * Swap function
+     */
+    virtual void swap(InternedIdentifierIndex<ValueType> &index) override final
+    {
+        m_keys.swap(index.m_keys);
+        std::swap(m_shift, index.m_shift);
+        std::swap(m_size, index.m_size);
+        m_values.swap(index.m_values);
+    }
+
+private:
+
+    /**
+     * Find the slot which contains the specified key or, if the key is not present, the empty slot which ends
+     * its probe sequence; returns the number of slots if this index has no storage
+     */
+    inline std::size_t findSlot(std::size_t key) const
+    {
+        if (m_keys.empty())
+            return 0;
+
+        auto &&mask = m_keys.size() - 1;
+        auto slot = getHomeSlot(key);
+        while (m_keys[slot] != EMPTY && m_keys[slot] != key)
+            slot = (slot + 1) & mask;
+
+        return slot;
+    }
+
+    /**
+     * Get the slot at which the probe sequence for the specified key begins (Fibonacci hashing)
+     */
+    inline std::size_t getHomeSlot(std::size_t key) const
+    {
+        return std::size_t((std::uint64_t(key) * UINT64_C(0x9e3779b97f4a7c15)) >> m_shift);
+    }
+
+    /**
+     * Resize this index to the specified number of slots, which must be a power of two
+     */
+    void rehash(std::size_t capacity)
+    {
+        std::vector<std::size_t> keys(capacity, EMPTY);
+        std::vector<ValueType> values(capacity);
+        keys.swap(m_keys);
+        values.swap(m_values);
+
+        m_shift = std::numeric_limits<std::uint64_t>::digits;
+        while (capacity > 1)
+        {
+            capacity >>= 1;
+            --m_shift;
+        }
+
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            if (keys[i] != EMPTY)
+            {
+                auto &&slot = findSlot(keys[i]);
+                m_keys[slot] = keys[i];
+                m_values[slot] = values[i];
+            }
+        }
+    }
+
+    /**
+     * the key which marks an empty slot
+     */
+    static constexpr std::size_t EMPTY = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * the number of slots allocated upon the first insertion
+     */
+    static constexpr std::size_t MINIMUM_CAPACITY = 8;
+
+    /**
+     * the interned identifier index stored in each slot
+     */
+    std::vector<std::size_t> m_keys;
+
+    /**
+     * the number of bits by which a hashed key is shifted to obtain its home slot
+     */
+    int m_shift;
+
+    /**
+     * the number of values in this index
+     */
+    std::size_t m_size;
+
+    /**
+     * the value stored in each slot
+     */
+    std::vector<ValueType> m_values;
+};
+
+}
+
+#endif
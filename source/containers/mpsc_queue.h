@@ -0,0 +1,243 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+
+namespace containers
+{
+
+/**
+ * This class implements a bounded, lock-free, multiple-producer/single-consumer queue backed by a ring buffer.
+ * Each slot in the ring carries a sequence number which producers and the consumer use to claim and publish
+ * the slot without locking, so any number of threads may call push() concurrently; pop() and drain() may only
+ * be called from a single consumer thread at a time. The capacity is rounded up to a power of two. Values
+ * popped from the queue are moved out of their slots, so resources held by a value (e.g., the reference held
+ * by a shared pointer) are released by the consumer rather than lingering in the ring
+ * @tparam T the element type, which must be default-constructible and move-assignable
+ */
+template<typename T>
+class MPSC_Queue final
+{
+private:
+
+    /**
+     * the assumed size of a cache line, used to keep the producer and consumer positions from false sharing
+     */
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    /**
+     * This structure stores a single slot of the ring buffer
+     */
+    struct Cell
+    {
+        /**
+         * the sequence number used to determine whether the slot is free or occupied
+         */
+        std::atomic<std::size_t> m_sequence;
+
+        /**
+         * the value stored in the slot
+         */
+        T m_value;
+    };
+
+public:
+
+    /**
+     * Constructor
+     * @param capacity the maximum number of elements the queue can hold (rounded up to a power of two)
+     */
+    explicit MPSC_Queue(std::size_t capacity)
+    : m_capacity(roundUpToPowerOfTwo(capacity < 2 ? 2 : capacity)),
+      m_mask(m_capacity - 1),
+      m_pCells(new Cell[m_capacity]),
+      m_enqueuePosition(0),
+      m_dequeuePosition(0)
+    {
+        for (std::size_t i = 0; i < m_capacity; ++i)
+            m_pCells[i].m_sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /**
+     * Copy constructor
+     */
+    MPSC_Queue(const MPSC_Queue<T> &queue) = delete;
+
+    /**
+     * Move constructor
+     */
+    MPSC_Queue(MPSC_Queue<T> &&queue) = delete;
+
+    /**
+     * Destructor
+     */
+    ~MPSC_Queue(void)
+    {
+
+    }
+
+    /**
+     * Copy assignment operator
+     */
+    MPSC_Queue<T> &operator = (const MPSC_Queue<T> &queue) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    MPSC_Queue<T> &operator = (MPSC_Queue<T> &&queue) = delete;
+
+    /**
+     * Remove up to the specified number of elements from the front of the queue, passing each to the given
+     * function in order; returns the number of elements removed. Must only be called from the consumer thread
+     * @param function a unary function object which accepts an rvalue reference to an element
+     * @param maximum  the maximum number of elements to remove
+     */
+    template<typename Function>
+    std::size_t drain(Function &&function,
+                      std::size_t maximum = std::numeric_limits<std::size_t>::max())
+    {
+        std::size_t numRemoved = 0;
+        T value;
+        while (numRemoved < maximum && pop(value))
+        {
+            function(std::move(value));
+            ++numRemoved;
+        }
+
+        return numRemoved;
+    }
+
+    /**
+     * Determine whether or not the queue is empty; the result is exact only when called from the consumer
+     * thread while no push is in progress, otherwise it is a snapshot
+     */
+    inline bool empty(void) const
+    {
+        auto &&position = m_dequeuePosition.load(std::memory_order_relaxed);
+        auto &&sequence = m_pCells[position & m_mask].m_sequence.load(std::memory_order_acquire);
+
+        return sequence != position + 1;
+    }
+
+    /**
+     * Get the maximum number of elements the queue can hold
+     */
+    inline std::size_t getCapacity(void) const
+    {
+        return m_capacity;
+    }
+
+    /**
+     * Remove the element at the front of the queue; returns false if the queue is empty. Must only be called
+     * from the consumer thread
+     * @param value upon success, contains the element removed from the queue
+     */
+    bool pop(T &value)
+    {
+        auto &&position = m_dequeuePosition.load(std::memory_order_relaxed);
+        auto *pCell = &m_pCells[position & m_mask];
+        auto &&sequence = pCell->m_sequence.load(std::memory_order_acquire);
+        bool bSuccess = (sequence == position + 1); // the slot has been published by a producer
+        if (bSuccess)
+        {
+            value = std::move(pCell->m_value);
+            pCell->m_value = T();
+            m_dequeuePosition.store(position + 1, std::memory_order_relaxed);
+
+            // release the slot to producers for the next lap around the ring
+            pCell->m_sequence.store(position + m_capacity, std::memory_order_release);
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Append an element to the back of the queue; returns false if the queue is full. May be called
+     * concurrently from any number of threads
+     */
+    template<typename Value>
+    bool push(Value &&value)
+    {
+        Cell *pCell = nullptr;
+        auto position = m_enqueuePosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+            pCell = &m_pCells[position & m_mask];
+            auto &&sequence = pCell->m_sequence.load(std::memory_order_acquire);
+            auto &&difference = static_cast<std::intptr_t>(sequence - position);
+            if (difference == 0)
+            {
+                // the slot is free; attempt to claim it
+                if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+                return false; // the queue is full
+            else
+                position = m_enqueuePosition.load(std::memory_order_relaxed); // another producer claimed it
+        }
+
+        pCell->m_value = std::forward<Value>(value);
+        pCell->m_sequence.store(position + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Get the approximate number of elements in the queue
+     */
+    inline std::size_t size(void) const
+    {
+        auto &&dequeuePosition = m_dequeuePosition.load(std::memory_order_relaxed);
+        auto &&enqueuePosition = m_enqueuePosition.load(std::memory_order_relaxed);
+
+        return enqueuePosition > dequeuePosition ? enqueuePosition - dequeuePosition : 0;
+    }
+
+private:
+
+    /**
+     * Round the input up to the nearest power of two
+     */
+    inline static std::size_t roundUpToPowerOfTwo(std::size_t value)
+    {
+        std::size_t result = 1;
+        while (result < value)
+            result <<= 1;
+
+        return result;
+    }
+
+    /**
+     * the capacity of the ring buffer
+     */
+    const std::size_t m_capacity;
+
+    /**
+     * the mask used to map positions to slots
+     */
+    const std::size_t m_mask;
+
+    /**
+     * the ring buffer
+     */
+    std::unique_ptr<Cell[]> m_pCells;
+
+    /**
+     * the position at which the next element will be enqueued (shared by producers)
+     */
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_enqueuePosition;
+
+    /**
+     * the position from which the next element will be dequeued (owned by the consumer)
+     */
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_dequeuePosition;
+};
+
+}
+
+#endif
@@ -2,12 +2,16 @@
 #define TIME_SORTED_CONTAINER_H
 
 #include "entry_container.h"
+#include <algorithm>
 
 namespace containers
 {
 
 /**
- * A container class for storing and retrieving entries by time
+ * A container class for storing and retrieving entries by time. Once the container holds its maximum number
+ * of entries, entries which arrive in increasing order of time overwrite the oldest entry in place, so that
+ * the entries are stored in a circular buffer and both the append and the eviction take constant time;
+ * entries which arrive out of order are inserted by binary search
  */
 template<typename EntryType,
          typename TimeType = double,
@@ -69,6 +73,7 @@ public:
      * Constructor
      */
     TimeSortedContainer(void)
+    : m_head(0)
     {
 
     }
@@ -77,6 +82,7 @@ public:
      * Copy constructor
      */
     TimeSortedContainer(const tTimeSortedContainer &container)
+    : m_head(0)
     {
         operator = (container);
     }
@@ -85,6 +91,7 @@ public:
      * Move constructor
      */
     TimeSortedContainer(tTimeSortedContainer &&container)
+    : m_head(0)
     {
         operator = (std::move(container));
     }
@@ -136,6 +143,27 @@ public:
         if (bSuccess)
         {
             auto time = (pEntry->*getTime)();
+            if (isAppendable(time))
+            {
+                if (m_entries.size() == this->getMaxSize())
+                {
+                    // overwrite the oldest entry
+                    destroyEntry(m_entries[m_head]);
+                    m_entries[m_head] = pEntry;
+                    if (++m_head == m_entries.size())
+                        m_head = 0;
+                }
+                else
+                {
+                    linearize();
+                    m_entries.push_back(pEntry);
+                    evictOldestEntries();
+                }
+
+                return bSuccess;
+            }
+
+            linearize();
             auto &&itEntry = std::lower_bound(m_entries.cbegin(),
                                               m_entries.cend(),
                                               time,
@@ -171,10 +199,7 @@ public:
 
             m_entries.insert(itEntry,
                              pEntry);
-            while (m_entries.size() > this->getMaxSize())
-            {
-                deleteEntry(m_entries.front());
-            }
+            evictOldestEntries();
         }
 
         return bSuccess;
@@ -186,6 +211,35 @@ public:
     virtual void addEntry(const EntryType &entry) override
     {
         auto time = (entry.*getTime)();
+        if (isAppendable(time))
+        {
+            if (m_entries.size() == this->getMaxSize())
+            {
+                // recycle the oldest entry
+                auto *pEntry = m_entries[m_head];
+                if (pEntry != nullptr)
+                {
+                    *pEntry = entry;
+                }
+                else
+                {
+                    m_entries[m_head] = (entry.*clone)();
+                }
+
+                if (++m_head == m_entries.size())
+                    m_head = 0;
+            }
+            else
+            {
+                linearize();
+                m_entries.push_back((entry.*clone)());
+                evictOldestEntries();
+            }
+
+            return;
+        }
+
+        linearize();
         auto &&itEntry = std::lower_bound(m_entries.cbegin(),
                                           m_entries.cend(),
                                           time,
@@ -200,38 +254,11 @@ public:
         if (pEntry == nullptr ||
             (pEntry->*getTime)() != time)
         {
-            if (m_entries.size() >= this->getMaxSize())
-            {
-                if (itEntry == m_entries.cend())
-                {
-                    // perform a simple rotation and assign the current entry to the back
-                    std::rotate(m_entries.begin(),
-                                m_entries.begin() + 1,
-                                m_entries.end());
-
-                    pEntry = m_entries.back();
-                    if (pEntry != nullptr)
-                    {
-                        *pEntry = entry;
-                    }
-                }
-                else
-                {
-                    m_entries.emplace(itEntry,
-                                      (entry.*clone)());
-                    while (m_entries.size() > this->getMaxSize())
-                    {
-                        deleteEntry(m_entries.front());
-                    }
-                }
-            }
-            else
-            {
-                m_entries.emplace(itEntry,
-                                  (entry.*clone)());
-            }
+            m_entries.emplace(itEntry,
+                              (entry.*clone)());
+            evictOldestEntries();
         }
-        else if (pEntry != nullptr)
+        else
         {
             // an entry with the same entry time already exists in this object's entries, so
             // update the current entry with the new one
@@ -248,16 +275,13 @@ public:
         deleteEntries();
 
         // clone or copy entries from the input container
-        auto &&itEntry = m_entries.cbegin();
-        while (itEntry != m_entries.cend())
+        for (std::size_t i = 0; i < container.m_entries.size(); ++i)
         {
-            auto *pEntry = *itEntry;
+            auto *pEntry = container.getEntryAt(i);
             if (pEntry != nullptr)
             {
                 addEntry(*pEntry);
             }
-
-            ++itEntry;
         }
     }
 
@@ -267,6 +291,7 @@ public:
     virtual void deleteEntries(TimeType startTime,
                                TimeType endTime) final
     {
+        linearize();
         auto &&itEntry = std::lower_bound(m_entries.cbegin(),
                                           m_entries.cend(),
                                           startTime,
@@ -368,6 +393,7 @@ public:
         }
 
         m_entries.clear();
+        m_head = 0;
     }
 
     /**
@@ -378,6 +404,7 @@ public:
         bool bSuccess = (pEntry != nullptr);
         if (bSuccess)
         {
+            linearize();
             auto &&itEntry = std::find(m_entries.cbegin(),
                                        m_entries.cend(),
                                        pEntry);
@@ -425,26 +452,20 @@ public:
                             TimeType endTime,
                             std::vector<EntryType *> &entries) const final
     {
-        auto &&itEntry = std::lower_bound(m_entries.cbegin(),
-                                          m_entries.cend(),
-                                          startTime,
-                                          m_comparator);
-        auto &&itEntryEnd = std::upper_bound(itEntry,
-                                             m_entries.cend(),
-                                             endTime,
-                                             m_comparator);
-        if (itEntryEnd == itEntry)
+        auto &&index = lowerBound(startTime);
+        auto &&indexEnd = upperBound(endTime, index);
+        if (indexEnd == index)
         {
-            itEntryEnd = m_entries.cend();
+            indexEnd = m_entries.size();
         }
 
-        bool bSuccess = (itEntry != itEntryEnd);
+        bool bSuccess = (index != indexEnd);
         if (bSuccess)
         {
             while (bSuccess &&
-                   itEntry != itEntryEnd)
+                   index != indexEnd)
             {
-                auto *pEntry = *itEntry;
+                auto *pEntry = getEntryAt(index);
                 bSuccess = (pEntry != nullptr);
                 if (bSuccess)
                 {
@@ -456,7 +477,7 @@ public:
                     }
                 }
 
-                ++itEntry;
+                ++index;
             }
         }
 
@@ -468,6 +489,8 @@ public:
      */
     inline virtual std::vector<EntryType *> &getEntries(void) final
     {
+        linearize();
+
         return m_entries;
     }
 
@@ -476,7 +499,10 @@ public:
      */
     inline virtual std::vector<EntryType *> getEntries(void) const final
     {
-        return m_entries;
+        std::vector<EntryType *> entries(m_entries.cbegin() + m_head, m_entries.cend());
+        entries.insert(entries.cend(), m_entries.cbegin(), m_entries.cbegin() + m_head);
+
+        return entries;
     }
 
     /**
@@ -484,13 +510,10 @@ public:
      */
     virtual EntryType *getEntry(TimeType time) const final
     {
-        auto &&itEntry = std::lower_bound(m_entries.cbegin(),
-                                          m_entries.cend(),
-                                          time,
-                                          m_comparator);
-        if (itEntry != m_entries.cend())
+        auto &&index = lowerBound(time);
+        if (index != m_entries.size())
         {
-            auto *pEntry = *itEntry;
+            auto *pEntry = getEntryAt(index);
             if (pEntry != nullptr &&
                 (pEntry->*getTime)() == time)
             {
@@ -508,7 +531,7 @@ public:
     {
         if (!m_entries.empty())
         {
-            return m_entries.back();
+            return getEntryAt(m_entries.size() - 1);
         }
 
         return nullptr;
@@ -521,24 +544,21 @@ public:
     {
         if (!m_entries.empty())
         {
-            auto &&itEntry = std::lower_bound(m_entries.cbegin(),
-                                              m_entries.cend(),
-                                              time,
-                                              m_comparator);
-            if (itEntry == m_entries.cend())
+            auto &&index = lowerBound(time);
+            if (index == m_entries.size())
             {
-                --itEntry;
+                --index;
             }
 
-            for (;; --itEntry)
+            for (;; --index)
             {
-                auto *pEntry = *itEntry;
+                auto *pEntry = getEntryAt(index);
                 if (pEntry != nullptr &&
                     (pEntry->*getTime)() <= time)
                 {
                     return pEntry;
                 }
-                else if (itEntry == m_entries.cbegin())
+                else if (index == 0)
                 {
                     break;
                 }
@@ -554,6 +574,7 @@ public:
     virtual void removeEntries(TimeType startTime,
                                TimeType endTime) final
     {
+        linearize();
         auto &&itEntry = std::lower_bound(m_entries.cbegin(),
                                           m_entries.cend(),
                                           startTime,
@@ -591,6 +612,7 @@ public:
     inline virtual void removeEntries(void) override
     {
         m_entries.clear();
+        m_head = 0;
     }
 
     /**
@@ -601,6 +623,7 @@ public:
         bool bSuccess = (pEntry != nullptr);
         if (bSuccess)
         {
+            linearize();
             auto &&itEntry = std::find(m_entries.cbegin(),
                                        m_entries.cend(),
                                        pEntry);
@@ -632,19 +655,149 @@ public:
         std::swap(m_comparator,
                   container.m_comparator);
         m_entries.swap(container.m_entries);
+        std::swap(m_head,
+                  container.m_head);
     }
 
 protected:
 
+    /**
+     * Destroy an entry
+     */
+    inline static void destroyEntry(EntryType *pEntry)
+    {
+        if (pEntry != nullptr)
+        {
+            if (deleter == nullptr)
+            {
+                delete pEntry;
+            }
+            else
+            {
+                (*deleter)(pEntry);
+            }
+        }
+    }
+
+    /**
+     * Delete the oldest entries in excess of the maximum size of this container
+     */
+    void evictOldestEntries(void)
+    {
+        if (m_entries.size() > this->getMaxSize())
+        {
+            auto &&itEntryEnd = m_entries.begin() + (m_entries.size() - this->getMaxSize());
+            std::for_each(m_entries.begin(), itEntryEnd, &destroyEntry);
+            m_entries.erase(m_entries.begin(), itEntryEnd);
+        }
+    }
+
+    /**
+     * Retrieve the entry at the specified index, counted from the oldest entry
+     */
+    inline EntryType *getEntryAt(std::size_t index) const
+    {
+        index += m_head;
+        if (index >= m_entries.size())
+        {
+            index -= m_entries.size();
+        }
+
+        return m_entries[index];
+    }
+
+    /**
+     * Determines whether or not an entry tagged at the specified time follows all of this container's entries
+     */
+    inline bool isAppendable(TimeType time) const
+    {
+        if (m_entries.empty())
+        {
+            return this->getMaxSize() > 0;
+        }
+
+        auto *pEntry = getEntryAt(m_entries.size() - 1);
+
+        return pEntry != nullptr && (pEntry->*getTime)() < time;
+    }
+
+    /**
+     * Restore this container's entries to contiguous order, oldest first
+     */
+    inline void linearize(void)
+    {
+        if (m_head != 0)
+        {
+            std::rotate(m_entries.begin(),
+                        m_entries.begin() + m_head,
+                        m_entries.end());
+            m_head = 0;
+        }
+    }
+
+    /**
+     * Find the index, counted from the oldest entry, of the first entry not tagged before the specified time
+     */
+    std::size_t lowerBound(TimeType time) const
+    {
+        std::size_t index = 0, count = m_entries.size();
+        while (count > 0)
+        {
+            auto step = count / 2;
+            if (m_comparator(getEntryAt(index + step), time))
+            {
+                index += step + 1;
+                count -= step + 1;
+            }
+            else
+            {
+                count = step;
+            }
+        }
+
+        return index;
+    }
+
+    /**
+     * Find the index, counted from the oldest entry, of the first entry tagged after the specified time,
+     * searching from the specified index
+     */
+    std::size_t upperBound(TimeType time,
+                           std::size_t index) const
+    {
+        std::size_t count = m_entries.size() - index;
+        while (count > 0)
+        {
+            auto step = count / 2;
+            if (!m_comparator(time, getEntryAt(index + step)))
+            {
+                index += step + 1;
+                count -= step + 1;
+            }
+            else
+            {
+                count = step;
+            }
+        }
+
+        return index;
+    }
+
     /**
      * this object's entry comparator
      */
     EntryComparator m_comparator;
 
     /**
-     * this container's entries sorted by time
+     * this container's entries sorted by time; once the container has filled and begun to overwrite its oldest
+     * entries, the entries are stored circularly beginning at m_head
      */
     std::vector<EntryType *> m_entries;
+
+    /**
+     * the index within m_entries of the oldest entry
+     */
+    std::size_t m_head;
 };
 
 }
@@ -5,10 +5,13 @@
 #include "is_output_streamable.h"
 #include "reference_unwrapper.h"
 #include "swappable.h"
+#include <cstddef>
 #include <cstring>
 #include <iostream>
+#include <new>
 #include <sstream>
 #include <tuple>
+#include <type_traits>
 
 namespace functional
 {
@@ -19,7 +22,11 @@ template<typename T> T any_cast(Any &operand);
 
 /**
  * This class can hold instances of any copy-constructible type. Code adapted and modified from Boost C++
- * libraries.
+ * libraries. Values whose holders fit within a small internal buffer (e.g., arithmetic types, pointers,
+ * std::shared_ptr, Vector3d) and which are nothrow move-constructible are stored in place, so that creating,
+ * copying and moving them does not allocate; larger values are stored on the heap. The type of the held value
+ * is identified by a per-type tag, so that successful any_cast() operations do not require run-time type
+ * information
  */
 class Any final
 : public attributes::interfaces::Cloneable<Any>,
@@ -34,44 +41,62 @@ public:
     template<typename T> friend T *any_cast(Any *) noexcept;
     template<typename T> friend T *unsafe_any_cast(Any *) noexcept;
 
+    /**
+     * the size (in bytes) of the buffer in which small values are stored in place; large enough to hold the
+     * holder of a Vector3d, whose vtable pointers account for 24 bytes in addition to the value itself
+     */
+    static constexpr std::size_t BUFFER_SIZE = 80;
+
     /**
      * Constructor
      */
     Any(void) noexcept
-    : std::tuple<functional::Holder *>(nullptr)
+    : std::tuple<functional::Holder *>(nullptr),
+      m_bInPlace(false),
+      m_pTypeId(nullptr)
     {
 
     }
 
     /**
-     * Constructor
+     * Constructor; rvalues are moved into this object rather than copied
      */
     template<typename T, typename U = typename std::decay<T>::type,
              typename std::enable_if<!std::is_same<std::tuple<functional::Holder *>, U>::value &&
                                      !std::is_base_of<std::tuple<functional::Holder *>, U>::value, int>::type = 0>
-    Any(const T &value) noexcept
-    : std::tuple<functional::Holder *>(new Held<T>(value))
+    Any(T &&value)
+    : std::tuple<functional::Holder *>(nullptr),
+      m_bInPlace(isStorableInPlace<U>()),
+      m_pTypeId(Held<U>::getHeldTypeId())
     {
-
+        if constexpr (isStorableInPlace<U>())
+            std::get<functional::Holder *>(*this) = new (&m_buffer) Held<U>(std::forward<T>(value));
+        else
+            std::get<functional::Holder *>(*this) = new Held<U>(std::forward<T>(value));
     }
 
     /**
      * Copy constructor
      */
-    Any(const Any &any) noexcept
-    : std::tuple<functional::Holder *>(any.holder() != nullptr ? any.holder()->clone() : nullptr)
-
+    Any(const Any &any)
+    : std::tuple<functional::Holder *>(nullptr),
+      m_bInPlace(any.m_bInPlace),
+      m_pTypeId(any.m_pTypeId)
     {
-
+        auto *pHolder = static_cast<Holder *>(any.holder());
+        if (pHolder != nullptr)
+            std::get<functional::Holder *>(*this) = pHolder->copyTo(&m_buffer);
     }
 
     /**
      * Move constructor
      */
     Any(Any &&any) noexcept
-    : std::tuple<functional::Holder *>(std::get<functional::Holder *>(any))
+    : std::tuple<functional::Holder *>(nullptr),
+      m_bInPlace(false),
+      m_pTypeId(nullptr)
     {
-        std::get<functional::Holder *>(any) = nullptr;
+        moveFrom(any);
     }
 
     /**
@@ -79,9 +104,7 @@ public:
      */
     virtual ~Any(void) noexcept
     {
-        auto *pHolder = holder();
-        if (pHolder != nullptr)
-            delete pHolder;
+        reset();
     }
 
     /**
@@ -100,24 +123,26 @@ public:
     /**
      * Move assignment operator
      */
-    Any &operator = (Any &&any)
+    Any &operator = (Any &&any) noexcept
     {
-        any.swap(*this);
+        if (&any != this)
+        {
+            reset();
+            moveFrom(any);
+        }
 
         return *this;
     }
 
     /**
-     * Assignment operator
+     * Assignment operator; rvalues are moved into this object rather than copied
      */
     template<typename T, typename U = typename std::decay<T>::type>
     inline typename std::enable_if<!std::is_same<std::tuple<functional::Holder *>, U>::value &&
                                    !std::is_base_of<std::tuple<functional::Holder *>, U>::value, Any &>::type
-    operator = (const T &value)
+    operator = (T &&value)
     {
-        Any(value).swap(*this);
-
-        return *this;
+        return operator = (Any(std::forward<T>(value)));
     }
 
     /**
@@ -162,6 +187,25 @@ public:
         return holder() == nullptr;
     }
 
+    /**
+     * Query whether or not values of the specified type are stored within this object's internal buffer (rather
+     * than on the heap)
+     */
+    template<typename T>
+    inline static constexpr bool isStorableInPlace(void) noexcept
+    {
+        return sizeof(Held<T>) <= BUFFER_SIZE && alignof(Held<T>) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<T>::value;
+    }
+
+    /**
+     * Query whether or not this object's value is stored within its internal buffer (rather than on the heap)
+     */
+    inline bool isStoredInPlace(void) const noexcept
+    {
+        return m_bInPlace;
+    }
+
     /**
      * Return a pointer to this object's holder
      */
@@ -193,12 +237,41 @@ public:
         return stream;
     }
 
+    /**
+     * Destroy this object's value (if any)
+     */
+    inline void reset(void) noexcept
+    {
+        auto *pHolder = holder();
+        if (pHolder != nullptr)
+        {
+            static_cast<Holder *>(pHolder)->destroy();
+            std::get<functional::Holder *>(*this) = nullptr;
+        }
+
+        m_bInPlace = false;
+        m_pTypeId = nullptr;
+    }
+
     /**
      * Swap contents of this object with another
      */
     inline virtual void swap(Any &any) noexcept override final
     {
-        std::tuple<functional::Holder *>::swap(any);
+        if (&any != this)
+        {
+            if (!m_bInPlace && !any.m_bInPlace)
+            {
+                std::tuple<functional::Holder *>::swap(any);
+                std::swap(m_pTypeId, any.m_pTypeId);
+            }
+            else
+            {
+                Any temp(std::move(any));
+                any = std::move(*this);
+                *this = std::move(temp);
+            }
+        }
     }
 
     /**
@@ -231,6 +304,35 @@ public:
 
 private:
 
+    /**
+     * Return a tag that uniquely identifies the specified type within a module; tags are compared in lieu of
+     * type_info names when performing any_cast() operations
+     */
+    template<typename T>
+    inline static const void *getTypeId(void) noexcept
+    {
+        static const char id = 0;
+
+        return &id;
+    }
+
+    /**
+     * Move the contents of another object into this (empty) object, leaving the other object empty
+     */
+    inline void moveFrom(Any &any) noexcept
+    {
+        auto *pHolder = static_cast<Holder *>(any.holder());
+        if (pHolder != nullptr)
+        {
+            m_bInPlace = any.m_bInPlace;
+            m_pTypeId = any.m_pTypeId;
+            std::get<functional::Holder *>(*this) = pHolder->moveTo(&m_buffer);
+            std::get<functional::Holder *>(any) = nullptr;
+            any.m_bInPlace = false;
+            any.m_pTypeId = nullptr;
+        }
+    }
+
     /**
      * This class serves as an abstract base container class that facilitates the type erasure idiom in classes
      * from which it is derived
@@ -249,6 +351,23 @@ private:
 
         }
 
+        /**
+         * Copy-construct this holder within the specified buffer if its value is stored in place, otherwise on
+         * the heap
+         */
+        virtual Holder *copyTo(void *pBuffer) const = 0;
+
+        /**
+         * Destroy this holder, releasing its memory if it resides on the heap
+         */
+        virtual void destroy(void) noexcept = 0;
+
+        /**
+         * Move this holder into the specified buffer if its value is stored in place (destroying the original),
+         * otherwise return this holder, the ownership of which passes to the caller
+         */
+        virtual Holder *moveTo(void *pBuffer) noexcept = 0;
+
         /**
          * Output stream print function
          * @param stream a reference to an std::ostream object
@@ -293,8 +412,9 @@ private:
         /**
          * Constructor
          */
-        Held(const T &value)
-        : functional::Held<T>(value)
+        template<typename U>
+        Held(U &&value)
+        : functional::Held<T>(std::forward<U>(value))
         {
 
         }
@@ -315,6 +435,54 @@ private:
             return new Held<T>(this->m_held);
         }
 
+        /**
+         * Copy-construct this holder within the specified buffer if its value is stored in place, otherwise on
+         * the heap
+         */
+        inline virtual Holder *copyTo(void *pBuffer) const override
+        {
+            if constexpr (Any::isStorableInPlace<T>())
+                return new (pBuffer) Held<T>(this->m_held);
+            else
+                return new Held<T>(this->m_held);
+        }
+
+        /**
+         * Destroy this holder, releasing its memory if it resides on the heap
+         */
+        inline virtual void destroy(void) noexcept override
+        {
+            if constexpr (Any::isStorableInPlace<T>())
+                this->~Held();
+            else
+                delete this;
+        }
+
+        /**
+         * Return the tag that identifies the type of the held value
+         */
+        inline static const void *getHeldTypeId(void) noexcept
+        {
+            return Any::getTypeId<T>();
+        }
+
+        /**
+         * Move this holder into the specified buffer if its value is stored in place (destroying the original),
+         * otherwise return this holder, the ownership of which passes to the caller
+         */
+        inline virtual Holder *moveTo(void *pBuffer) noexcept override
+        {
+            if constexpr (Any::isStorableInPlace<T>())
+            {
+                auto *pHolder = new (pBuffer) Held<T>(std::move(this->m_held));
+                this->~Held();
+
+                return pHolder;
+            }
+            else
+                return this;
+        }
+
         /**
          * Output stream print function
          * @param stream a reference to an std::ostream object
@@ -373,6 +541,41 @@ private:
             return new Held<std::reference_wrapper<noconst>>(this->m_held);
         }
 
+        /**
+         * Copy-construct this holder within the specified buffer (reference wrappers are always stored in place)
+         */
+        inline virtual Holder *copyTo(void *pBuffer) const override
+        {
+            return new (pBuffer) Held<std::reference_wrapper<noconst>>(this->m_held);
+        }
+
+        /**
+         * Destroy this holder
+         */
+        inline virtual void destroy(void) noexcept override
+        {
+            this->~Held();
+        }
+
+        /**
+         * Return the tag that identifies the type of the held value
+         */
+        inline static const void *getHeldTypeId(void) noexcept
+        {
+            return Any::getTypeId<std::reference_wrapper<noconst>>();
+        }
+
+        /**
+         * Move this holder into the specified buffer, destroying the original
+         */
+        inline virtual Holder *moveTo(void *pBuffer) noexcept override
+        {
+            auto *pHolder = new (pBuffer) Held<std::reference_wrapper<noconst>>(this->m_held);
+            this->~Held();
+
+            return pHolder;
+        }
+
         /**
          * Output stream print function
          * @param stream a reference to an std::ostream object
@@ -390,6 +593,21 @@ private:
             return typeid(std::reference_wrapper<noconst>);
         }
     };
+
+    /**
+     * flag indicating whether or not the value is stored within the internal buffer
+     */
+    bool m_bInPlace;
+
+    /**
+     * the buffer in which small values are stored in place
+     */
+    typename std::aligned_storage<BUFFER_SIZE, alignof(std::max_align_t)>::type m_buffer;
+
+    /**
+     * a tag that identifies the type of the held value
+     */
+    const void *m_pTypeId;
 };
 
 /**
@@ -416,12 +634,26 @@ inline T *any_cast(Any *pAny) noexcept
         typedef typename std::remove_cv<typename traits::helpers::reference_unwrapper<T>::type>::type noconst;
         typedef typename std::conditional<std::is_copy_constructible<typename std::decay<T>::type>::value,
                                           T, typename std::add_lvalue_reference<T>::type>::type type;
-
-        auto &&name = pAny->type().name();
-        if (std::strcmp(name, typeid(type).name()) == 0)
-            return &static_cast<Any::Held<type> *>(pAny->holder())->m_held;
-        else if (std::strcmp(name, typeid(std::reference_wrapper<noconst>).name()) == 0)
+        typedef typename std::remove_cv<type>::type held;
+
+        // compare type tags; values are held without cv-qualification, so the tag of a cv-qualified type is that
+        // of its unqualified type. In shared library builds, tags may not be unique across module boundaries, so
+        // type names are compared if the tags differ
+        auto *pTypeId = pAny->m_pTypeId;
+        if (pTypeId == Any::getTypeId<held>())
+            return &static_cast<Any::Held<held> *>(pAny->holder())->m_held;
+        else if (pTypeId == Any::getTypeId<std::reference_wrapper<noconst>>())
             return &(static_cast<Any::Held<std::reference_wrapper<noconst>> *>(pAny->holder())->m_held).get();
+#ifdef STEMULATION_SHARED_LIBRARY
+        else if (pTypeId != nullptr)
+        {
+            auto &&name = pAny->type().name();
+            if (std::strcmp(name, typeid(held).name()) == 0)
+                return &static_cast<Any::Held<held> *>(pAny->holder())->m_held;
+            else if (std::strcmp(name, typeid(std::reference_wrapper<noconst>).name()) == 0)
+                return &(static_cast<Any::Held<std::reference_wrapper<noconst>> *>(pAny->holder())->m_held).get();
+        }
+#endif
     }
 
     return nullptr;
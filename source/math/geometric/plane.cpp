@@ -271,7 +271,7 @@ Vector2d Plane::project(const Vector3d &point3d)
 {
     // determine the angle between the normal vector and the z-axis
     Vector3d zAxis(0.0, 0.0, 1.0);
-    auto angle = m_normal.calcAngle(zAxis);
+    auto angle = m_normal.calcAngle(zAxis, AngleUnitType::Radians);
 
     // determine the axis of rotation
     Vector3d axis(m_normal);
@@ -350,7 +350,7 @@ Vector3d Plane::unproject(const Vector2d &point2d)
 {
     // determine the angle between the normal vector and the z-axis
     Vector3d zAxis(0.0, 0.0, 1.0);
-    auto angle = m_normal.calcAngle(zAxis);
+    auto angle = m_normal.calcAngle(zAxis, AngleUnitType::Radians);
 
     // determine the axis of rotation
     Vector3d axis(m_normal);
@@ -377,11 +377,9 @@ void Plane::unproject(Vector2d point2d,
                       const Vector3d &axis,
                       const AngleUnitType &angleUnits)
 {
-    double x, y, z; // z should be zero after the rotation
-    point3d.rotate(-angle, axis, angleUnits).get(x, y, z);
+    point3d.set(point2d.getX(), point2d.getY(), 0.0);
+    point3d.rotate(-angle, axis, angleUnits);
     point3d += m_origin;
-
-    point3d.set(x, y, z);
 }
 
 }
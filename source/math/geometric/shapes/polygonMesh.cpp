@@ -1,16 +1,21 @@
+#include "boundingVolumeHierarchy.h"
+#include "objFileReader.h"
 #include "polygonMesh.h"
+#include "ray.h"
 #include "rayIntersection.h"
+#include "thread_pool.h"
 #include "triangle.h"
 #include "vector2d.h"
-#include <fstream>
 
 // file-scoped variables
 static constexpr char factoryName[] = "PolygonMesh";
+static constexpr std::size_t MINIMUM_FACES_PER_THREAD = 16384;
 
 // using namespace declarations
 using namespace attributes::abstract;
 using namespace math::geometric;
 using namespace math::linear_algebra::vector;
+using namespace math::trigonometric;
 using namespace utilities;
 
 namespace math
@@ -29,6 +34,8 @@ static FactoryRegistrar<Shape> factory(factoryName, &PolygonMesh::create);
  * Constructor
  */
 PolygonMesh::PolygonMesh(void)
+: m_bBoundingVolumeHierarchyValid(false),
+  m_pBoundingVolumeHierarchy(new utilities::BoundingVolumeHierarchy())
 {
 
 }
@@ -37,16 +44,20 @@ PolygonMesh::PolygonMesh(void)
  * Copy constructor
  */
 PolygonMesh::PolygonMesh(const PolygonMesh &polygonMesh)
+: m_bBoundingVolumeHierarchyValid(false),
+  m_pBoundingVolumeHierarchy(new utilities::BoundingVolumeHierarchy())
 {
-
+    operator = (polygonMesh);
 }
 
 /**
  * Move constructor
  */
 PolygonMesh::PolygonMesh(PolygonMesh &&polygonMesh)
+: m_bBoundingVolumeHierarchyValid(false),
+  m_pBoundingVolumeHierarchy(new utilities::BoundingVolumeHierarchy())
 {
-
+    operator = (std::move(polygonMesh));
 }
 
 /**
@@ -66,7 +77,10 @@ PolygonMesh &PolygonMesh::operator = (const PolygonMesh &polygonMesh)
     {
         Shape3d::operator = (polygonMesh);
 
+        m_bBoundingVolumeHierarchyValid = polygonMesh.m_bBoundingVolumeHierarchyValid;
+        *m_pBoundingVolumeHierarchy = *polygonMesh.m_pBoundingVolumeHierarchy;
         m_polygons = polygonMesh.m_polygons;
+        m_triangleToPolygon = polygonMesh.m_triangleToPolygon;
     }
 
     return *this;
@@ -81,7 +95,11 @@ PolygonMesh &PolygonMesh::operator = (PolygonMesh &&polygonMesh)
     {
         Shape3d::operator = (std::move(polygonMesh));
 
+        m_bBoundingVolumeHierarchyValid = std::move(polygonMesh.m_bBoundingVolumeHierarchyValid);
+        m_pBoundingVolumeHierarchy.swap(polygonMesh.m_pBoundingVolumeHierarchy);
         m_polygons = std::move(polygonMesh.m_polygons);
+        m_triangleToPolygon = std::move(polygonMesh.m_triangleToPolygon);
+        polygonMesh.m_bBoundingVolumeHierarchyValid = false;
     }
 
     return *this;
@@ -92,6 +110,8 @@ PolygonMesh &PolygonMesh::operator = (PolygonMesh &&polygonMesh)
  */
 Polygon &PolygonMesh::operator [] (int index)
 {
+    m_bBoundingVolumeHierarchyValid = false;
+
     return m_polygons[index];
 }
 
@@ -108,6 +128,8 @@ Polygon PolygonMesh::operator [] (int index) const
  */
 PolygonMesh::iterator PolygonMesh::begin(void)
 {
+    m_bBoundingVolumeHierarchyValid = false;
+
     return m_polygons.begin();
 }
 
@@ -121,6 +143,36 @@ double PolygonMesh::calcArea(void) const
     return 0.0;
 }
 
+/**
+ * Build the bounding-volume hierarchy over this mesh's triangulated polygons
+ */
+bool PolygonMesh::buildBoundingVolumeHierarchy(void)
+{
+    // triangulate each polygon and map the vertices of the resulting triangles from the polygon's plane into
+    // 3-d space
+    std::vector<Triangle> triangles;
+    std::vector<Vector3d> vertices;
+    m_triangleToPolygon.clear();
+    for (std::size_t i = 0; i < m_polygons.size(); ++i)
+    {
+        auto &&polygon = m_polygons[i];
+        auto &&plane = polygon.getPlane();
+        triangles.clear();
+        polygon.triangulate(triangles);
+        for (auto &&triangle : triangles)
+        {
+            vertices.emplace_back(plane.unproject(triangle.getVertexOne()));
+            vertices.emplace_back(plane.unproject(triangle.getVertexTwo()));
+            vertices.emplace_back(plane.unproject(triangle.getVertexThree()));
+            m_triangleToPolygon.push_back(i);
+        }
+    }
+
+    m_bBoundingVolumeHierarchyValid = m_pBoundingVolumeHierarchy->build(vertices);
+
+    return m_bBoundingVolumeHierarchyValid;
+}
+
 /**
  * Calculate the volume of this shape
  */
@@ -152,6 +204,7 @@ PolygonMesh::const_iterator PolygonMesh::cend(void) const
  */
 void PolygonMesh::clear(void)
 {
+    m_bBoundingVolumeHierarchyValid = false;
     m_polygons.clear();
 }
 
@@ -200,6 +253,8 @@ bool PolygonMesh::empty(void) const
  */
 PolygonMesh::iterator PolygonMesh::end(void)
 {
+    m_bBoundingVolumeHierarchyValid = false;
+
     return m_polygons.end();
 }
 
@@ -208,6 +263,8 @@ PolygonMesh::iterator PolygonMesh::end(void)
  */
 PolygonMesh::iterator PolygonMesh::erase(iterator it)
 {
+    m_bBoundingVolumeHierarchyValid = false;
+
     return m_polygons.erase(it);
 }
 
@@ -219,6 +276,17 @@ std::string PolygonMesh::getClassName(void) const
     return "PolygonMesh";
 }
 
+/**
+ * Get the bounding-volume hierarchy built over this mesh's triangulated polygons, (re)building it if necessary
+ */
+utilities::BoundingVolumeHierarchy &PolygonMesh::getBoundingVolumeHierarchy(void)
+{
+    if (!m_bBoundingVolumeHierarchyValid)
+        buildBoundingVolumeHierarchy();
+
+    return *m_pBoundingVolumeHierarchy;
+}
+
 /**
  * Get the factory name of this constructible
  */
@@ -227,11 +295,21 @@ std::string PolygonMesh::getFactoryName(void) const
     return factoryName;
 }
 
+/**
+ * Get the maximum number of threads used to build the bounding-volume hierarchy and process batches of rays
+ */
+std::size_t PolygonMesh::getMaximumThreads(void) const
+{
+    return m_pBoundingVolumeHierarchy->getMaximumThreads();
+}
+
 /**
  * Get this object's polygons
  */
 std::vector<Polygon> &PolygonMesh::getPolygons(void)
 {
+    m_bBoundingVolumeHierarchyValid = false;
+
     return m_polygons;
 }
 
@@ -242,15 +320,39 @@ std::vector<Polygon> &PolygonMesh::getPolygons(void)
 bool PolygonMesh::intersect(const Ray &ray,
                             RayIntersection &intersection)
 {
-    intersection.clear();
+    return getBoundingVolumeHierarchy().intersect(ray, intersection);
+}
 
-    auto &&itPolygon = m_polygons.begin();
-    while (itPolygon != m_polygons.end())
+/**
+ * Calculate the closest location at which each of a batch of rays intersects this shape; returns true if at
+ * least one intersection occurs
+ * @param rays          the rays
+ * @param intersections upon return, contains the closest intersection of each ray (empty if none)
+ * @param pPolygons     if non-null, upon return contains the index of the polygon intersected by each ray (or
+ *                      the number of polygons, if none)
+ */
+bool PolygonMesh::intersect(const std::vector<Ray> &rays,
+                            std::vector<RayIntersection> &intersections,
+                            std::vector<std::size_t> *pPolygons)
+{
+    bool bIntersects = getBoundingVolumeHierarchy().intersect(rays, intersections, pPolygons);
+    if (pPolygons != nullptr)
     {
-        // TODO: implement this
+        for (auto &&index : *pPolygons)
+            index = index < m_triangleToPolygon.size() ? m_triangleToPolygon[index] : m_polygons.size();
     }
 
-    return true;
+    return bIntersects;
+}
+
+/**
+ * Determine whether or not a ray intersects this shape at a ray parameter less than the specified maximum
+ * distance, e.g., to test line-of-sight between the ray origin and the point at the maximum distance
+ */
+bool PolygonMesh::isOccluded(const Ray &ray,
+                             double maximumDistance)
+{
+    return getBoundingVolumeHierarchy().isOccluded(ray, maximumDistance);
 }
 
 /**
@@ -258,191 +360,101 @@ bool PolygonMesh::intersect(const Ray &ray,
  */
 PolygonMesh::reverse_iterator PolygonMesh::rbegin(void)
 {
+    m_bBoundingVolumeHierarchyValid = false;
+
     return m_polygons.rbegin();
 }
 
 /**
- * Function to read a standard obj file and populate this object's polygons
+ * Function to read a standard obj file and populate this object's polygons; each face of the file becomes a
+ * polygon, whose plane passes through the face's centroid with the face's (Newell) normal, oriented to agree
+ * with the file's vertex normals, if present
  */
 bool PolygonMesh::readObjFile(const std::string &filename)
 {
-    std::string line, lineHeader;
-    std::ifstream stream;
-    std::istringstream iss;
-    bool bSuccess = (bool)stream;
+    utilities::ObjFileReader reader;
+    reader.setMaximumThreads(getMaximumThreads());
+    bool bSuccess = reader.read(filename);
     if (bSuccess)
     {
-        std::size_t numTriangles = 0;
-        std::vector<std::size_t> normalIndices, textureIndices, vertexIndices;
-        std::vector<Vector3d> normals, textures, vertices;
-        while (getline(stream, line))
+        logMsg("debug", LoggingLevel::Enum::Debug,
+               "Read " + std::to_string(reader.getNumVertices()) + " vertices and " +
+               std::to_string(reader.getNumFaces()) + " faces from 3-d object file \"" + filename + "\" at " +
+               std::to_string(reader.getThroughput()) + " MB/s.\n",
+               getQualifiedMethodName(__func__));
+
+        m_bBoundingVolumeHierarchyValid = false;
+        m_polygons.clear();
+        m_polygons.resize(reader.getNumFaces());
+
+        auto &&faceOffsets = reader.getFaceOffsets();
+        auto &&normalIndices = reader.getNormalIndices();
+        auto &&normals = reader.getNormals();
+        auto &&vertexIndices = reader.getVertexIndices();
+        auto &&vertices = reader.getVertices();
+        auto &&function = [&] (std::size_t begin, std::size_t end)
         {
-            iss.str(line);
-            iss >> lineHeader;
-            if (std::strcmp(lineHeader.c_str(), "v") == 0)
-            {
-                Vector3d vertex;
-                iss >> vertex[0];
-                iss >> vertex[1];
-                iss >> vertex[2];
-                vertices.emplace_back(vertex);
-            }
-            else if (std::strcmp(lineHeader.c_str(), "vt") == 0)
-            {
-                Vector2d vertex;
-                iss >> vertex[0];
-                iss >> vertex[1];
-                textures.emplace_back(vertex);
-            }
-            else if (std::strcmp(lineHeader.c_str(), "vn") == 0)
+            Vector3d zAxis(0.0, 0.0, 1.0);
+            for (std::size_t face = begin; face < end; ++face)
             {
-                Vector3d normal;
-                iss >> normal[0];
-                iss >> normal[1];
-                iss >> normal[2];
-                normals.emplace_back(normal);
-            }
-            else if (std::strcmp(lineHeader.c_str(), "f") == 0)
-            {
-                std::size_t indices[9] = { 0 };
-                bool bReadNormalIndices = false;
-                bool bReadTextureIndices = false;
-                bool bReadVertexIndices = false;
-                if (std::sscanf(line.c_str() + 1, "%lu/%lu/%lu %lu/%lu/%lu %lu/%lu/%lu\n",
-                                &indices[0],
-                                &indices[1],
-                                &indices[2],
-                                &indices[3],
-                                &indices[4],
-                                &indices[5],
-                                &indices[6],
-                                &indices[7],
-                                &indices[8]))
-                {
-                    bReadNormalIndices = true;
-                    bReadTextureIndices = true;
-                    bReadVertexIndices = true;
-                }
-                else if (std::sscanf(line.c_str() + 1, "%lu/%lu %lu/%lu %lu/%lu\n",
-                                     &indices[0],
-                                     &indices[1],
-                                     &indices[2],
-                                     &indices[3],
-                                     &indices[4],
-                                     &indices[5]))
-                {
-                    bReadVertexIndices = true;
-                    bReadTextureIndices = true;
-                }
-                else if (std::sscanf(line.c_str() + 1, "%lu//%lu %lu//%lu %lu//%lu\n",
-                                     &indices[0],
-                                     &indices[1],
-                                     &indices[2],
-                                     &indices[6],
-                                     &indices[7],
-                                     &indices[8]))
-                {
-                    bReadNormalIndices = true;
-                    bReadVertexIndices = true;
-                }
-                else if (std::sscanf(line.c_str() + 1, "%lu %lu %lu\\n",
-                                     &indices[0],
-                                     &indices[1],
-                                     &indices[2]))
+                auto &&first = faceOffsets[face];
+                auto &&numVertices = faceOffsets[face + 1] - first;
+                Vector3d centroid(0.0, 0.0, 0.0), fileNormal(0.0, 0.0, 0.0), normal(0.0, 0.0, 0.0);
+                bool bFileNormals = true;
+                for (std::size_t i = 0; i < numVertices; ++i)
                 {
-                    bReadVertexIndices = true;
+                    auto *pVertex = &vertices[3 * vertexIndices[first + i]];
+                    auto *pNext = &vertices[3 * vertexIndices[first + (i + 1) % numVertices]];
+                    normal[0] += (pVertex[1] - pNext[1]) * (pVertex[2] + pNext[2]);
+                    normal[1] += (pVertex[2] - pNext[2]) * (pVertex[0] + pNext[0]);
+                    normal[2] += (pVertex[0] - pNext[0]) * (pVertex[1] + pNext[1]);
+                    centroid += Vector3d(pVertex[0], pVertex[1], pVertex[2]);
+
+                    auto &&normalIndex = normalIndices[first + i];
+                    bFileNormals &= (normalIndex != utilities::ObjFileReader::NO_INDEX);
+                    if (bFileNormals)
+                    {
+                        auto *pNormal = &normals[3 * normalIndex];
+                        fileNormal += Vector3d(pNormal[0], pNormal[1], pNormal[2]);
+                    }
                 }
-                else
-                {
-                    logMsg(std::cout, LoggingLevel::Enum::Error,
-                           "Failed to parse 3-d object file \"" + filename + "\"!\n",
-                           getQualifiedMethodName(__func__));
 
-                    return false;
-                }
+                if (bFileNormals && normal.dot(fileNormal) < 0.0)
+                    normal = -normal;
 
-                if (bReadNormalIndices)
-                {
-                    // store normal indices
-                    normalIndices.push_back(indices[2]);
-                    normalIndices.push_back(indices[5]);
-                    normalIndices.push_back(indices[8]);
-                }
+                centroid /= double(numVertices);
+                Plane plane(normal, centroid);
 
-                if (bReadTextureIndices)
-                {
-                    // store texture indices
-                    textureIndices.push_back(indices[1]);
-                    textureIndices.push_back(indices[4]);
-                    textureIndices.push_back(indices[7]);
-                }
+                // determine the rotation which takes the plane's normal onto the z-axis
+                auto &&angle = plane.getNormal().calcAngle(zAxis, AngleUnitType::Radians);
+                Vector3d axis(plane.getNormal());
+                axis.cross(zAxis);
+                axis.unitize();
 
-                if (bReadVertexIndices)
+                auto &&polygon = m_polygons[face];
+                auto &&polygonVertices = polygon.getVertices();
+                polygonVertices.resize(numVertices);
+                for (std::size_t i = 0; i < numVertices; ++i)
                 {
-                    // store vertex indices
-                    vertexIndices.push_back(indices[0]);
-                    vertexIndices.push_back(indices[3]);
-                    vertexIndices.push_back(indices[6]);
+                    auto *pVertex = &vertices[3 * vertexIndices[first + i]];
+                    plane.project(Vector3d(pVertex[0], pVertex[1], pVertex[2]), polygonVertices[i], angle, axis,
+                                  AngleUnitType::Radians);
                 }
 
-                ++numTriangles;
+                polygon.setPlane(plane);
             }
+        };
 
-            iss.clear();
-        }
-
-        Triangle triangle;
-        m_polygons.resize(numTriangles);
-        std::size_t polygonIndex = 0;
-        while (polygonIndex < numTriangles)
+        auto &&numFaces = m_polygons.size();
+        auto numThreads = std::min(getMaximumThreads(), numFaces / MINIMUM_FACES_PER_THREAD);
+        if (numThreads <= 1)
+            function(0, numFaces);
+        else
         {
-            auto i = 3 * polygonIndex + 0;
-            auto j = 3 * polygonIndex + 1;
-            auto k = 3 * polygonIndex + 2;
-
-            auto &&polygon = m_polygons[polygonIndex];
-            triangle.from3dVertices(vertices[vertexIndices[i]],
-                                    vertices[vertexIndices[j]],
-                                    vertices[vertexIndices[k]]);
-
-            auto &&plane = polygon.getPlane();
-            if (k < normals.size())
-            {
-                if (normalIndices[i] == normalIndices[j] &&
-                    normalIndices[i] == normalIndices[k])
-                {
-                    plane.setNormal(normals[normalIndices[i]]);
-                }
-                else
-                {
-                    logMsg(std::cout, LoggingLevel::Enum::Error,
-                           "Normal vector indices do not agree at face index " +
-                           std::to_string(polygonIndex) + " in file \"" + filename + "\"!\n",
-                           getQualifiedMethodName(__func__));
-
-                    return false;
-                }
-            }
-            else
-            {
-                plane.setNormal(triangle.getPlane().getNormal());
-            }
-
-            polygon.add(triangle.getVertexOne());
-            polygon.add(triangle.getVertexTwo());
-            polygon.add(triangle.getVertexThree());
-
-            ++polygonIndex;
+            ::utilities::ThreadPool<bool> threadPool(numThreads);
+            threadPool.forEachRange(numFaces, numThreads, 1, function);
         }
     }
-    else
-    {
-        logMsg(std::cout, LoggingLevel::Enum::Error,
-               "Failed to open 3-d object file \"" + filename + "\"!\n",
-               getQualifiedMethodName(__func__));
-    }
-
-    stream.close();
 
     return bSuccess;
 }
@@ -452,6 +464,8 @@ bool PolygonMesh::readObjFile(const std::string &filename)
  */
 PolygonMesh::reverse_iterator PolygonMesh::rend(void)
 {
+    m_bBoundingVolumeHierarchyValid = false;
+
     return m_polygons.rend();
 }
 
@@ -460,14 +474,24 @@ PolygonMesh::reverse_iterator PolygonMesh::rend(void)
  */
 void PolygonMesh::resize(std::size_t size)
 {
+    m_bBoundingVolumeHierarchyValid = false;
     m_polygons.resize(size);
 }
 
+/**
+ * Set the maximum number of threads used to build the bounding-volume hierarchy and process batches of rays
+ */
+void PolygonMesh::setMaximumThreads(std::size_t maximumThreads)
+{
+    m_pBoundingVolumeHierarchy->setMaximumThreads(maximumThreads);
+}
+
 /**
  * Set this object's polygons
  */
 void PolygonMesh::setPolygons(const std::vector<Polygon> &polygons)
 {
+    m_bBoundingVolumeHierarchyValid = false;
     m_polygons = polygons;
 }
 
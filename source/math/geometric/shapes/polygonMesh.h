@@ -7,6 +7,8 @@
 #include "polygon.h"
 #include "reverse_iterable.h"
 #include "shape3d.h"
+#include <limits>
+#include <memory>
 
 namespace math
 {
@@ -17,8 +19,14 @@ namespace geometric
 namespace shapes
 {
 
+// forward declarations
+namespace utilities { class BoundingVolumeHierarchy; }
+
 /**
- * This object represents a polyhedral object as a collection of polygons
+ * This object represents a polyhedral object as a collection of polygons. Ray intersection queries are
+ * answered by a bounding-volume hierarchy built over the triangulated polygons, which is (re)built upon the
+ * first query following any change to the mesh; since non-const access to the polygons (via getPolygons(),
+ * the subscript operator or iterators) may modify them, such access also causes the hierarchy to be rebuilt
  */
 class PolygonMesh
 : public attributes::abstract::Iterable<iterators::Iterator, std::vector<Polygon>,
@@ -98,6 +106,11 @@ public:
      */
     EXPORT_STEM virtual double calcVolume(void) const override;
 
+    /**
+     * Build the bounding-volume hierarchy over this mesh's triangulated polygons
+     */
+    EXPORT_STEM virtual bool buildBoundingVolumeHierarchy(void) final;
+
     /**
      * cbegin() overload
      */
@@ -153,11 +166,23 @@ public:
      */
     EXPORT_STEM virtual std::string getClassName(void) const override;
 
+    /**
+     * Get the bounding-volume hierarchy built over this mesh's triangulated polygons, (re)building it if
+     * necessary
+     */
+    EXPORT_STEM virtual utilities::BoundingVolumeHierarchy &getBoundingVolumeHierarchy(void) final;
+
     /**
      * Get the factory name of this constructible
      */
     EXPORT_STEM virtual std::string getFactoryName(void) const override final;
 
+    /**
+     * Get the maximum number of threads used to build the bounding-volume hierarchy and process batches of
+     * rays
+     */
+    EXPORT_STEM virtual std::size_t getMaximumThreads(void) const final;
+
     /**
      * Get this object's polygons
      */
@@ -170,13 +195,33 @@ public:
     EXPORT_STEM virtual bool intersect(const Ray &ray,
                                        RayIntersection &intersection) override;
 
+    /**
+     * Calculate the closest location at which each of a batch of rays intersects this shape; returns true if
+     * at least one intersection occurs
+     * @param rays          the rays
+     * @param intersections upon return, contains the closest intersection of each ray (empty if none)
+     * @param pPolygons     if non-null, upon return contains the index of the polygon intersected by each ray
+     *                      (or the number of polygons, if none)
+     */
+    EXPORT_STEM virtual bool intersect(const std::vector<Ray> &rays,
+                                       std::vector<RayIntersection> &intersections,
+                                       std::vector<std::size_t> *pPolygons = nullptr) final;
+
+    /**
+     * Determine whether or not a ray intersects this shape at a ray parameter less than the specified maximum
+     * distance, e.g., to test line-of-sight between the ray origin and the point at the maximum distance
+     */
+    EXPORT_STEM virtual bool isOccluded(const Ray &ray,
+                                        double maximumDistance = std::numeric_limits<double>::infinity()) final;
+
     /**
      * rbegin() overload
      */
     EXPORT_STEM virtual reverse_iterator rbegin(void) override;
 
     /**
-     * Function to read a standard obj file and populate this object's polygons
+     * Function to read a standard obj file and populate this object's polygons; each face of the file becomes a
+     * polygon. The file is parsed using up to the maximum number of threads (see setMaximumThreads())
      */
     EXPORT_STEM virtual bool readObjFile(const std::string &filename);
 
@@ -190,6 +235,11 @@ public:
      */
     EXPORT_STEM virtual void resize(std::size_t size);
 
+    /**
+     * Set the maximum number of threads used to build the bounding-volume hierarchy and process batches of rays
+     */
+    EXPORT_STEM virtual void setMaximumThreads(std::size_t maximumThreads) final;
+
     /**
      * Set this object's polygons
      */
@@ -202,10 +252,25 @@ public:
 
 private:
 
+    /**
+     * flag indicating whether or not the bounding-volume hierarchy is consistent with this object's polygons
+     */
+    bool m_bBoundingVolumeHierarchyValid;
+
+    /**
+     * the bounding-volume hierarchy built over this object's triangulated polygons
+     */
+    std::unique_ptr<utilities::BoundingVolumeHierarchy> m_pBoundingVolumeHierarchy;
+
     /**
      * this object's polygons
      */
     std::vector<Polygon> m_polygons;
+
+    /**
+     * the index of the polygon from which each triangle in the bounding-volume hierarchy originates
+     */
+    std::vector<std::size_t> m_triangleToPolygon;
 };
 
 }
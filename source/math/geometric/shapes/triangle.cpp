@@ -290,7 +290,7 @@ void Triangle::from3dVertices(const Vector3d &vertex1,
 
     // determine the angle between the normal vector and the z-axis
     Vector3d zAxis(0.0, 0.0, 1.0);
-    auto angle = m_plane.getNormal().calcAngle(zAxis);
+    auto angle = m_plane.getNormal().calcAngle(zAxis, AngleUnitType::Radians);
 
     // determine the axis of rotation
     Vector3d axis(m_plane.getNormal());
@@ -525,11 +525,11 @@ void Triangle::to3dVertices(Vector3d &vertex1,
 {
     // determine the angle between the normal vector and the z-axis
     Vector3d zAxis(0.0, 0.0, 1.0);
-    auto angle = zAxis.calcAngle(m_plane.getNormal());
+    auto angle = m_plane.getNormal().calcAngle(zAxis, AngleUnitType::Radians);
 
     // determine the axis of rotation
-    Vector3d axis(zAxis);
-    axis.cross(m_plane.getNormal());
+    Vector3d axis(m_plane.getNormal());
+    axis.cross(zAxis);
     axis.unitize();
 
     m_plane.unproject(m_vertices[0], vertex1, angle, axis, AngleUnitType::Radians);
@@ -0,0 +1,888 @@
+#include "boundingVolumeHierarchy.h"
+#include "ray.h"
+#include "rayIntersection.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+// using namespace declarations
+using namespace math::linear_algebra::vector;
+using namespace utilities;
+
+namespace math
+{
+
+namespace geometric
+{
+
+namespace shapes
+{
+
+namespace utilities
+{
+
+// type alias declarations
+using Node = BoundingVolumeHierarchy::Node;
+using TriangleData = BoundingVolumeHierarchy::TriangleData;
+
+/**
+ * the maximum depth of the hierarchy; nodes at this depth become leaves regardless of their size
+ */
+static constexpr std::size_t MAXIMUM_DEPTH = 48;
+
+/**
+ * the maximum number of triangles in a leaf, unless the triangles cannot be separated
+ */
+static constexpr std::size_t MAXIMUM_LEAF_SIZE = 4;
+
+/**
+ * the minimum number of rays processed by each thread when a batch is split across multiple threads
+ */
+static constexpr std::size_t MINIMUM_RAYS_PER_THREAD = 256;
+
+/**
+ * the minimum number of triangles in a subtree built by a separate thread
+ */
+static constexpr std::size_t MINIMUM_TRIANGLES_PER_THREAD = 4096;
+
+/**
+ * the number of bins per axis over which the surface area heuristic is evaluated
+ */
+static constexpr std::size_t NUM_BINS = 16;
+
+/**
+ * the number of rays traversed together in a packet
+ */
+static constexpr std::size_t PACKET_SIZE = 8;
+
+/**
+ * the capacity of the traversal stack, which must be at least the maximum depth of the hierarchy
+ */
+static constexpr std::size_t STACK_SIZE = 64;
+
+/**
+ * Function to calculate the surface area of an axis-aligned box
+ */
+inline static double calcArea(const double lower[3],
+                              const double upper[3])
+{
+    auto &&dx = upper[0] - lower[0];
+    auto &&dy = upper[1] - lower[1];
+    auto &&dz = upper[2] - lower[2];
+
+    return 2.0 * (dx * dy + dy * dz + dz * dx);
+}
+
+/**
+ * Function to grow an axis-aligned box so that it contains another box
+ */
+inline static void growBox(double lower[3],
+                           double upper[3],
+                           const double otherLower[3],
+                           const double otherUpper[3])
+{
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        lower[i] = std::min(lower[i], otherLower[i]);
+        upper[i] = std::max(upper[i], otherUpper[i]);
+    }
+}
+
+/**
+ * Function to determine whether or not a ray intersects an axis-aligned box at a ray parameter between zero
+ * and the specified maximum
+ */
+inline static bool intersectBox(const Node &node,
+                                const double origin[3],
+                                const double inverseDirection[3],
+                                double tMax)
+{
+    double tNear = 0.0, tFar = tMax;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        auto &&t1 = (node.m_lower[i] - origin[i]) * inverseDirection[i];
+        auto &&t2 = (node.m_upper[i] - origin[i]) * inverseDirection[i];
+        tNear = std::max(tNear, std::min(t1, t2));
+        tFar = std::min(tFar, std::max(t1, t2));
+    }
+
+    return tNear <= tFar;
+}
+
+/**
+ * Function to determine whether or not a ray intersects a triangle (from either side) at a non-negative ray
+ * parameter, using the Moller-Trumbore algorithm
+ */
+inline static bool intersectTriangle(const TriangleData &triangle,
+                                     const double origin[3],
+                                     const double direction[3],
+                                     double &t)
+{
+    auto *e1 = triangle.m_edgeOne;
+    auto *e2 = triangle.m_edgeTwo;
+    double p[3] = { direction[1] * e2[2] - direction[2] * e2[1],
+                    direction[2] * e2[0] - direction[0] * e2[2],
+                    direction[0] * e2[1] - direction[1] * e2[0] };
+
+    auto &&determinant = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+    if (determinant == 0.0)
+        return false; // the ray is parallel to the triangle, or the triangle is degenerate
+
+    auto &&inverseDeterminant = 1.0 / determinant;
+    double s[3] = { origin[0] - triangle.m_vertex[0],
+                    origin[1] - triangle.m_vertex[1],
+                    origin[2] - triangle.m_vertex[2] };
+
+    auto &&u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inverseDeterminant;
+    if (u < 0.0 || u > 1.0)
+        return false;
+
+    double q[3] = { s[1] * e1[2] - s[2] * e1[1],
+                    s[2] * e1[0] - s[0] * e1[2],
+                    s[0] * e1[1] - s[1] * e1[0] };
+
+    auto &&v = (direction[0] * q[0] + direction[1] * q[1] + direction[2] * q[2]) * inverseDeterminant;
+    if (v < 0.0 || u + v > 1.0)
+        return false;
+
+    t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inverseDeterminant;
+
+    return t >= 0.0;
+}
+
+/**
+ * Constructor
+ */
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(void)
+: m_parallelDepth(0),
+  m_maximumThreads(1)
+{
+
+}
+
+/**
+ * Copy constructor
+ */
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const BoundingVolumeHierarchy &hierarchy)
+: m_parallelDepth(0),
+  m_maximumThreads(1)
+{
+    operator = (hierarchy);
+}
+
+/**
+ * Move constructor
+ */
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(BoundingVolumeHierarchy &&hierarchy)
+: m_parallelDepth(0),
+  m_maximumThreads(1)
+{
+    operator = (std::move(hierarchy));
+}
+
+/**
+ * Destructor
+ */
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy(void)
+{
+
+}
+
+/**
+ * Copy assignment operator
+ */
+BoundingVolumeHierarchy &BoundingVolumeHierarchy::operator = (const BoundingVolumeHierarchy &hierarchy)
+{
+    if (&hierarchy != this)
+    {
+        setMaximumThreads(hierarchy.m_maximumThreads);
+        m_nodes = hierarchy.m_nodes;
+        m_triangleIndices = hierarchy.m_triangleIndices;
+        m_triangles = hierarchy.m_triangles;
+    }
+
+    return *this;
+}
+
+/**
+ * Move assignment operator
+ */
+BoundingVolumeHierarchy &BoundingVolumeHierarchy::operator = (BoundingVolumeHierarchy &&hierarchy)
+{
+    if (&hierarchy != this)
+    {
+        m_maximumThreads = std::move(hierarchy.m_maximumThreads);
+        m_nodes = std::move(hierarchy.m_nodes);
+        m_pThreadPool = std::move(hierarchy.m_pThreadPool);
+        m_triangleIndices = std::move(hierarchy.m_triangleIndices);
+        m_triangles = std::move(hierarchy.m_triangles);
+    }
+
+    return *this;
+}
+
+/**
+ * Build the hierarchy over a set of triangles; returns false if the number of vertices is not a multiple of
+ * three
+ * @param vertices the triangle vertices, three consecutive vertices per triangle; triangle indices reported
+ *                 by queries refer to the order of the triangles in this vector
+ */
+bool BoundingVolumeHierarchy::build(const std::vector<Vector3d> &vertices)
+{
+    auto &&numTriangles = vertices.size() / 3;
+    bool bSuccess = (3 * numTriangles == vertices.size() &&
+                     numTriangles < std::numeric_limits<std::uint32_t>::max());
+    if (bSuccess)
+    {
+        clear();
+
+        // store the triangles in the form used by the intersection test, along with their bounds and centroids
+        m_buildBounds.resize(9 * numTriangles);
+        m_triangleIndices.resize(numTriangles);
+        m_triangles.resize(numTriangles);
+        for (std::size_t i = 0; i < numTriangles; ++i)
+        {
+            auto &&a = vertices[3 * i];
+            auto &&b = vertices[3 * i + 1];
+            auto &&c = vertices[3 * i + 2];
+            auto *pBounds = &m_buildBounds[9 * i];
+            auto &&triangle = m_triangles[i];
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                triangle.m_vertex[j] = a[j];
+                triangle.m_edgeOne[j] = b[j] - a[j];
+                triangle.m_edgeTwo[j] = c[j] - a[j];
+                pBounds[j] = std::min(a[j], std::min(b[j], c[j]));
+                pBounds[3 + j] = std::max(a[j], std::max(b[j], c[j]));
+                pBounds[6 + j] = (a[j] + b[j] + c[j]) / 3.0;
+            }
+
+            m_triangleIndices[i] = std::uint32_t(i);
+        }
+
+        if (numTriangles > 0)
+        {
+            // subtrees near the root are built in parallel; with a parallel depth of d, at most 2^d - 1 builds
+            // are submitted to the pool, each of which may block waiting for its own right subtree, so the pool
+            // always has a free worker for the next submitted build
+            m_parallelDepth = 0;
+            if (m_maximumThreads > 1 && numTriangles >= 2 * MINIMUM_TRIANGLES_PER_THREAD)
+            {
+                while ((std::size_t(2) << m_parallelDepth) <= m_maximumThreads)
+                    ++m_parallelDepth;
+
+                if (m_pThreadPool == nullptr)
+                    m_pThreadPool.reset(new ::utilities::ThreadPool<bool>(m_maximumThreads));
+            }
+
+            m_nodes.reserve(2 * numTriangles / MAXIMUM_LEAF_SIZE + 1);
+            buildNode(0, numTriangles, 0, m_nodes);
+
+            // store the triangles in leaf order
+            std::vector<TriangleData> triangles(numTriangles);
+            for (std::size_t i = 0; i < numTriangles; ++i)
+                triangles[i] = m_triangles[m_triangleIndices[i]];
+
+            m_triangles.swap(triangles);
+        }
+
+        std::vector<double>().swap(m_buildBounds);
+    }
+    else
+    {
+        logMsg(std::cout, LoggingLevel::Enum::Warning,
+               "The number of vertices must be a multiple of three.\n",
+               getQualifiedMethodName(__func__));
+    }
+
+    return bSuccess;
+}
+
+/**
+ * Build the subtree over a range of triangles, appending its nodes to the input vector in depth-first order;
+ * node offsets are relative to the beginning of the vector
+ * @param begin the index of the first triangle in the range
+ * @param end   one past the index of the last triangle in the range
+ * @param depth the depth of the subtree's root node
+ * @param nodes the vector to which nodes are appended
+ */
+void BoundingVolumeHierarchy::buildNode(std::size_t begin,
+                                        std::size_t end,
+                                        std::size_t depth,
+                                        std::vector<Node> &nodes)
+{
+    static constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    auto &&nodeIndex = nodes.size();
+    nodes.emplace_back();
+
+    // compute the bounds of the triangles and of their centroids
+    Node node;
+    double centroidLower[3] = { infinity, infinity, infinity };
+    double centroidUpper[3] = { -infinity, -infinity, -infinity };
+    std::fill(node.m_lower, node.m_lower + 3, infinity);
+    std::fill(node.m_upper, node.m_upper + 3, -infinity);
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        auto *pBounds = &m_buildBounds[9 * m_triangleIndices[i]];
+        growBox(node.m_lower, node.m_upper, pBounds, pBounds + 3);
+        growBox(centroidLower, centroidUpper, pBounds + 6, pBounds + 6);
+    }
+
+    // evaluate the surface area heuristic at the bin boundaries along each axis
+    auto &&count = end - begin;
+    std::size_t bestAxis = 3, bestBin = 0;
+    double bestCost = infinity;
+    if (count > MAXIMUM_LEAF_SIZE && depth < MAXIMUM_DEPTH)
+    {
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            auto &&extent = centroidUpper[axis] - centroidLower[axis];
+            if (!(extent > 0.0))
+                continue;
+
+            std::size_t binCounts[NUM_BINS] = { 0 };
+            double binLower[NUM_BINS][3], binUpper[NUM_BINS][3];
+            for (std::size_t bin = 0; bin < NUM_BINS; ++bin)
+            {
+                std::fill(binLower[bin], binLower[bin] + 3, infinity);
+                std::fill(binUpper[bin], binUpper[bin] + 3, -infinity);
+            }
+
+            auto &&scale = NUM_BINS / extent;
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                auto *pBounds = &m_buildBounds[9 * m_triangleIndices[i]];
+                auto bin = std::min(NUM_BINS - 1, std::size_t((pBounds[6 + axis] - centroidLower[axis]) * scale));
+                growBox(binLower[bin], binUpper[bin], pBounds, pBounds + 3);
+                ++binCounts[bin];
+            }
+
+            // sweep from the right to accumulate the areas and counts to the right of each boundary
+            double rightAreas[NUM_BINS], lower[3], upper[3];
+            std::size_t rightCounts[NUM_BINS], rightCount = 0;
+            std::fill(lower, lower + 3, infinity);
+            std::fill(upper, upper + 3, -infinity);
+            for (std::size_t bin = NUM_BINS - 1; bin > 0; --bin)
+            {
+                growBox(lower, upper, binLower[bin], binUpper[bin]);
+                rightCount += binCounts[bin];
+                rightAreas[bin] = calcArea(lower, upper);
+                rightCounts[bin] = rightCount;
+            }
+
+            // sweep from the left, evaluating the cost of splitting after each bin
+            std::size_t leftCount = 0;
+            std::fill(lower, lower + 3, infinity);
+            std::fill(upper, upper + 3, -infinity);
+            for (std::size_t bin = 0; bin + 1 < NUM_BINS; ++bin)
+            {
+                growBox(lower, upper, binLower[bin], binUpper[bin]);
+                leftCount += binCounts[bin];
+                if (leftCount > 0 && rightCounts[bin + 1] > 0)
+                {
+                    auto &&cost = leftCount * calcArea(lower, upper) + rightCounts[bin + 1] * rightAreas[bin + 1];
+                    if (cost < bestCost)
+                    {
+                        bestAxis = axis;
+                        bestBin = bin;
+                        bestCost = cost;
+                    }
+                }
+            }
+        }
+    }
+
+    if (bestAxis == 3)
+    {
+        // create a leaf
+        node.m_axis = 0;
+        node.m_count = std::uint32_t(count);
+        node.m_offset = std::uint32_t(begin);
+        nodes[nodeIndex] = node;
+
+        return;
+    }
+
+    // partition the triangles about the chosen bin boundary
+    auto &&lower = centroidLower[bestAxis];
+    auto &&scale = NUM_BINS / (centroidUpper[bestAxis] - centroidLower[bestAxis]);
+    auto &&itMiddle = std::partition(m_triangleIndices.begin() + begin, m_triangleIndices.begin() + end,
+                                     [this, bestAxis, bestBin, lower, scale] (std::uint32_t index)
+                                     {
+                                         auto &&centroid = m_buildBounds[9 * index + 6 + bestAxis];
+
+                                         return std::min(NUM_BINS - 1, std::size_t((centroid - lower) * scale)) <=
+                                                bestBin;
+                                     });
+
+    auto &&middle = std::size_t(itMiddle - m_triangleIndices.begin());
+    node.m_axis = std::uint32_t(bestAxis);
+    node.m_count = 0;
+    if (m_pThreadPool != nullptr && depth < m_parallelDepth && count >= 2 * MINIMUM_TRIANGLES_PER_THREAD)
+    {
+        // build the right subtree on a worker thread, then append its nodes after those of the left subtree
+        std::vector<Node> rightNodes;
+        auto &&future = m_pThreadPool->submit([this, middle, end, depth, &rightNodes] (void)
+        {
+            buildNode(middle, end, depth + 1, rightNodes);
+
+            return true;
+        });
+
+        buildNode(begin, middle, depth + 1, nodes);
+        future.get();
+
+        auto &&offset = nodes.size();
+        for (auto &&rightNode : rightNodes)
+        {
+            if (rightNode.m_count == 0)
+                rightNode.m_offset += std::uint32_t(offset);
+
+            nodes.push_back(rightNode);
+        }
+
+        node.m_offset = std::uint32_t(offset);
+    }
+    else
+    {
+        buildNode(begin, middle, depth + 1, nodes);
+        node.m_offset = std::uint32_t(nodes.size());
+        buildNode(middle, end, depth + 1, nodes);
+    }
+
+    nodes[nodeIndex] = node;
+}
+
+/**
+ * Clear the hierarchy
+ */
+void BoundingVolumeHierarchy::clear(void)
+{
+    m_nodes.clear();
+    m_triangleIndices.clear();
+    m_triangles.clear();
+}
+
+/**
+ * Determine whether or not the hierarchy is empty
+ */
+bool BoundingVolumeHierarchy::empty(void) const
+{
+    return m_triangles.empty();
+}
+
+/**
+ * Get the name of this class
+ */
+std::string BoundingVolumeHierarchy::getClassName(void) const
+{
+    return "BoundingVolumeHierarchy";
+}
+
+/**
+ * Get the maximum number of threads used to build the hierarchy and process batches of rays (default is one,
+ * i.e., single-threaded)
+ */
+std::size_t BoundingVolumeHierarchy::getMaximumThreads(void) const
+{
+    return m_maximumThreads;
+}
+
+/**
+ * Get the flattened nodes of the hierarchy
+ */
+const std::vector<Node> &BoundingVolumeHierarchy::getNodes(void) const
+{
+    return m_nodes;
+}
+
+/**
+ * Get the number of triangles in the hierarchy
+ */
+std::size_t BoundingVolumeHierarchy::getNumTriangles(void) const
+{
+    return m_triangles.size();
+}
+
+/**
+ * Calculate the locations at which a ray intersects the triangles, in order of increasing distance along the
+ * ray; returns true if at least one intersection occurs
+ */
+bool BoundingVolumeHierarchy::intersect(const Ray &ray,
+                                        RayIntersection &intersection) const
+{
+    std::vector<double> hits;
+    auto &&infinity = std::numeric_limits<double>::infinity();
+    traverse(ray, infinity, [&hits, infinity] (double t, std::size_t)
+    {
+        hits.push_back(t);
+
+        return infinity;
+    });
+
+    // a ray that passes through an edge or vertex shared by several triangles intersects each of them at the
+    // same location; report such locations once
+    std::sort(hits.begin(), hits.end());
+    intersection.clear();
+    for (std::size_t i = 0; i < hits.size(); ++i)
+    {
+        if (i == 0 || hits[i] - hits[i - 1] > 1.0e-12 * std::max(1.0, std::fabs(hits[i])))
+            intersection.add(ray.getPosition(hits[i]));
+    }
+
+    return !intersection.empty();
+}
+
+/**
+ * Find the closest intersection of a ray with the triangles; returns true if an intersection occurs
+ * @param ray             the ray
+ * @param t               upon success, contains the ray parameter of the intersection
+ * @param triangle        upon success, contains the index of the intersected triangle
+ * @param maximumDistance the maximum ray parameter at which intersections are reported
+ */
+bool BoundingVolumeHierarchy::intersect(const Ray &ray,
+                                        double &t,
+                                        std::size_t &triangle,
+                                        double maximumDistance) const
+{
+    bool bIntersects = false;
+    traverse(ray, maximumDistance, [this, &bIntersects, &t, &triangle] (double tHit, std::size_t index)
+    {
+        bIntersects = true;
+        t = tHit;
+        triangle = m_triangleIndices[index];
+
+        return tHit;
+    });
+
+    return bIntersects;
+}
+
+/**
+ * Find the closest intersection of each of a batch of rays with the triangles; consecutive rays whose directions
+ * lie in the same octant are traversed together in packets (others are traced individually), and packets may be
+ * split across multiple threads. Returns true if at least one intersection occurs
+ * @param rays          the rays
+ * @param intersections upon return, contains the closest intersection of each ray (empty if none)
+ * @param pTriangles    if non-null, upon return contains the index of the triangle intersected by each ray (or
+ *                      the number of triangles, if none)
+ */
+bool BoundingVolumeHierarchy::intersect(const std::vector<Ray> &rays,
+                                        std::vector<RayIntersection> &intersections,
+                                        std::vector<std::size_t> *pTriangles)
+{
+    auto &&numRays = rays.size();
+    intersections.resize(numRays);
+    std::vector<std::size_t> triangles;
+    if (pTriangles == nullptr)
+        pTriangles = &triangles;
+
+    pTriangles->resize(numRays);
+
+    // order the rays by direction (octant first, then along a Morton curve over the direction's components), so
+    // that the rays grouped into each packet are as coherent as possible
+    std::vector<std::pair<std::uint64_t, std::size_t>> order(numRays);
+    for (std::size_t i = 0; i < numRays; ++i)
+    {
+        auto &&direction = rays[i].getDirection();
+        auto &&magnitude = direction.magnitude();
+        std::uint64_t key = 0;
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            auto &&component = magnitude > 0.0 ? direction[j] / magnitude : 0.0;
+            auto &&quantized = static_cast<std::uint64_t>(std::min(1023.0, 512.0 * (component + 1.0)));
+            for (std::size_t bit = 0; bit < 10; ++bit)
+                key |= ((quantized >> bit) & 1) << (3 * bit + j);
+
+            key |= std::uint64_t(std::signbit(component)) << (30 + j);
+        }
+
+        order[i] = std::make_pair(key, i);
+    }
+
+    std::sort(order.begin(), order.end());
+
+    std::atomic<bool> bIntersects(false);
+    auto &&function = [this, &bIntersects, &intersections, &order, pTriangles, &rays] (std::size_t begin,
+                                                                                       std::size_t end)
+    {
+        bool bRangeIntersects = false;
+        const Ray *pPacketRays[PACKET_SIZE];
+        std::size_t packetTriangles[PACKET_SIZE];
+        double t[PACKET_SIZE];
+        for (std::size_t packet = begin; packet < end; packet += PACKET_SIZE)
+        {
+            auto numPacketRays = std::min(PACKET_SIZE, end - packet);
+            for (std::size_t i = 0; i < numPacketRays; ++i)
+                pPacketRays[i] = &rays[order[packet + i].second];
+
+            intersectPacket(pPacketRays, numPacketRays, t, packetTriangles);
+            for (std::size_t i = 0; i < numPacketRays; ++i)
+            {
+                auto &&index = order[packet + i].second;
+                auto &&intersection = intersections[index];
+                intersection.clear();
+                (*pTriangles)[index] = packetTriangles[i];
+                if (std::isfinite(t[i]))
+                {
+                    intersection.add(rays[index].getPosition(t[i]));
+                    bRangeIntersects = true;
+                }
+            }
+        }
+
+        if (bRangeIntersects)
+            bIntersects.store(true, std::memory_order_relaxed);
+    };
+
+    auto numThreads = std::min(m_maximumThreads, numRays / MINIMUM_RAYS_PER_THREAD);
+    if (numThreads <= 1)
+        function(0, numRays);
+    else
+    {
+        if (m_pThreadPool == nullptr)
+            m_pThreadPool.reset(new ::utilities::ThreadPool<bool>(m_maximumThreads));
+
+        // range boundaries fall on packet boundaries
+        m_pThreadPool->forEachRange(numRays, numThreads, PACKET_SIZE, function);
+    }
+
+    return bIntersects.load();
+}
+
+/**
+ * Find the closest intersections of a packet of rays with the triangles
+ * @param ppRays    pointers to the rays in the packet
+ * @param numRays   the number of rays in the packet
+ * @param t         upon return, contains the ray parameter of each ray's closest intersection (infinite if none)
+ * @param triangles upon return, contains the index of the triangle intersected by each ray
+ */
+void BoundingVolumeHierarchy::intersectPacket(const Ray *const *ppRays,
+                                              std::size_t numRays,
+                                              double *t,
+                                              std::size_t *triangles) const
+{
+    // packets only pay off when their rays traverse similar paths through the hierarchy; rays whose directions
+    // do not all lie in the same octant are traced individually
+    bool bCoherent = true;
+    auto &&firstDirection = ppRays[0]->getDirection();
+    for (std::size_t lane = 1; bCoherent && lane < numRays; ++lane)
+    {
+        auto &&laneDirection = ppRays[lane]->getDirection();
+        for (std::size_t i = 0; bCoherent && i < 3; ++i)
+            bCoherent = std::signbit(laneDirection[i]) == std::signbit(firstDirection[i]);
+    }
+
+    if (!bCoherent)
+    {
+        for (std::size_t lane = 0; lane < numRays; ++lane)
+        {
+            t[lane] = std::numeric_limits<double>::infinity();
+            triangles[lane] = m_triangles.size();
+            intersect(*ppRays[lane], t[lane], triangles[lane]);
+        }
+
+        return;
+    }
+
+    // store the packet in structure-of-arrays form
+    double direction[3][PACKET_SIZE], inverseDirection[3][PACKET_SIZE], origin[3][PACKET_SIZE];
+    double tMax[PACKET_SIZE];
+    std::size_t hits[PACKET_SIZE];
+    for (std::size_t lane = 0; lane < numRays; ++lane)
+    {
+        auto &&rayDirection = ppRays[lane]->getDirection();
+        auto &&rayOrigin = ppRays[lane]->getOrigin();
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            direction[i][lane] = rayDirection[i];
+            inverseDirection[i][lane] = 1.0 / rayDirection[i];
+            origin[i][lane] = rayOrigin[i];
+        }
+
+        hits[lane] = m_triangles.size();
+        tMax[lane] = std::numeric_limits<double>::infinity();
+    }
+
+    // each stack entry carries the set of lanes which intersected the parent node, so that lanes which leave the
+    // packet's common path stop being tested against the nodes beneath it
+    std::uint32_t stack[STACK_SIZE], stackMasks[STACK_SIZE];
+    std::size_t stackSize = 0;
+    std::uint32_t index = 0, mask = (std::uint32_t(1) << numRays) - 1;
+    while (!m_nodes.empty())
+    {
+        auto &&node = m_nodes[index];
+        std::uint32_t activeMask = 0;
+        for (std::size_t lane = 0; lane < numRays; ++lane)
+        {
+            if ((mask >> lane) & 1)
+            {
+                double tNear = 0.0, tFar = tMax[lane];
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    auto &&t1 = (node.m_lower[i] - origin[i][lane]) * inverseDirection[i][lane];
+                    auto &&t2 = (node.m_upper[i] - origin[i][lane]) * inverseDirection[i][lane];
+                    tNear = std::max(tNear, std::min(t1, t2));
+                    tFar = std::min(tFar, std::max(t1, t2));
+                }
+
+                activeMask |= std::uint32_t(tNear <= tFar) << lane;
+            }
+        }
+
+        if (activeMask != 0)
+        {
+            if (node.m_count > 0)
+            {
+                for (std::size_t lane = 0; lane < numRays; ++lane)
+                {
+                    if ((activeMask >> lane) & 1)
+                    {
+                        double laneDirection[3] = { direction[0][lane], direction[1][lane], direction[2][lane] };
+                        double laneOrigin[3] = { origin[0][lane], origin[1][lane], origin[2][lane] };
+                        for (std::size_t i = node.m_offset; i < node.m_offset + node.m_count; ++i)
+                        {
+                            double tHit;
+                            if (intersectTriangle(m_triangles[i], laneOrigin, laneDirection, tHit) &&
+                                tHit < tMax[lane])
+                            {
+                                hits[lane] = i;
+                                tMax[lane] = tHit;
+                            }
+                        }
+                    }
+                }
+            }
+            else
+            {
+                // all lanes share a direction octant, so the nearer child is the same for every lane
+                auto nearIndex = index + 1, farIndex = node.m_offset;
+                if (direction[node.m_axis][0] < 0.0)
+                    std::swap(nearIndex, farIndex);
+
+                stackMasks[stackSize] = activeMask;
+                stack[stackSize++] = farIndex;
+                index = nearIndex;
+                mask = activeMask;
+
+                continue;
+            }
+        }
+
+        if (stackSize == 0)
+            break;
+
+        index = stack[--stackSize];
+        mask = stackMasks[stackSize];
+    }
+
+    for (std::size_t lane = 0; lane < numRays; ++lane)
+    {
+        auto &&bHit = hits[lane] < m_triangles.size();
+        t[lane] = bHit ? tMax[lane] : std::numeric_limits<double>::infinity();
+        triangles[lane] = bHit ? m_triangleIndices[hits[lane]] : m_triangles.size();
+    }
+}
+
+/**
+ * Determine whether or not a ray intersects any triangle at a ray parameter less than the specified maximum
+ * distance
+ */
+bool BoundingVolumeHierarchy::isOccluded(const Ray &ray,
+                                         double maximumDistance) const
+{
+    bool bOccluded = false;
+    traverse(ray, maximumDistance, [&bOccluded] (double, std::size_t)
+    {
+        bOccluded = true;
+
+        return -1.0;
+    });
+
+    return bOccluded;
+}
+
+/**
+ * Set the maximum number of threads used to build the hierarchy and process batches of rays
+ */
+void BoundingVolumeHierarchy::setMaximumThreads(std::size_t maximumThreads)
+{
+    m_maximumThreads = std::max<std::size_t>(1, maximumThreads);
+    if (m_pThreadPool != nullptr)
+        m_pThreadPool->setMaximumThreads(m_maximumThreads);
+}
+
+/**
+ * Traverse the hierarchy along a ray, invoking a function for each triangle intersected at a ray parameter less
+ * than the current maximum; the function returns the new maximum, and traversal stops if the function returns
+ * a negative value
+ * @param ray             the ray
+ * @param maximumDistance the initial maximum ray parameter
+ * @param function        a binary function object which accepts the ray parameter of an intersection and the
+ *                        index of the intersected triangle (in leaf order)
+ */
+template<typename Function>
+void BoundingVolumeHierarchy::traverse(const Ray &ray,
+                                       double maximumDistance,
+                                       Function &&function) const
+{
+    auto &&rayDirection = ray.getDirection();
+    auto &&rayOrigin = ray.getOrigin();
+    double direction[3] = { rayDirection[0], rayDirection[1], rayDirection[2] };
+    double inverseDirection[3] = { 1.0 / direction[0], 1.0 / direction[1], 1.0 / direction[2] };
+    double origin[3] = { rayOrigin[0], rayOrigin[1], rayOrigin[2] };
+
+    std::uint32_t stack[STACK_SIZE];
+    std::size_t stackSize = 0;
+    std::uint32_t index = 0;
+    auto tMax = maximumDistance;
+    while (!m_nodes.empty())
+    {
+        auto &&node = m_nodes[index];
+        if (intersectBox(node, origin, inverseDirection, tMax))
+        {
+            if (node.m_count > 0)
+            {
+                for (std::size_t i = node.m_offset; i < node.m_offset + node.m_count; ++i)
+                {
+                    double t;
+                    if (intersectTriangle(m_triangles[i], origin, direction, t) && t < tMax)
+                    {
+                        tMax = function(t, i);
+                        if (tMax < 0.0)
+                            return;
+                    }
+                }
+            }
+            else
+            {
+                // visit the nearer child first
+                auto nearIndex = index + 1, farIndex = node.m_offset;
+                if (direction[node.m_axis] < 0.0)
+                    std::swap(nearIndex, farIndex);
+
+                stack[stackSize++] = farIndex;
+                index = nearIndex;
+
+                continue;
+            }
+        }
+
+        if (stackSize == 0)
+            break;
+
+        index = stack[--stackSize];
+    }
+}
+
+}
+
+}
+
+}
+
+}
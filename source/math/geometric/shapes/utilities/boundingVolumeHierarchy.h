@@ -0,0 +1,309 @@
+#ifndef BOUNDING_VOLUME_HIERARCHY_H
+#define BOUNDING_VOLUME_HIERARCHY_H
+
+#include "export_library.h"
+#include "loggable.h"
+#include "reflective.h"
+#include "vector3d.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+// forward declarations
+namespace utilities { template<typename> class ThreadPool; }
+
+namespace math
+{
+
+namespace geometric
+{
+
+// forward declarations
+class Ray;
+class RayIntersection;
+
+namespace shapes
+{
+
+namespace utilities
+{
+
+/**
+ * This class implements a bounding-volume hierarchy over a set of triangles in 3-d space, for fast ray
+ * intersection queries. The hierarchy is built top-down using the surface area heuristic (evaluated over a
+ * fixed number of bins per axis) and stored as a flattened array of nodes in depth-first order, in which the
+ * left child of an interior node immediately follows its parent; triangles are stored in leaf order, so that
+ * each leaf references a contiguous range. Traversal uses a small, fixed-size stack and visits the nearer
+ * child first.
+ *
+ * Queries are provided for all intersections along a ray, the closest intersection, any intersection within a
+ * given distance (for line-of-sight and occlusion tests), and the closest intersections of a batch of rays,
+ * which are traversed together in packets. Construction and batch queries may be split across worker threads
+ * (see setMaximumThreads()). Single-ray queries are const and may be issued concurrently from multiple
+ * threads; building and batch queries must not overlap with any other use of the object
+ */
+class BoundingVolumeHierarchy final
+: public attributes::concrete::Loggable<std::string, std::ostream>,
+  virtual private attributes::abstract::Reflective
+{
+public:
+
+    /**
+     * Type alias declarations
+     */
+    using Vector3d = linear_algebra::vector::Vector3d;
+
+    /**
+     * This structure stores a node of the flattened hierarchy
+     */
+    struct Node
+    {
+        /**
+         * the lower corner of the node's axis-aligned bounding box
+         */
+        double m_lower[3];
+
+        /**
+         * the upper corner of the node's axis-aligned bounding box
+         */
+        double m_upper[3];
+
+        /**
+         * for interior nodes, the index of the right child; for leaves, the index of the first triangle
+         */
+        std::uint32_t m_offset;
+
+        /**
+         * the number of triangles in a leaf, or zero for interior nodes
+         */
+        std::uint32_t m_count;
+
+        /**
+         * the axis along which an interior node was split
+         */
+        std::uint32_t m_axis;
+    };
+
+    /**
+     * This structure stores a triangle in the form used by the ray-triangle intersection test
+     */
+    struct TriangleData
+    {
+        /**
+         * the first vertex
+         */
+        double m_vertex[3];
+
+        /**
+         * the edge from the first vertex to the second
+         */
+        double m_edgeOne[3];
+
+        /**
+         * the edge from the first vertex to the third
+         */
+        double m_edgeTwo[3];
+    };
+
+    /**
+     * Constructor
+     */
+    EXPORT_STEM BoundingVolumeHierarchy(void);
+
+    /**
+     * Copy constructor
+     */
+    EXPORT_STEM BoundingVolumeHierarchy(const BoundingVolumeHierarchy &hierarchy);
+
+    /**
+     * Move constructor
+     */
+    EXPORT_STEM BoundingVolumeHierarchy(BoundingVolumeHierarchy &&hierarchy);
+
+    /**
+     * Destructor
+     */
+    EXPORT_STEM virtual ~BoundingVolumeHierarchy(void) override;
+
+    /**
+     * Copy assignment operator
+     */
+    EXPORT_STEM BoundingVolumeHierarchy &operator = (const BoundingVolumeHierarchy &hierarchy);
+
+    /**
+     * Move assignment operator
+     */
+    EXPORT_STEM BoundingVolumeHierarchy &operator = (BoundingVolumeHierarchy &&hierarchy);
+
+    /**
+     * Build the hierarchy over a set of triangles; returns false if the number of vertices is not a multiple
+     * of three
+     * @param vertices the triangle vertices, three consecutive vertices per triangle; triangle indices
+     *                 reported by queries refer to the order of the triangles in this vector
+     */
+    EXPORT_STEM bool build(const std::vector<Vector3d> &vertices);
+
+    /**
+     * Clear the hierarchy
+     */
+    EXPORT_STEM void clear(void);
+
+    /**
+     * Determine whether or not the hierarchy is empty
+     */
+    EXPORT_STEM bool empty(void) const;
+
+    /**
+     * Get the name of this class
+     */
+    EXPORT_STEM virtual std::string getClassName(void) const override;
+
+    /**
+     * Get the maximum number of threads used to build the hierarchy and process batches of rays (default is
+     * one, i.e., single-threaded)
+     */
+    EXPORT_STEM std::size_t getMaximumThreads(void) const;
+
+    /**
+     * Get the flattened nodes of the hierarchy
+     */
+    EXPORT_STEM const std::vector<Node> &getNodes(void) const;
+
+    /**
+     * Get the number of triangles in the hierarchy
+     */
+    EXPORT_STEM std::size_t getNumTriangles(void) const;
+
+    /**
+     * Calculate the locations at which a ray intersects the triangles, in order of increasing distance along
+     * the ray; returns true if at least one intersection occurs
+     */
+    EXPORT_STEM bool intersect(const Ray &ray,
+                               RayIntersection &intersection) const;
+
+    /**
+     * Find the closest intersection of a ray with the triangles; returns true if an intersection occurs
+     * @param ray             the ray
+     * @param t               upon success, contains the ray parameter of the intersection
+     * @param triangle        upon success, contains the index of the intersected triangle
+     * @param maximumDistance the maximum ray parameter at which intersections are reported
+     */
+    EXPORT_STEM bool intersect(const Ray &ray,
+                               double &t,
+                               std::size_t &triangle,
+                               double maximumDistance = std::numeric_limits<double>::infinity()) const;
+
+    /**
+     * Find the closest intersection of each of a batch of rays with the triangles; consecutive rays whose
+     * directions lie in the same octant are traversed together in packets (others are traced individually), and
+     * packets may be split across multiple threads. Returns true if at least one intersection occurs
+     * @param rays          the rays
+     * @param intersections upon return, contains the closest intersection of each ray (empty if none)
+     * @param pTriangles    if non-null, upon return contains the index of the triangle intersected by each
+     *                      ray (or the number of triangles, if none)
+     */
+    EXPORT_STEM bool intersect(const std::vector<Ray> &rays,
+                               std::vector<RayIntersection> &intersections,
+                               std::vector<std::size_t> *pTriangles = nullptr);
+
+    /**
+     * Determine whether or not a ray intersects any triangle at a ray parameter less than the specified
+     * maximum distance
+     */
+    EXPORT_STEM bool isOccluded(const Ray &ray,
+                                double maximumDistance = std::numeric_limits<double>::infinity()) const;
+
+    /**
+     * Set the maximum number of threads used to build the hierarchy and process batches of rays
+     */
+    EXPORT_STEM void setMaximumThreads(std::size_t maximumThreads);
+
+private:
+
+    /**
+     * Build the subtree over a range of triangles, appending its nodes to the input vector in depth-first
+     * order; node offsets are relative to the beginning of the vector
+     * @param begin the index of the first triangle in the range
+     * @param end   one past the index of the last triangle in the range
+     * @param depth the depth of the subtree's root node
+     * @param nodes the vector to which nodes are appended
+     */
+    EXPORT_STEM void buildNode(std::size_t begin,
+                               std::size_t end,
+                               std::size_t depth,
+                               std::vector<Node> &nodes);
+
+    /**
+     * Find the closest intersections of a packet of rays with the triangles
+     * @param ppRays    pointers to the rays in the packet
+     * @param numRays   the number of rays in the packet
+     * @param t         upon return, contains the ray parameter of each ray's closest intersection (infinite
+     *                  if none)
+     * @param triangles upon return, contains the index of the triangle intersected by each ray
+     */
+    EXPORT_STEM void intersectPacket(const Ray *const *ppRays,
+                                     std::size_t numRays,
+                                     double *t,
+                                     std::size_t *triangles) const;
+
+    /**
+     * Traverse the hierarchy along a ray, invoking a function for each triangle intersected at a ray parameter
+     * less than the current maximum; the function returns the new maximum, and traversal stops if the
+     * function returns a negative value
+     * @param ray             the ray
+     * @param maximumDistance the initial maximum ray parameter
+     * @param function        a binary function object which accepts the ray parameter of an intersection and
+     *                        the index of the intersected triangle (in leaf order)
+     */
+    template<typename Function>
+    void traverse(const Ray &ray,
+                  double maximumDistance,
+                  Function &&function) const;
+
+    /**
+     * the number of levels of the hierarchy below which subtrees are built in parallel
+     */
+    std::size_t m_parallelDepth;
+
+    /**
+     * the maximum number of threads used to build the hierarchy and process batches of rays
+     */
+    std::size_t m_maximumThreads;
+
+    /**
+     * the flattened nodes of the hierarchy
+     */
+    std::vector<Node> m_nodes;
+
+    /**
+     * the thread pool used to build the hierarchy and process batches of rays; created upon first use
+     */
+    std::unique_ptr<::utilities::ThreadPool<bool>> m_pThreadPool;
+
+    /**
+     * the bounds and centroids of the triangles during construction
+     */
+    std::vector<double> m_buildBounds;
+
+    /**
+     * the original index of each triangle, in leaf order
+     */
+    std::vector<std::uint32_t> m_triangleIndices;
+
+    /**
+     * the triangles, in leaf order
+     */
+    std::vector<TriangleData> m_triangles;
+};
+
+}
+
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,701 @@
+#include "memory_mapped_file.h"
+#include "objFileReader.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+
+// using namespace declarations
+using namespace utilities;
+using namespace utilities::file_system;
+
+namespace math
+{
+
+namespace geometric
+{
+
+namespace shapes
+{
+
+namespace utilities
+{
+
+/**
+ * the minimum number of bytes parsed by each thread when a file is split across multiple threads
+ */
+static constexpr std::size_t MINIMUM_BYTES_PER_THREAD = 1 << 20;
+
+/**
+ * the bias added to face indices which are relative to the vertices read within the same chunk, so that they
+ * can be distinguished from absolute indices until the chunks are merged
+ */
+static constexpr std::int64_t RELATIVE_INDEX_BIAS = std::int64_t(1) << 62;
+
+/**
+ * the powers of ten which are exactly representable in double precision
+ */
+static constexpr double POWERS_OF_TEN[] = { 1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8,
+                                            1.0e9, 1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16,
+                                            1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22 };
+
+/**
+ * This structure stores the statements parsed from a chunk of a file. Face indices are stored as read, less
+ * one (absent indices are stored as -1), except that relative indices are stored as indices relative to the
+ * first vertex read within the chunk, plus RELATIVE_INDEX_BIAS
+ */
+struct ParsedChunk
+{
+    /**
+     * the byte offset of a malformed statement, or the size of the file if none
+     */
+    std::size_t m_errorOffset;
+
+    /**
+     * the offsets of each face's entries within the chunk's index buffers
+     */
+    std::vector<std::size_t> m_faceOffsets;
+
+    /**
+     * the normal indices of the face vertices
+     */
+    std::vector<std::int64_t> m_normalIndices;
+
+    /**
+     * the vertex normals
+     */
+    std::vector<double> m_normals;
+
+    /**
+     * the texture coordinates
+     */
+    std::vector<double> m_textureCoordinates;
+
+    /**
+     * the texture coordinate indices of the face vertices
+     */
+    std::vector<std::int64_t> m_textureIndices;
+
+    /**
+     * the geometric vertex indices of the face vertices
+     */
+    std::vector<std::int64_t> m_vertexIndices;
+
+    /**
+     * the geometric vertices
+     */
+    std::vector<double> m_vertices;
+};
+
+/**
+ * Function to determine whether or not a character is a space or tab
+ */
+inline static bool isBlank(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+/**
+ * Function to determine whether or not a position is at the end of a line
+ */
+inline static bool isEndOfLine(const char *p,
+                               const char *pEnd)
+{
+    return p == pEnd || *p == '\n' || *p == '\r';
+}
+
+/**
+ * Function to scan a floating-point number; returns false if none is present. Numbers having at most 19
+ * significant digits and a decimal exponent representable exactly are converted directly, all others are
+ * converted by the standard library
+ */
+static bool scanDouble(const char *&p,
+                       const char *pEnd,
+                       double &value)
+{
+    auto *pStart = p;
+    bool bNegative = (p != pEnd && (*p == '-' || *p == '+')) ? *p++ == '-' : false;
+
+    std::uint64_t mantissa = 0;
+    int exponent = 0, numDigits = 0, numSignificantDigits = 0;
+    for (; p != pEnd && *p >= '0' && *p <= '9'; ++p, ++numDigits)
+    {
+        if (numSignificantDigits < 19)
+        {
+            mantissa = 10 * mantissa + std::uint64_t(*p - '0');
+            numSignificantDigits += (mantissa != 0);
+        }
+        else
+            ++exponent;
+    }
+
+    if (p != pEnd && *p == '.')
+    {
+        for (++p; p != pEnd && *p >= '0' && *p <= '9'; ++p, ++numDigits)
+        {
+            if (numSignificantDigits < 19)
+            {
+                mantissa = 10 * mantissa + std::uint64_t(*p - '0');
+                numSignificantDigits += (mantissa != 0);
+                --exponent;
+            }
+        }
+    }
+
+    if (numDigits == 0)
+    {
+        p = pStart;
+
+        return false;
+    }
+
+    bool bExact = (numSignificantDigits < 19);
+    if (p != pEnd && (*p == 'e' || *p == 'E'))
+    {
+        auto *pExponent = ++p;
+        bool bNegativeExponent = (p != pEnd && (*p == '-' || *p == '+')) ? *p++ == '-' : false;
+        int exponentValue = 0;
+        for (; p != pEnd && *p >= '0' && *p <= '9'; ++p)
+            exponentValue = std::min(10 * exponentValue + (*p - '0'), 100000);
+
+        if (p == pExponent || (p == pExponent + 1 && !(*pExponent >= '0' && *pExponent <= '9')))
+        {
+            p = pStart;
+
+            return false;
+        }
+
+        exponent += bNegativeExponent ? -exponentValue : exponentValue;
+    }
+
+    if (bExact && mantissa <= (std::uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+    {
+        // both the mantissa and the power of ten are exact, so a single rounding yields the correctly rounded
+        // result
+        value = double(mantissa);
+        value = exponent < 0 ? value / POWERS_OF_TEN[-exponent] : value * POWERS_OF_TEN[exponent];
+        if (bNegative)
+            value = -value;
+    }
+    else
+    {
+        std::string token(pStart, p);
+        value = std::strtod(token.c_str(), nullptr);
+    }
+
+    return true;
+}
+
+/**
+ * Function to scan a signed integer; returns false if none is present
+ */
+inline static bool scanInteger(const char *&p,
+                               const char *pEnd,
+                               std::int64_t &value)
+{
+    bool bNegative = (p != pEnd && *p == '-');
+    auto *pDigits = p + bNegative;
+    auto *q = pDigits;
+    value = 0;
+    for (; q != pEnd && *q >= '0' && *q <= '9' && value < RELATIVE_INDEX_BIAS / 10; ++q)
+        value = 10 * value + (*q - '0');
+
+    bool bSuccess = (q != pDigits);
+    if (bSuccess)
+    {
+        p = q;
+        if (bNegative)
+            value = -value;
+    }
+
+    return bSuccess;
+}
+
+/**
+ * Function to advance to the beginning of the next line
+ */
+inline static void skipLine(const char *&p,
+                            const char *pEnd)
+{
+    auto *pNewLine = static_cast<const char *>(std::memchr(p, '\n', std::size_t(pEnd - p)));
+    p = pNewLine != nullptr ? pNewLine + 1 : pEnd;
+}
+
+/**
+ * Function to scan the coordinates of a vertex, texture coordinate or normal statement; trailing values (e.g.,
+ * weights or colors) are ignored. Returns false if fewer than the required number of coordinates are present
+ */
+static bool scanCoordinates(const char *&p,
+                            const char *pEnd,
+                            std::size_t numCoordinates,
+                            std::vector<double> &coordinates)
+{
+    for (std::size_t i = 0; i < numCoordinates; ++i)
+    {
+        while (p != pEnd && isBlank(*p))
+            ++p;
+
+        double value;
+        if (!scanDouble(p, pEnd, value))
+            return false;
+
+        coordinates.push_back(value);
+    }
+
+    return true;
+}
+
+/**
+ * Function to convert an index read from a face statement to the form stored in a parsed chunk; returns false
+ * if the index is zero
+ * @param index      the index, as read
+ * @param localCount the number of elements of the indexed kind read so far within the chunk
+ */
+inline static bool toChunkIndex(std::int64_t &index,
+                                std::size_t localCount)
+{
+    bool bSuccess = (index != 0);
+    if (bSuccess)
+        index = index > 0 ? index - 1 : RELATIVE_INDEX_BIAS + std::int64_t(localCount) + index;
+
+    return bSuccess;
+}
+
+/**
+ * Function to scan a face statement; returns false if the statement is malformed
+ */
+static bool scanFace(const char *&p,
+                     const char *pEnd,
+                     ParsedChunk &chunk)
+{
+    auto &&numVertices = chunk.m_vertices.size() / 3;
+    auto &&numTextureCoordinates = chunk.m_textureCoordinates.size() / 2;
+    auto &&numNormals = chunk.m_normals.size() / 3;
+    chunk.m_faceOffsets.push_back(chunk.m_vertexIndices.size());
+    std::size_t numFaceVertices = 0;
+    while (true)
+    {
+        while (p != pEnd && isBlank(*p))
+            ++p;
+
+        if (isEndOfLine(p, pEnd))
+            break;
+
+        // v, v/vt, v//vn or v/vt/vn
+        std::int64_t vertex, texture = -1, normal = -1;
+        if (!scanInteger(p, pEnd, vertex) || !toChunkIndex(vertex, numVertices))
+            return false;
+
+        if (p != pEnd && *p == '/')
+        {
+            ++p;
+            if (p != pEnd && *p != '/' && (!scanInteger(p, pEnd, texture) ||
+                                           !toChunkIndex(texture, numTextureCoordinates)))
+                return false;
+
+            if (p != pEnd && *p == '/')
+            {
+                ++p;
+                if (!scanInteger(p, pEnd, normal) || !toChunkIndex(normal, numNormals))
+                    return false;
+            }
+        }
+
+        if (!isEndOfLine(p, pEnd) && !isBlank(*p))
+            return false;
+
+        chunk.m_vertexIndices.push_back(vertex);
+        chunk.m_textureIndices.push_back(texture);
+        chunk.m_normalIndices.push_back(normal);
+        ++numFaceVertices;
+    }
+
+    return numFaceVertices >= 3;
+}
+
+/**
+ * Function to parse the statements within a range of a file
+ */
+static void parseChunk(const char *pBegin,
+                       const char *pEnd,
+                       const char *pFile,
+                       std::size_t fileSize,
+                       ParsedChunk &chunk)
+{
+    chunk.m_errorOffset = fileSize;
+
+    // reserve space assuming the chunk consists mostly of vertices and triangles, roughly 30 bytes per line
+    auto &&numLines = std::size_t(pEnd - pBegin) / 30;
+    chunk.m_vertices.reserve(numLines);
+    chunk.m_vertexIndices.reserve(numLines);
+
+    auto *p = pBegin;
+    while (p != pEnd)
+    {
+        auto *pLine = p;
+        while (p != pEnd && isBlank(*p))
+            ++p;
+
+        bool bSuccess = true;
+        if (p != pEnd && *p == 'v')
+        {
+            auto *pNext = p + 1;
+            if (pNext != pEnd && isBlank(*pNext))
+                bSuccess = scanCoordinates(++p, pEnd, 3, chunk.m_vertices);
+            else if (pNext != pEnd && pNext + 1 != pEnd && isBlank(pNext[1]))
+            {
+                p += 2;
+                if (*pNext == 't')
+                {
+                    // the second texture coordinate is optional and defaults to zero
+                    bSuccess = scanCoordinates(p, pEnd, 1, chunk.m_textureCoordinates);
+                    if (bSuccess && !scanCoordinates(p, pEnd, 1, chunk.m_textureCoordinates))
+                        chunk.m_textureCoordinates.push_back(0.0);
+                }
+                else if (*pNext == 'n')
+                    bSuccess = scanCoordinates(p, pEnd, 3, chunk.m_normals);
+            }
+        }
+        else if (p != pEnd && *p == 'f' && p + 1 != pEnd && isBlank(p[1]))
+            bSuccess = scanFace(++p, pEnd, chunk);
+
+        if (!bSuccess)
+        {
+            chunk.m_errorOffset = std::size_t(pLine - pFile);
+
+            return;
+        }
+
+        // comments and unsupported statements are skipped, as are values trailing those read
+        if (p != pEnd)
+            skipLine(p, pEnd);
+    }
+}
+
+/**
+ * Constructor
+ */
+ObjFileReader::ObjFileReader(void)
+: m_fileSize(0),
+  m_maximumThreads(1),
+  m_throughput(0.0)
+{
+
+}
+
+/**
+ * Destructor
+ */
+ObjFileReader::~ObjFileReader(void)
+{
+
+}
+
+/**
+ * Clear the buffers populated by the last read
+ */
+void ObjFileReader::clear(void)
+{
+    m_faceOffsets.clear();
+    m_fileSize = 0;
+    m_normalIndices.clear();
+    m_normals.clear();
+    m_textureCoordinates.clear();
+    m_textureIndices.clear();
+    m_throughput = 0.0;
+    m_vertexIndices.clear();
+    m_vertices.clear();
+}
+
+/**
+ * Get the name of this class
+ */
+std::string ObjFileReader::getClassName(void) const
+{
+    return "ObjFileReader";
+}
+
+/**
+ * Get the offsets of each face's entries within the index buffers, followed by the total number of entries
+ */
+const std::vector<std::size_t> &ObjFileReader::getFaceOffsets(void) const
+{
+    return m_faceOffsets;
+}
+
+/**
+ * Get the size, in bytes, of the last file read
+ */
+std::size_t ObjFileReader::getFileSize(void) const
+{
+    return m_fileSize;
+}
+
+/**
+ * Get the maximum number of threads used to parse a file (default is one, i.e., single-threaded)
+ */
+std::size_t ObjFileReader::getMaximumThreads(void) const
+{
+    return m_maximumThreads;
+}
+
+/**
+ * Get the normal indices of the face vertices
+ */
+const std::vector<std::uint32_t> &ObjFileReader::getNormalIndices(void) const
+{
+    return m_normalIndices;
+}
+
+/**
+ * Get the vertex normals, three coordinates per normal
+ */
+const std::vector<double> &ObjFileReader::getNormals(void) const
+{
+    return m_normals;
+}
+
+/**
+ * Get the number of faces read
+ */
+std::size_t ObjFileReader::getNumFaces(void) const
+{
+    return m_faceOffsets.empty() ? 0 : m_faceOffsets.size() - 1;
+}
+
+/**
+ * Get the number of geometric vertices read
+ */
+std::size_t ObjFileReader::getNumVertices(void) const
+{
+    return m_vertices.size() / 3;
+}
+
+/**
+ * Get the texture coordinates, two coordinates per entry
+ */
+const std::vector<double> &ObjFileReader::getTextureCoordinates(void) const
+{
+    return m_textureCoordinates;
+}
+
+/**
+ * Get the texture coordinate indices of the face vertices
+ */
+const std::vector<std::uint32_t> &ObjFileReader::getTextureIndices(void) const
+{
+    return m_textureIndices;
+}
+
+/**
+ * Get the rate, in megabytes (10^6 bytes) per second, at which the last file was read and parsed
+ */
+double ObjFileReader::getThroughput(void) const
+{
+    return m_throughput;
+}
+
+/**
+ * Get the geometric vertex indices of the face vertices
+ */
+const std::vector<std::uint32_t> &ObjFileReader::getVertexIndices(void) const
+{
+    return m_vertexIndices;
+}
+
+/**
+ * Get the geometric vertices, three coordinates per vertex
+ */
+const std::vector<double> &ObjFileReader::getVertices(void) const
+{
+    return m_vertices;
+}
+
+/**
+ * Read an obj file, replacing the contents of the buffers; returns false if the file cannot be opened or
+ * contains a malformed statement or an out-of-range index
+ */
+bool ObjFileReader::read(const std::string &filename)
+{
+    auto &&start = std::chrono::steady_clock::now();
+
+    clear();
+
+    MemoryMappedFile file(filename);
+    bool bSuccess = file.isOpen();
+    if (!bSuccess)
+    {
+        logMsg(std::cout, LoggingLevel::Enum::Error,
+               "Failed to open 3-d object file \"" + filename + "\"!\n",
+               getQualifiedMethodName(__func__));
+
+        return bSuccess;
+    }
+
+    // divide the file into chunks which begin and end on line boundaries
+    auto *pFile = file.getData();
+    auto &&fileSize = file.getSize();
+    auto numChunks = std::max<std::size_t>(1, std::min(m_maximumThreads, fileSize / MINIMUM_BYTES_PER_THREAD));
+    std::vector<const char *> boundaries(1, pFile);
+    for (std::size_t i = 1; i < numChunks; ++i)
+    {
+        auto *p = std::max(boundaries.back(), pFile + i * (fileSize / numChunks));
+        if (p != pFile + fileSize)
+            skipLine(p, pFile + fileSize);
+
+        boundaries.push_back(p);
+    }
+
+    boundaries.push_back(pFile + fileSize);
+
+    // parse the chunks, then merge them in parallel at offsets given by the totals of the preceding chunks
+    std::vector<ParsedChunk> chunks(numChunks);
+    auto &&execute = [this, numChunks] (const std::function<void (std::size_t)> &function)
+    {
+        if (numChunks == 1)
+            function(0);
+        else
+        {
+            if (m_pThreadPool == nullptr)
+                m_pThreadPool.reset(new ::utilities::ThreadPool<bool>(m_maximumThreads));
+
+            m_pThreadPool->forEachRange(numChunks, numChunks, 1, [&function] (std::size_t begin, std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                    function(i);
+            });
+        }
+    };
+
+    execute([&] (std::size_t i)
+    {
+        parseChunk(boundaries[i], boundaries[i + 1], pFile, fileSize, chunks[i]);
+    });
+
+    std::size_t errorOffset = fileSize;
+    std::vector<std::size_t> faceOffsets(numChunks + 1, 0), indexOffsets(numChunks + 1, 0),
+                             normalOffsets(numChunks + 1, 0), textureOffsets(numChunks + 1, 0),
+                             vertexOffsets(numChunks + 1, 0);
+    for (std::size_t i = 0; i < numChunks; ++i)
+    {
+        auto &&chunk = chunks[i];
+        errorOffset = std::min(errorOffset, chunk.m_errorOffset);
+        faceOffsets[i + 1] = faceOffsets[i] + chunk.m_faceOffsets.size();
+        indexOffsets[i + 1] = indexOffsets[i] + chunk.m_vertexIndices.size();
+        normalOffsets[i + 1] = normalOffsets[i] + chunk.m_normals.size() / 3;
+        textureOffsets[i + 1] = textureOffsets[i] + chunk.m_textureCoordinates.size() / 2;
+        vertexOffsets[i + 1] = vertexOffsets[i] + chunk.m_vertices.size() / 3;
+    }
+
+    bSuccess = (errorOffset == fileSize);
+    if (!bSuccess)
+    {
+        auto &&line = 1 + std::count(pFile, pFile + errorOffset, '\n');
+        logMsg(std::cout, LoggingLevel::Enum::Error,
+               "Malformed statement at line " + std::to_string(line) + " of 3-d object file \"" + filename +
+               "\"!\n", getQualifiedMethodName(__func__));
+
+        return bSuccess;
+    }
+
+    bSuccess = (vertexOffsets.back() < NO_INDEX && normalOffsets.back() < NO_INDEX &&
+                textureOffsets.back() < NO_INDEX);
+    if (!bSuccess)
+    {
+        logMsg(std::cout, LoggingLevel::Enum::Error,
+               "3-d object file \"" + filename + "\" contains too many vertices!\n",
+               getQualifiedMethodName(__func__));
+
+        return bSuccess;
+    }
+
+    m_faceOffsets.resize(faceOffsets.back() + 1);
+    m_faceOffsets.back() = indexOffsets.back();
+    m_normalIndices.resize(indexOffsets.back());
+    m_normals.resize(3 * normalOffsets.back());
+    m_textureCoordinates.resize(2 * textureOffsets.back());
+    m_textureIndices.resize(indexOffsets.back());
+    m_vertexIndices.resize(indexOffsets.back());
+    m_vertices.resize(3 * vertexOffsets.back());
+
+    std::vector<char> bIndicesValid(numChunks, true);
+    execute([&] (std::size_t i)
+    {
+        auto &&chunk = chunks[i];
+        std::copy(chunk.m_normals.cbegin(), chunk.m_normals.cend(), m_normals.begin() + 3 * normalOffsets[i]);
+        std::copy(chunk.m_textureCoordinates.cbegin(), chunk.m_textureCoordinates.cend(),
+                  m_textureCoordinates.begin() + 2 * textureOffsets[i]);
+        std::copy(chunk.m_vertices.cbegin(), chunk.m_vertices.cend(), m_vertices.begin() + 3 * vertexOffsets[i]);
+        for (std::size_t j = 0; j < chunk.m_faceOffsets.size(); ++j)
+            m_faceOffsets[faceOffsets[i] + j] = indexOffsets[i] + chunk.m_faceOffsets[j];
+
+        // resolve relative indices and verify that all indices are in range; absent texture and normal indices
+        // become NO_INDEX
+        auto &&resolve = [] (std::int64_t index, std::size_t chunkOffset, std::size_t count, bool &bValid)
+        {
+            if (index >= RELATIVE_INDEX_BIAS / 2)
+                index += std::int64_t(chunkOffset) - RELATIVE_INDEX_BIAS;
+
+            bValid &= (index >= 0 && std::size_t(index) < count);
+
+            return bValid ? std::uint32_t(index) : NO_INDEX;
+        };
+
+        bool bValid = true;
+        for (std::size_t j = 0; j < chunk.m_vertexIndices.size(); ++j)
+        {
+            auto &&index = indexOffsets[i] + j;
+            m_vertexIndices[index] = resolve(chunk.m_vertexIndices[j], vertexOffsets[i], vertexOffsets.back(),
+                                             bValid);
+
+            auto &&texture = chunk.m_textureIndices[j];
+            m_textureIndices[index] = texture < 0 ? NO_INDEX : resolve(texture, textureOffsets[i],
+                                                                       textureOffsets.back(), bValid);
+
+            auto &&normal = chunk.m_normalIndices[j];
+            m_normalIndices[index] = normal < 0 ? NO_INDEX : resolve(normal, normalOffsets[i],
+                                                                     normalOffsets.back(), bValid);
+        }
+
+        bIndicesValid[i] = bValid;
+    });
+
+    bSuccess = std::all_of(bIndicesValid.cbegin(), bIndicesValid.cend(), [] (char bValid) { return bValid; });
+    if (!bSuccess)
+    {
+        logMsg(std::cout, LoggingLevel::Enum::Error,
+               "3-d object file \"" + filename + "\" contains an out-of-range index!\n",
+               getQualifiedMethodName(__func__));
+
+        clear();
+
+        return bSuccess;
+    }
+
+    m_fileSize = fileSize;
+    auto &&elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    m_throughput = elapsed > 0.0 ? 1.0e-6 * double(fileSize) / elapsed : 0.0;
+
+    return bSuccess;
+}
+
+/**
+ * Set the maximum number of threads used to parse a file
+ */
+void ObjFileReader::setMaximumThreads(std::size_t maximumThreads)
+{
+    m_maximumThreads = std::max<std::size_t>(1, maximumThreads);
+    if (m_pThreadPool != nullptr)
+        m_pThreadPool->setMaximumThreads(m_maximumThreads);
+}
+
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,228 @@
+#ifndef OBJ_FILE_READER_H
+#define OBJ_FILE_READER_H
+
+#include "export_library.h"
+#include "loggable.h"
+#include "reflective.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+// forward declarations
+namespace utilities { template<typename> class ThreadPool; }
+
+namespace math
+{
+
+namespace geometric
+{
+
+namespace shapes
+{
+
+namespace utilities
+{
+
+/**
+ * This class reads Wavefront obj files into indexed vertex and face buffers. The file is memory-mapped (where
+ * supported) and divided at line boundaries into chunks which are parsed concurrently (see
+ * setMaximumThreads()); numbers are scanned directly from the mapped bytes, without intermediate strings or
+ * streams. Geometric vertices ("v"), texture coordinates ("vt"), vertex normals ("vn") and faces ("f") having
+ * three or more vertices are read, including relative (negative) indices; other statements are ignored.
+ *
+ * All buffers are flat: vertices and normals store three consecutive coordinates per entry, texture
+ * coordinates store two, and face k references the index entries in the half-open range
+ * [getFaceOffsets()[k], getFaceOffsets()[k + 1]). Indices are zero-based; texture and normal indices which are
+ * absent from a face vertex are reported as NO_INDEX
+ */
+class ObjFileReader final
+: public attributes::concrete::Loggable<std::string, std::ostream>,
+  virtual private attributes::abstract::Reflective
+{
+public:
+
+    /**
+     * the value reported for texture and normal indices which are absent from a face vertex
+     */
+    static constexpr std::uint32_t NO_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * Constructor
+     */
+    EXPORT_STEM ObjFileReader(void);
+
+    /**
+     * Copy constructor
+     */
+    ObjFileReader(const ObjFileReader &reader) = delete;
+
+    /**
+     * Move constructor
+     */
+    ObjFileReader(ObjFileReader &&reader) = delete;
+
+    /**
+     * Destructor
+     */
+    EXPORT_STEM virtual ~ObjFileReader(void) override;
+
+    /**
+     * Copy assignment operator
+     */
+    ObjFileReader &operator = (const ObjFileReader &reader) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    ObjFileReader &operator = (ObjFileReader &&reader) = delete;
+
+    /**
+     * Clear the buffers populated by the last read
+     */
+    EXPORT_STEM void clear(void);
+
+    /**
+     * Get the name of this class
+     */
+    EXPORT_STEM virtual std::string getClassName(void) const override;
+
+    /**
+     * Get the offsets of each face's entries within the index buffers, followed by the total number of entries
+     */
+    EXPORT_STEM const std::vector<std::size_t> &getFaceOffsets(void) const;
+
+    /**
+     * Get the size, in bytes, of the last file read
+     */
+    EXPORT_STEM std::size_t getFileSize(void) const;
+
+    /**
+     * Get the maximum number of threads used to parse a file (default is one, i.e., single-threaded)
+     */
+    EXPORT_STEM std::size_t getMaximumThreads(void) const;
+
+    /**
+     * Get the normal indices of the face vertices
+     */
+    EXPORT_STEM const std::vector<std::uint32_t> &getNormalIndices(void) const;
+
+    /**
+     * Get the vertex normals, three coordinates per normal
+     */
+    EXPORT_STEM const std::vector<double> &getNormals(void) const;
+
+    /**
+     * Get the number of faces read
+     */
+    EXPORT_STEM std::size_t getNumFaces(void) const;
+
+    /**
+     * Get the number of geometric vertices read
+     */
+    EXPORT_STEM std::size_t getNumVertices(void) const;
+
+    /**
+     * Get the texture coordinates, two coordinates per entry
+     */
+    EXPORT_STEM const std::vector<double> &getTextureCoordinates(void) const;
+
+    /**
+     * Get the texture coordinate indices of the face vertices
+     */
+    EXPORT_STEM const std::vector<std::uint32_t> &getTextureIndices(void) const;
+
+    /**
+     * Get the rate, in megabytes (10^6 bytes) per second, at which the last file was read and parsed
+     */
+    EXPORT_STEM double getThroughput(void) const;
+
+    /**
+     * Get the geometric vertex indices of the face vertices
+     */
+    EXPORT_STEM const std::vector<std::uint32_t> &getVertexIndices(void) const;
+
+    /**
+     * Get the geometric vertices, three coordinates per vertex
+     */
+    EXPORT_STEM const std::vector<double> &getVertices(void) const;
+
+    /**
+     * Read an obj file, replacing the contents of the buffers; returns false if the file cannot be opened or
+     * contains a malformed statement or an out-of-range index
+     */
+    EXPORT_STEM bool read(const std::string &filename);
+
+    /**
+     * Set the maximum number of threads used to parse a file
+     */
+    EXPORT_STEM void setMaximumThreads(std::size_t maximumThreads);
+
+private:
+
+    /**
+     * the offsets of each face's entries within the index buffers, followed by the total number of entries
+     */
+    std::vector<std::size_t> m_faceOffsets;
+
+    /**
+     * the size, in bytes, of the last file read
+     */
+    std::size_t m_fileSize;
+
+    /**
+     * the maximum number of threads used to parse a file
+     */
+    std::size_t m_maximumThreads;
+
+    /**
+     * the normal indices of the face vertices
+     */
+    std::vector<std::uint32_t> m_normalIndices;
+
+    /**
+     * the vertex normals
+     */
+    std::vector<double> m_normals;
+
+    /**
+     * the thread pool used to parse files; created upon first use
+     */
+    std::unique_ptr<::utilities::ThreadPool<bool>> m_pThreadPool;
+
+    /**
+     * the texture coordinates
+     */
+    std::vector<double> m_textureCoordinates;
+
+    /**
+     * the texture coordinate indices of the face vertices
+     */
+    std::vector<std::uint32_t> m_textureIndices;
+
+    /**
+     * the rate, in megabytes per second, at which the last file was read and parsed
+     */
+    double m_throughput;
+
+    /**
+     * the geometric vertex indices of the face vertices
+     */
+    std::vector<std::uint32_t> m_vertexIndices;
+
+    /**
+     * the geometric vertices
+     */
+    std::vector<double> m_vertices;
+};
+
+}
+
+}
+
+}
+
+}
+
+#endif
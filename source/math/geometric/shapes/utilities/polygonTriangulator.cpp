@@ -116,7 +116,7 @@ PolygonTriangulator::const_iterator PolygonTriangulator::cend(void) const
  */
 PolygonTriangulator::iterator PolygonTriangulator::end(void)
 {
-    return iterator(std::vector<Vector2d>{ { }, { } });
+    return iterator(std::vector<Vector2d>());
 }
 
 /**
@@ -174,8 +174,7 @@ bool PolygonTriangulator::findNextTriangle(const std::vector<Vector2d> &vertices
                                  vertices[c]);
 
             // remove v from remaining polygon
-            for (std::size_t s = v, t = v + 1; t < numVerticesRemaining; ++s, ++t)
-                indices[s] = indices[t];
+            indices.erase(indices.begin() + v);
 
             --numVerticesRemaining;
 
@@ -216,7 +215,7 @@ bool PolygonTriangulator::testVertices(const std::vector<Vector2d> &vertices,
     if ((bx - ax) * (cy - ay) - (by - ay) * (cx - ax) < 0.0)
         return false;
 
-    for (std::size_t i = 0; i < vertices.size(); ++i)
+    for (std::size_t i = 0; i < indices.size(); ++i)
     {
         if (i == u || i == v || i == w)
             continue;
@@ -241,8 +240,8 @@ void PolygonTriangulator::triangulate(const Polygon &polygon,
                                       std::vector<Triangle> &triangles)
 {
     m_pPolygon = &polygon;
-    auto &&itTriangle = cbegin();
-    while (itTriangle != cend())
+    auto &&itTriangle = begin();
+    while (itTriangle != end())
     {
         triangles.push_back(*itTriangle);
 
@@ -82,7 +82,14 @@ public:
       m_triangulationFunctor(triangulationFunctor),
       m_vertices(vertices)
     {
-
+        // traverse the vertices in counter-clockwise order
+        double area = 0.0;
+        for (std::size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++)
+            area += vertices[j].getX() * vertices[i].getY() - vertices[i].getX() * vertices[j].getY();
+
+        m_indices.resize(vertices.size());
+        for (std::size_t i = 0; i < vertices.size(); ++i)
+            m_indices[i] = area > 0.0 ? i : vertices.size() - 1 - i;
     }
 
     /**
@@ -161,7 +168,9 @@ public:
      */
     inline virtual iterator &operator ++ (void) override
     {
-        m_triangulationFunctor(m_vertices, m_indices, m_triangle, m_numVerticesRemaining);
+        // the iterator becomes equal to the end iterator once no further triangles can be extracted
+        if (!m_triangulationFunctor(m_vertices, m_indices, m_triangle, m_numVerticesRemaining))
+            m_numVerticesRemaining = 0;
 
         return *this;
     }
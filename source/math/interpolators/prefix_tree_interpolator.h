@@ -1,10 +1,14 @@
 #ifndef PREFIX_TREE_INTERPOLATOR_H
 #define PREFIX_TREE_INTERPOLATOR_H
 
+#include "prefix_tree.h"
 #include "reflective.h"
 #include "static_mutex_mappable.h"
 #include "static_synchronizable.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <vector>
 
 namespace math
 {
@@ -13,7 +17,16 @@ namespace interpolators
 {
 
 /**
- * This class implements an algorithm to perform prefix tree node interpolation
+ * This class implements an algorithm to perform prefix tree node interpolation. Each branch of the tree holds
+ * the abscissas of a table entry, one per level, followed by the tabulated value.
+ *
+ * A rectilinear tree (one whose levels each hold the same breakpoints beneath every node of the level above)
+ * can be compiled via compile() into contiguous per-axis breakpoint arrays and a strided array of values.
+ * Compiled look-ups locate the bracketing interval of each axis in constant time for uniformly spaced axes
+ * (by binary search otherwise) and perform multilinear interpolation without visiting the tree; the node
+ * functor is then applied only to the tabulated values, as they are compiled. The compiled kernel is written
+ * as plain loops left to the compiler to vectorize, rather than with the runtime-dispatched intrinsics used by
+ * MatrixMultiplier, so that it remains generic in T and batched look-ups agree exactly with single look-ups
  */
 template<typename T, class functor>
 class PrefixTreeInterpolator
@@ -29,8 +42,9 @@ public:
      * @param nodeFunctor a reference to a function object that operates on or manipulates one or more nodes in
      *                    the tree
      */
-    PrefixTreeInterpolator(const Containers::Tree::TreeNode<T> *pRoot, const functor &nodeFunctor)
-    : m_bExtrapolate(false),
+    PrefixTreeInterpolator(const containers::tree::TreeNode<T> *pRoot, const functor &nodeFunctor)
+    : m_bCompiled(false),
+      m_bExtrapolate(false),
       m_nodeFunctor(nodeFunctor),
       m_pRoot(pRoot)
     {
@@ -41,6 +55,9 @@ public:
      * Copy constructor
      */
     PrefixTreeInterpolator(const PrefixTreeInterpolator<T, functor> &interpolator)
+    : m_bCompiled(false),
+      m_bExtrapolate(false),
+      m_pRoot(nullptr)
     {
         operator = (interpolator);
     }
@@ -49,6 +66,9 @@ public:
      * Move constructor
      */
     PrefixTreeInterpolator(PrefixTreeInterpolator<T, functor> &&interpolator)
+    : m_bCompiled(false),
+      m_bExtrapolate(false),
+      m_pRoot(nullptr)
     {
         operator = (std::move(interpolator));
     }
@@ -68,9 +88,15 @@ public:
     {
         if (&interpolator != this)
         {
+            m_bCompiled = interpolator.m_bCompiled;
             m_bExtrapolate = interpolator.m_bExtrapolate;
+            m_breakpoints = interpolator.m_breakpoints;
+            m_cornerOffsets = interpolator.m_cornerOffsets;
+            m_inverseSpacings = interpolator.m_inverseSpacings;
             m_nodeFunctor = interpolator.m_nodeFunctor;
             m_pRoot = interpolator.m_pRoot;
+            m_strides = interpolator.m_strides;
+            m_values = interpolator.m_values;
         }
 
         return *this;
@@ -79,13 +105,20 @@ public:
     /**
      * Move assignment operator
      */
-    PrefixTreeInterpolator<T, functor> &operator = (PrefixTreeInterpolator<T, functor> &&number)
+    PrefixTreeInterpolator<T, functor> &operator = (PrefixTreeInterpolator<T, functor> &&interpolator)
     {
         if (&interpolator != this)
         {
+            m_bCompiled = std::move(interpolator.m_bCompiled);
             m_bExtrapolate = std::move(interpolator.m_bExtrapolate);
+            m_breakpoints = std::move(interpolator.m_breakpoints);
+            m_cornerOffsets = std::move(interpolator.m_cornerOffsets);
+            m_inverseSpacings = std::move(interpolator.m_inverseSpacings);
             m_nodeFunctor = std::move(interpolator.m_nodeFunctor);
             m_pRoot = std::move(interpolator.m_pRoot);
+            m_strides = std::move(interpolator.m_strides);
+            m_values = std::move(interpolator.m_values);
+            interpolator.m_bCompiled = false;
             interpolator.m_pRoot = nullptr;
         }
 
@@ -97,8 +130,8 @@ private:
     /**
      * Function to adjust the bounding nodes (for extrapolation and singletons)
      */
-    virtual bool adjustBoundingNodes(Containers::Tree::TreeNode<T> *&pLeft,
-                                     Containers::Tree::TreeNode<T> *&pRight) const final
+    virtual bool adjustBoundingNodes(containers::tree::TreeNode<T> *&pLeft,
+                                     containers::tree::TreeNode<T> *&pRight) const final
     {
         bool bSingleton = false;
         if (pLeft && !pRight)
@@ -107,7 +140,7 @@ private:
             if (m_bExtrapolate && !bSingleton)
             {
                 pRight = pLeft;
-                pLeft = Containers::Tree::TreeNode<T>::getLeft(pRight);
+                pLeft = containers::tree::TreeNode<T>::getLeft(pRight);
             }
             else
                 pRight = pLeft;
@@ -118,7 +151,7 @@ private:
             if (m_bExtrapolate && !bSingleton)
             {
                 pLeft = pRight;
-                pRight = Containers::Tree::TreeNode<T>::getRight(pLeft);
+                pRight = containers::tree::TreeNode<T>::getRight(pLeft);
             }
             else
                 pLeft = pRight;
@@ -138,8 +171,220 @@ private:
         return true;
     }
 
+    /**
+     * Locate the interval of the specified axis which brackets an abscissa; returns the index of the lower
+     * breakpoint and sets the fractional position of the abscissa within the interval, which lies outside
+     * [0, 1] only when extrapolating
+     */
+    inline std::size_t bracket(std::size_t axis,
+                               const T &x,
+                               T &alpha) const
+    {
+        auto &&breakpoints = m_breakpoints[axis];
+        auto &&numBreakpoints = breakpoints.size();
+        if (numBreakpoints < 2)
+        {
+            alpha = T(0);
+
+            return 0;
+        }
+
+        std::size_t index = 0;
+        auto &&inverseSpacing = m_inverseSpacings[axis];
+        if (inverseSpacing != T(0))
+        {
+            // uniformly spaced breakpoints
+            auto &&position = (x - breakpoints[0]) * inverseSpacing;
+            if (position >= T(numBreakpoints - 1))
+                index = numBreakpoints - 2;
+            else if (position > T(0))
+                index = std::size_t(position);
+        }
+        else
+        {
+            auto &&itBreakpoint = std::upper_bound(breakpoints.cbegin(), breakpoints.cend(), x);
+            if (itBreakpoint == breakpoints.cend())
+                index = numBreakpoints - 2;
+            else if (itBreakpoint != breakpoints.cbegin())
+                index = std::min(std::size_t(itBreakpoint - breakpoints.cbegin()) - 1, numBreakpoints - 2);
+        }
+
+        alpha = (x - breakpoints[index]) / (breakpoints[index + 1] - breakpoints[index]);
+        if (!m_bExtrapolate)
+            alpha = std::min(std::max(alpha, T(0)), T(1));
+
+        return index;
+    }
+
+    /**
+     * Flatten the subtree beneath the specified node, whose children hold the breakpoints of the specified axis,
+     * into the value array; returns false if the subtree is not rectilinear
+     */
+    bool compile(const containers::tree::TreeNode<T> *pNode,
+                 std::size_t axis,
+                 std::size_t offset)
+    {
+        auto &&children = containers::tree::TreeNode<T>::getChildren(pNode);
+        if (axis == m_breakpoints.size())
+        {
+            // the tabulated value
+            bool bSuccess = (children.size() == 1 && !containers::tree::TreeNode<T>::hasChild(children[0]));
+            if (bSuccess)
+                m_values[offset] = m_nodeFunctor(children[0]->getData());
+
+            return bSuccess;
+        }
+
+        auto &&breakpoints = m_breakpoints[axis];
+        bool bSuccess = (children.size() == breakpoints.size());
+        for (std::size_t i = 0; bSuccess && i < children.size(); ++i)
+        {
+            bSuccess = (children[i]->getData() == breakpoints[i] &&
+                        compile(children[i], axis + 1, offset + i * m_strides[axis]));
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Perform multilinear interpolation of the compiled table at the specified point
+     * @param x      an array of abscissas, one per axis
+     * @param values a work array with room for one value per corner of an interpolation cell
+     */
+    inline T interpolateCompiled(const T *x,
+                                 T *values) const
+    {
+        auto &&numAxes = m_breakpoints.size();
+        T alphas[MAXIMUM_COMPILED_AXES];
+        std::size_t base = 0;
+        for (std::size_t axis = 0; axis < numAxes; ++axis)
+            base += bracket(axis, x[axis], alphas[axis]) * m_strides[axis];
+
+        // gather the values at the corners of the cell, then reduce along one axis at a time, beginning with
+        // the last; the lowest bit of a corner index selects the upper breakpoint of the axis being reduced
+        auto &&numCorners = m_cornerOffsets.size();
+        const T *pValues = m_values.data() + base;
+        for (std::size_t corner = 0; corner < numCorners; ++corner)
+            values[corner] = pValues[m_cornerOffsets[corner]];
+
+        for (std::size_t axis = numAxes; axis-- > 0;)
+        {
+            numCorners >>= 1;
+            auto &&alpha = alphas[axis];
+            for (std::size_t corner = 0; corner < numCorners; ++corner)
+            {
+                auto &&lower = values[2 * corner];
+                values[corner] = lower + alpha * (values[2 * corner + 1] - lower);
+            }
+        }
+
+        return values[0];
+    }
+
 public:
 
+    /**
+     * Compile the tree into a dense table, such that subsequent look-ups perform multilinear interpolation on
+     * contiguous arrays rather than visiting the tree; returns false, leaving this object uncompiled, if the
+     * tree is not rectilinear or has more than MAXIMUM_COMPILED_AXES levels of abscissas. The tree must be
+     * compiled again after it is modified
+     */
+    bool compile(void)
+    {
+        m_bCompiled = false;
+        m_breakpoints.clear();
+        m_cornerOffsets.clear();
+        m_inverseSpacings.clear();
+        m_strides.clear();
+        m_values.clear();
+
+        // the breakpoints of each axis are taken from the left-most branch; the level beneath which the
+        // children have no children of their own holds the tabulated values
+        auto *pNode = m_pRoot;
+        bool bSuccess = (pNode != nullptr);
+        while (bSuccess)
+        {
+            auto &&children = containers::tree::TreeNode<T>::getChildren(pNode);
+            bSuccess = !children.empty();
+            if (bSuccess)
+            {
+                if (!containers::tree::TreeNode<T>::hasChild(children[0]))
+                    break;
+
+                std::vector<T> breakpoints;
+                for (auto *pChild : children)
+                    breakpoints.push_back(pChild->getData());
+
+                bSuccess = (m_breakpoints.size() < MAXIMUM_COMPILED_AXES &&
+                            std::adjacent_find(breakpoints.cbegin(),
+                                               breakpoints.cend(),
+                                               std::greater_equal<T>()) == breakpoints.cend());
+                m_breakpoints.push_back(std::move(breakpoints));
+                pNode = children[0];
+            }
+        }
+
+        bSuccess &= !m_breakpoints.empty();
+        if (bSuccess)
+        {
+            // row-major strides, and the offsets of the corners of an interpolation cell relative to its lower
+            // corner
+            auto &&numAxes = m_breakpoints.size();
+            m_strides.resize(numAxes);
+            std::size_t size = 1;
+            for (std::size_t axis = numAxes; axis-- > 0;)
+            {
+                m_strides[axis] = size;
+                size *= m_breakpoints[axis].size();
+            }
+
+            m_cornerOffsets.assign(std::size_t(1) << numAxes, 0);
+            for (std::size_t corner = 0; corner < m_cornerOffsets.size(); ++corner)
+                for (std::size_t axis = 0; axis < numAxes; ++axis)
+                    if ((corner >> (numAxes - 1 - axis)) & 1)
+                        m_cornerOffsets[corner] += m_breakpoints[axis].size() > 1 ? m_strides[axis] : 0;
+
+            // axes with uniformly spaced breakpoints are bracketed without a search
+            for (auto &&breakpoints : m_breakpoints)
+            {
+                T inverseSpacing(0);
+                auto &&numIntervals = breakpoints.size() - 1;
+                if (numIntervals > 0)
+                {
+                    auto &&spacing = (breakpoints.back() - breakpoints.front()) / T(numIntervals);
+                    bool bUniform = true;
+                    for (std::size_t i = 1; bUniform && i <= numIntervals; ++i)
+                    {
+                        auto &&uniformBreakpoint = breakpoints.front() + T(i) * spacing;
+                        bUniform = (std::abs(breakpoints[i] - uniformBreakpoint) <=
+                                    UNIFORM_SPACING_TOLERANCE * std::abs(spacing));
+                    }
+
+                    if (bUniform)
+                        inverseSpacing = T(1) / spacing;
+                }
+
+                m_inverseSpacings.push_back(inverseSpacing);
+            }
+
+            m_values.resize(size);
+            bSuccess = compile(m_pRoot, 0, 0);
+        }
+
+        if (!bSuccess)
+        {
+            m_breakpoints.clear();
+            m_cornerOffsets.clear();
+            m_inverseSpacings.clear();
+            m_strides.clear();
+            m_values.clear();
+        }
+
+        m_bCompiled = bSuccess;
+
+        return bSuccess;
+    }
+
     /**
      * Set extrapolation status
      */
@@ -164,14 +409,61 @@ public:
         return "PrefixTreeInterpolator";
     }
 
+    /**
+     * Get the number of axes of the compiled table (zero if this object has not been compiled)
+     */
+    inline std::size_t getNumCompiledAxes(void) const
+    {
+        return m_breakpoints.size();
+    }
+
     /**
      * Interpolation function
      */
     template<class Container> bool interpolate(const Container &abscissas, T &y) const
     {
+        if (m_bCompiled && std::size_t(abscissas.size()) == m_breakpoints.size())
+        {
+            T x[MAXIMUM_COMPILED_AXES], values[std::size_t(1) << MAXIMUM_COMPILED_AXES];
+            std::copy(abscissas.begin(), abscissas.end(), x);
+            y = interpolateCompiled(x, values);
+
+            return true;
+        }
+
         return traverse(abscissas.begin(), abscissas.end(), m_pRoot, y);
     }
 
+    /**
+     * Interpolate the compiled table at a batch of points; returns false if this object has not been compiled
+     * @param points    an array of points, stored contiguously with one abscissa per compiled axis
+     * @param numPoints the number of points
+     * @param results   an array which receives the interpolated value at each point
+     */
+    bool interpolate(const T *points,
+                     std::size_t numPoints,
+                     T *results) const
+    {
+        bool bSuccess = m_bCompiled;
+        if (bSuccess)
+        {
+            auto &&numAxes = m_breakpoints.size();
+            T values[std::size_t(1) << MAXIMUM_COMPILED_AXES];
+            for (std::size_t i = 0; i < numPoints; ++i)
+                results[i] = interpolateCompiled(points + i * numAxes, values);
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Query whether or not this object has been compiled
+     */
+    inline bool isCompiled(void) const
+    {
+        return m_bCompiled;
+    }
+
 private:
 
     /**
@@ -179,21 +471,21 @@ private:
      * nodes, and process the node bounds using the node functor
      */
     template<class iterator>
-    bool traverse(iterator it, iterator itEnd, const Containers::Tree::TreeNode<T> *pNode, T &y) const
+    bool traverse(iterator it, iterator itEnd, const containers::tree::TreeNode<T> *pNode, T &y) const
     {
-        T x1, x2, y1, y2;
-        Containers::Tree::TreeNode<T> *pLeft = nullptr;
-        auto *pRight = Containers::Tree::TreeNode<T>::getChild(pNode);
+        T x1(0), x2(0), y1(0), y2(0);
+        containers::tree::TreeNode<T> *pLeft = nullptr;
+        auto *pRight = containers::tree::TreeNode<T>::getChild(pNode);
 
         if (it != itEnd)
         {
-            Containers::Tree::PrefixTree<T>::retrieve(*it, pRight, std::greater_equal<T>(), pLeft);
+            containers::tree::PrefixTree<T>::retrieve(*it, pRight, std::greater_equal<T>(), pLeft);
             adjustBoundingNodes(pLeft, pRight);
         }
 
         if (pLeft)
         {
-            if (Containers::Tree::TreeNode<T>::getChild(pLeft) != nullptr && it != itEnd)
+            if (containers::tree::TreeNode<T>::getChild(pLeft) != nullptr && it != itEnd)
                 traverse(it + 1, itEnd, pLeft, y1);
             else
             {
@@ -207,7 +499,7 @@ private:
 
         if (pRight)
         {
-            if (Containers::Tree::TreeNode<T>::getChild(pRight) != nullptr && it != itEnd)
+            if (containers::tree::TreeNode<T>::getChild(pRight) != nullptr && it != itEnd)
                 traverse(it + 1, itEnd, pRight, y2);
             else
             {
@@ -229,18 +521,59 @@ private:
         return false;
     }
 
+    /**
+     * the maximum number of axes of a compiled table
+     */
+    static constexpr std::size_t MAXIMUM_COMPILED_AXES = 10;
+
+    /**
+     * the relative tolerance within which breakpoints are considered to be uniformly spaced
+     */
+    static constexpr double UNIFORM_SPACING_TOLERANCE = 1.0e-12;
+
+    /**
+     * flag indicating whether or not the tree has been compiled
+     */
+    bool m_bCompiled;
+
     /**
      * extrapolation flag
      */
     bool m_bExtrapolate;
 
+    /**
+     * the breakpoints of each axis of the compiled table
+     */
+    std::vector<std::vector<T>> m_breakpoints;
+
+    /**
+     * the offsets of the corners of an interpolation cell from its lower corner within the compiled values
+     */
+    std::vector<std::size_t> m_cornerOffsets;
+
+    /**
+     * the reciprocal of the breakpoint spacing of each axis of the compiled table, or zero if the breakpoints
+     * of the axis are not uniformly spaced
+     */
+    std::vector<T> m_inverseSpacings;
+
     /**
      * an instance of the node function object
      */
     functor m_nodeFunctor;
 
     // a pointer to the root of the tree
-    const Containers::Tree::TreeNode<T> *m_pRoot;
+    const containers::tree::TreeNode<T> *m_pRoot;
+
+    /**
+     * the row-major stride of each axis of the compiled table
+     */
+    std::vector<std::size_t> m_strides;
+
+    /**
+     * the tabulated values of the compiled table, in row-major order
+     */
+    std::vector<T> m_values;
 };
 
 }
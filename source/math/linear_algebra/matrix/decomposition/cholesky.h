@@ -332,7 +332,7 @@ public:
                     sum += A[in + j] * A[in + j];
 
                 auto &Aii = A[in + i];
-                if (Aii <= 0)
+                if (Aii - sum <= 0)
                 {
                     iError = i + 1;
 
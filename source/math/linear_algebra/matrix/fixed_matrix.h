@@ -0,0 +1,695 @@
+#ifndef FIXED_MATRIX_H
+#define FIXED_MATRIX_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace math
+{
+
+namespace linear_algebra
+{
+
+namespace matrix
+{
+
+/**
+ * This class implements a row-major matrix whose extents are known at compile time. Elements are stored
+ * in-place (no heap allocation), the class has no virtual functions or virtual bases, and the arithmetic
+ * operations are constexpr and are expected to be fully inlined; as such, the class is intended for the small,
+ * fixed-size linear algebra found in hot paths such as Kalman filter predict/update cycles and kinematics.
+ * Column vectors are represented as matrices with a single column (see FixedVector).
+ *
+ * Interoperability with the dynamically-sized matrix types (Matrix<2, T>, Matrix2d) is provided through the
+ * fromMatrix()/toMatrix() functions, which accept any type that implements rows(), columns() and
+ * operator () (i, j); interoperability with Matrix3x3 and Vector3d (or native arrays) is provided through the
+ * fromArray()/toArray() functions, which use subscript operators
+ */
+template<std::size_t Rows, std::size_t Columns, typename T = double>
+class FixedMatrix final
+{
+    static_assert(Rows > 0 && Columns > 0, "FixedMatrix extents must be non-zero!");
+
+public:
+
+    /**
+     * Typedef declarations
+     */
+    typedef std::array<T, Rows * Columns> tArray;
+    typedef T value_type;
+
+    /**
+     * Constructor
+     */
+    constexpr FixedMatrix(void)
+    : m_array{}
+    {
+
+    }
+
+    /**
+     * Construct from a sequence of values given in row-major order; the number of values must match the number
+     * of elements in this matrix
+     */
+    template<typename ... Values,
+             typename std::enable_if<sizeof ... (Values) == Rows * Columns &&
+                                     std::conjunction<std::is_arithmetic<Values> ...>::value, int>::type = 0>
+    constexpr FixedMatrix(Values ... values)
+    : m_array{ { static_cast<T>(values) ... } }
+    {
+
+    }
+
+    /**
+     * Copy constructor
+     */
+    constexpr FixedMatrix(const FixedMatrix<Rows, Columns, T> &matrix) = default;
+
+    /**
+     * Copy assignment operator
+     */
+    constexpr FixedMatrix &operator = (const FixedMatrix<Rows, Columns, T> &matrix) = default;
+
+    /**
+     * Addition operator
+     */
+    constexpr FixedMatrix operator + (const FixedMatrix<Rows, Columns, T> &matrix) const
+    {
+        auto result(*this);
+
+        return result += matrix;
+    }
+
+    /**
+     * Addition assignment operator
+     */
+    constexpr FixedMatrix &operator += (const FixedMatrix<Rows, Columns, T> &matrix)
+    {
+        for (std::size_t i = 0; i < Rows * Columns; ++i)
+            m_array[i] += matrix.m_array[i];
+
+        return *this;
+    }
+
+    /**
+     * Subtraction operator
+     */
+    constexpr FixedMatrix operator - (const FixedMatrix<Rows, Columns, T> &matrix) const
+    {
+        auto result(*this);
+
+        return result -= matrix;
+    }
+
+    /**
+     * Unary minus operator
+     */
+    constexpr FixedMatrix operator - (void) const
+    {
+        FixedMatrix result;
+        for (std::size_t i = 0; i < Rows * Columns; ++i)
+            result.m_array[i] = -m_array[i];
+
+        return result;
+    }
+
+    /**
+     * Subtraction assignment operator
+     */
+    constexpr FixedMatrix &operator -= (const FixedMatrix<Rows, Columns, T> &matrix)
+    {
+        for (std::size_t i = 0; i < Rows * Columns; ++i)
+            m_array[i] -= matrix.m_array[i];
+
+        return *this;
+    }
+
+    /**
+     * Matrix multiplication operator
+     */
+    template<std::size_t Inner>
+    constexpr FixedMatrix<Rows, Inner, T> operator * (const FixedMatrix<Columns, Inner, T> &matrix) const
+    {
+        FixedMatrix<Rows, Inner, T> result;
+        for (std::size_t i = 0; i < Rows; ++i)
+            for (std::size_t k = 0; k < Columns; ++k)
+            {
+                auto &&value = (*this)(i, k);
+                for (std::size_t j = 0; j < Inner; ++j)
+                    result(i, j) += value * matrix(k, j);
+            }
+
+        return result;
+    }
+
+    /**
+     * Matrix multiplication assignment operator (square right-hand operands only)
+     */
+    constexpr FixedMatrix &operator *= (const FixedMatrix<Columns, Columns, T> &matrix)
+    {
+        return *this = *this * matrix;
+    }
+
+    /**
+     * Scalar multiplication operator
+     */
+    constexpr FixedMatrix operator * (const T &value) const
+    {
+        auto result(*this);
+
+        return result *= value;
+    }
+
+    /**
+     * Scalar multiplication assignment operator
+     */
+    constexpr FixedMatrix &operator *= (const T &value)
+    {
+        for (auto &&element : m_array)
+            element *= value;
+
+        return *this;
+    }
+
+    /**
+     * Scalar division operator
+     */
+    constexpr FixedMatrix operator / (const T &value) const
+    {
+        auto result(*this);
+
+        return result /= value;
+    }
+
+    /**
+     * Scalar division assignment operator
+     */
+    constexpr FixedMatrix &operator /= (const T &value)
+    {
+        for (auto &&element : m_array)
+            element /= value;
+
+        return *this;
+    }
+
+    /**
+     * Equality operator
+     */
+    constexpr bool operator == (const FixedMatrix<Rows, Columns, T> &matrix) const
+    {
+        for (std::size_t i = 0; i < Rows * Columns; ++i)
+            if (m_array[i] != matrix.m_array[i])
+                return false;
+
+        return true;
+    }
+
+    /**
+     * Inequality operator
+     */
+    constexpr bool operator != (const FixedMatrix<Rows, Columns, T> &matrix) const
+    {
+        return !operator == (matrix);
+    }
+
+    /**
+     * Subscript operator; accesses elements by linear (row-major) index
+     */
+    constexpr T &operator [] (std::size_t index)
+    {
+        return m_array[index];
+    }
+
+    /**
+     * Subscript operator; accesses elements by linear (row-major) index
+     */
+    constexpr const T &operator [] (std::size_t index) const
+    {
+        return m_array[index];
+    }
+
+    /**
+     * Function call operator; accesses the element at the specified row and column
+     */
+    constexpr T &operator () (std::size_t i, std::size_t j = 0)
+    {
+        return m_array[i * Columns + j];
+    }
+
+    /**
+     * Function call operator; accesses the element at the specified row and column
+     */
+    constexpr const T &operator () (std::size_t i, std::size_t j = 0) const
+    {
+        return m_array[i * Columns + j];
+    }
+
+    /**
+     * Output stream operator
+     */
+    friend std::ostream &operator << (std::ostream &stream, const FixedMatrix<Rows, Columns, T> &matrix)
+    {
+        for (std::size_t i = 0; i < Rows; ++i)
+        {
+            for (std::size_t j = 0; j < Columns; ++j)
+                stream << (j > 0 ? " " : "") << matrix(i, j);
+
+            stream << std::endl;
+        }
+
+        return stream;
+    }
+
+    /**
+     * Scalar pre-multiplication operator
+     */
+    friend constexpr FixedMatrix operator * (const T &value, const FixedMatrix<Rows, Columns, T> &matrix)
+    {
+        return matrix * value;
+    }
+
+    /**
+     * Return an iterator to the beginning of this matrix's storage
+     */
+    constexpr auto begin(void)
+    {
+        return m_array.begin();
+    }
+
+    /**
+     * Return an iterator to the beginning of this matrix's storage
+     */
+    constexpr auto begin(void) const
+    {
+        return m_array.begin();
+    }
+
+    /**
+     * Calculate the inverse of this matrix by solving for the identity using LU decomposition with partial
+     * pivoting; if this matrix is singular, the elements of the result are set to quiet NaN
+     */
+    template<std::size_t N = Rows, typename std::enable_if<N == Columns, int>::type = 0>
+    constexpr FixedMatrix calcInverse(void) const
+    {
+        FixedMatrix inverse;
+        if (!solve(identity(), inverse))
+            inverse.fill(std::numeric_limits<T>::quiet_NaN());
+
+        return inverse;
+    }
+
+    /**
+     * Return the number of columns in this matrix
+     */
+    static constexpr std::size_t columns(void)
+    {
+        return Columns;
+    }
+
+    /**
+     * Compute the cross product of this 3-vector with another
+     */
+    template<std::size_t N = Rows, typename std::enable_if<N == 3 && Columns == 1, int>::type = 0>
+    constexpr FixedMatrix cross(const FixedMatrix<3, 1, T> &vector) const
+    {
+        return FixedMatrix(m_array[1] * vector[2] - m_array[2] * vector[1],
+                           m_array[2] * vector[0] - m_array[0] * vector[2],
+                           m_array[0] * vector[1] - m_array[1] * vector[0]);
+    }
+
+    /**
+     * Return a pointer to this matrix's storage
+     */
+    constexpr T *data(void)
+    {
+        return m_array.data();
+    }
+
+    /**
+     * Return a pointer to this matrix's storage
+     */
+    constexpr const T *data(void) const
+    {
+        return m_array.data();
+    }
+
+    /**
+     * Compute the dot product of this column vector with another
+     */
+    template<std::size_t N = Columns, typename std::enable_if<N == 1, int>::type = 0>
+    constexpr T dot(const FixedMatrix<Rows, 1, T> &vector) const
+    {
+        T result{};
+        for (std::size_t i = 0; i < Rows; ++i)
+            result += m_array[i] * vector.m_array[i];
+
+        return result;
+    }
+
+    /**
+     * Return an iterator to the end of this matrix's storage
+     */
+    constexpr auto end(void)
+    {
+        return m_array.end();
+    }
+
+    /**
+     * Return an iterator to the end of this matrix's storage
+     */
+    constexpr auto end(void) const
+    {
+        return m_array.end();
+    }
+
+    /**
+     * Set all elements of this matrix to the specified value
+     */
+    constexpr void fill(const T &value)
+    {
+        for (auto &&element : m_array)
+            element = value;
+    }
+
+    /**
+     * Construct a fixed-size matrix from a type which supports subscripted element access, e.g., a Matrix3x3
+     * (array[i][j]), or, for column vectors, a Vector3d (array[i]); also accepts native arrays
+     */
+    template<typename Array>
+    static constexpr FixedMatrix fromArray(const Array &array)
+    {
+        FixedMatrix result;
+        for (std::size_t i = 0; i < Rows; ++i)
+        {
+            if constexpr (Columns == 1)
+                result(i) = array[i];
+            else
+            {
+                for (std::size_t j = 0; j < Columns; ++j)
+                    result(i, j) = array[i][j];
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * Construct a fixed-size matrix from a dynamically-sized two-dimensional matrix, e.g., Matrix<2, T> or
+     * Matrix2d; throws std::invalid_argument if the dimensions of the input matrix do not match
+     */
+    template<typename Matrix>
+    static FixedMatrix fromMatrix(const Matrix &matrix)
+    {
+        if (matrix.rows() != Rows || matrix.columns() != Columns)
+            throw std::invalid_argument("FixedMatrix::fromMatrix(): Input matrix dimensions do not match!");
+
+        FixedMatrix result;
+        for (std::size_t i = 0; i < Rows; ++i)
+            for (std::size_t j = 0; j < Columns; ++j)
+                result(i, j) = matrix(i, j);
+
+        return result;
+    }
+
+    /**
+     * Return the transpose of this matrix
+     */
+    constexpr FixedMatrix<Columns, Rows, T> getTranspose(void) const
+    {
+        FixedMatrix<Columns, Rows, T> result;
+        for (std::size_t i = 0; i < Rows; ++i)
+            for (std::size_t j = 0; j < Columns; ++j)
+                result(j, i) = (*this)(i, j);
+
+        return result;
+    }
+
+    /**
+     * Return an identity matrix
+     */
+    static constexpr FixedMatrix identity(void)
+    {
+        FixedMatrix result;
+        for (std::size_t i = 0; i < Rows && i < Columns; ++i)
+            result(i, i) = T(1);
+
+        return result;
+    }
+
+    /**
+     * Compute the Euclidean norm of this column vector
+     */
+    template<std::size_t N = Columns, typename std::enable_if<N == 1, int>::type = 0>
+    inline T norm(void) const
+    {
+        return std::sqrt(dot(*this));
+    }
+
+    /**
+     * Compute the outer product of this column vector with another, i.e., this * vector^T
+     */
+    template<std::size_t N, std::size_t C = Columns, typename std::enable_if<C == 1, int>::type = 0>
+    constexpr FixedMatrix<Rows, N, T> outerProduct(const FixedMatrix<N, 1, T> &vector) const
+    {
+        FixedMatrix<Rows, N, T> result;
+        for (std::size_t i = 0; i < Rows; ++i)
+            for (std::size_t j = 0; j < N; ++j)
+                result(i, j) = m_array[i] * vector[j];
+
+        return result;
+    }
+
+    /**
+     * Compute the product of this matrix with the transpose of the input matrix, i.e., this * matrix^T, without
+     * forming the transpose
+     */
+    template<std::size_t Inner>
+    constexpr FixedMatrix<Rows, Inner, T>
+    postMultiplyTranspose(const FixedMatrix<Inner, Columns, T> &matrix) const
+    {
+        FixedMatrix<Rows, Inner, T> result;
+        for (std::size_t i = 0; i < Rows; ++i)
+            for (std::size_t j = 0; j < Inner; ++j)
+            {
+                T sum{};
+                for (std::size_t k = 0; k < Columns; ++k)
+                    sum += (*this)(i, k) * matrix(j, k);
+
+                result(i, j) = sum;
+            }
+
+        return result;
+    }
+
+    /**
+     * Compute the product of the transpose of the input matrix with this matrix, i.e., matrix^T * this, without
+     * forming the transpose
+     */
+    template<std::size_t Inner>
+    constexpr FixedMatrix<Inner, Columns, T>
+    preMultiplyTranspose(const FixedMatrix<Rows, Inner, T> &matrix) const
+    {
+        FixedMatrix<Inner, Columns, T> result;
+        for (std::size_t k = 0; k < Rows; ++k)
+            for (std::size_t i = 0; i < Inner; ++i)
+            {
+                auto &&value = matrix(k, i);
+                for (std::size_t j = 0; j < Columns; ++j)
+                    result(i, j) += value * (*this)(k, j);
+            }
+
+        return result;
+    }
+
+    /**
+     * Return the number of rows in this matrix
+     */
+    static constexpr std::size_t rows(void)
+    {
+        return Rows;
+    }
+
+    /**
+     * Return the number of elements in this matrix
+     */
+    static constexpr std::size_t size(void)
+    {
+        return Rows * Columns;
+    }
+
+    /**
+     * Solve the linear system this * x = b for x using LU decomposition with partial pivoting; returns false if
+     * this matrix is singular
+     */
+    template<std::size_t N, std::size_t R = Rows, typename std::enable_if<R == Columns, int>::type = 0>
+    constexpr bool solve(const FixedMatrix<Rows, N, T> &b, FixedMatrix<Rows, N, T> &x) const
+    {
+        auto lu(*this);
+        x = b;
+        for (std::size_t k = 0; k < Rows; ++k)
+        {
+            // find the pivot row
+            auto pivot = k;
+            auto maximum = absoluteValue(lu(k, k));
+            for (std::size_t i = k + 1; i < Rows; ++i)
+            {
+                auto &&value = absoluteValue(lu(i, k));
+                if (value > maximum)
+                {
+                    maximum = value;
+                    pivot = i;
+                }
+            }
+
+            if (maximum == T(0))
+                return false;
+
+            if (pivot != k)
+            {
+                for (std::size_t j = 0; j < Columns; ++j)
+                    swapValues(lu(k, j), lu(pivot, j));
+
+                for (std::size_t j = 0; j < N; ++j)
+                    swapValues(x(k, j), x(pivot, j));
+            }
+
+            // eliminate the entries below the pivot
+            for (std::size_t i = k + 1; i < Rows; ++i)
+            {
+                auto &&factor = lu(i, k) / lu(k, k);
+                for (std::size_t j = k + 1; j < Columns; ++j)
+                    lu(i, j) -= factor * lu(k, j);
+
+                for (std::size_t j = 0; j < N; ++j)
+                    x(i, j) -= factor * x(k, j);
+            }
+        }
+
+        // back substitution
+        for (std::size_t k = Rows; k-- > 0;)
+            for (std::size_t j = 0; j < N; ++j)
+            {
+                auto sum = x(k, j);
+                for (std::size_t i = k + 1; i < Rows; ++i)
+                    sum -= lu(k, i) * x(i, j);
+
+                x(k, j) = sum / lu(k, k);
+            }
+
+        return true;
+    }
+
+    /**
+     * Copy the contents of this matrix to a type which supports subscripted element access, e.g., a Matrix3x3
+     * (array[i][j]), or, for column vectors, a Vector3d (array[i])
+     */
+    template<typename Array>
+    inline void toArray(Array &array) const
+    {
+        for (std::size_t i = 0; i < Rows; ++i)
+        {
+            if constexpr (Columns == 1)
+                array[i] = (*this)(i);
+            else
+            {
+                for (std::size_t j = 0; j < Columns; ++j)
+                    array[i][j] = (*this)(i, j);
+            }
+        }
+    }
+
+    /**
+     * Convert this matrix to a dynamically-sized two-dimensional matrix, e.g., Matrix<2, T> or Matrix2d
+     */
+    template<typename Matrix>
+    inline Matrix toMatrix(void) const
+    {
+        Matrix matrix(Rows, Columns);
+        for (std::size_t i = 0; i < Rows; ++i)
+            for (std::size_t j = 0; j < Columns; ++j)
+                matrix(i, j) = (*this)(i, j);
+
+        return matrix;
+    }
+
+    /**
+     * Compute the trace of this matrix
+     */
+    constexpr T trace(void) const
+    {
+        T result{};
+        for (std::size_t i = 0; i < Rows && i < Columns; ++i)
+            result += (*this)(i, i);
+
+        return result;
+    }
+
+    /**
+     * Transpose this matrix in-place (square matrices only)
+     */
+    template<std::size_t N = Rows, typename std::enable_if<N == Columns, int>::type = 0>
+    constexpr FixedMatrix &transpose(void)
+    {
+        for (std::size_t i = 0; i < Rows; ++i)
+            for (std::size_t j = i + 1; j < Columns; ++j)
+                swapValues((*this)(i, j), (*this)(j, i));
+
+        return *this;
+    }
+
+    /**
+     * Return a matrix of zeros
+     */
+    static constexpr FixedMatrix zeros(void)
+    {
+        return FixedMatrix();
+    }
+
+private:
+
+    /**
+     * constexpr absolute value function
+     */
+    static constexpr T absoluteValue(const T &value)
+    {
+        return value < T(0) ? -value : value;
+    }
+
+    /**
+     * constexpr swap function
+     */
+    static constexpr void swapValues(T &lhs, T &rhs)
+    {
+        T temp = lhs;
+        lhs = rhs;
+        rhs = temp;
+    }
+
+    /**
+     * allow access to the storage of matrices with different extents
+     */
+    template<std::size_t, std::size_t, typename> friend class FixedMatrix;
+
+    /**
+     * array of elements, stored in row-major order
+     */
+    tArray m_array;
+};
+
+/**
+ * Type alias declarations
+ */
+template<std::size_t N, typename T = double> using FixedVector = FixedMatrix<N, 1, T>;
+
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,298 @@
+#include "matrix_multiplier.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <thread>
+#if (defined (__GNUC__) || defined (__clang__)) && (defined (__x86_64__) || defined (__i386__))
+#define MATRIX_MULTIPLIER_X86_SIMD
+#include <immintrin.h>
+#endif
+
+// using namespace declarations
+using namespace utilities;
+
+namespace math
+{
+
+namespace linear_algebra
+{
+
+namespace matrix
+{
+
+// type alias declarations
+using InstructionSet = MatrixMultiplier::InstructionSet;
+
+/**
+ * Function to detect the best instruction set supported by the host processor
+ */
+static InstructionSet detectInstructionSet(void)
+{
+#ifdef MATRIX_MULTIPLIER_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return InstructionSet::AVX512;
+    else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return InstructionSet::AVX2;
+#endif
+    return InstructionSet::Generic;
+}
+
+/**
+ * Function to access the best instruction set supported by the host processor
+ */
+static InstructionSet getSupportedInstructionSet(void)
+{
+    static const InstructionSet instructionSet = detectInstructionSet();
+
+    return instructionSet;
+}
+
+/**
+ * Function to access the instruction set currently used by the double precision micro-kernels
+ */
+static std::atomic<InstructionSet> &getInstructionSetReference(void)
+{
+    static std::atomic<InstructionSet> instructionSet(getSupportedInstructionSet());
+
+    return instructionSet;
+}
+
+/**
+ * Function to access the maximum number of threads used to compute large products
+ */
+static std::atomic<std::size_t> &getMaximumThreadsReference(void)
+{
+    static std::atomic<std::size_t> maximumThreads(1);
+
+    return maximumThreads;
+}
+
+/**
+ * Function to access the multithreading operation count threshold
+ */
+static std::atomic<std::size_t> &getMultithreadingThresholdReference(void)
+{
+    static std::atomic<std::size_t> threshold(128 * 128 * 128);
+
+    return threshold;
+}
+
+/**
+ * Function to access the thread pool used to compute large products
+ */
+static ThreadPool<bool> &getThreadPool(void)
+{
+    static ThreadPool<bool> threadPool(getMaximumThreadsReference().load());
+
+    return threadPool;
+}
+
+#ifdef MATRIX_MULTIPLIER_X86_SIMD
+/**
+ * 6 x 8 double precision micro-kernel using AVX2 and FMA instructions
+ */
+__attribute__ ((target ("avx2,fma")))
+static void microKernelAVX2(std::size_t kc, const double *pA, const double *pB, double *pC, std::size_t ldc)
+{
+    __m256d c[6][2];
+#pragma GCC unroll 6
+    for (std::size_t i = 0; i < 6; ++i)
+    {
+        c[i][0] = _mm256_loadu_pd(pC + i * ldc);
+        c[i][1] = _mm256_loadu_pd(pC + i * ldc + 4);
+    }
+
+    for (std::size_t p = 0; p < kc; ++p, pA += 6, pB += 8)
+    {
+        auto b0 = _mm256_loadu_pd(pB);
+        auto b1 = _mm256_loadu_pd(pB + 4);
+#pragma GCC unroll 6
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+            auto a = _mm256_broadcast_sd(pA + i);
+            c[i][0] = _mm256_fmadd_pd(a, b0, c[i][0]);
+            c[i][1] = _mm256_fmadd_pd(a, b1, c[i][1]);
+        }
+    }
+
+#pragma GCC unroll 6
+    for (std::size_t i = 0; i < 6; ++i)
+    {
+        _mm256_storeu_pd(pC + i * ldc, c[i][0]);
+        _mm256_storeu_pd(pC + i * ldc + 4, c[i][1]);
+    }
+}
+
+/**
+ * 6 x 16 double precision micro-kernel using AVX-512 instructions
+ */
+__attribute__ ((target ("avx512f")))
+static void microKernelAVX512(std::size_t kc, const double *pA, const double *pB, double *pC, std::size_t ldc)
+{
+    __m512d c[6][2];
+#pragma GCC unroll 6
+    for (std::size_t i = 0; i < 6; ++i)
+    {
+        c[i][0] = _mm512_loadu_pd(pC + i * ldc);
+        c[i][1] = _mm512_loadu_pd(pC + i * ldc + 8);
+    }
+
+    for (std::size_t p = 0; p < kc; ++p, pA += 6, pB += 16)
+    {
+        auto b0 = _mm512_loadu_pd(pB);
+        auto b1 = _mm512_loadu_pd(pB + 8);
+#pragma GCC unroll 6
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+            auto a = _mm512_set1_pd(pA[i]);
+            c[i][0] = _mm512_fmadd_pd(a, b0, c[i][0]);
+            c[i][1] = _mm512_fmadd_pd(a, b1, c[i][1]);
+        }
+    }
+
+#pragma GCC unroll 6
+    for (std::size_t i = 0; i < 6; ++i)
+    {
+        _mm512_storeu_pd(pC + i * ldc, c[i][0]);
+        _mm512_storeu_pd(pC + i * ldc + 8, c[i][1]);
+    }
+}
+#endif
+
+/**
+ * Get the instruction set used by the double precision micro-kernels
+ */
+InstructionSet MatrixMultiplier::getInstructionSet(void)
+{
+    return getInstructionSetReference().load();
+}
+
+/**
+ * Get the maximum number of threads used to compute large products
+ */
+std::size_t MatrixMultiplier::getMaximumThreads(void)
+{
+    return getMaximumThreadsReference().load();
+}
+
+/**
+ * Get the operation count (rows * columns * inner) at and above which products are computed using multiple
+ * threads
+ */
+std::size_t MatrixMultiplier::getMultithreadingThreshold(void)
+{
+    return getMultithreadingThresholdReference().load();
+}
+
+/**
+ * Compute the product C = op(A) * op(B) of double precision matrices using the micro-kernels best suited to
+ * the host processor
+ */
+template<>
+void MatrixMultiplier::multiply<double>(std::size_t rows, std::size_t columns, std::size_t inner,
+                                        const double *pLhs, std::size_t lhsRowStride,
+                                        std::size_t lhsColumnStride, const double *pRhs,
+                                        std::size_t rhsRowStride, std::size_t rhsColumnStride,
+                                        double *pResult)
+{
+    std::fill(pResult, pResult + rows * columns, 0.0);
+    if (rows == 0 || columns == 0 || inner == 0)
+        return;
+
+    if (rows * columns * inner < DirectThreshold)
+    {
+        multiplyDirect(rows, columns, inner, pLhs, lhsRowStride, lhsColumnStride,
+                       pRhs, rhsRowStride, rhsColumnStride, pResult);
+
+        return;
+    }
+
+    auto &&instructionSet = getInstructionSet();
+    auto &&granularity = instructionSet == InstructionSet::Generic ? 4 : 6;
+    parallelize(rows, columns, inner, granularity, [&] (std::size_t begin, std::size_t end)
+    {
+        auto *pLhsBegin = pLhs + begin * lhsRowStride;
+        auto *pResultBegin = pResult + begin * columns;
+        switch (instructionSet)
+        {
+#ifdef MATRIX_MULTIPLIER_X86_SIMD
+            case InstructionSet::AVX512:
+            multiplyBlocked<double, 6, 16>(end - begin, columns, inner, pLhsBegin, lhsRowStride,
+                                           lhsColumnStride, pRhs, rhsRowStride, rhsColumnStride,
+                                           pResultBegin, columns, &microKernelAVX512);
+            break;
+
+            case InstructionSet::AVX2:
+            multiplyBlocked<double, 6, 8>(end - begin, columns, inner, pLhsBegin, lhsRowStride,
+                                          lhsColumnStride, pRhs, rhsRowStride, rhsColumnStride,
+                                          pResultBegin, columns, &microKernelAVX2);
+            break;
+#endif
+            default:
+            case InstructionSet::Generic:
+            multiplyBlocked<double, 4, 4>(end - begin, columns, inner, pLhsBegin, lhsRowStride,
+                                          lhsColumnStride, pRhs, rhsRowStride, rhsColumnStride,
+                                          pResultBegin, columns, &microKernel<double, 4, 4>);
+            break;
+        }
+    });
+}
+
+/**
+ * Apply a function to disjoint ranges of result rows, using multiple threads if the product is large enough
+ * and multithreading is enabled
+ * @param granularity the number of rows by which range boundaries must be divisible
+ * @param function    a binary function object which accepts the beginning and end of a range of rows
+ */
+void MatrixMultiplier::parallelize(std::size_t rows, std::size_t columns, std::size_t inner,
+                                   std::size_t granularity,
+                                   const std::function<void (std::size_t, std::size_t)> &function)
+{
+    auto &&maximumThreads = getMaximumThreads();
+    auto &&numBlocks = (rows + granularity - 1) / granularity;
+    auto numThreads = std::min(maximumThreads, numBlocks);
+    if (numThreads <= 1 || rows * columns * inner < getMultithreadingThreshold())
+    {
+        function(0, rows);
+
+        return;
+    }
+
+    getThreadPool().forEachRange(rows, numThreads, granularity, function);
+}
+
+/**
+ * Set the instruction set used by the double precision micro-kernels; requests for instruction sets that are
+ * not supported by the host processor fall back to the best supported instruction set
+ */
+void MatrixMultiplier::setInstructionSet(const InstructionSet &instructionSet)
+{
+    auto &&supportedInstructionSet = getSupportedInstructionSet();
+    getInstructionSetReference() = instructionSet <= supportedInstructionSet ? instructionSet
+                                                                             : supportedInstructionSet;
+}
+
+/**
+ * Set the maximum number of threads used to compute large products (default is one, i.e., single-threaded)
+ */
+void MatrixMultiplier::setMaximumThreads(std::size_t maximumThreads)
+{
+    maximumThreads = std::max<std::size_t>(1, maximumThreads);
+    getMaximumThreadsReference() = maximumThreads;
+    getThreadPool().setMaximumThreads(maximumThreads);
+}
+
+/**
+ * Set the operation count (rows * columns * inner) at and above which products are computed using multiple
+ * threads
+ */
+void MatrixMultiplier::setMultithreadingThreshold(std::size_t threshold)
+{
+    getMultithreadingThresholdReference() = threshold;
+}
+
+}
+
+}
+
+}
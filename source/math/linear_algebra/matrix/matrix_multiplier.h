@@ -0,0 +1,370 @@
+#ifndef MATRIX_MULTIPLIER_H
+#define MATRIX_MULTIPLIER_H
+
+#include "export_library.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace math
+{
+
+namespace linear_algebra
+{
+
+namespace matrix
+{
+
+/**
+ * This class implements a packed, register-tiled, cache-blocked general matrix multiplication kernel which
+ * computes C = op(A) * op(B) for row-major matrices. Each operand is described by a pointer and a pair of
+ * (row, column) strides, so that the supported transposition modes are absorbed by the packing routines and
+ * the inner micro-kernel always streams contiguous data. For double precision operands, micro-kernels which
+ * use AVX2/FMA or AVX-512 instructions are selected at runtime if supported by the host processor. Products
+ * whose operation count exceeds a configurable threshold may optionally be split across multiple threads.
+ *
+ * Within each element of the product, the terms of the inner product are accumulated in the same order as a
+ * naive triple loop; the SIMD micro-kernels use fused multiply-add instructions, so results may differ from
+ * the generic path in the last bits of precision
+ */
+class MatrixMultiplier final
+{
+public:
+
+    /**
+     * Enumerations
+     */
+    enum class InstructionSet { Generic, AVX2, AVX512 };
+
+    /**
+     * Depth of the inner dimension blocks; a KC x NR panel of the packed right-hand side should fit within L1
+     */
+    static constexpr std::size_t KC = 256;
+
+    /**
+     * Number of rows in the left-hand side blocks; an MC x KC packed block should fit within L2
+     */
+    static constexpr std::size_t MC = 96;
+
+    /**
+     * Number of columns in the right-hand side blocks; a KC x NC packed block should fit within L3
+     */
+    static constexpr std::size_t NC = 2048;
+
+    /**
+     * Operation counts (rows * columns * inner) below which the unpacked, direct algorithm is used
+     */
+    static constexpr std::size_t DirectThreshold = 24 * 24 * 24;
+
+private:
+
+    /**
+     * Constructor
+     */
+    MatrixMultiplier(void) = delete;
+
+public:
+
+    /**
+     * Get the instruction set used by the double precision micro-kernels
+     */
+    static EXPORT_STEM InstructionSet getInstructionSet(void);
+
+    /**
+     * Get the maximum number of threads used to compute large products
+     */
+    static EXPORT_STEM std::size_t getMaximumThreads(void);
+
+    /**
+     * Get the operation count (rows * columns * inner) at and above which products are computed using
+     * multiple threads
+     */
+    static EXPORT_STEM std::size_t getMultithreadingThreshold(void);
+
+    /**
+     * Compute the product C = op(A) * op(B), where op(A) is rows x inner and op(B) is inner x columns
+     * @param      rows            the number of rows in op(A) and in the result
+     * @param      columns         the number of columns in op(B) and in the result
+     * @param      inner           the number of columns in op(A) and rows in op(B)
+     * @param      pLhs            a pointer to the first element of A
+     * @param      lhsRowStride    the distance between consecutive rows of op(A)
+     * @param      lhsColumnStride the distance between consecutive columns of op(A)
+     * @param      pRhs            a pointer to the first element of B
+     * @param      rhsRowStride    the distance between consecutive rows of op(B)
+     * @param      rhsColumnStride the distance between consecutive columns of op(B)
+     * @param[out] pResult         a pointer to contiguous, row-major storage for the rows x columns result,
+     *                             which must not alias either operand
+     */
+    template<typename T>
+    static void multiply(std::size_t rows, std::size_t columns, std::size_t inner,
+                         const T *pLhs, std::size_t lhsRowStride, std::size_t lhsColumnStride,
+                         const T *pRhs, std::size_t rhsRowStride, std::size_t rhsColumnStride,
+                         T *pResult)
+    {
+        std::fill(pResult, pResult + rows * columns, T(0));
+        if (rows == 0 || columns == 0 || inner == 0)
+            return;
+
+        if (rows * columns * inner < DirectThreshold)
+            multiplyDirect(rows, columns, inner, pLhs, lhsRowStride, lhsColumnStride,
+                           pRhs, rhsRowStride, rhsColumnStride, pResult);
+        else
+        {
+            parallelize(rows, columns, inner, 4, [&] (std::size_t begin, std::size_t end)
+            {
+                multiplyBlocked<T, 4, 4>(end - begin, columns, inner, pLhs + begin * lhsRowStride,
+                                         lhsRowStride, lhsColumnStride, pRhs, rhsRowStride, rhsColumnStride,
+                                         pResult + begin * columns, columns, &microKernel<T, 4, 4>);
+            });
+        }
+    }
+
+    /**
+     * Set the instruction set used by the double precision micro-kernels; requests for instruction sets that
+     * are not supported by the host processor fall back to the best supported instruction set
+     */
+    static EXPORT_STEM void setInstructionSet(const InstructionSet &instructionSet);
+
+    /**
+     * Set the maximum number of threads used to compute large products (default is one, i.e., single-threaded)
+     */
+    static EXPORT_STEM void setMaximumThreads(std::size_t maximumThreads);
+
+    /**
+     * Set the operation count (rows * columns * inner) at and above which products are computed using
+     * multiple threads
+     */
+    static EXPORT_STEM void setMultithreadingThreshold(std::size_t threshold);
+
+private:
+
+    /**
+     * Get a thread-local buffer in which matrix blocks are packed
+     */
+    template<typename T, int Operand>
+    inline static std::vector<T> &getPackingBuffer(void)
+    {
+        static thread_local std::vector<T> buffer;
+
+        return buffer;
+    }
+
+    /**
+     * Compute a register tile of the product, C[MR x NR] += A[MR x kc] * B[kc x NR], using packed panels of
+     * the left- and right-hand sides
+     * @param kc      the depth of the packed panels
+     * @param pA      a pointer to a packed MR x kc panel of the left-hand side, stored column by column
+     * @param pB      a pointer to a packed kc x NR panel of the right-hand side, stored row by row
+     * @param pC      a pointer to the first element of the result tile
+     * @param ldc     the distance between consecutive rows of the result tile
+     */
+    template<typename T, std::size_t MR, std::size_t NR>
+    static void microKernel(std::size_t kc, const T *pA, const T *pB, T *pC, std::size_t ldc)
+    {
+        T c[MR][NR];
+        for (std::size_t i = 0; i < MR; ++i)
+            for (std::size_t j = 0; j < NR; ++j)
+                c[i][j] = pC[i * ldc + j];
+
+        for (std::size_t p = 0; p < kc; ++p, pA += MR, pB += NR)
+        {
+            for (std::size_t i = 0; i < MR; ++i)
+            {
+                auto &&a = pA[i];
+                for (std::size_t j = 0; j < NR; ++j)
+                    c[i][j] += a * pB[j];
+            }
+        }
+
+        for (std::size_t i = 0; i < MR; ++i)
+            for (std::size_t j = 0; j < NR; ++j)
+                pC[i * ldc + j] = c[i][j];
+    }
+
+    /**
+     * Compute the product C = op(A) * op(B) using the cache-blocked algorithm; the result must be initialized
+     * prior to calling this function
+     */
+    template<typename T, std::size_t MR, std::size_t NR>
+    static void multiplyBlocked(std::size_t rows, std::size_t columns, std::size_t inner,
+                                const T *pLhs, std::size_t lhsRowStride, std::size_t lhsColumnStride,
+                                const T *pRhs, std::size_t rhsRowStride, std::size_t rhsColumnStride,
+                                T *pResult, std::size_t ldc,
+                                void (*kernel)(std::size_t, const T *, const T *, T *, std::size_t))
+    {
+        auto &packedLhs = getPackingBuffer<T, 0>();
+        auto &packedRhs = getPackingBuffer<T, 1>();
+        packedLhs.resize(((std::min(MC, rows) + MR - 1) / MR) * MR * std::min(KC, inner));
+        packedRhs.resize(((std::min(NC, columns) + NR - 1) / NR) * NR * std::min(KC, inner));
+
+        T tile[MR * NR];
+        for (std::size_t jc = 0; jc < columns; jc += NC)
+        {
+            auto nc = std::min(NC, columns - jc);
+            for (std::size_t pc = 0; pc < inner; pc += KC)
+            {
+                auto kc = std::min(KC, inner - pc);
+                packRhs<T, NR>(kc, nc, pRhs + pc * rhsRowStride + jc * rhsColumnStride,
+                               rhsRowStride, rhsColumnStride, packedRhs.data());
+                for (std::size_t ic = 0; ic < rows; ic += MC)
+                {
+                    auto mc = std::min(MC, rows - ic);
+                    packLhs<T, MR>(mc, kc, pLhs + ic * lhsRowStride + pc * lhsColumnStride,
+                                   lhsRowStride, lhsColumnStride, packedLhs.data());
+                    for (std::size_t jr = 0; jr < nc; jr += NR)
+                    {
+                        auto nr = std::min(NR, nc - jr);
+                        for (std::size_t ir = 0; ir < mc; ir += MR)
+                        {
+                            auto mr = std::min(MR, mc - ir);
+                            auto *pA = packedLhs.data() + ir * kc;
+                            auto *pB = packedRhs.data() + jr * kc;
+                            auto *pC = pResult + (ic + ir) * ldc + jc + jr;
+                            if (mr == MR && nr == NR)
+                                kernel(kc, pA, pB, pC, ldc);
+                            else
+                            {
+                                // partial tiles at the matrix edges are computed in a local buffer
+                                std::fill(tile, tile + MR * NR, T(0));
+                                for (std::size_t i = 0; i < mr; ++i)
+                                    std::copy(pC + i * ldc, pC + i * ldc + nr, tile + i * NR);
+
+                                kernel(kc, pA, pB, tile, NR);
+                                for (std::size_t i = 0; i < mr; ++i)
+                                    std::copy(tile + i * NR, tile + i * NR + nr, pC + i * ldc);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Compute the product C = op(A) * op(B) directly (without packing); used for small matrices for which the
+     * cost of packing is not amortized
+     */
+    template<typename T>
+    static void multiplyDirect(std::size_t rows, std::size_t columns, std::size_t inner,
+                               const T *pLhs, std::size_t lhsRowStride, std::size_t lhsColumnStride,
+                               const T *pRhs, std::size_t rhsRowStride, std::size_t rhsColumnStride,
+                               T *pResult)
+    {
+        for (std::size_t i = 0; i < rows; ++i, pLhs += lhsRowStride)
+        {
+            for (std::size_t j = 0; j < columns; ++j)
+            {
+                auto &result_ij = pResult[i * columns + j];
+                auto *pRhsColumn = pRhs + j * rhsColumnStride;
+                for (std::size_t k = 0; k < inner; ++k)
+                    result_ij += pLhs[k * lhsColumnStride] * pRhsColumn[k * rhsRowStride];
+            }
+        }
+    }
+
+    /**
+     * Pack an mc x kc block of the left-hand side into panels of MR rows, each of which is stored column by
+     * column; rows beyond the edge of the matrix are padded with zeros
+     */
+    template<typename T, std::size_t MR>
+    static void packLhs(std::size_t mc, std::size_t kc, const T *pLhs, std::size_t rowStride,
+                        std::size_t columnStride, T *pPacked)
+    {
+        for (std::size_t ir = 0; ir < mc; ir += MR, pPacked += MR * kc)
+        {
+            auto mr = std::min(MR, mc - ir);
+            if (columnStride == 1)
+            {
+                // rows of the operand are contiguous
+                for (std::size_t i = 0; i < mr; ++i)
+                {
+                    auto *pRow = pLhs + (ir + i) * rowStride;
+                    for (std::size_t p = 0; p < kc; ++p)
+                        pPacked[p * MR + i] = pRow[p];
+                }
+            }
+            else
+            {
+                // columns of the operand are contiguous (transposed storage)
+                for (std::size_t p = 0; p < kc; ++p)
+                {
+                    auto *pColumn = pLhs + ir * rowStride + p * columnStride;
+                    for (std::size_t i = 0; i < mr; ++i)
+                        pPacked[p * MR + i] = pColumn[i * rowStride];
+                }
+            }
+
+            for (std::size_t i = mr; i < MR; ++i)
+                for (std::size_t p = 0; p < kc; ++p)
+                    pPacked[p * MR + i] = T(0);
+        }
+    }
+
+    /**
+     * Pack a kc x nc block of the right-hand side into panels of NR columns, each of which is stored row by
+     * row; columns beyond the edge of the matrix are padded with zeros
+     */
+    template<typename T, std::size_t NR>
+    static void packRhs(std::size_t kc, std::size_t nc, const T *pRhs, std::size_t rowStride,
+                        std::size_t columnStride, T *pPacked)
+    {
+        for (std::size_t jr = 0; jr < nc; jr += NR, pPacked += NR * kc)
+        {
+            auto nr = std::min(NR, nc - jr);
+            if (columnStride == 1)
+            {
+                // rows of the operand are contiguous
+                for (std::size_t p = 0; p < kc; ++p)
+                {
+                    auto *pRow = pRhs + p * rowStride + jr;
+                    for (std::size_t j = 0; j < nr; ++j)
+                        pPacked[p * NR + j] = pRow[j];
+                }
+            }
+            else
+            {
+                // columns of the operand are contiguous (transposed storage)
+                for (std::size_t j = 0; j < nr; ++j)
+                {
+                    auto *pColumn = pRhs + (jr + j) * columnStride;
+                    for (std::size_t p = 0; p < kc; ++p)
+                        pPacked[p * NR + j] = pColumn[p * rowStride];
+                }
+            }
+
+            for (std::size_t p = 0; p < kc; ++p)
+                for (std::size_t j = nr; j < NR; ++j)
+                    pPacked[p * NR + j] = T(0);
+        }
+    }
+
+    /**
+     * Apply a function to disjoint ranges of result rows, using multiple threads if the product is large
+     * enough and multithreading is enabled
+     * @param granularity the number of rows by which range boundaries must be divisible
+     * @param function    a binary function object which accepts the beginning and end of a range of rows
+     */
+    static EXPORT_STEM void parallelize(std::size_t rows, std::size_t columns, std::size_t inner,
+                                        std::size_t granularity,
+                                        const std::function<void (std::size_t, std::size_t)> &function);
+};
+
+/**
+ * Compute the product C = op(A) * op(B) of double precision matrices using the micro-kernels best suited to
+ * the host processor
+ */
+template<>
+EXPORT_STEM void MatrixMultiplier::multiply<double>(std::size_t rows, std::size_t columns, std::size_t inner,
+                                                    const double *pLhs, std::size_t lhsRowStride,
+                                                    std::size_t lhsColumnStride, const double *pRhs,
+                                                    std::size_t rhsRowStride, std::size_t rhsColumnStride,
+                                                    double *pResult);
+
+}
+
+}
+
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include "arithmetic_matrix_operations.h"
 #include "doolittle_lu.h"
 #include "general_matrix_2d.h"
+#include "matrix_multiplier.h"
 #include "numeric_matrix.h"
 
 namespace math
@@ -357,13 +358,9 @@ protected:
         auto rhsCols = rhs.m_columns;
         auto rhsRows = rhs.m_rows;
 
-        std::size_t i, j, k;
-        auto *pLhsColIndex = &k;
-        auto *pLhsRowIndex = &i;
-        auto *pRhsColIndex = &j;
-        auto *pRhsRowIndex = &k;
-        auto lhsOffset = lhsCols;
-        auto rhsOffset = rhsCols;
+        // strides between consecutive rows and columns of the (possibly transposed) operands
+        std::size_t lhsRowStride = lhsCols, lhsColumnStride = 1;
+        std::size_t rhsRowStride = rhsCols, rhsColumnStride = 1;
         switch (multiplicationTransposeType)
         {
             default:
@@ -373,23 +370,19 @@ protected:
 
             case MultiplicationTransposeType::PostMultiplyByTranspose:
             std::swap(rhsCols, rhsRows);
-            std::swap(pRhsColIndex, pRhsRowIndex);
-            rhsOffset = rhsRows;
+            std::swap(rhsRowStride, rhsColumnStride);
             break;
 
             case MultiplicationTransposeType::PreMultiplyByTranspose:
             std::swap(lhsCols, lhsRows);
-            std::swap(pLhsColIndex, pLhsRowIndex);
-            lhsOffset = lhsRows;
+            std::swap(lhsRowStride, lhsColumnStride);
             break;
 
             case MultiplicationTransposeType::TransposeBoth:
             std::swap(lhsCols, lhsRows);
-            std::swap(pLhsColIndex, pLhsRowIndex);
+            std::swap(lhsRowStride, lhsColumnStride);
             std::swap(rhsCols, rhsRows);
-            std::swap(pRhsColIndex, pRhsRowIndex);
-            lhsOffset = lhsRows;
-            rhsOffset = rhsRows;
+            std::swap(rhsRowStride, rhsColumnStride);
             break;
         }
 
@@ -408,17 +401,10 @@ protected:
             }
 
             pResult->resize(lhsRows, rhsCols);
-            for (i = 0; i < lhsRows; ++i)
-            {
-                for (j = 0; j < rhsCols; ++j)
-                {
-                    auto &result_ij = pResult->m_vector[i * rhsCols + j];
-                    result_ij = 0.0;
-                    for (k = 0; k < lhsCols; ++k)
-                        result_ij += lhs.m_vector[*pLhsRowIndex * lhsOffset + *pLhsColIndex]
-                                   * rhs.m_vector[*pRhsRowIndex * rhsOffset + *pRhsColIndex];
-                }
-            }
+            MatrixMultiplier::multiply(lhsRows, rhsCols, lhsCols,
+                                       lhs.m_vector.data(), lhsRowStride, lhsColumnStride,
+                                       rhs.m_vector.data(), rhsRowStride, rhsColumnStride,
+                                       pResult->m_vector.data());
 
             if (pResult != &result)
                 result = *pResult;
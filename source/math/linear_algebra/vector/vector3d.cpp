@@ -81,7 +81,7 @@ Vector3d::Vector3d(const Vector3d &vec)
 /**
  * Move constructor
  */
-Vector3d::Vector3d(Vector3d &&vec)
+Vector3d::Vector3d(Vector3d &&vec) noexcept
 {
     operator = (std::move(vec));
 }
@@ -112,7 +112,7 @@ Vector3d &Vector3d::operator = (const Vector3d &vec)
 /**
  * Move assignment operator
  */
-Vector3d &Vector3d::operator = (Vector3d &&vec)
+Vector3d &Vector3d::operator = (Vector3d &&vec) noexcept
 {
     if (&vec != this)
     {
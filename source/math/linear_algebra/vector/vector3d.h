@@ -88,7 +88,7 @@ public:
     /**
      * Move constructor
      */
-    EXPORT_STEM Vector3d(Vector3d &&vec);
+    EXPORT_STEM Vector3d(Vector3d &&vec) noexcept;
 
     /**
      * Destructor
@@ -103,7 +103,7 @@ public:
     /**
      * Move assignment operator
      */
-    EXPORT_STEM Vector3d &operator = (Vector3d &&vec);
+    EXPORT_STEM Vector3d &operator = (Vector3d &&vec) noexcept;
 
     /**
      * Assignment operator (assign imaginary part of quaternion to vector)
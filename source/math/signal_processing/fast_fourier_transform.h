@@ -0,0 +1,730 @@
+#ifndef FAST_FOURIER_TRANSFORM_H
+#define FAST_FOURIER_TRANSFORM_H
+
+#include "math_constants.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace math
+{
+
+namespace signal_processing
+{
+
+/**
+ * This class implements forward and inverse discrete Fourier transforms of complex and real sequences of
+ * arbitrary length. Lengths whose prime factors are 2, 3 and 5 are transformed by a mixed-radix (2, 3, 4 and
+ * 5) Stockham algorithm; all other lengths are transformed by Bluestein's algorithm, which re-expresses the
+ * transform as a convolution evaluated with power-of-two transforms. The factorization and twiddle factors of
+ * each length (its plan) are computed once and cached for use by all subsequent transforms of that length;
+ * each object owns its own workspace, so that distinct objects may be used concurrently. Forward transforms
+ * are unnormalized, while inverse transforms are scaled by the reciprocal of the length
+ */
+template<typename T>
+class FastFourierTransform final
+{
+    static_assert(std::is_floating_point<T>::value, "FastFourierTransform requires a floating-point type.");
+
+public:
+
+    /**
+     * Typedef declarations
+     */
+    typedef std::complex<T> tComplex;
+
+private:
+
+    /**
+     * This structure holds the precomputed data required to transform sequences of a given length
+     */
+    struct Plan
+    {
+        /**
+         * the length of the sequences transformed by this plan
+         */
+        std::size_t m_size;
+
+        /**
+         * the radix of each Stockham stage; empty if the transform is performed by Bluestein's algorithm
+         */
+        std::vector<std::size_t> m_radices;
+
+        /**
+         * the twiddle factors of each Stockham stage, stored by stage output index and then by butterfly leg
+         */
+        std::vector<std::vector<tComplex>> m_twiddles;
+
+        /**
+         * for Bluestein's algorithm, the power-of-two plan with which the convolution is evaluated
+         */
+        std::shared_ptr<const Plan> m_pConvolutionPlan;
+
+        /**
+         * for Bluestein's algorithm, the chirp sequence exp(-i * pi * n^2 / N)
+         */
+        std::vector<tComplex> m_chirp;
+
+        /**
+         * for Bluestein's algorithm, the scaled transform of the conjugated chirp sequence
+         */
+        std::vector<tComplex> m_chirpSpectrum;
+    };
+
+    /**
+     * This structure holds the precomputed data required to transform real sequences of a given even length
+     */
+    struct RealPlan
+    {
+        /**
+         * the plan of the complex half-length transform
+         */
+        std::shared_ptr<const Plan> m_pHalfPlan;
+
+        /**
+         * the twiddle factors exp(-2 * pi * i * k / N), 0 <= k <= N / 4, that combine the half-length transforms
+         */
+        std::vector<tComplex> m_twiddles;
+    };
+
+public:
+
+    /**
+     * Constructor
+     * @param size the length of the sequences to be transformed
+     */
+    FastFourierTransform(std::size_t size = 1)
+    : m_size(0)
+    {
+        setSize(size);
+    }
+
+    /**
+     * Copy constructor
+     */
+    FastFourierTransform(const FastFourierTransform<T> &transform) = default;
+
+    /**
+     * Move constructor
+     */
+    FastFourierTransform(FastFourierTransform<T> &&transform) = default;
+
+    /**
+     * Destructor
+     */
+    ~FastFourierTransform(void)
+    {
+
+    }
+
+    /**
+     * Copy assignment operator
+     */
+    FastFourierTransform<T> &operator = (const FastFourierTransform<T> &transform) = default;
+
+    /**
+     * Move assignment operator
+     */
+    FastFourierTransform<T> &operator = (FastFourierTransform<T> &&transform) = default;
+
+    /**
+     * Release all cached plans; plans in use by existing objects remain valid
+     */
+    static void clearPlans(void)
+    {
+        std::lock_guard<std::mutex> lock(getPlanMutex());
+        getPlans().clear();
+        getRealPlans().clear();
+    }
+
+    /**
+     * Perform an in-place forward transform of a complex sequence of length N
+     */
+    void forward(tComplex *pData)
+    {
+        m_workspace.resize(getWorkspaceSize(*m_pPlan));
+        execute(*m_pPlan, pData, m_workspace.data());
+    }
+
+    /**
+     * Perform an in-place forward transform of a complex sequence; returns false if the length of the sequence
+     * is not equal to that of this object
+     */
+    bool forward(std::vector<tComplex> &data)
+    {
+        bool bSuccess = (data.size() == m_size);
+        if (bSuccess)
+            forward(data.data());
+
+        return bSuccess;
+    }
+
+    /**
+     * Perform a forward transform of a real sequence of length N, storing the N / 2 + 1 non-redundant
+     * coefficients of the (Hermitian) spectrum
+     * @param pInput  a pointer to the real sequence
+     * @param pOutput a pointer to the beginning of the range to which the spectrum is written
+     */
+    void forward(const T *pInput, tComplex *pOutput)
+    {
+        if (m_size % 2 == 0)
+        {
+            // transform the even- and odd-indexed samples, packed as real and imaginary parts, at half length
+            auto &&halfSize = m_size / 2;
+            auto &&realPlan = getRealPlan();
+            for (std::size_t i = 0; i < halfSize; ++i)
+                pOutput[i] = tComplex(pInput[2 * i], pInput[2 * i + 1]);
+
+            m_workspace.resize(getWorkspaceSize(*realPlan.m_pHalfPlan));
+            execute(*realPlan.m_pHalfPlan, pOutput, m_workspace.data());
+
+            // separate the two half-length spectra and combine them
+            auto &&z = pOutput[0];
+            pOutput[halfSize] = tComplex(z.real() - z.imag());
+            pOutput[0] = tComplex(z.real() + z.imag());
+            for (std::size_t k = 1; 2 * k <= halfSize; ++k)
+            {
+                auto &&zk = pOutput[k];
+                auto &&zj = std::conj(pOutput[halfSize - k]);
+                auto &&even = T(0.5) * (zk + zj);
+                auto &&odd = multiply(realPlan.m_twiddles[k], T(0.5) * tComplex((zk - zj).imag(),
+                                                                                 (zj - zk).real()));
+                pOutput[halfSize - k] = std::conj(even - odd);
+                pOutput[k] = even + odd;
+            }
+        }
+        else
+        {
+            m_workspace.resize(m_size + getWorkspaceSize(*m_pPlan));
+            auto *pData = m_workspace.data() + getWorkspaceSize(*m_pPlan);
+            std::copy(pInput, pInput + m_size, pData);
+            execute(*m_pPlan, pData, m_workspace.data());
+            std::copy(pData, pData + m_size / 2 + 1, pOutput);
+        }
+    }
+
+    /**
+     * Get the smallest length greater than or equal to the specified length whose only prime factors are 2, 3
+     * and 5; sequences of such lengths are transformed without recourse to Bluestein's algorithm
+     */
+    static std::size_t getFastSize(std::size_t size)
+    {
+        std::size_t fastSize = 1;
+        while (fastSize < size)
+            fastSize <<= 1;
+
+        for (std::size_t i = 1; i < fastSize; i *= 5)
+            for (std::size_t j = i; j < fastSize; j *= 3)
+            {
+                auto k = j;
+                while (k < size)
+                    k <<= 1;
+
+                fastSize = std::min(fastSize, k);
+            }
+
+        return fastSize;
+    }
+
+    /**
+     * Get the length of the sequences transformed by this object
+     */
+    inline std::size_t getSize(void) const
+    {
+        return m_size;
+    }
+
+    /**
+     * Perform an in-place inverse transform of a complex sequence of length N
+     */
+    void inverse(tComplex *pData)
+    {
+        // the inverse transform is the conjugate of the forward transform of the conjugate sequence
+        std::transform(pData, pData + m_size, pData, [] (const tComplex &z) { return std::conj(z); });
+        forward(pData);
+
+        auto &&scale = T(1) / T(m_size);
+        std::transform(pData, pData + m_size, pData, [scale] (const tComplex &z) { return scale * std::conj(z); });
+    }
+
+    /**
+     * Perform an in-place inverse transform of a complex sequence; returns false if the length of the sequence
+     * is not equal to that of this object
+     */
+    bool inverse(std::vector<tComplex> &data)
+    {
+        bool bSuccess = (data.size() == m_size);
+        if (bSuccess)
+            inverse(data.data());
+
+        return bSuccess;
+    }
+
+    /**
+     * Perform an inverse transform of the N / 2 + 1 non-redundant coefficients of a Hermitian spectrum,
+     * producing a real sequence of length N
+     * @param pInput  a pointer to the spectrum
+     * @param pOutput a pointer to the beginning of the range to which the real sequence is written
+     */
+    void inverse(const tComplex *pInput, T *pOutput)
+    {
+        auto &&scale = T(1) / T(m_size);
+        if (m_size % 2 == 0)
+        {
+            // reassemble the packed half-length spectrum and transform it at half length
+            auto &&halfSize = m_size / 2;
+            auto &&realPlan = getRealPlan();
+            auto &&workspaceSize = getWorkspaceSize(*realPlan.m_pHalfPlan);
+            m_workspace.resize(halfSize + workspaceSize);
+            auto *pData = m_workspace.data() + workspaceSize;
+            pData[0] = tComplex(pInput[0].real() + pInput[halfSize].real(),
+                                pInput[halfSize].real() - pInput[0].real());
+            for (std::size_t k = 1; 2 * k <= halfSize; ++k)
+            {
+                auto &&xk = pInput[k];
+                auto &&xj = std::conj(pInput[halfSize - k]);
+                auto &&even = xk + xj;
+                auto &&odd = multiply(std::conj(realPlan.m_twiddles[k]), xk - xj);
+                auto &&iOdd = tComplex(-odd.imag(), odd.real());
+
+                // conjugate in preparation for the inverse transform
+                pData[k] = std::conj(even + iOdd);
+                pData[halfSize - k] = std::conj(std::conj(even) + tComplex(odd.imag(), odd.real()));
+            }
+
+            execute(*realPlan.m_pHalfPlan, pData, m_workspace.data());
+            for (std::size_t i = 0; i < halfSize; ++i)
+            {
+                pOutput[2 * i] = scale * pData[i].real();
+                pOutput[2 * i + 1] = -scale * pData[i].imag();
+            }
+        }
+        else
+        {
+            auto &&workspaceSize = getWorkspaceSize(*m_pPlan);
+            m_workspace.resize(m_size + workspaceSize);
+            auto *pData = m_workspace.data() + workspaceSize;
+            for (std::size_t k = 0; k <= m_size / 2; ++k)
+            {
+                pData[k] = std::conj(pInput[k]);
+                if (k > 0)
+                    pData[m_size - k] = pInput[k];
+            }
+
+            execute(*m_pPlan, pData, m_workspace.data());
+            for (std::size_t i = 0; i < m_size; ++i)
+                pOutput[i] = scale * pData[i].real();
+        }
+    }
+
+    /**
+     * Set the length of the sequences to be transformed, creating and caching its plan if necessary
+     */
+    void setSize(std::size_t size)
+    {
+        size = std::max<std::size_t>(size, 1);
+        if (size != m_size)
+        {
+            m_size = size;
+            m_pPlan = getPlan(size);
+            m_pRealPlan.reset();
+        }
+    }
+
+private:
+
+    /**
+     * Create the plan for sequences of the specified length
+     */
+    static std::shared_ptr<const Plan> createPlan(std::size_t size)
+    {
+        auto pPlan = std::make_shared<Plan>();
+        pPlan->m_size = size;
+
+        // factor the length, preferring radix-4 stages
+        auto remaining = size;
+        while (remaining % 4 == 0)
+        {
+            pPlan->m_radices.push_back(4);
+            remaining /= 4;
+        }
+
+        for (std::size_t radix : { 2, 3, 5 })
+            while (remaining % radix == 0)
+            {
+                pPlan->m_radices.push_back(radix);
+                remaining /= radix;
+            }
+
+        if (remaining == 1)
+        {
+            // at each stage, a sub-sequence of length n is split into r interleaved sub-sequences of length n / r
+            std::size_t n = size;
+            for (auto &&radix : pPlan->m_radices)
+            {
+                auto &&m = n / radix;
+                std::vector<tComplex> twiddles(m * (radix - 1));
+                for (std::size_t p = 0; p < m; ++p)
+                    for (std::size_t k = 1; k < radix; ++k)
+                        twiddles[p * (radix - 1) + k - 1] = getRootOfUnity(p * k, n);
+
+                pPlan->m_twiddles.push_back(std::move(twiddles));
+                n = m;
+            }
+        }
+        else
+        {
+            // Bluestein's algorithm: X[k] = w[k] * sum_n (x[n] * w[n]) * conj(w[k - n]), w[n] = exp(-i*pi*n^2/N)
+            pPlan->m_radices.clear();
+            std::size_t convolutionSize = 1;
+            while (convolutionSize < 2 * size - 1)
+                convolutionSize <<= 1;
+
+            pPlan->m_pConvolutionPlan = getPlan(convolutionSize);
+            pPlan->m_chirp.resize(size);
+            pPlan->m_chirpSpectrum.assign(convolutionSize, tComplex(0));
+            auto &&scale = T(1) / T(convolutionSize);
+            for (std::size_t n = 0; n < size; ++n)
+            {
+                // reduce n^2 modulo 2N so that the argument of the exponential remains accurate
+                auto &&square = (unsigned long long)n * n % (2ull * size);
+                pPlan->m_chirp[n] = getRootOfUnity(square, 2 * size);
+                pPlan->m_chirpSpectrum[n] = scale * std::conj(pPlan->m_chirp[n]);
+                if (n > 0)
+                    pPlan->m_chirpSpectrum[convolutionSize - n] = pPlan->m_chirpSpectrum[n];
+            }
+
+            std::vector<tComplex> workspace(getWorkspaceSize(*pPlan->m_pConvolutionPlan));
+            execute(*pPlan->m_pConvolutionPlan, pPlan->m_chirpSpectrum.data(), workspace.data());
+        }
+
+        return pPlan;
+    }
+
+    /**
+     * Transform a sequence in place according to the specified plan
+     * @param plan       the plan of the transform
+     * @param pData      a pointer to the sequence
+     * @param pWorkspace a pointer to workspace of at least getWorkspaceSize(plan) elements
+     */
+    static void execute(const Plan &plan, tComplex *pData, tComplex *pWorkspace)
+    {
+        if (plan.m_pConvolutionPlan)
+        {
+            // convolve the chirp-modulated sequence with the conjugate chirp
+            auto &&size = plan.m_size;
+            auto &&convolutionSize = plan.m_pConvolutionPlan->m_size;
+            auto *pConvolution = pWorkspace + getWorkspaceSize(*plan.m_pConvolutionPlan);
+            for (std::size_t n = 0; n < size; ++n)
+                pConvolution[n] = multiply(pData[n], plan.m_chirp[n]);
+
+            std::fill(pConvolution + size, pConvolution + convolutionSize, tComplex(0));
+            execute(*plan.m_pConvolutionPlan, pConvolution, pWorkspace);
+            for (std::size_t k = 0; k < convolutionSize; ++k)
+                pConvolution[k] = std::conj(multiply(pConvolution[k], plan.m_chirpSpectrum[k]));
+
+            execute(*plan.m_pConvolutionPlan, pConvolution, pWorkspace);
+            for (std::size_t k = 0; k < size; ++k)
+                pData[k] = multiply(std::conj(pConvolution[k]), plan.m_chirp[k]);
+
+            return;
+        }
+
+        auto *pInput = pData, *pOutput = pWorkspace;
+        std::size_t n = plan.m_size, stride = 1;
+        for (std::size_t i = 0; i < plan.m_radices.size(); ++i)
+        {
+            auto &&radix = plan.m_radices[i];
+            auto &&m = n / radix;
+            auto *pIn = reinterpret_cast<const T *>(pInput);
+            auto *pOut = reinterpret_cast<T *>(pOutput);
+            auto *pTwiddles = reinterpret_cast<const T *>(plan.m_twiddles[i].data());
+            switch (radix)
+            {
+                case 2:
+                butterfly2(pIn, pOut, pTwiddles, m, stride);
+                break;
+
+                case 3:
+                butterfly3(pIn, pOut, pTwiddles, m, stride);
+                break;
+
+                case 4:
+                butterfly4(pIn, pOut, pTwiddles, m, stride);
+                break;
+
+                default:
+                butterfly5(pIn, pOut, pTwiddles, m, stride);
+            }
+
+            std::swap(pInput, pOutput);
+            n = m;
+            stride *= radix;
+        }
+
+        if (pInput != pData)
+            std::copy(pInput, pInput + plan.m_size, pData);
+    }
+
+    /**
+     * Functions to perform a Stockham stage of the specified radix. Each sub-sequence of length n = r * m,
+     * whose elements are interleaved with the given stride, is split into r sub-sequences of length m; the
+     * butterflies are written in terms of the real and imaginary parts of the data and iterate over the
+     * stride in the innermost loop so that the compiler can vectorize them
+     * @param pIn       a pointer to the input of the stage, viewed as interleaved real and imaginary parts
+     * @param pOut      a pointer to the output of the stage, viewed as interleaved real and imaginary parts
+     * @param pTwiddles a pointer to the twiddle factors of the stage
+     * @param m         the length of the sub-sequences produced by the stage
+     * @param stride    the product of the radices of the preceding stages
+     */
+    static void butterfly2(const T *pIn, T *pOut, const T *pTwiddles, std::size_t m, std::size_t stride)
+    {
+        for (std::size_t p = 0; p < m; ++p)
+        {
+            auto &&wr = pTwiddles[2 * p], &&wi = pTwiddles[2 * p + 1];
+            auto *pA = pIn + 2 * stride * p, *pB = pA + 2 * stride * m;
+            auto *pY0 = pOut + 4 * stride * p, *pY1 = pY0 + 2 * stride;
+            for (std::size_t q = 0; q < 2 * stride; q += 2)
+            {
+                auto &&ar = pA[q], &&ai = pA[q + 1], &&br = pB[q], &&bi = pB[q + 1];
+                auto &&dr = ar - br, &&di = ai - bi;
+                pY0[q] = ar + br;
+                pY0[q + 1] = ai + bi;
+                pY1[q] = dr * wr - di * wi;
+                pY1[q + 1] = dr * wi + di * wr;
+            }
+        }
+    }
+
+    static void butterfly3(const T *pIn, T *pOut, const T *pTwiddles, std::size_t m, std::size_t stride)
+    {
+        const T sine = T(-0.5 * SQRT_THREE);
+        for (std::size_t p = 0; p < m; ++p)
+        {
+            auto *pW = pTwiddles + 4 * p;
+            auto *pA0 = pIn + 2 * stride * p, *pA1 = pA0 + 2 * stride * m, *pA2 = pA1 + 2 * stride * m;
+            auto *pY0 = pOut + 6 * stride * p, *pY1 = pY0 + 2 * stride, *pY2 = pY1 + 2 * stride;
+            for (std::size_t q = 0; q < 2 * stride; q += 2)
+            {
+                auto &&sr = pA1[q] + pA2[q], &&si = pA1[q + 1] + pA2[q + 1];
+                auto &&dr = pA1[q] - pA2[q], &&di = pA1[q + 1] - pA2[q + 1];
+                auto &&mr = pA0[q] - T(0.5) * sr, &&mi = pA0[q + 1] - T(0.5) * si;
+
+                // multiply the difference by -i * sqrt(3) / 2
+                auto &&nr = -sine * di, &&ni = sine * dr;
+                pY0[q] = pA0[q] + sr;
+                pY0[q + 1] = pA0[q + 1] + si;
+                rotate(mr + nr, mi + ni, pW[0], pW[1], pY1 + q);
+                rotate(mr - nr, mi - ni, pW[2], pW[3], pY2 + q);
+            }
+        }
+    }
+
+    static void butterfly4(const T *pIn, T *pOut, const T *pTwiddles, std::size_t m, std::size_t stride)
+    {
+        for (std::size_t p = 0; p < m; ++p)
+        {
+            auto *pW = pTwiddles + 6 * p;
+            auto *pA0 = pIn + 2 * stride * p, *pA1 = pA0 + 2 * stride * m;
+            auto *pA2 = pA1 + 2 * stride * m, *pA3 = pA2 + 2 * stride * m;
+            auto *pY0 = pOut + 8 * stride * p, *pY1 = pY0 + 2 * stride;
+            auto *pY2 = pY1 + 2 * stride, *pY3 = pY2 + 2 * stride;
+            for (std::size_t q = 0; q < 2 * stride; q += 2)
+            {
+                auto &&t0r = pA0[q] + pA2[q], &&t0i = pA0[q + 1] + pA2[q + 1];
+                auto &&t1r = pA0[q] - pA2[q], &&t1i = pA0[q + 1] - pA2[q + 1];
+                auto &&t2r = pA1[q] + pA3[q], &&t2i = pA1[q + 1] + pA3[q + 1];
+
+                // multiply the difference of the odd legs by -i
+                auto &&t3r = pA1[q + 1] - pA3[q + 1], &&t3i = pA3[q] - pA1[q];
+                pY0[q] = t0r + t2r;
+                pY0[q + 1] = t0i + t2i;
+                rotate(t1r + t3r, t1i + t3i, pW[0], pW[1], pY1 + q);
+                rotate(t0r - t2r, t0i - t2i, pW[2], pW[3], pY2 + q);
+                rotate(t1r - t3r, t1i - t3i, pW[4], pW[5], pY3 + q);
+            }
+        }
+    }
+
+    static void butterfly5(const T *pIn, T *pOut, const T *pTwiddles, std::size_t m, std::size_t stride)
+    {
+        const T c1 = T(std::cos(0.4 * PI)), c2 = T(std::cos(0.8 * PI));
+        const T s1 = T(std::sin(0.4 * PI)), s2 = T(std::sin(0.8 * PI));
+        for (std::size_t p = 0; p < m; ++p)
+        {
+            auto *pW = pTwiddles + 8 * p;
+            auto *pA0 = pIn + 2 * stride * p, *pA1 = pA0 + 2 * stride * m, *pA2 = pA1 + 2 * stride * m;
+            auto *pA3 = pA2 + 2 * stride * m, *pA4 = pA3 + 2 * stride * m;
+            auto *pY0 = pOut + 10 * stride * p, *pY1 = pY0 + 2 * stride, *pY2 = pY1 + 2 * stride;
+            auto *pY3 = pY2 + 2 * stride, *pY4 = pY3 + 2 * stride;
+            for (std::size_t q = 0; q < 2 * stride; q += 2)
+            {
+                auto &&t1r = pA1[q] + pA4[q], &&t1i = pA1[q + 1] + pA4[q + 1];
+                auto &&t2r = pA2[q] + pA3[q], &&t2i = pA2[q + 1] + pA3[q + 1];
+                auto &&t3r = pA1[q] - pA4[q], &&t3i = pA1[q + 1] - pA4[q + 1];
+                auto &&t4r = pA2[q] - pA3[q], &&t4i = pA2[q + 1] - pA3[q + 1];
+                auto &&m1r = pA0[q] + c1 * t1r + c2 * t2r, &&m1i = pA0[q + 1] + c1 * t1i + c2 * t2i;
+                auto &&m2r = pA0[q] + c2 * t1r + c1 * t2r, &&m2i = pA0[q + 1] + c2 * t1i + c1 * t2i;
+
+                // multiply the weighted differences by -i
+                auto &&n1r = s1 * t3i + s2 * t4i, &&n1i = -s1 * t3r - s2 * t4r;
+                auto &&n2r = s2 * t3i - s1 * t4i, &&n2i = s1 * t4r - s2 * t3r;
+                pY0[q] = pA0[q] + t1r + t2r;
+                pY0[q + 1] = pA0[q + 1] + t1i + t2i;
+                rotate(m1r + n1r, m1i + n1i, pW[0], pW[1], pY1 + q);
+                rotate(m2r + n2r, m2i + n2i, pW[2], pW[3], pY2 + q);
+                rotate(m2r - n2r, m2i - n2i, pW[4], pW[5], pY3 + q);
+                rotate(m1r - n1r, m1i - n1i, pW[6], pW[7], pY4 + q);
+            }
+        }
+    }
+
+    /**
+     * Get the cached plan for sequences of the specified length, creating it if necessary
+     */
+    static std::shared_ptr<const Plan> getPlan(std::size_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(getPlanMutex());
+            auto &&itPlan = getPlans().find(size);
+            if (itPlan != getPlans().cend())
+                return itPlan->second;
+        }
+
+        // plans are created outside of the lock, since Bluestein plans require other plans
+        auto &&pPlan = createPlan(size);
+        std::lock_guard<std::mutex> lock(getPlanMutex());
+
+        return getPlans().emplace(size, pPlan).first->second;
+    }
+
+    /**
+     * Get the mutex guarding the plan caches
+     */
+    inline static std::mutex &getPlanMutex(void)
+    {
+        static std::mutex mutex;
+
+        return mutex;
+    }
+
+    /**
+     * Get the cache of complex transform plans
+     */
+    inline static std::map<std::size_t, std::shared_ptr<const Plan>> &getPlans(void)
+    {
+        static std::map<std::size_t, std::shared_ptr<const Plan>> plans;
+
+        return plans;
+    }
+
+    /**
+     * Get the real transform plan of this object's length, which must be even
+     */
+    const RealPlan &getRealPlan(void)
+    {
+        if (!m_pRealPlan)
+        {
+            {
+                std::lock_guard<std::mutex> lock(getPlanMutex());
+                auto &&itPlan = getRealPlans().find(m_size);
+                if (itPlan != getRealPlans().cend())
+                    m_pRealPlan = itPlan->second;
+            }
+
+            if (!m_pRealPlan)
+            {
+                auto pRealPlan = std::make_shared<RealPlan>();
+                pRealPlan->m_pHalfPlan = getPlan(m_size / 2);
+                pRealPlan->m_twiddles.resize(m_size / 4 + 1);
+                for (std::size_t k = 0; k < pRealPlan->m_twiddles.size(); ++k)
+                    pRealPlan->m_twiddles[k] = getRootOfUnity(k, m_size);
+
+                std::lock_guard<std::mutex> lock(getPlanMutex());
+                m_pRealPlan = getRealPlans().emplace(m_size, pRealPlan).first->second;
+            }
+        }
+
+        return *m_pRealPlan;
+    }
+
+    /**
+     * Get the cache of real transform plans
+     */
+    inline static std::map<std::size_t, std::shared_ptr<const RealPlan>> &getRealPlans(void)
+    {
+        static std::map<std::size_t, std::shared_ptr<const RealPlan>> plans;
+
+        return plans;
+    }
+
+    /**
+     * Get the root of unity exp(-2 * pi * i * k / n)
+     */
+    inline static tComplex getRootOfUnity(unsigned long long k, std::size_t n)
+    {
+        auto &&angle = -2.0 * PI * double(k % n) / double(n);
+
+        return tComplex(T(std::cos(angle)), T(std::sin(angle)));
+    }
+
+    /**
+     * Get the number of elements of workspace required to execute the specified plan
+     */
+    inline static std::size_t getWorkspaceSize(const Plan &plan)
+    {
+        if (plan.m_pConvolutionPlan)
+            return 2 * plan.m_pConvolutionPlan->m_size;
+
+        return plan.m_size;
+    }
+
+    /**
+     * Multiply two complex numbers without the special handling of infinities performed by operator *
+     */
+    inline static tComplex multiply(const tComplex &x, const tComplex &y)
+    {
+        return tComplex(x.real() * y.real() - x.imag() * y.imag(), x.real() * y.imag() + x.imag() * y.real());
+    }
+
+    /**
+     * Multiply a complex number by a twiddle factor and store the result
+     */
+    inline static void rotate(T xr, T xi, T wr, T wi, T *pResult)
+    {
+        pResult[0] = xr * wr - xi * wi;
+        pResult[1] = xr * wi + xi * wr;
+    }
+
+    /**
+     * the length of the sequences transformed by this object
+     */
+    std::size_t m_size;
+
+    /**
+     * the plan of the complex transform
+     */
+    std::shared_ptr<const Plan> m_pPlan;
+
+    /**
+     * the plan of the real transform, obtained upon first use
+     */
+    std::shared_ptr<const RealPlan> m_pRealPlan;
+
+    /**
+     * workspace used during transforms
+     */
+    std::vector<tComplex> m_workspace;
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,439 @@
+#ifndef BLOCK_CONVOLUTION_FILTER_H
+#define BLOCK_CONVOLUTION_FILTER_H
+
+#include "cloneable.h"
+#include "digital_filter.h"
+#include "fast_fourier_transform.h"
+#include "reflective.h"
+#include "static_mutex_mappable.h"
+#include "static_synchronizable.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace math
+{
+
+namespace signal_processing
+{
+
+namespace filters
+{
+
+/**
+ * This class implements a streaming digital filter stage that accepts a signal in blocks of arbitrary size and
+ * retains its state between calls, such that filtering a signal in pieces produces the same output as
+ * filtering it at once. Finite impulse response (FIR) filters having at least as many taps as the FFT
+ * threshold are evaluated by overlap-save block convolution in the frequency domain, using the most recent
+ * input samples as the overlap between blocks; all other filters, including infinite impulse response (IIR)
+ * filters, are evaluated by the transposed Direct Form II recurrence of DigitalFilter. All workspace is
+ * allocated when the coefficients are set or upon the first call to filter(), so that subsequent calls do not
+ * allocate memory
+ */
+template<typename T>
+class BlockConvolutionFilter
+: public attributes::interfaces::Cloneable<BlockConvolutionFilter<T>>,
+  virtual private attributes::abstract::Reflective,
+  public attributes::concrete::StaticMutexMappable<BlockConvolutionFilter<T>, int, std::mutex *>,
+  public attributes::concrete::StaticSynchronizable<BlockConvolutionFilter<T>>
+{
+public:
+
+    /**
+     * the default number of FIR taps at and above which overlap-save block convolution is used
+     */
+    static constexpr std::size_t DEFAULT_FFT_THRESHOLD = 32;
+
+    /**
+     * Constructor; the filter is initialized to pass the input signal unchanged
+     */
+    BlockConvolutionFilter(void)
+    : BlockConvolutionFilter({ static_cast<T>(1.0) }, { static_cast<T>(1.0) })
+    {
+
+    }
+
+    /**
+     * Constructor
+     * @param a, b are the denominator and numerator coefficient vectors of the filter, as described by
+     *             DigitalFilter
+     */
+    BlockConvolutionFilter(const std::vector<T> &a, const std::vector<T> &b)
+    : m_bOverlapSave(false),
+      m_blockSize(0),
+      m_directLimit(0),
+      m_fftThreshold(DEFAULT_FFT_THRESHOLD)
+    {
+        setCoefficients(a, b);
+    }
+
+    /**
+     * Copy constructor
+     */
+    BlockConvolutionFilter(const BlockConvolutionFilter<T> &filter)
+    {
+        operator = (filter);
+    }
+
+    /**
+     * Move constructor
+     */
+    BlockConvolutionFilter(BlockConvolutionFilter<T> &&filter)
+    {
+        operator = (std::move(filter));
+    }
+
+    /**
+     * Destructor
+     */
+    virtual ~BlockConvolutionFilter(void) override
+    {
+
+    }
+
+    /**
+     * Copy assignment operator
+     */
+    BlockConvolutionFilter<T> &operator = (const BlockConvolutionFilter<T> &filter)
+    {
+        if (&filter != this)
+        {
+            m_bOverlapSave = filter.m_bOverlapSave;
+            m_blockSize = filter.m_blockSize;
+            m_directLimit = filter.m_directLimit;
+            m_fft = filter.m_fft;
+            m_fftThreshold = filter.m_fftThreshold;
+            m_filter = filter.m_filter;
+            m_history = filter.m_history;
+            m_kernelSpectrum = filter.m_kernelSpectrum;
+            m_segment = filter.m_segment;
+            m_spectrum = filter.m_spectrum;
+            m_taps = filter.m_taps;
+        }
+
+        return *this;
+    }
+
+    /**
+     * Move assignment operator
+     */
+    BlockConvolutionFilter<T> &operator = (BlockConvolutionFilter<T> &&filter)
+    {
+        if (&filter != this)
+        {
+            m_bOverlapSave = std::move(filter.m_bOverlapSave);
+            m_blockSize = std::move(filter.m_blockSize);
+            m_directLimit = std::move(filter.m_directLimit);
+            m_fft = std::move(filter.m_fft);
+            m_fftThreshold = std::move(filter.m_fftThreshold);
+            m_filter = std::move(filter.m_filter);
+            m_history = std::move(filter.m_history);
+            m_kernelSpectrum = std::move(filter.m_kernelSpectrum);
+            m_segment = std::move(filter.m_segment);
+            m_spectrum = std::move(filter.m_spectrum);
+            m_taps = std::move(filter.m_taps);
+        }
+
+        return *this;
+    }
+
+    /**
+     * Function to clear the state retained between calls to filter(), such that the next input sample is
+     * treated as the beginning of the signal
+     */
+    inline virtual void clearDelays(void) final
+    {
+        m_filter.clearDelays();
+        std::fill(m_history.begin(), m_history.end(), static_cast<T>(0.0));
+    }
+
+    /**
+     * clone() function
+     */
+    inline virtual BlockConvolutionFilter<T> *clone(void) const override
+    {
+        return new BlockConvolutionFilter<T>(*this);
+    }
+
+    /**
+     * Filter a block of the input signal
+     * @param[in]  x a vector containing the next block of the input signal
+     * @param[out] y a vector containing the filtered output signal (will be resized if necessary)
+     */
+    inline virtual bool filter(const std::vector<T> &x, std::vector<T> &y) final
+    {
+        auto &&size = x.size();
+        if (size != y.size())
+            y.resize(size);
+
+        return size == 0 || filter(x.data(), x.data() + size, y.data());
+    }
+
+    /**
+     * Filter a block of the input signal; the output range may coincide with the input range
+     * @param p_xBegin a pointer to the beginning of the next block of the input signal
+     * @param p_xEnd   a pointer to the element following the end of the range defining the block
+     * @param p_yBegin a pointer to the beginning of a range that will store the filtered output signal
+     */
+    virtual bool filter(const T *p_xBegin, const T *p_xEnd, T *p_yBegin) final
+    {
+        if (!m_bOverlapSave)
+            return m_filter.filter(p_xBegin, p_xEnd, p_yBegin);
+
+        bool bSuccess = (p_xBegin != nullptr && p_xEnd != nullptr && p_yBegin != nullptr);
+        if (bSuccess)
+        {
+            auto &&size = (std::size_t)std::distance(p_xBegin, p_xEnd);
+            auto &&numTaps = m_taps.size();
+            auto &&overlap = m_history.size();
+            auto &&spectrumSize = m_spectrum.size();
+            for (std::size_t i = 0; i < size; i += m_blockSize)
+            {
+                // assemble the overlap and the next block of input, then update the overlap before any output is
+                // written, so that the output range may coincide with the input range
+                auto count = std::min(m_blockSize, size - i);
+                auto *pBlock = p_xBegin + i;
+                std::copy(m_history.cbegin(), m_history.cend(), m_segment.begin());
+                std::copy(pBlock, pBlock + count, m_segment.begin() + overlap);
+                if (count >= overlap)
+                    std::copy(pBlock + count - overlap, pBlock + count, m_history.begin());
+                else
+                {
+                    std::copy(m_history.cbegin() + count, m_history.cend(), m_history.begin());
+                    std::copy(pBlock, pBlock + count, m_history.end() - count);
+                }
+
+                if (count < m_directLimit)
+                {
+                    // short blocks are cheaper to convolve directly
+                    for (std::size_t j = 0; j < count; ++j)
+                    {
+                        auto *pSample = &m_segment[overlap + j];
+                        T sum = 0.0;
+                        for (std::size_t k = 0; k < numTaps; ++k)
+                            sum += m_taps[k] * pSample[-(std::ptrdiff_t)k];
+
+                        p_yBegin[i + j] = sum;
+                    }
+                }
+                else
+                {
+                    // the circular convolution is free of wrap-around beyond the first (overlap) samples
+                    std::fill(m_segment.begin() + overlap + count, m_segment.end(), static_cast<T>(0.0));
+                    m_fft.forward(m_segment.data(), m_spectrum.data());
+                    for (std::size_t k = 0; k < spectrumSize; ++k)
+                    {
+                        auto &&x = m_spectrum[k], &&h = m_kernelSpectrum[k];
+                        x = std::complex<T>(x.real() * h.real() - x.imag() * h.imag(),
+                                            x.real() * h.imag() + x.imag() * h.real());
+                    }
+
+                    m_fft.inverse(m_spectrum.data(), m_segment.data());
+                    std::copy(m_segment.cbegin() + overlap, m_segment.cbegin() + overlap + count, p_yBegin + i);
+                }
+            }
+        }
+        else
+        {
+            this->lock(0);
+            std::cout << "Warning from " + getQualifiedMethodName(__func__) + ": "
+                      << "At least one input argument is null." << std::endl << std::endl;
+            this->unlock(0);
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Get the number of new input samples processed by each overlap-save transform; zero if overlap-save
+     * block convolution is not in use
+     */
+    inline virtual std::size_t getBlockSize(void) const final
+    {
+        return m_bOverlapSave ? m_blockSize : 0;
+    }
+
+    /**
+     * Get the name of this class
+     */
+    inline virtual std::string getClassName(void) const override
+    {
+        return "BlockConvolutionFilter";
+    }
+
+    /**
+     * Get filter numerator and denominator coefficients
+     * @param[out] a populated with a vector of denominator coefficients
+     * @param[out] b populated with a vector of numerator coefficients
+     */
+    inline virtual void getCoefficients(std::vector<T> &a, std::vector<T> &b) const final
+    {
+        m_filter.getCoefficients(a, b);
+    }
+
+    /**
+     * Get the number of FIR taps at and above which overlap-save block convolution is used
+     */
+    inline virtual std::size_t getFftThreshold(void) const final
+    {
+        return m_fftThreshold;
+    }
+
+    /**
+     * Query whether or not the filter is evaluated by overlap-save block convolution
+     */
+    inline virtual bool isOverlapSaveActive(void) const final
+    {
+        return m_bOverlapSave;
+    }
+
+    /**
+     * Set filter numerator and denominator coefficients, as described by DigitalFilter; the state retained
+     * between calls to filter() is cleared
+     * @param a a vector of denominator coefficients
+     * @param b a vector of numerator coefficients
+     */
+    virtual bool setCoefficients(const std::vector<T> &a, const std::vector<T> &b) final
+    {
+        bool bSuccess = m_filter.setCoefficients(a, b);
+        if (bSuccess)
+        {
+            std::vector<T> denominator;
+            m_filter.getCoefficients(denominator, m_taps);
+            m_filter.clearDelays();
+
+            // the filter has a finite impulse response if its denominator is trivial
+            bool bFiniteImpulseResponse = std::all_of(denominator.cbegin() + 1, denominator.cend(),
+                                                      [] (const T &value) { return value == 0.0; });
+            while (m_taps.size() > 1 && m_taps.back() == 0.0)
+                m_taps.pop_back();
+
+            m_bOverlapSave = (bFiniteImpulseResponse && m_taps.size() >= m_fftThreshold);
+            if (m_bOverlapSave)
+                initializeOverlapSave();
+        }
+
+        if (!bSuccess || !m_bOverlapSave)
+        {
+            m_bOverlapSave = false;
+            m_history.clear();
+            m_kernelSpectrum.clear();
+            m_segment.clear();
+            m_spectrum.clear();
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Set the number of FIR taps at and above which overlap-save block convolution is used; the state retained
+     * between calls to filter() is cleared
+     */
+    inline virtual void setFftThreshold(std::size_t threshold) final
+    {
+        m_fftThreshold = threshold;
+
+        std::vector<T> a, b;
+        m_filter.getCoefficients(a, b);
+        setCoefficients(a, b);
+    }
+
+private:
+
+    /**
+     * Choose the transform length and precompute the spectrum of the taps for overlap-save block convolution
+     */
+    void initializeOverlapSave(void)
+    {
+        // choose the power-of-two transform length that minimizes the cost per output sample
+        auto &&numTaps = m_taps.size();
+        auto &&getCost = [numTaps] (std::size_t size)
+        {
+            return double(size) * std::log2(double(size)) / double(size - numTaps + 1);
+        };
+
+        std::size_t minimumSize = 2, fftSize = 0;
+        while (minimumSize < 2 * numTaps)
+            minimumSize <<= 1;
+
+        for (auto size = minimumSize; size <= 16 * minimumSize; size <<= 1)
+            if (fftSize == 0 || getCost(size) < getCost(fftSize))
+                fftSize = size;
+
+        m_blockSize = fftSize - numTaps + 1;
+        m_directLimit = std::size_t(double(fftSize) * std::log2(double(fftSize)) / double(numTaps));
+        m_fft.setSize(fftSize);
+        m_history.assign(numTaps - 1, static_cast<T>(0.0));
+        m_segment.assign(fftSize, static_cast<T>(0.0));
+        m_spectrum.resize(fftSize / 2 + 1);
+        m_kernelSpectrum.resize(fftSize / 2 + 1);
+        std::copy(m_taps.cbegin(), m_taps.cend(), m_segment.begin());
+        m_fft.forward(m_segment.data(), m_kernelSpectrum.data());
+    }
+
+    /**
+     * flag indicating whether or not the filter is evaluated by overlap-save block convolution
+     */
+    bool m_bOverlapSave;
+
+    /**
+     * the number of new input samples processed by each overlap-save transform
+     */
+    std::size_t m_blockSize;
+
+    /**
+     * the number of input samples below which a block is convolved directly rather than transformed
+     */
+    std::size_t m_directLimit;
+
+    /**
+     * fast Fourier transform used by overlap-save block convolution
+     */
+    FastFourierTransform<T> m_fft;
+
+    /**
+     * the number of FIR taps at and above which overlap-save block convolution is used
+     */
+    std::size_t m_fftThreshold;
+
+    /**
+     * digital filter which evaluates the recurrence when overlap-save block convolution is not in use
+     */
+    DigitalFilter<T> m_filter;
+
+    /**
+     * the most recent input samples, one fewer than the number of taps, which overlap the next block
+     */
+    std::vector<T> m_history;
+
+    /**
+     * spectrum of the zero-padded taps
+     */
+    std::vector<std::complex<T>> m_kernelSpectrum;
+
+    /**
+     * workspace vector holding the overlap and the next block of input
+     */
+    std::vector<T> m_segment;
+
+    /**
+     * workspace vector holding the spectrum of a segment
+     */
+    std::vector<std::complex<T>> m_spectrum;
+
+    /**
+     * the FIR taps (normalized numerator coefficients without trailing zeros)
+     */
+    std::vector<T> m_taps;
+};
+
+}
+
+}
+
+}
+
+#endif
@@ -2,12 +2,19 @@
 #define FILTER_H
 
 #include "cloneable.h"
+#include "jenkins_traub.h"
 #include "reflective.h"
 #include "static_mutex_mappable.h"
 #include "static_synchronizable.h"
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
 #include <iostream>
+#include <limits>
 #include <mutex>
+#include <numeric>
+#include <type_traits>
 #include <vector>
 
 namespace math
@@ -21,7 +28,9 @@ namespace filters
 
 /**
  * This class implements algorithms to perform infinite impulse response (IIR) or finite impulse response (FIR)
- * digital filtering
+ * digital filtering. Filters may be evaluated either in direct form or as a cascade of second-order sections,
+ * and many channels that share the same coefficients can be filtered together, in which case the channels are
+ * advanced in lockstep so that the inner loop over channels can be vectorized by the compiler
  */
 template<typename T>
 class DigitalFilter
@@ -32,11 +41,18 @@ class DigitalFilter
 {
 public:
 
+    /**
+     * Enumerations
+     */
+    enum class ChannelLayout { Interleaved, // each frame holds one sample of every channel
+                               Planar };    // each channel's samples are contiguous
+
     /**
      * Constructor
      */
     DigitalFilter(void)
     : m_denCoeffs({ static_cast<T>(0.0) }),
+      m_numChannels(0),
       m_numCoeffs({ static_cast<T>(1.0) })
     {
 
@@ -52,6 +68,7 @@ public:
      *
      */
     DigitalFilter(const std::vector<T> &a, const std::vector<T> &b)
+    : m_numChannels(0)
     {
         setCoefficients(a, b);
     }
@@ -87,9 +104,15 @@ public:
     {
         if (&filter != this)
         {
+            m_buffer = filter.m_buffer;
+            m_channelDelays = filter.m_channelDelays;
             m_delays = filter.m_delays;
             m_denCoeffs = filter.m_denCoeffs;
+            m_frame = filter.m_frame;
+            m_numChannels = filter.m_numChannels;
             m_numCoeffs = filter.m_numCoeffs;
+            m_sectionDelays = filter.m_sectionDelays;
+            m_sections = filter.m_sections;
         }
 
         return *this;
@@ -102,9 +125,15 @@ public:
     {
         if (&filter != this)
         {
+            m_buffer = std::move(filter.m_buffer);
+            m_channelDelays = std::move(filter.m_channelDelays);
             m_delays = std::move(filter.m_delays);
             m_denCoeffs = std::move(filter.m_denCoeffs);
+            m_frame = std::move(filter.m_frame);
+            m_numChannels = std::move(filter.m_numChannels);
             m_numCoeffs = std::move(filter.m_numCoeffs);
+            m_sectionDelays = std::move(filter.m_sectionDelays);
+            m_sections = std::move(filter.m_sections);
         }
 
         return *this;
@@ -115,7 +144,9 @@ public:
      */
     inline virtual void clearDelays(void) final
     {
+        std::fill(m_channelDelays.begin(), m_channelDelays.end(), 0.0);
         std::fill(m_delays.begin(), m_delays.end(), 0.0);
+        std::fill(m_sectionDelays.begin(), m_sectionDelays.end(), 0.0);
     }
 
     /**
@@ -126,6 +157,110 @@ public:
         return new DigitalFilter<T>(*this);
     }
 
+    /**
+     * Decompose the filter's rational system function into a cascade of second-order sections, which are used
+     * thereafter to evaluate the filter. The poles and zeros of the system function are found and grouped into
+     * conjugate (or real) pairs; each pair of poles is matched with the nearest remaining pair of zeros,
+     * starting with the poles closest to the unit circle, and the sections are ordered such that those with
+     * poles closest to the unit circle come last. High-order filters evaluated in this manner are much less
+     * sensitive to round-off than in direct form; however, the sections can be no more accurate than the roots
+     * recovered from the direct-form coefficients, so filters whose poles are clustered closely (e.g.,
+     * high-order, narrow-band designs) are best specified by their sections in the first place (see
+     * setSecondOrderSections()). Only filters with real (floating-point) coefficients can be decomposed. The
+     * filter delays are cleared
+     */
+    virtual bool convertToSecondOrderSections(void) final
+    {
+        // the decomposition requires real coefficients, whose roots can be ordered and paired
+        auto &&n = m_denCoeffs.size();
+        bool bSuccess = (std::is_floating_point<T>::value && n != 0 && n == m_numCoeffs.size() &&
+                         m_denCoeffs[0] != 0.0);
+        if constexpr (std::is_floating_point<T>::value)
+        {
+            if (bSuccess)
+            {
+                // the system function is B(z) / A(z) with both polynomials of degree order in z; leading zeros in
+                // the numerator correspond to zeros at infinity (i.e., pure delays)
+                auto &&order = n - 1;
+                std::size_t numDelays = 0;
+                while (numDelays < order && m_numCoeffs[numDelays] == 0.0)
+                    ++numDelays;
+
+                auto &&gain = m_numCoeffs[numDelays] / m_denCoeffs[0];
+                std::vector<std::complex<T>> poles, zeros;
+                // zeros (but not poles, which would then lie on the unit circle) within round-off of z = 1 or z = -1
+                // are placed there exactly
+                bSuccess = findRoots(m_denCoeffs.data(), n, false, poles) &&
+                           findRoots(m_numCoeffs.data() + numDelays, n - numDelays, true, zeros);
+
+                // group the roots into factors of the form c[0] + c[1] z^-1 + c[2] z^-2; each factor's location
+                // is the root used to match poles and zeros
+                std::vector<std::array<T, 3>> denFactors, numFactors;
+                std::vector<std::complex<T>> denLocations, numLocations;
+                if (bSuccess)
+                {
+                    groupRoots(poles, 0, denFactors, denLocations);
+                    groupRoots(zeros, numDelays, numFactors, numLocations);
+
+                    // order the pole pairs by increasing proximity to the unit circle
+                    std::vector<std::size_t> indices(denFactors.size());
+                    std::iota(indices.begin(), indices.end(), 0);
+                    std::sort(indices.begin(), indices.end(), [&denLocations] (std::size_t i, std::size_t j)
+                    {
+                        return std::fabs(T(1.0) - std::abs(denLocations[i])) >
+                               std::fabs(T(1.0) - std::abs(denLocations[j]));
+                    });
+
+                    auto numSections = std::max<std::size_t>(1, indices.size());
+                    m_sections.assign(5 * numSections, 0.0);
+                    m_sections[0] = T(1.0);
+                    std::vector<bool> bUsed(numFactors.size(), false);
+                    for (std::size_t s = indices.size(); s-- > 0;)
+                    {
+                        auto &&location = denLocations[indices[s]];
+                        std::size_t nearest = numFactors.size();
+                        for (std::size_t i = 0; i < numFactors.size(); ++i)
+                        {
+                            if (!bUsed[i] && (nearest == numFactors.size() ||
+                                std::abs(numLocations[i] - location) < std::abs(numLocations[nearest] - location)))
+                                nearest = i;
+                        }
+
+                        auto *pSection = &m_sections[5 * s];
+                        auto &&denFactor = denFactors[indices[s]];
+                        if (nearest < numFactors.size())
+                        {
+                            bUsed[nearest] = true;
+                            std::copy(numFactors[nearest].cbegin(), numFactors[nearest].cend(), pSection);
+                        }
+
+                        pSection[3] = denFactor[1];
+                        pSection[4] = denFactor[2];
+                    }
+
+                    // the overall gain is applied to the first section
+                    for (std::size_t i = 0; i < 3; ++i)
+                        m_sections[i] *= gain;
+
+                    m_sectionDelays.assign(2 * numSections, 0.0);
+                    m_channelDelays.clear();
+                    m_numChannels = 0;
+                }
+            }
+        }
+
+        if (!bSuccess)
+        {
+            this->lock(0);
+            std::cout << "Warning from " + getQualifiedMethodName(__func__) + ": "
+                      << "Failed to decompose the filter into second-order sections."
+                      << std::endl << std::endl;
+            this->unlock(0);
+        }
+
+        return bSuccess;
+    }
+
     /**
      * Digital signal filtering function (see description in overloads that follow)
      * @param it_xBegin an iterator (or pointer) to the beginning of the input data sequence to be filtered
@@ -209,7 +344,9 @@ public:
     {
         auto &&n = m_denCoeffs.size();
         bool bSuccess = (n != 0 && n == m_numCoeffs.size());
-        if (bSuccess)
+        if (bSuccess && !m_sections.empty())
+            filterFrames(p_xBegin, p_yBegin, std::distance(p_xBegin, p_xEnd), 1, m_sectionDelays.data());
+        else if (bSuccess)
         {
             auto &&p = (size_t)std::distance(p_xBegin, p_xEnd);
             auto &&q = m_delays.size();
@@ -241,6 +378,163 @@ public:
         return bSuccess;
     }
 
+    /**
+     * Multi-channel digital signal filtering function; filters several independent channels with this object's
+     * coefficients (see the single-channel overload). All channels are advanced together one frame at a time,
+     * and the filter delays of each channel are retained between calls for as long as the number of channels
+     * does not change
+     * @param p_xBegin    a pointer to the beginning of the input data sequence to be filtered
+     * @param p_xEnd      a pointer to the element following the end of the range defining the input data
+     *                    sequence, the length of which must be a multiple of the number of channels
+     * @param p_yBegin    a pointer to the beginning of a range that will store the values arising from the
+     *                    filtration process, arranged in the same layout as the input; may coincide with the
+     *                    input range
+     * @param numChannels the number of channels
+     * @param layout      the arrangement of the channels' samples within the input and output ranges
+     */
+    virtual bool filter(const T *p_xBegin, const T *p_xEnd, T *p_yBegin, std::size_t numChannels,
+                        ChannelLayout layout = ChannelLayout::Interleaved)
+    {
+        auto &&size = static_cast<std::size_t>(std::distance(p_xBegin, p_xEnd));
+        bool bSuccess = validateChannels(size, numChannels);
+        if (bSuccess)
+        {
+            auto &&numDelays = getNumDelaysPerChannel() * numChannels;
+            if (numChannels != m_numChannels || numDelays != m_channelDelays.size())
+            {
+                m_channelDelays.assign(numDelays, 0.0);
+                m_numChannels = numChannels;
+            }
+
+            auto &&numFrames = size / numChannels;
+            if (layout == ChannelLayout::Interleaved)
+                filterFrames(p_xBegin, p_yBegin, numFrames, numChannels, m_channelDelays.data());
+            else
+            {
+                // planar channels are transposed block by block into interleaved frames, filtered and then
+                // transposed back into the output
+                auto blockSize = std::max<std::size_t>(1, PLANAR_BLOCK_SIZE / numChannels);
+                m_buffer.resize(blockSize * numChannels);
+                for (std::size_t i = 0; i < numFrames; i += blockSize)
+                {
+                    auto numBlockFrames = std::min(blockSize, numFrames - i);
+                    for (std::size_t k = 0; k < numChannels; ++k)
+                        for (std::size_t j = 0; j < numBlockFrames; ++j)
+                            m_buffer[j * numChannels + k] = p_xBegin[k * numFrames + i + j];
+
+                    filterFrames(m_buffer.data(), m_buffer.data(), numBlockFrames, numChannels,
+                                 m_channelDelays.data());
+                    for (std::size_t k = 0; k < numChannels; ++k)
+                        for (std::size_t j = 0; j < numBlockFrames; ++j)
+                            p_yBegin[k * numFrames + i + j] = m_buffer[j * numChannels + k];
+                }
+            }
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Zero-phase digital signal filtering function; the input is filtered in the forward direction and the
+     * result is then filtered in the reverse direction, so that the output has no phase distortion and a
+     * magnitude response equal to the square of that of the filter. To reduce edge transients, the signal is
+     * extended at both ends by odd reflection about its end points, and the filter delays of each pass are
+     * initialized to their steady-state response to the first sample of that pass. As in scipy's filtfilt(),
+     * the extension spans 3 * max(a.size(), b.size()) samples (three times one more than the filter order),
+     * but it is shortened to one sample fewer than the signal rather than rejecting shorter signals. The filter
+     * delays retained by this object are not modified
+     * @param[in]  x a vector containing the input signal
+     * @param[out] y a vector containing the filtered output signal (will be resized if necessary)
+     */
+    inline virtual bool filtfilt(const std::vector<T> &x, std::vector<T> &y)
+    {
+        auto &&size = x.size();
+        if (size != y.size())
+            y.resize(size);
+
+        return filtfilt(x.data(), x.data() + size, y.data());
+    }
+
+    /**
+     * Zero-phase digital signal filtering function (see description in overloads above and below)
+     * @param p_xBegin a pointer to the beginning of the input data sequence to be filtered
+     * @param p_xEnd   a pointer to the element following the end of the range defining the input data sequence
+     * @param p_yBegin a pointer to the beginning of a range that will store the values arising from the
+     *                 filtration process; may coincide with the input range
+     */
+    inline virtual bool filtfilt(const T *p_xBegin, const T *p_xEnd, T *p_yBegin)
+    {
+        return filtfilt(p_xBegin, p_xEnd, p_yBegin, 1);
+    }
+
+    /**
+     * Multi-channel zero-phase digital signal filtering function (see description in overloads above)
+     * @param p_xBegin    a pointer to the beginning of the input data sequence to be filtered
+     * @param p_xEnd      a pointer to the element following the end of the range defining the input data
+     *                    sequence, the length of which must be a multiple of the number of channels
+     * @param p_yBegin    a pointer to the beginning of a range that will store the values arising from the
+     *                    filtration process, arranged in the same layout as the input; may coincide with the
+     *                    input range
+     * @param numChannels the number of channels
+     * @param layout      the arrangement of the channels' samples within the input and output ranges
+     */
+    virtual bool filtfilt(const T *p_xBegin, const T *p_xEnd, T *p_yBegin, std::size_t numChannels,
+                          ChannelLayout layout = ChannelLayout::Interleaved)
+    {
+        auto &&size = static_cast<std::size_t>(std::distance(p_xBegin, p_xEnd));
+        bool bSuccess = validateChannels(size, numChannels);
+        if (bSuccess && size > 0)
+        {
+            auto &&numFrames = size / numChannels;
+            auto &&bPlanar = (layout == ChannelLayout::Planar);
+            auto &&input = [&] (std::size_t i, std::size_t k)
+            {
+                return bPlanar ? p_xBegin[k * numFrames + i] : p_xBegin[i * numChannels + k];
+            };
+
+            // extend the signal at both ends by odd reflection about its end points
+            auto numEdgeFrames = std::min<std::size_t>(3 * m_numCoeffs.size(), numFrames - 1);
+            auto &&numExtendedFrames = numFrames + 2 * numEdgeFrames;
+            m_buffer.resize(numExtendedFrames * numChannels);
+            for (std::size_t k = 0; k < numChannels; ++k)
+            {
+                for (std::size_t i = 0; i < numFrames; ++i)
+                    m_buffer[(numEdgeFrames + i) * numChannels + k] = input(i, k);
+
+                auto &&first = input(0, k), last = input(numFrames - 1, k);
+                for (std::size_t i = 1; i <= numEdgeFrames; ++i)
+                {
+                    m_buffer[(numEdgeFrames - i) * numChannels + k] = T(2.0) * first - input(i, k);
+                    m_buffer[(numEdgeFrames + numFrames - 1 + i) * numChannels + k] =
+                        T(2.0) * last - input(numFrames - 1 - i, k);
+                }
+            }
+
+            // filter forward, reverse the frames, filter again and reverse back
+            auto &&numDelaysPerChannel = getNumDelaysPerChannel();
+            std::vector<T> delays(numDelaysPerChannel * numChannels), steadyStateDelays;
+            computeSteadyStateDelays(steadyStateDelays);
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                for (std::size_t j = 0; j < numDelaysPerChannel; ++j)
+                    for (std::size_t k = 0; k < numChannels; ++k)
+                        delays[j * numChannels + k] = steadyStateDelays[j] * m_buffer[k];
+
+                filterFrames(m_buffer.data(), m_buffer.data(), numExtendedFrames, numChannels, delays.data());
+                for (std::size_t i = 0, j = numExtendedFrames - 1; i < j; ++i, --j)
+                    std::swap_ranges(&m_buffer[i * numChannels], &m_buffer[(i + 1) * numChannels],
+                                     &m_buffer[j * numChannels]);
+            }
+
+            for (std::size_t k = 0; k < numChannels; ++k)
+                for (std::size_t i = 0; i < numFrames; ++i)
+                    (bPlanar ? p_yBegin[k * numFrames + i] : p_yBegin[i * numChannels + k]) =
+                        m_buffer[(numEdgeFrames + i) * numChannels + k];
+        }
+
+        return bSuccess;
+    }
+
     /**
      * Get the name of this class
      */
@@ -264,22 +558,46 @@ public:
     }
 
     /**
-     * Get current state of filter delays
+     * Get current state of filter delays; when the filter is evaluated as a cascade of second-order sections,
+     * these are the two delays of each section in turn
      * @param[out] delays populated with a vector of filter delays
      */
     inline virtual void getDelays(std::vector<T> &delays) final
     {
-        delays.resize(m_delays.size());
+        auto &&activeDelays = getDelays();
+        delays.resize(activeDelays.size());
 
-        std::copy(m_delays.cbegin(), m_delays.cend(), delays.begin());
+        std::copy(activeDelays.cbegin(), activeDelays.cend(), delays.begin());
     }
 
     /**
-     * Get current state of filter delays
+     * Get current state of filter delays; when the filter is evaluated as a cascade of second-order sections,
+     * these are the two delays of each section in turn
      */
     inline virtual const std::vector<T> &getDelays(void) const final
     {
-        return m_delays;
+        return m_sections.empty() ? m_delays : m_sectionDelays;
+    }
+
+    /**
+     * Get the second-order sections used to evaluate the filter, if any
+     * @param[out] sections populated with the coefficients of the sections, stored consecutively as
+     *                      { b0, b1, b2, a0, a1, a2 } for each section, where a0 is one
+     */
+    inline virtual void getSecondOrderSections(std::vector<T> &sections) const final
+    {
+        auto &&numSections = m_sections.size() / 5;
+        sections.resize(6 * numSections);
+        for (std::size_t s = 0; s < numSections; ++s)
+        {
+            auto *pSection = &m_sections[5 * s];
+            sections[6 * s + 0] = pSection[0];
+            sections[6 * s + 1] = pSection[1];
+            sections[6 * s + 2] = pSection[2];
+            sections[6 * s + 3] = T(1.0);
+            sections[6 * s + 4] = pSection[3];
+            sections[6 * s + 5] = pSection[4];
+        }
     }
 
     /**
@@ -324,6 +642,10 @@ public:
         if (&b != &m_numCoeffs)
             m_numCoeffs = std::move(b);
 
+        // the filter reverts to direct form until it is decomposed again
+        m_sectionDelays.clear();
+        m_sections.clear();
+
         auto &&order = getOrder();
         if (order != static_cast<long>(m_delays.size()))
             m_delays.resize(order);
@@ -373,28 +695,95 @@ public:
     }
 
     /**
-     * Set initial filter delays
+     * Set the filter coefficients from a cascade of second-order sections, which are used thereafter to
+     * evaluate the filter; the direct-form coefficients become the products of the sections' numerator and
+     * denominator polynomials. The filter delays are cleared
+     * @param sections the coefficients of the sections, stored consecutively as { b0, b1, b2, a0, a1, a2 } for
+     *                 each section
+     */
+    virtual bool setSecondOrderSections(const std::vector<T> &sections) final
+    {
+        auto &&numSections = sections.size() / 6;
+        bool bSuccess = (numSections > 0 && sections.size() == 6 * numSections);
+        for (std::size_t s = 0; bSuccess && s < numSections; ++s)
+            bSuccess = (sections[6 * s + 3] != 0.0);
+
+        if (bSuccess)
+        {
+            std::vector<T> a({ T(1.0) }), b({ T(1.0) });
+            std::vector<T> normalized(5 * numSections);
+            for (std::size_t s = 0; s < numSections; ++s)
+            {
+                auto *pSection = &sections[6 * s];
+                auto &&norm = pSection[3];
+                for (std::size_t i = 0; i < 3; ++i)
+                    normalized[5 * s + i] = pSection[i] / norm;
+
+                normalized[5 * s + 3] = pSection[4] / norm;
+                normalized[5 * s + 4] = pSection[5] / norm;
+
+                // multiply the sections' polynomials together to form the direct-form coefficients
+                std::vector<T> a_product(a.size() + 2, 0.0), b_product(b.size() + 2, 0.0);
+                for (std::size_t i = 0; i < a.size(); ++i)
+                {
+                    for (std::size_t j = 0; j < 3; ++j)
+                    {
+                        a_product[i + j] += a[i] * pSection[3 + j] / norm;
+                        b_product[i + j] += b[i] * pSection[j] / norm;
+                    }
+                }
+
+                a = std::move(a_product);
+                b = std::move(b_product);
+            }
+
+            bSuccess = setCoefficients(std::move(a), std::move(b));
+            if (bSuccess)
+            {
+                m_sections = std::move(normalized);
+                m_sectionDelays.assign(2 * numSections, 0.0);
+                m_channelDelays.clear();
+                m_numChannels = 0;
+            }
+        }
+        else
+        {
+            this->lock(0);
+            std::cout << "Warning from " + getQualifiedMethodName(__func__) + ": "
+                      << "Second-order sections must be given as rows of six coefficients with non-zero a0."
+                      << std::endl << std::endl;
+            this->unlock(0);
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Set initial filter delays; when the filter is evaluated as a cascade of second-order sections, the vector
+     * contains the two delays of each section in turn, as returned by getDelays()
      * @param delays a vector of filter delays
      */
     virtual bool setDelays(std::vector<T> &&delays) final
     {
         if (!delays.empty()) // initial condition was not specified
         {
-            if (static_cast<long>(delays.size()) != getOrder())
+            auto &activeDelays = m_sections.empty() ? m_delays : m_sectionDelays;
+            if (delays.size() != getNumDelaysPerChannel())
             {
                 this->lock(0);
                 std::cout << "Warning from " + getQualifiedMethodName(__func__) + ": "
                           << "Size of filter delay vector should be one less than "
                           << "the maximum length of the numerator and denominator "
-                          << "coefficient vectors." << std::endl << std::endl;
+                          << "coefficient vectors, or twice the number of second-order "
+                          << "sections." << std::endl << std::endl;
                 this->unlock(0);
 
-                std::fill(m_delays.begin(), m_delays.end(), 0.0);
+                std::fill(activeDelays.begin(), activeDelays.end(), 0.0);
 
                 return false;
             }
-            else if (&delays != &m_delays) // set the filter delays using the specified initial condition
-                std::copy(delays.cbegin(), delays.cend(), m_delays.begin());
+            else if (&delays != &activeDelays) // set the filter delays using the specified initial condition
+                std::copy(delays.cbegin(), delays.cend(), activeDelays.begin());
         }
 
         return true;
@@ -409,8 +798,388 @@ public:
         return setDelays(std::vector<T>(delays));
     }
 
+    /**
+     * Query whether or not the filter is evaluated as a cascade of second-order sections
+     */
+    inline virtual bool usesSecondOrderSections(void) const final
+    {
+        return !m_sections.empty();
+    }
+
 protected:
 
+    /**
+     * Compute the filter delays of a single channel in steady state for a unit step input, such that a
+     * constant input multiplied by these delays yields a constant output from the first sample
+     * @param[out] delays populated with a vector of filter delays
+     */
+    virtual void computeSteadyStateDelays(std::vector<T> &delays) const final
+    {
+        auto &&steadyState = [] (const T *b, const T *a, std::size_t order, T scale, T *pDelays)
+        {
+            // solves (I - A) z = B for the transposed direct form II state matrix A, where a[0] is one
+            T denominator = T(1.0), numerator = T(0.0);
+            for (std::size_t j = 1; j <= order; ++j)
+            {
+                denominator += a[j];
+                numerator += b[j] - a[j] * b[0];
+            }
+
+            if (order > 0)
+            {
+                pDelays[0] = denominator != 0.0 ? scale * numerator / denominator : T(0.0);
+                T asum = T(1.0), csum = T(0.0);
+                for (std::size_t j = 1; j < order; ++j)
+                {
+                    asum += a[j];
+                    csum += b[j] - a[j] * b[0];
+                    pDelays[j] = denominator != 0.0 ? asum * pDelays[0] - scale * csum : T(0.0);
+                }
+            }
+        };
+
+        delays.assign(getNumDelaysPerChannel(), 0.0);
+        if (m_sections.empty())
+            steadyState(m_numCoeffs.data(), m_denCoeffs.data(), m_delays.size(), T(1.0), delays.data());
+        else
+        {
+            // each section's input in steady state is the step scaled by the DC gain of preceding sections
+            T scale = T(1.0);
+            for (std::size_t s = 0; s < m_sections.size() / 5; ++s)
+            {
+                auto *pSection = &m_sections[5 * s];
+                const T a[] = { T(1.0), pSection[3], pSection[4] };
+                steadyState(pSection, a, 2, scale, &delays[2 * s]);
+                auto &&denominator = a[0] + a[1] + a[2];
+                scale *= denominator != 0.0 ? (pSection[0] + pSection[1] + pSection[2]) / denominator : T(0.0);
+            }
+        }
+    }
+
+    /**
+     * Advance the filter over a block of interleaved frames, all channels in lockstep
+     * @param p_x         a pointer to the beginning of the interleaved input frames
+     * @param p_y         a pointer to the beginning of the interleaved output frames; may coincide with p_x
+     * @param numFrames   the number of frames
+     * @param numChannels the number of channels
+     * @param p_delays    a pointer to the filter delays of every channel, stored by delay and then by channel
+     */
+    virtual void filterFrames(const T *p_x, T *p_y, std::size_t numFrames, std::size_t numChannels,
+                              T *p_delays) final
+    {
+        if (!m_sections.empty())
+        {
+            auto &&numSections = m_sections.size() / 5;
+            for (std::size_t i = 0; i < numFrames; ++i)
+            {
+                auto *pInput = p_x + i * numChannels;
+                auto *pOutput = p_y + i * numChannels;
+                for (std::size_t s = 0; s < numSections; ++s)
+                {
+                    auto *pSection = &m_sections[5 * s];
+                    auto b0 = pSection[0], b1 = pSection[1], b2 = pSection[2];
+                    auto a1 = pSection[3], a2 = pSection[4];
+                    auto *pDelays0 = p_delays + 2 * s * numChannels;
+                    auto *pDelays1 = pDelays0 + numChannels;
+                    for (std::size_t k = 0; k < numChannels; ++k)
+                    {
+                        auto x = pInput[k];
+                        auto y = b0 * x + pDelays0[k];
+                        pDelays0[k] = b1 * x - a1 * y + pDelays1[k];
+                        pDelays1[k] = b2 * x - a2 * y;
+                        pOutput[k] = y;
+                    }
+
+                    // each subsequent section filters the output of the section that precedes it
+                    pInput = pOutput;
+                }
+            }
+        }
+        else
+        {
+            // the input frame is copied, since the output may overwrite it before the delays are updated
+            auto &&q = m_delays.size();
+            m_frame.resize(numChannels);
+            auto *pFrame = m_frame.data();
+            for (std::size_t i = 0; i < numFrames; ++i)
+            {
+                auto *pOutput = p_y + i * numChannels;
+                std::copy(p_x + i * numChannels, p_x + (i + 1) * numChannels, pFrame);
+                auto b0 = m_numCoeffs[0];
+                if (q > 0)
+                {
+                    for (std::size_t k = 0; k < numChannels; ++k)
+                        pOutput[k] = b0 * pFrame[k] + p_delays[k];
+
+                    for (std::size_t j = 1; j <= q; ++j)
+                    {
+                        auto b = m_numCoeffs[j], a = m_denCoeffs[j];
+                        auto *pDelays = p_delays + (j - 1) * numChannels;
+                        if (j < q)
+                        {
+                            auto *pNextDelays = pDelays + numChannels;
+                            for (std::size_t k = 0; k < numChannels; ++k)
+                                pDelays[k] = pNextDelays[k] + b * pFrame[k] - a * pOutput[k];
+                        }
+                        else
+                        {
+                            for (std::size_t k = 0; k < numChannels; ++k)
+                                pDelays[k] = b * pFrame[k] - a * pOutput[k];
+                        }
+                    }
+                }
+                else
+                {
+                    for (std::size_t k = 0; k < numChannels; ++k)
+                        pOutput[k] = b0 * pFrame[k];
+                }
+            }
+        }
+    }
+
+    /**
+     * Find the roots of a polynomial in z, the coefficients of which are given in order of decreasing degree
+     * @param      pCoeffs   a pointer to the polynomial coefficients
+     * @param      numCoeffs the number of coefficients
+     * @param      bUnitRoots   flag indicating that roots within round-off of z = 1 and z = -1 should be placed
+     *                          there exactly
+     * @param[out] roots     populated with the roots of the polynomial
+     */
+    static bool findRoots(const T *pCoeffs, std::size_t numCoeffs, bool bUnitRoots,
+                          std::vector<std::complex<T>> &roots)
+    {
+        // roots at the origin are counted directly, since the solver requires a non-zero constant term
+        auto &&degree = numCoeffs - 1;
+        while (numCoeffs > 1 && pCoeffs[numCoeffs - 1] == 0.0)
+            --numCoeffs;
+
+        roots.assign(degree, std::complex<T>(0.0, 0.0));
+        std::vector<T> coeffs(pCoeffs, pCoeffs + numCoeffs), quotient;
+
+        // roots at z = 1 and z = -1, which filter designs commonly place with high multiplicity, are removed by
+        // synthetic division; the solver resolves a root of multiplicity m only to within the m-th root of the
+        // machine precision, which the pairing of roots into sections cannot recover
+        auto &&tolerance = 16 * std::numeric_limits<T>::epsilon() * degree;
+        auto itRoot = roots.begin() + (degree - numCoeffs + 1);
+        for (auto &&root : { T(1.0), T(-1.0) })
+        {
+            if (!bUnitRoots)
+                break;
+
+            while (coeffs.size() > 1)
+            {
+                T norm = 0.0;
+                quotient.resize(coeffs.size() - 1);
+                quotient[0] = coeffs[0];
+                for (std::size_t i = 1; i < quotient.size(); ++i)
+                {
+                    quotient[i] = coeffs[i] + root * quotient[i - 1];
+                    norm += std::fabs(coeffs[i]);
+                }
+
+                auto &&remainder = coeffs.back() + root * quotient.back();
+                norm += std::fabs(coeffs[0]) + std::fabs(coeffs.back());
+                if (std::fabs(remainder) > tolerance * norm)
+                    break;
+
+                coeffs.swap(quotient);
+                *itRoot++ = root;
+            }
+        }
+
+        bool bSuccess = true;
+        if (coeffs.size() > 1)
+        {
+            expression::polynomial::solvers::JenkinsTraub<T> rootSolver;
+            std::vector<std::complex<T>> remaining(coeffs.size() - 1);
+            bSuccess = (rootSolver.findRoots(coeffs, remaining) == remaining.size());
+
+            // the solver's deflation degrades the accuracy of later roots, so each root is polished by Newton's
+            // method on the undeflated polynomial for as long as its residual decreases
+            auto &&evaluate = [&coeffs] (const std::complex<T> &z, std::complex<T> &derivative)
+            {
+                std::complex<T> value(0.0, 0.0);
+                derivative = value;
+                for (auto &&coeff : coeffs)
+                {
+                    derivative = derivative * z + value;
+                    value = value * z + coeff;
+                }
+
+                return value;
+            };
+
+            auto &&separation = [] (const std::vector<std::complex<T>> &roots, std::size_t i)
+            {
+                auto distance = std::numeric_limits<T>::max();
+                for (std::size_t j = 0; j < roots.size(); ++j)
+                    if (j != i)
+                        distance = std::min(distance, std::abs(roots[i] - roots[j]));
+
+                return distance;
+            };
+
+            auto polished = remaining;
+            for (auto &&root : polished)
+            {
+                std::complex<T> derivative;
+                auto &&value = evaluate(root, derivative);
+                for (int i = 0; i < MAX_POLISHING_ITERATIONS && derivative != T(0.0); ++i)
+                {
+                    std::complex<T> newDerivative;
+                    auto &&newRoot = root - value / derivative;
+                    auto &&newValue = evaluate(newRoot, newDerivative);
+                    if (std::abs(newValue) >= std::abs(value))
+                        break;
+
+                    root = newRoot;
+                    value = newValue;
+                    derivative = newDerivative;
+                }
+            }
+
+            // within a tight cluster, Newton's method may draw neighbouring roots onto the same root, in which
+            // case the unpolished roots are kept
+            for (std::size_t i = 0; i < polished.size(); ++i)
+                if (2 * separation(polished, i) >= separation(remaining, i))
+                    remaining[i] = polished[i];
+
+            std::copy(remaining.cbegin(), remaining.cend(), itRoot);
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Get the number of filter delays of each channel
+     */
+    inline std::size_t getNumDelaysPerChannel(void) const
+    {
+        return m_sections.empty() ? m_delays.size() : m_sectionDelays.size();
+    }
+
+    /**
+     * Group the roots of a real polynomial into first- and second-order factors with real coefficients,
+     * pairing complex roots with their conjugates and real roots with one another
+     * @param      roots        the finite roots of the polynomial
+     * @param      numInfinite  the number of additional roots at infinity, represented by factors of z^-1
+     * @param[out] factors      populated with the coefficients { c0, c1, c2 } of each factor
+     *                          c0 + c1 z^-1 + c2 z^-2
+     * @param[out] locations    populated with a representative root of each factor
+     */
+    static void groupRoots(std::vector<std::complex<T>> roots, std::size_t numInfinite,
+                           std::vector<std::array<T, 3>> &factors, std::vector<std::complex<T>> &locations)
+    {
+        // each complex root is paired with the remaining root nearest its conjugate rather than with its exact
+        // conjugate, since repeated roots are resolved only approximately by the root finder and the products
+        // of the computed roots are far more accurate than the roots themselves; roots whose imaginary parts
+        // are within round-off of zero are considered real
+        auto &&tolerance = std::sqrt(std::numeric_limits<T>::epsilon());
+        std::sort(roots.begin(), roots.end(), [] (const std::complex<T> &x, const std::complex<T> &y)
+        {
+            return std::fabs(x.imag()) > std::fabs(y.imag());
+        });
+
+        std::vector<T> real;
+        factors.clear();
+        locations.clear();
+        while (!roots.empty())
+        {
+            auto root = roots.front();
+            roots.erase(roots.begin());
+            auto itPartner = std::min_element(roots.begin(), roots.end(),
+                                              [&root] (const std::complex<T> &x, const std::complex<T> &y)
+            {
+                return std::abs(x - std::conj(root)) < std::abs(y - std::conj(root));
+            });
+
+            if (itPartner == roots.end() ||
+                std::fabs(root.imag()) <= tolerance * std::max(T(1.0), std::abs(root)))
+                real.push_back(root.real());
+            else
+            {
+                auto &&mean = T(0.5) * (root + std::conj(*itPartner));
+                factors.push_back({ T(1.0), -2 * mean.real(), std::norm(mean) });
+                locations.push_back(root);
+                roots.erase(itPartner);
+            }
+        }
+
+        // real roots are paired in order of magnitude, with roots at infinity last; the location of each pair is
+        // its root of larger magnitude
+        std::sort(real.begin(), real.end(), [] (const T &x, const T &y) { return std::fabs(x) < std::fabs(y); });
+        std::vector<std::array<T, 2>> linear;
+        for (auto &&root : real)
+            linear.push_back({ T(1.0), -root });
+
+        linear.resize(real.size() + numInfinite, { T(0.0), T(1.0) });
+        auto &&infinity = std::numeric_limits<T>::max();
+        for (std::size_t i = 0; i < linear.size(); i += 2)
+        {
+            auto &&u = linear[i];
+            auto j = std::min(i + 1, linear.size() - 1);
+            locations.emplace_back(j < real.size() ? real[j] : infinity, T(0.0));
+            if (i + 1 < linear.size())
+            {
+                auto &&v = linear[i + 1];
+                factors.push_back({ u[0] * v[0], u[0] * v[1] + u[1] * v[0], u[1] * v[1] });
+            }
+            else
+                factors.push_back({ u[0], u[1], T(0.0) });
+        }
+    }
+
+    /**
+     * Validate the coefficients and the arrangement of channels for multi-channel filtering
+     * @param size        the total number of samples of all channels
+     * @param numChannels the number of channels
+     */
+    bool validateChannels(std::size_t size, std::size_t numChannels)
+    {
+        auto &&n = m_denCoeffs.size();
+        bool bSuccess = (n != 0 && n == m_numCoeffs.size());
+        if (!bSuccess)
+        {
+            this->lock(0);
+            std::cout << "Warning from " + getQualifiedMethodName(__func__) + ": "
+                      << "Invalid filter numerator and/or denominator coefficients."
+                      << std::endl << std::endl;
+            this->unlock(0);
+        }
+        else if (numChannels == 0 || size % numChannels != 0)
+        {
+            this->lock(0);
+            std::cout << "Warning from " + getQualifiedMethodName(__func__) + ": "
+                      << "Number of samples must be a non-zero multiple of the number of channels."
+                      << std::endl << std::endl;
+            this->unlock(0);
+
+            bSuccess = false;
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * the maximum number of Newton iterations used to polish each root of the system function
+     */
+    static constexpr int MAX_POLISHING_ITERATIONS = 8;
+
+    /**
+     * the number of samples of planar channels that are interleaved at once
+     */
+    static constexpr std::size_t PLANAR_BLOCK_SIZE = 4096;
+
+    /**
+     * workspace for interleaving planar channels and for zero-phase filtering
+     */
+    std::vector<T> m_buffer;
+
+    /**
+     * the filter delays of each channel in multi-channel filtering, stored by delay and then by channel
+     */
+    std::vector<T> m_channelDelays;
+
     /**
      * vector of filter delays
      */
@@ -421,10 +1190,31 @@ protected:
      */
     std::vector<T> m_denCoeffs;
 
+    /**
+     * a copy of the current input frame in direct-form multi-channel filtering
+     */
+    std::vector<T> m_frame;
+
+    /**
+     * the number of channels for which multi-channel filter delays are retained
+     */
+    std::size_t m_numChannels;
+
     /**
      * numerator coefficients
      */
     std::vector<T> m_numCoeffs;
+
+    /**
+     * the filter delays of the second-order sections in single-channel filtering, two per section
+     */
+    std::vector<T> m_sectionDelays;
+
+    /**
+     * the normalized coefficients of the second-order sections, stored consecutively as { b0, b1, b2, a1, a2 }
+     * for each section; empty if the filter is evaluated in direct form
+     */
+    std::vector<T> m_sections;
 };
 
 }
@@ -69,6 +69,17 @@ public:
     {
         return "MovingAverage";
     }
+
+protected:
+
+    /**
+     * Get the factor by which the multi-channel running sums are scaled to produce the filter output
+     * @param numSamples the number of samples in the window
+     */
+    inline virtual T getScale(long numSamples) const override
+    {
+        return T(1.0) / T(numSamples);
+    }
 };
 
 }
@@ -37,7 +37,7 @@ public:
         if (this->m_pCalculator != nullptr)
             delete this->m_pCalculator;
 
-        this->m_pCalculator = new Statistical::Correlation<T>(bBiasedEstimate);
+        this->m_pCalculator = new statistical::Correlation<T>(bBiasedEstimate);
     }
 
     /**
@@ -84,7 +84,7 @@ public:
      */
     MovingCorrelation<T> &operator = (MovingCorrelation<T> &&filter)
     {
-        if (&interpolator != this)
+        if (&filter != this)
         {
             MovingCovariance<T>::operator = (std::move(filter));
         }
@@ -99,6 +99,17 @@ public:
     {
         return new MovingCorrelation<T>(*this);
     }
+
+protected:
+
+    /**
+     * Query whether or not the multi-channel co-moments are normalized by the standard deviations of the two
+     * sequences, yielding correlations rather than covariances
+     */
+    inline virtual bool isNormalized(void) const override
+    {
+        return true;
+    }
 };
 
 }
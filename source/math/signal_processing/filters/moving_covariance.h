@@ -25,6 +25,7 @@ public:
     /**
      * Typedef declarations
      */
+    using typename DigitalFilter<T>::ChannelLayout;
     using DigitalFilter<T>::filter;
 
     /**
@@ -33,7 +34,7 @@ public:
      */
     MovingCovariance(int period, bool bBiasedEstimate = false)
     : m_bBiasedEstimate(bBiasedEstimate),
-      m_pCalculator(new Statistical::Covariance<T>(bBiasedEstimate)),
+      m_pCalculator(new statistical::Covariance<T>(bBiasedEstimate)),
       m_period(period)
     {
 
@@ -139,28 +140,26 @@ public:
      * @param[in]  p_yBegin a pointer to a range containing the y data sequence
      * @param[out] p_yBegin points to the calculated moving covariance values
      */
-    virtual bool filter(const T *p_xBegin, const T *p_xEnd, T *p_yBegin)
+    virtual bool filter(const T *p_xBegin, const T *p_xEnd, T *p_yBegin) override
     {
-        bool bSuccess = (m_pCalculator != nullptr);
+        bool bSuccess = (m_period > 0 && m_pCalculator != nullptr);
         if (bSuccess)
         {
+            // the y samples in the window are held in a ring buffer, since their values are overwritten by the
+            // output
             m_buffer.resize(m_period);
-            std::copy(p_yBegin, p_yBegin + m_period, m_buffer.begin());
-
             m_pCalculator->initialize();
             auto &&size = static_cast<int>(std::distance(p_xBegin, p_xEnd));
-            for (int i = 0; i < size; ++i)
+            for (int i = 0, j = 0; i < size; ++i)
             {
-                m_pCalculator->addSample(p_xBegin[i], p_yBegin[i]);
+                auto sample = p_yBegin[i];
+                m_pCalculator->addSample(p_xBegin[i], sample);
                 if (i >= m_period)
-                {
-                    T sample = m_buffer.front();
-                    std::rotate(m_buffer.begin(), m_buffer.begin() + 1, m_buffer.end());
-                    m_buffer.back() = p_yBegin[i];
+                    bSuccess &= m_pCalculator->deleteSample(p_xBegin[i - m_period], m_buffer[j]);
 
-                    bSuccess &= m_pCalculator->deleteSample(p_xBegin[i - m_period],
-                                                            p_yBegin[i - m_period]);
-                }
+                m_buffer[j] = sample;
+                if (++j == m_period)
+                    j = 0;
 
                 if (bSuccess)
                     p_yBegin[i] = m_pCalculator->calculate();
@@ -172,6 +171,106 @@ public:
         return bSuccess;
     }
 
+    /**
+     * This function calculates the moving covariance of several independent pairs of channels, the samples of
+     * which are interleaved such that each frame holds one sample of every channel. Channels are updated
+     * together in each frame using running means and co-moments, so that the cost per sample does not depend
+     * on the period and the inner loop over channels can be vectorized by the compiler
+     * @param      p_xBegin    a pointer to the beginning of the interleaved x data sequence
+     * @param      p_xEnd      a pointer to the element following the end of the range that defines the x data
+     *                         sequence, the length of which must be a multiple of the number of channels
+     * @param[in]  p_yBegin    a pointer to a range containing the interleaved y data sequence
+     * @param[out] p_yBegin    points to the calculated interleaved moving covariance values
+     * @param      numChannels the number of channels
+     * @param      layout      the arrangement of the channels' samples; planar channels are not supported and
+     *                         are rejected
+     */
+    virtual bool filter(const T *p_xBegin, const T *p_xEnd, T *p_yBegin, std::size_t numChannels,
+                        ChannelLayout layout = ChannelLayout::Interleaved) override
+    {
+        auto &&size = static_cast<std::size_t>(std::distance(p_xBegin, p_xEnd));
+        bool bSuccess = (layout == ChannelLayout::Interleaved && m_period > 0 && numChannels > 0 &&
+                         size % numChannels == 0);
+        if (bSuccess)
+        {
+            // correlations additionally require the sums of squared deviations of each sequence
+            bool bNormalize = isNormalized();
+            auto &&numFrames = size / numChannels;
+            m_buffer.resize(m_period * numChannels);
+            m_moments.assign(5 * numChannels, T(0.0));
+            auto *pMeans_x = m_moments.data(), *pMeans_y = pMeans_x + numChannels;
+            auto *pSums_xy = pMeans_y + numChannels, *pSums_xx = pSums_xy + numChannels;
+            auto *pSums_yy = pSums_xx + numChannels;
+            for (std::size_t i = 0, j = 0; i < numFrames; ++i)
+            {
+                auto *pBuffer = &m_buffer[j * numChannels];
+                auto *pInput_x = p_xBegin + i * numChannels;
+                auto *pOutput = p_yBegin + i * numChannels;
+                bool bFull = (i >= std::size_t(m_period));
+                auto numSamples = std::min<std::size_t>(i + 1, m_period);
+                auto &&addScale = T(1.0) / T(bFull ? numSamples + 1 : numSamples);
+                auto &&deleteScale = T(1.0) / T(numSamples);
+                for (std::size_t k = 0; k < numChannels; ++k)
+                {
+                    auto x = pInput_x[k], y = pOutput[k];
+                    auto delta_x = x - pMeans_x[k], delta_y = y - pMeans_y[k];
+                    pMeans_x[k] += delta_x * addScale;
+                    pMeans_y[k] += delta_y * addScale;
+                    pSums_xy[k] += delta_x * (y - pMeans_y[k]);
+                    if (bNormalize)
+                    {
+                        pSums_xx[k] += delta_x * (x - pMeans_x[k]);
+                        pSums_yy[k] += delta_y * (y - pMeans_y[k]);
+                    }
+                }
+
+                if (bFull)
+                {
+                    auto *pDeleted_x = pInput_x - m_period * numChannels;
+                    for (std::size_t k = 0; k < numChannels; ++k)
+                    {
+                        auto x = pDeleted_x[k], y = pBuffer[k];
+                        auto delta_x = x - pMeans_x[k], delta_y = y - pMeans_y[k];
+                        pMeans_x[k] -= delta_x * deleteScale;
+                        pMeans_y[k] -= delta_y * deleteScale;
+                        pSums_xy[k] -= delta_x * (y - pMeans_y[k]);
+                        if (bNormalize)
+                        {
+                            pSums_xx[k] = std::max(T(0.0), pSums_xx[k] - delta_x * (x - pMeans_x[k]));
+                            pSums_yy[k] = std::max(T(0.0), pSums_yy[k] - delta_y * (y - pMeans_y[k]));
+                        }
+                    }
+                }
+
+                if (bNormalize && numSamples > 1)
+                {
+                    for (std::size_t k = 0; k < numChannels; ++k)
+                    {
+                        auto &&product = pSums_xx[k] * pSums_yy[k];
+                        pBuffer[k] = pOutput[k];
+                        pOutput[k] = product > 0.0 ? pSums_xy[k] / std::sqrt(product) : T(0.0);
+                    }
+                }
+                else
+                {
+                    // a window of a single sample has no spread, so its correlation is taken to be zero
+                    auto &&divisor = T(m_bBiasedEstimate ? numSamples : numSamples - 1);
+                    auto &&outputScale = numSamples > 1 && !bNormalize ? T(1.0) / divisor : T(0.0);
+                    for (std::size_t k = 0; k < numChannels; ++k)
+                    {
+                        pBuffer[k] = pOutput[k];
+                        pOutput[k] = outputScale * pSums_xy[k];
+                    }
+                }
+
+                if (++j == std::size_t(m_period))
+                    j = 0;
+            }
+        }
+
+        return bSuccess;
+    }
+
     /**
      * Query whether or not biased estimate is enabled/disabled
      */
@@ -208,20 +307,35 @@ public:
 
 protected:
 
+    /**
+     * Query whether or not the multi-channel co-moments are normalized by the standard deviations of the two
+     * sequences, yielding correlations rather than covariances
+     */
+    inline virtual bool isNormalized(void) const
+    {
+        return false;
+    }
+
     /**
      * flag to indicate that the estimate will be biased
      */
     bool m_bBiasedEstimate;
 
     /**
-     * buffer vector to hold values when source and destination vectors are the same
+     * ring buffer holding the y samples in the moving window
      */
     std::vector<T> m_buffer;
 
+    /**
+     * the multi-channel running means, co-moments and sums of squared deviations, stored by quantity and then
+     * by channel
+     */
+    std::vector<T> m_moments;
+
     /**
      * pointer to member covariance calculator
      */
-    Statistical::Covariance<T> *m_pCalculator;
+    statistical::Covariance<T> *m_pCalculator;
 
     /**
      * number of samples in the moving average
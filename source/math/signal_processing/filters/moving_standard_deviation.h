@@ -26,6 +26,7 @@ public:
     /**
      * Using declarations
      */
+    using typename MovingVariance<T>::ChannelLayout;
     using MovingVariance<T>::filter;
 
     /**
@@ -135,33 +136,21 @@ public:
         bool bSuccess = (this->m_period > 0 && m_pStandardDeviation != nullptr);
         if (bSuccess)
         {
-            bool bBufferSamples = (p_xBegin == p_yBegin); // need to buffer samples if x and y are the same
-                                                          // vector...
-            if (bBufferSamples)
-            {
-                this->m_buffer.resize(this->m_period);
-                std::copy(p_yBegin, p_yBegin + this->m_period, this->m_buffer.begin());
-            }
-
+            // the window is held in a ring buffer, so that each sample is read before its output is written
+            // and the source and destination ranges may coincide
+            this->m_buffer.resize(this->m_period);
             m_pStandardDeviation->initialize();
             auto &&size = static_cast<int>(std::distance(p_xBegin, p_xEnd));
-            for (int i = 0; i < size; ++i)
+            for (int i = 0, j = 0; i < size; ++i)
             {
-                m_pStandardDeviation->addSample(p_xBegin[i]);
+                auto sample = p_xBegin[i];
+                m_pStandardDeviation->addSample(sample);
                 if (i >= this->m_period)
-                {
-                    T sample;
-                    if (bBufferSamples)
-                    {
-                        sample = this->m_buffer.front();
-                        std::rotate(this->m_buffer.begin(), this->m_buffer.begin() + 1, this->m_buffer.end());
-                        this->m_buffer.back() = p_xBegin[i];
-                    }
-                    else
-                        sample = p_xBegin[i - this->m_period];
-
-                    bSuccess &= m_pStandardDeviation->deleteSample(sample);
-                }
+                    bSuccess &= m_pStandardDeviation->deleteSample(this->m_buffer[j]);
+
+                this->m_buffer[j] = sample;
+                if (++j == this->m_period)
+                    j = 0;
 
                 if (bSuccess)
                     p_yBegin[i] = m_pStandardDeviation->calculate();
@@ -173,6 +162,31 @@ public:
         return bSuccess;
     }
 
+    /**
+     * Multi-channel digital signal filtering function (see MovingVariance)
+     * @param p_xBegin    a pointer to the beginning of the interleaved input data sequence to be filtered
+     * @param p_xEnd      a pointer to the element following the end of the range defining the input data
+     *                    sequence, the length of which must be a multiple of the number of channels
+     * @param p_yBegin    a pointer to the beginning of a range that will store the interleaved values arising
+     *                    from the filtration process; may coincide with the input range
+     * @param numChannels the number of channels
+     * @param layout      the arrangement of the channels' samples; planar channels are not supported and are
+     *                    rejected
+     */
+    bool filter(const T *p_xBegin, const T *p_xEnd, T *p_yBegin, std::size_t numChannels,
+                ChannelLayout layout = ChannelLayout::Interleaved) final
+    {
+        bool bSuccess = MovingVariance<T>::filter(p_xBegin, p_xEnd, p_yBegin, numChannels, layout);
+        if (bSuccess)
+        {
+            auto &&size = std::distance(p_xBegin, p_xEnd);
+            std::transform(p_yBegin, p_yBegin + size, p_yBegin,
+                           [] (const T &variance) { return std::sqrt(variance); });
+        }
+
+        return bSuccess;
+    }
+
     /**
      * Get the name of this class
      */
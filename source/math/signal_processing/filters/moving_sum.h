@@ -26,6 +26,7 @@ public:
     /**
      * Using declarations
      */
+    using typename DigitalFilter<T>::ChannelLayout;
     using DigitalFilter<T>::filter;
 
     /**
@@ -142,33 +143,21 @@ public:
         bool bSuccess = (m_period > 0 && m_pCalculator != nullptr);
         if (bSuccess)
         {
-            bool bBufferSamples = (p_xBegin == p_yBegin); // need to buffer samples if x and y are the same
-                                                          // vector...
-            if (bBufferSamples)
-            {
-                m_buffer.resize(m_period);
-                std::copy(p_yBegin, p_yBegin + m_period, m_buffer.begin());
-            }
-
+            // the window is held in a ring buffer, so that each sample is read before its output is written
+            // and the source and destination ranges may coincide
+            m_buffer.resize(m_period);
             m_pCalculator->initialize();
             auto &&size = static_cast<int>(std::distance(p_xBegin, p_xEnd));
-            for (int i = 0; i < size; ++i)
+            for (int i = 0, j = 0; i < size; ++i)
             {
-                m_pCalculator->addSample(p_xBegin[i]);
+                auto sample = p_xBegin[i];
+                m_pCalculator->addSample(sample);
                 if (i >= m_period)
-                {
-                    T sample;
-                    if (bBufferSamples)
-                    {
-                        sample = m_buffer.front();
-                        std::rotate(m_buffer.begin(), m_buffer.begin() + 1, m_buffer.end());
-                        m_buffer.back() = p_xBegin[i];
-                    }
-                    else
-                        sample = p_xBegin[i - m_period];
-
-                    bSuccess &= m_pCalculator->deleteSample(sample);
-                }
+                    bSuccess &= m_pCalculator->deleteSample(m_buffer[j]);
+
+                m_buffer[j] = sample;
+                if (++j == m_period)
+                    j = 0;
 
                 if (bSuccess)
                     p_yBegin[i] = m_pCalculator->calculate();
@@ -180,6 +169,63 @@ public:
         return bSuccess;
     }
 
+    /**
+     * Multi-channel digital signal filtering function; filters several independent channels, the samples of
+     * which are interleaved such that each frame holds one sample of every channel. Channels are updated
+     * together in each frame using compensated running sums, so that the cost per sample does not depend on
+     * the period and the inner loop over channels can be vectorized by the compiler
+     * @param p_xBegin    a pointer to the beginning of the interleaved input data sequence to be filtered
+     * @param p_xEnd      a pointer to the element following the end of the range defining the input data
+     *                    sequence, the length of which must be a multiple of the number of channels
+     * @param p_yBegin    a pointer to the beginning of a range that will store the interleaved values arising
+     *                    from the filtration process; may coincide with the input range
+     * @param numChannels the number of channels
+     * @param layout      the arrangement of the channels' samples; planar channels are not supported and are
+     *                    rejected
+     */
+    virtual bool filter(const T *p_xBegin, const T *p_xEnd, T *p_yBegin, std::size_t numChannels,
+                        ChannelLayout layout = ChannelLayout::Interleaved) override
+    {
+        auto &&size = static_cast<std::size_t>(std::distance(p_xBegin, p_xEnd));
+        bool bSuccess = (layout == ChannelLayout::Interleaved && m_period > 0 && numChannels > 0 &&
+                         size % numChannels == 0);
+        if (bSuccess)
+        {
+            // a ring buffer of frames, initially zero so that samples leaving a partially filled window are zero
+            auto &&numFrames = size / numChannels;
+            m_buffer.assign(m_period * numChannels, T(0.0));
+            m_compensations.assign(numChannels, T(0.0));
+            m_sums.assign(numChannels, T(0.0));
+            auto *pCompensations = m_compensations.data();
+            auto *pSums = m_sums.data();
+            for (std::size_t i = 0, j = 0; i < numFrames; ++i)
+            {
+                auto *pBuffer = &m_buffer[j * numChannels];
+                auto *pInput = p_xBegin + i * numChannels;
+                auto *pOutput = p_yBegin + i * numChannels;
+                auto &&scale = getScale(long(std::min<std::size_t>(i + 1, m_period)));
+                for (std::size_t k = 0; k < numChannels; ++k)
+                {
+                    // Kahan-compensated addition of the incoming sample and subtraction of the outgoing sample
+                    auto sample = pInput[k];
+                    T y = sample - pCompensations[k];
+                    T sum = pSums[k] + y;
+                    T compensation = (sum - pSums[k]) - y;
+                    y = -pBuffer[k] - compensation;
+                    pSums[k] = sum + y;
+                    pCompensations[k] = (pSums[k] - sum) - y;
+                    pBuffer[k] = sample;
+                    pOutput[k] = scale * pSums[k];
+                }
+
+                if (++j == std::size_t(m_period))
+                    j = 0;
+            }
+        }
+
+        return bSuccess;
+    }
+
     /**
      * Get the name of this class
      */
@@ -207,10 +253,23 @@ public:
 protected:
 
     /**
-     * buffer vector to hold values when source and destination vectors are the same
+     * Get the factor by which the multi-channel running sums are scaled to produce the filter output
+     */
+    inline virtual T getScale(long /* numSamples */) const
+    {
+        return T(1.0);
+    }
+
+    /**
+     * ring buffer holding the samples in the moving window
      */
     std::vector<T> m_buffer;
 
+    /**
+     * the compensation terms of the multi-channel running sums
+     */
+    std::vector<T> m_compensations;
+
     /**
      * a pointer to a statistical calculator object
      */
@@ -220,6 +279,11 @@ protected:
      * number of samples in the moving sum
      */
     int m_period;
+
+    /**
+     * the multi-channel running sums
+     */
+    std::vector<T> m_sums;
 };
 
 }
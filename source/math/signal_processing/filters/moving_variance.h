@@ -26,6 +26,7 @@ public:
     /**
      * Using declarations
      */
+    using typename DigitalFilter<T>::ChannelLayout;
     using DigitalFilter<T>::filter;
 
     /**
@@ -141,36 +142,24 @@ public:
      */
     virtual bool filter(const T *p_xBegin, const T *p_xEnd, T *p_yBegin) override
     {
-        bool bSuccess = (m_pVarianceCalculator != nullptr);
+        bool bSuccess = (m_period > 0 && m_pVarianceCalculator != nullptr);
         if (bSuccess)
         {
-            bool bBufferSamples = (p_xBegin == p_yBegin); // need to buffer samples if x and y are the same
-                                                          // vector...
-            if (bBufferSamples)
-            {
-                m_buffer.resize(m_period);
-                std::copy(p_yBegin, p_yBegin + m_period, m_buffer.begin());
-            }
-
+            // the window is held in a ring buffer, so that each sample is read before its output is written
+            // and the source and destination ranges may coincide
+            m_buffer.resize(m_period);
             m_pVarianceCalculator->initialize();
             auto &&size = static_cast<int>(std::distance(p_xBegin, p_xEnd));
-            for (int i = 0; i < size; ++i)
+            for (int i = 0, j = 0; i < size; ++i)
             {
-                m_pVarianceCalculator->addSample(p_xBegin[i]);
+                auto sample = p_xBegin[i];
+                m_pVarianceCalculator->addSample(sample);
                 if (i >= m_period)
-                {
-                    T sample;
-                    if (bBufferSamples)
-                    {
-                        sample = m_buffer.front();
-                        std::rotate(m_buffer.begin(), m_buffer.begin() + 1, m_buffer.end());
-                        m_buffer.back() = p_xBegin[i];
-                    }
-                    else
-                        sample = p_xBegin[i - m_period];
+                    bSuccess &= m_pVarianceCalculator->deleteSample(m_buffer[j]);
 
-                    bSuccess &= m_pVarianceCalculator->deleteSample(sample);
-                }
+                m_buffer[j] = sample;
+                if (++j == m_period)
+                    j = 0;
 
                 if (bSuccess)
                     p_yBegin[i] = m_pVarianceCalculator->calculate();
@@ -182,6 +171,78 @@ public:
         return bSuccess;
     }
 
+    /**
+     * Multi-channel digital signal filtering function; filters several independent channels, the samples of
+     * which are interleaved such that each frame holds one sample of every channel. Channels are updated
+     * together in each frame using Welford's running mean and sum of squared deviations, so that the cost per
+     * sample does not depend on the period and the inner loop over channels can be vectorized by the compiler
+     * @param p_xBegin    a pointer to the beginning of the interleaved input data sequence to be filtered
+     * @param p_xEnd      a pointer to the element following the end of the range defining the input data
+     *                    sequence, the length of which must be a multiple of the number of channels
+     * @param p_yBegin    a pointer to the beginning of a range that will store the interleaved values arising
+     *                    from the filtration process; may coincide with the input range
+     * @param numChannels the number of channels
+     * @param layout      the arrangement of the channels' samples; planar channels are not supported and are
+     *                    rejected
+     */
+    virtual bool filter(const T *p_xBegin, const T *p_xEnd, T *p_yBegin, std::size_t numChannels,
+                        ChannelLayout layout = ChannelLayout::Interleaved) override
+    {
+        auto &&size = static_cast<std::size_t>(std::distance(p_xBegin, p_xEnd));
+        bool bSuccess = (layout == ChannelLayout::Interleaved && m_period > 0 && numChannels > 0 &&
+                         size % numChannels == 0);
+        if (bSuccess)
+        {
+            auto &&numFrames = size / numChannels;
+            m_buffer.resize(m_period * numChannels);
+            m_means.assign(numChannels, T(0.0));
+            m_sumsOfSquares.assign(numChannels, T(0.0));
+            auto *pMeans = m_means.data();
+            auto *pSumsOfSquares = m_sumsOfSquares.data();
+            for (std::size_t i = 0, j = 0; i < numFrames; ++i)
+            {
+                auto *pBuffer = &m_buffer[j * numChannels];
+                auto *pInput = p_xBegin + i * numChannels;
+                auto *pOutput = p_yBegin + i * numChannels;
+                bool bFull = (i >= std::size_t(m_period));
+                auto numSamples = std::min<std::size_t>(i + 1, m_period);
+                auto &&addScale = T(1.0) / T(bFull ? numSamples + 1 : numSamples);
+                auto &&deleteScale = T(1.0) / T(numSamples);
+                auto &&divisor = T(m_bBiasedEstimate ? numSamples : numSamples - 1);
+                auto &&outputScale = numSamples > 1 ? T(1.0) / divisor : T(0.0);
+                for (std::size_t k = 0; k < numChannels; ++k)
+                {
+                    auto sample = pInput[k];
+                    auto delta = sample - pMeans[k];
+                    pMeans[k] += delta * addScale;
+                    pSumsOfSquares[k] += delta * (sample - pMeans[k]);
+                }
+
+                if (bFull)
+                {
+                    for (std::size_t k = 0; k < numChannels; ++k)
+                    {
+                        auto &&sample = pBuffer[k];
+                        auto delta = sample - pMeans[k];
+                        pMeans[k] -= delta * deleteScale;
+                        pSumsOfSquares[k] = std::max(T(0.0), pSumsOfSquares[k] - delta * (sample - pMeans[k]));
+                    }
+                }
+
+                for (std::size_t k = 0; k < numChannels; ++k)
+                {
+                    pBuffer[k] = pInput[k];
+                    pOutput[k] = outputScale * pSumsOfSquares[k];
+                }
+
+                if (++j == std::size_t(m_period))
+                    j = 0;
+            }
+        }
+
+        return bSuccess;
+    }
+
     /**
      * Query whether or not biased estimate is enabled/disabled
      */
@@ -232,15 +293,25 @@ protected:
     bool m_bBiasedEstimate;
 
     /**
-     * buffer vector to hold values when source and destination vectors are the same
+     * ring buffer holding the samples in the moving window
      */
     std::vector<T> m_buffer;
 
+    /**
+     * the multi-channel running means
+     */
+    std::vector<T> m_means;
+
     /**
      * number of samples in the moving window
      */
     int m_period;
 
+    /**
+     * the multi-channel running sums of squared deviations from the mean
+     */
+    std::vector<T> m_sumsOfSquares;
+
     /**
      * pointer to member variance calculator
      */
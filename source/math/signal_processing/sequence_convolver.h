@@ -3,7 +3,10 @@
 
 #include "cloneable.h"
 #include "digital_filter.h"
+#include "fast_fourier_transform.h"
 #include "reflective.h"
+#include <cmath>
+#include <type_traits>
 
 namespace math
 {
@@ -12,7 +15,10 @@ namespace signal_processing
 {
 
 /**
- * This class contains algorithms to perform convolution and deconvolution of two digital data sequences
+ * This class contains algorithms to perform convolution and deconvolution of two digital data sequences. For
+ * floating-point types, sequences whose shorter length reaches the FFT threshold are convolved by overlap-add
+ * of fast Fourier transforms, and deconvolved by Newton iteration of the reciprocal power series of the
+ * divisor; shorter sequences are convolved directly and deconvolved by long division
  */
 template<typename T>
 class SequenceConvolver
@@ -23,11 +29,17 @@ class SequenceConvolver
 {
 public:
 
+    /**
+     * the default length of the shorter of two sequences at and above which fast Fourier transforms are used
+     */
+    static constexpr std::size_t DEFAULT_FFT_THRESHOLD = 64;
+
     /**
      * Constructor
      */
     SequenceConvolver(void)
-    : m_pFilter(new filters::DigitalFilter<T>())
+    : m_fftThreshold(DEFAULT_FFT_THRESHOLD),
+      m_pFilter(new filters::DigitalFilter<T>())
     {
 
     }
@@ -75,6 +87,8 @@ public:
             if (sequenceConvolver.m_pFilter != nullptr)
                 m_pFilter = sequenceConvolver.m_pFilter->clone();
 
+            m_fftThreshold = sequenceConvolver.m_fftThreshold;
+
             // don't copy temporary remainder and result workspace vectors
 //          m_remainder = sequenceConvolver.m_remainder;
 //          m_result = sequenceConvolver.m_result;
@@ -99,6 +113,8 @@ public:
             m_pFilter = std::move(sequenceConvolver.m_pFilter);
             sequenceConvolver.m_pFilter = nullptr;
 
+            m_fftThreshold = std::move(sequenceConvolver.m_fftThreshold);
+
             // don't move temporary remainder and result workspace vectors
 //          m_remainder = std::move(sequenceConvolver.m_remainder);
 //          m_result = std::move(sequenceConvolver.m_result);
@@ -303,9 +319,16 @@ public:
         {
             auto &&sizeLeft = (size_t)std::distance(pLeftBegin, pLeftEnd);
             auto &&sizeRight = (size_t)std::distance(pRightBegin, pRightEnd);
-            for (size_t i = 0; i < sizeLeft; ++i)
-                for (size_t j = 0; j < sizeRight; ++j)
-                    pResultBegin[i + j] += pRightBegin[j] * pLeftBegin[i];
+            if (!isFftPreferred(std::min(sizeLeft, sizeRight)))
+            {
+                for (size_t i = 0; i < sizeLeft; ++i)
+                    for (size_t j = 0; j < sizeRight; ++j)
+                        pResultBegin[i + j] += pRightBegin[j] * pLeftBegin[i];
+            }
+            else if (sizeLeft >= sizeRight)
+                convolveFft(pLeftBegin, sizeLeft, pRightBegin, sizeRight, pResultBegin);
+            else
+                convolveFft(pRightBegin, sizeRight, pLeftBegin, sizeLeft, pResultBegin);
         }
         else
         {
@@ -541,6 +564,12 @@ public:
                 pResultBegin[0] = 0.0;
                 std::copy(pRightBegin, pRightEnd, pRemainderBegin);
             }
+            else if (pLeftBegin[0] != T(0.0) && isFftPreferred(std::min(sizeLeft, 1 + sizeRight - sizeLeft)))
+            {
+                bSuccess = (sizeLeft == 1 || pRemainderBegin != nullptr);
+                if (bSuccess)
+                    deconvolveFft(pLeftBegin, sizeLeft, pRightBegin, sizeRight, pResultBegin, pRemainderBegin);
+            }
             else if (m_pFilter != nullptr)
             {
                 // perform deconvolution via digital filter impulse response
@@ -594,8 +623,194 @@ public:
         return "SequenceConvolver";
     }
 
+    /**
+     * Get the length of the shorter of two sequences at and above which convolution and deconvolution are
+     * performed via fast Fourier transforms
+     */
+    inline virtual std::size_t getFftThreshold(void) const final
+    {
+        return m_fftThreshold;
+    }
+
+    /**
+     * Set the length of the shorter of two sequences at and above which convolution and deconvolution are
+     * performed via fast Fourier transforms; a threshold of zero always selects the fast Fourier transform,
+     * whereas a threshold exceeding the lengths of the sequences always selects the direct algorithms. Fast
+     * Fourier transforms are used only for floating-point types
+     */
+    inline virtual void setFftThreshold(std::size_t threshold) final
+    {
+        m_fftThreshold = threshold;
+    }
+
 private:
 
+    /**
+     * Typedef declarations
+     */
+    typedef typename std::conditional<std::is_floating_point<T>::value, T, double>::type tFloat;
+
+    /**
+     * Convolve two sequences by overlap-add, accumulating the result; the shorter sequence is transformed once
+     * and the longer sequence is transformed in blocks
+     * @param pLongBegin   a pointer to the beginning of the longer sequence
+     * @param sizeLong     the length of the longer sequence
+     * @param pShortBegin  a pointer to the beginning of the shorter sequence
+     * @param sizeShort    the length of the shorter sequence
+     * @param pResultBegin a pointer to the beginning of the range to which the result is added
+     */
+    void convolveFft(const T *pLongBegin, std::size_t sizeLong, const T *pShortBegin, std::size_t sizeShort,
+                     T *pResultBegin)
+    {
+        if constexpr (std::is_floating_point<T>::value)
+        {
+            // choose the transform length that minimizes the estimated cost of transforming all blocks, from
+            // among the doublings of the shortest usable length and a single transform spanning the entire result
+            auto &&getCost = [sizeLong, sizeShort] (std::size_t size)
+            {
+                auto &&numBlocks = (sizeLong + size - sizeShort) / (size - sizeShort + 1);
+
+                return double(numBlocks) * double(size) * std::log2(double(size));
+            };
+
+            auto &&fullSize = 2 * FastFourierTransform<T>::getFastSize((sizeLong + sizeShort) / 2);
+            auto fftSize = fullSize;
+            auto bestCost = getCost(fullSize);
+            for (auto size = 2 * FastFourierTransform<T>::getFastSize(sizeShort); size < fullSize; size *= 2)
+            {
+                auto &&cost = getCost(size);
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    fftSize = size;
+                }
+            }
+
+            auto &&blockSize = fftSize - sizeShort + 1;
+            auto &&spectrumSize = fftSize / 2 + 1;
+            m_fft.setSize(fftSize);
+            m_block.assign(fftSize, T(0.0));
+            m_blockSpectrum.resize(spectrumSize);
+            m_kernelSpectrum.resize(spectrumSize);
+            std::copy(pShortBegin, pShortBegin + sizeShort, m_block.begin());
+            m_fft.forward(m_block.data(), m_kernelSpectrum.data());
+            for (std::size_t offset = 0; offset < sizeLong; offset += blockSize)
+            {
+                auto count = std::min(blockSize, sizeLong - offset);
+                std::copy(pLongBegin + offset, pLongBegin + offset + count, m_block.begin());
+                std::fill(m_block.begin() + count, m_block.end(), T(0.0));
+                m_fft.forward(m_block.data(), m_blockSpectrum.data());
+                for (std::size_t k = 0; k < spectrumSize; ++k)
+                {
+                    auto &&x = m_blockSpectrum[k], &&h = m_kernelSpectrum[k];
+                    x = std::complex<T>(x.real() * h.real() - x.imag() * h.imag(),
+                                        x.real() * h.imag() + x.imag() * h.real());
+                }
+
+                m_fft.inverse(m_blockSpectrum.data(), m_block.data());
+                for (std::size_t i = 0; i < count + sizeShort - 1; ++i)
+                    pResultBegin[offset + i] += m_block[i];
+            }
+        }
+    }
+
+    /**
+     * Deconvolve the left sequence out of the right sequence by multiplying the right sequence with the
+     * reciprocal power series of the left sequence, the latter being computed by Newton iteration; the
+     * remainder, if required, is obtained by subtracting the product of the quotient and the left sequence
+     * @param pLeftBegin      a pointer to the beginning of the left sequence, whose first element is non-zero
+     * @param sizeLeft        the length N of the left sequence
+     * @param pRightBegin     a pointer to the beginning of the right sequence
+     * @param sizeRight       the length M >= N of the right sequence
+     * @param pResultBegin    a pointer to the beginning of the range of length 1+M-N that will hold the quotient
+     * @param pRemainderBegin a pointer to the beginning of the range of length N-1 that will hold the remainder
+     */
+    void deconvolveFft(const T *pLeftBegin, std::size_t sizeLeft, const T *pRightBegin, std::size_t sizeRight,
+                       T *pResultBegin, T *pRemainderBegin)
+    {
+        // each iteration doubles the number of accurate coefficients of the reciprocal g via g <- g - g * e,
+        // where e = left * g - 1 vanishes in its first n coefficients
+        auto &&size = 1 + sizeRight - sizeLeft;
+        m_reciprocal.assign(1, T(1.0) / pLeftBegin[0]);
+        for (std::size_t n = 1; n < size; n = m_reciprocal.size())
+        {
+            auto next = std::min(2 * n, size);
+            auto sizeProduct = std::min(sizeLeft, next);
+            m_product.assign(std::max(next, sizeProduct + n - 1), T(0.0));
+            convolve(pLeftBegin, pLeftBegin + sizeProduct, m_reciprocal.data(), m_reciprocal.data() + n,
+                     m_product.data());
+
+            m_correction.assign(next - 1, T(0.0));
+            convolve(m_reciprocal.data(), m_reciprocal.data() + n, m_product.data() + n, m_product.data() + next,
+                     m_correction.data());
+
+            m_reciprocal.resize(next);
+            for (std::size_t i = n; i < next; ++i)
+                m_reciprocal[i] = -m_correction[i - n];
+        }
+
+        m_product.assign(2 * size - 1, T(0.0));
+        convolve(pRightBegin, pRightBegin + size, m_reciprocal.data(), m_reciprocal.data() + size,
+                 m_product.data());
+        std::copy(m_product.cbegin(), m_product.cbegin() + size, pResultBegin);
+        if (sizeLeft > 1)
+        {
+            m_product.assign(sizeRight, T(0.0));
+            convolve(pLeftBegin, pLeftBegin + sizeLeft, pResultBegin, pResultBegin + size, m_product.data());
+            for (std::size_t i = 0; i + 1 < sizeLeft; ++i)
+                pRemainderBegin[i] = pRightBegin[size + i] - m_product[size + i];
+        }
+    }
+
+    /**
+     * Determine whether or not fast Fourier transforms should be used for sequences the shorter of which has the
+     * specified length
+     */
+    inline bool isFftPreferred(std::size_t size) const
+    {
+        return std::is_floating_point<T>::value && size >= m_fftThreshold;
+    }
+
+    /**
+     * the length of the shorter of two sequences at and above which fast Fourier transforms are used
+     */
+    std::size_t m_fftThreshold;
+
+    /**
+     * fast Fourier transform used by overlap-add convolution
+     */
+    FastFourierTransform<tFloat> m_fft;
+
+    /**
+     * temporary workspace vector to hold a zero-padded block of a sequence during overlap-add convolution
+     */
+    std::vector<T> m_block;
+
+    /**
+     * temporary workspace vector to hold the spectrum of a block during overlap-add convolution
+     */
+    std::vector<std::complex<tFloat>> m_blockSpectrum;
+
+    /**
+     * temporary workspace vector to hold the spectrum of the shorter sequence during overlap-add convolution
+     */
+    std::vector<std::complex<tFloat>> m_kernelSpectrum;
+
+    /**
+     * temporary workspace vector to hold the correction to the reciprocal power series during deconvolution
+     */
+    std::vector<T> m_correction;
+
+    /**
+     * temporary workspace vector to hold products computed during deconvolution
+     */
+    std::vector<T> m_product;
+
+    /**
+     * temporary workspace vector to hold the reciprocal power series of the divisor during deconvolution
+     */
+    std::vector<T> m_reciprocal;
+
     /**
      * pointer to a digital filter object
      */
@@ -107,11 +107,10 @@ public:
     inline virtual void addSample(const T &x, const T &y)
     {
         ++this->m_numSamples;
-        T delta_x = (x - m_mean[0]) / this->m_numSamples;
-        m_mean[0] += delta_x;
-        T delta_y = (y - m_mean[1]) / this->m_numSamples;
-        m_mean[1] += delta_y;
-        m_sum += (this->m_numSamples - 1) * delta_x * delta_y - m_sum / this->m_numSamples;
+        T delta_x(x - m_mean[0]);
+        m_mean[0] += delta_x / this->m_numSamples;
+        m_mean[1] += (y - m_mean[1]) / this->m_numSamples;
+        m_sum += delta_x * (y - m_mean[1]);
     }
 
     /**
@@ -119,10 +118,11 @@ public:
      */
     inline virtual T calculate(void) const override
     {
+        long numSamples = this->m_numSamples - 1;
         if (m_bBiasedEstimate)
-            return m_sum;
-        else
-            return this->m_numSamples > 1 ? this->m_numSamples / (this->m_numSamples - 1.0) * m_sum : 0.0;
+            ++numSamples;
+
+        return this->m_numSamples > 1 ? m_sum / numSamples : 0.0;
     }
 
     /**
@@ -160,11 +160,10 @@ public:
         else if (this->m_numSamples > 1)
         {
             --this->m_numSamples;
-            T delta_x = (x - m_mean[0]) / this->m_numSamples;
-            m_mean[0] -= delta_x;
-            T delta_y = (y - m_mean[1]) / this->m_numSamples;
-            m_mean[1] -= delta_y;
-            m_sum = (this->m_numSamples + 1) * (m_sum / this->m_numSamples - delta_x * delta_y);
+            T delta_x(x - m_mean[0]);
+            m_mean[0] -= delta_x / this->m_numSamples;
+            m_mean[1] -= (y - m_mean[1]) / this->m_numSamples;
+            m_sum -= delta_x * (y - m_mean[1]);
         }
 
         return bSuccess;
@@ -212,7 +211,7 @@ protected:
     T m_mean[2];
 
     /**
-     * running sum of samples
+     * running sum of products of deviations from the sample means
      */
     T m_sum;
 };
@@ -1,7 +1,10 @@
+#include "estimationFilter.h"
+#include "kalmanFilterBank.h"
 #include "latestMeasurementStrategy.h"
 #include "measurementAggregationStrategy.h"
 #include "radarMeasurement.h"
 #include "radarTrackEstimationFilterUser.h"
+#include "radarTrackFilter.h"
 #include "referenceFrame.h"
 #include "stateVector.h"
 #include <cmath>
@@ -12,6 +15,8 @@ static constexpr char factoryName[] = "RadarTrackEstimationFilterUser";
 // using namespace declarations
 using namespace attributes::abstract;
 using namespace math::control_systems;
+using namespace math::linear_algebra::matrix;
+using namespace math::statistical::estimation::kalman;
 using namespace physics::kinematics;
 using namespace utilities;
 
@@ -136,6 +141,18 @@ RadarTrackEstimationFilterUser::create(EstimationFilter *pEstimationFilter,
     return pEstimationFilterUser;
 }
 
+/**
+ * Create a Kalman filter bank configured with the radar track measurement model; the bank can be used in place
+ * of individual estimation filters to update many radar tracks at once (see initializeFilterBank())
+ */
+KalmanFilterBank *RadarTrackEstimationFilterUser::createFilterBank(void)
+{
+    auto *pBank = new KalmanFilterBank(9, 4);
+    pBank->setMeasurementModel(&RadarTrackFilter::evaluateFilterBankMeasurementModel);
+
+    return pBank;
+}
+
 /**
  * Function to estimate the initial state from this object's measurements
  */
@@ -236,6 +253,80 @@ ReferenceFrame *RadarTrackEstimationFilterUser::getStateEstimateFrame(double tim
     return nullptr; // not used
 }
 
+/**
+ * Initialize a filter within a Kalman filter bank from this object's measurements, rather than this object's
+ * estimation filter; the covariances are computed by the radar track filter associated with this object's
+ * estimation filter, at the estimation filter's update rate. Returns true upon success
+ * @param bank   a Kalman filter bank created by createFilterBank()
+ * @param filter the index of the filter within the bank
+ */
+bool RadarTrackEstimationFilterUser::initializeFilterBank(KalmanFilterBank &bank,
+                                                          std::size_t filter)
+{
+    RadarTrackFilter *pTrackFilter = nullptr;
+    if (m_pEstimationFilter != nullptr)
+        pTrackFilter = dynamic_cast<RadarTrackFilter *>(m_pEstimationFilter->getAppliedEstimationFilter());
+
+    auto *pMeasurementStandardDeviations = getMeasurementStandardDeviations();
+    bool bSuccess = (pTrackFilter != nullptr && pMeasurementStandardDeviations != nullptr);
+    if (bSuccess)
+    {
+        StateVector xh;
+        bSuccess = estimateInitialState(xh);
+        if (bSuccess)
+        {
+            auto dt = m_pEstimationFilter->getUpdateRate();
+            Matrix2d x = xh;
+            bSuccess = bank.setStateEstimate(filter, x) &&
+                       bank.setErrorCovariance(filter, pTrackFilter->computeErrorCovariance(x,
+                                               pMeasurementStandardDeviations, dt)) &&
+                       bank.setProcessCovariance(filter, pTrackFilter->computeProcessCovariance(dt)) &&
+                       bank.setMeasurementCovariance(filter, pTrackFilter->
+                                                     computeMeasurementCovariance(pMeasurementStandardDeviations,
+                                                                                  dt));
+        }
+    }
+    else if (pTrackFilter == nullptr)
+    {
+        logMsg(std::cout, LoggingLevel::Enum::Warning,
+               "Estimation filter is null or is not associated with a radar track filter!\n",
+               getQualifiedMethodName(__func__));
+    }
+    else if (pMeasurementStandardDeviations == nullptr)
+    {
+        logMsg(std::cout, LoggingLevel::Enum::Warning,
+               "Measurement standard deviations are null!\n",
+               getQualifiedMethodName(__func__));
+    }
+
+    return bSuccess;
+}
+
+/**
+ * Set this object's latest state measurement as the pending measurement of a filter within a Kalman filter
+ * bank; returns true upon success
+ * @param bank   a Kalman filter bank created by createFilterBank()
+ * @param filter the index of the filter within the bank
+ */
+bool RadarTrackEstimationFilterUser::setFilterBankMeasurement(KalmanFilterBank &bank,
+                                                              std::size_t filter)
+{
+    AppliedEstimationFilter *pAppliedEstimationFilter = nullptr;
+    if (m_pEstimationFilter != nullptr)
+        pAppliedEstimationFilter = m_pEstimationFilter->getAppliedEstimationFilter();
+
+    auto *pStateMeasurement = getLatestStateMeasurement();
+    bool bSuccess = (pAppliedEstimationFilter != nullptr && pStateMeasurement != nullptr);
+    if (bSuccess)
+    {
+        StateVector z;
+        pAppliedEstimationFilter->convertStateMeasurementToStateVector(*pStateMeasurement, z);
+        bSuccess = bank.setMeasurement(filter, z);
+    }
+
+    return bSuccess;
+}
+
 /**
  * Swap function
  */
@@ -13,6 +13,9 @@ namespace statistical
 namespace estimation
 {
 
+// forward declarations
+namespace kalman { class KalmanFilterBank; }
+
 namespace applied
 {
 
@@ -98,6 +101,12 @@ public:
     create(EstimationFilter *pEstimationFilter,
            MeasurementAggregationStrategy *pMeasurementAggregationStrategy = nullptr);
 
+    /**
+     * Create a Kalman filter bank configured with the radar track measurement model; the bank can be used in
+     * place of individual estimation filters to update many radar tracks at once (see initializeFilterBank())
+     */
+    static EXPORT_STEM kalman::KalmanFilterBank *createFilterBank(void);
+
     /**
      * Function to estimate the initial state from this object's measurements
      */
@@ -123,6 +132,25 @@ public:
      */
     EXPORT_STEM virtual ReferenceFrame *getStateEstimateFrame(double time) const override;
 
+    /**
+     * Initialize a filter within a Kalman filter bank from this object's measurements, rather than this
+     * object's estimation filter; the covariances are computed by the radar track filter associated with this
+     * object's estimation filter, at the estimation filter's update rate. Returns true upon success
+     * @param bank   a Kalman filter bank created by createFilterBank()
+     * @param filter the index of the filter within the bank
+     */
+    EXPORT_STEM virtual bool initializeFilterBank(kalman::KalmanFilterBank &bank,
+                                                  std::size_t filter) final;
+
+    /**
+     * Set this object's latest state measurement as the pending measurement of a filter within a Kalman filter
+     * bank; returns true upon success
+     * @param bank   a Kalman filter bank created by createFilterBank()
+     * @param filter the index of the filter within the bank
+     */
+    EXPORT_STEM virtual bool setFilterBankMeasurement(kalman::KalmanFilterBank &bank,
+                                                      std::size_t filter) final;
+
     /**
      * Swap function
      */
@@ -1,4 +1,5 @@
 #include "estimationFilter.h"
+#include "kalmanFilterBank.h"
 #include "matrix2d.h"
 #include "radar_measurement_type.h"
 #include "radarTrackEstimationFilterUser.h"
@@ -8,6 +9,7 @@
 #endif
 #include "stateMap.h"
 #include "stateVector.h"
+#include <algorithm>
 #include <cmath>
 
 // file-scoped variables
@@ -17,6 +19,7 @@ static constexpr char factoryName[] = "RadarTrackFilter";
 using namespace attributes::abstract;
 using namespace math::control_systems;
 using namespace math::linear_algebra::matrix;
+using namespace math::statistical::estimation::kalman;
 #ifdef RAPID_XML
 using namespace rapidxml;
 #endif
@@ -404,6 +407,62 @@ Matrix2d RadarTrackFilter::dynamicsModel(double dt,
     return xh;
 }
 
+/**
+ * Evaluate the measurement model and Jacobian for a block of filters within a Kalman filter bank (see
+ * kalman::KalmanFilterBank::MeasurementModel); equivalent to measurementModel() and measurementJacobian()
+ * applied to each lane of the block
+ * @param pStates      the interleaved states of the block
+ * @param pPredictions upon return, contains the interleaved predicted measurements
+ * @param pJacobians   upon return, contains the interleaved measurement Jacobians
+ */
+void RadarTrackFilter::evaluateFilterBankMeasurementModel(const double *pStates,
+                                                          double *pPredictions,
+                                                          double *pJacobians)
+{
+    constexpr std::size_t LANES = KalmanFilterBank::LANES;
+    auto *x = pStates, *y = x + LANES, *z = y + LANES, *xd = z + LANES, *yd = xd + LANES, *zd = yd + LANES;
+    auto *H = pJacobians;
+    std::fill(H, H + 4 * 9 * LANES, 0.0);
+    for (std::size_t l = 0; l < LANES; ++l)
+    {
+        auto rxySq = x[l] * x[l] + y[l] * y[l];
+        auto rSq = rxySq + z[l] * z[l];
+        auto r = std::sqrt(rSq);
+        auto rd = (x[l] * xd[l] + y[l] * yd[l] + z[l] * zd[l]) / r;
+
+        // azimuth, zenith, range, range rate
+        pPredictions[l] = std::atan2(y[l], x[l]);
+        pPredictions[LANES + l] = std::acos(z[l] / r);
+        pPredictions[2 * LANES + l] = r;
+        pPredictions[3 * LANES + l] = rd;
+
+        // element (i, j) of the Jacobian of lane l is stored at H[(9 * i + j) * LANES + l]
+        if (rSq > 0)
+        {
+            H[l] = -y[l] / rxySq;
+            H[LANES + l] = x[l] / rxySq;
+        }
+
+        auto d = rSq * std::sqrt(rSq - z[l] * z[l]);
+        if (d > 0)
+        {
+            H[9 * LANES + l] = x[l] * z[l] / d;
+            H[10 * LANES + l] = y[l] * z[l] / d;
+            H[11 * LANES + l] = -d / rSq / rSq;
+        }
+
+        if (r > 0)
+        {
+            H[18 * LANES + l] = H[30 * LANES + l] = x[l] / r;
+            H[19 * LANES + l] = H[31 * LANES + l] = y[l] / r;
+            H[20 * LANES + l] = H[32 * LANES + l] = z[l] / r;
+            H[27 * LANES + l] = (r * xd[l] - rd * x[l]) / rSq;
+            H[28 * LANES + l] = (r * yd[l] - rd * y[l]) / rSq;
+            H[29 * LANES + l] = (r * zd[l] - rd * z[l]) / rSq;
+        }
+    }
+}
+
 /**
  * Get the name of this class
  */
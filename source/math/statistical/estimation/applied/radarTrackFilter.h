@@ -151,6 +151,18 @@ public:
                                                const Matrix2d &x,
                                                const Matrix2d &u) override;
 
+    /**
+     * Evaluate the measurement model and Jacobian for a block of filters within a Kalman filter bank (see
+     * kalman::KalmanFilterBank::MeasurementModel); equivalent to measurementModel() and measurementJacobian()
+     * applied to each lane of the block
+     * @param pStates      the interleaved states of the block
+     * @param pPredictions upon return, contains the interleaved predicted measurements
+     * @param pJacobians   upon return, contains the interleaved measurement Jacobians
+     */
+    static EXPORT_STEM void evaluateFilterBankMeasurementModel(const double *pStates,
+                                                               double *pPredictions,
+                                                               double *pJacobians);
+
     /**
      * Get the name of this class
      */
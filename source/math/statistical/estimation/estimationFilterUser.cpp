@@ -439,13 +439,10 @@ std::vector<StateMap *> &EstimationFilterUser::getStateMeasurements(void)
  */
 std::vector<StateMap *> EstimationFilterUser::getStateMeasurements(void) const
 {
-    auto &&itStateMap = m_entries.find("measured");
-    if (itStateMap != m_entries.cend())
-    {
-        return itStateMap->second;
-    }
+    std::vector<StateMap *> stateMeasurements;
+    getEntries("measured", stateMeasurements);
 
-    return { };
+    return stateMeasurements;
 }
 
 /**
@@ -339,7 +339,6 @@ bool ExtendedKalman::measurementUpdate(StateVector &stateMeasurement)
     bool bSuccess = (m_bInitialized && m_pAppliedEstimationFilter != nullptr && !z.empty());
     if (bSuccess)
     {
-        auto &&I = Matrix2d::identity(m_xh.rows());
 //      Matrix2d P(m_P); // error covariance prior to measurement update
         m_tempP = m_P; // error covariance prior to measurement update
 //      Matrix2d x(m_xh); // state estimate prior to measurement update
@@ -348,52 +347,59 @@ bool ExtendedKalman::measurementUpdate(StateVector &stateMeasurement)
         // Compute the measurement Jacobian
 //      Matrix2d H(pAppliedEstimationFilter->measurementJacobian(x))
         auto &&H = m_pAppliedEstimationFilter->measurementJacobian(m_temp_x);
-//      const Matrix2d &HT = H.calcTranspose();
-//      Matrix2d S(H * P * HT + m_R); // residual covariance
-        m_tempS = H * m_tempP;
-        m_tempS.postMultiplyTranspose(H, m_tempS);
+//      Matrix2d PHT(P * H.calcTranspose()); // state-measurement cross-covariance
+        m_tempPHT = m_tempP;
+        m_tempPHT.postMultiplyTranspose(H, m_tempPHT);
+//      Matrix2d S(H * PHT + m_R); // residual covariance
+        m_tempS = H * m_tempPHT;
         m_tempS += m_R;
 
-//      Matrix2d K(P * HT * S.calcInverse()); // Kalman gain
-        Matrix2d K(m_tempP);
-        K.postMultiplyTranspose(H, K);
-        K *= m_tempS.calcInverse();
-
-//      const Matrix2d &yh = pAppliedEstimationFilter->measurementModel(x);
-        auto &&yh = m_pAppliedEstimationFilter->measurementModel(m_temp_x);
-
-        // measurement residual
-        auto &&v = m_pAppliedEstimationFilter->computeMeasurementResidual(yh, z);
-
-//      m_xh = x + K * v; // state estimate update
-        m_xh = K * v;
-        m_xh += m_temp_x;
-
-        if (m_lambda > 0.0)
+//      Matrix2d K(PHT * S.calcInverse()); // Kalman gain, computed by Cholesky factorization of S
+        Matrix2d K;
+        bSuccess = calcKalmanGain(m_tempPHT, m_tempS, K);
+        if (bSuccess)
         {
-            K = m_tempP;
-//          computeReversePrediction(H, S, v, z);
-            computeReversePrediction(H,
-                                     m_tempS,
-                                     v,
-                                     z);
+//          const Matrix2d &yh = pAppliedEstimationFilter->measurementModel(x);
+            auto &&yh = m_pAppliedEstimationFilter->measurementModel(m_temp_x);
 
-//          K = P * HT * S.calcInverse(); // Kalman gain
-            K.postMultiplyTranspose(H, K);
-            K *= m_tempS.calcInverse();
+            // measurement residual
+            auto &&v = m_pAppliedEstimationFilter->computeMeasurementResidual(yh, z);
 
 //          m_xh = x + K * v; // state estimate update
             m_xh = K * v;
             m_xh += m_temp_x;
+
+            if (m_lambda > 0.0)
+            {
+//              computeReversePrediction(H, S, v, z);
+                computeReversePrediction(H,
+                                         m_tempS,
+                                         v,
+                                         z);
+
+//              K = PHT * S.calcInverse(); // Kalman gain
+                bSuccess = calcKalmanGain(m_tempPHT, m_tempS, K);
+                if (bSuccess)
+                {
+//                  m_xh = x + K * v; // state estimate update
+                    m_xh = K * v;
+                    m_xh += m_temp_x;
+                }
+                else
+                    m_xh = m_temp_x;
+            }
         }
 
-//      m_P = (I - K * H) * P; // error covariance update
-        m_P = (I - K * H) * m_tempP; // error covariance update
+        if (bSuccess)
+        {
+//          m_P = (I - K * H) * P; // error covariance update
+            updateErrorCovariance(K, m_tempPHT); // error covariance update, P = P - K * PHT'
 
-        // adaptive estimation of process noise
-//      adaptProcessCovariance(x, P);
-        adaptProcessCovariance(m_temp_x,
-                               m_tempP);
+            // adaptive estimation of process noise
+//          adaptProcessCovariance(x, P);
+            adaptProcessCovariance(m_temp_x,
+                                   m_tempP);
+        }
     }
 
     if (m_pAppliedEstimationFilter == nullptr)
@@ -503,6 +509,7 @@ void ExtendedKalman::swap(ExtendedKalman &kalman)
     m_temp_wSIw.swap(kalman.m_temp_wSIw);
     m_temp_x.swap(kalman.m_temp_x);
     m_tempP.swap(kalman.m_tempP);
+    m_tempPHT.swap(kalman.m_tempPHT);
     m_tempQ.swap(kalman.m_tempQ);
     m_tempS.swap(kalman.m_tempS);
 }
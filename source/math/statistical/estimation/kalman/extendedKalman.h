@@ -203,6 +203,7 @@ protected:
     Matrix2d m_temp_wSIw;
     Matrix2d m_temp_x;
     Matrix2d m_tempP;
+    Matrix2d m_tempPHT;
     Matrix2d m_tempQ;
     Matrix2d m_tempS;
 };
@@ -0,0 +1,285 @@
+#ifndef FIXED_EXTENDED_KALMAN_H
+#define FIXED_EXTENDED_KALMAN_H
+
+#include "fixed_matrix.h"
+
+namespace math
+{
+
+namespace statistical
+{
+
+namespace estimation
+{
+
+namespace kalman
+{
+
+/**
+ * This class implements an extended Kalman estimation filter for a state vector and measurement vector whose
+ * sizes are known at compile time. All vectors and matrices use stack storage, so that a predict/update cycle
+ * performs no heap allocation and no virtual function calls; the dynamics and measurement models (and their
+ * Jacobians) are supplied as function objects to timeUpdate() and measurementUpdate(), and are expected to be
+ * inlined. Adaptive estimation of the process noise covariance is supported as in ExtendedKalman, whereas
+ * adaptive reverse prediction is not
+ * @tparam N the size of the state vector
+ * @tparam M the size of the measurement vector
+ * @tparam T the element type
+ */
+template<std::size_t N, std::size_t M, typename T = double>
+class FixedExtendedKalman
+{
+public:
+
+    /**
+     * Typedef declarations
+     */
+    typedef linear_algebra::matrix::FixedMatrix<M, N, T> tMeasurementJacobian;
+    typedef linear_algebra::matrix::FixedMatrix<M, M, T> tMeasurementMatrix;
+    typedef linear_algebra::matrix::FixedVector<M, T> tMeasurementVector;
+    typedef linear_algebra::matrix::FixedMatrix<N, N, T> tStateMatrix;
+    typedef linear_algebra::matrix::FixedVector<N, T> tStateVector;
+
+    /**
+     * Constructor
+     * @param dt the sampling interval (s)
+     */
+    FixedExtendedKalman(double dt = 0.0)
+    : m_dt(dt),
+      m_gamma(0.0),
+      m_P(tStateMatrix::identity()),
+      m_Q(tStateMatrix::identity()),
+      m_R(tMeasurementMatrix::identity())
+    {
+
+    }
+
+    /**
+     * Get adaptive process window size
+     */
+    inline double getAdaptiveWindow(void) const
+    {
+        return m_gamma;
+    }
+
+    /**
+     * Get the error covariance matrix
+     */
+    inline const tStateMatrix &getErrorCovariance(void) const
+    {
+        return m_P;
+    }
+
+    /**
+     * Get the measurement covariance matrix
+     */
+    inline const tMeasurementMatrix &getMeasurementCovariance(void) const
+    {
+        return m_R;
+    }
+
+    /**
+     * Get the process covariance matrix
+     */
+    inline const tStateMatrix &getProcessCovariance(void) const
+    {
+        return m_Q;
+    }
+
+    /**
+     * Get the sampling interval (s)
+     */
+    inline double getSamplingInterval(void) const
+    {
+        return m_dt;
+    }
+
+    /**
+     * Get the state estimate
+     */
+    inline const tStateVector &getStateEstimate(void) const
+    {
+        return m_xh;
+    }
+
+    /**
+     * Measurement update function; the measurement residual is computed as z - h(x)
+     * @param z                   the measurement vector
+     * @param measurementModel    a function object of the form tMeasurementVector (const tStateVector &)
+     * @param measurementJacobian a function object of the form tMeasurementJacobian (const tStateVector &)
+     */
+    template<typename MeasurementModel, typename MeasurementJacobian>
+    inline bool measurementUpdate(const tMeasurementVector &z,
+                                  MeasurementModel &&measurementModel,
+                                  MeasurementJacobian &&measurementJacobian)
+    {
+        return measurementUpdate(z, measurementModel, measurementJacobian,
+                                 [] (const tMeasurementVector &yh, const tMeasurementVector &z)
+                                 { return z - yh; });
+    }
+
+    /**
+     * Measurement update function
+     * @param z                   the measurement vector
+     * @param measurementModel    a function object of the form tMeasurementVector (const tStateVector &)
+     * @param measurementJacobian a function object of the form tMeasurementJacobian (const tStateVector &)
+     * @param measurementResidual a function object of the form
+     *                            tMeasurementVector (const tMeasurementVector &yh, const tMeasurementVector &z)
+     *                            which computes the measurement residual (e.g., to account for angle wrapping)
+     */
+    template<typename MeasurementModel, typename MeasurementJacobian, typename MeasurementResidual>
+    inline bool measurementUpdate(const tMeasurementVector &z,
+                                  MeasurementModel &&measurementModel,
+                                  MeasurementJacobian &&measurementJacobian,
+                                  MeasurementResidual &&measurementResidual)
+    {
+        const auto x(m_xh); // state estimate prior to measurement update
+        const auto P(m_P); // error covariance prior to measurement update
+
+        // compute the measurement Jacobian and residual covariance, S = H * P * H^T + R
+        const tMeasurementJacobian H(measurementJacobian(x));
+        const auto PHT(P.postMultiplyTranspose(H));
+        auto &&S = H * PHT + m_R;
+
+        // compute the Kalman gain, K = P * H^T * S^-1, by solving S * K^T = H * P (S and P are symmetric)
+        linear_algebra::matrix::FixedMatrix<M, N, T> KT;
+        if (!S.solve(PHT.getTranspose(), KT))
+            return false;
+
+        // measurement residual
+        const tMeasurementVector v(measurementResidual(measurementModel(x), z));
+
+        // state estimate update
+        m_xh = x + v.preMultiplyTranspose(KT);
+
+        // error covariance update, P = (I - K * H) * P
+        m_P = P - (H * P).preMultiplyTranspose(KT);
+
+        // adaptive estimation of process noise
+        adaptProcessCovariance(x, P);
+
+        return true;
+    }
+
+    /**
+     * Set adaptive process window size; a value of zero disables adaptive estimation of process noise
+     */
+    inline void setAdaptiveWindow(double gamma)
+    {
+        m_gamma = gamma;
+    }
+
+    /**
+     * Set the error covariance matrix
+     */
+    inline void setErrorCovariance(const tStateMatrix &P)
+    {
+        m_P = P;
+    }
+
+    /**
+     * Set the measurement covariance matrix
+     */
+    inline void setMeasurementCovariance(const tMeasurementMatrix &R)
+    {
+        m_R = R;
+    }
+
+    /**
+     * Set the process covariance matrix
+     */
+    inline void setProcessCovariance(const tStateMatrix &Q)
+    {
+        m_Q = Q;
+    }
+
+    /**
+     * Set the sampling interval (s)
+     */
+    inline void setSamplingInterval(double dt)
+    {
+        m_dt = dt;
+    }
+
+    /**
+     * Set the state estimate
+     */
+    inline void setStateEstimate(const tStateVector &xh)
+    {
+        m_xh = xh;
+    }
+
+    /**
+     * Time update function
+     * @param dynamicsModel    a function object of the form tStateVector (double dt, const tStateVector &)
+     * @param dynamicsJacobian a function object of the form tStateMatrix (double dt, const tStateVector &)
+     */
+    template<typename DynamicsModel, typename DynamicsJacobian>
+    inline void timeUpdate(DynamicsModel &&dynamicsModel, DynamicsJacobian &&dynamicsJacobian)
+    {
+        const tStateMatrix A(dynamicsJacobian(m_dt, m_xh));
+        m_xh = dynamicsModel(m_dt, m_xh); // project state ahead
+        m_P = (A * m_P).postMultiplyTranspose(A); // project the error covariance ahead
+        m_P += m_Q;
+    }
+
+protected:
+
+    /**
+     * Adaptive estimation of process noise
+     * @param x the state estimate prior to the measurement update
+     * @param P the error covariance prior to the measurement update
+     */
+    inline void adaptProcessCovariance(const tStateVector &x, const tStateMatrix &P)
+    {
+        if (m_gamma > 0.0)
+        {
+            // compute estimated process noise
+            auto &&q = m_xh - x;
+            auto &&Q = q.outerProduct(q) + P - m_P - m_Q;
+
+            // combine new estimate of process noise in a moving average
+            m_Q += (Q - m_Q) / m_gamma;
+        }
+    }
+
+    /**
+     * the sampling interval (s)
+     */
+    double m_dt;
+
+    /**
+     * adaptive process window size
+     */
+    double m_gamma;
+
+    /**
+     * the error covariance matrix
+     */
+    tStateMatrix m_P;
+
+    /**
+     * the process covariance matrix
+     */
+    tStateMatrix m_Q;
+
+    /**
+     * the measurement covariance matrix
+     */
+    tMeasurementMatrix m_R;
+
+    /**
+     * the state estimate
+     */
+    tStateVector m_xh;
+};
+
+}
+
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef FIXED_LINEAR_KALMAN_H
+#define FIXED_LINEAR_KALMAN_H
+
+#include "fixedExtendedKalman.h"
+
+namespace math
+{
+
+namespace statistical
+{
+
+namespace estimation
+{
+
+namespace kalman
+{
+
+/**
+ * This class implements a linear Kalman estimation filter for a state vector and measurement vector whose sizes
+ * are known at compile time; the state transition and measurement matrices are stored within the filter, so
+ * that a predict/update cycle performs no heap allocation
+ * @tparam N the size of the state vector
+ * @tparam M the size of the measurement vector
+ * @tparam T the element type
+ */
+template<std::size_t N, std::size_t M, typename T = double>
+class FixedLinearKalman
+: public FixedExtendedKalman<N, M, T>
+{
+public:
+
+    /**
+     * Typedef declarations
+     */
+    typedef FixedExtendedKalman<N, M, T> tBase;
+    typedef typename tBase::tMeasurementJacobian tMeasurementJacobian;
+    typedef typename tBase::tMeasurementVector tMeasurementVector;
+    typedef typename tBase::tStateMatrix tStateMatrix;
+    typedef typename tBase::tStateVector tStateVector;
+
+    /**
+     * Constructor
+     * @param dt the sampling interval (s)
+     */
+    FixedLinearKalman(double dt = 0.0)
+    : tBase(dt),
+      m_A(tStateMatrix::identity())
+    {
+
+    }
+
+    /**
+     * Get the state transition matrix
+     */
+    inline const tStateMatrix &getDynamicsMatrix(void) const
+    {
+        return m_A;
+    }
+
+    /**
+     * Get the measurement matrix
+     */
+    inline const tMeasurementJacobian &getMeasurementMatrix(void) const
+    {
+        return m_H;
+    }
+
+    /**
+     * Measurement update function
+     * @param z the measurement vector
+     */
+    inline bool measurementUpdate(const tMeasurementVector &z)
+    {
+        return tBase::measurementUpdate(z, [this] (const tStateVector &x) { return m_H * x; },
+                                        [this] (const tStateVector &) -> const tMeasurementJacobian &
+                                        { return m_H; });
+    }
+
+    /**
+     * Set the state transition matrix
+     */
+    inline void setDynamicsMatrix(const tStateMatrix &A)
+    {
+        m_A = A;
+    }
+
+    /**
+     * Set the measurement matrix
+     */
+    inline void setMeasurementMatrix(const tMeasurementJacobian &H)
+    {
+        m_H = H;
+    }
+
+    /**
+     * Time update function
+     */
+    inline void timeUpdate(void)
+    {
+        tBase::timeUpdate([this] (double, const tStateVector &x) { return m_A * x; },
+                          [this] (double, const tStateVector &) -> const tStateMatrix & { return m_A; });
+    }
+
+protected:
+
+    /**
+     * the state transition matrix
+     */
+    tStateMatrix m_A;
+
+    /**
+     * the measurement matrix
+     */
+    tMeasurementJacobian m_H;
+};
+
+}
+
+}
+
+}
+
+}
+
+#endif
@@ -1,5 +1,10 @@
+#include "cholesky.h"
 #include "kalman.h"
 
+// using namespace declarations
+using namespace math::linear_algebra::matrix::decomposition;
+using namespace utilities;
+
 namespace math
 {
 
@@ -74,6 +79,39 @@ Kalman &Kalman::operator = (Kalman &&kalman)
     return *this;
 }
 
+/**
+ * Compute the Kalman gain, K = Pxy * S^-1, by Cholesky factorization of the residual covariance and triangular
+ * solves, without forming its inverse; returns false if the residual covariance is not positive definite
+ * @param Pxy the cross-covariance of the state and measurement (P * H' for linearized filters)
+ * @param S   the residual covariance
+ * @param K   upon success, contains the Kalman gain
+ */
+bool Kalman::calcKalmanGain(const Matrix2d &Pxy,
+                            const Matrix2d &S,
+                            Matrix2d &K)
+{
+    // since S is symmetric, K' solves S * K' = Pxy'
+    Cholesky_Factor<Matrix2d> cholesky;
+    m_tempFactor = S;
+    bool bSuccess = (cholesky.factor(m_tempFactor) == 0);
+    if (bSuccess)
+    {
+        m_tempGainTranspose = Pxy.calcTranspose();
+        bSuccess = (cholesky.solveLower(m_tempFactor, m_tempGainTranspose, m_tempGainTranspose) == 0);
+        if (bSuccess)
+            K = m_tempGainTranspose.calcTranspose();
+    }
+
+    if (!bSuccess)
+    {
+        logMsg(std::cout, LoggingLevel::Enum::Warning,
+               "Residual covariance is not positive definite!\n",
+               getQualifiedMethodName(__func__));
+    }
+
+    return bSuccess;
+}
+
 /**
  * Get the name of this class
  */
@@ -98,6 +136,31 @@ bool Kalman::setup(void)
     return bSuccess;
 }
 
+/**
+ * Update the error covariance, P = P - K * Pxy'; only the upper triangle is evaluated, and it is mirrored into
+ * the lower triangle so that the error covariance remains exactly symmetric
+ * @param K   the Kalman gain
+ * @param Pxy the cross-covariance of the state and measurement
+ */
+void Kalman::updateErrorCovariance(const Matrix2d &K,
+                                   const Matrix2d &Pxy)
+{
+    auto &&L = m_P.rows();
+    auto &&n = K.columns();
+    for (std::size_t i = 0; i < L; ++i)
+    {
+        for (std::size_t j = i; j < L; ++j)
+        {
+            double sum = 0.0;
+            for (std::size_t k = 0; k < n; ++k)
+                sum += K(i, k) * Pxy(j, k);
+
+            m_P(i, j) -= sum;
+            m_P(j, i) = m_P(i, j);
+        }
+    }
+}
+
 /**
  * Swap function
  */
@@ -108,6 +171,8 @@ void Kalman::swap(Kalman &kalman)
     m_P.swap(kalman.m_P);
     m_Q.swap(kalman.m_Q);
     m_R.swap(kalman.m_R);
+    m_tempFactor.swap(kalman.m_tempFactor);
+    m_tempGainTranspose.swap(kalman.m_tempGainTranspose);
 }
 
 }
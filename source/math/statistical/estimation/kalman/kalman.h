@@ -67,6 +67,27 @@ protected:
      */
     EXPORT_STEM Kalman &operator = (Kalman &&kalman);
 
+    /**
+     * Compute the Kalman gain, K = Pxy * S^-1, by Cholesky factorization of the residual covariance and
+     * triangular solves, without forming its inverse; returns false if the residual covariance is not positive
+     * definite
+     * @param Pxy the cross-covariance of the state and measurement (P * H' for linearized filters)
+     * @param S   the residual covariance
+     * @param K   upon success, contains the Kalman gain
+     */
+    EXPORT_STEM virtual bool calcKalmanGain(const Matrix2d &Pxy,
+                                            const Matrix2d &S,
+                                            Matrix2d &K) final;
+
+    /**
+     * Update the error covariance, P = P - K * Pxy'; only the upper triangle is evaluated, and it is mirrored
+     * into the lower triangle so that the error covariance remains exactly symmetric
+     * @param K   the Kalman gain
+     * @param Pxy the cross-covariance of the state and measurement
+     */
+    EXPORT_STEM virtual void updateErrorCovariance(const Matrix2d &K,
+                                                   const Matrix2d &Pxy) final;
+
 public:
 
     /**
@@ -105,6 +126,16 @@ protected:
      * the measurement covariance matrix
      */
     Matrix2d m_R;
+
+    /**
+     * the Cholesky factor of the residual covariance, used to compute the Kalman gain
+     */
+    Matrix2d m_tempFactor;
+
+    /**
+     * the transpose of the Kalman gain, used to compute the Kalman gain
+     */
+    Matrix2d m_tempGainTranspose;
 };
 
 }
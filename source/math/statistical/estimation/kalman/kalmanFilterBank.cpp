@@ -0,0 +1,627 @@
+#include "kalmanFilterBank.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+
+// using namespace declarations
+using namespace math::linear_algebra::matrix;
+using namespace utilities;
+
+namespace math
+{
+
+namespace statistical
+{
+
+namespace estimation
+{
+
+namespace kalman
+{
+
+/**
+ * the minimum number of blocks updated by each thread when the filters are split across multiple threads
+ */
+static constexpr std::size_t MINIMUM_BLOCKS_PER_THREAD = 16;
+
+/**
+ * Constructor
+ * @param stateSize       the dimension of the state of each filter
+ * @param measurementSize the dimension of the measurements of each filter
+ */
+KalmanFilterBank::KalmanFilterBank(std::size_t stateSize,
+                                   std::size_t measurementSize)
+: m_maximumThreads(1),
+  m_measurementSize(measurementSize),
+  m_numFilters(0),
+  m_stateSize(stateSize)
+{
+
+}
+
+/**
+ * Destructor
+ */
+KalmanFilterBank::~KalmanFilterBank(void)
+{
+
+}
+
+/**
+ * Invoke a function over ranges of blocks, splitting the blocks across multiple threads if worthwhile
+ * @param function a binary function object which accepts the indices of the first block in a range and one
+ *                 past the last
+ */
+template<typename Function>
+void KalmanFilterBank::forEachBlockRange(Function &&function)
+{
+    auto &&numBlocks = (m_numFilters + LANES - 1) / LANES;
+    auto numThreads = std::min(m_maximumThreads, numBlocks / MINIMUM_BLOCKS_PER_THREAD);
+    if (numThreads <= 1)
+        function(std::size_t(0), numBlocks);
+    else
+    {
+        if (m_pThreadPool == nullptr)
+            m_pThreadPool.reset(new ThreadPool<bool>(m_maximumThreads));
+
+        m_pThreadPool->forEachRange(numBlocks, numThreads, 1, function);
+    }
+}
+
+/**
+ * Get the name of this class
+ */
+std::string KalmanFilterBank::getClassName(void) const
+{
+    return "KalmanFilterBank";
+}
+
+/**
+ * Get the error covariance of the specified filter; returns false if the index is out of range
+ */
+bool KalmanFilterBank::getErrorCovariance(std::size_t filter,
+                                          Matrix2d &P) const
+{
+    bool bSuccess = (filter < m_numFilters);
+    if (bSuccess)
+    {
+        auto &&n = m_stateSize;
+        auto *pBlock = m_errorCovariances.data() + (filter / LANES) * n * n * LANES + filter % LANES;
+        P.resize(n, n);
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+                P(i, j) = pBlock[(i * n + j) * LANES];
+    }
+
+    return bSuccess;
+}
+
+/**
+ * Get the maximum number of threads used to update the filters (default is one, i.e., single-threaded)
+ */
+std::size_t KalmanFilterBank::getMaximumThreads(void) const
+{
+    return m_maximumThreads;
+}
+
+/**
+ * Get the dimension of the measurements of each filter
+ */
+std::size_t KalmanFilterBank::getMeasurementSize(void) const
+{
+    return m_measurementSize;
+}
+
+/**
+ * Get the number of filters in the bank
+ */
+std::size_t KalmanFilterBank::getNumFilters(void) const
+{
+    return m_numFilters;
+}
+
+/**
+ * Get the state estimate of the specified filter as a column vector; returns false if the index is out of
+ * range
+ */
+bool KalmanFilterBank::getStateEstimate(std::size_t filter,
+                                        Matrix2d &xh) const
+{
+    bool bSuccess = (filter < m_numFilters);
+    if (bSuccess)
+    {
+        auto &&n = m_stateSize;
+        auto *pBlock = m_stateEstimates.data() + (filter / LANES) * n * LANES + filter % LANES;
+        xh.resize(n, 1);
+        for (std::size_t i = 0; i < n; ++i)
+            xh[i] = pBlock[i * LANES];
+    }
+
+    return bSuccess;
+}
+
+/**
+ * Get the dimension of the state of each filter
+ */
+std::size_t KalmanFilterBank::getStateSize(void) const
+{
+    return m_stateSize;
+}
+
+/**
+ * Determine whether or not a measurement is pending for the specified filter
+ */
+bool KalmanFilterBank::isMeasurementPending(std::size_t filter) const
+{
+    return filter < m_numFilters && m_measurementPending[filter] != 0.0;
+}
+
+/**
+ * Update each filter for which a measurement is pending, and clear the pending measurements; returns false if
+ * a measurement model has not been set or if any filter could not be updated because its residual covariance
+ * is not positive definite
+ */
+bool KalmanFilterBank::measurementUpdate(void)
+{
+    if (!m_measurementModel)
+    {
+        logMsg(std::cout, LoggingLevel::Enum::Warning,
+               "Measurement model has not been set!\n",
+               getQualifiedMethodName(__func__));
+
+        return false;
+    }
+
+    std::atomic<std::size_t> numFailures(0);
+    forEachBlockRange([this, &numFailures] (std::size_t beginBlock, std::size_t endBlock)
+    {
+        auto &&n = m_stateSize;
+        auto &&m = m_measurementSize;
+
+        // workspace: predicted measurements, measurement Jacobians, P * H^T, the lower triangular Cholesky
+        // factor of the residual covariance, Kalman gains, residuals and the per-lane update mask
+        std::vector<double> workspace(LANES * (m + m * n + n * m + m * m + n * m + m + 1));
+        auto *h = workspace.data();
+        auto *H = h + m * LANES;
+        auto *PHt = H + m * n * LANES;
+        auto *L = PHt + n * m * LANES;
+        auto *K = L + m * m * LANES;
+        auto *v = K + n * m * LANES;
+        auto *mask = v + m * LANES;
+
+        std::size_t numBlockFailures = 0;
+        for (std::size_t block = beginBlock; block < endBlock; ++block)
+        {
+            auto *pending = m_measurementPending.data() + block * LANES;
+            if (std::none_of(pending, pending + LANES, [] (double flag) { return flag != 0.0; }))
+                continue;
+
+            auto *x = m_stateEstimates.data() + block * n * LANES;
+            auto *P = m_errorCovariances.data() + block * n * n * LANES;
+            auto *R = m_measurementCovariances.data() + block * m * m * LANES;
+            auto *z = m_measurements.data() + block * m * LANES;
+
+            m_measurementModel(x, h, H);
+
+            // P * H^T
+            std::fill(PHt, PHt + n * m * LANES, 0.0);
+            for (std::size_t i = 0; i < n; ++i)
+                for (std::size_t j = 0; j < m; ++j)
+                    for (std::size_t k = 0; k < n; ++k)
+                    {
+                        auto *pP = P + (i * n + k) * LANES;
+                        auto *pH = H + (j * n + k) * LANES;
+                        auto *pPHt = PHt + (i * m + j) * LANES;
+                        for (std::size_t l = 0; l < LANES; ++l)
+                            pPHt[l] += pP[l] * pH[l];
+                    }
+
+            // lower triangle of the residual covariance, S = H * P * H^T + R
+            for (std::size_t i = 0; i < m; ++i)
+                for (std::size_t j = 0; j <= i; ++j)
+                {
+                    auto *pS = L + (i * m + j) * LANES;
+                    auto *pR = R + (i * m + j) * LANES;
+                    for (std::size_t l = 0; l < LANES; ++l)
+                        pS[l] = pR[l];
+
+                    for (std::size_t k = 0; k < n; ++k)
+                    {
+                        auto *pH = H + (i * n + k) * LANES;
+                        auto *pPHt = PHt + (k * m + j) * LANES;
+                        for (std::size_t l = 0; l < LANES; ++l)
+                            pS[l] += pH[l] * pPHt[l];
+                    }
+                }
+
+            // factor the residual covariance in place; lanes with a non-positive pivot are masked out, and
+            // their pivots replaced so that the remaining arithmetic stays finite
+            for (std::size_t l = 0; l < LANES; ++l)
+                mask[l] = pending[l];
+
+            for (std::size_t j = 0; j < m; ++j)
+            {
+                auto *pDiagonal = L + (j * m + j) * LANES;
+                for (std::size_t k = 0; k < j; ++k)
+                {
+                    auto *pLjk = L + (j * m + k) * LANES;
+                    for (std::size_t l = 0; l < LANES; ++l)
+                        pDiagonal[l] -= pLjk[l] * pLjk[l];
+                }
+
+                for (std::size_t l = 0; l < LANES; ++l)
+                {
+                    bool bPositive = pDiagonal[l] > 0.0;
+                    mask[l] = bPositive ? mask[l] : 0.0;
+                    pDiagonal[l] = std::sqrt(bPositive ? pDiagonal[l] : 1.0);
+                }
+
+                for (std::size_t i = j + 1; i < m; ++i)
+                {
+                    auto *pLij = L + (i * m + j) * LANES;
+                    for (std::size_t k = 0; k < j; ++k)
+                    {
+                        auto *pLik = L + (i * m + k) * LANES;
+                        auto *pLjk = L + (j * m + k) * LANES;
+                        for (std::size_t l = 0; l < LANES; ++l)
+                            pLij[l] -= pLik[l] * pLjk[l];
+                    }
+
+                    for (std::size_t l = 0; l < LANES; ++l)
+                        pLij[l] /= pDiagonal[l];
+                }
+            }
+
+            for (std::size_t l = 0; l < LANES; ++l)
+                if (pending[l] != 0.0 && mask[l] == 0.0)
+                    ++numBlockFailures;
+
+            // Kalman gain, K = P * H^T * S^-1; each row of K solves L * L^T * k = (row of P * H^T)
+            for (std::size_t r = 0; r < n; ++r)
+            {
+                auto *k = K + r * m * LANES;
+                auto *b = PHt + r * m * LANES;
+                for (std::size_t i = 0; i < m; ++i)
+                {
+                    auto *pk = k + i * LANES;
+                    auto *pb = b + i * LANES;
+                    for (std::size_t l = 0; l < LANES; ++l)
+                        pk[l] = pb[l];
+
+                    for (std::size_t j = 0; j < i; ++j)
+                    {
+                        auto *pLij = L + (i * m + j) * LANES;
+                        auto *pkj = k + j * LANES;
+                        for (std::size_t l = 0; l < LANES; ++l)
+                            pk[l] -= pLij[l] * pkj[l];
+                    }
+
+                    auto *pLii = L + (i * m + i) * LANES;
+                    for (std::size_t l = 0; l < LANES; ++l)
+                        pk[l] /= pLii[l];
+                }
+
+                for (std::size_t i = m; i-- > 0;)
+                {
+                    auto *pk = k + i * LANES;
+                    for (std::size_t j = i + 1; j < m; ++j)
+                    {
+                        auto *pLji = L + (j * m + i) * LANES;
+                        auto *pkj = k + j * LANES;
+                        for (std::size_t l = 0; l < LANES; ++l)
+                            pk[l] -= pLji[l] * pkj[l];
+                    }
+
+                    auto *pLii = L + (i * m + i) * LANES;
+                    for (std::size_t l = 0; l < LANES; ++l)
+                        pk[l] /= pLii[l];
+                }
+            }
+
+            // measurement residual
+            for (std::size_t i = 0; i < m * LANES; ++i)
+                v[i] = z[i] - h[i];
+
+            // state estimate update, x = x + K * v
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                double dx[LANES] = {};
+                for (std::size_t j = 0; j < m; ++j)
+                {
+                    auto *pK = K + (i * m + j) * LANES;
+                    auto *pv = v + j * LANES;
+                    for (std::size_t l = 0; l < LANES; ++l)
+                        dx[l] += pK[l] * pv[l];
+                }
+
+                auto *px = x + i * LANES;
+                for (std::size_t l = 0; l < LANES; ++l)
+                    px[l] = mask[l] != 0.0 ? px[l] + dx[l] : px[l];
+            }
+
+            // error covariance update, P = P - K * (P * H^T)^T, which is symmetric
+            for (std::size_t i = 0; i < n; ++i)
+                for (std::size_t j = i; j < n; ++j)
+                {
+                    double dP[LANES] = {};
+                    for (std::size_t k = 0; k < m; ++k)
+                    {
+                        auto *pK = K + (i * m + k) * LANES;
+                        auto *pPHt = PHt + (j * m + k) * LANES;
+                        for (std::size_t l = 0; l < LANES; ++l)
+                            dP[l] += pK[l] * pPHt[l];
+                    }
+
+                    auto *pPij = P + (i * n + j) * LANES;
+                    auto *pPji = P + (j * n + i) * LANES;
+                    for (std::size_t l = 0; l < LANES; ++l)
+                    {
+                        pPij[l] = mask[l] != 0.0 ? pPij[l] - dP[l] : pPij[l];
+                        pPji[l] = pPij[l];
+                    }
+                }
+
+            std::fill(pending, pending + LANES, 0.0);
+        }
+
+        numFailures += numBlockFailures;
+    });
+
+    bool bSuccess = (numFailures == 0);
+    if (!bSuccess)
+    {
+        logMsg(std::cout, LoggingLevel::Enum::Warning,
+               std::to_string(numFailures.load()) + " filter(s) with a residual covariance that is not positive "
+               "definite were not updated.\n",
+               getQualifiedMethodName(__func__));
+    }
+
+    return bSuccess;
+}
+
+/**
+ * Resize the bank; filters added to the bank have zero state estimates and covariances
+ */
+void KalmanFilterBank::resize(std::size_t numFilters)
+{
+    auto &&n = m_stateSize;
+    auto &&m = m_measurementSize;
+    auto &&numLanes = LANES * ((numFilters + LANES - 1) / LANES);
+
+    // when shrinking, clear the lanes of the last block which no longer belong to a filter, so that filters
+    // added later start from zero
+    for (std::size_t filter = numFilters; filter < std::min(m_numFilters, numLanes); ++filter)
+    {
+        std::size_t block = filter / LANES, lane = filter % LANES;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            m_stateEstimates[(block * n + i) * LANES + lane] = 0.0;
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                m_errorCovariances[((block * n + i) * n + j) * LANES + lane] = 0.0;
+                m_processCovariances[((block * n + i) * n + j) * LANES + lane] = 0.0;
+            }
+        }
+
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            m_measurements[(block * m + i) * LANES + lane] = 0.0;
+            for (std::size_t j = 0; j < m; ++j)
+                m_measurementCovariances[((block * m + i) * m + j) * LANES + lane] = 0.0;
+        }
+
+        m_measurementPending[filter] = 0.0;
+    }
+
+    m_errorCovariances.resize(numLanes * n * n, 0.0);
+    m_measurementCovariances.resize(numLanes * m * m, 0.0);
+    m_measurementPending.resize(numLanes, 0.0);
+    m_measurements.resize(numLanes * m, 0.0);
+    m_processCovariances.resize(numLanes * n * n, 0.0);
+    m_stateEstimates.resize(numLanes * n, 0.0);
+    m_numFilters = numFilters;
+}
+
+/**
+ * Copy a matrix into the interleaved storage of the specified filter
+ */
+bool KalmanFilterBank::setElements(std::vector<double> &elements,
+                                   std::size_t rows,
+                                   std::size_t columns,
+                                   std::size_t filter,
+                                   const Matrix2d &matrix)
+{
+    // vectors may be given as rows or columns
+    bool bVector = (columns == 1 && matrix.size() == rows && (matrix.rows() == 1 || matrix.columns() == 1));
+    bool bSuccess = (filter < m_numFilters && (bVector || (matrix.rows() == rows && matrix.columns() == columns)));
+    if (bSuccess)
+    {
+        auto *pBlock = elements.data() + (filter / LANES) * rows * columns * LANES + filter % LANES;
+        for (std::size_t i = 0; i < rows * columns; ++i)
+            pBlock[i * LANES] = matrix[i];
+    }
+    else
+    {
+        logMsg(std::cout, LoggingLevel::Enum::Warning,
+               "Invalid filter index or matrix dimensions!\n",
+               getQualifiedMethodName(__func__));
+    }
+
+    return bSuccess;
+}
+
+/**
+ * Set the error covariance of the specified filter; returns false if the index or the dimensions of the matrix
+ * are invalid
+ */
+bool KalmanFilterBank::setErrorCovariance(std::size_t filter,
+                                          const Matrix2d &P)
+{
+    return setElements(m_errorCovariances, m_stateSize, m_stateSize, filter, P);
+}
+
+/**
+ * Set the maximum number of threads used to update the filters
+ */
+void KalmanFilterBank::setMaximumThreads(std::size_t maximumThreads)
+{
+    m_maximumThreads = std::max(maximumThreads, std::size_t(1));
+    if (m_pThreadPool != nullptr)
+        m_pThreadPool->setMaximumThreads(m_maximumThreads);
+}
+
+/**
+ * Set a measurement to be processed by the specified filter at the next measurement update; returns false if
+ * the index or the dimensions of the measurement are invalid
+ */
+bool KalmanFilterBank::setMeasurement(std::size_t filter,
+                                      const Matrix2d &z)
+{
+    bool bSuccess = setElements(m_measurements, m_measurementSize, 1, filter, z);
+    if (bSuccess)
+        m_measurementPending[filter] = 1.0;
+
+    return bSuccess;
+}
+
+/**
+ * Set the measurement covariance of the specified filter; returns false if the index or the dimensions of the
+ * matrix are invalid
+ */
+bool KalmanFilterBank::setMeasurementCovariance(std::size_t filter,
+                                                const Matrix2d &R)
+{
+    return setElements(m_measurementCovariances, m_measurementSize, m_measurementSize, filter, R);
+}
+
+/**
+ * Set the measurement model
+ */
+void KalmanFilterBank::setMeasurementModel(const MeasurementModel &measurementModel)
+{
+    m_measurementModel = measurementModel;
+}
+
+/**
+ * Set the process covariance of the specified filter; returns false if the index or the dimensions of the
+ * matrix are invalid
+ */
+bool KalmanFilterBank::setProcessCovariance(std::size_t filter,
+                                            const Matrix2d &Q)
+{
+    return setElements(m_processCovariances, m_stateSize, m_stateSize, filter, Q);
+}
+
+/**
+ * Set the state estimate of the specified filter; returns false if the index or the dimensions of the state
+ * are invalid
+ */
+bool KalmanFilterBank::setStateEstimate(std::size_t filter,
+                                        const Matrix2d &xh)
+{
+    return setElements(m_stateEstimates, m_stateSize, 1, filter, xh);
+}
+
+/**
+ * Propagate the state estimates and error covariances of all filters ahead; returns false if the dimensions of
+ * the state transition matrix are invalid
+ * @param F the state transition matrix
+ */
+bool KalmanFilterBank::timeUpdate(const Matrix2d &F)
+{
+    auto &&n = m_stateSize;
+    bool bSuccess = (F.rows() == n && F.columns() == n);
+    if (!bSuccess)
+    {
+        logMsg(std::cout, LoggingLevel::Enum::Warning,
+               "Invalid state transition matrix dimensions!\n",
+               getQualifiedMethodName(__func__));
+
+        return bSuccess;
+    }
+
+    // state transition matrices are typically sparse; only their non-zero entries are visited
+    std::vector<std::size_t> rowOffsets(1, 0), columns;
+    std::vector<double> values;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            if (F(i, j) != 0.0)
+            {
+                columns.push_back(j);
+                values.push_back(F(i, j));
+            }
+        }
+
+        rowOffsets.push_back(columns.size());
+    }
+
+    forEachBlockRange([&] (std::size_t beginBlock, std::size_t endBlock)
+    {
+        std::vector<double> workspace(LANES * (n + n * n));
+        auto *xf = workspace.data();
+        auto *FP = xf + n * LANES;
+        for (std::size_t block = beginBlock; block < endBlock; ++block)
+        {
+            auto *x = m_stateEstimates.data() + block * n * LANES;
+            auto *P = m_errorCovariances.data() + block * n * n * LANES;
+            auto *Q = m_processCovariances.data() + block * n * n * LANES;
+
+            // project the state ahead, x = F * x
+            std::fill(xf, xf + n * LANES, 0.0);
+            for (std::size_t i = 0; i < n; ++i)
+                for (std::size_t e = rowOffsets[i]; e < rowOffsets[i + 1]; ++e)
+                {
+                    auto &&value = values[e];
+                    auto *pxf = xf + i * LANES;
+                    auto *px = x + columns[e] * LANES;
+                    for (std::size_t l = 0; l < LANES; ++l)
+                        pxf[l] += value * px[l];
+                }
+
+            std::copy(xf, xf + n * LANES, x);
+
+            // project the error covariance ahead, P = F * P * F^T + Q
+            std::fill(FP, FP + n * n * LANES, 0.0);
+            for (std::size_t i = 0; i < n; ++i)
+                for (std::size_t e = rowOffsets[i]; e < rowOffsets[i + 1]; ++e)
+                {
+                    auto &&value = values[e];
+                    for (std::size_t j = 0; j < n; ++j)
+                    {
+                        auto *pFP = FP + (i * n + j) * LANES;
+                        auto *pP = P + (columns[e] * n + j) * LANES;
+                        for (std::size_t l = 0; l < LANES; ++l)
+                            pFP[l] += value * pP[l];
+                    }
+                }
+
+            std::copy(Q, Q + n * n * LANES, P);
+            for (std::size_t i = 0; i < n; ++i)
+                for (std::size_t j = 0; j < n; ++j)
+                {
+                    auto *pP = P + (i * n + j) * LANES;
+                    for (std::size_t e = rowOffsets[j]; e < rowOffsets[j + 1]; ++e)
+                    {
+                        auto &&value = values[e];
+                        auto *pFP = FP + (i * n + columns[e]) * LANES;
+                        for (std::size_t l = 0; l < LANES; ++l)
+                            pP[l] += value * pFP[l];
+                    }
+                }
+        }
+    });
+
+    return bSuccess;
+}
+
+}
+
+}
+
+}
+
+}
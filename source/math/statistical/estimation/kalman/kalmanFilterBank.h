@@ -0,0 +1,295 @@
+#ifndef KALMAN_FILTER_BANK_H
+#define KALMAN_FILTER_BANK_H
+
+#include "export_library.h"
+#include "loggable.h"
+#include "matrix2d.h"
+#include "reflective.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// forward declarations
+namespace utilities { template<typename> class ThreadPool; }
+
+namespace math
+{
+
+namespace statistical
+{
+
+namespace estimation
+{
+
+namespace kalman
+{
+
+/**
+ * This class implements a bank of extended Kalman filters sharing the same state and measurement dimensions,
+ * linear dynamics and measurement model, for tracking many objects at once. The filters are stored in blocks
+ * of LANES filters; within a block, each element of the state estimates, error covariances, process and
+ * measurement covariances and pending measurements is stored as LANES consecutive values (one per filter), so
+ * that the time and measurement updates of a block run as straight-line loops over the lanes which the
+ * compiler can vectorize. Blocks may be split across worker threads (see setMaximumThreads()).
+ *
+ * A time update propagates every filter through a common state transition matrix. A measurement update is
+ * applied only to filters for which a measurement has been set since the last measurement update; the
+ * residual covariance is inverted by Cholesky factorization, and filters whose residual covariance is not
+ * positive definite are left unchanged
+ */
+class KalmanFilterBank final
+: public attributes::concrete::Loggable<std::string, std::ostream>,
+  virtual private attributes::abstract::Reflective
+{
+public:
+
+    /**
+     * Type alias declarations
+     */
+    using Matrix2d = linear_algebra::matrix::Matrix2d;
+
+    /**
+     * the number of filters whose elements are interleaved within a block
+     */
+    static constexpr std::size_t LANES = 8;
+
+    /**
+     * Function type which evaluates the measurement model and its Jacobian for a block of filters. Element i
+     * of the state of lane l is found at pStates[i * LANES + l]; upon return, element i of the predicted
+     * measurement must be stored at pPredictions[i * LANES + l], and element (i, j) of the measurement
+     * Jacobian at pJacobians[(i * stateSize + j) * LANES + l]
+     */
+    using MeasurementModel = std::function<void (const double *pStates,
+                                                 double *pPredictions,
+                                                 double *pJacobians)>;
+
+    /**
+     * Constructor
+     * @param stateSize       the dimension of the state of each filter
+     * @param measurementSize the dimension of the measurements of each filter
+     */
+    EXPORT_STEM KalmanFilterBank(std::size_t stateSize,
+                                 std::size_t measurementSize);
+
+    /**
+     * Copy constructor
+     */
+    KalmanFilterBank(const KalmanFilterBank &bank) = delete;
+
+    /**
+     * Move constructor
+     */
+    KalmanFilterBank(KalmanFilterBank &&bank) = delete;
+
+    /**
+     * Destructor
+     */
+    EXPORT_STEM virtual ~KalmanFilterBank(void) override;
+
+    /**
+     * Copy assignment operator
+     */
+    KalmanFilterBank &operator = (const KalmanFilterBank &bank) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    KalmanFilterBank &operator = (KalmanFilterBank &&bank) = delete;
+
+    /**
+     * Get the name of this class
+     */
+    EXPORT_STEM virtual std::string getClassName(void) const override;
+
+    /**
+     * Get the error covariance of the specified filter; returns false if the index is out of range
+     */
+    EXPORT_STEM bool getErrorCovariance(std::size_t filter,
+                                        Matrix2d &P) const;
+
+    /**
+     * Get the maximum number of threads used to update the filters (default is one, i.e., single-threaded)
+     */
+    EXPORT_STEM std::size_t getMaximumThreads(void) const;
+
+    /**
+     * Get the dimension of the measurements of each filter
+     */
+    EXPORT_STEM std::size_t getMeasurementSize(void) const;
+
+    /**
+     * Get the number of filters in the bank
+     */
+    EXPORT_STEM std::size_t getNumFilters(void) const;
+
+    /**
+     * Get the state estimate of the specified filter as a column vector; returns false if the index is out of
+     * range
+     */
+    EXPORT_STEM bool getStateEstimate(std::size_t filter,
+                                      Matrix2d &xh) const;
+
+    /**
+     * Get the dimension of the state of each filter
+     */
+    EXPORT_STEM std::size_t getStateSize(void) const;
+
+    /**
+     * Determine whether or not a measurement is pending for the specified filter
+     */
+    EXPORT_STEM bool isMeasurementPending(std::size_t filter) const;
+
+    /**
+     * Update each filter for which a measurement is pending, and clear the pending measurements; returns
+     * false if a measurement model has not been set or if any filter could not be updated because its
+     * residual covariance is not positive definite
+     */
+    EXPORT_STEM bool measurementUpdate(void);
+
+    /**
+     * Resize the bank; filters added to the bank have zero state estimates and covariances
+     */
+    EXPORT_STEM void resize(std::size_t numFilters);
+
+    /**
+     * Set the error covariance of the specified filter; returns false if the index or the dimensions of the
+     * matrix are invalid
+     */
+    EXPORT_STEM bool setErrorCovariance(std::size_t filter,
+                                        const Matrix2d &P);
+
+    /**
+     * Set the maximum number of threads used to update the filters
+     */
+    EXPORT_STEM void setMaximumThreads(std::size_t maximumThreads);
+
+    /**
+     * Set a measurement to be processed by the specified filter at the next measurement update; returns false
+     * if the index or the dimensions of the measurement are invalid
+     */
+    EXPORT_STEM bool setMeasurement(std::size_t filter,
+                                    const Matrix2d &z);
+
+    /**
+     * Set the measurement covariance of the specified filter; returns false if the index or the dimensions of
+     * the matrix are invalid
+     */
+    EXPORT_STEM bool setMeasurementCovariance(std::size_t filter,
+                                              const Matrix2d &R);
+
+    /**
+     * Set the measurement model
+     */
+    EXPORT_STEM void setMeasurementModel(const MeasurementModel &measurementModel);
+
+    /**
+     * Set the process covariance of the specified filter; returns false if the index or the dimensions of the
+     * matrix are invalid
+     */
+    EXPORT_STEM bool setProcessCovariance(std::size_t filter,
+                                          const Matrix2d &Q);
+
+    /**
+     * Set the state estimate of the specified filter; returns false if the index or the dimensions of the
+     * state are invalid
+     */
+    EXPORT_STEM bool setStateEstimate(std::size_t filter,
+                                      const Matrix2d &xh);
+
+    /**
+     * Propagate the state estimates and error covariances of all filters ahead; returns false if the
+     * dimensions of the state transition matrix are invalid
+     * @param F the state transition matrix
+     */
+    EXPORT_STEM bool timeUpdate(const Matrix2d &F);
+
+private:
+
+    /**
+     * Invoke a function over ranges of blocks, splitting the blocks across multiple threads if worthwhile
+     * @param function a binary function object which accepts the indices of the first block in a range and one
+     *                 past the last
+     */
+    template<typename Function>
+    void forEachBlockRange(Function &&function);
+
+    /**
+     * Copy a matrix into the interleaved storage of the specified filter
+     */
+    EXPORT_STEM bool setElements(std::vector<double> &elements,
+                                 std::size_t rows,
+                                 std::size_t columns,
+                                 std::size_t filter,
+                                 const Matrix2d &matrix);
+
+    /**
+     * the error covariances, interleaved by block
+     */
+    std::vector<double> m_errorCovariances;
+
+    /**
+     * the maximum number of threads used to update the filters
+     */
+    std::size_t m_maximumThreads;
+
+    /**
+     * the measurement covariances, interleaved by block
+     */
+    std::vector<double> m_measurementCovariances;
+
+    /**
+     * the measurement model
+     */
+    MeasurementModel m_measurementModel;
+
+    /**
+     * flags (one per lane) indicating which filters have a pending measurement
+     */
+    std::vector<double> m_measurementPending;
+
+    /**
+     * the pending measurements, interleaved by block
+     */
+    std::vector<double> m_measurements;
+
+    /**
+     * the dimension of the measurements of each filter
+     */
+    std::size_t m_measurementSize;
+
+    /**
+     * the number of filters in the bank
+     */
+    std::size_t m_numFilters;
+
+    /**
+     * the thread pool used to update the filters; created upon first use
+     */
+    std::unique_ptr<::utilities::ThreadPool<bool>> m_pThreadPool;
+
+    /**
+     * the process covariances, interleaved by block
+     */
+    std::vector<double> m_processCovariances;
+
+    /**
+     * the state estimates, interleaved by block
+     */
+    std::vector<double> m_stateEstimates;
+
+    /**
+     * the dimension of the state of each filter
+     */
+    std::size_t m_stateSize;
+};
+
+}
+
+}
+
+}
+
+}
+
+#endif
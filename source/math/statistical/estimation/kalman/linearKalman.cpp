@@ -171,32 +171,39 @@ bool LinearKalman::measurementUpdate(StateVector &stateMeasurement)
     bool bSuccess = (m_bInitialized && m_pAppliedEstimationFilter != nullptr && !z.empty());
     if (bSuccess)
     {
-        auto &&HT = m_H.transpose();
-        auto &&I = Matrix2d::identity(m_xh.rows());
+        auto &&HT = m_H.calcTranspose();
 
         Matrix2d P(m_P); // error covariance prior to measurement update
         Matrix2d x(m_xh); // state estimate prior to measurement update
-        auto &&S = m_H * P * HT + m_R; // residual covariance
-        auto &&K = P * HT * S.calcInverse(); // Kalman gain
-        auto &&yh = m_H * x;
-        auto &&v = m_pAppliedEstimationFilter->computeMeasurementResidual(yh, z); // measurement residual
-        m_xh = x + K * v; // state estimate update
-
-        if (m_lambda > 0.0)
+        auto &&PHT = P * HT; // state-measurement cross-covariance
+        auto &&S = m_H * PHT + m_R; // residual covariance
+        Matrix2d K;
+        bSuccess = calcKalmanGain(PHT, S, K); // Kalman gain, computed by Cholesky factorization of S
+        if (bSuccess)
         {
-            computeReversePrediction(m_H,
-                                     S,
-                                     v,
-                                     z);
-
-            K = P * HT * S.calcInverse(); // Kalman gain
+            auto &&yh = m_H * x;
+            auto &&v = m_pAppliedEstimationFilter->computeMeasurementResidual(yh, z); // measurement residual
             m_xh = x + K * v; // state estimate update
+
+            if (m_lambda > 0.0)
+            {
+                computeReversePrediction(m_H,
+                                         S,
+                                         v,
+                                         z);
+
+                bSuccess = calcKalmanGain(PHT, S, K); // Kalman gain
+                m_xh = bSuccess ? x + K * v : x; // state estimate update
+            }
         }
 
-        m_P = (I - K * m_H) * P; // error covariance update
+        if (bSuccess)
+        {
+            updateErrorCovariance(K, PHT); // error covariance update, P = (I - K * H) * P = P - K * PHT'
 
-        // adaptive estimation of process noise
-        adaptProcessCovariance(x, P);
+            // adaptive estimation of process noise
+            adaptProcessCovariance(x, P);
+        }
 
     }
 
@@ -13,6 +13,7 @@ static constexpr char factoryName[] = "UnscentedKalman";
 
 // using namespace declarations
 using namespace attributes::abstract;
+using namespace math::linear_algebra::matrix;
 using namespace math::linear_algebra::matrix::decomposition;
 #ifdef RAPID_XML
 using namespace rapidxml;
@@ -35,6 +36,24 @@ namespace kalman
 static FactoryRegistrar<EstimationFilter, Kalman>
 factory(factoryName, &UnscentedKalman::create);
 
+/**
+ * Compute the deviations of a set of sigma points from their mean
+ * @param chi    the sigma points, one per column
+ * @param mean   the mean
+ * @param deltas upon return, contains the deviation of each sigma point, one per column
+ */
+static void calcDeviations(const Matrix2d &chi,
+                           const Matrix2d &mean,
+                           Matrix2d &deltas)
+{
+    auto &&rows = chi.rows();
+    auto &&columns = chi.columns();
+    deltas.resize(rows, columns);
+    for (std::size_t i = 0; i < rows; ++i)
+        for (std::size_t k = 0; k < columns; ++k)
+            deltas(i, k) = chi(i, k) - mean[i];
+}
+
 /**
  * Constructor
  */
@@ -333,55 +352,52 @@ bool UnscentedKalman::measurementUpdate(StateVector &stateMeasurement)
     bool bSuccess = (m_bInitialized && m_pAppliedEstimationFilter != nullptr && !z.empty());
     if (bSuccess)
     {
-        // initialize Pyy covariance matrix
-        for (std::size_t i = 0; i < m_Pyy.size(); ++i)
-            m_Pyy[i] = 0.0;
-
-        // compute Pyy covariance
+        // compute the deviations of the sigma points from the estimates once, rather than for each element of
+        // the covariances
         auto &&L = m_xh.size();
         auto &&n = m_yh.size();
+        auto &&numSigmaPoints = 1 + (L << 1);
+        calcDeviations(m_chiX, m_xh, m_deltaX);
+        calcDeviations(m_chiY, m_yh, m_deltaY);
+
+        // compute Pyy covariance; only the upper triangle is evaluated, since the matrix is symmetric
         for (std::size_t i = 0; i < n; ++i)
         {
-            for (std::size_t j = 0; j < n; ++j)
+            for (std::size_t j = i; j < n; ++j)
             {
-                for (std::size_t k = 0; k <= (L << 1); ++k)
-                {
-                    auto &&dYi = m_chiY(i, k) - m_yh[i];
-                    auto &&dYj = m_chiY(j, k) - m_yh[j];
-                    m_Pyy(i, j) += m_Wc[k] * dYi * dYj;
-                }
+                double sum = 0.0;
+                for (std::size_t k = 0; k < numSigmaPoints; ++k)
+                    sum += m_Wc[k] * m_deltaY(i, k) * m_deltaY(j, k);
 
-                m_Pyy(i, j) += m_R(i, j);
+                m_Pyy(i, j) = sum + m_R(i, j);
+                m_Pyy(j, i) = m_Pyy(i, j);
             }
         }
 
-        // initialize Pxy covariance matrix
-        for (std::size_t i = 0; i < m_Pxy.size(); ++i)
-            m_Pxy[i] = 0.0;
-
         // compute Pxy covariance
         for (std::size_t i = 0; i < L; ++i)
         {
             for (std::size_t j = 0; j < n; ++j)
             {
-                for (std::size_t k = 0; k <= (L << 1); ++k)
-                {
-                    auto &&dXi = m_chiX(i, k) - m_xh[i];
-                    auto &&dYj = m_chiY(j, k) - m_yh[j];
-                    m_Pxy(i, j) += m_Wc[k] * dXi * dYj;
-                }
+                double sum = 0.0;
+                for (std::size_t k = 0; k < numSigmaPoints; ++k)
+                    sum += m_Wc[k] * m_deltaX(i, k) * m_deltaY(j, k);
+
+                m_Pxy(i, j) = sum;
             }
         }
 
         // compute Kalman gain
-        m_K = m_Pxy * m_Pyy.calcInverse();
-
-        // update state estimate
-        auto &&v = m_pAppliedEstimationFilter->computeMeasurementResidual(m_yh, z); // measurement residual
-        m_xh += m_K * v;
+        bSuccess = calcKalmanGain(m_Pxy, m_Pyy, m_K);
+        if (bSuccess)
+        {
+            // update state estimate
+            auto &&v = m_pAppliedEstimationFilter->computeMeasurementResidual(m_yh, z); // measurement residual
+            m_xh += m_K * v;
 
-        // update error covariance
-        m_P -= m_K * m_Pyy.postMultiplyTranspose(m_K);
+            // update error covariance, P = P - K * Pyy * K' = P - K * Pxy'
+            updateErrorCovariance(m_K, m_Pxy);
+        }
     }
 
     if (m_pAppliedEstimationFilter == nullptr)
@@ -512,6 +528,8 @@ void UnscentedKalman::swap(UnscentedKalman &kalman)
     std::swap(m_beta, kalman.m_beta);
     m_chiX.swap(kalman.m_chiX);
     m_chiY.swap(kalman.m_chiY);
+    m_deltaX.swap(kalman.m_deltaX);
+    m_deltaY.swap(kalman.m_deltaY);
     std::swap(m_kappa, kalman.m_kappa);
     m_K.swap(kalman.m_K);
     m_Pxy.swap(kalman.m_Pxy);
@@ -555,23 +573,19 @@ void UnscentedKalman::timeUpdate(const Matrix2d &u)
             }
         }
 
-        // initialize error covariance matrix
-        for (std::size_t i = 0; i < m_P.size(); ++i)
-            m_P[i] = 0.0;
-
-        // compute error covariance
+        // compute error covariance from the deviations of the sigma points; only the upper triangle is
+        // evaluated, since the matrix is symmetric
+        calcDeviations(m_chiX, m_xh, m_deltaX);
         for (std::size_t i = 0; i < L; ++i)
         {
-            for (std::size_t j = 0; j < L; ++j)
+            for (std::size_t j = i; j < L; ++j)
             {
+                double sum = 0.0;
                 for (std::size_t k = 0; k <= (L << 1); ++k)
-                {
-                    auto &&dXi = m_chiX(i, k) - m_xh[i];
-                    auto &&dXj = m_chiX(j, k) - m_xh[j];
-                    m_P(i, j) += m_Wc[k] * dXi * dXj;
-                }
+                    sum += m_Wc[k] * m_deltaX(i, k) * m_deltaX(j, k);
 
-                m_P(i, j) += m_Q(i, j);
+                m_P(i, j) = sum + m_Q(i, j);
+                m_P(j, i) = m_P(i, j);
             }
         }
 
@@ -188,6 +188,16 @@ protected:
      */
     Matrix2d m_chiY;
 
+    /**
+     * deviations of the state sigma points from the state estimate
+     */
+    Matrix2d m_deltaX;
+
+    /**
+     * deviations of the observation sigma points from the observed estimate
+     */
+    Matrix2d m_deltaY;
+
     /**
      * secondary scaling parameter
      */
@@ -10,7 +10,8 @@ namespace statistical
 {
 
 /**
- * Class for computing the sum of a collection of samples
+ * Class for computing the sum of a collection of samples; samples are accumulated with Kahan compensation so
+ * that the round-off error of a running sum does not grow with the number of samples added and deleted
  */
 template<typename T>
 class Sum
@@ -63,6 +64,7 @@ protected:
         {
             StatisticalCalculator<T>::operator = (sum);
 
+            m_compensation = sum.m_compensation;
             m_sum = sum.m_sum;
         }
 
@@ -78,6 +80,7 @@ protected:
         {
             StatisticalCalculator<T>::operator = (std::move(sum));
 
+            m_compensation = std::move(sum.m_compensation);
             m_sum = std::move(sum.m_sum);
         }
 
@@ -92,7 +95,7 @@ public:
     inline virtual void addSample(const T &x) override
     {
         ++this->m_numSamples;
-        m_sum += x;
+        accumulate(x);
     }
 
     /**
@@ -129,7 +132,7 @@ public:
         else if (this->m_numSamples > 1)
         {
             --this->m_numSamples;
-            m_sum -= x;
+            accumulate(-x);
         }
 
         return bSuccess;
@@ -141,13 +144,30 @@ public:
     inline virtual bool initialize(void) override
     {
         this->m_numSamples = 0;
+        m_compensation = T(0.0);
         m_sum = T(0.0);
 
-        return bSuccess;
+        return true;
     }
 
 protected:
 
+    /**
+     * Add a value to the running sum, carrying the low-order bits lost to round-off into the next addition
+     */
+    inline void accumulate(const T &x)
+    {
+        T y = x - m_compensation;
+        T sum = m_sum + y;
+        m_compensation = (sum - m_sum) - y;
+        m_sum = sum;
+    }
+
+    /**
+     * the (negated) round-off error of the running sum
+     */
+    T m_compensation;
+
     /**
      * the sum of all samples in the collection
      */
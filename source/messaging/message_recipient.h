@@ -173,7 +173,8 @@ public:
         catch (const functional::bad_any_cast &)
         {
             // if a bad_any_cast is thrown, perhaps the recipient expects a vector of any objects
-            std::vector<functional::Any> anys = { functional::Any(messages) };
+            std::vector<functional::Any> anys;
+            anys.emplace_back(messages);
 
             return invoke(anys,
                           std::make_index_sequence<arity>{ });
@@ -4,13 +4,39 @@
 #include "any.h"
 #include "initializable.h"
 #include "message_packet.h"
+#include "mpsc_queue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace messaging
 {
 
 /**
- * This class provides an abstract interface for types that can send, receive, and process messages
+ * This class provides an abstract interface for types that can send, receive, and process messages.
+ *
+ * Received messages and messages queued for send are held in bounded, lock-free, multiple-producer/single-
+ * consumer queues, so receiveMessage() and queueMessageForSend() may be called concurrently from any number of
+ * threads. Received messages are separated into priority lanes upon arrival rather than sorted when they are
+ * processed: lane zero holds messages to which no priority has been assigned (negative priorities), and
+ * priorities zero and above map to the remaining lanes, with priorities beyond the last lane sharing it.
+ * Messages are processed in order of decreasing priority and, among messages of equal priority, in order of
+ * arrival; the messages drained from a lane shared by several priorities (the first and the last) are sorted by
+ * priority before they are queued for processing. Each lane is allocated when the first message is received in
+ * it, so lanes which are never used cost nothing.
+ *
+ * All other member functions (processing, sending, draining, clearing, initialization) are consumer-side and
+ * must be called from a single thread at a time; if the dispatch thread has been started (see
+ * startDispatchThread()), that thread is the consumer. Derived classes which start the dispatch thread should
+ * stop it in their own destructors, since the thread calls their overrides of processReceivedMessage() and
+ * sendMessage()
  */
 class Messenger
 : public attributes::interfaces::Initializable
@@ -21,13 +47,35 @@ public:
      * Typedef declarations
      */
     typedef MessagePacket<functional::Any> tMessagePacket;
+    typedef containers::MPSC_Queue<std::shared_ptr<tMessagePacket>> tMessageQueue;
+
+    /**
+     * the default capacity of each of this object's message queues
+     */
+    static constexpr std::size_t DEFAULT_QUEUE_CAPACITY = 4096;
+
+    /**
+     * the default number of received message priority lanes
+     */
+    static constexpr std::size_t DEFAULT_PRIORITY_LANES = 8;
 
     /**
      * Constructor
+     * @param queueCapacity    the capacity of each of this object's received message lanes and of its send
+     *                         queue
+     * @param numPriorityLanes the number of received message priority lanes
      */
-    Messenger(void)
+    Messenger(std::size_t queueCapacity = DEFAULT_QUEUE_CAPACITY,
+              std::size_t numPriorityLanes = DEFAULT_PRIORITY_LANES)
+    : m_bDispatcherWaiting(false),
+      m_bDispatching(false),
+      m_numPriorityLanes(numPriorityLanes == 0 ? 1 : numPriorityLanes),
+      m_queueCapacity(queueCapacity),
+      m_pSendQueue(new tMessageQueue(queueCapacity)),
+      m_pReceivedMessageLanes(new std::atomic<tMessageQueue *>[m_numPriorityLanes])
     {
-
+        for (std::size_t i = 0; i < m_numPriorityLanes; ++i)
+            m_pReceivedMessageLanes[i].store(nullptr, std::memory_order_relaxed);
     }
 
 protected:
@@ -49,14 +97,10 @@ public:
      */
     virtual ~Messenger(void)
     {
-        // clear this object's vector of messages queued for processing
-        m_messagesQueuedForProcessing.clear();
+        stopDispatchThread();
 
-        // clear this object's vector of messages queued for send
-        m_messagesQueuedForSend.clear();
-
-        // this object's queue of received messages
-        m_receivedMessages.clear();
+        for (std::size_t i = 0; i < m_numPriorityLanes; ++i)
+            delete m_pReceivedMessageLanes[i].load(std::memory_order_acquire);
     }
 
 protected:
@@ -82,19 +126,25 @@ public:
     }
 
     /**
-     * Clear this object's vector of messages queued for send
+     * Clear this object's messages queued for send
      */
     inline virtual void clearMessagesQueuedForSend(void) final
     {
+        m_pSendQueue->drain([] (std::shared_ptr<tMessagePacket> &&) { });
         m_messagesQueuedForSend.clear();
     }
 
     /**
-     * Clear this object's queue of received messages
+     * Clear this object's queues of received messages
      */
     inline virtual void clearReceivedMessages(void) final
     {
-        m_receivedMessages.clear();
+        for (std::size_t i = 0; i < m_numPriorityLanes; ++i)
+        {
+            auto *pLane = getReceivedMessageLane(i);
+            if (pLane != nullptr)
+                pLane->drain([] (std::shared_ptr<tMessagePacket> &&) { });
+        }
     }
 
     /**
@@ -107,7 +157,39 @@ public:
     }
 
     /**
-     * Get this object's vector of messages queued for processing
+     * Remove up to the specified number of received messages from this object's priority lanes, in order of
+     * decreasing priority, and append them to the input vector; returns the number of messages removed
+     * @param messages        upon return, contains the removed messages
+     * @param maximumMessages the maximum number of messages to remove
+     */
+    inline virtual std::size_t drainReceivedMessages(std::vector<std::shared_ptr<tMessagePacket>> &messages,
+                                                     std::size_t maximumMessages =
+                                                     std::numeric_limits<std::size_t>::max()) final
+    {
+        std::size_t numRemoved = 0;
+        for (std::size_t lane = m_numPriorityLanes; numRemoved < maximumMessages && lane-- > 0;)
+        {
+            auto *pLane = getReceivedMessageLane(lane);
+            if (pLane == nullptr)
+                continue;
+
+            // drain no more than the current occupancy of the lane, so that a steady stream of incoming
+            // messages cannot keep the consumer here indefinitely
+            auto numMessages = std::min(maximumMessages - numRemoved, pLane->size());
+            auto &&first = messages.size();
+            numRemoved += pLane->drain([&messages] (std::shared_ptr<tMessagePacket> &&pMessagePacket)
+                                       { messages.push_back(std::move(pMessagePacket)); }, numMessages);
+
+            // the first and last lanes are shared by several priorities
+            if (lane == 0 || lane + 1 == m_numPriorityLanes)
+                prioritizeMessages(messages.begin() + first, messages.end());
+        }
+
+        return numRemoved;
+    }
+
+    /**
+     * Get this object's vector of messages queued for processing, in order of decreasing priority
      */
     inline virtual std::vector<std::shared_ptr<tMessagePacket>> &getMessagesQueuedForProcessing(void) final
     {
@@ -115,7 +197,8 @@ public:
     }
 
     /**
-     * Get this object's vector of messages queued for send
+     * Get this object's vector of messages queued for send which have been removed from the send queue but not
+     * yet sent
      */
     inline virtual std::vector<std::shared_ptr<tMessagePacket>> &getMessagesQueuedForSend(void) final
     {
@@ -123,11 +206,60 @@ public:
     }
 
     /**
-     * Get this object's queue of received messages
+     * Get the approximate number of received messages which have not yet been queued for processing
+     */
+    inline virtual std::size_t getNumReceivedMessages(void) const final
+    {
+        std::size_t numMessages = 0;
+        for (std::size_t i = 0; i < m_numPriorityLanes; ++i)
+        {
+            auto *pLane = getReceivedMessageLane(i);
+            if (pLane != nullptr)
+                numMessages += pLane->size();
+        }
+
+        return numMessages;
+    }
+
+    /**
+     * Get the number of received message priority lanes which have been allocated
+     */
+    inline virtual std::size_t getNumAllocatedPriorityLanes(void) const final
+    {
+        std::size_t numLanes = 0;
+        for (std::size_t i = 0; i < m_numPriorityLanes; ++i)
+            if (getReceivedMessageLane(i) != nullptr)
+                ++numLanes;
+
+        return numLanes;
+    }
+
+    /**
+     * Get the number of received message priority lanes
+     */
+    inline virtual std::size_t getNumPriorityLanes(void) const final
+    {
+        return m_numPriorityLanes;
+    }
+
+    /**
+     * Get the priority lane to which the specified message is assigned
+     */
+    inline virtual std::size_t getPriorityLane(const tMessagePacket *pMessagePacket) const final
+    {
+        auto &&priority = getMessagePriority(pMessagePacket);
+        if (priority < 0)
+            return 0;
+
+        return std::min(std::size_t(priority) + 1, m_numPriorityLanes - 1);
+    }
+
+    /**
+     * Get the priority of the specified message; a null message is treated as having no priority assigned
      */
-    inline virtual std::vector<std::shared_ptr<tMessagePacket>> &getReceivedMessages(void) final
+    inline static int getMessagePriority(const tMessagePacket *pMessagePacket)
     {
-        return m_receivedMessages;
+        return pMessagePacket != nullptr ? pMessagePacket->getPriority() : -1;
     }
 
     /**
@@ -142,29 +274,150 @@ public:
         return true;
     }
 
+    /**
+     * Query whether or not the dispatch thread is running
+     */
+    inline virtual bool isDispatchThreadRunning(void) const final
+    {
+        return m_bDispatching.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Start a background thread which processes received messages and sends queued messages as they arrive;
+     * returns false if the dispatch thread is already running
+     * @param retryInterval the interval at which the dispatch thread re-attempts to process or send messages
+     *                      that could not be processed or sent, and the longest it sleeps between polls
+     */
+    inline virtual bool startDispatchThread(std::chrono::microseconds retryInterval =
+                                            std::chrono::milliseconds(1)) final
+    {
+        bool bSuccess = !m_bDispatching.exchange(true, std::memory_order_acq_rel);
+        if (bSuccess)
+        {
+            m_dispatchThread = std::thread([this, retryInterval] (void) { dispatch(retryInterval); });
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Stop the dispatch thread, if running, and wait for it to finish its current pass
+     */
+    inline virtual void stopDispatchThread(void) final
+    {
+        if (m_bDispatching.exchange(false, std::memory_order_acq_rel))
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_dispatchMutex);
+                m_dispatchCondition.notify_one();
+            }
+
+            m_dispatchThread.join();
+        }
+    }
+
 protected:
 
     /**
-     * Sort messages in order of priority
+     * Dispatch loop executed by the dispatch thread
+     */
+    inline virtual void dispatch(std::chrono::microseconds retryInterval) final
+    {
+        while (m_bDispatching.load(std::memory_order_acquire))
+        {
+            processReceivedMessages();
+            sendMessages();
+
+            std::unique_lock<std::mutex> lock(m_dispatchMutex);
+            m_bDispatcherWaiting.store(true, std::memory_order_relaxed);
+
+            // pairs with the fence in notifyDispatchThread(): either the producer observes that the dispatcher
+            // is waiting, or the dispatcher observes the producer's message
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_bDispatching.load(std::memory_order_acquire) && !hasPendingMessages())
+                m_dispatchCondition.wait_for(lock, retryInterval);
+
+            m_bDispatcherWaiting.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Determine whether or not any received messages or messages queued for send are waiting in this object's
+     * lock-free queues
      */
-    static void prioritizeMessages(std::vector<std::shared_ptr<tMessagePacket>> &messages)
+    inline virtual bool hasPendingMessages(void) const final
+    {
+        if (!m_pSendQueue->empty())
+            return true;
+
+        for (std::size_t i = 0; i < m_numPriorityLanes; ++i)
+        {
+            auto *pLane = getReceivedMessageLane(i);
+            if (pLane != nullptr && !pLane->empty())
+                return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * Wake the dispatch thread, if it is waiting for messages
+     */
+    inline virtual void notifyDispatchThread(void) final
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_bDispatcherWaiting.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(m_dispatchMutex);
+            m_dispatchCondition.notify_one();
+        }
+    }
+
+    /**
+     * Get the specified received message priority lane, or null if no message has yet been received in it
+     */
+    inline tMessageQueue *getReceivedMessageLane(std::size_t lane) const
+    {
+        return m_pReceivedMessageLanes[lane].load(std::memory_order_acquire);
+    }
+
+    /**
+     * Get the specified received message priority lane, allocating it if no message has yet been received in
+     * it; may be called from any thread
+     */
+    inline tMessageQueue *getOrCreateReceivedMessageLane(std::size_t lane)
+    {
+        auto *pLane = getReceivedMessageLane(lane);
+        if (pLane == nullptr)
+        {
+            // if another producer allocates the lane first, the compare-exchange loads its lane into pLane
+            std::unique_ptr<tMessageQueue> pNewLane(new tMessageQueue(m_queueCapacity));
+            if (m_pReceivedMessageLanes[lane].compare_exchange_strong(pLane, pNewLane.get(),
+                                                                      std::memory_order_acq_rel,
+                                                                      std::memory_order_acquire))
+                pLane = pNewLane.release();
+        }
+
+        return pLane;
+    }
+
+    /**
+     * Sort a range of messages in order of decreasing priority, preserving the order of messages of equal
+     * priority
+     */
+    template<typename Iterator>
+    static void prioritizeMessages(Iterator first,
+                                   Iterator last)
     {
         // define the comparator function
         auto &&comparator = [] (auto &&pLeft, auto &&pRight)
                             {
-                                int leftPriority = -1;
-                                if (pLeft != nullptr)
-                                    leftPriority = pLeft->getPriority();
-
-                                int rightPriority = -1;
-                                if (pRight != nullptr)
-                                    rightPriority = pRight->getPriority();
-
-                                return leftPriority > rightPriority;
+                                return getMessagePriority(pLeft.get()) > getMessagePriority(pRight.get());
                             };
 
-        // sort tasks in order of priority
-        std::sort(messages.begin(), messages.end(), comparator);
+        // sort messages in order of priority
+        if (!std::is_sorted(first, last, comparator))
+            std::stable_sort(first, last, comparator);
     }
 
 public:
@@ -175,112 +428,125 @@ public:
     virtual bool processReceivedMessage(tMessagePacket *pMessagePacket) = 0;
 
     /**
-     * Process this object's received messages
-     * @param time the current simulation time
+     * Process this object's received messages in order of priority; messages that cannot be processed remain
+     * queued for processing and are re-attempted on the next call
      */
     virtual bool processReceivedMessages(void)
     {
         bool bSuccess = queueReceivedMessagesForProcessing();
         if (bSuccess)
         {
-            prioritizeMessages(m_messagesQueuedForProcessing);
-
-            auto &&itMessagePacket = m_messagesQueuedForProcessing.begin();
-            while (itMessagePacket != m_messagesQueuedForProcessing.end())
+            // compact the messages which were not processed towards the front, preserving their order
+            std::size_t numRetained = 0;
+            for (std::size_t i = 0; i < m_messagesQueuedForProcessing.size(); ++i)
             {
-                auto pMessagePacket = *itMessagePacket;
-                bSuccess = (pMessagePacket != nullptr);
-                if (bSuccess)
-                {
-                    bool bProcessed = processReceivedMessage(pMessagePacket.get());
-                    if (bProcessed)
-                    {
-                        // remove message from this object's vector of messages queued for processing
-                        itMessagePacket = m_messagesQueuedForProcessing.erase(itMessagePacket);
-
-                        continue;
-                    }
-                }
-
-                ++itMessagePacket;
+                auto &&pMessagePacket = m_messagesQueuedForProcessing[i];
+                if (pMessagePacket != nullptr && processReceivedMessage(pMessagePacket.get()))
+                    continue;
+
+                if (numRetained != i)
+                    m_messagesQueuedForProcessing[numRetained] = std::move(pMessagePacket);
+
+                ++numRetained;
             }
+
+            m_messagesQueuedForProcessing.resize(numRetained);
         }
 
         return bSuccess;
     }
 
     /**
-     * Function to queue a message for processing
+     * Function to queue a message for processing, ahead of messages of lower priority and behind messages of
+     * equal or higher priority
      */
     virtual bool queueMessageForProcessing(std::shared_ptr<tMessagePacket> pMessagePacket)
     {
         bool bSuccess = (pMessagePacket != nullptr);
         if (bSuccess)
         {
-            m_messagesQueuedForProcessing.push_back(pMessagePacket);
+            auto &&priority = getMessagePriority(pMessagePacket.get());
+            auto &&itMessagePacket = std::upper_bound(m_messagesQueuedForProcessing.begin(),
+                                                      m_messagesQueuedForProcessing.end(), priority,
+                                                      [] (int priority, auto &&pQueuedMessagePacket)
+                                                      {
+                                                          return priority >
+                                                                 getMessagePriority(pQueuedMessagePacket.get());
+                                                      });
+
+            m_messagesQueuedForProcessing.insert(itMessagePacket, std::move(pMessagePacket));
         }
 
         return bSuccess;
     }
 
     /**
-     * Function to queue a message for send
+     * Function to queue a message for send; may be called from any thread. Returns false if the message is null
+     * or the send queue is full
      */
     virtual bool queueMessageForSend(std::shared_ptr<tMessagePacket> pMessagePacket)
     {
         bool bSuccess = (pMessagePacket != nullptr);
         if (bSuccess)
         {
-            m_messagesQueuedForSend.push_back(pMessagePacket);
+            bSuccess = m_pSendQueue->push(std::move(pMessagePacket));
+            if (bSuccess)
+                notifyDispatchThread();
         }
 
         return bSuccess;
     }
 
     /**
-     * Function to queue received messages for processing
+     * Function to queue received messages for processing; the received messages, which are drained from the
+     * priority lanes already in order of priority, are merged with any messages retained from a previous pass in
+     * linear time
      */
     virtual bool queueReceivedMessagesForProcessing(void)
     {
-        bool bSuccess = true; // assume success
-        auto &&itMessagePacket = m_receivedMessages.begin();
-        while (itMessagePacket != m_receivedMessages.end())
+        m_drainedMessages.clear();
+        if (drainReceivedMessages(m_drainedMessages) > 0)
         {
-            auto pMessagePacket = *itMessagePacket;
-            bSuccess = (pMessagePacket != nullptr);
-            if (bSuccess)
+            auto &&comparator = [] (auto &&pLeft, auto &&pRight)
+                                {
+                                    return getMessagePriority(pLeft.get()) > getMessagePriority(pRight.get());
+                                };
+
+            if (m_messagesQueuedForProcessing.empty())
+                m_messagesQueuedForProcessing.swap(m_drainedMessages);
+            else
             {
-                bool bMessageQueuedForProcessing = queueMessageForProcessing(pMessagePacket);
-                if (bMessageQueuedForProcessing)
-                {
-                    itMessagePacket = m_receivedMessages.erase(itMessagePacket);
-
-                    continue;
-                }
+                // std::merge() is stable, so retained messages stay ahead of new messages of equal priority
+                m_mergedMessages.clear();
+                m_mergedMessages.reserve(m_messagesQueuedForProcessing.size() + m_drainedMessages.size());
+                std::merge(std::make_move_iterator(m_messagesQueuedForProcessing.begin()),
+                           std::make_move_iterator(m_messagesQueuedForProcessing.end()),
+                           std::make_move_iterator(m_drainedMessages.begin()),
+                           std::make_move_iterator(m_drainedMessages.end()),
+                           std::back_inserter(m_mergedMessages), comparator);
+                m_messagesQueuedForProcessing.swap(m_mergedMessages);
+                m_mergedMessages.clear();
             }
 
-            ++itMessagePacket;
+            m_drainedMessages.clear();
         }
 
-        return bSuccess;
+        return true;
     }
 
     /**
-     * Function to receive a message
+     * Function to receive a message; may be called from any thread. Returns false if the message is null or
+     * its priority lane is full
      */
     virtual bool receiveMessage(std::shared_ptr<tMessagePacket> pMessagePacket)
     {
         bool bSuccess = (pMessagePacket != nullptr);
         if (bSuccess)
         {
-            auto &&itMessagePacket = std::find(m_receivedMessages.cbegin(),
-                                               m_receivedMessages.cend(),
-                                               pMessagePacket);
-            bSuccess = (itMessagePacket == m_receivedMessages.cend());
+            auto &&lane = getPriorityLane(pMessagePacket.get());
+            bSuccess = getOrCreateReceivedMessageLane(lane)->push(std::move(pMessagePacket));
             if (bSuccess)
-            {
-                m_receivedMessages.push_back(pMessagePacket);
-            }
+                notifyDispatchThread();
         }
 
         return bSuccess;
@@ -292,50 +558,102 @@ public:
     virtual bool sendMessage(std::shared_ptr<tMessagePacket> pMessagePacket) = 0;
 
     /**
-     * Function to send outgoing messages according to availability
-     * @param time the current simulation time
+     * Function to send outgoing messages according to availability; messages that cannot be sent remain queued
+     * and are re-attempted, in their original order, on the next call
      */
     virtual bool sendMessages(void)
     {
-        bool bSuccess = true; // assume success
-        auto &&itMessagePacket = m_messagesQueuedForSend.begin();
-        while (bSuccess && itMessagePacket != m_messagesQueuedForSend.end())
+        auto &&numMessages = m_pSendQueue->size();
+        m_pSendQueue->drain([this] (std::shared_ptr<tMessagePacket> &&pMessagePacket)
+                            { m_messagesQueuedForSend.push_back(std::move(pMessagePacket)); }, numMessages);
+
+        std::size_t numRetained = 0;
+        for (std::size_t i = 0; i < m_messagesQueuedForSend.size(); ++i)
         {
-            auto pMessagePacket = *itMessagePacket;
-            bSuccess = (pMessagePacket != nullptr);
-            if (bSuccess)
-            {
-                bool bMessageSent = sendMessage(pMessagePacket);
-                if (bMessageSent)
-                {
-                    itMessagePacket = m_messagesQueuedForSend.erase(itMessagePacket);
+            auto &&pMessagePacket = m_messagesQueuedForSend[i];
+            if (pMessagePacket != nullptr && sendMessage(pMessagePacket))
+                continue;
 
-                    continue;
-                }
-            }
+            if (numRetained != i)
+                m_messagesQueuedForSend[numRetained] = std::move(pMessagePacket);
 
-            ++itMessagePacket;
+            ++numRetained;
         }
 
-        return bSuccess;
+        m_messagesQueuedForSend.resize(numRetained);
+
+        return true;
     }
 
+private:
+
+    /**
+     * flag indicating whether or not the dispatch thread is waiting for messages
+     */
+    std::atomic<bool> m_bDispatcherWaiting;
+
+    /**
+     * flag indicating whether or not the dispatch thread is running
+     */
+    std::atomic<bool> m_bDispatching;
+
+    /**
+     * condition variable used to wake the dispatch thread
+     */
+    std::condition_variable m_dispatchCondition;
+
+    /**
+     * mutex associated with the dispatch condition variable
+     */
+    std::mutex m_dispatchMutex;
+
+    /**
+     * the dispatch thread
+     */
+    std::thread m_dispatchThread;
+
+    /**
+     * scratch vector of messages drained from the priority lanes
+     */
+    std::vector<std::shared_ptr<tMessagePacket>> m_drainedMessages;
+
+    /**
+     * scratch vector used to merge drained messages with retained messages
+     */
+    std::vector<std::shared_ptr<tMessagePacket>> m_mergedMessages;
+
+    /**
+     * the number of received message priority lanes
+     */
+    const std::size_t m_numPriorityLanes;
+
+    /**
+     * the capacity of each of this object's received message lanes
+     */
+    const std::size_t m_queueCapacity;
+
 protected:
 
     /**
-     * this object's vector of messages queued for processing
+     * this object's vector of messages queued for processing, in order of decreasing priority
      */
     std::vector<std::shared_ptr<tMessagePacket>> m_messagesQueuedForProcessing;
 
     /**
-     * this object's vector of messages queued for send
+     * this object's vector of messages removed from the send queue but not yet sent
      */
     std::vector<std::shared_ptr<tMessagePacket>> m_messagesQueuedForSend;
 
     /**
-     * this object's queue of received messages
+     * this object's send queue
+     */
+    std::unique_ptr<tMessageQueue> m_pSendQueue;
+
+    /**
+     * this object's received message priority lanes, in order of increasing priority; each is null until the
+     * first message is received in it
      */
-    std::vector<std::shared_ptr<tMessagePacket>> m_receivedMessages;
+    std::unique_ptr<std::atomic<tMessageQueue *>[]> m_pReceivedMessageLanes;
 };
 
 }
@@ -123,11 +123,11 @@ public:
            Message &&message,
            Messages && ... messages)
     {
+        // the messages are passed as lvalues so that each recipient receives its own copy
         bool bSuccess = true;
         for (auto &&recipient : recipients)
         {
-            bSuccess = notify(recipient, std::forward<Message>(message),
-                                         std::forward<Messages>(messages) ...);
+            bSuccess = notify(recipient, message, messages ...);
             if (!bSuccess)
                 break;
         }
@@ -150,8 +150,17 @@ public:
            Message &&message,
            Messages && ... messages)
     {
-        return notify(recipient, { functional::Any(message),
-                                   functional::Any(messages) ... });
+        // construct the Any objects in place (rather than copying them from an initializer list) so that small
+        // messages do not allocate and rvalue messages are moved rather than copied
+        std::vector<functional::Any> anys;
+        anys.reserve(1 + sizeof ... (Messages));
+        anys.emplace_back(std::forward<Message>(message));
+        int dummy[] = { 0, ((void)anys.emplace_back(std::forward<Messages>(messages)), 0) ... };
+
+        // silence unused variable warnings...
+        (void)(dummy);
+
+        return notify(recipient, anys);
     }
 
     /**
@@ -0,0 +1,1041 @@
+#include "concurrentDownloader.h"
+#include "connectionPool.h"
+#include "downloaderPreferences.h"
+#include "httpHeaders.h"
+#include "socket.h"
+#include "URL.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#if defined (__linux__)
+#define EPOLL
+#endif
+
+#ifdef EPOLL
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// using namespace declarations
+using namespace networking::sockets;
+using namespace utilities;
+
+namespace networking
+{
+
+/**
+ * the largest block of response headers accepted from a server, in bytes
+ */
+static constexpr std::size_t MAXIMUM_HEADER_SIZE = 1 << 20;
+
+/**
+ * the maximum number of events retrieved from the event loop per wait
+ */
+static constexpr int MAXIMUM_EVENTS = 64;
+
+/**
+ * the largest number of bytes reserved up front for a response body of advertised length; longer bodies grow
+ * as they are received, so that a bogus Content-Length cannot force a huge allocation
+ */
+static constexpr std::size_t MAXIMUM_RESERVED_BODY_SIZE = 1 << 24;
+
+/**
+ * Enumerations
+ */
+enum class ResponseStage { Headers, Body, ChunkSize, ChunkData, ChunkTerminator, Trailers, UntilClose };
+
+/**
+ * This structure holds the requests destined for a server which have not yet been sent, along with the state
+ * of the connections opened to the server
+ */
+struct Server
+{
+    /**
+     * the number of connections to the server
+     */
+    std::size_t m_numConnections;
+
+    /**
+     * the number of connections to the server which are still being established
+     */
+    std::size_t m_numConnecting;
+
+    /**
+     * the number of consecutive failed attempts to connect to the server
+     */
+    std::size_t m_numConnectFailures;
+
+    /**
+     * the indices of the requests which have not yet been sent
+     */
+    std::deque<std::size_t> m_requests;
+
+    /**
+     * the time before which no further connection to the server is to be attempted
+     */
+    std::chrono::steady_clock::time_point m_retryTime;
+
+    /**
+     * a web address on the server, used to establish connections
+     */
+    std::string m_url;
+};
+
+/**
+ * This structure holds the state of a connection serviced by the event loop, including the requests sent on
+ * the connection whose responses are awaited, in the order in which they were sent
+ */
+struct Connection
+{
+    /**
+     * flag indicating that the connection is to be closed once the current response is complete
+     */
+    bool m_bClose;
+
+    /**
+     * flag indicating that the connection has been closed and is awaiting removal
+     */
+    bool m_bClosed;
+
+    /**
+     * flag indicating that a non-blocking connect is in progress
+     */
+    bool m_bConnecting;
+
+    /**
+     * flag indicating that the connection was taken from the pool, rather than newly established
+     */
+    bool m_bReused;
+
+    /**
+     * flag indicating that the connection is waiting for its socket to become writable, in order to write the
+     * remainder of its output
+     */
+    bool m_bWaitingToWrite;
+
+    /**
+     * the headers of the response currently being received
+     */
+    HttpHeaders m_headers;
+
+    /**
+     * the time at which data was last sent or received on the connection
+     */
+    std::chrono::steady_clock::time_point m_lastActivity;
+
+    /**
+     * the number of bytes remaining in the current response body or chunk
+     */
+    std::size_t m_numBytesRemaining;
+
+    /**
+     * the number of bytes of the output which have been written to the socket
+     */
+    std::size_t m_numBytesWritten;
+
+    /**
+     * the number of responses completed on the connection
+     */
+    std::size_t m_numResponses;
+
+    /**
+     * the pipelined requests queued on the connection, which are written as the socket accepts them
+     */
+    std::string m_output;
+
+    /**
+     * the server to which the connection is made
+     */
+    Server *m_pServer;
+
+    /**
+     * the socket
+     */
+    Socket *m_pSocket;
+
+    /**
+     * the indices of the requests sent on the connection whose responses are awaited
+     */
+    std::deque<std::size_t> m_requests;
+
+    /**
+     * the stage reached in parsing the current response
+     */
+    ResponseStage m_stage;
+
+    /**
+     * the status code of the current response
+     */
+    int m_statusCode;
+};
+
+/**
+ * Function to determine whether a comma-separated header value contains the specified (lower-case) token
+ */
+static bool containsToken(const HttpHeaders &headers,
+                          const std::string &field,
+                          const std::string &token)
+{
+    auto *pValues = headers.get(field);
+    if (pValues != nullptr)
+    {
+        for (auto &&value : *pValues)
+        {
+            std::string lowerCaseValue(value);
+            std::transform(lowerCaseValue.begin(), lowerCaseValue.end(), lowerCaseValue.begin(), ::tolower);
+            if (lowerCaseValue.find(token) != std::string::npos)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Function to parse the responses awaited on a connection from the data held in its socket's read buffer,
+ * appending response bodies by length to the data buffers of their requests and consuming the parsed bytes;
+ * returns false if a malformed response is encountered. Parsing stops once a response completes after which
+ * the server closes the connection
+ * @param connection           the connection
+ * @param data                 the data buffers of the requests
+ * @param statusCodes          the status codes of the requests, set upon completion of their responses
+ * @param pResponseHeaders     a pointer to an HttpHeaders container, which upon completion of each response is
+ *                             populated with its headers
+ * @param numCompletedRequests upon return, incremented by the number of responses completed
+ */
+static bool parseResponses(Connection &connection,
+                           std::vector<std::string> &data,
+                           std::vector<int> &statusCodes,
+                           HttpHeaders *pResponseHeaders,
+                           std::size_t &numCompletedRequests)
+{
+    auto *pSocket = connection.m_pSocket;
+    auto &&numBufferedBytes = pSocket->getNumBufferedBytes();
+    std::string_view buffer;
+    if (numBufferedBytes == 0 || pSocket->peekBuffered(buffer, numBufferedBytes) <= 0)
+        return true;
+
+    bool bParsing = true, bSuccess = true;
+    std::size_t offset = 0;
+    while (bParsing && !connection.m_requests.empty() && offset < buffer.size())
+    {
+        bool bComplete = false;
+        auto index = connection.m_requests.front();
+        auto &&output = data[index];
+        auto &&unparsed = buffer.substr(offset);
+        switch (connection.m_stage)
+        {
+            case ResponseStage::Headers:
+            {
+                auto &&headersEnd = unparsed.find("\r\n\r\n");
+                if (headersEnd == std::string_view::npos)
+                {
+                    bSuccess = (unparsed.size() <= MAXIMUM_HEADER_SIZE);
+                    bParsing = false;
+                    break;
+                }
+
+                // the status line has the form HTTP/<version> <status code> <reason phrase>
+                auto &&statusLineEnd = unparsed.find("\r\n");
+                auto &&statusLine = unparsed.substr(0, statusLineEnd);
+                auto &&versionEnd = statusLine.find(' ');
+                bSuccess = (statusLine.compare(0, 5, "HTTP/") == 0 && versionEnd != std::string_view::npos &&
+                            statusLine.size() >= versionEnd + 4);
+                for (std::size_t i = versionEnd + 1; bSuccess && i < versionEnd + 4; ++i)
+                    bSuccess = (statusLine[i] >= '0' && statusLine[i] <= '9');
+
+                if (!bSuccess)
+                {
+                    bParsing = false;
+                    break;
+                }
+
+                int statusCode = 0;
+                for (std::size_t i = versionEnd + 1; i < versionEnd + 4; ++i)
+                    statusCode = 10 * statusCode + (statusLine[i] - '0');
+
+                std::istringstream iss(std::string(unparsed.substr(statusLineEnd + 2, headersEnd - statusLineEnd)));
+                connection.m_headers.extract(iss);
+                offset += headersEnd + 4;
+
+                // interim (1xx) responses precede the final response to the same request
+                if (statusCode >= 100 && statusCode < 200)
+                    break;
+
+                auto &&version = statusLine.substr(5, versionEnd - 5);
+                connection.m_bClose = containsToken(connection.m_headers, "Connection", "close") ||
+                                      (version == "1.0" && !connection.m_headers.keepAliveSupported());
+                connection.m_statusCode = statusCode;
+                output.clear();
+
+                auto &&contentLength = connection.m_headers.getContentLength();
+                if (containsToken(connection.m_headers, "Transfer-Encoding", "chunked"))
+                    connection.m_stage = ResponseStage::ChunkSize;
+                else if (statusCode == 204 || statusCode == 304 || contentLength == 0)
+                    bComplete = true;
+                else if (contentLength > 0)
+                {
+                    // the body is appended into a buffer allocated once for its full length, up to a cap
+                    output.reserve(std::min(std::size_t(contentLength), MAXIMUM_RESERVED_BODY_SIZE));
+                    connection.m_numBytesRemaining = std::size_t(contentLength);
+                    connection.m_stage = ResponseStage::Body;
+                }
+                else
+                {
+                    // the body is delimited by the server closing the connection
+                    connection.m_bClose = true;
+                    connection.m_stage = ResponseStage::UntilClose;
+                }
+
+                break;
+            }
+
+            case ResponseStage::Body:
+            case ResponseStage::ChunkData:
+            {
+                auto numBytes = std::min(connection.m_numBytesRemaining, unparsed.size());
+                output.append(unparsed.data(), numBytes);
+                offset += numBytes;
+                connection.m_numBytesRemaining -= numBytes;
+                if (connection.m_numBytesRemaining == 0)
+                {
+                    if (connection.m_stage == ResponseStage::Body)
+                        bComplete = true;
+                    else
+                        connection.m_stage = ResponseStage::ChunkTerminator;
+                }
+
+                break;
+            }
+
+            case ResponseStage::ChunkSize:
+            {
+                // the hexadecimal chunk size may be followed by chunk extensions
+                auto &&lineEnd = unparsed.find("\r\n");
+                if (lineEnd == std::string_view::npos)
+                {
+                    bParsing = false;
+                    break;
+                }
+
+                auto &&line = unparsed.substr(0, lineEnd);
+                auto numDigits = std::min(line.find_first_not_of("ABCDEFabcdef0123456789"), line.size());
+                bSuccess = (numDigits > 0 && numDigits <= 2 * sizeof(std::size_t));
+                if (!bSuccess)
+                {
+                    bParsing = false;
+                    break;
+                }
+
+                std::size_t chunkSize = 0;
+                for (std::size_t i = 0; i < numDigits; ++i)
+                {
+                    auto &&digit = line[i];
+                    chunkSize = 16 * chunkSize + std::size_t(digit <= '9' ? digit - '0' : (digit | 0x20) - 'a' + 10);
+                }
+
+                offset += lineEnd + 2;
+                connection.m_numBytesRemaining = chunkSize;
+                connection.m_stage = (chunkSize > 0 ? ResponseStage::ChunkData : ResponseStage::Trailers);
+                break;
+            }
+
+            case ResponseStage::ChunkTerminator:
+            if (unparsed.size() < 2)
+                bParsing = false;
+            else
+            {
+                bSuccess = (unparsed.compare(0, 2, "\r\n") == 0);
+                bParsing = bSuccess;
+                offset += 2;
+                connection.m_stage = ResponseStage::ChunkSize;
+            }
+
+            break;
+
+            case ResponseStage::Trailers:
+            {
+                // trailer fields, if any, are discarded up to the empty line which ends the response
+                auto &&lineEnd = unparsed.find("\r\n");
+                if (lineEnd == std::string_view::npos)
+                    bParsing = false;
+                else
+                {
+                    offset += lineEnd + 2;
+                    bComplete = (lineEnd == 0);
+                }
+
+                break;
+            }
+
+            case ResponseStage::UntilClose:
+            output.append(unparsed.data(), unparsed.size());
+            offset += unparsed.size();
+            break;
+        }
+
+        if (bComplete)
+        {
+            statusCodes[index] = connection.m_statusCode;
+            connection.m_requests.pop_front();
+            connection.m_stage = ResponseStage::Headers;
+            ++connection.m_numResponses;
+            ++numCompletedRequests;
+            if (pResponseHeaders != nullptr)
+                *pResponseHeaders = connection.m_headers;
+
+            // any data following a response after which the server closes the connection is ignored
+            bParsing = !connection.m_bClose;
+        }
+    }
+
+    if (offset > 0)
+        pSocket->readBuffered(buffer, offset);
+
+    return bSuccess;
+}
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ * @param url          the web address from which the resource(s) will be downloaded
+ */
+ConcurrentDownloader::ConcurrentDownloader(const tDependencies &dependencies,
+                                           const std::string &url)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  Downloader(dependencies, url),
+  m_maxConnectionsPerHost(6),
+  m_pConnectionPool(new ConnectionPool),
+  m_pipelineDepth(8)
+{
+
+}
+
+/**
+ * Copy constructor
+ */
+ConcurrentDownloader::ConcurrentDownloader(const ConcurrentDownloader &downloader)
+: DependencyInjectableVirtualBaseInitializer(1, downloader),
+  Downloader(downloader),
+  m_pConnectionPool(nullptr)
+{
+    operator = (downloader);
+}
+
+/**
+ * Move constructor
+ */
+ConcurrentDownloader::ConcurrentDownloader(ConcurrentDownloader &&downloader)
+: DependencyInjectableVirtualBaseInitializer(1, std::move(downloader)),
+  Downloader(std::move(downloader)),
+  m_pConnectionPool(nullptr)
+{
+    operator = (std::move(downloader));
+}
+
+/**
+ * Destructor
+ */
+ConcurrentDownloader::~ConcurrentDownloader(void)
+{
+    if (m_pConnectionPool != nullptr)
+        delete m_pConnectionPool;
+}
+
+/**
+ * Copy assignment operator
+ */
+ConcurrentDownloader &ConcurrentDownloader::operator = (const ConcurrentDownloader &downloader)
+{
+    if (&downloader != this)
+    {
+        Downloader::operator = (downloader);
+
+        m_maxConnectionsPerHost = downloader.m_maxConnectionsPerHost;
+
+        // do not share pooled connections, just start with an empty pool
+        if (m_pConnectionPool == nullptr)
+            m_pConnectionPool = new ConnectionPool(downloader.m_pConnectionPool != nullptr ?
+                                                   downloader.m_pConnectionPool->getMaximumIdleConnectionsPerHost() :
+                                                   8);
+
+        m_pipelineDepth = downloader.m_pipelineDepth;
+    }
+
+    return *this;
+}
+
+/**
+ * Move assignment operator
+ */
+ConcurrentDownloader &ConcurrentDownloader::operator = (ConcurrentDownloader &&downloader)
+{
+    if (&downloader != this)
+    {
+        Downloader::operator = (std::move(downloader));
+
+        m_maxConnectionsPerHost = std::move(downloader.m_maxConnectionsPerHost);
+
+        if (m_pConnectionPool != nullptr)
+        {
+            delete m_pConnectionPool;
+            m_pConnectionPool = nullptr;
+        }
+
+        m_pConnectionPool = std::move(downloader.m_pConnectionPool);
+        downloader.m_pConnectionPool = nullptr;
+
+        m_pipelineDepth = std::move(downloader.m_pipelineDepth);
+    }
+
+    return *this;
+}
+
+/**
+ * clone() function
+ */
+ConcurrentDownloader *ConcurrentDownloader::clone(void) const
+{
+    auto *pDownloader = new ConcurrentDownloader(*this);
+    if (pDownloader != nullptr)
+        pDownloader->setup();
+
+    return pDownloader;
+}
+
+/**
+ * create() function
+ * @param dependencies a tuple of this object's required injection dependencies
+ * @param url          the web address from which the resource(s) will be downloaded
+ */
+ConcurrentDownloader *ConcurrentDownloader::create(const tDependencies &dependencies,
+                                                   const std::string &url)
+{
+    ConcurrentDownloader *pDownloader = nullptr;
+    if (ConcurrentDownloader::dependenciesInitialized(dependencies))
+    {
+        pDownloader = new ConcurrentDownloader(dependencies, url);
+        pDownloader->setup();
+    }
+
+    return pDownloader;
+}
+
+/**
+ * Function to download data from the server at this object's web address, using a pooled connection. Function
+ * returns true if data was successfully read from the server
+ * @param data an std::string that will be populated with bytes read from the server.
+ */
+bool ConcurrentDownloader::download(std::string &data)
+{
+    bool bSuccess = (m_pURL != nullptr);
+    if (bSuccess)
+    {
+        std::vector<std::string> buffers(1);
+        bSuccess = download({ m_pURL->getURL() }, buffers);
+        data = std::move(buffers[0]);
+    }
+
+    return bSuccess;
+}
+
+/**
+ * Function to download the resources at the specified web addresses concurrently. Function returns true if
+ * every resource was received in a response having a successful (2xx) status code
+ * @param urls a vector of web addresses from which the resources will be downloaded
+ * @param data a vector that will be populated with the bytes read for each web address (resized if necessary);
+ *             the body of an unsuccessful response is retained, while the entry for a resource which could not
+ *             be retrieved is left empty
+ */
+bool ConcurrentDownloader::download(const std::vector<std::string> &urls,
+                                    std::vector<std::string> &data)
+{
+    auto *pDownloaderPreferences = getDependency<DownloaderPreferences *>();
+    bool bSuccess = (pDownloaderPreferences != nullptr && m_pConnectionPool != nullptr);
+    if (!bSuccess)
+        return bSuccess;
+
+    auto &&numRequests = urls.size();
+    data.resize(numRequests);
+    for (auto &&buffer : data)
+        buffer.clear();
+
+    // a status code of zero indicates a request in progress, while a negative value indicates a failed request
+    std::vector<int> statusCodes(numRequests, 0);
+#ifdef EPOLL
+    auto &&bKeepSocketConnectionAlive = pDownloaderPreferences->keepSocketConnectionAlive();
+    auto &&connectRetryTimeout = pDownloaderPreferences->getConnectRetryTimeout();
+    auto maxConnectRetryAttempts = std::max<std::size_t>(1,
+                                                         pDownloaderPreferences->getMaximumConnectRetryAttempts());
+    auto &&maxRecvRetryAttempts = pDownloaderPreferences->getMaximumReceiveRetryAttempts();
+    auto &&receiveBufferSize = pDownloaderPreferences->getReceiveBufferSize();
+    auto &&receiveTimeout = std::chrono::milliseconds(pDownloaderPreferences->getServerReceiveTimeout());
+    auto &&methodName = getQualifiedMethodName(__func__);
+
+    // build the requests and group them by server
+    if (bKeepSocketConnectionAlive && m_pHttpRequestHeaders != nullptr)
+        m_pHttpRequestHeaders->addEntry("Connection", "keep-alive");
+
+    std::vector<std::size_t> numAttempts(numRequests, 0);
+    std::vector<std::string> requests(numRequests);
+    std::map<std::string, Server> servers;
+    for (std::size_t i = 0; i < numRequests; ++i)
+    {
+        URL url(urls[i]);
+        requests[i] = getHttpRequest(url);
+        auto &&server = servers[ConnectionPool::getKey(url)];
+        if (server.m_requests.empty())
+        {
+            server.m_numConnections = 0;
+            server.m_numConnecting = 0;
+            server.m_numConnectFailures = 0;
+            server.m_url = urls[i];
+        }
+
+        server.m_requests.push_back(i);
+    }
+
+    int epollDescriptor = epoll_create1(EPOLL_CLOEXEC);
+    if (epollDescriptor < 0)
+    {
+        lock("std_out_mutex");
+        perror(("Warning from " + methodName).c_str());
+        unlock("std_out_mutex");
+
+        return false;
+    }
+
+    std::list<Connection> connections;
+    std::size_t numOutstandingRequests = numRequests;
+
+    // function to mark a request as failed
+    auto &&fail = [&] (std::size_t index, const std::string &reason)
+    {
+        data[index].clear();
+        statusCodes[index] = -1;
+        --numOutstandingRequests;
+
+        lock("std_out_mutex");
+        logMsg("warning", LoggingLevel::Enum::Warning,
+               "Request for \"" + urls[index] + "\" failed: " + reason + ".\n",
+               methodName);
+        unlock("std_out_mutex");
+    };
+
+    // function to record a failed attempt to connect to a server; further attempts are deferred by the connect
+    // retry timeout rather than by sleeping, so that the other connections continue to be serviced
+    auto &&failConnect = [&] (Server &server)
+    {
+        ++server.m_numConnectFailures;
+        server.m_retryTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(connectRetryTimeout);
+
+        lock("std_out_mutex");
+        logMsg("warning", LoggingLevel::Enum::Warning,
+               "Connection attempt # " + std::to_string(server.m_numConnectFailures) + " of " +
+               std::to_string(maxConnectRetryAttempts) + " to " + server.m_url + " failed.\n",
+               methodName);
+        unlock("std_out_mutex");
+    };
+
+    // function to close a connection, returning the requests awaiting responses to the front of the server's
+    // queue (in their original order) and the socket to the pool, which retains it if it is reusable
+    auto &&close = [&] (Connection &connection, bool bReusable)
+    {
+        auto *pServer = connection.m_pServer;
+        auto *pSocket = connection.m_pSocket;
+        if (pSocket->initialized())
+            epoll_ctl(epollDescriptor, EPOLL_CTL_DEL, int(pSocket->getSocketFileDescriptor()), nullptr);
+
+        pServer->m_requests.insert(pServer->m_requests.begin(), connection.m_requests.cbegin(),
+                                   connection.m_requests.cend());
+        if (!bReusable || !bKeepSocketConnectionAlive || connection.m_bClose || connection.m_bConnecting ||
+            !connection.m_requests.empty())
+            pSocket->disconnect();
+
+        m_pConnectionPool->release(pSocket);
+        connection.m_bClosed = true;
+        connection.m_requests.clear();
+        --pServer->m_numConnections;
+        if (connection.m_bConnecting)
+            --pServer->m_numConnecting;
+    };
+
+    // function to write as much of a connection's output as its socket accepts without waiting; while output
+    // remains, the connection also waits for the socket to become writable. Returns false upon error
+    auto &&flush = [&] (Connection &connection)
+    {
+        while (connection.m_numBytesWritten < connection.m_output.size())
+        {
+            auto &&result = connection.m_pSocket->write(connection.m_output.data() + connection.m_numBytesWritten,
+                                                        connection.m_output.size() - connection.m_numBytesWritten);
+            if (result < 0)
+                return false;
+            else if (result == 0)
+                break;
+
+            connection.m_numBytesWritten += std::size_t(result);
+        }
+
+        bool bWaitingToWrite = (connection.m_numBytesWritten < connection.m_output.size());
+        if (!bWaitingToWrite)
+        {
+            connection.m_numBytesWritten = 0;
+            connection.m_output.clear();
+        }
+
+        if (bWaitingToWrite != connection.m_bWaitingToWrite)
+        {
+            epoll_event event = {};
+            event.events = (bWaitingToWrite ? EPOLLIN | EPOLLOUT : EPOLLIN);
+            event.data.ptr = &connection;
+            if (epoll_ctl(epollDescriptor, EPOLL_CTL_MOD, int(connection.m_pSocket->getSocketFileDescriptor()),
+                          &event) != 0)
+                return false;
+
+            connection.m_bWaitingToWrite = bWaitingToWrite;
+        }
+
+        return true;
+    };
+
+    // function to handle a connection which was closed by the server or failed before its awaited responses
+    // were complete. A body delimited by the connection's closure is complete, and requests which had not yet
+    // been answered are resent on another connection. The request being answered is charged with a failed
+    // attempt, unless the connection was closed between responses after having answered a request (or, for a
+    // reused connection, before answering any), as servers may close idle or long-lived connections
+    auto &&abort = [&] (Connection &connection, const std::string &reason)
+    {
+        auto *pSocket = connection.m_pSocket;
+        if (!connection.m_requests.empty())
+        {
+            auto index = connection.m_requests.front();
+            if (connection.m_stage == ResponseStage::UntilClose && !pSocket->initialized())
+            {
+                statusCodes[index] = connection.m_statusCode;
+                --numOutstandingRequests;
+                connection.m_requests.pop_front();
+            }
+            else if (connection.m_stage != ResponseStage::Headers || pSocket->getNumBufferedBytes() > 0 ||
+                     (connection.m_numResponses == 0 && !connection.m_bReused))
+            {
+                data[index].clear();
+                if (++numAttempts[index] > maxRecvRetryAttempts)
+                {
+                    connection.m_requests.pop_front();
+                    fail(index, reason);
+                }
+            }
+        }
+
+        close(connection, false);
+    };
+
+    while (bSuccess && numOutstandingRequests > 0)
+    {
+        auto &&now = std::chrono::steady_clock::now();
+
+        // send requests on the established connections with room in their pipelines, and retire connections
+        // that are no longer needed
+        for (auto &&connection : connections)
+        {
+            auto *pServer = connection.m_pServer;
+            if (connection.m_bClosed || connection.m_bConnecting || connection.m_bClose)
+                continue;
+            else if (connection.m_requests.empty() && pServer->m_requests.empty())
+            {
+                close(connection, true);
+                continue;
+            }
+
+            // pipelined requests are queued together and written without waiting; the remainder of a batch
+            // which the socket does not accept is written as the socket becomes writable, and the batch is not
+            // extended until it has been written in full
+            if (!connection.m_output.empty())
+                continue;
+
+            while (connection.m_requests.size() < m_pipelineDepth && !pServer->m_requests.empty())
+            {
+                auto &&index = pServer->m_requests.front();
+                connection.m_output += requests[index];
+                connection.m_requests.push_back(index);
+                pServer->m_requests.pop_front();
+            }
+
+            if (!connection.m_output.empty())
+            {
+                connection.m_lastActivity = now;
+                if (!flush(connection))
+                    abort(connection, "error sending request");
+            }
+        }
+
+        // open connections to servers whose unsent requests exceed what their pending connections will take
+        for (auto &&entry : servers)
+        {
+            auto &&server = entry.second;
+            if (server.m_numConnectFailures >= maxConnectRetryAttempts && server.m_numConnections == 0)
+            {
+                while (!server.m_requests.empty())
+                {
+                    fail(server.m_requests.front(), "unable to connect");
+                    server.m_requests.pop_front();
+                }
+            }
+
+            // connections still being established, or opened during this pass, have yet to take their requests
+            std::size_t numUnloadedConnections = server.m_numConnecting;
+            while (!server.m_requests.empty() && server.m_numConnections < m_maxConnectionsPerHost &&
+                   server.m_requests.size() > numUnloadedConnections * m_pipelineDepth &&
+                   server.m_numConnectFailures < maxConnectRetryAttempts && now >= server.m_retryTime)
+            {
+                auto *pSocket = m_pConnectionPool->acquire(URL(server.m_url));
+                if (pSocket == nullptr)
+                {
+                    while (!server.m_requests.empty())
+                    {
+                        fail(server.m_requests.front(), "unsupported scheme");
+                        server.m_requests.pop_front();
+                    }
+
+                    break;
+                }
+
+                // plain connections are established without blocking; secure connections complete their
+                // handshake upon connecting, and only then switch to non-blocking mode
+                bool bReused = pSocket->initialized(), bConnecting = false, bConnected = bReused;
+                if (!bConnected && pSocket->initialize())
+                {
+                    bConnecting = (pSocket->getFactoryName() == "http");
+                    if (bConnecting)
+                        pSocket->blockingEnabled(false);
+
+                    bConnected = pSocket->connect();
+                    if (bConnected)
+                        pSocket->blockingEnabled(false);
+                }
+
+                if (bConnected)
+                {
+                    connections.emplace_back();
+                    auto &&connection = connections.back();
+                    connection.m_bClose = false;
+                    connection.m_bClosed = false;
+                    connection.m_bConnecting = bConnecting;
+                    connection.m_bReused = bReused;
+                    connection.m_bWaitingToWrite = false;
+                    connection.m_lastActivity = now;
+                    connection.m_numBytesRemaining = 0;
+                    connection.m_numBytesWritten = 0;
+                    connection.m_numResponses = 0;
+                    connection.m_pServer = &server;
+                    connection.m_pSocket = pSocket;
+                    connection.m_stage = ResponseStage::Headers;
+                    connection.m_statusCode = 0;
+
+                    // completion of a non-blocking connect is signaled when the socket becomes writable
+                    epoll_event event = {};
+                    event.events = (bConnecting ? EPOLLOUT : EPOLLIN);
+                    event.data.ptr = &connection;
+                    bConnected = (epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, int(pSocket->getSocketFileDescriptor()),
+                                            &event) == 0);
+                    if (bConnected)
+                    {
+                        pSocket->setReadBufferSize(receiveBufferSize);
+                        ++server.m_numConnections;
+                        ++numUnloadedConnections;
+                        if (bConnecting)
+                            ++server.m_numConnecting;
+                        else
+                            server.m_numConnectFailures = 0;
+                    }
+                    else
+                        connections.pop_back();
+                }
+
+                if (!bConnected)
+                {
+                    pSocket->disconnect();
+                    m_pConnectionPool->release(pSocket);
+                    failConnect(server);
+                    break;
+                }
+            }
+        }
+
+        // remove the closed connections
+        connections.remove_if([] (const Connection &connection) { return connection.m_bClosed; });
+        if (numOutstandingRequests == 0)
+            break;
+
+        // wait no longer than the earliest connection timeout or scheduled connection retry
+        auto &&deadline = std::chrono::steady_clock::time_point::max();
+        for (auto &&connection : connections)
+            if (receiveTimeout.count() > 0 && (connection.m_bConnecting || !connection.m_requests.empty()))
+                deadline = std::min(deadline, connection.m_lastActivity + receiveTimeout);
+
+        for (auto &&entry : servers)
+            if (!entry.second.m_requests.empty() && now < entry.second.m_retryTime)
+                deadline = std::min(deadline, entry.second.m_retryTime);
+
+        int timeout = -1;
+        if (deadline != std::chrono::steady_clock::time_point::max())
+        {
+            auto &&wait = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count();
+            timeout = int(std::max<long long>(0, std::min<long long>(wait + 1, 60000)));
+        }
+
+        epoll_event events[MAXIMUM_EVENTS];
+        int numEvents = epoll_wait(epollDescriptor, events, MAXIMUM_EVENTS, timeout);
+        if (numEvents < 0 && errno != EINTR)
+        {
+            lock("std_out_mutex");
+            perror(("Warning from " + methodName).c_str());
+            unlock("std_out_mutex");
+
+            bSuccess = false;
+            break;
+        }
+
+        now = std::chrono::steady_clock::now();
+        for (int i = 0; i < numEvents; ++i)
+        {
+            auto &&connection = *static_cast<Connection *>(events[i].data.ptr);
+            if (connection.m_bClosed)
+                continue;
+
+            auto *pServer = connection.m_pServer;
+            auto *pSocket = connection.m_pSocket;
+            auto &&fileDescriptor = int(pSocket->getSocketFileDescriptor());
+            connection.m_lastActivity = now;
+            if (connection.m_bConnecting)
+            {
+                // a non-blocking connect has completed, successfully or not
+                int error = 0;
+                socklen_t length = sizeof(error);
+                if (getsockopt(fileDescriptor, SOL_SOCKET, SO_ERROR, &error, &length) < 0 || error != 0)
+                {
+                    close(connection, false);
+                    failConnect(*pServer);
+                    continue;
+                }
+
+                epoll_event event = {};
+                event.events = EPOLLIN;
+                event.data.ptr = &connection;
+                epoll_ctl(epollDescriptor, EPOLL_CTL_MOD, fileDescriptor, &event);
+                connection.m_bConnecting = false;
+                --pServer->m_numConnecting;
+                pServer->m_numConnectFailures = 0;
+                continue;
+            }
+            else if ((events[i].events & EPOLLOUT) != 0 && !flush(connection))
+            {
+                abort(connection, "error sending request");
+                continue;
+            }
+            else if ((events[i].events & ~EPOLLOUT) == 0)
+                continue; // the socket has only become writable
+
+            // alternately parse the buffered data and read whatever else has arrived, until the socket has no
+            // more data, the server has closed the connection, or a response ends the connection
+            std::size_t numCompletedRequests = 0;
+            bool bFinished = false, bValid = true;
+            while (bValid && !bFinished)
+            {
+                bValid = parseResponses(connection, data, statusCodes, m_pHttpResponseHeaders,
+                                        numCompletedRequests);
+                bFinished = ((connection.m_bClose && connection.m_stage == ResponseStage::Headers) ||
+                             !pSocket->initialized());
+                if (bValid && !bFinished)
+                {
+                    auto &&numBufferedBytes = pSocket->getNumBufferedBytes();
+                    std::string_view buffer;
+                    pSocket->peekBuffered(buffer, numBufferedBytes + 1);
+                    bFinished = (pSocket->getNumBufferedBytes() == numBufferedBytes);
+                }
+            }
+
+            // data is not expected on a connection with no outstanding requests
+            bValid &= (!connection.m_requests.empty() || pSocket->getNumBufferedBytes() == 0 || connection.m_bClose);
+            numOutstandingRequests -= numCompletedRequests;
+            if (!bValid)
+                abort(connection, "malformed response");
+            else if (connection.m_bClose && connection.m_stage == ResponseStage::Headers)
+                close(connection, false);
+            else if (!pSocket->initialized() || (events[i].events & (EPOLLERR | EPOLLHUP)) != 0)
+                abort(connection, "connection closed by server");
+        }
+
+        // close the connections which have timed out
+        now = std::chrono::steady_clock::now();
+        for (auto &&connection : connections)
+        {
+            if (!connection.m_bClosed && receiveTimeout.count() > 0 &&
+                (connection.m_bConnecting || !connection.m_requests.empty()) &&
+                now - connection.m_lastActivity > receiveTimeout)
+            {
+                if (connection.m_bConnecting)
+                {
+                    auto *pServer = connection.m_pServer;
+                    close(connection, false);
+                    failConnect(*pServer);
+                }
+                else
+                    abort(connection, "timed out");
+            }
+        }
+
+        connections.remove_if([] (const Connection &connection) { return connection.m_bClosed; });
+    }
+
+    // retire the remaining connections, returning those which remain usable to the pool
+    for (auto &&connection : connections)
+        if (!connection.m_bClosed)
+            close(connection, connection.m_requests.empty());
+
+    ::close(epollDescriptor);
+#else
+    // without an event loop, the resources are downloaded in turn, reusing this object's socket
+    bSuccess = (m_pURL != nullptr);
+    if (bSuccess)
+    {
+        auto &&url = m_pURL->getURL();
+        for (std::size_t i = 0; i < numRequests; ++i)
+        {
+            m_pURL->setURL(urls[i]);
+            statusCodes[i] = Downloader::download(data[i]) ? 200 : -1;
+        }
+
+        m_pURL->setURL(url);
+    }
+#endif
+    for (auto &&statusCode : statusCodes)
+        bSuccess &= (statusCode >= 200 && statusCode < 300);
+
+    return bSuccess;
+}
+
+/**
+ * Setup function
+ */
+bool ConcurrentDownloader::setup(void)
+{
+    bool bSuccess = Downloader::setup();
+    if (bSuccess)
+    {
+        // setup token map-configurable variables...
+        m_registry["maximumConnectionsPerHost"] = m_maxConnectionsPerHost;
+        m_registry["pipelineDepth"] = m_pipelineDepth;
+    }
+
+    return bSuccess;
+}
+
+}
@@ -0,0 +1,179 @@
+#ifndef CONCURRENT_DOWNLOADER_H
+#define CONCURRENT_DOWNLOADER_H
+
+#include "downloader.h"
+#include <algorithm>
+#include <vector>
+
+namespace networking
+{
+
+// forward declarations
+namespace sockets { class ConnectionPool; }
+
+/**
+ * This class downloads many resources concurrently from a single thread. Requests are grouped by server
+ * (scheme, host and port) and multiplexed over a bounded number of non-blocking connections to each server,
+ * which an event loop services as they become ready (using epoll, where available). Up to a configurable
+ * number of requests are pipelined on each connection, and connections are kept alive in a pool so that they
+ * can be reused by subsequent downloads. Response bodies are appended by length from the socket's read buffer
+ * into output buffers preallocated from the Content-Length header, if present
+ */
+class ConcurrentDownloader
+: public Downloader,
+  virtual private attributes::abstract::Reflective
+{
+public:
+
+    /**
+     * Using declarations
+     */
+    using Downloader::download;
+
+protected:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     * @param url          the web address from which the resource(s) will be downloaded
+     */
+    EXPORT_STEM ConcurrentDownloader(const tDependencies &dependencies,
+                                     const std::string &url = "");
+
+    /**
+     * Copy constructor
+     */
+    EXPORT_STEM ConcurrentDownloader(const ConcurrentDownloader &downloader);
+
+    /**
+     * Move constructor
+     */
+    EXPORT_STEM ConcurrentDownloader(ConcurrentDownloader &&downloader);
+
+public:
+
+    /**
+     * Destructor
+     */
+    EXPORT_STEM virtual ~ConcurrentDownloader(void) override;
+
+protected:
+
+    /**
+     * Copy assignment operator
+     */
+    EXPORT_STEM ConcurrentDownloader &operator = (const ConcurrentDownloader &downloader);
+
+    /**
+     * Move assignment operator
+     */
+    EXPORT_STEM ConcurrentDownloader &operator = (ConcurrentDownloader &&downloader);
+
+public:
+
+    /**
+     * clone() function
+     */
+    EXPORT_STEM virtual ConcurrentDownloader *clone(void) const override;
+
+    /**
+     * create() function
+     * @param dependencies a tuple of this object's required injection dependencies
+     * @param url          the web address from which the resource(s) will be downloaded
+     */
+    static EXPORT_STEM ConcurrentDownloader *create(const tDependencies &dependencies,
+                                                    const std::string &url = "");
+
+    /**
+     * Function to download data from the server at this object's web address, using a pooled connection.
+     * Function returns true if data was successfully read from the server
+     * @param data an std::string that will be populated with bytes read from the server.
+     */
+    EXPORT_STEM virtual bool download(std::string &data) override;
+
+    /**
+     * Function to download the resources at the specified web addresses concurrently. Function returns true
+     * if every resource was received in a response having a successful (2xx) status code
+     * @param urls a vector of web addresses from which the resources will be downloaded
+     * @param data a vector that will be populated with the bytes read for each web address (resized if
+     *             necessary); the body of an unsuccessful response is retained, while the entry for a resource
+     *             which could not be retrieved is left empty
+     */
+    EXPORT_STEM virtual bool download(const std::vector<std::string> &urls,
+                                      std::vector<std::string> &data) final;
+
+    /**
+     * Get the name of this class
+     */
+    inline virtual std::string getClassName(void) const override
+    {
+        return "ConcurrentDownloader";
+    }
+
+    /**
+     * Get a pointer to the pool of keep-alive connections used by this object
+     */
+    inline virtual sockets::ConnectionPool *getConnectionPool(void) const final
+    {
+        return m_pConnectionPool;
+    }
+
+    /**
+     * Get the maximum number of simultaneous connections opened to each server
+     */
+    inline virtual std::size_t getMaximumConnectionsPerHost(void) const final
+    {
+        return m_maxConnectionsPerHost;
+    }
+
+    /**
+     * Get the maximum number of requests sent on a connection ahead of their responses
+     */
+    inline virtual std::size_t getPipelineDepth(void) const final
+    {
+        return m_pipelineDepth;
+    }
+
+    /**
+     * Set the maximum number of simultaneous connections opened to each server
+     */
+    inline virtual void setMaximumConnectionsPerHost(std::size_t maxConnectionsPerHost) final
+    {
+        m_maxConnectionsPerHost = std::max<std::size_t>(1, maxConnectionsPerHost);
+    }
+
+    /**
+     * Set the maximum number of requests sent on a connection ahead of their responses; a depth of one
+     * disables pipelining
+     */
+    inline virtual void setPipelineDepth(std::size_t pipelineDepth) final
+    {
+        m_pipelineDepth = std::max<std::size_t>(1, pipelineDepth);
+    }
+
+    /**
+     * Setup function
+     */
+    EXPORT_STEM virtual bool setup(void) override;
+
+protected:
+
+    /**
+     * the maximum number of simultaneous connections opened to each server
+     */
+    std::size_t m_maxConnectionsPerHost;
+
+    /**
+     * pointer to the pool of keep-alive connections
+     */
+    sockets::ConnectionPool *m_pConnectionPool;
+
+    /**
+     * the maximum number of requests sent on a connection ahead of their responses
+     */
+    std::size_t m_pipelineDepth;
+};
+
+}
+
+#endif
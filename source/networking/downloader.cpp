@@ -412,31 +412,37 @@ std::string Downloader::getClassName(void) const
  * Get the full HTTP request string
  */
 std::string Downloader::getHttpRequest(void) const
+{
+    return m_pURL != nullptr ? getHttpRequest(*m_pURL) : "";
+}
+
+/**
+ * Get the full HTTP request string for the specified web address
+ * @param url the web address of the requested resource
+ */
+std::string Downloader::getHttpRequest(const URL &url) const
 {
     std::string httpRequest;
     auto *pDownloaderPreferences = getDependency<DownloaderPreferences *>();
-    if (m_pURL != nullptr && pDownloaderPreferences != nullptr)
+    if (pDownloaderPreferences != nullptr)
     {
-        auto &&host = m_pURL->getHost();
-        auto &&requestURI = m_pURL->getRequestURI();
+        auto &&host = url.getHost();
+        auto &&requestURI = url.getRequestURI();
         auto &&httpVersion = pDownloaderPreferences->getHttpVersion();
         httpRequest = std::string(m_httpRequestMethod) + " " + requestURI + " HTTP/" + httpVersion +
                       "\r\nHost: " + host + "\r\n";
 
         if (m_pHttpRequestHeaders != nullptr)
         {
-            auto &&userName = m_pURL->getUserName();
-            auto &&userPassword = m_pURL->getUserPassword();
-
-            if (!userName.empty() && !userPassword.empty())
-            {
-                auto &&authorization =  "Basic " + userName + ":" + userPassword;
-                m_pHttpRequestHeaders->addEntry("Authorization", authorization);
-            }
-
             std::ostringstream oss;
             oss << *m_pHttpRequestHeaders;
             httpRequest += oss.str();
+
+            // credentials belong to the web address, so they are not stored with the shared request headers
+            auto &&userName = url.getUserName();
+            auto &&userPassword = url.getUserPassword();
+            if (!userName.empty() && !userPassword.empty() && !m_pHttpRequestHeaders->containsEntry("Authorization"))
+                httpRequest += "Authorization: Basic " + userName + ":" + userPassword + "\r\n";
         }
 
         httpRequest += "\r\n";
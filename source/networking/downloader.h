@@ -127,6 +127,12 @@ public:
      */
     EXPORT_STEM virtual std::string getHttpRequest(void) const final;
 
+    /**
+     * Get the full HTTP request string for the specified web address
+     * @param url the web address of the requested resource
+     */
+    EXPORT_STEM virtual std::string getHttpRequest(const URL &url) const final;
+
     /**
      * Get this object's HTTP request headers
      */
@@ -2,16 +2,6 @@
 #include "socket.h"
 #include "string_utilities.h"
 
-#if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
-#define POSIX
-#endif
-
-#ifdef _WIN32
-#include <winsock.h>
-#elif defined POSIX
-#include <sys/socket.h>
-#endif
-
 // using namespace declarations
 using namespace networking::sockets;
 using namespace utilities::string;
@@ -309,13 +299,16 @@ bool HttpHeaders::readHeaders(Socket *pSocket)
     bool bSuccess = (pSocket != nullptr);
     if (bSuccess)
     {
-        char buffer[5] = { 0 };
-        auto &&result = pSocket->read(buffer, 4, MSG_PEEK);
-        if (result > 0 && strcmp(buffer, "HTTP") == 0)
+        std::string_view line;
+        if (pSocket->peekBuffered(line, 4) > 0 && line == "HTTP")
         {
+            // read lines until the empty line which terminates the headers, appending a newline to each line
             std::string data;
-            for (std::size_t size = 0; pSocket->readLine(&data) && size != data.size(); size = data.size())
-                data += '\n'; // append a newline to each line
+            while (pSocket->readLine(line) && !line.empty())
+            {
+                data.append(line.data(), line.size());
+                data += '\n';
+            }
 
             std::istringstream iss(data);
             extract(iss);
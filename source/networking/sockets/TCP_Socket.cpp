@@ -19,6 +19,7 @@
 #ifdef _WIN32
 #define _errno WSAGetLastError()
 #define CONNRESET WSAECONNRESET
+#define INPROGRESS WSAEWOULDBLOCK
 #define NOTCONN WSAENOTCONN
 #define TIMEDOUT WSAETIMEDOUT
 #define WOULDBLOCK WSAEWOULDBLOCK
@@ -26,6 +27,7 @@
 #define closesocket close
 #define CONNRESET ECONNRESET
 #define _errno errno
+#define INPROGRESS EINPROGRESS
 #define INVALID_SOCKET -1
 #define NOTCONN ENOTCONN
 #define SOCKET_ERROR -1
@@ -83,8 +85,13 @@ bool TCP_Socket::connect(void)
 
     if (bSuccess)
     {
-        // socket was successfully created, now connect to the server
-        bSuccess = (::connect(m_sockfd, m_pAddrInfo->ai_addr, int(m_pAddrInfo->ai_addrlen)) >= 0);
+        // data buffered from a previous connection does not belong to this one
+        clearReadBuffer();
+
+        // socket was successfully created, now connect to the server; in non-blocking mode, the connection may
+        // still be in progress upon return, and its completion is signaled when the socket becomes writable
+        bSuccess = (::connect(m_sockfd, m_pAddrInfo->ai_addr, int(m_pAddrInfo->ai_addrlen)) >= 0 ||
+                    (!m_bBlockingEnabled && _errno == INPROGRESS));
         if (!bSuccess)
         {
             lock("std_out_mutex");
@@ -359,39 +366,80 @@ bool TCP_Socket::write(const std::string &data)
     bool bSuccess = false;
     if (initialized())
     {
-        auto &&result = send(m_sockfd, data.c_str(), int(data.length()), 0);
-        switch (result)
+        // send() may accept only part of the data, so continue with the remainder until all of it is sent
+        std::size_t numBytesSent = 0;
+        do
         {
-            case SOCKET_ERROR: // we got an error, check errno
-            if (_errno == EAGAIN || _errno == EWOULDBLOCK)
-                std::this_thread::sleep_for(std::chrono::milliseconds(m_sendTimeout));
-            else
+            auto &&result = send(m_sockfd, data.c_str() + numBytesSent, int(data.length() - numBytesSent),
+                                 MSG_NOSIGNAL);
+            switch (result)
             {
+                case SOCKET_ERROR: // we got an error, check errno
+                if (_errno == EAGAIN || _errno == EWOULDBLOCK)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(m_sendTimeout));
+                else
+                {
+                    lock("std_out_mutex");
+                    logMsg("warning", LoggingLevel::Enum::Warning,
+                           "Error sending socket: " + std::string(strerror(_errno)) + "\n",
+                           getQualifiedMethodName(__func__));
+                    unlock("std_out_mutex");
+                }
+
+                return false;
+
+                case 0: // the socket has been closed on the other end
+                disconnect();
                 lock("std_out_mutex");
                 logMsg("warning", LoggingLevel::Enum::Warning,
-                       "Error sending socket: " + std::string(strerror(_errno)) + "\n",
+                       "The socket disconnected: " + std::string(strerror(_errno)) + "\n",
                        getQualifiedMethodName(__func__));
                 unlock("std_out_mutex");
+
+                return false;
+
+                default:
+                numBytesSent += std::size_t(result);
+                break;
             }
+        }
+        while (numBytesSent < data.length());
 
-            break;
+        bSuccess = true;
+    }
 
-            case 0: // the socket has been closed on the other end
-            disconnect();
-            lock("std_out_mutex");
-            logMsg("warning", LoggingLevel::Enum::Warning,
-                   "The socket disconnected: " + std::string(strerror(_errno)) + "\n",
-                   getQualifiedMethodName(__func__));
-            unlock("std_out_mutex");
-            break;
+    return bSuccess;
+}
 
-            default:
-            bSuccess = true;
-            break;
+/**
+ * Function to write as much data to the socket as it accepts without waiting; returns the number of bytes
+ * written, zero if the socket cannot accept any more data at present, or a negative value upon error
+ * @param pData  a pointer to the character sequence to be written to the socket
+ * @param length the number of characters to be written
+ */
+long TCP_Socket::write(const char *pData,
+                       std::size_t length)
+{
+    long result = -1;
+    if (pData != nullptr && initialized())
+    {
+        result = send(m_sockfd, pData, int(length), MSG_NOSIGNAL);
+        if (result == SOCKET_ERROR)
+        {
+            if (_errno == EAGAIN || _errno == EWOULDBLOCK)
+                result = 0; // wrote nothing
+            else
+            {
+                lock("std_out_mutex");
+                logMsg("warning", LoggingLevel::Enum::Warning,
+                       "Error sending socket: " + std::string(strerror(_errno)) + "\n",
+                       getQualifiedMethodName(__func__));
+                unlock("std_out_mutex");
+            }
         }
     }
 
-    return bSuccess;
+    return result;
 }
 
 }
@@ -94,14 +94,6 @@ public:
      */
     EXPORT_STEM virtual int getLastError(int /* not used */ = 0) const override;
 
-    /**
-     * Get socket file descriptor
-     */
-    inline virtual long getSocketFileDescriptor(void) const final
-    {
-        return m_sockfd;
-    }
-
     /**
      * Initialization function
      */
@@ -143,6 +135,15 @@ public:
      */
     EXPORT_STEM virtual bool write(const std::string &data) override;
 
+    /**
+     * Function to write as much data to the socket as it accepts without waiting; returns the number of bytes
+     * written, zero if the socket cannot accept any more data at present, or a negative value upon error
+     * @param pData  a pointer to the character sequence to be written to the socket
+     * @param length the number of characters to be written
+     */
+    EXPORT_STEM virtual long write(const char *pData,
+                                   std::size_t length) override;
+
 protected:
 
     /**
@@ -122,16 +122,26 @@ Receiver *ChunkedReceiver::create(Socket *pSocket,
 long ChunkedReceiver::getChunkSize(void)
 {
     long chunkSize = 0;
-    std::stringstream stream;
-    std::string data;
     if (m_pSocket != nullptr)
     {
-        while (m_pSocket->readLine(&data))
+        // skip lines (e.g., the CRLF which terminates the previous chunk's data) until one begins with the
+        // hexadecimal chunk size, which may be followed by chunk extensions; a chunk size with more digits than
+        // a long can hold is rejected, which ends the transfer
+        std::string_view line;
+        while (m_pSocket->readLine(line))
         {
-            if (!data.empty() && data.find_first_not_of("ABCDEFabcdef0123456789") == std::string::npos)
+            auto numDigits = std::min(line.find_first_not_of("ABCDEFabcdef0123456789"), line.size());
+            if (numDigits > 0 && (numDigits == line.size() || line[numDigits] == ';' || line[numDigits] == ' '))
             {
-                stream.str(data);
-                stream >> std::hex >> chunkSize;
+                if (numDigits > 2 * sizeof(long) - 1)
+                    break;
+
+                for (std::size_t i = 0; i < numDigits; ++i)
+                {
+                    auto &&digit = line[i];
+                    chunkSize = 16 * chunkSize + (digit <= '9' ? digit - '0' : (digit | 0x20) - 'a' + 10);
+                }
+
                 break;
             }
         }
@@ -162,19 +172,20 @@ long ChunkedReceiver::receive(std::string &data,
     long totalBytesRead = 0;
     if (m_pSocket != nullptr && m_pSocket->initialized())
     {
+        // chunk data is appended directly from the socket's read buffer
         long chunkSize = getChunkSize();
         do
         {
             long numBytesRead = 0, result = 0;
+            std::string_view buffer;
             do
             {
-                long numBytesRequested = std::min(m_receiveBufferSize - 1, chunkSize - numBytesRead);
-                std::memset(m_pReceiveBuffer, 0, numBytesRequested + 1);
-                result = m_pSocket->read(m_pReceiveBuffer, numBytesRequested);
+                long numBytesRequested = std::min(m_receiveBufferSize, chunkSize - numBytesRead);
+                result = m_pSocket->readBuffered(buffer, std::size_t(numBytesRequested));
                 if (result > 0)
                 {
                     numBytesRead += result;
-                    data += m_pReceiveBuffer;
+                    data.append(buffer.data(), buffer.size());
                 }
                 else
                     return result;
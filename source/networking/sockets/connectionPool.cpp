@@ -0,0 +1,153 @@
+#include "connectionPool.h"
+#include "socket.h"
+#include "URL.h"
+
+namespace networking
+{
+
+namespace sockets
+{
+
+/**
+ * Constructor
+ * @param maxIdleConnectionsPerHost the maximum number of idle connections retained for each server
+ */
+ConnectionPool::ConnectionPool(std::size_t maxIdleConnectionsPerHost)
+: m_maxIdleConnectionsPerHost(maxIdleConnectionsPerHost)
+{
+
+}
+
+/**
+ * Destructor
+ */
+ConnectionPool::~ConnectionPool(void)
+{
+    while (!m_urls.empty())
+        destroy(m_urls.begin()->first);
+}
+
+/**
+ * Acquire a socket for the server identified by the specified web address. An idle connection to the server is
+ * returned if one is still open; otherwise, a new, unconnected socket is created. Returns a null pointer if a
+ * socket could not be created for the address' scheme
+ * @param url the web address of the requested resource
+ */
+Socket *ConnectionPool::acquire(const URL &url)
+{
+    auto itIdleConnections = m_idleConnections.find(getKey(url));
+    if (itIdleConnections != m_idleConnections.end())
+    {
+        auto &&idleConnections = itIdleConnections->second;
+        while (!idleConnections.empty())
+        {
+            auto *pSocket = idleConnections.back();
+            idleConnections.pop_back();
+
+            // an idle connection should have nothing to read; a peek which finds the connection closed by the
+            // server disconnects the socket, while one which finds stray data leaves the connection unusable
+            char byte;
+            if (pSocket->peek(&byte, 1) <= 0 && pSocket->initialized() && pSocket->getNumBufferedBytes() == 0)
+                return pSocket;
+
+            destroy(pSocket);
+        }
+    }
+
+    // the socket references its own copy of the web address, since the caller's may not outlive it
+    auto *pURL = new URL(url);
+    auto *pSocket = Socket::create(pURL);
+    if (pSocket != nullptr)
+        m_urls[pSocket] = pURL;
+    else
+        delete pURL;
+
+    return pSocket;
+}
+
+/**
+ * Close and destroy all idle connections
+ */
+void ConnectionPool::clear(void)
+{
+    for (auto &&idleConnections : m_idleConnections)
+        for (auto *pSocket : idleConnections.second)
+            destroy(pSocket);
+
+    m_idleConnections.clear();
+}
+
+/**
+ * Function to disconnect and destroy a socket owned by this pool, along with its URL object
+ */
+void ConnectionPool::destroy(Socket *pSocket)
+{
+    auto itURL = m_urls.find(pSocket);
+    if (itURL != m_urls.end())
+    {
+        pSocket->disconnect();
+        delete pSocket;
+        delete itURL->second;
+        m_urls.erase(itURL);
+    }
+}
+
+/**
+ * Get the key which identifies the server associated with the specified web address, of the form
+ * scheme://host:port
+ */
+std::string ConnectionPool::getKey(const URL &url)
+{
+    auto &&scheme = url.getScheme();
+    if (scheme.empty())
+        scheme = "http"; // assume http
+
+    auto &&port = url.getPort();
+    if (port.empty())
+        port = (scheme == "https" ? "443" : "80");
+
+    return scheme + "://" + url.getHost() + ":" + port;
+}
+
+/**
+ * Get the number of idle connections held by this pool
+ */
+std::size_t ConnectionPool::getNumIdleConnections(void) const
+{
+    std::size_t numIdleConnections = 0;
+    for (auto &&idleConnections : m_idleConnections)
+        numIdleConnections += idleConnections.second.size();
+
+    return numIdleConnections;
+}
+
+/**
+ * Return a socket to this pool. A socket that is still connected is retained as an idle connection (in
+ * non-blocking mode, so that it can be probed without blocking) if the server's limit has not been reached;
+ * otherwise, the socket is destroyed
+ * @param pSocket a pointer to a socket previously acquired from this pool
+ */
+void ConnectionPool::release(Socket *pSocket)
+{
+    auto itURL = m_urls.find(pSocket);
+    if (itURL != m_urls.end())
+    {
+        auto &&idleConnections = m_idleConnections[getKey(*itURL->second)];
+        bool bRetain = (pSocket->initialized() && pSocket->getNumBufferedBytes() == 0 &&
+                        idleConnections.size() < m_maxIdleConnectionsPerHost);
+        if (bRetain)
+        {
+            pSocket->blockingEnabled(false);
+            bRetain = !pSocket->blockingEnabled();
+        }
+
+        if (bRetain)
+            idleConnections.push_back(pSocket);
+        else
+            destroy(pSocket);
+    }
+}
+
+}
+
+}
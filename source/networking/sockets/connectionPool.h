@@ -0,0 +1,138 @@
+#ifndef CONNECTION_POOL_H
+#define CONNECTION_POOL_H
+
+#include "export_library.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace networking
+{
+
+// forward declarations
+class URL;
+
+namespace sockets
+{
+
+// forward declarations
+class Socket;
+
+/**
+ * This class maintains a pool of idle, keep-alive socket connections, keyed by the scheme, host and port of the
+ * server to which they are connected, so that subsequent requests to the same server can reuse an established
+ * connection rather than open a new one. The pool owns every socket it hands out (along with the URL object
+ * each socket references); sockets acquired from the pool must be returned to it with release(), and must not
+ * be deleted by the caller
+ */
+class ConnectionPool
+{
+public:
+
+    /**
+     * Constructor
+     * @param maxIdleConnectionsPerHost the maximum number of idle connections retained for each server
+     */
+    EXPORT_STEM ConnectionPool(std::size_t maxIdleConnectionsPerHost = 8);
+
+    /**
+     * Copy constructor
+     */
+    EXPORT_STEM ConnectionPool(const ConnectionPool &pool) = delete;
+
+    /**
+     * Move constructor
+     */
+    EXPORT_STEM ConnectionPool(ConnectionPool &&pool) = delete;
+
+    /**
+     * Destructor
+     */
+    EXPORT_STEM virtual ~ConnectionPool(void);
+
+    /**
+     * Copy assignment operator
+     */
+    EXPORT_STEM ConnectionPool &operator = (const ConnectionPool &pool) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    EXPORT_STEM ConnectionPool &operator = (ConnectionPool &&pool) = delete;
+
+    /**
+     * Acquire a socket for the server identified by the specified web address. An idle connection to the
+     * server is returned if one is still open; otherwise, a new, unconnected socket is created. Returns a null
+     * pointer if a socket could not be created for the address' scheme
+     * @param url the web address of the requested resource
+     */
+    EXPORT_STEM virtual Socket *acquire(const URL &url) final;
+
+    /**
+     * Close and destroy all idle connections
+     */
+    EXPORT_STEM virtual void clear(void) final;
+
+    /**
+     * Get the key which identifies the server associated with the specified web address, of the form
+     * scheme://host:port
+     */
+    static EXPORT_STEM std::string getKey(const URL &url);
+
+    /**
+     * Get the maximum number of idle connections retained for each server
+     */
+    inline virtual std::size_t getMaximumIdleConnectionsPerHost(void) const final
+    {
+        return m_maxIdleConnectionsPerHost;
+    }
+
+    /**
+     * Get the number of idle connections held by this pool
+     */
+    EXPORT_STEM virtual std::size_t getNumIdleConnections(void) const final;
+
+    /**
+     * Return a socket to this pool. A socket that is still connected is retained as an idle connection (in
+     * non-blocking mode, so that it can be probed without blocking) if the server's limit has not been reached;
+     * otherwise, the socket is destroyed
+     * @param pSocket a pointer to a socket previously acquired from this pool
+     */
+    EXPORT_STEM virtual void release(Socket *pSocket) final;
+
+    /**
+     * Set the maximum number of idle connections retained for each server
+     */
+    inline virtual void setMaximumIdleConnectionsPerHost(std::size_t maxIdleConnectionsPerHost) final
+    {
+        m_maxIdleConnectionsPerHost = maxIdleConnectionsPerHost;
+    }
+
+private:
+
+    /**
+     * Function to disconnect and destroy a socket owned by this pool, along with its URL object
+     */
+    EXPORT_STEM virtual void destroy(Socket *pSocket) final;
+
+    /**
+     * a map of server keys to the idle connections to each server, most recently used last
+     */
+    std::map<std::string, std::vector<Socket *>> m_idleConnections;
+
+    /**
+     * the maximum number of idle connections retained for each server
+     */
+    std::size_t m_maxIdleConnectionsPerHost;
+
+    /**
+     * a map of the sockets owned by this pool to the URL objects they reference
+     */
+    std::map<Socket *, URL *> m_urls;
+};
+
+}
+
+}
+
+#endif
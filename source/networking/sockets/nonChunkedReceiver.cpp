@@ -5,6 +5,12 @@
 // file-scoped variables
 static constexpr char factoryName[] = "non-chunked";
 
+/**
+ * the largest number of bytes reserved up front for a message of known size; larger messages grow as they are
+ * received, so that a bogus Content-Length cannot force a huge allocation
+ */
+static constexpr std::size_t maximumReservedMessageSize = 1 << 24;
+
 // using namespace declarations
 using namespace attributes::abstract;
 using namespace utilities;
@@ -135,12 +141,18 @@ long NonChunkedReceiver::receive(std::string &data, const functor_type &stopCrit
     long totalBytesRead = 0;
     if (m_pSocket != nullptr && m_pSocket->initialized())
     {
+        // message data is appended directly from the socket's read buffer
         long messageSize = getMessageSize();
         if (messageSize > 0)
         {
+            // the message size is known, so the output is allocated once (up to a cap) rather than grown as data
+            // arrives
+            data.reserve(data.size() + std::min(std::size_t(messageSize), maximumReservedMessageSize));
+
+            std::string_view buffer;
             while (true)
             {
-                long numBytesRequested = m_receiveBufferSize - 1;
+                long numBytesRequested = m_receiveBufferSize;
                 if (messageSize >= 0)
                 {
                     numBytesRequested = std::min(numBytesRequested, messageSize - totalBytesRead);
@@ -148,11 +160,10 @@ long NonChunkedReceiver::receive(std::string &data, const functor_type &stopCrit
                         break;
                 }
 
-                std::memset(m_pReceiveBuffer, 0, numBytesRequested + 1);
-                long result = m_pSocket->read(m_pReceiveBuffer, numBytesRequested);
+                long result = m_pSocket->readBuffered(buffer, std::size_t(numBytesRequested));
                 if (result > 0)
                 {
-                    data += m_pReceiveBuffer;
+                    data.append(buffer.data(), buffer.size());
                     totalBytesRead += result;
                 }
                 else
@@ -2,6 +2,8 @@
 #include "socket.h"
 #include "static_message_dispatcher.h"
 #include "URL.h"
+#include <algorithm>
+#include <cstring>
 #include <mutex>
 
 #if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
@@ -22,6 +24,7 @@
 
 // file-scoped variables
 static constexpr char className[] = "Socket";
+static constexpr std::size_t defaultReadBufferSize = 16384;
 
 // using namespace declarations
 using namespace attributes::concrete;
@@ -50,6 +53,9 @@ Socket::Socket(URL *pURL)
   m_bKeepAlive(false),
   m_connectRetryTimeout(100),
   m_pURL(pURL),
+  m_readBegin(0),
+  m_readBuffer(defaultReadBufferSize),
+  m_readEnd(0),
   m_receiveTimeout(1000),
   m_sendTimeout(1000),
   m_sockfd(int(INVALID_SOCKET))
@@ -103,6 +109,15 @@ inline void Socket::blockingEnabled(bool bEnabled)
     }
 }
 
+/**
+ * Discard the contents of the read buffer, e.g., upon establishing a new connection
+ */
+void Socket::clearReadBuffer(void)
+{
+    m_readBegin = 0;
+    m_readEnd = 0;
+}
+
 /**
  * create() function
  * @param pURL a pointer to a URL object
@@ -122,6 +137,29 @@ Socket *Socket::create(URL *pURL)
     return pSocket;
 }
 
+/**
+ * Function to refill the read buffer with a single call to read(), first moving unconsumed data to the front of
+ * the buffer (and growing the buffer, if it is full); returns the result of read()
+ */
+long Socket::fillReadBuffer(void)
+{
+    if (m_readBegin > 0)
+    {
+        std::memmove(m_readBuffer.data(), m_readBuffer.data() + m_readBegin, m_readEnd - m_readBegin);
+        m_readEnd -= m_readBegin;
+        m_readBegin = 0;
+    }
+
+    if (m_readEnd == m_readBuffer.size())
+        m_readBuffer.resize(std::max(2 * m_readBuffer.size(), defaultReadBufferSize));
+
+    auto &&result = read(m_readBuffer.data() + m_readEnd, m_readBuffer.size() - m_readEnd, 0);
+    if (result > 0)
+        m_readEnd += result;
+
+    return result;
+}
+
 /**
  * Get the name of this class
  */
@@ -146,6 +184,14 @@ std::string Socket::getHost(void) const
     return m_pURL != nullptr ? m_pURL->getHost() : "";
 }
 
+/**
+ * Get the number of bytes received but not yet consumed from the read buffer
+ */
+std::size_t Socket::getNumBufferedBytes(void) const
+{
+    return m_readEnd - m_readBegin;
+}
+
 /**
  * Get the port
  */
@@ -170,6 +216,14 @@ std::string Socket::getPort(void) const
     return port;
 }
 
+/**
+ * Get the capacity of the read buffer
+ */
+std::size_t Socket::getReadBufferSize(void) const
+{
+    return m_readBuffer.size();
+}
+
 /**
  * Get socket receive timeout value in milliseconds
  */
@@ -215,40 +269,101 @@ void Socket::keepAlive(bool bEnabled)
 }
 
 /**
- * Read a line of data (until CRLF)
- * @param pData a pointer to a buffer in which the received data will be stored
+ * Function to peek at the data in the read buffer, refilling the buffer until it holds at least the requested
+ * number of bytes or no more data is available; returns the number of bytes viewed, or the (non-positive)
+ * result of the failed read if none are available
+ * @param data   upon return, a view of up to the requested number of bytes, which remains valid until the next
+ *               call to a buffered read function
+ * @param length the number of bytes requested
  */
-bool Socket::readLine(std::string *pData)
+long Socket::peekBuffered(std::string_view &data,
+                          std::size_t length)
 {
-    bool bSuccess = false;
-    if (initialized())
+    long result = 1;
+    while (m_readEnd - m_readBegin < length && result > 0)
+        result = fillReadBuffer();
+
+    auto size = std::min(length, m_readEnd - m_readBegin);
+    data = std::string_view(m_readBuffer.data() + m_readBegin, size);
+
+    return size > 0 ? long(size) : result;
+}
+
+/**
+ * Function to consume data from the read buffer, refilling the buffer if it is empty; returns the number of
+ * bytes consumed, or the (non-positive) result of the failed read if none are available
+ * @param data          upon return, a view of the consumed data, which remains valid until the next call to a
+ *                      buffered read function
+ * @param maximumLength the maximum number of bytes to consume
+ */
+long Socket::readBuffered(std::string_view &data,
+                          std::size_t maximumLength)
+{
+    long result = 1;
+    if (m_readBegin == m_readEnd && maximumLength > 0)
+        result = fillReadBuffer();
+
+    auto size = std::min(maximumLength, m_readEnd - m_readBegin);
+    data = std::string_view(m_readBuffer.data() + m_readBegin, size);
+    m_readBegin += size;
+
+    return size > 0 ? long(size) : std::min(result, 0L);
+}
+
+/**
+ * Read a line of data (until CRLF) from the read buffer; returns false if the line could not be completed, in
+ * which case the remaining buffered data is consumed and returned
+ * @param line upon return, a view of the line without its terminating CRLF, which remains valid until the next
+ *             call to a buffered read function
+ */
+bool Socket::readLine(std::string_view &line)
+{
+    // the number of unconsumed bytes already searched for the line terminator, which is unaffected when the
+    // buffer is refilled and its contents are moved
+    std::size_t numSearched = 0;
+    while (true)
     {
-        long result = 0;
-        while (true)
+        const char *pBegin = m_readBuffer.data() + m_readBegin;
+        const char *pEnd = m_readBuffer.data() + m_readEnd;
+        const char *pSearch = pBegin + numSearched;
+        while (pSearch != pEnd)
         {
-            char byte;
-            result = read(&byte, 1, 0);
-            if (result <= 0)
+            auto *pNewLine = static_cast<const char *>(std::memchr(pSearch, '\n', std::size_t(pEnd - pSearch)));
+            if (pNewLine == nullptr)
                 break;
-            else
+            else if (pNewLine != pBegin && pNewLine[-1] == '\r')
             {
-                if (byte == '\r')
-                {
-                    result = read(&byte, 1, MSG_PEEK);
-                    if (result > 0 && byte == '\n')
-                    {
-                        read(&byte, 1, 0);
-                        bSuccess = true;
-                        break;
-                    }
-                }
+                line = std::string_view(pBegin, std::size_t(pNewLine - 1 - pBegin));
+                m_readBegin += std::size_t(pNewLine + 1 - pBegin);
 
-                if (pData != nullptr)
-                    *pData += byte;
+                return true;
             }
+
+            pSearch = pNewLine + 1;
         }
+
+        numSearched = m_readEnd - m_readBegin;
+        if (fillReadBuffer() <= 0)
+            break;
     }
 
+    line = std::string_view(m_readBuffer.data() + m_readBegin, m_readEnd - m_readBegin);
+    m_readBegin = m_readEnd;
+
+    return false;
+}
+
+/**
+ * Read a line of data (until CRLF)
+ * @param pData a pointer to a buffer to which the received data will be appended
+ */
+bool Socket::readLine(std::string *pData)
+{
+    std::string_view line;
+    bool bSuccess = readLine(line);
+    if (pData != nullptr)
+        pData->append(line.data(), line.size());
+
     return bSuccess;
 }
 
@@ -260,6 +375,23 @@ void Socket::setConnectRetryTimeout(std::size_t timeout)
     m_connectRetryTimeout = timeout;
 }
 
+/**
+ * Set the capacity of the read buffer; the buffer is never made smaller than the data it holds, and grows as
+ * needed to hold lines longer than its capacity
+ */
+void Socket::setReadBufferSize(std::size_t size)
+{
+    if (m_readBegin > 0)
+    {
+        std::memmove(m_readBuffer.data(), m_readBuffer.data() + m_readBegin, m_readEnd - m_readBegin);
+        m_readEnd -= m_readBegin;
+        m_readBegin = 0;
+    }
+
+    m_readBuffer.resize(std::max<std::size_t>(1, std::max(size, m_readEnd)));
+    m_readBuffer.shrink_to_fit();
+}
+
 /**
  * Set socket receive timeout value in milliseconds
  */
@@ -10,6 +10,8 @@
 #include "static_synchronizable.h"
 #include "toggleable_stream.h"
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace networking
 {
@@ -21,7 +23,12 @@ namespace sockets
 {
 
 /**
- * This class implements a C++ abstract base wrapper class for network sockets
+ * This class implements a C++ abstract base wrapper class for network sockets. In addition to the unbuffered
+ * read() and peek() functions implemented by derived classes, this class maintains a read buffer from which
+ * lines and blocks of data can be consumed (see readLine(), readBuffered() and peekBuffered()); the buffer is
+ * refilled on demand with as much data as the socket has available, so that parsing line-oriented protocols
+ * costs one receive call per buffer-full rather than one per byte. The two forms of reading must not be mixed
+ * on the same connection, as data held in the read buffer is not visible to read() and peek()
  */
 class Socket
 : public attributes::abstract::FactoryConstructible<Socket>,
@@ -142,6 +149,24 @@ public:
      */
     EXPORT_STEM virtual std::size_t getServerSendTimeout(void) const final;
 
+    /**
+     * Get the number of bytes received but not yet consumed from the read buffer
+     */
+    EXPORT_STEM virtual std::size_t getNumBufferedBytes(void) const final;
+
+    /**
+     * Get the capacity of the read buffer
+     */
+    EXPORT_STEM virtual std::size_t getReadBufferSize(void) const final;
+
+    /**
+     * Get socket file descriptor
+     */
+    inline virtual long getSocketFileDescriptor(void) const final
+    {
+        return m_sockfd;
+    }
+
     /**
      * Get a pointer to this object's URL
      */
@@ -190,9 +215,38 @@ public:
                                   size_t length,
                                   int flags = 0) = 0;
 
+    /**
+     * Function to peek at the data in the read buffer, refilling the buffer until it holds at least the
+     * requested number of bytes or no more data is available; returns the number of bytes viewed, or the
+     * (non-positive) result of the failed read if none are available
+     * @param data   upon return, a view of up to the requested number of bytes, which remains valid until the
+     *               next call to a buffered read function
+     * @param length the number of bytes requested
+     */
+    EXPORT_STEM virtual long peekBuffered(std::string_view &data,
+                                          std::size_t length) final;
+
+    /**
+     * Function to consume data from the read buffer, refilling the buffer if it is empty; returns the number of
+     * bytes consumed, or the (non-positive) result of the failed read if none are available
+     * @param data          upon return, a view of the consumed data, which remains valid until the next call
+     *                      to a buffered read function
+     * @param maximumLength the maximum number of bytes to consume
+     */
+    EXPORT_STEM virtual long readBuffered(std::string_view &data,
+                                          std::size_t maximumLength) final;
+
+    /**
+     * Read a line of data (until CRLF) from the read buffer; returns false if the line could not be completed,
+     * in which case the remaining buffered data is consumed and returned
+     * @param line upon return, a view of the line without its terminating CRLF, which remains valid until the
+     *             next call to a buffered read function
+     */
+    EXPORT_STEM virtual bool readLine(std::string_view &line) final;
+
     /**
      * Read a line of data (until CRLF)
-     * @param pData a pointer to a buffer in which the received data will be stored
+     * @param pData a pointer to a buffer to which the received data will be appended
      */
     EXPORT_STEM virtual bool readLine(std::string *pData = nullptr);
 
@@ -201,6 +255,12 @@ public:
      */
     EXPORT_STEM virtual void setConnectRetryTimeout(std::size_t timeout) final;
 
+    /**
+     * Set the capacity of the read buffer; the buffer is never made smaller than the data it holds, and grows
+     * as needed to hold lines longer than its capacity
+     */
+    EXPORT_STEM virtual void setReadBufferSize(std::size_t size) final;
+
     /**
      * Set socket receive timeout value in milliseconds
      */
@@ -211,8 +271,21 @@ public:
      */
     EXPORT_STEM virtual void setServerSendTimeout(std::size_t timeout) final;
 
+protected:
+
+    /**
+     * Discard the contents of the read buffer, e.g., upon establishing a new connection
+     */
+    EXPORT_STEM virtual void clearReadBuffer(void) final;
+
 private:
 
+    /**
+     * Function to refill the read buffer with a single call to read(), first moving unconsumed data to the
+     * front of the buffer (and growing the buffer, if it is full); returns the result of read()
+     */
+    EXPORT_STEM virtual long fillReadBuffer(void) final;
+
     /**
      * Function to set the connection send/receive timeout in milliseconds
      */
@@ -227,6 +300,15 @@ public:
      */
     EXPORT_STEM virtual bool write(const std::string &data) = 0;
 
+    /**
+     * Function to write as much data to the socket as it accepts without waiting; returns the number of bytes
+     * written, zero if the socket cannot accept any more data at present, or a negative value upon error
+     * @param pData  a pointer to the character sequence to be written to the socket
+     * @param length the number of characters to be written
+     */
+    EXPORT_STEM virtual long write(const char *pData,
+                                   std::size_t length) = 0;
+
 protected:
 
     /**
@@ -249,6 +331,21 @@ protected:
      */
     URL *m_pURL;
 
+    /**
+     * the offset of the first unconsumed byte in the read buffer
+     */
+    std::size_t m_readBegin;
+
+    /**
+     * the read buffer
+     */
+    std::vector<char> m_readBuffer;
+
+    /**
+     * the offset one past the last unconsumed byte in the read buffer
+     */
+    std::size_t m_readEnd;
+
     /**
      * receive timeout (milliseconds)
      */
@@ -311,7 +311,7 @@ long SSL_Socket::read(char *pBuffer,
     if (pBuffer != nullptr && initialized())
     {
         // read data from the peek buffer, if there is any
-        auto &&size = std::min(length, m_peekBuffer.size());
+        auto size = std::min(length, m_peekBuffer.size());
         for (size_t i = 0; i < size; ++i, ++pBuffer)
         {
             if (flags & MSG_PEEK)
@@ -344,7 +344,13 @@ long SSL_Socket::read(char *pBuffer,
             }
             else if ((flags & MSG_PEEK) == 0)
             {
-                switch (getLastError(result))
+                // in non-blocking mode, a read which would block is expected and is not reported
+                auto &&error = SSL_get_error(m_pHandle, int(result));
+                bool bWouldBlock = (error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE);
+                if (!bWouldBlock || blockingEnabled())
+                    getLastError(int(result));
+
+                switch (error)
                 {
                     case SSL_ERROR_ZERO_RETURN: // the socket has been closed on the other end
                     disconnect();
@@ -407,6 +413,49 @@ bool SSL_Socket::write(const std::string &data)
     return bSuccess;
 }
 
+/**
+ * Function to write data to the socket without waiting; returns the number of bytes written, zero if the socket
+ * cannot accept the data at present (in which case the same data must be written again), or a negative value
+ * upon error
+ * @param pData  a pointer to the character sequence to be written to the socket
+ * @param length the number of characters to be written
+ */
+long SSL_Socket::write(const char *pData,
+                       std::size_t length)
+{
+    long result = -1;
+    if (pData != nullptr && initialized())
+    {
+        result = SSL_write(m_pHandle, pData, int(length));
+        if (result <= 0)
+        {
+            // a write which would block is expected of the non-blocking event loop and is not reported
+            auto &&error = SSL_get_error(m_pHandle, int(result));
+            if (error != SSL_ERROR_WANT_READ && error != SSL_ERROR_WANT_WRITE)
+                getLastError(int(result));
+
+            switch (error)
+            {
+                case SSL_ERROR_ZERO_RETURN: // the socket has been closed on the other end
+                disconnect();
+                result = -1;
+                break;
+
+                case SSL_ERROR_WANT_READ:
+                case SSL_ERROR_WANT_WRITE:
+                result = 0; // wrote nothing
+                break;
+
+                default:
+                result = -1;
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
 }
 
 }
@@ -152,6 +152,16 @@ public:
      */
     EXPORT_STEM virtual bool write(const std::string &data) override;
 
+    /**
+     * Function to write data to the socket without waiting; returns the number of bytes written, zero if the
+     * socket cannot accept the data at present (in which case the same data must be written again), or a
+     * negative value upon error
+     * @param pData  a pointer to the character sequence to be written to the socket
+     * @param length the number of characters to be written
+     */
+    EXPORT_STEM virtual long write(const char *pData,
+                                   std::size_t length) override;
+
 private:
 
     /**
@@ -0,0 +1,798 @@
+#include "cartesianMotionState.h"
+#include "compositeFrameTransform.h"
+#include "euler_state_derivative_type.h"
+#include "eulers.h"
+#include "frameState.h"
+#include "referenceFrame.h"
+#include "rotation_type.h"
+#include "state_derivative_type.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <iostream>
+
+// using namespace declarations
+using namespace math::geometric::orientation;
+using namespace math::linear_algebra::vector;
+using namespace math::number_systems::complex;
+using namespace utilities;
+
+namespace physics
+{
+
+namespace kinematics
+{
+
+// type alias declarations
+using tMatrix = CompositeFrameTransform::tMatrix;
+using tVector = CompositeFrameTransform::tVector;
+
+/**
+ * the number of states transformed per block by the structure-of-arrays kernel
+ */
+static constexpr std::size_t BLOCK_SIZE = 64;
+
+/**
+ * the minimum number of states transformed by each thread when a batch is split across multiple threads
+ */
+static constexpr std::size_t MINIMUM_STATES_PER_THREAD = 2048;
+
+/**
+ * Function to compute the matrix which, when pre-multiplied with a vector, is equivalent to the cross product
+ * of the input vector with that vector
+ */
+static tMatrix calcCrossProductMatrix(const Vector3d &vector)
+{
+    return tMatrix(0.0, -vector[2], vector[1],
+                   vector[2], 0.0, -vector[0],
+                   -vector[1], vector[0], 0.0);
+}
+
+/**
+ * Function to compute the rotation matrix which is equivalent to Vector3d::rotate() with the input quaternion
+ */
+static tMatrix calcRotationMatrix(const Quat &quat)
+{
+    tMatrix matrix;
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+        Vector3d column;
+        column[j] = 1.0;
+        column.rotate(quat);
+        for (std::size_t i = 0; i < 3; ++i)
+            matrix(i, j) = column[i];
+    }
+
+    return matrix;
+}
+
+/**
+ * Construct a spatial-only (by default) transformation from the source frame to the destination frame
+ * @param pSourceFrame      the frame in which input motion states are defined
+ * @param pDestinationFrame the frame into which input motion states are transformed
+ * @param bTemporal         flag indicating whether or not a temporal transformation will take place. If true,
+ *                          motion states will be projected to the time at which the destination frame is
+ *                          defined
+ * @param state             the desired perturbation state of the reference frames
+ */
+CompositeFrameTransform::CompositeFrameTransform(const ReferenceFrame *pSourceFrame,
+                                                 const ReferenceFrame *pDestinationFrame,
+                                                 bool bTemporal,
+                                                 const std::string &state)
+: m_bCompiled(false),
+  m_bTemporal(bTemporal),
+  m_maximumThreads(1),
+  m_pDestinationFrame(pDestinationFrame),
+  m_pDestinationFrameState(nullptr),
+  m_pSourceFrame(pSourceFrame),
+  m_state(state),
+  m_t(0.0),
+  m_bUseDestinationTime(true)
+{
+
+}
+
+/**
+ * Construct a spatial and temporal transformation from the source frame to the destination frame
+ * @param pSourceFrame      the frame in which input motion states are defined
+ * @param pDestinationFrame the frame into which input motion states are transformed
+ * @param t                 the time to which the frames and motion states will be projected
+ * @param state             the desired perturbation state of the reference frames
+ */
+CompositeFrameTransform::CompositeFrameTransform(const ReferenceFrame *pSourceFrame,
+                                                 const ReferenceFrame *pDestinationFrame,
+                                                 double t,
+                                                 const std::string &state)
+: m_bCompiled(false),
+  m_bTemporal(true),
+  m_maximumThreads(1),
+  m_pDestinationFrame(pDestinationFrame),
+  m_pDestinationFrameState(nullptr),
+  m_pSourceFrame(pSourceFrame),
+  m_state(state),
+  m_t(t),
+  m_bUseDestinationTime(false)
+{
+
+}
+
+/**
+ * Copy constructor; the copy is compiled upon first use
+ */
+CompositeFrameTransform::CompositeFrameTransform(const CompositeFrameTransform &transform)
+: m_bCompiled(false),
+  m_bTemporal(transform.m_bTemporal),
+  m_maximumThreads(transform.m_maximumThreads),
+  m_pDestinationFrame(transform.m_pDestinationFrame),
+  m_pDestinationFrameState(nullptr),
+  m_pSourceFrame(transform.m_pSourceFrame),
+  m_state(transform.m_state),
+  m_t(transform.m_t),
+  m_bUseDestinationTime(transform.m_bUseDestinationTime)
+{
+
+}
+
+/**
+ * Move constructor
+ */
+CompositeFrameTransform::CompositeFrameTransform(CompositeFrameTransform &&transform)
+{
+    operator = (std::move(transform));
+}
+
+/**
+ * Destructor
+ */
+CompositeFrameTransform::~CompositeFrameTransform(void)
+{
+
+}
+
+/**
+ * Copy assignment operator; the copy is compiled upon first use
+ */
+CompositeFrameTransform &CompositeFrameTransform::operator = (const CompositeFrameTransform &transform)
+{
+    if (&transform != this)
+    {
+        m_bCompiled = false;
+        m_bTemporal = transform.m_bTemporal;
+        m_hops.clear();
+        setMaximumThreads(transform.m_maximumThreads);
+        m_pDestinationFrame = transform.m_pDestinationFrame;
+        m_pDestinationFrameState = nullptr;
+        m_pSourceFrame = transform.m_pSourceFrame;
+        m_state = transform.m_state;
+        m_t = transform.m_t;
+        m_bUseDestinationTime = transform.m_bUseDestinationTime;
+    }
+
+    return *this;
+}
+
+/**
+ * Move assignment operator
+ */
+CompositeFrameTransform &CompositeFrameTransform::operator = (CompositeFrameTransform &&transform)
+{
+    if (&transform != this)
+    {
+        m_bCompiled = std::move(transform.m_bCompiled);
+        m_bTemporal = std::move(transform.m_bTemporal);
+        m_destinationFrameRevision = std::move(transform.m_destinationFrameRevision);
+        m_destinationFrameStateRevision = std::move(transform.m_destinationFrameStateRevision);
+        m_hops = std::move(transform.m_hops);
+        m_maximumThreads = std::move(transform.m_maximumThreads);
+        m_pCartesianMotionState = std::move(transform.m_pCartesianMotionState);
+        m_pDestinationFrame = std::move(transform.m_pDestinationFrame);
+        m_pDestinationFrameState = std::move(transform.m_pDestinationFrameState);
+        m_pSourceFrame = std::move(transform.m_pSourceFrame);
+        m_pThreadPool = std::move(transform.m_pThreadPool);
+        m_state = std::move(transform.m_state);
+        m_t = std::move(transform.m_t);
+        m_bUseDestinationTime = std::move(transform.m_bUseDestinationTime);
+        m_transform = std::move(transform.m_transform);
+
+        transform.m_bCompiled = false;
+    }
+
+    return *this;
+}
+
+/**
+ * Append a frame to the compiled path
+ * @param pFrame   the frame through which the motion state passes
+ * @param bToChild flag indicating whether the hop is into the frame from its parent (true) or out of the frame
+ *                 to its parent (false)
+ */
+bool CompositeFrameTransform::appendFrame(const ReferenceFrame *pFrame,
+                                          bool bToChild)
+{
+    auto *pFrameState = pFrame->getFrameState(m_state);
+    bool bSuccess = (pFrameState != nullptr);
+    if (bSuccess)
+    {
+        auto t = m_bTemporal ? m_t : pFrame->getTime(m_state);
+        auto &&orientation = pFrame->getOrientation(t, m_state);
+
+        FrameHop hop;
+        hop.m_bToChild = bToChild;
+        hop.m_bFrameHasOrientation = (orientation != 0.0);
+        hop.m_frameAngularAcceleration = pFrame->calcAngularAcceleration(t, m_state);
+        hop.m_frameAngularVelocity = pFrame->calcAngularVelocity(t, m_state);
+        hop.m_frameOrientationQuat = Quat(1.0);
+        if (hop.m_bFrameHasOrientation)
+            hop.m_frameOrientationQuat = orientation.calcQuaternion(bToChild ? RotationType::Passive :
+                                                                               RotationType::Active);
+
+        hop.m_frameRevision = pFrame->getRevision();
+        hop.m_frameStateRevision = pFrameState->getRevision();
+        hop.m_pFrame = pFrame;
+        hop.m_pFrameState = pFrameState;
+
+        // the translational part of each hop is composed of a shift by the frame origin, velocity and
+        // acceleration, a rotation, and the terms induced by the frame angular velocity and acceleration
+        AffineTransform rotation, shift, spin;
+        rotation.m_R = calcRotationMatrix(hop.m_frameOrientationQuat);
+        shift.m_R = tMatrix::identity();
+        shift.m_ba = tVector::fromArray(pFrame->getAcceleration(m_state));
+        shift.m_bp = tVector::fromArray(pFrame->getOrigin(t, m_state));
+        shift.m_bv = tVector::fromArray(pFrame->getVelocity(t, m_state));
+        spin.m_R = tMatrix::identity();
+        if (bToChild)
+        {
+            // v' = v + w x p, a' = a + 2 w x v + w x (w x p) + alpha x p
+            auto &&A = calcCrossProductMatrix(hop.m_frameAngularAcceleration);
+            auto &&W = calcCrossProductMatrix(hop.m_frameAngularVelocity);
+            spin.m_Vp = W;
+            spin.m_Av = 2.0 * W;
+            spin.m_Ap = W * W + A;
+
+            shift.m_ba = -shift.m_ba;
+            shift.m_bp = -shift.m_bp;
+            shift.m_bv = -shift.m_bv;
+
+            m_transform = compose(spin, compose(rotation, compose(shift, m_transform)));
+        }
+        else
+        {
+            // the frame angular velocity and acceleration are rotated into the parent frame
+            auto rotatedAngularAcceleration = hop.m_frameAngularAcceleration;
+            auto rotatedAngularVelocity = hop.m_frameAngularVelocity;
+            rotatedAngularAcceleration.rotate(hop.m_frameOrientationQuat);
+            rotatedAngularVelocity.rotate(hop.m_frameOrientationQuat);
+
+            // v' = v - w x p, a' = a - 2 w x v + w x (w x p) - alpha x p
+            auto &&A = calcCrossProductMatrix(rotatedAngularAcceleration);
+            auto &&W = calcCrossProductMatrix(rotatedAngularVelocity);
+            spin.m_Vp = -W;
+            spin.m_Av = -2.0 * W;
+            spin.m_Ap = W * W - A;
+
+            m_transform = compose(shift, compose(spin, compose(rotation, m_transform)));
+        }
+
+        m_hops.push_back(hop);
+    }
+
+    return bSuccess;
+}
+
+/**
+ * Transform the input motion state to the destination frame; the transformation is (re)compiled if it has not
+ * yet been compiled or if any frame on the path has changed since it was compiled. Motion states that are not
+ * defined in the source frame, or for which transformation caching or debugging is enabled, are transformed via
+ * ReferenceFrame::transformToFrame()
+ */
+bool CompositeFrameTransform::apply(MotionState *pMotionState)
+{
+    bool bSuccess = (pMotionState != nullptr && m_pDestinationFrame != nullptr);
+    if (bSuccess)
+    {
+        bool bCompiled = isValid() || compile();
+        if (!bCompiled || pMotionState->getFrame() != m_pSourceFrame ||
+            pMotionState->cacheTransformationsEnabled() || pMotionState->debugTransformsEnabled())
+        {
+            if (!m_bTemporal)
+                return m_pDestinationFrame->transformToFrame(pMotionState, false, m_state);
+            else if (m_bUseDestinationTime)
+                return m_pDestinationFrame->transformToFrame(pMotionState, true, m_state);
+            else
+                return m_pDestinationFrame->transformToFrame(pMotionState, m_t, m_state);
+        }
+
+        // update the motion state to time t
+        if (m_bTemporal && pMotionState->getTime() != m_t)
+            pMotionState->update(m_t - pMotionState->getTime());
+
+        if (m_hops.empty())
+            return bSuccess;
+
+        CartesianMotionState *pCartesianMotionState = nullptr;
+        if (pMotionState->isCartesian())
+            pCartesianMotionState = dynamic_cast<CartesianMotionState *>(pMotionState);
+        else
+        {
+            // reuse the scratch motion state rather than allocating one per transformation
+            if (m_pCartesianMotionState == nullptr)
+                m_pCartesianMotionState.reset(new CartesianMotionState(*pMotionState));
+            else
+                m_pCartesianMotionState->assign(pMotionState);
+
+            pCartesianMotionState = m_pCartesianMotionState.get();
+        }
+
+        transformTranslationalState(pCartesianMotionState);
+        transformBodyState(pCartesianMotionState);
+        pCartesianMotionState->setFrame(const_cast<ReferenceFrame *>(m_pDestinationFrame));
+
+        if (pMotionState != pCartesianMotionState)
+            pMotionState->assign(pCartesianMotionState);
+    }
+
+    return bSuccess;
+}
+
+/**
+ * Transform a batch of motion states to the destination frame. Cartesian motion states defined in the source
+ * frame (without transformation caching or debugging enabled) are transformed in blocks, in parallel if
+ * multithreading is enabled; all others are transformed individually via apply(MotionState *)
+ * @param motionStates a vector of pointers to the motion states to be transformed
+ */
+bool CompositeFrameTransform::apply(const std::vector<MotionState *> &motionStates)
+{
+    bool bSuccess = (m_pDestinationFrame != nullptr);
+    if (bSuccess)
+    {
+        bool bCompiled = isValid() || compile();
+
+        // separate the motion states that can be transformed in blocks from those that cannot
+        std::vector<CartesianMotionState *> cartesianMotionStates;
+        cartesianMotionStates.reserve(motionStates.size());
+        for (auto *pMotionState : motionStates)
+        {
+            if (bCompiled && pMotionState != nullptr && pMotionState->isCartesian() &&
+                pMotionState->getFrame() == m_pSourceFrame && !pMotionState->cacheTransformationsEnabled() &&
+                !pMotionState->debugTransformsEnabled())
+            {
+                cartesianMotionStates.push_back(static_cast<CartesianMotionState *>(pMotionState));
+            }
+            else
+                bSuccess &= apply(pMotionState);
+        }
+
+        // each range gathers the translational states of its motion states into blocks, transforms the blocks
+        // and scatters the results; the motion states' frames are updated afterward, since doing so modifies
+        // the frames' lists of associated motion states
+        parallelize(cartesianMotionStates.size(), [this, &cartesianMotionStates] (std::size_t begin,
+                                                                                   std::size_t end)
+        {
+            double block[9][BLOCK_SIZE];
+            double *const position[] = { block[0], block[1], block[2] };
+            double *const velocity[] = { block[3], block[4], block[5] };
+            double *const acceleration[] = { block[6], block[7], block[8] };
+            for (std::size_t i = begin; i < end; i += BLOCK_SIZE)
+            {
+                auto numStates = std::min(BLOCK_SIZE, end - i);
+                for (std::size_t j = 0; j < numStates; ++j)
+                {
+                    auto *pCartesianMotionState = cartesianMotionStates[i + j];
+                    if (m_bTemporal && pCartesianMotionState->getTime() != m_t)
+                        pCartesianMotionState->update(m_t - pCartesianMotionState->getTime());
+
+                    if (m_hops.empty())
+                        continue;
+
+                    auto &a = (*pCartesianMotionState)[StateDerivativeType::Acceleration];
+                    auto &p = (*pCartesianMotionState)[StateDerivativeType::Position];
+                    auto &v = (*pCartesianMotionState)[StateDerivativeType::Velocity];
+                    for (std::size_t k = 0; k < 3; ++k)
+                    {
+                        acceleration[k][j] = a[k];
+                        position[k][j] = p[k];
+                        velocity[k][j] = v[k];
+                    }
+                }
+
+                if (m_hops.empty())
+                    continue;
+
+                transformTranslationalStates(0, numStates, position, velocity, acceleration);
+                for (std::size_t j = 0; j < numStates; ++j)
+                {
+                    auto *pCartesianMotionState = cartesianMotionStates[i + j];
+                    auto &a = (*pCartesianMotionState)[StateDerivativeType::Acceleration];
+                    auto &p = (*pCartesianMotionState)[StateDerivativeType::Position];
+                    auto &v = (*pCartesianMotionState)[StateDerivativeType::Velocity];
+                    for (std::size_t k = 0; k < 3; ++k)
+                    {
+                        a[k] = acceleration[k][j];
+                        p[k] = position[k][j];
+                        v[k] = velocity[k][j];
+                    }
+
+                    transformBodyState(pCartesianMotionState);
+                }
+            }
+        });
+
+        for (auto *pCartesianMotionState : cartesianMotionStates)
+            pCartesianMotionState->setFrame(const_cast<ReferenceFrame *>(m_pDestinationFrame));
+    }
+
+    return bSuccess;
+}
+
+/**
+ * Transform a batch of positions, velocities and accelerations defined in the source frame to the destination
+ * frame. Each argument is an array of three pointers to contiguous arrays of numStates x, y and z components,
+ * respectively; the arrays are updated in place and must not overlap. Velocities and accelerations are
+ * optional, but accelerations cannot be transformed without velocities. If the transformation is temporal, the
+ * input states are assumed to be defined at the time to which the frames are projected
+ * @param numStates    the number of states in the batch
+ * @param position     the x, y and z position component arrays
+ * @param velocity     the x, y and z velocity component arrays (optional)
+ * @param acceleration the x, y and z acceleration component arrays (optional)
+ */
+bool CompositeFrameTransform::apply(std::size_t numStates,
+                                    double *const position[3],
+                                    double *const velocity[3],
+                                    double *const acceleration[3])
+{
+    bool bSuccess = (position != nullptr && (acceleration == nullptr || velocity != nullptr));
+    if (bSuccess)
+    {
+        bSuccess = isValid() || compile();
+        if (bSuccess && !m_hops.empty())
+        {
+            parallelize(numStates, [&] (std::size_t begin, std::size_t end)
+            {
+                transformTranslationalStates(begin, end, position, velocity, acceleration);
+            });
+        }
+    }
+    else
+    {
+        logMsg(std::cout, LoggingLevel::Enum::Warning,
+               "Position arrays must be specified, and velocity arrays must be specified in order to transform "
+               "accelerations.\n",
+               getQualifiedMethodName(__func__));
+    }
+
+    return bSuccess;
+}
+
+/**
+ * Compile the path from the source frame to the destination frame
+ */
+bool CompositeFrameTransform::compile(void)
+{
+    m_bCompiled = false;
+    m_hops.clear();
+    m_pDestinationFrameState = nullptr;
+    m_transform = AffineTransform();
+    m_transform.m_R = tMatrix::identity();
+
+    bool bSuccess = (m_pSourceFrame != nullptr && m_pSourceFrame->isFamily(m_pDestinationFrame));
+    if (bSuccess && m_bTemporal && m_bUseDestinationTime)
+    {
+        auto *pFrameState = m_pDestinationFrame->getFrameState(m_state);
+        bSuccess = (pFrameState != nullptr);
+        if (bSuccess)
+        {
+            m_destinationFrameRevision = m_pDestinationFrame->getRevision();
+            m_destinationFrameStateRevision = pFrameState->getRevision();
+            m_pDestinationFrameState = pFrameState;
+            m_t = pFrameState->getTime();
+        }
+    }
+
+    if (bSuccess)
+    {
+        // transform out of frames from the source frame up to the nearest common ancestor
+        auto *pFrame = m_pSourceFrame;
+        while (bSuccess && pFrame != m_pDestinationFrame && !pFrame->isAncestor(m_pDestinationFrame))
+        {
+            bSuccess = appendFrame(pFrame, false);
+            pFrame = pFrame->getParent();
+            bSuccess &= (pFrame != nullptr);
+        }
+
+        // transform into frames from the nearest common ancestor down to the destination frame
+        std::vector<const ReferenceFrame *> frames;
+        for (auto *pChildFrame = m_pDestinationFrame; bSuccess && pChildFrame != pFrame;)
+        {
+            frames.push_back(pChildFrame);
+            pChildFrame = pChildFrame->getParent();
+            bSuccess = (pChildFrame != nullptr);
+        }
+
+        for (auto itFrame = frames.crbegin(); bSuccess && itFrame != frames.crend(); ++itFrame)
+            bSuccess = appendFrame(*itFrame, true);
+    }
+
+    if (!bSuccess)
+    {
+        logMsg(std::cout, LoggingLevel::Enum::Warning,
+               "The source and destination frames are not related (they do not exist within the same tree); "
+               "the transformation could not be compiled.\n",
+               getQualifiedMethodName(__func__));
+    }
+
+    m_bCompiled = bSuccess;
+
+    return bSuccess;
+}
+
+/**
+ * Compose two affine transformations, returning first followed by second
+ */
+CompositeFrameTransform::AffineTransform
+CompositeFrameTransform::compose(const AffineTransform &second,
+                                 const AffineTransform &first)
+{
+    AffineTransform result;
+    result.m_R = second.m_R * first.m_R;
+    result.m_Vp = second.m_R * first.m_Vp + second.m_Vp * first.m_R;
+    result.m_Av = second.m_R * first.m_Av + second.m_Av * first.m_R;
+    result.m_Ap = second.m_R * first.m_Ap + second.m_Av * first.m_Vp + second.m_Ap * first.m_R;
+    result.m_bp = second.m_R * first.m_bp + second.m_bp;
+    result.m_bv = second.m_R * first.m_bv + second.m_Vp * first.m_bp + second.m_bv;
+    result.m_ba = second.m_R * first.m_ba + second.m_Av * first.m_bv + second.m_Ap * first.m_bp + second.m_ba;
+
+    return result;
+}
+
+/**
+ * Get the name of this class
+ */
+std::string CompositeFrameTransform::getClassName(void) const
+{
+    return "CompositeFrameTransform";
+}
+
+/**
+ * Get the destination frame
+ */
+const ReferenceFrame *CompositeFrameTransform::getDestinationFrame(void) const
+{
+    return m_pDestinationFrame;
+}
+
+/**
+ * Get the maximum number of threads used to transform batches (default is one, i.e., single-threaded)
+ */
+std::size_t CompositeFrameTransform::getMaximumThreads(void) const
+{
+    return m_maximumThreads;
+}
+
+/**
+ * Get the number of frames through which motion states are transformed
+ */
+std::size_t CompositeFrameTransform::getPathLength(void) const
+{
+    return m_hops.size();
+}
+
+/**
+ * Get the source frame
+ */
+const ReferenceFrame *CompositeFrameTransform::getSourceFrame(void) const
+{
+    return m_pSourceFrame;
+}
+
+/**
+ * Determine whether or not this transformation has been compiled and remains consistent with the frames on its
+ * path
+ */
+bool CompositeFrameTransform::isValid(void) const
+{
+    // a frame's state is compared only once the frame itself is known to be unchanged, since a change to the
+    // frame may have deleted that state
+    bool bValid = m_bCompiled;
+    if (bValid && m_pDestinationFrameState != nullptr)
+        bValid = m_pDestinationFrame->getRevision() == m_destinationFrameRevision &&
+                 m_pDestinationFrameState->getRevision() == m_destinationFrameStateRevision;
+
+    for (auto itHop = m_hops.cbegin(); bValid && itHop != m_hops.cend(); ++itHop)
+        bValid = itHop->m_pFrame->getRevision() == itHop->m_frameRevision &&
+                 itHop->m_pFrameState->getRevision() == itHop->m_frameStateRevision;
+
+    return bValid;
+}
+
+/**
+ * Apply a function to disjoint ranges of a batch, using multiple threads if the batch is large enough and
+ * multithreading is enabled
+ * @param function a binary function object which accepts the beginning and end of a range of the batch
+ */
+void CompositeFrameTransform::parallelize(std::size_t numStates,
+                                          const std::function<void (std::size_t, std::size_t)> &function)
+{
+    auto numThreads = std::min(m_maximumThreads, numStates / MINIMUM_STATES_PER_THREAD);
+    if (numThreads <= 1)
+    {
+        function(0, numStates);
+
+        return;
+    }
+
+    if (m_pThreadPool == nullptr)
+        m_pThreadPool.reset(new ThreadPool<bool>(m_maximumThreads));
+
+    // range boundaries fall on block boundaries
+    m_pThreadPool->forEachRange(numStates, numThreads, BLOCK_SIZE, function);
+}
+
+/**
+ * Set the maximum number of threads used to transform batches
+ */
+void CompositeFrameTransform::setMaximumThreads(std::size_t maximumThreads)
+{
+    m_maximumThreads = std::max<std::size_t>(1, maximumThreads);
+    if (m_pThreadPool != nullptr)
+        m_pThreadPool->setMaximumThreads(m_maximumThreads);
+}
+
+/**
+ * Transform the body orientation, Euler rates and Euler accelerations of the input motion state
+ */
+void CompositeFrameTransform::transformBodyState(CartesianMotionState *pCartesianMotionState) const
+{
+    auto &bodyEulers = (*pCartesianMotionState)[EulerStateDerivativeType::Eulers];
+    auto &bodyEulerRates = (*pCartesianMotionState)[EulerStateDerivativeType::Rates];
+    auto &bodyEulerAccelerations = (*pCartesianMotionState)[EulerStateDerivativeType::Accelerations];
+
+    Quat bodyOrientQuat(1.0);
+    auto &&angleUnits = pCartesianMotionState->getAngleUnits();
+    if (bodyEulers != 0.0)
+        bodyOrientQuat = bodyEulers.calcQuaternion(RotationType::Active);
+
+    // calculate body angular velocity and acceleration
+    Vector3d bodyAngularAcceleration, bodyAngularVelocity;
+    bool bBodyHasAngularVelocity = (bodyEulerRates != 0.0);
+    if (bBodyHasAngularVelocity)
+        bodyAngularVelocity = bodyEulers.calcBodyRates(bodyEulerRates);
+
+    if (bBodyHasAngularVelocity || bodyEulerAccelerations != 0.0)
+        bodyAngularAcceleration = bodyEulers.calcBodyAccelerations(bodyEulerRates, bodyEulerAccelerations);
+
+    // carry the body orientation and angular motion through each frame; this is equivalent to the frame-by-
+    // frame updates performed by ReferenceFrame, without the intermediate conversions to and from Euler angles
+    bool bBodyOrientationChanged = false;
+    for (auto &&hop : m_hops)
+    {
+        if (hop.m_bToChild && hop.m_bFrameHasOrientation)
+        {
+            bodyOrientQuat = hop.m_frameOrientationQuat * bodyOrientQuat;
+            bBodyOrientationChanged = true;
+        }
+
+        auto frameAngularAcceleration = hop.m_frameAngularAcceleration;
+        auto frameAngularVelocity = hop.m_frameAngularVelocity;
+        frameAngularAcceleration.rotate(bodyOrientQuat);
+        frameAngularVelocity.rotate(bodyOrientQuat);
+        if (hop.m_bToChild)
+        {
+            bodyAngularAcceleration += frameAngularAcceleration;
+            bodyAngularAcceleration += frameAngularVelocity.calcCross(bodyAngularVelocity);
+            bodyAngularVelocity += frameAngularVelocity;
+        }
+        else
+        {
+            bodyAngularAcceleration -= frameAngularAcceleration;
+            bodyAngularAcceleration -= frameAngularVelocity.calcCross(bodyAngularVelocity);
+            bodyAngularVelocity -= frameAngularVelocity;
+
+            if (hop.m_bFrameHasOrientation)
+            {
+                bodyOrientQuat = hop.m_frameOrientationQuat * bodyOrientQuat;
+                bBodyOrientationChanged = true;
+            }
+        }
+    }
+
+    if (bBodyOrientationChanged)
+        bodyEulers = bodyOrientQuat.calcEulers(angleUnits, RotationType::Active);
+
+    bodyEulerRates = bodyEulers.calcEulerRates(bodyAngularVelocity, angleUnits);
+    bodyEulerAccelerations = bodyEulers.calcEulerAccelerations(bodyAngularVelocity, bodyAngularAcceleration,
+                                                               angleUnits);
+}
+
+/**
+ * Transform the position, velocity and acceleration of the input motion state
+ */
+void CompositeFrameTransform::transformTranslationalState(CartesianMotionState *pCartesianMotionState) const
+{
+    // Note that the position, velocity and acceleration are intentionally accessed in this way so that we can
+    // get a reference to each 3d vector
+    auto &acceleration = (*pCartesianMotionState)[StateDerivativeType::Acceleration];
+    auto &position = (*pCartesianMotionState)[StateDerivativeType::Position];
+    auto &velocity = (*pCartesianMotionState)[StateDerivativeType::Velocity];
+
+    auto &&a = tVector::fromArray(acceleration);
+    auto &&p = tVector::fromArray(position);
+    auto &&v = tVector::fromArray(velocity);
+
+    (m_transform.m_R * a + m_transform.m_Av * v + m_transform.m_Ap * p + m_transform.m_ba).toArray(acceleration);
+    (m_transform.m_R * p + m_transform.m_bp).toArray(position);
+    (m_transform.m_R * v + m_transform.m_Vp * p + m_transform.m_bv).toArray(velocity);
+}
+
+/**
+ * Transform a range of positions, velocities and accelerations stored in structure-of-arrays form; each block of
+ * states is transformed into local arrays (so that the compiler need not account for aliasing between the
+ * component arrays when vectorizing the kernel) and then copied back
+ * @param begin        the index of the first state in the range
+ * @param end          one past the index of the last state in the range
+ * @param position     the x, y and z position component arrays
+ * @param velocity     the x, y and z velocity component arrays (may be null)
+ * @param acceleration the x, y and z acceleration component arrays (may be null)
+ */
+void CompositeFrameTransform::transformTranslationalStates(std::size_t begin,
+                                                           std::size_t end,
+                                                           double *const position[3],
+                                                           double *const velocity[3],
+                                                           double *const acceleration[3]) const
+{
+    double Ap[3][3], Av[3][3], R[3][3], Vp[3][3], ba[3], bp[3], bv[3];
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            Ap[i][j] = m_transform.m_Ap(i, j);
+            Av[i][j] = m_transform.m_Av(i, j);
+            R[i][j] = m_transform.m_R(i, j);
+            Vp[i][j] = m_transform.m_Vp(i, j);
+        }
+
+        ba[i] = m_transform.m_ba[i];
+        bp[i] = m_transform.m_bp[i];
+        bv[i] = m_transform.m_bv[i];
+    }
+
+    double a[3][BLOCK_SIZE], p[3][BLOCK_SIZE], v[3][BLOCK_SIZE];
+    for (std::size_t i = begin; i < end; i += BLOCK_SIZE)
+    {
+        auto numStates = std::min(BLOCK_SIZE, end - i);
+        const double *px = position[0] + i, *py = position[1] + i, *pz = position[2] + i;
+        for (std::size_t k = 0; k < 3; ++k)
+            for (std::size_t j = 0; j < numStates; ++j)
+                p[k][j] = R[k][0] * px[j] + R[k][1] * py[j] + R[k][2] * pz[j] + bp[k];
+
+        if (velocity != nullptr)
+        {
+            const double *vx = velocity[0] + i, *vy = velocity[1] + i, *vz = velocity[2] + i;
+            for (std::size_t k = 0; k < 3; ++k)
+                for (std::size_t j = 0; j < numStates; ++j)
+                    v[k][j] = R[k][0] * vx[j] + R[k][1] * vy[j] + R[k][2] * vz[j] +
+                              Vp[k][0] * px[j] + Vp[k][1] * py[j] + Vp[k][2] * pz[j] + bv[k];
+
+            if (acceleration != nullptr)
+            {
+                const double *ax = acceleration[0] + i, *ay = acceleration[1] + i, *az = acceleration[2] + i;
+                for (std::size_t k = 0; k < 3; ++k)
+                    for (std::size_t j = 0; j < numStates; ++j)
+                        a[k][j] = R[k][0] * ax[j] + R[k][1] * ay[j] + R[k][2] * az[j] +
+                                  Av[k][0] * vx[j] + Av[k][1] * vy[j] + Av[k][2] * vz[j] +
+                                  Ap[k][0] * px[j] + Ap[k][1] * py[j] + Ap[k][2] * pz[j] + ba[k];
+
+                for (std::size_t k = 0; k < 3; ++k)
+                    std::copy(a[k], a[k] + numStates, acceleration[k] + i);
+            }
+
+            for (std::size_t k = 0; k < 3; ++k)
+                std::copy(v[k], v[k] + numStates, velocity[k] + i);
+        }
+
+        for (std::size_t k = 0; k < 3; ++k)
+            std::copy(p[k], p[k] + numStates, position[k] + i);
+    }
+}
+
+}
+
+}
@@ -0,0 +1,392 @@
+#ifndef COMPOSITE_FRAME_TRANSFORM_H
+#define COMPOSITE_FRAME_TRANSFORM_H
+
+#include "export_library.h"
+#include "fixed_matrix.h"
+#include "loggable.h"
+#include "quat.h"
+#include "reflective.h"
+#include "vector3d.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// if a default frame state is not specified in preprocessor configuration, then define the following
+#ifndef DEFAULT_FRAME_STATE
+#define DEFAULT_FRAME_STATE "default"
+#endif
+
+// forward declarations
+namespace utilities { template<typename> class ThreadPool; }
+
+namespace physics
+{
+
+namespace kinematics
+{
+
+// forward declarations
+class CartesianMotionState;
+class FrameState;
+class MotionState;
+class ReferenceFrame;
+
+/**
+ * This class compiles the chain of reference frames between a source frame and a destination frame into a
+ * single, flattened rigid-body transformation, which can then be applied to any number of motion states
+ * defined in the source frame without walking the frame tree. The translational part of the chain (position,
+ * velocity and acceleration, including the tangential, centrifugal, Coriolis and Euler terms induced by frame
+ * rotation rates and accelerations) is reduced to a single affine map; the rotational part retains only the
+ * per-frame quaternions and angular rates/accelerations needed to update a body's Euler angles, Euler rates
+ * and Euler accelerations. The results are equivalent to those of ReferenceFrame::transformToFrame().
+ *
+ * The compiled transformation records the revision of each frame on the path and of its frame state (see
+ * ReferenceFrame::getRevision() and FrameState::getRevision()); if any of these frames is modified, re-parented
+ * or updated to a new time, the transformation is recompiled automatically the next time it is applied.
+ * Frames on the path must outlive this object.
+ *
+ * Large numbers of objects can be transformed at once via the batch overloads of apply(), which accept either
+ * positions, velocities and accelerations stored in structure-of-arrays form or a collection of motion states
+ * (e.g., a slice of a MotionStateContainer). Batches are processed in fixed-size blocks using a branch-free
+ * kernel that the compiler can vectorize, and may optionally be split across worker threads (see
+ * setMaximumThreads()). Objects of this class are not thread-safe; each thread should use its own instance
+ */
+class CompositeFrameTransform final
+: public attributes::concrete::Loggable<std::string, std::ostream>,
+  virtual private attributes::abstract::Reflective
+{
+public:
+
+    /**
+     * Typedef declarations
+     */
+    typedef math::linear_algebra::matrix::FixedMatrix<3, 3> tMatrix;
+    typedef math::linear_algebra::matrix::FixedVector<3> tVector;
+
+private:
+
+    /**
+     * This structure stores an affine map of a position, velocity, acceleration triplet, of the form
+     *     p' = R * p + bp
+     *     v' = R * v + Vp * p + bv
+     *     a' = R * a + Av * v + Ap * p + ba
+     */
+    struct AffineTransform
+    {
+        tMatrix m_Ap, m_Av, m_R, m_Vp;
+        tVector m_ba, m_bp, m_bv;
+    };
+
+    /**
+     * This structure stores the information required to transform a body's orientation and angular motion
+     * through a single frame on the path
+     */
+    struct FrameHop
+    {
+        /**
+         * flag indicating whether the hop is into a child frame (true) or out to a parent frame (false)
+         */
+        bool m_bToChild;
+
+        /**
+         * flag indicating whether or not the frame has a non-zero orientation
+         */
+        bool m_bFrameHasOrientation;
+
+        /**
+         * the frame angular acceleration
+         */
+        math::linear_algebra::vector::Vector3d m_frameAngularAcceleration;
+
+        /**
+         * the frame angular velocity
+         */
+        math::linear_algebra::vector::Vector3d m_frameAngularVelocity;
+
+        /**
+         * the quaternion by which the body orientation is pre-multiplied
+         */
+        math::number_systems::complex::Quat m_frameOrientationQuat;
+
+        /**
+         * the revision of the frame at the time of compilation
+         */
+        std::size_t m_frameRevision;
+
+        /**
+         * the revision of the frame's state at the time of compilation
+         */
+        std::size_t m_frameStateRevision;
+
+        /**
+         * the frame through which the motion state passes
+         */
+        const ReferenceFrame *m_pFrame;
+
+        /**
+         * the frame's state at the time of compilation
+         */
+        const FrameState *m_pFrameState;
+    };
+
+public:
+
+    /**
+     * Construct a spatial-only (by default) transformation from the source frame to the destination frame
+     * @param pSourceFrame      the frame in which input motion states are defined
+     * @param pDestinationFrame the frame into which input motion states are transformed
+     * @param bTemporal         flag indicating whether or not a temporal transformation will take place. If
+     *                          true, motion states will be projected to the time at which the destination frame
+     *                          is defined
+     * @param state             the desired perturbation state of the reference frames
+     */
+    EXPORT_STEM CompositeFrameTransform(const ReferenceFrame *pSourceFrame,
+                                        const ReferenceFrame *pDestinationFrame,
+                                        bool bTemporal = false,
+                                        const std::string &state = DEFAULT_FRAME_STATE);
+
+    /**
+     * Construct a spatial and temporal transformation from the source frame to the destination frame
+     * @param pSourceFrame      the frame in which input motion states are defined
+     * @param pDestinationFrame the frame into which input motion states are transformed
+     * @param t                 the time to which the frames and motion states will be projected
+     * @param state             the desired perturbation state of the reference frames
+     */
+    EXPORT_STEM CompositeFrameTransform(const ReferenceFrame *pSourceFrame,
+                                        const ReferenceFrame *pDestinationFrame,
+                                        double t,
+                                        const std::string &state = DEFAULT_FRAME_STATE);
+
+    /**
+     * Copy constructor; the copy is compiled upon first use
+     */
+    EXPORT_STEM CompositeFrameTransform(const CompositeFrameTransform &transform);
+
+    /**
+     * Move constructor
+     */
+    EXPORT_STEM CompositeFrameTransform(CompositeFrameTransform &&transform);
+
+    /**
+     * Destructor
+     */
+    EXPORT_STEM virtual ~CompositeFrameTransform(void) override;
+
+    /**
+     * Copy assignment operator; the copy is compiled upon first use
+     */
+    EXPORT_STEM CompositeFrameTransform &operator = (const CompositeFrameTransform &transform);
+
+    /**
+     * Move assignment operator
+     */
+    EXPORT_STEM CompositeFrameTransform &operator = (CompositeFrameTransform &&transform);
+
+    /**
+     * Transform the input motion state to the destination frame; the transformation is (re)compiled if it has
+     * not yet been compiled or if any frame on the path has changed since it was compiled. Motion states that
+     * are not defined in the source frame, or for which transformation caching or debugging is enabled, are
+     * transformed via ReferenceFrame::transformToFrame()
+     */
+    EXPORT_STEM bool apply(MotionState *pMotionState);
+
+    /**
+     * Transform a batch of motion states to the destination frame. Cartesian motion states defined in the
+     * source frame (without transformation caching or debugging enabled) are transformed in blocks, in parallel
+     * if multithreading is enabled; all others are transformed individually via apply(MotionState *)
+     * @param motionStates a vector of pointers to the motion states to be transformed
+     */
+    EXPORT_STEM bool apply(const std::vector<MotionState *> &motionStates);
+
+    /**
+     * Transform a batch of positions, velocities and accelerations defined in the source frame to the
+     * destination frame. Each argument is an array of three pointers to contiguous arrays of numStates
+     * x, y and z components, respectively; the arrays are updated in place and must not overlap. Velocities
+     * and accelerations are optional, but accelerations cannot be transformed without velocities. If the
+     * transformation is temporal, the input states are assumed to be defined at the time to which the frames
+     * are projected
+     * @param numStates    the number of states in the batch
+     * @param position     the x, y and z position component arrays
+     * @param velocity     the x, y and z velocity component arrays (optional)
+     * @param acceleration the x, y and z acceleration component arrays (optional)
+     */
+    EXPORT_STEM bool apply(std::size_t numStates,
+                           double *const position[3],
+                           double *const velocity[3] = nullptr,
+                           double *const acceleration[3] = nullptr);
+
+    /**
+     * Compile the path from the source frame to the destination frame
+     */
+    EXPORT_STEM bool compile(void);
+
+    /**
+     * Get the name of this class
+     */
+    EXPORT_STEM virtual std::string getClassName(void) const override;
+
+    /**
+     * Get the destination frame
+     */
+    EXPORT_STEM const ReferenceFrame *getDestinationFrame(void) const;
+
+    /**
+     * Get the maximum number of threads used to transform batches (default is one, i.e., single-threaded)
+     */
+    EXPORT_STEM std::size_t getMaximumThreads(void) const;
+
+    /**
+     * Get the number of frames through which motion states are transformed
+     */
+    EXPORT_STEM std::size_t getPathLength(void) const;
+
+    /**
+     * Get the source frame
+     */
+    EXPORT_STEM const ReferenceFrame *getSourceFrame(void) const;
+
+    /**
+     * Determine whether or not this transformation has been compiled and remains consistent with the frames
+     * on its path
+     */
+    EXPORT_STEM bool isValid(void) const;
+
+    /**
+     * Set the maximum number of threads used to transform batches
+     */
+    EXPORT_STEM void setMaximumThreads(std::size_t maximumThreads);
+
+private:
+
+    /**
+     * Append a frame to the compiled path
+     * @param pFrame   the frame through which the motion state passes
+     * @param bToChild flag indicating whether the hop is into the frame from its parent (true) or out of the
+     *                 frame to its parent (false)
+     */
+    EXPORT_STEM bool appendFrame(const ReferenceFrame *pFrame,
+                                 bool bToChild);
+
+    /**
+     * Compose two affine transformations, returning first followed by second
+     */
+    static EXPORT_STEM AffineTransform compose(const AffineTransform &second,
+                                               const AffineTransform &first);
+
+    /**
+     * Apply a function to disjoint ranges of a batch, using multiple threads if the batch is large enough and
+     * multithreading is enabled
+     * @param function a binary function object which accepts the beginning and end of a range of the batch
+     */
+    EXPORT_STEM void parallelize(std::size_t numStates,
+                                 const std::function<void (std::size_t, std::size_t)> &function);
+
+    /**
+     * Transform the body orientation, Euler rates and Euler accelerations of the input motion state
+     */
+    EXPORT_STEM void transformBodyState(CartesianMotionState *pCartesianMotionState) const;
+
+    /**
+     * Transform the position, velocity and acceleration of the input motion state
+     */
+    EXPORT_STEM void transformTranslationalState(CartesianMotionState *pCartesianMotionState) const;
+
+    /**
+     * Transform a range of positions, velocities and accelerations stored in structure-of-arrays form
+     * @param begin        the index of the first state in the range
+     * @param end          one past the index of the last state in the range
+     * @param position     the x, y and z position component arrays
+     * @param velocity     the x, y and z velocity component arrays (may be null)
+     * @param acceleration the x, y and z acceleration component arrays (may be null)
+     */
+    EXPORT_STEM void transformTranslationalStates(std::size_t begin,
+                                                  std::size_t end,
+                                                  double *const position[3],
+                                                  double *const velocity[3],
+                                                  double *const acceleration[3]) const;
+
+    /**
+     * flag indicating whether or not the transformation has been compiled
+     */
+    bool m_bCompiled;
+
+    /**
+     * flag indicating whether or not the transformation is temporal
+     */
+    bool m_bTemporal;
+
+    /**
+     * the revision of the destination frame at the time of compilation
+     */
+    std::size_t m_destinationFrameRevision;
+
+    /**
+     * the revision of the destination frame's state at the time of compilation
+     */
+    std::size_t m_destinationFrameStateRevision;
+
+    /**
+     * the frames on the path
+     */
+    std::vector<FrameHop> m_hops;
+
+    /**
+     * the maximum number of threads used to transform batches
+     */
+    std::size_t m_maximumThreads;
+
+    /**
+     * a scratch motion state used to transform non-Cartesian motion states
+     */
+    std::unique_ptr<CartesianMotionState> m_pCartesianMotionState;
+
+    /**
+     * pointer to the destination frame
+     */
+    const ReferenceFrame *m_pDestinationFrame;
+
+    /**
+     * the destination frame's state at the time of compilation, if the time of a temporal transformation is
+     * taken from the destination frame
+     */
+    const FrameState *m_pDestinationFrameState;
+
+    /**
+     * pointer to the source frame
+     */
+    const ReferenceFrame *m_pSourceFrame;
+
+    /**
+     * the thread pool used to transform batches; created upon first use
+     */
+    std::unique_ptr<utilities::ThreadPool<bool>> m_pThreadPool;
+
+    /**
+     * the desired perturbation state of the reference frames
+     */
+    std::string m_state;
+
+    /**
+     * the time to which the frames and motion states will be projected if performing a temporal
+     * transformation
+     */
+    double m_t;
+
+    /**
+     * flag indicating whether or not the time to which the frames and motion states will be projected is
+     * taken from the destination frame
+     */
+    bool m_bUseDestinationTime;
+
+    /**
+     * the compiled translational transformation
+     */
+    AffineTransform m_transform;
+};
+
+}
+
+}
+
+#endif
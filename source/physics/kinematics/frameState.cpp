@@ -35,6 +35,7 @@ FrameState::FrameState(const std::string &name,
                        const AngleUnitType &angleUnits)
 : m_angleUnits(angleUnits),
   m_name(name),
+  m_revision(0),
   m_t0(0.0)
 {
 
@@ -44,6 +45,7 @@ FrameState::FrameState(const std::string &name,
  * Copy constructor
  */
 FrameState::FrameState(const FrameState &state)
+: m_revision(0)
 {
     operator = (state);
 }
@@ -52,6 +54,7 @@ FrameState::FrameState(const FrameState &state)
  * Move constructor
  */
 FrameState::FrameState(FrameState &&state)
+: m_revision(0)
 {
     operator = (std::move(state));
 }
@@ -74,6 +77,8 @@ FrameState &FrameState::operator = (const FrameState &state)
         m_angleUnits = state.m_angleUnits;
         m_name = state.m_name;
         m_t0 = state.m_t0;
+
+        ++m_revision;
     }
 
     return *this;
@@ -138,6 +143,7 @@ bool FrameState::assign(const FrameState *pState)
  */
 std::istream &FrameState::deserialize(std::istream &stream)
 {
+    ++m_revision;
     if (stream)
     {
         stream.read((char *)&m_angleUnits, sizeof(int));
@@ -407,6 +413,15 @@ Eulers FrameState::getRotationalRates(double t) const
     return rotationalRates;
 }
 
+/**
+ * Get the revision of this frame state; the revision changes whenever the frame state is modified through any
+ * of its mutators, but not through the references returned by its non-const accessors
+ */
+std::size_t FrameState::getRevision(void) const
+{
+    return m_revision;
+}
+
 /**
  * Get the time at which this frame is currently defined
  */
@@ -500,6 +515,7 @@ double FrameState::getYawRate(const AngleUnitType &angleUnits) const
  */
 bool FrameState::initialize(void)
 {
+    ++m_revision;
     m_t0 = 0.0;
 
     initializeTimeDerivatives();
@@ -546,6 +562,8 @@ bool FrameState::readFromXML(xml_node<> *pNode)
     bool bSuccess = (pNode != nullptr && std::strcmp(pNode->name(), "frameState") == 0);
     if (bSuccess)
     {
+        ++m_revision;
+
         auto *pAngleUnitsNode = pNode->first_node("angleType");
         if (pAngleUnitsNode != nullptr)
             m_angleUnits = pAngleUnitsNode->value();
@@ -594,6 +612,7 @@ void FrameState::setAcceleration(const Vector3d &acceleration)
  */
 void FrameState::setName(const std::string &name)
 {
+    ++m_revision;
     m_name = name;
 }
 
@@ -660,6 +679,7 @@ void FrameState::setRollRate(double rollRate)
  */
 void FrameState::setTime(double t0)
 {
+    ++m_revision;
     m_t0 = t0;
 }
 
@@ -705,6 +725,9 @@ void FrameState::swap(FrameState &state)
     std::swap(m_angleUnits, state.m_angleUnits);
     std::swap(m_name, state.m_name);
     std::swap(m_t0, state.m_t0);
+
+    ++m_revision;
+    ++state.m_revision;
 }
 #ifdef RAPID_XML
 /**
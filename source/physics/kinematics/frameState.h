@@ -411,6 +411,12 @@ public:
      */
     EXPORT_STEM virtual Eulers getRotationalRates(double t) const final;
 
+    /**
+     * Get the revision of this frame state; the revision changes whenever the frame state is modified through
+     * any of its mutators, but not through the references returned by its non-const accessors
+     */
+    EXPORT_STEM virtual std::size_t getRevision(void) const final;
+
     /**
      * Get the time at which this frame is currently defined
      */
@@ -769,6 +775,11 @@ protected:
      */
     std::string m_name;
 
+    /**
+     * count of the modifications made to this frame state
+     */
+    std::size_t m_revision;
+
     /**
      * time (s) at which this frame is currently defined
      */
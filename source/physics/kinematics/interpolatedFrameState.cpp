@@ -2,6 +2,7 @@
 #include "euler_acceleration_axis_type.h"
 #include "euler_rate_axis_type.h"
 #include "interpolatedFrameState.h"
+#include "math_constants.h"
 #include "projectedFrameState.h"
 #ifdef RAPID_XML
 #include "rapidxml.hpp"
@@ -13,8 +14,21 @@
 // file-scoped variables
 static constexpr char factoryName[] = "Interpolated";
 
+// channels of the time history, in the order in which they're serialized
+static constexpr std::size_t accelerationChannel = 0;
+static constexpr std::size_t orientationChannel = 1;
+static constexpr std::size_t originChannel = 2;
+static constexpr std::size_t rotationalAccelerationsChannel = 3;
+static constexpr std::size_t rotationalRatesChannel = 4;
+static constexpr std::size_t velocityChannel = 5;
+static constexpr std::size_t numChannels = 6;
+
+// the maximum number of samples retained by each channel
+static constexpr std::size_t maximumSamples = 5;
+
 // using namespace declarations
 using namespace attributes::abstract;
+using namespace math;
 using namespace math::geometric::orientation;
 using namespace math::linear_algebra::vector;
 using namespace math::trigonometric;
@@ -32,6 +46,16 @@ namespace kinematics
 static FactoryRegistrar<FrameState>
 factory(factoryName, (InterpolatedFrameState * (*)(const std::string &))&InterpolatedFrameState::create);
 
+/**
+ * Determine whether or not the specified channel stores Euler angles, rates or accelerations
+ */
+static bool isAngularChannel(std::size_t channel)
+{
+    return channel == orientationChannel ||
+           channel == rotationalAccelerationsChannel ||
+           channel == rotationalRatesChannel;
+}
+
 /**
  * Constructor
  * @param name       the name of this reference frame state
@@ -40,7 +64,8 @@ factory(factoryName, (InterpolatedFrameState * (*)(const std::string &))&Interpo
 InterpolatedFrameState::InterpolatedFrameState(const std::string &name,
                                                const AngleUnitType &angleUnits)
 : FrameState(name,
-             angleUnits)
+             angleUnits),
+  m_timeHistory(numChannels)
 {
 
 }
@@ -49,6 +74,7 @@ InterpolatedFrameState::InterpolatedFrameState(const std::string &name,
  * Copy constructor
  */
 InterpolatedFrameState::InterpolatedFrameState(const InterpolatedFrameState &state)
+: m_timeHistory(numChannels)
 {
     operator = (state);
 }
@@ -57,6 +83,7 @@ InterpolatedFrameState::InterpolatedFrameState(const InterpolatedFrameState &sta
  * Move constructor
  */
 InterpolatedFrameState::InterpolatedFrameState(InterpolatedFrameState &&state)
+: m_timeHistory(numChannels)
 {
     operator = (std::move(state));
 }
@@ -78,12 +105,7 @@ InterpolatedFrameState &InterpolatedFrameState::operator = (const InterpolatedFr
     {
         FrameState::operator = (state);
 
-        m_accelerationMap = state.m_accelerationMap;
-        m_orientationMap = state.m_orientationMap;
-        m_originMap = state.m_originMap;
-        m_rotationalAccelerationsMap = state.m_rotationalAccelerationsMap;
-        m_rotationalRatesMap = state.m_rotationalRatesMap;
-        m_velocityMap = state.m_velocityMap;
+        m_timeHistory = state.m_timeHistory;
     }
 
     return *this;
@@ -118,12 +140,7 @@ bool InterpolatedFrameState::operator == (const InterpolatedFrameState &state) c
     bool bEqual = FrameState::operator == (state);
     if (bEqual)
     {
-        bEqual = (m_accelerationMap == state.m_accelerationMap &&
-                  m_orientationMap == state.m_orientationMap &&
-                  m_originMap == state.m_originMap &&
-                  m_rotationalAccelerations == state.m_rotationalAccelerations &&
-                  m_rotationalRatesMap == state.m_rotationalRatesMap &&
-                  m_velocityMap == state.m_velocityMap);
+        bEqual = (m_timeHistory == state.m_timeHistory);
     }
 
     return bEqual;
@@ -191,19 +208,20 @@ InterpolatedFrameState *InterpolatedFrameState::clone(void) const
  */
 void InterpolatedFrameState::convertAngleUnits(const AngleUnitType &angleUnits)
 {
-    m_angleUnits = angleUnits;
-
-    std::for_each(m_orientationMap.begin(),
-                  m_orientationMap.end(),
-                  [&angleUnits] (auto &&pair) { pair.second.convertAngleUnits(angleUnits); });
-
-    std::for_each(m_rotationalAccelerationsMap.begin(),
-                  m_rotationalAccelerationsMap.end(),
-                  [&angleUnits] (auto &&pair) { pair.second.convertAngleUnits(angleUnits); });
+    ++m_revision;
+    double cnv = 1.0;
+    if (angleUnits == AngleUnitType::Degrees && m_angleUnits == AngleUnitType::Radians)
+        cnv = RADIANS_TO_DEGREES;
+    else if (angleUnits == AngleUnitType::Radians && m_angleUnits == AngleUnitType::Degrees)
+        cnv = DEGREES_TO_RADIANS;
 
-    std::for_each(m_rotationalRatesMap.begin(),
-                  m_rotationalRatesMap.end(),
-                  [&angleUnits] (auto &&pair) { pair.second.convertAngleUnits(angleUnits); });
+    m_angleUnits = angleUnits;
+    if (cnv != 1.0)
+    {
+        m_timeHistory.scale(orientationChannel, cnv);
+        m_timeHistory.scale(rotationalAccelerationsChannel, cnv);
+        m_timeHistory.scale(rotationalRatesChannel, cnv);
+    }
 }
 
 /**
@@ -239,64 +257,29 @@ std::istream &InterpolatedFrameState::deserialize(std::istream &stream)
 
     if (stream)
     {
-        std::size_t numAccelerations;
-        stream.read((char *)&numAccelerations, sizeof(std::size_t));
-        m_accelerationMap.clear();
-        for (std::size_t i = 0; i < numAccelerations; ++i)
-        {
-            double time;
-            stream.read((char *)&time, sizeof(double));
-            m_accelerationMap[time].deserialize(stream);
-        }
-
-        std::size_t numOrientations;
-        stream.read((char *)&numOrientations, sizeof(std::size_t));
-        m_orientationMap.clear();
-        for (std::size_t i = 0; i < numOrientations; ++i)
-        {
-            double time;
-            stream.read((char *)&time, sizeof(double));
-            m_orientationMap[time].deserialize(stream);
-        }
-
-        std::size_t numOrigins;
-        stream.read((char *)&numOrigins, sizeof(std::size_t));
-        m_originMap.clear();
-        for (std::size_t i = 0; i < numOrigins; ++i)
-        {
-            double time;
-            stream.read((char *)&time, sizeof(double));
-            m_originMap[time].deserialize(stream);
-        }
-
-        std::size_t numRotationalAccelerations;
-        stream.read((char *)&numRotationalAccelerations, sizeof(std::size_t));
-        m_rotationalAccelerationsMap.clear();
-        for (std::size_t i = 0; i < numRotationalAccelerations; ++i)
-        {
-            double time;
-            stream.read((char *)&time, sizeof(double));
-            m_rotationalAccelerationsMap[time].deserialize(stream);
-        }
-
-        std::size_t numRotationalRates;
-        stream.read((char *)&numRotationalRates, sizeof(std::size_t));
-        m_rotationalRatesMap.clear();
-        for (std::size_t i = 0; i < numRotationalRates; ++i)
+        m_timeHistory.clear();
+        for (std::size_t channel = 0; stream && channel < numChannels; ++channel)
         {
-            double time;
-            stream.read((char *)&time, sizeof(double));
-            m_rotationalRatesMap[time].deserialize(stream);
-        }
-
-        std::size_t numVelocities;
-        stream.read((char *)&numVelocities, sizeof(std::size_t));
-        m_velocityMap.clear();
-        for (std::size_t i = 0; i < numVelocities; ++i)
-        {
-            double time;
-            stream.read((char *)&time, sizeof(double));
-            m_velocityMap[time].deserialize(stream);
+            std::size_t numSamples;
+            stream.read((char *)&numSamples, sizeof(std::size_t));
+            for (std::size_t i = 0; stream && i < numSamples; ++i)
+            {
+                double time;
+                stream.read((char *)&time, sizeof(double));
+                if (isAngularChannel(channel))
+                {
+                    Eulers eulers;
+                    eulers.deserialize(stream);
+                    eulers.convertAngleUnits(m_angleUnits);
+                    eulers.get(m_timeHistory.insert(channel, time));
+                }
+                else
+                {
+                    Vector3d vector;
+                    vector.deserialize(stream);
+                    vector.get(m_timeHistory.insert(channel, time));
+                }
+            }
         }
     }
 
@@ -308,7 +291,7 @@ std::istream &InterpolatedFrameState::deserialize(std::istream &stream)
  */
 void InterpolatedFrameState::getAcceleration(double acceleration[3]) const
 {
-    interpolate(m_t0, acceleration, m_accelerationMap);
+    m_timeHistory.interpolate(accelerationChannel, m_t0, acceleration);
 }
 
 /**
@@ -317,7 +300,7 @@ void InterpolatedFrameState::getAcceleration(double acceleration[3]) const
 Vector3d &InterpolatedFrameState::getAcceleration(void)
 {
     m_acceleration.set(0.0, 0.0, 0.0);
-    interpolate(m_t0, m_acceleration, m_accelerationMap);
+    interpolate(accelerationChannel, m_t0, m_acceleration);
 
     return m_acceleration;
 }
@@ -328,7 +311,7 @@ Vector3d &InterpolatedFrameState::getAcceleration(void)
 Vector3d InterpolatedFrameState::getAcceleration(void) const
 {
     Vector3d acceleration;
-    interpolate(m_t0, acceleration, m_accelerationMap);
+    interpolate(accelerationChannel, m_t0, acceleration);
 
     return acceleration;
 }
@@ -357,8 +340,8 @@ void InterpolatedFrameState::getOrientation(double &roll,
                                             double &yaw,
                                             double t) const
 {
-    Eulers orientation;
-    interpolate(t, orientation, m_orientationMap);
+    Eulers orientation(m_angleUnits);
+    interpolate(orientationChannel, t, orientation);
 
     pitch = orientation.getPitch();
     roll = orientation.getRoll();
@@ -370,8 +353,9 @@ void InterpolatedFrameState::getOrientation(double &roll,
  */
 Eulers &InterpolatedFrameState::getOrientation(void)
 {
+    m_orientation.setAngleUnits(m_angleUnits);
     m_orientation.set(0.0, 0.0, 0.0);
-    interpolate(m_t0, m_orientation, m_orientationMap);
+    interpolate(orientationChannel, m_t0, m_orientation);
 
     return m_orientation;
 }
@@ -381,8 +365,8 @@ Eulers &InterpolatedFrameState::getOrientation(void)
  */
 Eulers InterpolatedFrameState::getOrientation(void) const
 {
-    Eulers orientation;
-    interpolate(m_t0, orientation, m_orientationMap);
+    Eulers orientation(m_angleUnits);
+    interpolate(orientationChannel, m_t0, orientation);
 
     return orientation;
 }
@@ -393,7 +377,7 @@ Eulers InterpolatedFrameState::getOrientation(void) const
 void InterpolatedFrameState::getOrigin(double origin[3],
                                        double t) const
 {
-    interpolate(t, origin, m_originMap);
+    m_timeHistory.interpolate(originChannel, t, origin);
 }
 
 /**
@@ -402,7 +386,7 @@ void InterpolatedFrameState::getOrigin(double origin[3],
 Vector3d &InterpolatedFrameState::getOrigin(void)
 {
     m_origin.set(0.0, 0.0, 0.0);
-    interpolate(m_t0, m_origin, m_originMap);
+    interpolate(originChannel, m_t0, m_origin);
 
     return m_origin;
 }
@@ -413,7 +397,7 @@ Vector3d &InterpolatedFrameState::getOrigin(void)
 Vector3d InterpolatedFrameState::getOrigin(void) const
 {
     Vector3d origin;
-    interpolate(m_t0, origin, m_originMap);
+    interpolate(originChannel, m_t0, origin);
 
     return origin;
 }
@@ -511,8 +495,8 @@ void InterpolatedFrameState::getRotationalAccelerations(double &rollAccel,
                                                         double &pitchAccel,
                                                         double &yawAccel) const
 {
-    Eulers rotationalAccelerations;
-    interpolate(m_t0, rotationalAccelerations, m_rotationalAccelerationsMap);
+    Eulers rotationalAccelerations(m_angleUnits);
+    interpolate(rotationalAccelerationsChannel, m_t0, rotationalAccelerations);
 
     pitchAccel = rotationalAccelerations.getPitch();
     rollAccel = rotationalAccelerations.getRoll();
@@ -524,8 +508,9 @@ void InterpolatedFrameState::getRotationalAccelerations(double &rollAccel,
  */
 Eulers &InterpolatedFrameState::getRotationalAccelerations(void)
 {
+    m_rotationalAccelerations.setAngleUnits(m_angleUnits);
     m_rotationalAccelerations.set(0.0, 0.0, 0.0);
-    interpolate(m_t0, m_rotationalAccelerations, m_rotationalAccelerationsMap);
+    interpolate(rotationalAccelerationsChannel, m_t0, m_rotationalAccelerations);
 
     return m_rotationalAccelerations;
 }
@@ -535,8 +520,8 @@ Eulers &InterpolatedFrameState::getRotationalAccelerations(void)
  */
 Eulers InterpolatedFrameState::getRotationalAccelerations(void) const
 {
-    Eulers rotationalAccelerations;
-    interpolate(m_t0, rotationalAccelerations, m_rotationalAccelerationsMap);
+    Eulers rotationalAccelerations(m_angleUnits);
+    interpolate(rotationalAccelerationsChannel, m_t0, rotationalAccelerations);
 
     return rotationalAccelerations;
 }
@@ -549,8 +534,8 @@ void InterpolatedFrameState::getRotationalRates(double &rollRate,
                                                 double &yawRate,
                                                 double t) const
 {
-    Eulers rotationalRates;
-    interpolate(t, rotationalRates, m_rotationalRatesMap);
+    Eulers rotationalRates(m_angleUnits);
+    interpolate(rotationalRatesChannel, t, rotationalRates);
 
     pitchRate = rotationalRates.getPitch();
     rollRate = rotationalRates.getRoll();
@@ -562,8 +547,9 @@ void InterpolatedFrameState::getRotationalRates(double &rollRate,
  */
 Eulers &InterpolatedFrameState::getRotationalRates(void)
 {
+    m_rotationalRates.setAngleUnits(m_angleUnits);
     m_rotationalRates.set(0.0, 0.0, 0.0);
-    interpolate(m_t0, m_rotationalRates, m_rotationalRatesMap);
+    interpolate(rotationalRatesChannel, m_t0, m_rotationalRates);
 
     return m_rotationalRates;
 }
@@ -573,8 +559,8 @@ Eulers &InterpolatedFrameState::getRotationalRates(void)
  */
 Eulers InterpolatedFrameState::getRotationalRates(void) const
 {
-    Eulers rotationalRates;
-    interpolate(m_t0, rotationalRates, m_rotationalRatesMap);
+    Eulers rotationalRates(m_angleUnits);
+    interpolate(rotationalRatesChannel, m_t0, rotationalRates);
 
     return rotationalRates;
 }
@@ -585,7 +571,7 @@ Eulers InterpolatedFrameState::getRotationalRates(void) const
 void InterpolatedFrameState::getVelocity(double velocity[3],
                                          double t) const
 {
-    interpolate(t, velocity, m_velocityMap);
+    m_timeHistory.interpolate(velocityChannel, t, velocity);
 }
 
 /**
@@ -594,7 +580,7 @@ void InterpolatedFrameState::getVelocity(double velocity[3],
 Vector3d &InterpolatedFrameState::getVelocity(void)
 {
     m_velocity.set(0.0, 0.0, 0.0);
-    interpolate(m_t0, m_velocity, m_velocityMap);
+    interpolate(velocityChannel, m_t0, m_velocity);
 
     return m_velocity;
 }
@@ -605,7 +591,7 @@ Vector3d &InterpolatedFrameState::getVelocity(void)
 Vector3d InterpolatedFrameState::getVelocity(void) const
 {
     Vector3d velocity;
-    interpolate(m_t0, velocity, m_velocityMap);
+    interpolate(velocityChannel, m_t0, velocity);
 
     return velocity;
 }
@@ -661,12 +647,7 @@ bool InterpolatedFrameState::initialize(void)
     bool bSuccess = FrameState::initialize();
     if (bSuccess)
     {
-        m_accelerationMap.clear();
-        m_rotationalAccelerationsMap.clear();
-        m_rotationalRatesMap.clear();
-        m_orientationMap.clear();
-        m_originMap.clear();
-        m_velocityMap.clear();
+        m_timeHistory.clear();
     }
 
     return bSuccess;
@@ -677,25 +658,34 @@ bool InterpolatedFrameState::initialize(void)
  */
 void InterpolatedFrameState::initializeTimeDerivatives(void)
 {
+    ++m_revision;
     m_acceleration.set(0.0, 0.0, 0.0);
-    std::for_each(m_accelerationMap.begin(),
-                  m_accelerationMap.end(),
-                  [] (auto &&pair) { pair.second.set(0.0, 0.0, 0.0); });
-
     m_rotationalAccelerations.set(0.0, 0.0, 0.0);
-    std::for_each(m_rotationalAccelerationsMap.begin(),
-                  m_rotationalAccelerationsMap.end(),
-                  [] (auto &&pair) { pair.second.set(0.0, 0.0, 0.0); });
-
     m_rotationalRates.set(0.0, 0.0, 0.0);
-    std::for_each(m_rotationalRatesMap.begin(),
-                  m_rotationalRatesMap.end(),
-                  [] (auto &&pair) { pair.second.set(0.0, 0.0, 0.0); });
-
     m_velocity.set(0.0, 0.0, 0.0);
-    std::for_each(m_velocityMap.begin(),
-                  m_velocityMap.end(),
-                  [] (auto &&pair) { pair.second.set(0.0, 0.0, 0.0); });
+    for (auto &&channel : { accelerationChannel,
+                            rotationalAccelerationsChannel,
+                            rotationalRatesChannel,
+                            velocityChannel })
+    {
+        m_timeHistory.scale(channel, 0.0);
+    }
+}
+
+/**
+ * Interpolate the time history of the specified channel at the specified time; returns false, leaving the
+ * result unchanged, if the channel has no samples
+ */
+bool InterpolatedFrameState::interpolate(std::size_t channel,
+                                         double t,
+                                         Vector3d &result) const
+{
+    double values[3];
+    bool bSuccess = m_timeHistory.interpolate(channel, t, values);
+    if (bSuccess)
+        result.set(values);
+
+    return bSuccess;
 }
 
 /**
@@ -739,63 +729,7 @@ bool InterpolatedFrameState::isSpatiallyEqual(const InterpolatedFrameState &stat
 {
     bool bEqual = (memcmp((void *)this, (void *)&state, sizeof(FrameState)) == 0);
     if (!bEqual)
-    {
-        auto &&comparator = [&tol] (auto &&left, auto &&right)
-                            {
-                                return left.second.isEqual(right.second, tol);
-                            };
-
-        bEqual = m_accelerationMap.size() == state.m_accelerationMap.size() &&
-                 std::equal(m_accelerationMap.cbegin(),
-                            m_accelerationMap.cend(),
-                            state.m_accelerationMap.begin(),
-                            comparator);
-
-        if (bEqual)
-        {
-            bEqual = m_orientationMap.size() == state.m_orientationMap.size() &&
-                     std::equal(m_orientationMap.cbegin(),
-                                m_orientationMap.cend(),
-                                state.m_orientationMap.begin(),
-                                comparator);
-        }
-
-        if (bEqual)
-        {
-            bEqual = m_originMap.size() == state.m_originMap.size() &&
-                     std::equal(m_originMap.cbegin(),
-                                m_originMap.cend(),
-                                state.m_originMap.begin(),
-                                comparator);
-        }
-
-        if (bEqual)
-        {
-            bEqual = m_rotationalAccelerationsMap.size() == state.m_rotationalAccelerationsMap.size() &&
-                     std::equal(m_rotationalAccelerationsMap.cbegin(),
-                                m_rotationalAccelerationsMap.cend(),
-                                state.m_rotationalAccelerationsMap.begin(),
-                                comparator);
-        }
-
-        if (bEqual)
-        {
-            bEqual = m_rotationalRatesMap.size() == state.m_rotationalRatesMap.size() &&
-                     std::equal(m_rotationalRatesMap.cbegin(),
-                                m_rotationalRatesMap.cend(),
-                                state.m_rotationalRatesMap.begin(),
-                                comparator);
-        }
-
-        if (bEqual)
-        {
-            bEqual = m_velocityMap.size() == state.m_velocityMap.size() &&
-                     std::equal(m_velocityMap.cbegin(),
-                                m_velocityMap.cend(),
-                                state.m_velocityMap.begin(),
-                                comparator);
-        }
-    }
+        bEqual = m_timeHistory.isEqual(state.m_timeHistory, tol);
 
     return bEqual;
 }
@@ -809,45 +743,27 @@ std::ostream &InterpolatedFrameState::print(std::ostream &stream) const
 
     if (stream)
     {
-        static const std::vector<std::string> strings = { "Origin vs time:",
-                                                          "Velocity vs time:",
-                                                          "Acceleration vs time:",
-                                                          "Orientation vs time:",
-                                                          "Rotational rates vs time:",
-                                                          "Rotational accelerations vs time:" };
+        static const std::vector<std::pair<std::string, std::size_t>> channels =
+        { { "Origin vs time:", originChannel },
+          { "Velocity vs time:", velocityChannel },
+          { "Acceleration vs time:", accelerationChannel },
+          { "Orientation vs time:", orientationChannel },
+          { "Rotational rates vs time:", rotationalRatesChannel },
+          { "Rotational accelerations vs time:", rotationalAccelerationsChannel } };
 
         stream << std::endl;
-        auto &&itStrings = strings.cbegin();
-        for (auto &mapEntry : { m_originMap,
-                                m_velocityMap,
-                                m_accelerationMap })
-        {
-            stream << *itStrings << std::endl;
-            std::for_each(mapEntry.cbegin(),
-                          mapEntry.cend(),
-                          [&stream] (auto &&pair)
-                          {
-                              stream << pair.first << ", ";
-                              pair.second.print(stream) << std::endl;
-                          });
-
-            ++itStrings;
-        }
-
-        for (auto &mapEntry : { m_orientationMap,
-                                m_rotationalRatesMap,
-                                m_rotationalAccelerationsMap })
+        for (auto &&channel : channels)
         {
-            stream << *itStrings << std::endl;
-            std::for_each(mapEntry.cbegin(),
-                          mapEntry.cend(),
-                          [&stream] (auto &&pair)
-                          {
-                              stream << pair.first << ", ";
-                              pair.second.print(stream) << std::endl;
-                          });
-
-            ++itStrings;
+            stream << channel.first << std::endl;
+            m_timeHistory.forEach(channel.second,
+                                  [this, &channel, &stream] (double t, const double *pValues)
+                                  {
+                                      stream << t << ", ";
+                                      if (isAngularChannel(channel.second))
+                                          Eulers(pValues, m_angleUnits).print(stream) << std::endl;
+                                      else
+                                          Vector3d(pValues).print(stream) << std::endl;
+                                  });
         }
     }
 
@@ -862,89 +778,40 @@ bool InterpolatedFrameState::readFromXML(xml_node<> *pNode)
     bool bSuccess = FrameState::readFromXML(pNode);
     if (bSuccess)
     {
-        auto *pOriginNode = pNode->first_node("origin");
-        while (pOriginNode != nullptr)
-        {
-            double t = 0.0;
-            auto *pTimeNode = pOriginNode->first_node("time");
-            if (pTimeNode != nullptr)
-            {
-                t = std::stod(pTimeNode->value());
-                m_originMap[t].readFromXML(pOriginNode);
-            }
-
-            pOriginNode = pOriginNode->next_sibling("origin");
-        }
-
-        auto *pVelocityNode = pNode->first_node("velocity");
-        while (pVelocityNode != nullptr)
-        {
-            double t = 0.0;
-            auto *pTimeNode = pVelocityNode->first_node("time");
-            if (pTimeNode != nullptr)
-            {
-                t = std::stod(pTimeNode->value());
-                m_velocityMap[t].readFromXML(pVelocityNode);
-            }
-
-            pVelocityNode = pVelocityNode->next_sibling("velocity");
-        }
-
-        auto *pAccelerationNode = pNode->first_node("acceleration");
-        while (pAccelerationNode != nullptr)
-        {
-            double t = 0.0;
-            auto *pTimeNode = pAccelerationNode->first_node("time");
-            if (pTimeNode != nullptr)
-            {
-                t = std::stod(pTimeNode->value());
-                m_accelerationMap[t].readFromXML(pAccelerationNode);
-            }
-
-            pAccelerationNode = pAccelerationNode->next_sibling("acceleration");
-        }
-
-        auto *pOrientationNode = pNode->first_node("orientation");
-        while (pOrientationNode != nullptr)
+        static const std::vector<std::pair<std::string, std::size_t>> channels =
+        { { "origin", originChannel },
+          { "velocity", velocityChannel },
+          { "acceleration", accelerationChannel },
+          { "orientation", orientationChannel },
+          { "rotationalRates", rotationalRatesChannel },
+          { "rotationalAccelerations", rotationalAccelerationsChannel } };
+
+        for (auto &&channel : channels)
         {
-            double t = 0.0;
-            auto *pTimeNode = pOrientationNode->first_node("time");
-            if (pTimeNode != nullptr)
+            auto *pChannelNode = pNode->first_node(channel.first.c_str());
+            while (pChannelNode != nullptr)
             {
-                t = std::stod(pTimeNode->value());
-                m_orientationMap[t].readFromXML(pOrientationNode);
+                auto *pTimeNode = pChannelNode->first_node("time");
+                if (pTimeNode != nullptr)
+                {
+                    auto &&t = std::stod(pTimeNode->value());
+                    if (isAngularChannel(channel.second))
+                    {
+                        Eulers eulers;
+                        eulers.readFromXML(pChannelNode);
+                        eulers.convertAngleUnits(m_angleUnits);
+                        eulers.get(m_timeHistory.insert(channel.second, t));
+                    }
+                    else
+                    {
+                        Vector3d vector;
+                        vector.readFromXML(pChannelNode);
+                        vector.get(m_timeHistory.insert(channel.second, t));
+                    }
+                }
+
+                pChannelNode = pChannelNode->next_sibling(channel.first.c_str());
             }
-
-            pOrientationNode = pOrientationNode->next_sibling("orientation");
-        }
-
-        auto *pRotationalRatesNode = pNode->first_node("rotationalRates");
-        while (pRotationalRatesNode != nullptr)
-        {
-            double t = 0.0;
-            auto *pTimeNode = pRotationalRatesNode->first_node("time");
-            if (pTimeNode != nullptr)
-            {
-                t = std::stod(pTimeNode->value());
-                m_rotationalRatesMap[t].readFromXML(pRotationalRatesNode);
-            }
-
-            pRotationalRatesNode = pRotationalRatesNode->next_sibling("rotationalRates");
-        }
-
-        auto *pRotationalAccelerationsNode = pNode->first_node("rotationalAccelerations");
-        while (pRotationalAccelerationsNode != nullptr)
-        {
-            double t = 0.0;
-            auto *pTimeNode = pRotationalAccelerationsNode->first_node("time");
-            if (pTimeNode != nullptr)
-            {
-                t = std::stod(pTimeNode->value());
-                m_rotationalAccelerationsMap[t].readFromXML(pRotationalAccelerationsNode);
-            }
-
-            pRotationalAccelerationsNode = pRotationalAccelerationsNode->
-                                           next_sibling("rotationalAccelerations");
         }
     }
 
@@ -958,73 +825,19 @@ std::ostream &InterpolatedFrameState::serialize(std::ostream &stream) const
 {
     FrameState::serialize(stream);
 
-    if (stream)
+    for (std::size_t channel = 0; stream && channel < numChannels; ++channel)
     {
-        auto numAccelerations = m_accelerationMap.size();
-        stream.write((const char *)&numAccelerations, sizeof(std::size_t));
-        auto &&itAcceleration = m_accelerationMap.cbegin();
-        while (itAcceleration != m_accelerationMap.cend())
-        {
-            double time = itAcceleration->first;
-            stream.write((const char *)&time, sizeof(double));
-            itAcceleration->second.serialize(stream);
-            ++itAcceleration;
-        }
-
-        auto numOrientations = m_orientationMap.size();
-        stream.write((const char *)&numOrientations, sizeof(std::size_t));
-        auto &&itOrientation = m_orientationMap.cbegin();
-        while (itOrientation != m_orientationMap.cend())
-        {
-            double time = itOrientation->first;
-            stream.write((const char *)&time, sizeof(double));
-            itOrientation->second.serialize(stream);
-            ++itOrientation;
-        }
-
-        auto numOrigins = m_originMap.size();
-        stream.write((const char *)&numOrigins, sizeof(std::size_t));
-        auto &&itOrigin = m_originMap.cbegin();
-        while (itOrigin != m_originMap.cend())
-        {
-            double time = itOrigin->first;
-            stream.write((const char *)&time, sizeof(double));
-            itOrigin->second.serialize(stream);
-            ++itOrigin;
-        }
-
-        auto numRotationalAccelerations = m_rotationalAccelerationsMap.size();
-        stream.write((const char *)&numRotationalAccelerations, sizeof(std::size_t));
-        auto &&itRotationalAccelerations = m_rotationalAccelerationsMap.cbegin();
-        while (itRotationalAccelerations != m_rotationalAccelerationsMap.cend())
-        {
-            double time = itRotationalAccelerations->first;
-            stream.write((const char *)&time, sizeof(double));
-            itRotationalAccelerations->second.serialize(stream);
-            ++itRotationalAccelerations;
-        }
-
-        auto numRotationalRates = m_rotationalRatesMap.size();
-        stream.write((const char *)&numRotationalRates, sizeof(std::size_t));
-        auto &&itRotationalRates = m_rotationalRatesMap.cbegin();
-        while (itRotationalRates != m_rotationalRatesMap.cend())
-        {
-            double time = itRotationalRates->first;
-            stream.write((const char *)&time, sizeof(double));
-            itRotationalRates->second.serialize(stream);
-            ++itRotationalRates;
-        }
-
-        auto numVelocities = m_velocityMap.size();
-        stream.write((const char *)&numVelocities, sizeof(std::size_t));
-        auto &&itVelocity = m_velocityMap.cbegin();
-        while (itVelocity != m_velocityMap.cend())
-        {
-            double time = itVelocity->first;
-            stream.write((const char *)&time, sizeof(double));
-            itVelocity->second.serialize(stream);
-            ++itVelocity;
-        }
+        auto &&numSamples = m_timeHistory.getNumSamples(channel);
+        stream.write((const char *)&numSamples, sizeof(std::size_t));
+        m_timeHistory.forEach(channel,
+                              [this, &channel, &stream] (double time, const double *pValues)
+                              {
+                                  stream.write((const char *)&time, sizeof(double));
+                                  if (isAngularChannel(channel))
+                                      Eulers(pValues, m_angleUnits).serialize(stream);
+                                  else
+                                      Vector3d(pValues).serialize(stream);
+                              });
     }
 
     return stream;
@@ -1037,11 +850,27 @@ void InterpolatedFrameState::setAcceleration(double xAcceleration,
                                              double yAcceleration,
                                              double zAcceleration)
 {
-    m_accelerationMap[m_t0].set(xAcceleration,
-                                yAcceleration,
-                                zAcceleration);
-    if (m_accelerationMap.size() > 5)
-        m_accelerationMap.erase(m_accelerationMap.begin());
+    double acceleration[3] = { xAcceleration, yAcceleration, zAcceleration };
+    setChannel(accelerationChannel, acceleration);
+}
+
+/**
+ * Set one of the angles of the orientation, rotational rate or rotational acceleration channel at the current
+ * time
+ * @param angleUnits the angle units of the input argument, Degrees or Radians
+ */
+void InterpolatedFrameState::setAngle(std::size_t channel,
+                                      const EulerAxisType &axis,
+                                      double angle,
+                                      const AngleUnitType &angleUnits)
+{
+    ++m_revision;
+    auto *pEulers = m_timeHistory.insert(channel, m_t0);
+    Eulers eulers(pEulers, m_angleUnits);
+    eulers.set(axis, angle, angleUnits);
+    eulers.get(pEulers);
+    if (m_timeHistory.getNumSamples(channel) > maximumSamples)
+        m_timeHistory.eraseFirst(channel);
 }
 
 /**
@@ -1049,19 +878,20 @@ void InterpolatedFrameState::setAcceleration(double xAcceleration,
  */
 void InterpolatedFrameState::setAngleUnits(const AngleUnitType &angleUnits)
 {
+    ++m_revision;
     m_angleUnits = angleUnits;
+}
 
-    std::for_each(m_orientationMap.begin(),
-                  m_orientationMap.end(),
-                  [&angleUnits] (auto &&pair) { pair.second.setAngleUnits(angleUnits); });
-
-    std::for_each(m_rotationalAccelerationsMap.begin(),
-                  m_rotationalAccelerationsMap.end(),
-                  [&angleUnits] (auto &&pair) { pair.second.setAngleUnits(angleUnits); });
-
-    std::for_each(m_rotationalRatesMap.begin(),
-                  m_rotationalRatesMap.end(),
-                  [&angleUnits] (auto &&pair) { pair.second.setAngleUnits(angleUnits); });
+/**
+ * Set the values of the specified channel at the current time
+ */
+void InterpolatedFrameState::setChannel(std::size_t channel,
+                                        const double values[3])
+{
+    ++m_revision;
+    std::copy_n(values, 3, m_timeHistory.insert(channel, m_t0));
+    if (m_timeHistory.getNumSamples(channel) > maximumSamples)
+        m_timeHistory.eraseFirst(channel);
 }
 
 /**
@@ -1069,13 +899,11 @@ void InterpolatedFrameState::setAngleUnits(const AngleUnitType &angleUnits)
  */
 void InterpolatedFrameState::setOrientation(const Eulers &orientation)
 {
-    setOrientation(orientation[EulerAxisType::Roll],
-                   orientation[EulerAxisType::Pitch],
-                   orientation[EulerAxisType::Yaw]);
-
-    m_orientationMap[m_t0].convertAngleUnits(m_angleUnits);
-    if (m_orientationMap.size() > 5)
-        m_orientationMap.erase(m_orientationMap.begin());
+    double values[3];
+    Eulers converted(orientation);
+    converted.convertAngleUnits(m_angleUnits);
+    converted.get(values);
+    setChannel(orientationChannel, values);
 }
 
 /**
@@ -1085,12 +913,9 @@ void InterpolatedFrameState::setOrientation(double roll,
                                             double pitch,
                                             double yaw)
 {
-    auto &&orientation = m_orientationMap[m_t0];
-    orientation.setPitch(pitch);
-    orientation.setRoll(roll);
-    orientation.setYaw(yaw);
-    if (m_orientationMap.size() > 5)
-        m_orientationMap.erase(m_orientationMap.begin());
+    double values[3];
+    Eulers(roll, pitch, yaw, m_angleUnits).get(values);
+    setChannel(orientationChannel, values);
 }
 
 /**
@@ -1100,11 +925,8 @@ void InterpolatedFrameState::setOrigin(double xPosition,
                                        double yPosition,
                                        double zPosition)
 {
-    m_originMap[m_t0].set(xPosition,
-                          yPosition,
-                          zPosition);
-    if (m_originMap.size() > 5)
-        m_originMap.erase(m_originMap.begin());
+    double origin[3] = { xPosition, yPosition, zPosition };
+    setChannel(originChannel, origin);
 }
 
 /**
@@ -1114,11 +936,7 @@ void InterpolatedFrameState::setOrigin(double xPosition,
 void InterpolatedFrameState::setPitch(double pitch,
                                       const AngleUnitType &angleUnits)
 {
-    auto &&orientation = m_orientationMap[m_t0];
-    orientation.setAngleUnits(m_angleUnits);
-    orientation.setPitch(pitch, angleUnits);
-    if (m_orientationMap.size() > 5)
-        m_orientationMap.erase(m_orientationMap.begin());
+    setAngle(orientationChannel, EulerAxisType::Pitch, pitch, angleUnits);
 }
 
 /**
@@ -1128,11 +946,7 @@ void InterpolatedFrameState::setPitch(double pitch,
 void InterpolatedFrameState::setPitchAcceleration(double pitchAcceleration,
                                                   const AngleUnitType &angleUnits)
 {
-    auto &&rotationalAccelerations = m_rotationalAccelerationsMap[m_t0];
-    rotationalAccelerations.setAngleUnits(m_angleUnits);
-    rotationalAccelerations.setPitch(pitchAcceleration, angleUnits);
-    if (m_rotationalAccelerationsMap.size() > 5)
-        m_rotationalAccelerationsMap.erase(m_rotationalAccelerationsMap.begin());
+    setAngle(rotationalAccelerationsChannel, EulerAxisType::Pitch, pitchAcceleration, angleUnits);
 }
 
 /**
@@ -1142,11 +956,7 @@ void InterpolatedFrameState::setPitchAcceleration(double pitchAcceleration,
 void InterpolatedFrameState::setPitchRate(double pitchRate,
                                           const AngleUnitType &angleUnits)
 {
-    auto &&rotationalRates = m_rotationalRatesMap[m_t0];
-    rotationalRates.setAngleUnits(m_angleUnits);
-    rotationalRates.setPitch(pitchRate, angleUnits);
-    if (m_rotationalRatesMap.size() > 5)
-        m_rotationalRatesMap.erase(m_rotationalRatesMap.begin());
+    setAngle(rotationalRatesChannel, EulerAxisType::Pitch, pitchRate, angleUnits);
 }
 
 /**
@@ -1156,11 +966,7 @@ void InterpolatedFrameState::setPitchRate(double pitchRate,
 void InterpolatedFrameState::setRoll(double roll,
                                      const AngleUnitType &angleUnits)
 {
-    auto &&orientation = m_orientationMap[m_t0];
-    orientation.setAngleUnits(m_angleUnits);
-    orientation.setRoll(roll, angleUnits);
-    if (m_orientationMap.size() > 5)
-        m_orientationMap.erase(m_orientationMap.begin());
+    setAngle(orientationChannel, EulerAxisType::Roll, roll, angleUnits);
 }
 
 /**
@@ -1170,11 +976,7 @@ void InterpolatedFrameState::setRoll(double roll,
 void InterpolatedFrameState::setRollAcceleration(double rollAcceleration,
                                                  const AngleUnitType &angleUnits)
 {
-    auto &&rotationalAccelerations = m_rotationalAccelerationsMap[m_t0];
-    rotationalAccelerations.setAngleUnits(m_angleUnits);
-    rotationalAccelerations.setRoll(rollAcceleration, angleUnits);
-    if (m_rotationalAccelerationsMap.size() > 5)
-        m_rotationalAccelerationsMap.erase(m_rotationalAccelerationsMap.begin());
+    setAngle(rotationalAccelerationsChannel, EulerAxisType::Roll, rollAcceleration, angleUnits);
 }
 
 /**
@@ -1184,11 +986,7 @@ void InterpolatedFrameState::setRollAcceleration(double rollAcceleration,
 void InterpolatedFrameState::setRollRate(double rollRate,
                                          const AngleUnitType &angleUnits)
 {
-    auto &&rotationalRates = m_rotationalRatesMap[m_t0];
-    rotationalRates.setAngleUnits(m_angleUnits);
-    rotationalRates.setRoll(rollRate, angleUnits);
-    if (m_rotationalRatesMap.size() > 5)
-        m_rotationalRatesMap.erase(m_rotationalRatesMap.begin());
+    setAngle(rotationalRatesChannel, EulerAxisType::Roll, rollRate, angleUnits);
 }
 
 /**
@@ -1196,13 +994,11 @@ void InterpolatedFrameState::setRollRate(double rollRate,
  */
 void InterpolatedFrameState::setRotationalAccelerations(const Eulers &rotationalAccelerations)
 {
-    setRotationalAccelerations(rotationalAccelerations[EulerAccelerationAxisType::Roll],
-                               rotationalAccelerations[EulerAccelerationAxisType::Pitch],
-                               rotationalAccelerations[EulerAccelerationAxisType::Yaw]);
-
-    m_rotationalAccelerationsMap[m_t0].convertAngleUnits(m_angleUnits);
-    if (m_rotationalAccelerationsMap.size() > 5)
-        m_rotationalAccelerationsMap.erase(m_rotationalAccelerationsMap.begin());
+    double values[3];
+    Eulers converted(rotationalAccelerations);
+    converted.convertAngleUnits(m_angleUnits);
+    converted.get(values);
+    setChannel(rotationalAccelerationsChannel, values);
 }
 
 /**
@@ -1212,12 +1008,9 @@ void InterpolatedFrameState::setRotationalAccelerations(double rollAcceleration,
                                                         double pitchAcceleration,
                                                         double yawAcceleration)
 {
-    auto &&rotationalAccelerations = m_rotationalAccelerationsMap[m_t0];
-    rotationalAccelerations.setPitch(pitchAcceleration);
-    rotationalAccelerations.setRoll(rollAcceleration);
-    rotationalAccelerations.setYaw(yawAcceleration);
-    if (m_rotationalAccelerationsMap.size() > 5)
-        m_rotationalAccelerationsMap.erase(m_rotationalAccelerationsMap.begin());
+    double values[3];
+    Eulers(rollAcceleration, pitchAcceleration, yawAcceleration, m_angleUnits).get(values);
+    setChannel(rotationalAccelerationsChannel, values);
 }
 
 /**
@@ -1225,13 +1018,11 @@ void InterpolatedFrameState::setRotationalAccelerations(double rollAcceleration,
  */
 void InterpolatedFrameState::setRotationalRates(const Eulers &rotationalRates)
 {
-    setRotationalRates(rotationalRates[EulerRateAxisType::Roll],
-                       rotationalRates[EulerRateAxisType::Pitch],
-                       rotationalRates[EulerRateAxisType::Yaw]);
-
-    m_rotationalRatesMap[m_t0].convertAngleUnits(m_angleUnits);
-    if (m_rotationalRatesMap.size() > 5)
-        m_rotationalRatesMap.erase(m_rotationalRatesMap.begin());
+    double values[3];
+    Eulers converted(rotationalRates);
+    converted.convertAngleUnits(m_angleUnits);
+    converted.get(values);
+    setChannel(rotationalRatesChannel, values);
 }
 
 /**
@@ -1241,12 +1032,9 @@ void InterpolatedFrameState::setRotationalRates(double rollRate,
                                                 double pitchRate,
                                                 double yawRate)
 {
-    auto &&rotationalRates = m_rotationalRatesMap[m_t0];
-    rotationalRates.setPitch(pitchRate);
-    rotationalRates.setRoll(rollRate);
-    rotationalRates.setYaw(yawRate);
-    if (m_rotationalRatesMap.size() > 5)
-        m_rotationalRatesMap.erase(m_rotationalRatesMap.begin());
+    double values[3];
+    Eulers(rollRate, pitchRate, yawRate, m_angleUnits).get(values);
+    setChannel(rotationalRatesChannel, values);
 }
 
 /**
@@ -1254,49 +1042,6 @@ void InterpolatedFrameState::setRotationalRates(double rollRate,
  */
 void InterpolatedFrameState::setTime(double t0)
 {
-#if 0
-    auto &&itAcceleration = m_accelerationMap.find(t0);
-    if (itAcceleration != m_accelerationMap.cend() && t0 != m_t0)
-    {
-        m_accelerationMap[t0] = itAcceleration->second;
-        m_accelerationMap.erase(itAcceleration);
-    }
-
-    auto &&itOrientation = m_orientationMap.find(t0);
-    if (itOrientation != m_orientationMap.cend() && t0 != m_t0)
-    {
-        m_orientationMap[t0] = itOrientation->second;
-        m_orientationMap.erase(itOrientation);
-    }
-
-    auto &&itOrigin = m_originMap.find(t0);
-    if (itOrigin != m_originMap.cend() && t0 != m_t0)
-    {
-        m_originMap[t0] = itOrigin->second;
-        m_originMap.erase(itOrigin);
-    }
-
-    auto &&itRotationalAccelerations = m_rotationalAccelerationsMap.find(t0);
-    if (itRotationalAccelerations != m_rotationalAccelerationsMap.cend() && t0 != m_t0)
-    {
-        m_rotationalAccelerationsMap[t0] = itRotationalAccelerations->second;
-        m_rotationalAccelerationsMap.erase(itRotationalAccelerations);
-    }
-
-    auto &&itRotationalRates = m_rotationalRatesMap.find(t0);
-    if (itRotationalRates != m_rotationalRatesMap.cend() && t0 != m_t0)
-    {
-        m_rotationalRatesMap[t0] = itRotationalRates->second;
-        m_rotationalRatesMap.erase(itRotationalRates);
-    }
-
-    auto &&itVelocity = m_velocityMap.find(t0);
-    if (itVelocity != m_velocityMap.cend() && t0 != m_t0)
-    {
-        m_velocityMap[t0] = itVelocity->second;
-        m_velocityMap.erase(itVelocity);
-    }
-#endif
     FrameState::setTime(t0);
 }
 
@@ -1307,11 +1052,8 @@ void InterpolatedFrameState::setVelocity(double xVelocity,
                                          double yVelocity,
                                          double zVelocity)
 {
-    m_velocityMap[m_t0].set(xVelocity,
-                            yVelocity,
-                            zVelocity);
-    if (m_velocityMap.size() > 5)
-        m_velocityMap.erase(m_velocityMap.begin());
+    double velocity[3] = { xVelocity, yVelocity, zVelocity };
+    setChannel(velocityChannel, velocity);
 }
 
 /**
@@ -1321,11 +1063,7 @@ void InterpolatedFrameState::setVelocity(double xVelocity,
 void InterpolatedFrameState::setYaw(double yaw,
                                     const AngleUnitType &angleUnits)
 {
-    auto &&orientation = m_orientationMap[m_t0];
-    orientation.setAngleUnits(m_angleUnits);
-    orientation.setYaw(yaw, angleUnits);
-    if (m_orientationMap.size() > 5)
-        m_orientationMap.erase(m_orientationMap.begin());
+    setAngle(orientationChannel, EulerAxisType::Yaw, yaw, angleUnits);
 }
 
 /**
@@ -1335,11 +1073,7 @@ void InterpolatedFrameState::setYaw(double yaw,
 void InterpolatedFrameState::setYawAcceleration(double yawAcceleration,
                                                 const AngleUnitType &angleUnits)
 {
-    auto &&rotationalAccelerations = m_rotationalAccelerationsMap[m_t0];
-    rotationalAccelerations.setAngleUnits(m_angleUnits);
-    rotationalAccelerations.setYaw(yawAcceleration, angleUnits);
-    if (m_rotationalAccelerationsMap.size() > 5)
-        m_rotationalAccelerationsMap.erase(m_rotationalAccelerationsMap.begin());
+    setAngle(rotationalAccelerationsChannel, EulerAxisType::Yaw, yawAcceleration, angleUnits);
 }
 
 /**
@@ -1349,11 +1083,7 @@ void InterpolatedFrameState::setYawAcceleration(double yawAcceleration,
 void InterpolatedFrameState::setYawRate(double yawRate,
                                         const AngleUnitType &angleUnits)
 {
-    auto &&rotationalRates = m_rotationalRatesMap[m_t0];
-    rotationalRates.setAngleUnits(m_angleUnits);
-    rotationalRates.setYaw(yawRate, angleUnits);
-    if (m_rotationalRatesMap.size() > 5)
-        m_rotationalRatesMap.erase(m_rotationalRatesMap.begin());
+    setAngle(rotationalRatesChannel, EulerAxisType::Yaw, yawRate, angleUnits);
 }
 
 /**
@@ -1363,12 +1093,7 @@ void InterpolatedFrameState::swap(InterpolatedFrameState &state)
 {
     FrameState::swap(state);
 
-    m_accelerationMap.swap(state.m_accelerationMap);
-    m_orientationMap.swap(state.m_orientationMap);
-    m_originMap.swap(state.m_originMap);
-    m_rotationalAccelerations.swap(state.m_rotationalAccelerations);
-    m_rotationalRatesMap.swap(state.m_rotationalRatesMap);
-    m_velocityMap.swap(state.m_velocityMap);
+    m_timeHistory.swap(state.m_timeHistory);
 }
 
 /**
@@ -1407,113 +1132,37 @@ bool InterpolatedFrameState::writeToXML(xml_node<> *pNode)
         bSuccess = (pDocument != nullptr);
         if (bSuccess)
         {
-            auto &&itAcceleration = m_accelerationMap.cbegin();
-            while (itAcceleration != m_accelerationMap.cend())
-            {
-                double time = itAcceleration->first;
-                auto *pTimeNode = pDocument->allocate_node(node_element, "time");
-                auto *pTimeString = pDocument->allocate_string(std::to_string(time).c_str());
-                auto *pDataNode = pDocument->allocate_node(node_data, pTimeString);
-                pTimeNode->append_node(pDataNode);
-
-                auto *pAccelerationNode = pDocument->allocate_node(node_element, "acceleration");
-                bSuccess = m_acceleration.writeToXML(pAccelerationNode);
-                if (bSuccess)
-                    pAccelerationNode->append_node(pTimeNode);
-
-                pNode->append_node(pAccelerationNode);
-                ++itAcceleration;
-            }
-
-            auto &&itOrientation = m_orientationMap.cbegin();
-            while (itOrientation != m_orientationMap.cend())
-            {
-                double time = itOrientation->first;
-                auto *pTimeNode = pDocument->allocate_node(node_element, "time");
-                auto *pTimeString = pDocument->allocate_string(std::to_string(time).c_str());
-                auto *pDataNode = pDocument->allocate_node(node_data, pTimeString);
-                pTimeNode->append_node(pDataNode);
-
-                auto *pOrientationNode = pDocument->allocate_node(node_element, "orientation");
-                bSuccess = m_orientation.writeToXML(pOrientationNode);
-                if (bSuccess)
-                    pOrientationNode->append_node(pTimeNode);
-
-                pNode->append_node(pOrientationNode);
-                ++itOrientation;
-            }
-
-            auto &&itOrigin = m_originMap.cbegin();
-            while (itOrigin != m_originMap.cend())
-            {
-                double time = itOrigin->first;
-                auto *pTimeNode = pDocument->allocate_node(node_element, "time");
-                auto *pTimeString = pDocument->allocate_string(std::to_string(time).c_str());
-                auto *pDataNode = pDocument->allocate_node(node_data, pTimeString);
-                pTimeNode->append_node(pDataNode);
-
-                auto *pOriginNode = pDocument->allocate_node(node_element, "origin");
-                bSuccess = m_origin.writeToXML(pOriginNode);
-                if (bSuccess)
-                    pOriginNode->append_node(pTimeNode);
-
-                pNode->append_node(pOriginNode);
-                ++itOrigin;
-            }
-
-            auto &&itRotationalAccelerations = m_rotationalAccelerationsMap.cbegin();
-            while (itRotationalAccelerations != m_rotationalAccelerationsMap.cend())
-            {
-                double time = itRotationalAccelerations->first;
-                auto *pTimeNode = pDocument->allocate_node(node_element, "time");
-                auto *pTimeString = pDocument->allocate_string(std::to_string(time).c_str());
-                auto *pDataNode = pDocument->allocate_node(node_data, pTimeString);
-                pTimeNode->append_node(pDataNode);
-
-                auto *pRotationalAccelerationsNode = pDocument->allocate_node(node_element,
-                                                                              "rotationalAccelerations");
-                bSuccess = m_rotationalAccelerations.writeToXML(pRotationalAccelerationsNode);
-                if (bSuccess)
-                    pRotationalAccelerationsNode->append_node(pTimeNode);
-
-                pNode->append_node(pRotationalAccelerationsNode);
-                ++itRotationalAccelerations;
-            }
-
-            auto &&itRotationalRates = m_rotationalRatesMap.cbegin();
-            while (itRotationalRates != m_rotationalRatesMap.cend())
-            {
-                double time = itRotationalRates->first;
-                auto *pTimeNode = pDocument->allocate_node(node_element, "time");
-                auto *pTimeString = pDocument->allocate_string(std::to_string(time).c_str());
-                auto *pDataNode = pDocument->allocate_node(node_data, pTimeString);
-                pTimeNode->append_node(pDataNode);
-
-                auto *pRotationalRatesNode = pDocument->allocate_node(node_element, "rotationalRates");
-                bSuccess = m_rotationalRates.writeToXML(pRotationalRatesNode);
-                if (bSuccess)
-                    pRotationalRatesNode->append_node(pTimeNode);
-
-                pNode->append_node(pRotationalRatesNode);
-                ++itRotationalRates;
-            }
-
-            auto &&itVelocity = m_velocityMap.cbegin();
-            while (itVelocity != m_velocityMap.cend())
+            static const std::vector<std::pair<std::string, std::size_t>> channels =
+            { { "acceleration", accelerationChannel },
+              { "orientation", orientationChannel },
+              { "origin", originChannel },
+              { "rotationalAccelerations", rotationalAccelerationsChannel },
+              { "rotationalRates", rotationalRatesChannel },
+              { "velocity", velocityChannel } };
+
+            for (auto &&channel : channels)
             {
-                double time = itVelocity->first;
-                auto *pTimeNode = pDocument->allocate_node(node_element, "time");
-                auto *pTimeString = pDocument->allocate_string(std::to_string(time).c_str());
-                auto *pDataNode = pDocument->allocate_node(node_data, pTimeString);
-                pTimeNode->append_node(pDataNode);
-
-                auto *pVelocityNode = pDocument->allocate_node(node_element, "velocity");
-                bSuccess = m_velocity.writeToXML(pVelocityNode);
-                if (bSuccess)
-                    pVelocityNode->append_node(pTimeNode);
-
-                pNode->append_node(pVelocityNode);
-                ++itVelocity;
+                m_timeHistory.forEach(channel.second,
+                                      [&] (double time, const double *pValues)
+                                      {
+                                          auto *pTimeNode = pDocument->allocate_node(node_element, "time");
+                                          auto &&timeString = std::to_string(time);
+                                          auto *pTimeString = pDocument->allocate_string(timeString.c_str());
+                                          auto *pDataNode = pDocument->allocate_node(node_data, pTimeString);
+                                          pTimeNode->append_node(pDataNode);
+
+                                          auto *pName = pDocument->allocate_string(channel.first.c_str());
+                                          auto *pChannelNode = pDocument->allocate_node(node_element, pName);
+                                          if (isAngularChannel(channel.second))
+                                              bSuccess = Eulers(pValues, m_angleUnits).writeToXML(pChannelNode);
+                                          else
+                                              bSuccess = Vector3d(pValues).writeToXML(pChannelNode);
+
+                                          if (bSuccess)
+                                              pChannelNode->append_node(pTimeNode);
+
+                                          pNode->append_node(pChannelNode);
+                                      });
             }
         }
     }
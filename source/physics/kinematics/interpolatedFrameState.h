@@ -2,6 +2,7 @@
 #define INTERPOLATED_FRAME_STATE_H
 
 #include "frameState.h"
+#include "kinematicTimeHistory.h"
 
 namespace physics
 {
@@ -14,7 +15,8 @@ class ProjectedFrameState;
 
 /**
  * This class stores the kinematic state of a coordinate reference frame and estimates the state at another
- * time by interpolating the time history
+ * time by interpolating the time history. The origin, velocity, acceleration, orientation and rotational rates
+ * and accelerations share a single column of sample times (see KinematicTimeHistory)
  */
 class InterpolatedFrameState
 : public FrameState,
@@ -304,42 +306,6 @@ public:
     EXPORT_STEM virtual double getYawRate(const AngleUnitType &angleUnits,
                                           double t) const override;
 
-private:
-
-    /**
-     * Function to perform map interpolation
-     */
-    template<typename Result, typename Vector>
-    static bool interpolate(double t,
-                            Result &&result,
-                            const std::map<double, Vector> &map)
-    {
-        bool bSuccess = (!map.empty());
-        if (bSuccess)
-        {
-            // if beyond the limits, return the first/last element
-            if (t < map.cbegin()->first)
-                map.cbegin()->second.get(result);
-            else if (t > map.crbegin()->first)
-                map.crbegin()->second.get(result);
-            else
-            {
-                auto &&itLower = map.lower_bound(t);
-                if (itLower == map.cbegin())
-                    --itLower;
-
-                auto &&itUpper = map.upper_bound(t);
-                for (std::size_t i = 0; i < 3; ++i)
-                {
-                    result[i] = itLower->second[i] + (itUpper->second[i] - itLower->second[i]) * t -
-                                itLower->first / (itUpper->first - itLower->first);
-                }
-            }
-        }
-
-        return bSuccess;
-    }
-
 public:
 
     /**
@@ -378,6 +344,18 @@ public:
     EXPORT_STEM virtual bool isSpatiallyEqual(const InterpolatedFrameState &state,
                                               double tol = 0.0) const final;
 
+private:
+
+    /**
+     * Interpolate the time history of the specified channel at the specified time; returns false, leaving the
+     * result unchanged, if the channel has no samples
+     */
+    EXPORT_STEM bool interpolate(std::size_t channel,
+                                 double t,
+                                 Vector3d &result) const;
+
+public:
+
     /**
      * Function to print the contents of this reference frame state
      */
@@ -400,6 +378,26 @@ public:
                                              double yAcceleration,
                                              double zAcceleration) override;
 
+private:
+
+    /**
+     * Set one of the angles of the orientation, rotational rate or rotational acceleration channel at the
+     * current time
+     * @param angleUnits the angle units of the input argument, Degrees or Radians
+     */
+    EXPORT_STEM void setAngle(std::size_t channel,
+                              const math::geometric::orientation::EulerAxisType &axis,
+                              double angle,
+                              const AngleUnitType &angleUnits);
+
+    /**
+     * Set the values of the specified channel at the current time
+     */
+    EXPORT_STEM void setChannel(std::size_t channel,
+                                const double values[3]);
+
+public:
+
     /**
      * Set angle units (Degrees or Radians)
      */
@@ -551,60 +549,36 @@ private:
      */
     Vector3d m_acceleration;
 
-    /**
-     * map of acceleration of the origin of this frame with respect to its parent vs time
-     */
-    std::map<double, Vector3d> m_accelerationMap;
-
     /**
      * orientation angles of this frame with respect to its parent
      */
     Eulers m_orientation;
 
-    /**
-     * map of orientation angles of this frame with respect to its parent vs time
-     */
-    std::map<double, Eulers> m_orientationMap;
-
     /**
      * position of the origin of this frame with respect to its parent
      */
     Vector3d m_origin;
 
-    /**
-     * map of position of the origin of this frame with respect to its parent vs time
-     */
-    std::map<double, Vector3d> m_originMap;
-
     /**
      * rotational accelerations of this frame with respect to its parent
      */
     Eulers m_rotationalAccelerations;
 
-    /**
-     * map of rotational accelerations of this frame with respect to its parent vs time
-     */
-    std::map<double, Eulers> m_rotationalAccelerationsMap;
-
     /**
      * rotational rates of this frame with respect to its parent
      */
     Eulers m_rotationalRates;
 
     /**
-     * map of rotational rates of this frame with respect to its parent vs time
+     * time history of the origin, velocity, acceleration, orientation and rotational rates and accelerations of
+     * this frame with respect to its parent
      */
-    std::map<double, Eulers> m_rotationalRatesMap;
+    KinematicTimeHistory m_timeHistory;
 
     /**
      * velocity of the origin of this frame with respect to its parent
      */
     Vector3d m_velocity;
-
-    /**
-     * map of velocity of the origin of this frame with respect to its parent vs time
-     */
-    std::map<double, Vector3d> m_velocityMap;
 };
 
 }
@@ -2,6 +2,7 @@
 #include "euler_acceleration_axis_type.h"
 #include "euler_rate_axis_type.h"
 #include "interpolatedKinematicState.h"
+#include "math_constants.h"
 #ifdef RAPID_XML
 #include "rapidxml.hpp"
 #endif
@@ -12,8 +13,18 @@
 // file-scoped variables
 static constexpr char factoryName[] = "Interpolated";
 
+// channels of the time history, in the order in which they're serialized
+static constexpr std::size_t accelerationChannel = 0;
+static constexpr std::size_t eulerAccelerationsChannel = 1;
+static constexpr std::size_t eulerRatesChannel = 2;
+static constexpr std::size_t eulersChannel = 3;
+static constexpr std::size_t positionChannel = 4;
+static constexpr std::size_t velocityChannel = 5;
+static constexpr std::size_t numChannels = 6;
+
 // using namespace declarations
 using namespace attributes::abstract;
+using namespace math;
 using namespace math::geometric::orientation;
 using namespace math::linear_algebra::vector;
 using namespace math::trigonometric;
@@ -31,6 +42,14 @@ namespace kinematics
 static FactoryRegistrar<KinematicState>
 factory(factoryName, &InterpolatedKinematicState::create);
 
+/**
+ * Determine whether or not the specified channel stores Euler angles, rates or accelerations
+ */
+static bool isAngularChannel(std::size_t channel)
+{
+    return channel == eulerAccelerationsChannel || channel == eulerRatesChannel || channel == eulersChannel;
+}
+
 /**
  * Constructor
  */
@@ -45,6 +64,7 @@ InterpolatedKinematicState::InterpolatedKinematicState(void)
  * @param angleUnits the units of this object's Euler angles, degrees or Radians
  */
 InterpolatedKinematicState::InterpolatedKinematicState(const AngleUnitType &angleUnits)
+: m_timeHistory(numChannels)
 {
     setAngleUnits(angleUnits);
 }
@@ -53,6 +73,7 @@ InterpolatedKinematicState::InterpolatedKinematicState(const AngleUnitType &angl
  * Copy constructor
  */
 InterpolatedKinematicState::InterpolatedKinematicState(const InterpolatedKinematicState &state)
+: m_timeHistory(numChannels)
 {
     operator = (state);
 }
@@ -61,6 +82,7 @@ InterpolatedKinematicState::InterpolatedKinematicState(const InterpolatedKinemat
  * Move constructor
  */
 InterpolatedKinematicState::InterpolatedKinematicState(InterpolatedKinematicState &&state)
+: m_timeHistory(numChannels)
 {
     operator = (std::move(state));
 }
@@ -82,12 +104,7 @@ InterpolatedKinematicState &InterpolatedKinematicState::operator = (const Interp
     {
         KinematicState::operator = (state);
 
-        m_accelerationMap = state.m_accelerationMap;
-        m_eulerAccelerationsMap = state.m_eulerAccelerationsMap;
-        m_eulerRatesMap = state.m_eulerRatesMap;
-        m_eulersMap = state.m_eulersMap;
-        m_positionMap = state.m_positionMap;
-        m_velocityMap = state.m_velocityMap;
+        m_timeHistory = state.m_timeHistory;
     }
 
     return *this;
@@ -122,12 +139,7 @@ bool InterpolatedKinematicState::operator == (const InterpolatedKinematicState &
     bool bEqual = KinematicState::operator == (state);
     if (bEqual)
     {
-        bEqual = (m_accelerationMap == state.m_accelerationMap &&
-                  m_eulerAccelerationsMap == state.m_eulerAccelerationsMap &&
-                  m_eulerRatesMap == state.m_eulerRatesMap &&
-                  m_eulersMap == state.m_eulersMap &&
-                  m_positionMap == state.m_positionMap &&
-                  m_velocityMap == state.m_velocityMap);
+        bEqual = (m_timeHistory == state.m_timeHistory);
     }
 
     return bEqual;
@@ -168,19 +180,19 @@ InterpolatedKinematicState *InterpolatedKinematicState::clone(void) const
  */
 void InterpolatedKinematicState::convertAngleUnits(const AngleUnitType &angleUnits)
 {
-    m_angleUnits = angleUnits;
-
-    std::for_each(m_eulerAccelerationsMap.begin(),
-                  m_eulerAccelerationsMap.end(),
-                  [&angleUnits] (auto &&pair) { pair.second.convertAngleUnits(angleUnits); });
+    double cnv = 1.0;
+    if (angleUnits == AngleUnitType::Degrees && m_angleUnits == AngleUnitType::Radians)
+        cnv = RADIANS_TO_DEGREES;
+    else if (angleUnits == AngleUnitType::Radians && m_angleUnits == AngleUnitType::Degrees)
+        cnv = DEGREES_TO_RADIANS;
 
-    std::for_each(m_eulerRatesMap.begin(),
-                  m_eulerRatesMap.end(),
-                  [&angleUnits] (auto &&pair) { pair.second.convertAngleUnits(angleUnits); });
-
-    std::for_each(m_eulersMap.begin(),
-                  m_eulersMap.end(),
-                  [&angleUnits] (auto &&pair) { pair.second.convertAngleUnits(angleUnits); });
+    m_angleUnits = angleUnits;
+    if (cnv != 1.0)
+    {
+        m_timeHistory.scale(eulerAccelerationsChannel, cnv);
+        m_timeHistory.scale(eulerRatesChannel, cnv);
+        m_timeHistory.scale(eulersChannel, cnv);
+    }
 }
 
 /**
@@ -201,64 +213,29 @@ std::istream &InterpolatedKinematicState::deserialize(std::istream &stream)
 
     if (stream)
     {
-        std::size_t numAccelerations;
-        stream.read((char *)&numAccelerations, sizeof(std::size_t));
-        m_accelerationMap.clear();
-        for (std::size_t i = 0; i < numAccelerations; ++i)
-        {
-            double time;
-            stream.read((char *)&time, sizeof(double));
-            m_accelerationMap[time].deserialize(stream);
-        }
-
-        std::size_t numEulerAccelerations;
-        stream.read((char *)&numEulerAccelerations, sizeof(std::size_t));
-        m_eulerAccelerationsMap.clear();
-        for (std::size_t i = 0; i < numEulerAccelerations; ++i)
+        m_timeHistory.clear();
+        for (std::size_t channel = 0; stream && channel < numChannels; ++channel)
         {
-            double time;
-            stream.read((char *)&time, sizeof(double));
-            m_eulerAccelerationsMap[time].deserialize(stream);
-        }
-
-        std::size_t numEulerRates;
-        stream.read((char *)&numEulerRates, sizeof(std::size_t));
-        m_eulerRatesMap.clear();
-        for (std::size_t i = 0; i < numEulerRates; ++i)
-        {
-            double time;
-            stream.read((char *)&time, sizeof(double));
-            m_eulerRatesMap[time].deserialize(stream);
-        }
-
-        std::size_t numEulers;
-        stream.read((char *)&numEulers, sizeof(std::size_t));
-        m_eulersMap.clear();
-        for (std::size_t i = 0; i < numEulers; ++i)
-        {
-            double time;
-            stream.read((char *)&time, sizeof(double));
-            m_eulersMap[time].deserialize(stream);
-        }
-
-        std::size_t numPositions;
-        stream.read((char *)&numPositions, sizeof(std::size_t));
-        m_positionMap.clear();
-        for (std::size_t i = 0; i < numPositions; ++i)
-        {
-            double time;
-            stream.read((char *)&time, sizeof(double));
-            m_positionMap[time].deserialize(stream);
-        }
-
-        std::size_t numVelocities;
-        stream.read((char *)&numVelocities, sizeof(std::size_t));
-        m_velocityMap.clear();
-        for (std::size_t i = 0; i < numVelocities; ++i)
-        {
-            double time;
-            stream.read((char *)&time, sizeof(double));
-            m_velocityMap[time].deserialize(stream);
+            std::size_t numSamples;
+            stream.read((char *)&numSamples, sizeof(std::size_t));
+            for (std::size_t i = 0; stream && i < numSamples; ++i)
+            {
+                double time;
+                stream.read((char *)&time, sizeof(double));
+                if (isAngularChannel(channel))
+                {
+                    Eulers eulers;
+                    eulers.deserialize(stream);
+                    eulers.convertAngleUnits(m_angleUnits);
+                    eulers.get(m_timeHistory.insert(channel, time));
+                }
+                else
+                {
+                    Vector3d vector;
+                    vector.deserialize(stream);
+                    vector.get(m_timeHistory.insert(channel, time));
+                }
+            }
         }
     }
 
@@ -270,7 +247,7 @@ std::istream &InterpolatedKinematicState::deserialize(std::istream &stream)
  */
 void InterpolatedKinematicState::getAcceleration(double acceleration[3]) const
 {
-    interpolate(m_t0, acceleration, m_accelerationMap);
+    m_timeHistory.interpolate(accelerationChannel, m_t0, acceleration);
 }
 
 /**
@@ -279,7 +256,7 @@ void InterpolatedKinematicState::getAcceleration(double acceleration[3]) const
 Vector3d &InterpolatedKinematicState::getAcceleration(void)
 {
     m_acceleration.set(0.0, 0.0, 0.0);
-    interpolate(m_t0, m_acceleration, m_accelerationMap);
+    interpolate(accelerationChannel, m_t0, m_acceleration);
 
     return m_acceleration;
 }
@@ -290,7 +267,7 @@ Vector3d &InterpolatedKinematicState::getAcceleration(void)
 Vector3d InterpolatedKinematicState::getAcceleration(void) const
 {
     Vector3d acceleration;
-    interpolate(m_t0, acceleration, m_accelerationMap);
+    interpolate(accelerationChannel, m_t0, acceleration);
 
     return acceleration;
 }
@@ -310,8 +287,8 @@ void InterpolatedKinematicState::getEulerAccelerations(double &rollAccel,
                                                        double &pitchAccel,
                                                        double &yawAccel) const
 {
-    Eulers eulerAccelerations;
-    interpolate(m_t0, eulerAccelerations, m_eulerAccelerationsMap);
+    Eulers eulerAccelerations(m_angleUnits);
+    interpolate(eulerAccelerationsChannel, m_t0, eulerAccelerations);
 
     pitchAccel = eulerAccelerations.getPitch();
     rollAccel = eulerAccelerations.getRoll();
@@ -323,8 +300,9 @@ void InterpolatedKinematicState::getEulerAccelerations(double &rollAccel,
  */
 Eulers &InterpolatedKinematicState::getEulerAccelerations(void)
 {
+    m_eulerAccelerations.setAngleUnits(m_angleUnits);
     m_eulerAccelerations.set(0.0, 0.0, 0.0);
-    interpolate(m_t0, m_eulerAccelerations, m_eulerAccelerationsMap);
+    interpolate(eulerAccelerationsChannel, m_t0, m_eulerAccelerations);
 
     return m_eulerAccelerations;
 }
@@ -334,8 +312,8 @@ Eulers &InterpolatedKinematicState::getEulerAccelerations(void)
  */
 Eulers InterpolatedKinematicState::getEulerAccelerations(void) const
 {
-    Eulers eulerAccelerations;
-    interpolate(m_t0, eulerAccelerations, m_eulerAccelerationsMap);
+    Eulers eulerAccelerations(m_angleUnits);
+    interpolate(eulerAccelerationsChannel, m_t0, eulerAccelerations);
 
     return eulerAccelerations;
 }
@@ -348,8 +326,8 @@ void InterpolatedKinematicState::getEulerRates(double &rollRate,
                                                double &yawRate,
                                                double t) const
 {
-    Eulers eulerRates;
-    interpolate(t, eulerRates, m_eulerRatesMap);
+    Eulers eulerRates(m_angleUnits);
+    interpolate(eulerRatesChannel, t, eulerRates);
 
     pitchRate = eulerRates.getPitch();
     rollRate = eulerRates.getRoll();
@@ -361,8 +339,9 @@ void InterpolatedKinematicState::getEulerRates(double &rollRate,
  */
 Eulers &InterpolatedKinematicState::getEulerRates(void)
 {
+    m_eulerRates.setAngleUnits(m_angleUnits);
     m_eulerRates.set(0.0, 0.0, 0.0);
-    interpolate(m_t0, m_eulerRates, m_eulerRatesMap);
+    interpolate(eulerRatesChannel, m_t0, m_eulerRates);
 
     return m_eulerRates;
 }
@@ -372,8 +351,8 @@ Eulers &InterpolatedKinematicState::getEulerRates(void)
  */
 Eulers InterpolatedKinematicState::getEulerRates(void) const
 {
-    Eulers eulerRates;
-    interpolate(m_t0, eulerRates, m_eulerRatesMap);
+    Eulers eulerRates(m_angleUnits);
+    interpolate(eulerRatesChannel, m_t0, eulerRates);
 
     return eulerRates;
 }
@@ -386,8 +365,8 @@ void InterpolatedKinematicState::getEulers(double &roll,
                                            double &yaw,
                                            double t) const
 {
-    Eulers eulers;
-    interpolate(t, eulers, m_eulersMap);
+    Eulers eulers(m_angleUnits);
+    interpolate(eulersChannel, t, eulers);
 
     pitch = eulers.getPitch();
     roll = eulers.getRoll();
@@ -399,8 +378,9 @@ void InterpolatedKinematicState::getEulers(double &roll,
  */
 Eulers &InterpolatedKinematicState::getEulers(void)
 {
+    m_eulers.setAngleUnits(m_angleUnits);
     m_eulers.set(0.0, 0.0, 0.0);
-    interpolate(m_t0, m_eulers, m_eulersMap);
+    interpolate(eulersChannel, m_t0, m_eulers);
 
     return m_eulers;
 }
@@ -410,8 +390,8 @@ Eulers &InterpolatedKinematicState::getEulers(void)
  */
 Eulers InterpolatedKinematicState::getEulers(void) const
 {
-    Eulers eulers;
-    interpolate(m_t0, eulers, m_eulersMap);
+    Eulers eulers(m_angleUnits);
+    interpolate(eulersChannel, m_t0, eulers);
 
     return eulers;
 }
@@ -473,7 +453,7 @@ double InterpolatedKinematicState::getPitchRate(const AngleUnitType &angleUnits,
 void InterpolatedKinematicState::getPosition(double position[3],
                                              double t) const
 {
-    interpolate(t, position, m_positionMap);
+    m_timeHistory.interpolate(positionChannel, t, position);
 }
 
 /**
@@ -482,7 +462,7 @@ void InterpolatedKinematicState::getPosition(double position[3],
 Vector3d &InterpolatedKinematicState::getPosition(void)
 {
     m_position.set(0.0, 0.0, 0.0);
-    interpolate(m_t0, m_position, m_positionMap);
+    interpolate(positionChannel, m_t0, m_position);
 
     return m_position;
 }
@@ -493,7 +473,7 @@ Vector3d &InterpolatedKinematicState::getPosition(void)
 Vector3d InterpolatedKinematicState::getPosition(void) const
 {
     Vector3d position;
-    interpolate(m_t0, position, m_positionMap);
+    interpolate(positionChannel, m_t0, position);
 
     return position;
 }
@@ -547,7 +527,7 @@ double InterpolatedKinematicState::getRollRate(const AngleUnitType &angleUnits,
 void InterpolatedKinematicState::getVelocity(double velocity[3],
                                              double t) const
 {
-    interpolate(t, velocity, m_velocityMap);
+    m_timeHistory.interpolate(velocityChannel, t, velocity);
 }
 
 /**
@@ -556,7 +536,7 @@ void InterpolatedKinematicState::getVelocity(double velocity[3],
 Vector3d &InterpolatedKinematicState::getVelocity(void)
 {
     m_velocity.set(0.0, 0.0, 0.0);
-    interpolate(m_t0, m_velocity, m_velocityMap);
+    interpolate(velocityChannel, m_t0, m_velocity);
 
     return m_velocity;
 }
@@ -567,7 +547,7 @@ Vector3d &InterpolatedKinematicState::getVelocity(void)
 Vector3d InterpolatedKinematicState::getVelocity(void) const
 {
     Vector3d velocity;
-    interpolate(m_t0, velocity, m_velocityMap);
+    interpolate(velocityChannel, m_t0, velocity);
 
     return velocity;
 }
@@ -623,24 +603,35 @@ bool InterpolatedKinematicState::initialize(void)
     bool bSuccess = KinematicState::initialize();
     if (bSuccess)
     {
-        m_accelerationMap.clear();
-        m_eulerAccelerationsMap.clear();
-        m_eulerRatesMap.clear();
-        m_eulersMap.clear();
-        m_positionMap.clear();
-        m_velocityMap.clear();
+        m_timeHistory.clear();
     }
 
     return bSuccess;
 }
 
+/**
+ * Interpolate the time history of the specified channel at the specified time; returns false, leaving the
+ * result unchanged, if the channel has no samples
+ */
+bool InterpolatedKinematicState::interpolate(std::size_t channel,
+                                             double t,
+                                             Vector3d &result) const
+{
+    double values[3];
+    bool bSuccess = m_timeHistory.interpolate(channel, t, values);
+    if (bSuccess)
+        result.set(values);
+
+    return bSuccess;
+}
+
 /**
  * Determines whether or not two kinematic states are equivalent within the specified tolerance
  */
 bool InterpolatedKinematicState::isEqual(const KinematicState &state,
                                          double tol) const
 {
-    return isEqual(dynamic_cast<const InterpolatedKinematicState &>(state));
+    return isEqual(dynamic_cast<const InterpolatedKinematicState &>(state), tol);
 }
 
 /**
@@ -663,7 +654,7 @@ bool InterpolatedKinematicState::isEqual(const InterpolatedKinematicState &state
 bool InterpolatedKinematicState::isSpatiallyEqual(const KinematicState &state,
                                                   double tol) const
 {
-    return isSpatiallyEqual(dynamic_cast<const InterpolatedKinematicState &>(state));
+    return isSpatiallyEqual(dynamic_cast<const InterpolatedKinematicState &>(state), tol);
 }
 
 /**
@@ -675,63 +666,7 @@ bool InterpolatedKinematicState::isSpatiallyEqual(const InterpolatedKinematicSta
 {
     bool bEqual = (memcmp((void *)this, (void *)&state, sizeof(KinematicState)) == 0);
     if (!bEqual)
-    {
-        auto &&comparator = [&tol] (auto &&left, auto &&right)
-                            {
-                                return left.second.isEqual(right.second, tol);
-                            };
-
-        bEqual = m_accelerationMap.size() == state.m_accelerationMap.size() &&
-                 std::equal(m_accelerationMap.cbegin(),
-                            m_accelerationMap.cend(),
-                            state.m_accelerationMap.begin(),
-                            comparator);
-
-        if (bEqual)
-        {
-            bEqual = m_eulerAccelerationsMap.size() == state.m_eulerAccelerationsMap.size() &&
-                     std::equal(m_eulerAccelerationsMap.cbegin(),
-                                m_eulerAccelerationsMap.cend(),
-                                state.m_eulerAccelerationsMap.begin(),
-                                comparator);
-        }
-
-        if (bEqual)
-        {
-            bEqual = m_eulerRatesMap.size() == state.m_eulerRatesMap.size() &&
-                     std::equal(m_eulerRatesMap.cbegin(),
-                                m_eulerRatesMap.cend(),
-                                state.m_eulerRatesMap.begin(),
-                                comparator);
-        }
-
-        if (bEqual)
-        {
-            bEqual = m_eulersMap.size() == state.m_eulersMap.size() &&
-                     std::equal(m_eulersMap.cbegin(),
-                                m_eulersMap.cend(),
-                                state.m_eulersMap.begin(),
-                                comparator);
-        }
-
-        if (bEqual)
-        {
-            bEqual = m_positionMap.size() == state.m_positionMap.size() &&
-                     std::equal(m_positionMap.cbegin(),
-                                m_positionMap.cend(),
-                                state.m_positionMap.begin(),
-                                comparator);
-        }
-
-        if (bEqual)
-        {
-            bEqual = m_velocityMap.size() == state.m_velocityMap.size() &&
-                     std::equal(m_velocityMap.cbegin(),
-                                m_velocityMap.cend(),
-                                state.m_velocityMap.begin(),
-                                comparator);
-        }
-    }
+        bEqual = m_timeHistory.isEqual(state.m_timeHistory, tol);
 
     return bEqual;
 }
@@ -745,45 +680,27 @@ std::ostream &InterpolatedKinematicState::print(std::ostream &stream) const
 
     if (stream)
     {
-        static const std::vector<std::string> strings = { "Position vs time:",
-                                                          "Velocity vs time:",
-                                                          "Acceleration vs time:",
-                                                          "Eulers vs time:",
-                                                          "Euler rates vs time:",
-                                                          "Euler accelerations vs time:" };
+        static const std::vector<std::pair<std::string, std::size_t>> channels =
+        { { "Position vs time:", positionChannel },
+          { "Velocity vs time:", velocityChannel },
+          { "Acceleration vs time:", accelerationChannel },
+          { "Eulers vs time:", eulersChannel },
+          { "Euler rates vs time:", eulerRatesChannel },
+          { "Euler accelerations vs time:", eulerAccelerationsChannel } };
 
         stream << std::endl;
-        auto &&itStrings = strings.cbegin();
-        for (auto &mapEntry : { m_positionMap,
-                                m_velocityMap,
-                                m_accelerationMap })
-        {
-            stream << *itStrings << std::endl;
-            std::for_each(mapEntry.cbegin(),
-                          mapEntry.cend(),
-                          [&stream] (auto &&pair)
-                          {
-                              stream << pair.first << ", ";
-                              pair.second.print(stream) << std::endl;
-                          });
-
-            ++itStrings;
-        }
-
-        for (auto &mapEntry : { m_eulersMap,
-                                m_eulerRatesMap,
-                                m_eulerAccelerationsMap })
+        for (auto &&channel : channels)
         {
-            stream << *itStrings << std::endl;
-            std::for_each(mapEntry.cbegin(),
-                          mapEntry.cend(),
-                          [&stream] (auto &&pair)
-                          {
-                              stream << pair.first << ", ";
-                              pair.second.print(stream) << std::endl;
-                          });
-
-            ++itStrings;
+            stream << channel.first << std::endl;
+            m_timeHistory.forEach(channel.second,
+                                  [this, &channel, &stream] (double t, const double *pValues)
+                                  {
+                                      stream << t << ", ";
+                                      if (isAngularChannel(channel.second))
+                                          Eulers(pValues, m_angleUnits).print(stream) << std::endl;
+                                      else
+                                          Vector3d(pValues).print(stream) << std::endl;
+                                  });
         }
     }
 
@@ -798,88 +715,40 @@ bool InterpolatedKinematicState::readFromXML(xml_node<> *pNode)
     bool bSuccess = KinematicState::readFromXML(pNode);
     if (bSuccess)
     {
-        auto *pPositionNode = pNode->first_node("position");
-        while (pPositionNode != nullptr)
+        static const std::vector<std::pair<std::string, std::size_t>> channels =
+        { { "position", positionChannel },
+          { "velocity", velocityChannel },
+          { "acceleration", accelerationChannel },
+          { "eulers", eulersChannel },
+          { "eulerRates", eulerRatesChannel },
+          { "eulerAccelerations", eulerAccelerationsChannel } };
+
+        for (auto &&channel : channels)
         {
-            double t = 0.0;
-            auto *pTimeNode = pPositionNode->first_node("time");
-            if (pTimeNode != nullptr)
+            auto *pChannelNode = pNode->first_node(channel.first.c_str());
+            while (pChannelNode != nullptr)
             {
-                t = std::stod(pTimeNode->value());
-                m_positionMap[t].readFromXML(pPositionNode);
+                auto *pTimeNode = pChannelNode->first_node("time");
+                if (pTimeNode != nullptr)
+                {
+                    auto &&t = std::stod(pTimeNode->value());
+                    if (isAngularChannel(channel.second))
+                    {
+                        Eulers eulers;
+                        eulers.readFromXML(pChannelNode);
+                        eulers.convertAngleUnits(m_angleUnits);
+                        eulers.get(m_timeHistory.insert(channel.second, t));
+                    }
+                    else
+                    {
+                        Vector3d vector;
+                        vector.readFromXML(pChannelNode);
+                        vector.get(m_timeHistory.insert(channel.second, t));
+                    }
+                }
+
+                pChannelNode = pChannelNode->next_sibling(channel.first.c_str());
             }
-
-            pPositionNode = pPositionNode->next_sibling("position");
-        }
-
-        auto *pVelocityNode = pNode->first_node("velocity");
-        while (pVelocityNode != nullptr)
-        {
-            double t = 0.0;
-            auto *pTimeNode = pVelocityNode->first_node("time");
-            if (pTimeNode != nullptr)
-            {
-                t = std::stod(pTimeNode->value());
-                m_velocityMap[t].readFromXML(pVelocityNode);
-            }
-
-            pVelocityNode = pVelocityNode->next_sibling("velocity");
-        }
-
-        auto *pAccelerationNode = pNode->first_node("acceleration");
-        while (pAccelerationNode != nullptr)
-        {
-            double t = 0.0;
-            auto *pTimeNode = pAccelerationNode->first_node("time");
-            if (pTimeNode != nullptr)
-            {
-                t = std::stod(pTimeNode->value());
-                m_accelerationMap[t].readFromXML(pAccelerationNode);
-            }
-
-            pAccelerationNode = pAccelerationNode->next_sibling("acceleration");
-        }
-
-        auto *pEulersNode = pNode->first_node("eulers");
-        while (pEulersNode != nullptr)
-        {
-            double t = 0.0;
-            auto *pTimeNode = pEulersNode->first_node("time");
-            if (pTimeNode != nullptr)
-            {
-                t = std::stod(pTimeNode->value());
-                m_eulersMap[t].readFromXML(pEulersNode);
-            }
-
-            pEulersNode = pEulersNode->next_sibling("eulers");
-        }
-
-        auto *pEulerRatesNode = pNode->first_node("eulerRates");
-        while (pEulerRatesNode != nullptr)
-        {
-            double t = 0.0;
-            auto *pTimeNode = pEulerRatesNode->first_node("time");
-            if (pTimeNode != nullptr)
-            {
-                t = std::stod(pTimeNode->value());
-                m_eulerRatesMap[t].readFromXML(pEulerRatesNode);
-            }
-
-            pEulerRatesNode = pEulerRatesNode->next_sibling("eulerRates");
-        }
-
-        auto *pEulerAccelerationsNode = pNode->first_node("eulerAccelerations");
-        while (pEulerAccelerationsNode != nullptr)
-        {
-            double t = 0.0;
-            auto *pTimeNode = pEulerAccelerationsNode->first_node("time");
-            if (pTimeNode != nullptr)
-            {
-                t = std::stod(pTimeNode->value());
-                m_eulerAccelerationsMap[t].readFromXML(pEulerAccelerationsNode);
-            }
-
-            pEulerAccelerationsNode = pEulerAccelerationsNode->next_sibling("eulerAccelerations");
         }
     }
 
@@ -893,73 +762,19 @@ std::ostream &InterpolatedKinematicState::serialize(std::ostream &stream) const
 {
     KinematicState::serialize(stream);
 
-    if (stream)
+    for (std::size_t channel = 0; stream && channel < numChannels; ++channel)
     {
-        auto numAccelerations = m_accelerationMap.size();
-        stream.write((const char *)&numAccelerations, sizeof(std::size_t));
-        auto &&itAcceleration = m_accelerationMap.cbegin();
-        while (itAcceleration != m_accelerationMap.cend())
-        {
-            double time = itAcceleration->first;
-            stream.write((const char *)&time, sizeof(double));
-            itAcceleration->second.serialize(stream);
-            ++itAcceleration;
-        }
-
-        auto numEulerAccelerations = m_eulerAccelerationsMap.size();
-        stream.write((const char *)&numEulerAccelerations, sizeof(std::size_t));
-        auto &&itEulerAcceleration = m_eulerAccelerationsMap.cbegin();
-        while (itEulerAcceleration != m_eulerAccelerationsMap.cend())
-        {
-            double time = itEulerAcceleration->first;
-            stream.write((const char *)&time, sizeof(double));
-            itEulerAcceleration->second.serialize(stream);
-            ++itEulerAcceleration;
-        }
-
-        auto numEulerRates = m_eulerRatesMap.size();
-        stream.write((const char *)&numEulerRates, sizeof(std::size_t));
-        auto &&itEulerRates = m_eulerRatesMap.cbegin();
-        while (itEulerRates != m_eulerRatesMap.cend())
-        {
-            double time = itEulerRates->first;
-            stream.write((const char *)&time, sizeof(double));
-            itEulerRates->second.serialize(stream);
-            ++itEulerRates;
-        }
-
-        auto numEulers = m_eulersMap.size();
-        stream.write((const char *)&numEulers, sizeof(std::size_t));
-        auto &&itEulers = m_eulersMap.cbegin();
-        while (itEulers != m_eulersMap.cend())
-        {
-            double time = itEulers->first;
-            stream.write((const char *)&time, sizeof(double));
-            itEulers->second.serialize(stream);
-            ++itEulers;
-        }
-
-        auto numPositions = m_positionMap.size();
-        stream.write((const char *)&numPositions, sizeof(std::size_t));
-        auto &&itPosition = m_positionMap.cbegin();
-        while (itPosition != m_positionMap.cend())
-        {
-            double time = itPosition->first;
-            stream.write((const char *)&time, sizeof(double));
-            itPosition->second.serialize(stream);
-            ++itPosition;
-        }
-
-        auto numVelocities = m_velocityMap.size();
-        stream.write((const char *)&numVelocities, sizeof(std::size_t));
-        auto &&itVelocity = m_velocityMap.cbegin();
-        while (itVelocity != m_velocityMap.cend())
-        {
-            double time = itVelocity->first;
-            stream.write((const char *)&time, sizeof(double));
-            itVelocity->second.serialize(stream);
-            ++itVelocity;
-        }
+        auto &&numSamples = m_timeHistory.getNumSamples(channel);
+        stream.write((const char *)&numSamples, sizeof(std::size_t));
+        m_timeHistory.forEach(channel,
+                              [this, &channel, &stream] (double time, const double *pValues)
+                              {
+                                  stream.write((const char *)&time, sizeof(double));
+                                  if (isAngularChannel(channel))
+                                      Eulers(pValues, m_angleUnits).serialize(stream);
+                                  else
+                                      Vector3d(pValues).serialize(stream);
+                              });
     }
 
     return stream;
@@ -972,9 +787,25 @@ void InterpolatedKinematicState::setAcceleration(double xAcceleration,
                                                  double yAcceleration,
                                                  double zAcceleration)
 {
-    m_accelerationMap[m_t0].set(xAcceleration,
-                                yAcceleration,
-                                zAcceleration);
+    auto *pAcceleration = m_timeHistory.insert(accelerationChannel, m_t0);
+    pAcceleration[0] = xAcceleration;
+    pAcceleration[1] = yAcceleration;
+    pAcceleration[2] = zAcceleration;
+}
+
+/**
+ * Set one of the angles of the Euler angle, rate or acceleration channel at the current time
+ * @param angleUnits the angle units of the input argument, Degrees or Radians
+ */
+void InterpolatedKinematicState::setAngle(std::size_t channel,
+                                          const EulerAxisType &axis,
+                                          double angle,
+                                          const AngleUnitType &angleUnits)
+{
+    auto *pEulers = m_timeHistory.insert(channel, m_t0);
+    Eulers eulers(pEulers, m_angleUnits);
+    eulers.set(axis, angle, angleUnits);
+    eulers.get(pEulers);
 }
 
 /**
@@ -983,18 +814,6 @@ void InterpolatedKinematicState::setAcceleration(double xAcceleration,
 void InterpolatedKinematicState::setAngleUnits(const AngleUnitType &angleUnits)
 {
     m_angleUnits = angleUnits;
-
-    std::for_each(m_eulerAccelerationsMap.begin(),
-                  m_eulerAccelerationsMap.end(),
-                  [&angleUnits] (auto &&pair) { pair.second.setAngleUnits(angleUnits); });
-
-    std::for_each(m_eulerRatesMap.begin(),
-                  m_eulerRatesMap.end(),
-                  [&angleUnits] (auto &&pair) { pair.second.setAngleUnits(angleUnits); });
-
-    std::for_each(m_eulersMap.begin(),
-                  m_eulersMap.end(),
-                  [&angleUnits] (auto &&pair) { pair.second.setAngleUnits(angleUnits); });
 }
 
 /**
@@ -1002,11 +821,9 @@ void InterpolatedKinematicState::setAngleUnits(const AngleUnitType &angleUnits)
  */
 void InterpolatedKinematicState::setEulerAccelerations(const Eulers &eulerAccelerations)
 {
-    setEulerAccelerations(eulerAccelerations[EulerAccelerationAxisType::Roll],
-                          eulerAccelerations[EulerAccelerationAxisType::Pitch],
-                          eulerAccelerations[EulerAccelerationAxisType::Yaw]);
-
-    m_eulerAccelerationsMap[m_t0].convertAngleUnits(m_angleUnits);
+    Eulers converted(eulerAccelerations);
+    converted.convertAngleUnits(m_angleUnits);
+    converted.get(m_timeHistory.insert(eulerAccelerationsChannel, m_t0));
 }
 
 /**
@@ -1016,10 +833,8 @@ void InterpolatedKinematicState::setEulerAccelerations(double rollAcceleration,
                                                        double pitchAcceleration,
                                                        double yawAcceleration)
 {
-    auto &&eulerAccelerations = m_eulerAccelerationsMap[m_t0];
-    eulerAccelerations.setPitch(pitchAcceleration);
-    eulerAccelerations.setRoll(rollAcceleration);
-    eulerAccelerations.setYaw(yawAcceleration);
+    Eulers eulerAccelerations(rollAcceleration, pitchAcceleration, yawAcceleration, m_angleUnits);
+    eulerAccelerations.get(m_timeHistory.insert(eulerAccelerationsChannel, m_t0));
 }
 
 /**
@@ -1027,11 +842,9 @@ void InterpolatedKinematicState::setEulerAccelerations(double rollAcceleration,
  */
 void InterpolatedKinematicState::setEulerRates(const Eulers &eulerRates)
 {
-    setEulerRates(eulerRates[EulerRateAxisType::Roll],
-                  eulerRates[EulerRateAxisType::Pitch],
-                  eulerRates[EulerRateAxisType::Yaw]);
-
-    m_eulerRatesMap[m_t0].convertAngleUnits(m_angleUnits);
+    Eulers converted(eulerRates);
+    converted.convertAngleUnits(m_angleUnits);
+    converted.get(m_timeHistory.insert(eulerRatesChannel, m_t0));
 }
 
 /**
@@ -1041,10 +854,8 @@ void InterpolatedKinematicState::setEulerRates(double rollRate,
                                                double pitchRate,
                                                double yawRate)
 {
-    auto &&eulerRates = m_eulerRatesMap[m_t0];
-    eulerRates.setPitch(pitchRate);
-    eulerRates.setRoll(rollRate);
-    eulerRates.setYaw(yawRate);
+    Eulers eulerRates(rollRate, pitchRate, yawRate, m_angleUnits);
+    eulerRates.get(m_timeHistory.insert(eulerRatesChannel, m_t0));
 }
 
 /**
@@ -1052,11 +863,9 @@ void InterpolatedKinematicState::setEulerRates(double rollRate,
  */
 void InterpolatedKinematicState::setEulers(const Eulers &eulers)
 {
-    setEulers(eulers[EulerAxisType::Roll],
-              eulers[EulerAxisType::Pitch],
-              eulers[EulerAxisType::Yaw]);
-
-    m_eulersMap[m_t0].convertAngleUnits(m_angleUnits);
+    Eulers converted(eulers);
+    converted.convertAngleUnits(m_angleUnits);
+    converted.get(m_timeHistory.insert(eulersChannel, m_t0));
 }
 
 /**
@@ -1066,10 +875,8 @@ void InterpolatedKinematicState::setEulers(double roll,
                                            double pitch,
                                            double yaw)
 {
-    auto &&eulers = m_eulersMap[m_t0];
-    eulers.setPitch(pitch);
-    eulers.setRoll(roll);
-    eulers.setYaw(yaw);
+    Eulers eulers(roll, pitch, yaw, m_angleUnits);
+    eulers.get(m_timeHistory.insert(eulersChannel, m_t0));
 }
 
 /**
@@ -1079,9 +886,7 @@ void InterpolatedKinematicState::setEulers(double roll,
 void InterpolatedKinematicState::setPitch(double pitch,
                                           const AngleUnitType &angleUnits)
 {
-    auto &&eulers = m_eulersMap[m_t0];
-    eulers.setAngleUnits(m_angleUnits);
-    eulers.setPitch(pitch, angleUnits);
+    setAngle(eulersChannel, EulerAxisType::Pitch, pitch, angleUnits);
 }
 
 /**
@@ -1091,9 +896,7 @@ void InterpolatedKinematicState::setPitch(double pitch,
 void InterpolatedKinematicState::setPitchAcceleration(double pitchAcceleration,
                                                       const AngleUnitType &angleUnits)
 {
-    auto &&eulerAccelerations = m_eulerAccelerationsMap[m_t0];
-    eulerAccelerations.setAngleUnits(m_angleUnits);
-    eulerAccelerations.setPitch(pitchAcceleration, angleUnits);
+    setAngle(eulerAccelerationsChannel, EulerAxisType::Pitch, pitchAcceleration, angleUnits);
 }
 
 /**
@@ -1103,9 +906,7 @@ void InterpolatedKinematicState::setPitchAcceleration(double pitchAcceleration,
 void InterpolatedKinematicState::setPitchRate(double pitchRate,
                                               const AngleUnitType &angleUnits)
 {
-    auto &&eulerRates = m_eulerRatesMap[m_t0];
-    eulerRates.setAngleUnits(m_angleUnits);
-    eulerRates.setPitch(pitchRate, angleUnits);
+    setAngle(eulerRatesChannel, EulerAxisType::Pitch, pitchRate, angleUnits);
 }
 
 /**
@@ -1115,9 +916,10 @@ void InterpolatedKinematicState::setPosition(double xPosition,
                                              double yPosition,
                                              double zPosition)
 {
-    m_positionMap[m_t0].set(xPosition,
-                            yPosition,
-                            zPosition);
+    auto *pPosition = m_timeHistory.insert(positionChannel, m_t0);
+    pPosition[0] = xPosition;
+    pPosition[1] = yPosition;
+    pPosition[2] = zPosition;
 }
 
 /**
@@ -1127,9 +929,7 @@ void InterpolatedKinematicState::setPosition(double xPosition,
 void InterpolatedKinematicState::setRoll(double roll,
                                          const AngleUnitType &angleUnits)
 {
-    auto &&eulers = m_eulersMap[m_t0];
-    eulers.setAngleUnits(m_angleUnits);
-    eulers.setRoll(roll, angleUnits);
+    setAngle(eulersChannel, EulerAxisType::Roll, roll, angleUnits);
 }
 
 /**
@@ -1139,9 +939,7 @@ void InterpolatedKinematicState::setRoll(double roll,
 void InterpolatedKinematicState::setRollAcceleration(double rollAcceleration,
                                                      const AngleUnitType &angleUnits)
 {
-    auto &&eulerAccelerations = m_eulerAccelerationsMap[m_t0];
-    eulerAccelerations.setAngleUnits(m_angleUnits);
-    eulerAccelerations.setRoll(rollAcceleration, angleUnits);
+    setAngle(eulerAccelerationsChannel, EulerAxisType::Roll, rollAcceleration, angleUnits);
 }
 
 /**
@@ -1151,9 +949,64 @@ void InterpolatedKinematicState::setRollAcceleration(double rollAcceleration,
 void InterpolatedKinematicState::setRollRate(double rollRate,
                                              const AngleUnitType &angleUnits)
 {
-    auto &&eulerRates = m_eulerRatesMap[m_t0];
-    eulerRates.setAngleUnits(m_angleUnits);
-    eulerRates.setRoll(rollRate, angleUnits);
+    setAngle(eulerRatesChannel, EulerAxisType::Roll, rollRate, angleUnits);
+}
+
+/**
+ * Load the time history of this state in bulk, replacing its current contents. The sample times must be
+ * strictly increasing, and each non-empty vector of values must contain one entry per sample time; Euler
+ * angles, rates and accelerations are converted to this object's angle units. Returns false, leaving this
+ * object unchanged, if the inputs are invalid
+ */
+bool InterpolatedKinematicState::setTimeHistory(const std::vector<double> &times,
+                                                const std::vector<Vector3d> &positions,
+                                                const std::vector<Vector3d> &velocities,
+                                                const std::vector<Vector3d> &accelerations,
+                                                const std::vector<Eulers> &eulers,
+                                                const std::vector<Eulers> &eulerRates,
+                                                const std::vector<Eulers> &eulerAccelerations)
+{
+    const std::vector<std::pair<std::size_t, const std::vector<Vector3d> *>> vectorChannels =
+    { { accelerationChannel, &accelerations },
+      { positionChannel, &positions },
+      { velocityChannel, &velocities } };
+
+    const std::vector<std::pair<std::size_t, const std::vector<Eulers> *>> eulerChannels =
+    { { eulerAccelerationsChannel, &eulerAccelerations },
+      { eulerRatesChannel, &eulerRates },
+      { eulersChannel, &eulers } };
+
+    bool bSuccess = true;
+    for (auto &&channel : vectorChannels)
+        bSuccess &= (channel.second->empty() || channel.second->size() == times.size());
+
+    for (auto &&channel : eulerChannels)
+        bSuccess &= (channel.second->empty() || channel.second->size() == times.size());
+
+    KinematicTimeHistory timeHistory(numChannels);
+    if (bSuccess)
+        bSuccess = timeHistory.setTimes(times);
+
+    if (bSuccess)
+    {
+        for (auto &&channel : vectorChannels)
+            for (std::size_t i = 0; i < channel.second->size(); ++i)
+                (*channel.second)[i].get(timeHistory.set(channel.first, i));
+
+        for (auto &&channel : eulerChannels)
+        {
+            for (std::size_t i = 0; i < channel.second->size(); ++i)
+            {
+                Eulers converted((*channel.second)[i]);
+                converted.convertAngleUnits(m_angleUnits);
+                converted.get(timeHistory.set(channel.first, i));
+            }
+        }
+
+        m_timeHistory.swap(timeHistory);
+    }
+
+    return bSuccess;
 }
 
 /**
@@ -1163,9 +1016,10 @@ void InterpolatedKinematicState::setVelocity(double xVelocity,
                                              double yVelocity,
                                              double zVelocity)
 {
-    m_velocityMap[m_t0].set(xVelocity,
-                            yVelocity,
-                            zVelocity);
+    auto *pVelocity = m_timeHistory.insert(velocityChannel, m_t0);
+    pVelocity[0] = xVelocity;
+    pVelocity[1] = yVelocity;
+    pVelocity[2] = zVelocity;
 }
 
 /**
@@ -1175,9 +1029,7 @@ void InterpolatedKinematicState::setVelocity(double xVelocity,
 void InterpolatedKinematicState::setYaw(double yaw,
                                         const AngleUnitType &angleUnits)
 {
-    auto &&eulers = m_eulersMap[m_t0];
-    eulers.setAngleUnits(m_angleUnits);
-    eulers.setYaw(yaw, angleUnits);
+    setAngle(eulersChannel, EulerAxisType::Yaw, yaw, angleUnits);
 }
 
 /**
@@ -1187,9 +1039,7 @@ void InterpolatedKinematicState::setYaw(double yaw,
 void InterpolatedKinematicState::setYawAcceleration(double yawAcceleration,
                                                     const AngleUnitType &angleUnits)
 {
-    auto &&eulerAccelerations = m_eulerAccelerationsMap[m_t0];
-    eulerAccelerations.setAngleUnits(m_angleUnits);
-    eulerAccelerations.setYaw(yawAcceleration, angleUnits);
+    setAngle(eulerAccelerationsChannel, EulerAxisType::Yaw, yawAcceleration, angleUnits);
 }
 
 /**
@@ -1199,9 +1049,7 @@ void InterpolatedKinematicState::setYawAcceleration(double yawAcceleration,
 void InterpolatedKinematicState::setYawRate(double yawRate,
                                             const AngleUnitType &angleUnits)
 {
-    auto &&eulerRates = m_eulerRatesMap[m_t0];
-    eulerRates.setAngleUnits(m_angleUnits);
-    eulerRates.setYaw(yawRate, angleUnits);
+    setAngle(eulerRatesChannel, EulerAxisType::Yaw, yawRate, angleUnits);
 }
 
 /**
@@ -1211,12 +1059,7 @@ void InterpolatedKinematicState::swap(InterpolatedKinematicState &state)
 {
     KinematicState::swap(state);
 
-    m_accelerationMap.swap(state.m_accelerationMap);
-    m_eulerAccelerationsMap.swap(state.m_eulerAccelerationsMap);
-    m_eulerRatesMap.swap(state.m_eulerRatesMap);
-    m_eulersMap.swap(state.m_eulersMap);
-    m_positionMap.swap(state.m_positionMap);
-    m_velocityMap.swap(state.m_velocityMap);
+    m_timeHistory.swap(state.m_timeHistory);
 }
 #ifdef RAPID_XML
 /**
@@ -1231,112 +1074,37 @@ bool InterpolatedKinematicState::writeToXML(xml_node<> *pNode)
         bSuccess = (pDocument != nullptr);
         if (bSuccess)
         {
-            auto &&itAcceleration = m_accelerationMap.cbegin();
-            while (itAcceleration != m_accelerationMap.cend())
-            {
-                double time = itAcceleration->first;
-                auto *pTimeNode = pDocument->allocate_node(node_element, "time");
-                auto *pTimeString = pDocument->allocate_string(std::to_string(time).c_str());
-                auto *pDataNode = pDocument->allocate_node(node_data, pTimeString);
-                pTimeNode->append_node(pDataNode);
-
-                auto *pAccelerationNode = pDocument->allocate_node(node_element, "acceleration");
-                bSuccess = m_acceleration.writeToXML(pAccelerationNode);
-                if (bSuccess)
-                    pAccelerationNode->append_node(pTimeNode);
-
-                pNode->append_node(pAccelerationNode);
-                ++itAcceleration;
-            }
-
-            auto &&itEulerAcceleration = m_eulerAccelerationsMap.cbegin();
-            while (itEulerAcceleration != m_eulerAccelerationsMap.cend())
-            {
-                double time = itEulerAcceleration->first;
-                auto *pTimeNode = pDocument->allocate_node(node_element, "time");
-                auto *pTimeString = pDocument->allocate_string(std::to_string(time).c_str());
-                auto *pDataNode = pDocument->allocate_node(node_data, pTimeString);
-                pTimeNode->append_node(pDataNode);
-
-                auto *pEulerAccelerationsNode = pDocument->allocate_node(node_element, "eulerAccelerations");
-                bSuccess = m_eulerAccelerations.writeToXML(pEulerAccelerationsNode);
-                if (bSuccess)
-                    pEulerAccelerationsNode->append_node(pTimeNode);
-
-                pNode->append_node(pEulerAccelerationsNode);
-                ++itEulerAcceleration;
-            }
-
-            auto &&itEulerRates = m_eulerRatesMap.cbegin();
-            while (itEulerRates != m_eulerRatesMap.cend())
-            {
-                double time = itEulerRates->first;
-                auto *pTimeNode = pDocument->allocate_node(node_element, "time");
-                auto *pTimeString = pDocument->allocate_string(std::to_string(time).c_str());
-                auto *pDataNode = pDocument->allocate_node(node_data, pTimeString);
-                pTimeNode->append_node(pDataNode);
-
-                auto *pEulerRatesNode = pDocument->allocate_node(node_element, "eulerRates");
-                bSuccess = m_eulerRates.writeToXML(pEulerRatesNode);
-                if (bSuccess)
-                    pEulerRatesNode->append_node(pTimeNode);
-
-                pNode->append_node(pEulerRatesNode);
-                ++itEulerRates;
-            }
-
-            auto &&itEulers = m_eulersMap.cbegin();
-            while (itEulers != m_eulersMap.cend())
-            {
-                double time = itEulers->first;
-                auto *pTimeNode = pDocument->allocate_node(node_element, "time");
-                auto *pTimeString = pDocument->allocate_string(std::to_string(time).c_str());
-                auto *pDataNode = pDocument->allocate_node(node_data, pTimeString);
-                pTimeNode->append_node(pDataNode);
-
-                auto *pEulersNode = pDocument->allocate_node(node_element, "eulers");
-                bSuccess = m_eulers.writeToXML(pEulersNode);
-                if (bSuccess)
-                    pEulersNode->append_node(pTimeNode);
-
-                pNode->append_node(pEulersNode);
-                ++itEulers;
-            }
-
-            auto &&itPosition = m_positionMap.cbegin();
-            while (itPosition != m_positionMap.cend())
-            {
-                double time = itPosition->first;
-                auto *pTimeNode = pDocument->allocate_node(node_element, "time");
-                auto *pTimeString = pDocument->allocate_string(std::to_string(time).c_str());
-                auto *pDataNode = pDocument->allocate_node(node_data, pTimeString);
-                pTimeNode->append_node(pDataNode);
-
-                auto *pPositionNode = pDocument->allocate_node(node_element, "position");
-                bSuccess = m_position.writeToXML(pPositionNode);
-                if (bSuccess)
-                    pPositionNode->append_node(pTimeNode);
-
-                pNode->append_node(pPositionNode);
-                ++itPosition;
-            }
-
-            auto &&itVelocity = m_velocityMap.cbegin();
-            while (itVelocity != m_velocityMap.cend())
+            static const std::vector<std::pair<std::string, std::size_t>> channels =
+            { { "acceleration", accelerationChannel },
+              { "eulerAccelerations", eulerAccelerationsChannel },
+              { "eulerRates", eulerRatesChannel },
+              { "eulers", eulersChannel },
+              { "position", positionChannel },
+              { "velocity", velocityChannel } };
+
+            for (auto &&channel : channels)
             {
-                double time = itVelocity->first;
-                auto *pTimeNode = pDocument->allocate_node(node_element, "time");
-                auto *pTimeString = pDocument->allocate_string(std::to_string(time).c_str());
-                auto *pDataNode = pDocument->allocate_node(node_data, pTimeString);
-                pTimeNode->append_node(pDataNode);
-
-                auto *pVelocityNode = pDocument->allocate_node(node_element, "velocity");
-                bSuccess = m_velocity.writeToXML(pVelocityNode);
-                if (bSuccess)
-                    pVelocityNode->append_node(pTimeNode);
-
-                pNode->append_node(pVelocityNode);
-                ++itVelocity;
+                m_timeHistory.forEach(channel.second,
+                                      [&] (double time, const double *pValues)
+                                      {
+                                          auto *pTimeNode = pDocument->allocate_node(node_element, "time");
+                                          auto &&timeString = std::to_string(time);
+                                          auto *pTimeString = pDocument->allocate_string(timeString.c_str());
+                                          auto *pDataNode = pDocument->allocate_node(node_data, pTimeString);
+                                          pTimeNode->append_node(pDataNode);
+
+                                          auto *pName = pDocument->allocate_string(channel.first.c_str());
+                                          auto *pChannelNode = pDocument->allocate_node(node_element, pName);
+                                          if (isAngularChannel(channel.second))
+                                              bSuccess = Eulers(pValues, m_angleUnits).writeToXML(pChannelNode);
+                                          else
+                                              bSuccess = Vector3d(pValues).writeToXML(pChannelNode);
+
+                                          if (bSuccess)
+                                              pChannelNode->append_node(pTimeNode);
+
+                                          pNode->append_node(pChannelNode);
+                                      });
             }
         }
     }
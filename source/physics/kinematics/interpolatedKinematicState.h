@@ -2,6 +2,8 @@
 #define INTERPOLATED_KINEMATIC_STATE_H
 
 #include "kinematicState.h"
+#include "kinematicTimeHistory.h"
+#include <vector>
 
 namespace physics
 {
@@ -11,7 +13,8 @@ namespace kinematics
 
 /**
  * This class stores the kinematic state of a 3-d point/space object as a time history and estimates the state
- * at another time by interpolating the time history
+ * at another time by interpolating the time history. The position, velocity, acceleration and Euler angles,
+ * rates and accelerations share a single column of sample times (see KinematicTimeHistory)
  */
 class InterpolatedKinematicState
 : public KinematicState,
@@ -289,42 +292,6 @@ public:
     EXPORT_STEM virtual double getYawRate(const AngleUnitType &angleUnits,
                                           double t) const override;
 
-private:
-
-    /**
-     * Function to perform map interpolation
-     */
-    template<typename Result, typename Vector>
-    static bool interpolate(double t,
-                            Result &&result,
-                            const std::map<double, Vector> &map)
-    {
-        bool bSuccess = (!map.empty());
-        if (bSuccess)
-        {
-            // if beyond the limits, return the first/last element
-            if (t < map.cbegin()->first)
-                map.cbegin()->second.get(result);
-            else if (t > map.crbegin()->first)
-                map.crbegin()->second.get(result);
-            else
-            {
-                auto &&itLower = map.lower_bound(t);
-                if (itLower == map.cbegin())
-                    --itLower;
-
-                auto &&itUpper = map.upper_bound(t);
-                for (std::size_t i = 0; i < 3; ++i)
-                {
-                    result[i] = itLower->second[i] + (itUpper->second[i] - itLower->second[i]) * t -
-                                itLower->first / (itUpper->first - itLower->first);
-                }
-            }
-        }
-
-        return bSuccess;
-    }
-
 public:
 
     /**
@@ -358,6 +325,18 @@ public:
     EXPORT_STEM virtual bool isSpatiallyEqual(const InterpolatedKinematicState &state,
                                               double tol = 0.0) const final;
 
+private:
+
+    /**
+     * Interpolate the time history of the specified channel at the specified time; returns false, leaving the
+     * result unchanged, if the channel has no samples
+     */
+    EXPORT_STEM bool interpolate(std::size_t channel,
+                                 double t,
+                                 Vector3d &result) const;
+
+public:
+
     /**
      * Function to print the contents of this reference frame state
      */
@@ -380,6 +359,19 @@ public:
                                              double yAcceleration,
                                              double zAcceleration) override;
 
+private:
+
+    /**
+     * Set one of the angles of the Euler angle, rate or acceleration channel at the current time
+     * @param angleUnits the angle units of the input argument, Degrees or Radians
+     */
+    EXPORT_STEM void setAngle(std::size_t channel,
+                              const math::geometric::orientation::EulerAxisType &axis,
+                              double angle,
+                              const AngleUnitType &angleUnits);
+
+public:
+
     /**
      * Set angle units (Degrees or Radians)
      */
@@ -470,6 +462,20 @@ public:
     EXPORT_STEM virtual void setRollRate(double rollRate,
                                          const AngleUnitType &angleUnits) override;
 
+    /**
+     * Load the time history of this state in bulk, replacing its current contents. The sample times must be
+     * strictly increasing, and each non-empty vector of values must contain one entry per sample time; Euler
+     * angles, rates and accelerations are converted to this object's angle units. Returns false, leaving this
+     * object unchanged, if the inputs are invalid
+     */
+    EXPORT_STEM bool setTimeHistory(const std::vector<double> &times,
+                                    const std::vector<Vector3d> &positions,
+                                    const std::vector<Vector3d> &velocities = {},
+                                    const std::vector<Vector3d> &accelerations = {},
+                                    const std::vector<Eulers> &eulers = {},
+                                    const std::vector<Eulers> &eulerRates = {},
+                                    const std::vector<Eulers> &eulerAccelerations = {});
+
     /**
      * Set the state initial velocity
      */
@@ -515,60 +521,35 @@ private:
      */
     Vector3d m_acceleration;
 
-    /**
-     * this state's map of accelerations vs time
-     */
-    std::map<double, Vector3d> m_accelerationMap;
-
     /**
      * this state's interpolated Euler angle accelerations (degrees/sec/sec [default] or radians/sec/sec)
      */
     Eulers m_eulerAccelerations;
 
-    /**
-     * this state's map of Euler accelerations vs time
-     */
-    std::map<double, Eulers> m_eulerAccelerationsMap;
-
     /**
      * this state's interpolated Euler angle rates (degrees/sec [default] or radians/sec)
      */
     Eulers m_eulerRates;
 
-    /**
-     * this state's map of Euler rates vs time
-     */
-    std::map<double, Eulers> m_eulerRatesMap;
-
     /**
      * this state's interpolated Euler angles (degrees [default] or radians)
      */
     Eulers m_eulers;
 
-    /**
-     * this state's map of Euler angles vs time
-     */
-    std::map<double, Eulers> m_eulersMap;
-
     /**
      * this state's interpolated position
      */
     Vector3d m_position;
 
     /**
-     * this state's map of position vs time
+     * this state's time history of position, velocity, acceleration and Euler angles, rates and accelerations
      */
-    std::map<double, Vector3d> m_positionMap;
+    KinematicTimeHistory m_timeHistory;
 
     /**
      * this state's interpolated velocity
      */
     Vector3d m_velocity;
-
-    /**
-     * this state's map of velocity vs time
-     */
-    std::map<double, Vector3d> m_velocityMap;
 };
 
 }
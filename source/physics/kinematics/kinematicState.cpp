@@ -493,7 +493,7 @@ bool KinematicState::isEqual(const KinematicState &state,
     {
         bEqual = m_angleUnits == state.m_angleUnits &&
                  std::fabs(m_t0 - state.m_t0) <= tol &&
-                 isSpatiallyEqual(state);
+                 isSpatiallyEqual(state, tol);
     }
 
     return bEqual;
@@ -0,0 +1,379 @@
+#include "kinematicTimeHistory.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace physics
+{
+
+namespace kinematics
+{
+
+/**
+ * Constructor
+ * @param numChannels the number of channels (at most MAXIMUM_CHANNELS)
+ */
+KinematicTimeHistory::KinematicTimeHistory(std::size_t numChannels)
+: m_cursor(0),
+  m_numChannels(std::min(numChannels, MAXIMUM_CHANNELS)),
+  m_numSamples(m_numChannels, 0),
+  m_values(m_numChannels)
+{
+
+}
+
+/**
+ * Copy constructor
+ */
+KinematicTimeHistory::KinematicTimeHistory(const KinematicTimeHistory &history)
+: m_cursor(0),
+  m_numChannels(0)
+{
+    operator = (history);
+}
+
+/**
+ * Move constructor
+ */
+KinematicTimeHistory::KinematicTimeHistory(KinematicTimeHistory &&history)
+: m_cursor(0),
+  m_numChannels(0)
+{
+    operator = (std::move(history));
+}
+
+/**
+ * Destructor
+ */
+KinematicTimeHistory::~KinematicTimeHistory(void)
+{
+
+}
+
+/**
+ * Copy assignment operator
+ */
+KinematicTimeHistory &KinematicTimeHistory::operator = (const KinematicTimeHistory &history)
+{
+    if (&history != this)
+    {
+        m_cursor = history.m_cursor.load(std::memory_order_relaxed);
+        m_masks = history.m_masks;
+        m_numChannels = history.m_numChannels;
+        m_numSamples = history.m_numSamples;
+        m_times = history.m_times;
+        m_values = history.m_values;
+    }
+
+    return *this;
+}
+
+/**
+ * Move assignment operator
+ */
+KinematicTimeHistory &KinematicTimeHistory::operator = (KinematicTimeHistory &&history)
+{
+    if (&history != this)
+    {
+        history.swap(*this);
+    }
+
+    return *this;
+}
+
+/**
+ * Equality operator
+ */
+bool KinematicTimeHistory::operator == (const KinematicTimeHistory &history) const
+{
+    return m_numChannels == history.m_numChannels &&
+           m_times == history.m_times &&
+           m_masks == history.m_masks &&
+           m_values == history.m_values;
+}
+
+/**
+ * Remove all samples
+ */
+void KinematicTimeHistory::clear(void)
+{
+    m_cursor = 0;
+    m_masks.clear();
+    m_times.clear();
+    std::fill(m_numSamples.begin(), m_numSamples.end(), 0);
+    for (auto &&values : m_values)
+        values.clear();
+}
+
+/**
+ * Remove the earliest sample of the specified channel; the sample time is removed once no channel is defined
+ * at that time
+ */
+void KinematicTimeHistory::eraseFirst(std::size_t channel)
+{
+    if (channel < m_numChannels && m_numSamples[channel] > 0)
+    {
+        auto &&mask = std::uint32_t(1) << channel;
+        std::size_t index = 0;
+        while (!(m_masks[index] & mask))
+            ++index;
+
+        m_masks[index] &= ~mask;
+        std::fill_n(m_values[channel].begin() + 3 * index, 3, 0.0);
+        --m_numSamples[channel];
+        if (m_masks[index] == 0)
+        {
+            m_masks.erase(m_masks.begin() + index);
+            m_times.erase(m_times.begin() + index);
+            for (auto &&values : m_values)
+                values.erase(values.begin() + 3 * index, values.begin() + 3 * index + 3);
+        }
+    }
+}
+
+/**
+ * Find the index of the last sample time at or before the specified time; returns the number of sample times
+ * if the specified time precedes the first sample
+ */
+std::size_t KinematicTimeHistory::findLowerBound(double t) const
+{
+    auto &&numTimes = m_times.size();
+    if (numTimes == 0 || t < m_times[0])
+        return numTimes;
+
+    // try the interval found by the previous search, then the one following it
+    auto index = m_cursor.load(std::memory_order_relaxed);
+    if (index < numTimes && m_times[index] <= t)
+    {
+        if (index + 1 == numTimes || t < m_times[index + 1])
+            return index;
+
+        if (index + 2 == numTimes || t < m_times[index + 2])
+        {
+            m_cursor.store(index + 1, std::memory_order_relaxed);
+
+            return index + 1;
+        }
+    }
+
+    index = std::size_t(std::upper_bound(m_times.cbegin(), m_times.cend(), t) - m_times.cbegin()) - 1;
+    m_cursor.store(index, std::memory_order_relaxed);
+
+    return index;
+}
+
+/**
+ * Get the name of this class
+ */
+std::string KinematicTimeHistory::getClassName(void) const
+{
+    return "KinematicTimeHistory";
+}
+
+/**
+ * Get the number of channels
+ */
+std::size_t KinematicTimeHistory::getNumChannels(void) const
+{
+    return m_numChannels;
+}
+
+/**
+ * Get the number of samples of the specified channel
+ */
+std::size_t KinematicTimeHistory::getNumSamples(std::size_t channel) const
+{
+    return channel < m_numChannels ? m_numSamples[channel] : 0;
+}
+
+/**
+ * Get the sample times
+ */
+const std::vector<double> &KinematicTimeHistory::getTimes(void) const
+{
+    return m_times;
+}
+
+/**
+ * Get a pointer to the three values of the specified channel at the specified time, adding a sample (with
+ * zero values) if the channel is not defined at that time; returns null if the channel index is invalid
+ */
+double *KinematicTimeHistory::insert(std::size_t channel,
+                                     double t)
+{
+    if (channel >= m_numChannels)
+        return nullptr;
+
+    // samples are usually added in increasing order of time, in which case they're appended
+    std::size_t index = m_times.size();
+    if (!m_times.empty() && t <= m_times.back())
+        index = std::size_t(std::lower_bound(m_times.cbegin(), m_times.cend(), t) - m_times.cbegin());
+
+    if (index == m_times.size() || m_times[index] != t)
+    {
+        m_masks.insert(m_masks.begin() + index, 0);
+        m_times.insert(m_times.begin() + index, t);
+        for (auto &&values : m_values)
+            values.insert(values.begin() + 3 * index, 3, 0.0);
+    }
+
+    return set(channel, index);
+}
+
+/**
+ * Interpolate the values of the specified channel at the specified time; times preceding the first sample or
+ * following the last sample of the channel evaluate to the first or last sample, respectively. Returns false,
+ * leaving values unchanged, if the channel has no samples
+ */
+bool KinematicTimeHistory::interpolate(std::size_t channel,
+                                       double t,
+                                       double values[3]) const
+{
+    bool bSuccess = (channel < m_numChannels && m_numSamples[channel] > 0);
+    if (bSuccess)
+    {
+        auto &&mask = std::uint32_t(1) << channel;
+        auto &&numTimes = m_times.size();
+        auto &&index = findLowerBound(t);
+
+        // find the nearest samples of this channel on either side of the interval
+        auto lower = index, upper = index + 1;
+        if (index == numTimes)
+            upper = 0;
+        else
+        {
+            while (lower < numTimes && !(m_masks[lower] & mask))
+                lower = lower > 0 ? lower - 1 : numTimes;
+        }
+
+        while (upper < numTimes && !(m_masks[upper] & mask))
+            ++upper;
+
+        auto *pValues = m_values[channel].data();
+        if (lower == numTimes)
+            std::copy_n(pValues + 3 * upper, 3, values);
+        else if (upper == numTimes || m_times[lower] == t)
+            std::copy_n(pValues + 3 * lower, 3, values);
+        else
+        {
+            auto &&alpha = (t - m_times[lower]) / (m_times[upper] - m_times[lower]);
+            auto *pLower = pValues + 3 * lower;
+            auto *pUpper = pValues + 3 * upper;
+            for (std::size_t i = 0; i < 3; ++i)
+                values[i] = pLower[i] + alpha * (pUpper[i] - pLower[i]);
+        }
+    }
+
+    return bSuccess;
+}
+
+/**
+ * Determines whether or not two time histories are equivalent within the specified tolerance
+ */
+bool KinematicTimeHistory::isEqual(const KinematicTimeHistory &history,
+                                   double tol) const
+{
+    bool bEqual = (m_numChannels == history.m_numChannels &&
+                   m_times == history.m_times &&
+                   m_masks == history.m_masks);
+    for (std::size_t channel = 0; bEqual && channel < m_numChannels; ++channel)
+    {
+        bEqual = std::equal(m_values[channel].cbegin(),
+                            m_values[channel].cend(),
+                            history.m_values[channel].cbegin(),
+                            [&tol] (double left, double right) { return std::fabs(left - right) <= tol; });
+    }
+
+    return bEqual;
+}
+
+/**
+ * Reserve storage for the specified number of sample times
+ */
+void KinematicTimeHistory::reserve(std::size_t numSamples)
+{
+    m_masks.reserve(numSamples);
+    m_times.reserve(numSamples);
+    for (auto &&values : m_values)
+        values.reserve(3 * numSamples);
+}
+
+/**
+ * Multiply the values of the specified channel by a factor
+ */
+void KinematicTimeHistory::scale(std::size_t channel,
+                                 double factor)
+{
+    if (channel < m_numChannels)
+        for (auto &&value : m_values[channel])
+            value *= factor;
+}
+
+/**
+ * Get a pointer to the three values of the specified channel at the sample time with the specified index, and
+ * mark the channel as defined at that time; returns null if either index is invalid
+ */
+double *KinematicTimeHistory::set(std::size_t channel,
+                                  std::size_t index)
+{
+    if (channel >= m_numChannels || index >= m_times.size())
+        return nullptr;
+
+    auto &&mask = std::uint32_t(1) << channel;
+    if (!(m_masks[index] & mask))
+    {
+        m_masks[index] |= mask;
+        ++m_numSamples[channel];
+    }
+
+    return m_values[channel].data() + 3 * index;
+}
+
+/**
+ * Replace the contents of this object with the specified sample times, at which no channel is yet defined (use
+ * set() to assign the values of each channel); returns false, leaving this object unchanged, if the times are
+ * not strictly increasing
+ */
+bool KinematicTimeHistory::setTimes(const std::vector<double> &times)
+{
+    bool bSuccess = (std::adjacent_find(times.cbegin(), times.cend(), std::greater_equal<double>()) ==
+                     times.cend());
+    if (bSuccess)
+    {
+        clear();
+        m_masks.assign(times.size(), 0);
+        m_times = times;
+        for (auto &&values : m_values)
+            values.assign(3 * times.size(), 0.0);
+    }
+
+    return bSuccess;
+}
+
+/**
+ * Get the number of sample times
+ */
+std::size_t KinematicTimeHistory::size(void) const
+{
+    return m_times.size();
+}
+
+/**
+ * Swap function
+ */
+void KinematicTimeHistory::swap(KinematicTimeHistory &history)
+{
+    auto &&cursor = m_cursor.load(std::memory_order_relaxed);
+    m_cursor = history.m_cursor.load(std::memory_order_relaxed);
+    history.m_cursor = cursor;
+
+    m_masks.swap(history.m_masks);
+    std::swap(m_numChannels, history.m_numChannels);
+    m_numSamples.swap(history.m_numSamples);
+    m_times.swap(history.m_times);
+    m_values.swap(history.m_values);
+}
+
+}
+
+}
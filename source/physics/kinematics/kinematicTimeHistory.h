@@ -0,0 +1,244 @@
+#ifndef KINEMATIC_TIME_HISTORY_H
+#define KINEMATIC_TIME_HISTORY_H
+
+#include "export_library.h"
+#include "reflective.h"
+#include "swappable.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace physics
+{
+
+namespace kinematics
+{
+
+/**
+ * This class stores the time histories of one or more three-component kinematic quantities (channels, e.g.,
+ * position, velocity and Euler angles) in columnar form: a single sorted column of sample times is shared by
+ * all channels, and the values of each channel are stored contiguously, three per sample. A channel need not
+ * be defined at every sample time; a bit mask per sample records which channels are defined.
+ *
+ * Interpolation locates the interval that brackets the requested time with a single search of the time
+ * column; the interval found by the previous search is tried first, so that queries made at monotonically
+ * increasing times do not require a binary search. Samples are appended in constant time when added in
+ * increasing order of time, or may be loaded in bulk via setTimes()
+ */
+class KinematicTimeHistory final
+: virtual private attributes::abstract::Reflective,
+  public attributes::interfaces::Swappable<KinematicTimeHistory>
+{
+public:
+
+    /**
+     * the maximum number of channels
+     */
+    static constexpr std::size_t MAXIMUM_CHANNELS = 32;
+
+    /**
+     * Constructor
+     * @param numChannels the number of channels (at most MAXIMUM_CHANNELS)
+     */
+    EXPORT_STEM KinematicTimeHistory(std::size_t numChannels);
+
+    /**
+     * Copy constructor
+     */
+    EXPORT_STEM KinematicTimeHistory(const KinematicTimeHistory &history);
+
+    /**
+     * Move constructor
+     */
+    EXPORT_STEM KinematicTimeHistory(KinematicTimeHistory &&history);
+
+    /**
+     * Destructor
+     */
+    EXPORT_STEM virtual ~KinematicTimeHistory(void) override;
+
+    /**
+     * Copy assignment operator
+     */
+    EXPORT_STEM KinematicTimeHistory &operator = (const KinematicTimeHistory &history);
+
+    /**
+     * Move assignment operator
+     */
+    EXPORT_STEM KinematicTimeHistory &operator = (KinematicTimeHistory &&history);
+
+    /**
+     * Equality operator
+     */
+    EXPORT_STEM bool operator == (const KinematicTimeHistory &history) const;
+
+    /**
+     * Remove all samples
+     */
+    EXPORT_STEM void clear(void);
+
+    /**
+     * Remove the earliest sample of the specified channel; the sample time is removed once no channel is
+     * defined at that time
+     */
+    EXPORT_STEM void eraseFirst(std::size_t channel);
+
+    /**
+     * Invoke a function upon each sample of the specified channel, in increasing order of time
+     * @param function a function object which accepts the sample time and a pointer to the three values of the
+     *                 channel at that time
+     */
+    template<typename Function>
+    void forEach(std::size_t channel,
+                 Function &&function) const
+    {
+        if (channel < m_numChannels)
+        {
+            auto &&mask = std::uint32_t(1) << channel;
+            auto *pValues = m_values[channel].data();
+            for (std::size_t i = 0; i < m_times.size(); ++i)
+                if (m_masks[i] & mask)
+                    function(m_times[i], pValues + 3 * i);
+        }
+    }
+
+    /**
+     * Invoke a function upon each sample of the specified channel, in increasing order of time
+     * @param function a function object which accepts the sample time and a pointer to the three values of the
+     *                 channel at that time, which may be modified
+     */
+    template<typename Function>
+    void forEach(std::size_t channel,
+                 Function &&function)
+    {
+        if (channel < m_numChannels)
+        {
+            auto &&mask = std::uint32_t(1) << channel;
+            auto *pValues = m_values[channel].data();
+            for (std::size_t i = 0; i < m_times.size(); ++i)
+                if (m_masks[i] & mask)
+                    function(m_times[i], pValues + 3 * i);
+        }
+    }
+
+    /**
+     * Get the name of this class
+     */
+    EXPORT_STEM virtual std::string getClassName(void) const override;
+
+    /**
+     * Get the number of channels
+     */
+    EXPORT_STEM std::size_t getNumChannels(void) const;
+
+    /**
+     * Get the number of samples of the specified channel
+     */
+    EXPORT_STEM std::size_t getNumSamples(std::size_t channel) const;
+
+    /**
+     * Get the sample times
+     */
+    EXPORT_STEM const std::vector<double> &getTimes(void) const;
+
+    /**
+     * Get a pointer to the three values of the specified channel at the specified time, adding a sample (with
+     * zero values) if the channel is not defined at that time; returns null if the channel index is invalid
+     */
+    EXPORT_STEM double *insert(std::size_t channel,
+                               double t);
+
+    /**
+     * Interpolate the values of the specified channel at the specified time; times preceding the first sample
+     * or following the last sample of the channel evaluate to the first or last sample, respectively. Returns
+     * false, leaving values unchanged, if the channel has no samples
+     */
+    EXPORT_STEM bool interpolate(std::size_t channel,
+                                 double t,
+                                 double values[3]) const;
+
+    /**
+     * Determines whether or not two time histories are equivalent within the specified tolerance
+     */
+    EXPORT_STEM bool isEqual(const KinematicTimeHistory &history,
+                             double tol = 0.0) const;
+
+    /**
+     * Reserve storage for the specified number of sample times
+     */
+    EXPORT_STEM void reserve(std::size_t numSamples);
+
+    /**
+     * Multiply the values of the specified channel by a factor
+     */
+    EXPORT_STEM void scale(std::size_t channel,
+                           double factor);
+
+    /**
+     * Get a pointer to the three values of the specified channel at the sample time with the specified index,
+     * and mark the channel as defined at that time; returns null if either index is invalid
+     */
+    EXPORT_STEM double *set(std::size_t channel,
+                            std::size_t index);
+
+    /**
+     * Replace the contents of this object with the specified sample times, at which no channel is yet defined
+     * (use set() to assign the values of each channel); returns false, leaving this object unchanged, if the
+     * times are not strictly increasing
+     */
+    EXPORT_STEM bool setTimes(const std::vector<double> &times);
+
+    /**
+     * Get the number of sample times
+     */
+    EXPORT_STEM std::size_t size(void) const;
+
+    /**
+     * Swap function
+     */
+    EXPORT_STEM virtual void swap(KinematicTimeHistory &history) override;
+
+private:
+
+    /**
+     * Find the index of the last sample time at or before the specified time; returns the number of sample
+     * times if the specified time precedes the first sample
+     */
+    EXPORT_STEM std::size_t findLowerBound(double t) const;
+
+    /**
+     * the index of the sample time found by the most recent search
+     */
+    mutable std::atomic<std::size_t> m_cursor;
+
+    /**
+     * bit masks (one per sample time) indicating which channels are defined at each sample time
+     */
+    std::vector<std::uint32_t> m_masks;
+
+    /**
+     * the number of channels
+     */
+    std::size_t m_numChannels;
+
+    /**
+     * the number of samples of each channel
+     */
+    std::vector<std::size_t> m_numSamples;
+
+    /**
+     * the sample times, in increasing order
+     */
+    std::vector<double> m_times;
+
+    /**
+     * the values of each channel, three per sample time (zero where the channel is not defined)
+     */
+    std::vector<std::vector<double>> m_values;
+};
+
+}
+
+}
+
+#endif
@@ -218,6 +218,16 @@ MotionState *MotionStateContainer::getLatestMotionState(const ReferenceFrame *pF
     return pMotionState;
 }
 
+/**
+ * Retrieve the latest motion state associated with the specified interned coordinate reference frame and
+ * coordinate system; returns non-null upon success
+ */
+MotionState *
+MotionStateContainer::getLatestMotionState(const InternedIdentifier &frameAndCoordinateSystem) const
+{
+    return m_motionStates.getLatestEntry(frameAndCoordinateSystem);
+}
+
 /**
  * Retrieve the latest motion states for all coordinate reference frames and coordinate systems; returns true
  * upon success and entries are appended to input argument
@@ -257,6 +267,17 @@ MotionStateContainer::getMostRecentAvailableMotionState(double time,
     return pMotionState;
 }
 
+/**
+ * Retrieve the most recently available motion state associated with the specified interned coordinate reference
+ * frame and coordinate system; returns non-null upon success
+ */
+MotionState *
+MotionStateContainer::getMostRecentAvailableMotionState(double time,
+                                                        const InternedIdentifier &frameAndCoordinateSystem) const
+{
+    return m_motionStates.getMostRecentAvailableEntry(frameAndCoordinateSystem, time);
+}
+
 /**
  * Retrieve the most recently available motion states described in the specified coordinate reference frame and
  * coordinate system; matching entries are appended to input argument
@@ -295,6 +316,16 @@ MotionState *MotionStateContainer::getMotionState(double time,
     return pMotionState;
 }
 
+/**
+ * Retrieve a motion state described in the specified interned coordinate reference frame and coordinate system
+ * tagged at the provided time; returns non-null upon success
+ */
+MotionState *MotionStateContainer::getMotionState(double time,
+                                                  const InternedIdentifier &frameAndCoordinateSystem) const
+{
+    return m_motionStates.getEntry(frameAndCoordinateSystem, time);
+}
+
 /**
  * Get this object's motion state container
  */
@@ -398,6 +429,19 @@ bool MotionStateContainer::getMotionStates(std::vector<MotionState *> &motionSta
     return bSuccess;
 }
 
+/**
+ * Retrieve all motion states described in the specified interned coordinate reference frame and coordinate
+ * system tagged between the provided starting and ending times; returns true upon success and entries are
+ * appended to input argument
+ */
+bool MotionStateContainer::getMotionStates(std::vector<MotionState *> &motionStates,
+                                           double startTime,
+                                           double endTime,
+                                           const InternedIdentifier &frameAndCoordinateSystem) const
+{
+    return m_motionStates.getEntries(frameAndCoordinateSystem, startTime, endTime, motionStates);
+}
+
 /**
  * Initialization function
  */
@@ -406,6 +450,37 @@ bool MotionStateContainer::initialize(void)
     return m_motionStates.initialize();
 }
 
+/**
+ * Intern the specified coordinate reference frame and coordinate system; the returned handle may be used to
+ * query any motion state container for the motion states described in that frame and coordinate system
+ */
+InternedIdentifier MotionStateContainer::internFrameAndCoordinateSystem(const std::string &frame,
+                                                                        const CoordinateType &coordinateType)
+{
+    return IdentifierAndTimeSortedContainer<MotionState,
+                                            std::string,
+                                            double,
+                                            &MotionState::getFrameAndCoordinateSystem,
+                                            &MotionState::getTime>::internEntryId(frame + "_" +
+                                                                                  coordinateType.toString());
+}
+
+/**
+ * Intern the specified coordinate reference frame and coordinate system; the returned handle may be used to
+ * query any motion state container for the motion states described in that frame and coordinate system.
+ * Returns an invalid handle if the frame is null
+ */
+InternedIdentifier MotionStateContainer::internFrameAndCoordinateSystem(const ReferenceFrame *pFrame,
+                                                                        const CoordinateType &coordinateType)
+{
+    if (pFrame != nullptr)
+    {
+        return internFrameAndCoordinateSystem(pFrame->getName(), coordinateType);
+    }
+
+    return InternedIdentifier();
+}
+
 /**
  * Remove a motion state by value from this container
  */
@@ -520,6 +595,15 @@ std::size_t MotionStateContainer::size(const ReferenceFrame *pFrame,
     return 0;
 }
 
+/**
+ * Return the number of motion states described in the specified interned coordinate reference frame and
+ * coordinate system
+ */
+std::size_t MotionStateContainer::size(const InternedIdentifier &frameAndCoordinateSystem) const
+{
+    return m_motionStates.size(frameAndCoordinateSystem);
+}
+
 /**
  * Swap function
  */
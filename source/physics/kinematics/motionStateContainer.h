@@ -16,7 +16,9 @@ class ReferenceFrame;
 
 /**
  * This class implements a container for motion states and stores and retrieves them first by coordinate
- * reference frame and system, and then by time
+ * reference frame and system, and then by time. Frame and coordinate system pairs which are queried
+ * repeatedly may be interned via internFrameAndCoordinateSystem(); look-ups through the interned handle
+ * neither allocate nor compare strings
  */
 class MotionStateContainer
 : public attributes::interfaces::Initializable,
@@ -151,6 +153,13 @@ public:
                                                           const CoordinateType &coordinateType =
                                                           CoordinateType::Cartesian) const final;
 
+    /**
+     * Retrieve the latest motion state associated with the specified interned coordinate reference frame and
+     * coordinate system; returns non-null upon success
+     */
+    EXPORT_STEM virtual MotionState *
+    getLatestMotionState(const containers::InternedIdentifier &frameAndCoordinateSystem) const final;
+
     /**
      * Retrieve the latest motion states for all coordinate reference frames and coordinate systems; returns
      * true upon success and entries are appended to input argument
@@ -175,6 +184,14 @@ public:
                                                                        const CoordinateType &coordinateType =
                                                                        CoordinateType::Cartesian) const final;
 
+    /**
+     * Retrieve the most recently available motion state associated with the specified interned coordinate
+     * reference frame and coordinate system; returns non-null upon success
+     */
+    EXPORT_STEM virtual MotionState *
+    getMostRecentAvailableMotionState(double time,
+                                      const containers::InternedIdentifier &frameAndCoordinateSystem) const final;
+
     /**
      * Retrieve the most recently available motion states described in the specified coordinate reference frame
      * and coordinate system; matching entries are appended to input argument
@@ -201,6 +218,14 @@ public:
                                                     const CoordinateType &coordinateType =
                                                     CoordinateType::Cartesian) const final;
 
+    /**
+     * Retrieve a motion state described in the specified interned coordinate reference frame and coordinate
+     * system tagged at the provided time; returns non-null upon success
+     */
+    EXPORT_STEM virtual MotionState *
+    getMotionState(double time,
+                   const containers::InternedIdentifier &frameAndCoordinateSystem) const final;
+
     /**
      * Get this object's motion state container
      */
@@ -271,11 +296,39 @@ public:
                                              const CoordinateType &coordinateType =
                                              CoordinateType::Cartesian) const final;
 
+    /**
+     * Retrieve all motion states described in the specified interned coordinate reference frame and coordinate
+     * system tagged between the provided starting and ending times; returns true upon success and entries are
+     * appended to input argument
+     */
+    EXPORT_STEM virtual bool getMotionStates(std::vector<MotionState *> &motionStates,
+                                             double startTime,
+                                             double endTime,
+                                             const containers::InternedIdentifier &frameAndCoordinateSystem)
+                                             const final;
+
     /**
      * Initialization function
      */
     virtual bool initialize(void) override;
 
+    /**
+     * Intern the specified coordinate reference frame and coordinate system; the returned handle may be used
+     * to query any motion state container for the motion states described in that frame and coordinate system
+     */
+    EXPORT_STEM static containers::InternedIdentifier
+    internFrameAndCoordinateSystem(const std::string &frame,
+                                   const CoordinateType &coordinateType = CoordinateType::Cartesian);
+
+    /**
+     * Intern the specified coordinate reference frame and coordinate system; the returned handle may be used
+     * to query any motion state container for the motion states described in that frame and coordinate system.
+     * Returns an invalid handle if the frame is null
+     */
+    EXPORT_STEM static containers::InternedIdentifier
+    internFrameAndCoordinateSystem(const ReferenceFrame *pFrame,
+                                   const CoordinateType &coordinateType = CoordinateType::Cartesian);
+
     /**
      * Remove a motion state by value from this container
      */
@@ -349,6 +402,13 @@ public:
                                          const CoordinateType &coordinateType =
                                          CoordinateType::Cartesian) const final;
 
+    /**
+     * Return the number of motion states described in the specified interned coordinate reference frame and
+     * coordinate system
+     */
+    EXPORT_STEM virtual std::size_t size(const containers::InternedIdentifier &frameAndCoordinateSystem)
+                                         const final;
+
     /**
      * Swap function
      */
@@ -191,6 +191,7 @@ ProjectedFrameState *ProjectedFrameState::clone(void) const
  */
 void ProjectedFrameState::convertAngleUnits(const AngleUnitType &angleUnits)
 {
+    ++m_revision;
     m_angleUnits = angleUnits;
     m_orientation.convertAngleUnits(m_angleUnits);
     m_rotationalAccelerations.convertAngleUnits(m_angleUnits);
@@ -621,6 +622,7 @@ bool ProjectedFrameState::initialize(void)
  */
 void ProjectedFrameState::initializeTimeDerivatives(void)
 {
+    ++m_revision;
     m_acceleration.set(0.0, 0.0, 0.0);
     m_rotationalAccelerations.set(0.0, 0.0, 0.0);
     m_rotationalRates.set(0.0, 0.0, 0.0);
@@ -765,6 +767,7 @@ void ProjectedFrameState::setAcceleration(double xAcceleration,
                                           double yAcceleration,
                                           double zAcceleration)
 {
+    ++m_revision;
     m_acceleration.set(xAcceleration,
                        yAcceleration,
                        zAcceleration);
@@ -775,6 +778,7 @@ void ProjectedFrameState::setAcceleration(double xAcceleration,
  */
 void ProjectedFrameState::setAngleUnits(const AngleUnitType &angleUnits)
 {
+    ++m_revision;
     m_angleUnits = angleUnits;
     m_orientation.setAngleUnits(m_angleUnits);
     m_rotationalAccelerations.setAngleUnits(m_angleUnits);
@@ -786,6 +790,7 @@ void ProjectedFrameState::setAngleUnits(const AngleUnitType &angleUnits)
  */
 void ProjectedFrameState::setOrientation(const Eulers &orientation)
 {
+    ++m_revision;
     setOrientation(orientation[EulerAxisType::Roll],
                    orientation[EulerAxisType::Pitch],
                    orientation[EulerAxisType::Yaw]);
@@ -800,6 +805,7 @@ void ProjectedFrameState::setOrientation(double roll,
                                          double pitch,
                                          double yaw)
 {
+    ++m_revision;
     m_orientation.setPitch(pitch);
     m_orientation.setRoll(roll);
     m_orientation.setYaw(yaw);
@@ -812,6 +818,7 @@ void ProjectedFrameState::setOrigin(double xPosition,
                                     double yPosition,
                                     double zPosition)
 {
+    ++m_revision;
     m_origin.setX(xPosition);
     m_origin.setY(yPosition);
     m_origin.setZ(zPosition);
@@ -824,6 +831,7 @@ void ProjectedFrameState::setOrigin(double xPosition,
 void ProjectedFrameState::setPitch(double pitch,
                                    const AngleUnitType &angleUnits)
 {
+    ++m_revision;
     m_orientation.setPitch(pitch, angleUnits);
 }
 
@@ -834,6 +842,7 @@ void ProjectedFrameState::setPitch(double pitch,
 void ProjectedFrameState::setPitchAcceleration(double pitchAcceleration,
                                                const AngleUnitType &angleUnits)
 {
+    ++m_revision;
     m_rotationalAccelerations.setPitch(pitchAcceleration, angleUnits);
 }
 
@@ -844,6 +853,7 @@ void ProjectedFrameState::setPitchAcceleration(double pitchAcceleration,
 void ProjectedFrameState::setPitchRate(double pitchRate,
                                        const AngleUnitType &angleUnits)
 {
+    ++m_revision;
     m_rotationalRates.setPitch(pitchRate, angleUnits);
 }
 
@@ -854,6 +864,7 @@ void ProjectedFrameState::setPitchRate(double pitchRate,
 void ProjectedFrameState::setRoll(double roll,
                                   const AngleUnitType &angleUnits)
 {
+    ++m_revision;
     m_orientation.setRoll(roll, angleUnits);
 }
 
@@ -864,6 +875,7 @@ void ProjectedFrameState::setRoll(double roll,
 void ProjectedFrameState::setRollAcceleration(double rollAcceleration,
                                               const AngleUnitType &angleUnits)
 {
+    ++m_revision;
     m_rotationalAccelerations.setRoll(rollAcceleration, angleUnits);
 }
 
@@ -874,6 +886,7 @@ void ProjectedFrameState::setRollAcceleration(double rollAcceleration,
 void ProjectedFrameState::setRollRate(double rollRate,
                                       const AngleUnitType &angleUnits)
 {
+    ++m_revision;
     m_rotationalRates.setRoll(rollRate, angleUnits);
 }
 
@@ -882,6 +895,7 @@ void ProjectedFrameState::setRollRate(double rollRate,
  */
 void ProjectedFrameState::setRotationalAccelerations(const Eulers &rotationalAccelerations)
 {
+    ++m_revision;
     setRotationalAccelerations(rotationalAccelerations[EulerAccelerationAxisType::Roll],
                                rotationalAccelerations[EulerAccelerationAxisType::Pitch],
                                rotationalAccelerations[EulerAccelerationAxisType::Yaw]);
@@ -896,6 +910,7 @@ void ProjectedFrameState::setRotationalAccelerations(double rollAcceleration,
                                                      double pitchAcceleration,
                                                      double yawAcceleration)
 {
+    ++m_revision;
     m_rotationalAccelerations[EulerAccelerationAxisType::Pitch] = pitchAcceleration;
     m_rotationalAccelerations[EulerAccelerationAxisType::Roll] = rollAcceleration;
     m_rotationalAccelerations[EulerAccelerationAxisType::Yaw] = yawAcceleration;
@@ -906,6 +921,7 @@ void ProjectedFrameState::setRotationalAccelerations(double rollAcceleration,
  */
 void ProjectedFrameState::setRotationalRates(const Eulers &rotationalRates)
 {
+    ++m_revision;
     setRotationalRates(rotationalRates[EulerRateAxisType::Roll],
                        rotationalRates[EulerRateAxisType::Pitch],
                        rotationalRates[EulerRateAxisType::Yaw]);
@@ -920,6 +936,7 @@ void ProjectedFrameState::setRotationalRates(double rollRate,
                                              double pitchRate,
                                              double yawRate)
 {
+    ++m_revision;
     m_rotationalRates[EulerRateAxisType::Pitch] = pitchRate;
     m_rotationalRates[EulerRateAxisType::Roll] = rollRate;
     m_rotationalRates[EulerRateAxisType::Yaw] = yawRate;
@@ -932,6 +949,7 @@ void ProjectedFrameState::setVelocity(double xVelocity,
                                       double yVelocity,
                                       double zVelocity)
 {
+    ++m_revision;
     m_velocity.setX(xVelocity);
     m_velocity.setY(yVelocity);
     m_velocity.setZ(zVelocity);
@@ -944,6 +962,7 @@ void ProjectedFrameState::setVelocity(double xVelocity,
 void ProjectedFrameState::setYaw(double yaw,
                                  const AngleUnitType &angleUnits)
 {
+    ++m_revision;
     m_orientation.setYaw(yaw, angleUnits);
 }
 
@@ -954,6 +973,7 @@ void ProjectedFrameState::setYaw(double yaw,
 void ProjectedFrameState::setYawAcceleration(double yawAcceleration,
                                              const AngleUnitType &angleUnits)
 {
+    ++m_revision;
     m_rotationalAccelerations.setYaw(yawAcceleration, angleUnits);
 }
 
@@ -964,6 +984,7 @@ void ProjectedFrameState::setYawAcceleration(double yawAcceleration,
 void ProjectedFrameState::setYawRate(double yawRate,
                                      const AngleUnitType &angleUnits)
 {
+    ++m_revision;
     m_rotationalRates.setYaw(yawRate, angleUnits);
 }
 
@@ -590,7 +590,7 @@ bool ProjectedKinematicState::initialize(void)
 bool ProjectedKinematicState::isEqual(const KinematicState &state,
                                       double tol) const
 {
-    return isEqual(dynamic_cast<const ProjectedKinematicState &>(state));
+    return isEqual(dynamic_cast<const ProjectedKinematicState &>(state), tol);
 }
 
 /**
@@ -613,7 +613,7 @@ bool ProjectedKinematicState::isEqual(const ProjectedKinematicState &state,
 bool ProjectedKinematicState::isSpatiallyEqual(const KinematicState &state,
                                                double tol) const
 {
-    return isSpatiallyEqual(dynamic_cast<const ProjectedKinematicState &>(state));
+    return isSpatiallyEqual(dynamic_cast<const ProjectedKinematicState &>(state), tol);
 }
 
 /**
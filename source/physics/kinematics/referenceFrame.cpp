@@ -51,7 +51,8 @@ static GarbageCollector<ReferenceFrame> garbageCollector;
  */
 ReferenceFrame::ReferenceFrame(void)
 : m_frameStateType("ProjectedFrameState"),
-  m_pParentFrame(nullptr)
+  m_pParentFrame(nullptr),
+  m_revision(0)
 {
     garbageCollector.addObject(this);
 }
@@ -61,7 +62,8 @@ ReferenceFrame::ReferenceFrame(void)
  * @param pParentFrame a pointer to the parent frame
  */
 ReferenceFrame::ReferenceFrame(ReferenceFrame *pParentFrame)
-: m_pParentFrame(nullptr)
+: m_pParentFrame(nullptr),
+  m_revision(0)
 {
     garbageCollector.addObject(this);
 
@@ -81,7 +83,8 @@ ReferenceFrame::ReferenceFrame(ReferenceFrame *pParentFrame)
  */
 ReferenceFrame::ReferenceFrame(ReferenceFrame *pParentFrame,
                                const std::string &state)
-: m_pParentFrame(nullptr)
+: m_pParentFrame(nullptr),
+  m_revision(0)
 {
     garbageCollector.addObject(this);
 
@@ -110,7 +113,8 @@ ReferenceFrame::ReferenceFrame(ReferenceFrame *pParentFrame,
                                FrameStateType &&frameStateType,
                                const std::string &state)
 : m_frameStateType(frameStateType),
-  m_pParentFrame(nullptr)
+  m_pParentFrame(nullptr),
+  m_revision(0)
 {
     garbageCollector.addObject(this);
 
@@ -130,7 +134,8 @@ ReferenceFrame::ReferenceFrame(ReferenceFrame *pParentFrame,
  * Copy constructor
  */
 ReferenceFrame::ReferenceFrame(const ReferenceFrame &frame)
-: m_pParentFrame(nullptr)
+: m_pParentFrame(nullptr),
+  m_revision(0)
 {
     garbageCollector.addObject(this);
 
@@ -141,7 +146,8 @@ ReferenceFrame::ReferenceFrame(const ReferenceFrame &frame)
  * Move constructor
  */
 ReferenceFrame::ReferenceFrame(ReferenceFrame &&frame)
-: m_pParentFrame(nullptr)
+: m_pParentFrame(nullptr),
+  m_revision(0)
 {
     garbageCollector.releaseObject(&frame);
     garbageCollector.addObject(this);
@@ -253,6 +259,7 @@ bool ReferenceFrame::addChild(ReferenceFrame *pChildFrame)
 
             m_children.push_back(pChildFrame);
             pChildFrame->m_pParentFrame = this;
+            ++pChildFrame->m_revision;
         }
     }
 
@@ -555,6 +562,8 @@ bool ReferenceFrame::copyFrameStates(const ReferenceFrame *pFrame)
  */
 void ReferenceFrame::copyFrameStates(const tFrameStates &frameStates)
 {
+    ++m_revision;
+
     // eliminate frame states in the current object that are not present in the input object
     auto &&itFrameState = m_frameStates.begin();
     while (itFrameState != m_frameStates.end())
@@ -746,7 +755,10 @@ FrameState *const ReferenceFrame::createFrameState(const std::string &state) con
             pFrameState = ProjectedFrameState::create(state);
 
         if (pFrameState != nullptr)
+        {
             m_frameStates[state] = pFrameState;
+            ++m_revision;
+        }
     }
 
     return pFrameState;
@@ -1125,6 +1137,7 @@ bool ReferenceFrame::deleteFrameState(FrameState *&pFrameState)
         if (pFrameState == itFrameState->second)
         {
             itFrameState = m_frameStates.erase(itFrameState);
+            ++m_revision;
             if (pFrameState != nullptr)
             {
                 delete pFrameState;
@@ -1156,6 +1169,7 @@ void ReferenceFrame::deleteFrameStates(void)
     }
 
     m_frameStates.clear();
+    ++m_revision;
 }
 
 /**
@@ -1213,6 +1227,7 @@ std::istream &ReferenceFrame::deserialize(std::istream &stream)
 
                 auto &&state = pFrameState->getName();
                 m_frameStates[state] = pFrameState;
+                ++m_revision;
             }
         }
 
@@ -1748,6 +1763,9 @@ FrameState *const ReferenceFrame::getFrameState(const std::string &state) const
  */
 ReferenceFrame::tFrameStates &ReferenceFrame::getFrameStates(void)
 {
+    // the map may be modified through the returned reference
+    ++m_revision;
+
     return m_frameStates;
 }
 
@@ -2071,6 +2089,15 @@ double ReferenceFrame::getPitchRate(double t,
     throw std::runtime_error("ReferenceFrame::getPitchRate(): Invalid/non-existent frame state given!");
 }
 
+/**
+ * Get the revision of this frame; the revision changes whenever this frame is reparented or a frame state is
+ * added to or removed from it
+ */
+std::size_t ReferenceFrame::getRevision(void) const
+{
+    return m_revision;
+}
+
 /**
  * Get this frame's right sibling
  */
@@ -3145,6 +3172,8 @@ bool ReferenceFrame::readFromXML(xml_node<> *pNode)
                         }
                         else
                             pFrame->m_frameStates.emplace(std::make_pair(frameStateName, pFrameState));
+
+                        ++pFrame->m_revision;
                     }
 
                     ++index;
@@ -3173,6 +3202,7 @@ void ReferenceFrame::removeChild(ReferenceFrame *pChildFrame)
     if (itChild != m_children.cend())
     {
         pChildFrame->m_pParentFrame = nullptr;
+        ++pChildFrame->m_revision;
         m_children.erase(itChild);
     }
 }
@@ -3185,7 +3215,10 @@ bool ReferenceFrame::removeFrameState(const std::string &state)
     auto &&itFrameState = m_frameStates.find(state);
     bool bSuccess = (itFrameState != m_frameStates.cend());
     if (bSuccess)
+    {
         m_frameStates.erase(itFrameState);
+        ++m_revision;
+    }
 
     return bSuccess;
 }
@@ -3202,6 +3235,7 @@ bool ReferenceFrame::removeFrameState(FrameState *pFrameState)
         if (pFrameState == itFrameState->second)
         {
             itFrameState = m_frameStates.erase(itFrameState);
+            ++m_revision;
             bSuccess = true;
         }
         else
@@ -3217,6 +3251,7 @@ bool ReferenceFrame::removeFrameState(FrameState *pFrameState)
 void ReferenceFrame::removeFrameStates(void)
 {
     m_frameStates.clear();
+    ++m_revision;
 }
 
 /**
@@ -3843,6 +3878,9 @@ void ReferenceFrame::swap(ReferenceFrame &frame)
     m_motionStates.swap(frame.m_motionStates);
     m_name.swap(frame.m_name);
     std::swap(m_pParentFrame, frame.m_pParentFrame);
+
+    ++m_revision;
+    ++frame.m_revision;
 }
 
 /**
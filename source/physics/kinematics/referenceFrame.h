@@ -75,6 +75,7 @@ public:
     /**
      * Friend class declarations
      */
+    friend class CompositeFrameTransform;
     template<typename> friend class memory::GarbageCollector;
     friend class MotionState;
 
@@ -905,6 +906,12 @@ public:
                                             const AngleUnitType &angleUnits,
                                             const std::string &state = DEFAULT_FRAME_STATE) const final;
 
+    /**
+     * Get the revision of this frame; the revision changes whenever this frame is reparented or a frame state is
+     * added to or removed from it
+     */
+    EXPORT_STEM virtual std::size_t getRevision(void) const final;
+
 private:
 
     /**
@@ -1813,6 +1820,11 @@ private:
      * pointer to the parent frame
      */
     ReferenceFrame *m_pParentFrame;
+
+    /**
+     * count of the changes made to this frame's parent and to its map of frame states
+     */
+    mutable std::size_t m_revision;
 };
 
 }
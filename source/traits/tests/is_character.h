@@ -0,0 +1,34 @@
+#ifndef IS_CHARACTER_H
+#define IS_CHARACTER_H
+
+#include <type_traits>
+
+namespace traits
+{
+
+namespace tests
+{
+
+/**
+ * Type traits struct to determine whether or not T is a character type (char, signed char, unsigned char,
+ * wchar_t, char16_t or char32_t), irrespective of cv-qualification
+ */
+template<typename T>
+struct is_character final
+{
+    /**
+     * Static constants
+     */
+    static const bool value = std::is_same<typename std::remove_cv<T>::type, char>::value ||
+                              std::is_same<typename std::remove_cv<T>::type, signed char>::value ||
+                              std::is_same<typename std::remove_cv<T>::type, unsigned char>::value ||
+                              std::is_same<typename std::remove_cv<T>::type, wchar_t>::value ||
+                              std::is_same<typename std::remove_cv<T>::type, char16_t>::value ||
+                              std::is_same<typename std::remove_cv<T>::type, char32_t>::value;
+};
+
+}
+
+}
+
+#endif
@@ -3,16 +3,27 @@
 
 #include "iterable.h"
 #include "string_utilities.h"
+#include "thread_pool.h"
 #include "token_iterator.h"
+#include "tokenizer.h"
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <memory>
 #include <sstream>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace utilities
 {
 
 /**
- * This class implements an iterable csv-formatted string tokenizer
+ * This class implements an iterable csv-formatted string tokenizer. In addition to the iterable interface,
+ * which tokenizes a string held by this object, the forEachRow() functions visit the rows of a caller-owned
+ * buffer (such as a memory-mapped file) or of a stream read in fixed-size chunks as vectors of
+ * std::string_view fields, and parseColumns() converts selected columns of a buffer to numbers in parallel.
+ * These functions recognize newlines and commas enclosed by quotation marks as part of a field
  */
 class CsvTokenizer
 : public attributes::abstract::Iterable<iterators::Iterator, std::string, iterators::token_iterator_tag>
@@ -39,6 +50,11 @@ public:
     typedef attributes::abstract::Iterable<iterators::Iterator, std::string, iterators::token_iterator_tag>
                       ::iterator iterator;
 
+    /**
+     * the default number of bytes read from a stream per chunk
+     */
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 1 << 20;
+
     /**
      * Constructor
      * @param bRemoveEmptyTokens      flag indicating whether or not empty tokens will be removed
@@ -146,8 +162,90 @@ public:
         return iterator(m_string);
     }
 
+    /**
+     * Visit the rows of a caller-owned buffer without copying it. The function object is invoked with a vector
+     * of std::string_view fields for each row which contains at least one field, and returns false to
+     * terminate parsing; fields are trimmed and empty fields removed according to this object's settings.
+     * Rows end at newlines which are not enclosed by quotation marks, and a carriage return which precedes a
+     * newline is discarded. Returns true if the entire buffer was parsed
+     * @param buffer  the characters to be parsed, which must remain valid for the duration of the call
+     * @param functor a function object with signature bool (const std::vector<std::string_view> &)
+     */
+    template<typename Functor>
+    inline bool forEachRow(std::string_view buffer,
+                           Functor &&functor) const
+    {
+        std::vector<std::string_view> fields;
+        std::string scratch;
+        auto *pBuffer = buffer.data();
+
+        return scanRows(pBuffer, pBuffer + buffer.size(), true, fields, scratch, functor);
+    }
+
+    /**
+     * Visit the rows of a stream, which is read in chunks of the specified size so that the input is never
+     * held in memory in its entirety; a row which straddles two chunks is carried over to the next chunk,
+     * which grows as needed to hold rows longer than the chunk size. The fields passed to the function object
+     * are valid only for the duration of the call (see the description of forEachRow() for buffers). Returns
+     * true if the entire stream was parsed
+     * @param stream    a reference to an std::istream object
+     * @param functor   a function object with signature bool (const std::vector<std::string_view> &)
+     * @param chunkSize the number of bytes read from the stream at a time
+     */
+    template<typename Functor>
+    bool forEachRow(std::istream &stream,
+                    Functor &&functor,
+                    std::size_t chunkSize = DEFAULT_CHUNK_SIZE) const
+    {
+        bool bSuccess = (bool)stream;
+        if (bSuccess)
+        {
+            std::vector<char> buffer(std::max(chunkSize, std::size_t(1)));
+            std::vector<std::string_view> fields;
+            std::string scratch;
+            std::size_t size = 0; // the number of unprocessed characters at the front of the buffer
+            bool bFinal = false;
+            while (bSuccess && !bFinal)
+            {
+                if (size == buffer.size())
+                    buffer.resize(2 * buffer.size());
+
+                auto &&count = stream.rdbuf()->sgetn(buffer.data() + size, buffer.size() - size);
+                bFinal = (count <= 0);
+                if (!bFinal)
+                    size += std::size_t(count);
+
+                const char *pBuffer = buffer.data(), *pEnd = pBuffer + size;
+                bSuccess = scanRows(pBuffer, pEnd, bFinal, fields, scratch, functor);
+                size = std::size_t(pEnd - pBuffer);
+                std::memmove(buffer.data(), pBuffer, size);
+            }
+        }
+
+        return bSuccess;
+    }
+
 private:
 
+    /**
+     * Find the end of the row which begins at the specified position; returns a pointer to the newline which
+     * ends the row, or the end of the buffer if the row is not terminated by a newline
+     */
+    inline static const char *findEndOfRow(const char *pBuffer,
+                                           const char *pEnd)
+    {
+        bool bQuoted = false;
+        for (; pBuffer < pEnd; ++pBuffer)
+        {
+            if (*pBuffer == '"')
+                bQuoted = !bQuoted;
+            else if (*pBuffer == '\n' && !bQuoted)
+                break;
+        }
+
+        return pBuffer;
+    }
+
     /**
      * Function to get the next token from the input; returns zero if a token was successfully extracted
      */
@@ -254,8 +352,134 @@ private:
         return result;
     }
 
+    /**
+     * Visit the rows within the specified range. Unless the range ends the input, a row is visited only once
+     * the newline which ends it lies within the range. Returns false if the function object terminated
+     * parsing
+     * @param pBuffer upon return, points to the first character which has not been parsed
+     * @param pEnd    a pointer to the end of the range
+     * @param bFinal  flag indicating whether or not the range ends the input
+     * @param fields  a vector used to hold the fields of each row
+     * @param scratch a string used to hold the fields of each row which contain quotation marks
+     * @param functor a function object with signature bool (const std::vector<std::string_view> &)
+     */
+    template<typename Functor>
+    inline bool scanRows(const char *&pBuffer,
+                         const char *pEnd,
+                         bool bFinal,
+                         std::vector<std::string_view> &fields,
+                         std::string &scratch,
+                         Functor &functor) const
+    {
+        while (pBuffer < pEnd)
+        {
+            auto *pEndOfRow = findEndOfRow(pBuffer, pEnd);
+            if (pEndOfRow == pEnd && !bFinal)
+                break;
+
+            auto *pRow = pBuffer;
+            pBuffer = (pEndOfRow < pEnd ? pEndOfRow + 1 : pEnd);
+            splitRow(pRow, pEndOfRow, m_bRemoveEmptyTokens, fields, scratch);
+            if (!fields.empty() && !functor(fields))
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Split a row into fields. Fields which do not contain quotation marks refer to the row itself; the
+     * remaining fields are unquoted into the scratch string, which is reserved so that it does not reallocate
+     * @param pRow               a pointer to the beginning of the row
+     * @param pEndOfRow          a pointer to the newline which ends the row (or the end of the input)
+     * @param bRemoveEmptyTokens flag indicating whether or not empty fields will be removed
+     * @param fields             upon return, contains the fields of the row
+     * @param scratch            a string used to hold the fields which contain quotation marks
+     */
+    void splitRow(const char *pRow,
+                  const char *pEndOfRow,
+                  bool bRemoveEmptyTokens,
+                  std::vector<std::string_view> &fields,
+                  std::string &scratch) const
+    {
+        fields.clear();
+        if (pEndOfRow > pRow && pEndOfRow[-1] == '\r')
+            --pEndOfRow;
+
+        if (pEndOfRow == pRow)
+            return;
+
+        scratch.clear();
+        scratch.reserve(std::size_t(pEndOfRow - pRow));
+        for (auto *pBuffer = pRow; ; ++pBuffer)
+        {
+            auto *pField = pBuffer;
+            while (pBuffer < pEndOfRow && *pBuffer != ',' && *pBuffer != '"')
+                ++pBuffer;
+
+            std::string_view field(pField, std::size_t(pBuffer - pField));
+            if (pBuffer < pEndOfRow && *pBuffer == '"')
+            {
+                // a quotation mark toggles quoting, except that two consecutive quotation marks within a quoted
+                // sequence represent a literal quotation mark
+                auto &&offset = scratch.size();
+                scratch.append(pField, pBuffer);
+                for (bool bQuoted = false; pBuffer < pEndOfRow && (bQuoted || *pBuffer != ','); ++pBuffer)
+                {
+                    if (*pBuffer != '"')
+                        scratch.push_back(*pBuffer);
+                    else if (bQuoted && pBuffer + 1 < pEndOfRow && pBuffer[1] == '"')
+                        scratch.push_back(*pBuffer++);
+                    else
+                        bQuoted = !bQuoted;
+                }
+
+                field = std::string_view(scratch.data() + offset, scratch.size() - offset);
+            }
+
+            if (m_bTrimLeadingWhitespace)
+            {
+                auto &&position = field.find_first_not_of(" \t\r\n");
+                field.remove_prefix(position == std::string_view::npos ? field.size() : position);
+            }
+
+            if (m_bTrimTrailingWhitespace)
+            {
+                auto &&position = field.find_last_not_of(" \t\r\n");
+                field.remove_suffix(field.size() - (position == std::string_view::npos ? 0 : position + 1));
+            }
+
+            if (!field.empty() || !bRemoveEmptyTokens)
+                fields.push_back(field);
+
+            if (pBuffer >= pEndOfRow)
+                break;
+        }
+    }
+
 public:
 
+    /**
+     * Count the rows of a buffer which are not blank (a row which contains nothing other than a trailing
+     * carriage return is blank)
+     * @param buffer the characters to be scanned, which should begin at a row
+     */
+    static std::size_t countRows(std::string_view buffer)
+    {
+        std::size_t numRows = 0;
+        auto *pRow = buffer.data(), *pEnd = pRow + buffer.size();
+        while (pRow < pEnd)
+        {
+            auto *pEndOfRow = findEndOfRow(pRow, pEnd);
+            if (pEndOfRow - pRow > (pEndOfRow > pRow && pEndOfRow[-1] == '\r' ? 1 : 0))
+                ++numRows;
+
+            pRow = (pEndOfRow < pEnd ? pEndOfRow + 1 : pEnd);
+        }
+
+        return numRows;
+    }
+
     /**
      * Initialization function
      * @param stream an r-value reference to an std::ifstream object
@@ -310,6 +534,104 @@ public:
         return true;
     }
 
+    /**
+     * Convert the specified columns of a buffer to numbers. The rows which follow the header are partitioned
+     * into contiguous ranges which are parsed concurrently; the rows of each range are first counted by the
+     * same tasks, so that the values of each column are stored in a vector which is allocated once and into
+     * which each range writes at its own offset. Column indices count every field of a row, including empty
+     * fields, and blank rows are skipped. Fields which are missing or cannot be converted are stored as a quiet
+     * NaN (or zero, for integral types); returns false if any such field was encountered
+     * @param buffer         the characters to be parsed, such as the contents of a memory-mapped file
+     * @param columns        the indices of the columns to be converted
+     * @param values         upon return, contains a vector of values for each of the specified columns
+     * @param numHeaderRows  the number of rows at the beginning of the buffer to be skipped
+     * @param maximumThreads the maximum number of threads used to parse the buffer
+     */
+    template<typename T>
+    bool parseColumns(std::string_view buffer,
+                      const std::vector<std::size_t> &columns,
+                      std::vector<std::vector<T>> &values,
+                      std::size_t numHeaderRows = 0,
+                      std::size_t maximumThreads = 1) const
+    {
+        auto *pBuffer = buffer.data(), *pEnd = pBuffer + buffer.size();
+        for (std::size_t i = 0; i < numHeaderRows && pBuffer < pEnd; ++i)
+        {
+            pBuffer = findEndOfRow(pBuffer, pEnd);
+            if (pBuffer < pEnd)
+                ++pBuffer;
+        }
+
+        // ranges of fewer than MINIMUM_BYTES_PER_THREAD bytes are not worth the cost of a task
+        auto &&size = std::size_t(pEnd - pBuffer);
+        auto &&ranges = partition(std::string_view(pBuffer, size),
+                                  std::max(std::size_t(1), std::min(maximumThreads,
+                                                                    size / MINIMUM_BYTES_PER_THREAD)));
+
+        std::unique_ptr<ThreadPool<bool>> pThreadPool(ranges.size() > 1 ? new ThreadPool<bool>(ranges.size())
+                                                                         : nullptr);
+        auto &&forEachRange = [&ranges, &pThreadPool] (auto &&function)
+        {
+            if (pThreadPool == nullptr)
+            {
+                for (std::size_t range = 0; range < ranges.size(); ++range)
+                    function(range);
+
+                return;
+            }
+
+            pThreadPool->forEachRange(ranges.size(), ranges.size(), 1, [&function] (std::size_t begin,
+                                                                                   std::size_t end)
+            {
+                for (std::size_t range = begin; range < end; ++range)
+                    function(range);
+            });
+        };
+
+        // count the rows of each range concurrently, then convert the counts into the offset at which each
+        // range begins
+        std::vector<std::size_t> offsets(ranges.size(), 0);
+        forEachRange([&offsets, &ranges] (std::size_t range) { offsets[range] = countRows(ranges[range]); });
+
+        std::size_t numRows = 0;
+        for (auto &&offset : offsets)
+            numRows += std::exchange(offset, numRows);
+
+        values.assign(columns.size(), std::vector<T>(numRows));
+        std::vector<char> successes(ranges.size(), 1);
+        forEachRange([&] (std::size_t range)
+        {
+            std::vector<std::string_view> fields;
+            std::string scratch;
+            auto row = offsets[range];
+            auto *pRow = ranges[range].data(), *pEndOfRange = pRow + ranges[range].size();
+            while (pRow < pEndOfRange)
+            {
+                auto *pEndOfRow = findEndOfRow(pRow, pEndOfRange);
+                splitRow(pRow, pEndOfRow, false, fields, scratch);
+                pRow = (pEndOfRow < pEndOfRange ? pEndOfRow + 1 : pEndOfRange);
+                if (fields.empty())
+                    continue;
+
+                for (std::size_t i = 0; i < columns.size(); ++i)
+                {
+                    T value;
+                    if (columns[i] >= fields.size() || !Tokenizer::convert(fields[columns[i]], value))
+                    {
+                        value = std::numeric_limits<T>::has_quiet_NaN ? std::numeric_limits<T>::quiet_NaN() : T();
+                        successes[range] = 0;
+                    }
+
+                    values[i][row] = value;
+                }
+
+                ++row;
+            }
+        });
+
+        return std::all_of(successes.cbegin(), successes.cend(), [] (char bSuccess) { return bSuccess != 0; });
+    }
+
     /**
      * Overload of the parseLine() method which converts a stream into a string and then calls the split()
      * method to tokenize a line from the resultant string
@@ -418,6 +740,54 @@ public:
         return parseTable(stream);
     }
 
+    /**
+     * Split a buffer into at most the specified number of contiguous ranges of whole rows, of approximately
+     * equal size. Quotation marks are counted up to each prospective boundary, so that a range never begins
+     * within a quoted field; the buffer is scanned once in total
+     * @param buffer    the characters to be partitioned
+     * @param numRanges the maximum number of ranges
+     */
+    static std::vector<std::string_view> partition(std::string_view buffer,
+                                                   std::size_t numRanges)
+    {
+        std::vector<std::string_view> ranges;
+        auto *pBegin = buffer.data(), *pEnd = pBegin + buffer.size(), *pRange = pBegin, *pScan = pBegin;
+        bool bQuoted = false;
+        for (std::size_t i = 1; i < numRanges && pScan < pEnd; ++i)
+        {
+            auto *pTarget = pBegin + i * buffer.size() / numRanges;
+            for (; pScan < pTarget; ++pScan)
+            {
+                pScan = static_cast<const char *>(std::memchr(pScan, '"', std::size_t(pTarget - pScan)));
+                if (pScan == nullptr)
+                {
+                    pScan = pTarget;
+                    break;
+                }
+
+                bQuoted = !bQuoted;
+            }
+
+            // the range ends with the first newline which is not enclosed by quotation marks
+            for (; pScan < pEnd && (bQuoted || *pScan != '\n'); ++pScan)
+            {
+                if (*pScan == '"')
+                    bQuoted = !bQuoted;
+            }
+
+            if (pScan < pEnd)
+                ++pScan;
+
+            ranges.emplace_back(pRange, std::size_t(pScan - pRange));
+            pRange = pScan;
+        }
+
+        if (pRange < pEnd)
+            ranges.emplace_back(pRange, std::size_t(pEnd - pRange));
+
+        return ranges;
+    }
+
     /**
      * Query whether or not empty tokens will be removed
      */
@@ -507,6 +877,11 @@ public:
 
 private:
 
+    /**
+     * the minimum number of bytes parsed by each thread
+     */
+    static constexpr std::size_t MINIMUM_BYTES_PER_THREAD = 1 << 16;
+
     /**
      * flag to indicate whether or not empty tokens will be removed
      */
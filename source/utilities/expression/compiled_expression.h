@@ -0,0 +1,838 @@
+#ifndef COMPILED_EXPRESSION_H
+#define COMPILED_EXPRESSION_H
+
+#include "any.h"
+#include "binary_functors.h"
+#include "expression.h"
+#include "unary_functors.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace utilities
+{
+
+namespace expression
+{
+
+/**
+ * This class compiles an arithmetic/boolean expression once into a stack-based program of typed instructions,
+ * which can then be evaluated repeatedly without parsing the expression, allocating function objects or
+ * resolving variables by name. Sub-expressions whose operands are all numeric constants are folded at compile
+ * time, and each variable is bound to its registry entry when the expression is compiled; variables must
+ * therefore be registered as scalars of type T, and must outlive this object.
+ *
+ * The program may also be evaluated over a batch of entities, in which case variables bound to arrays via
+ * bindArray() take their values from the corresponding array element of each entity, while the remaining
+ * variables take their registered values; each instruction is then applied to a block of entities at a time
+ */
+template<typename T, typename Result = T>
+class CompiledExpression
+: public Expression<T, Result>
+{
+public:
+
+    /**
+     * Type alias declarations
+     */
+    using BinaryFunctorType = typename Expression<T, Result>::BinaryFunctorType;
+    using ErrorType = typename Expression<T, Result>::ErrorType;
+    using UnaryFunctorType = typename Expression<T, Result>::UnaryFunctorType;
+
+    /**
+     * Constructor
+     */
+    CompiledExpression(void)
+    : m_depth(0),
+      m_maxDepth(0)
+    {
+
+    }
+
+    /**
+     * Copy constructor
+     */
+    CompiledExpression(const CompiledExpression<T, Result> &expression)
+    : Expression<T, Result>(expression),
+      m_depth(0),
+      m_maxDepth(0)
+    {
+        operator = (expression);
+    }
+
+    /**
+     * Move constructor
+     */
+    CompiledExpression(CompiledExpression<T, Result> &&expression)
+    : Expression<T, Result>(std::move(expression)),
+      m_depth(0),
+      m_maxDepth(0)
+    {
+        operator = (std::move(expression));
+    }
+
+    /**
+     * Destructor
+     */
+    virtual ~CompiledExpression(void) override
+    {
+        clear();
+    }
+
+    /**
+     * Copy assignment operator
+     */
+    CompiledExpression<T, Result> &operator = (const CompiledExpression<T, Result> &expression)
+    {
+        if (&expression != this)
+        {
+            Expression<T, Result>::operator = (expression);
+
+            // the compiled program owns function objects, so it is rebuilt from the expression string; variables
+            // are assigned slots in the same order, so array bindings carry over slot by slot
+            clear();
+            if (!expression.m_expression.empty() && compile(expression.m_expression.c_str()))
+                for (std::size_t i = 0; i < m_variables.size(); ++i)
+                    m_variables[i] = expression.m_variables[i];
+        }
+
+        return *this;
+    }
+
+    /**
+     * Move assignment operator
+     */
+    CompiledExpression<T, Result> &operator = (CompiledExpression<T, Result> &&expression)
+    {
+        if (&expression != this)
+        {
+            Expression<T, Result>::operator = (std::move(expression));
+
+            clear();
+            m_batchStack = std::move(expression.m_batchStack);
+            m_binaryFunctors = std::move(expression.m_binaryFunctors);
+            m_depth = std::move(expression.m_depth);
+            m_expression = std::move(expression.m_expression);
+            m_functions = std::move(expression.m_functions);
+            m_maxDepth = std::move(expression.m_maxDepth);
+            m_program = std::move(expression.m_program);
+            m_stack = std::move(expression.m_stack);
+            m_unaryFunctors = std::move(expression.m_unaryFunctors);
+            m_variables = std::move(expression.m_variables);
+            m_variableSlots = std::move(expression.m_variableSlots);
+
+            expression.m_binaryFunctors.clear();
+            expression.m_functions.clear();
+            expression.m_unaryFunctors.clear();
+        }
+
+        return *this;
+    }
+
+    /**
+     * Bind a variable referenced by the compiled expression to an array from which batched evaluations take
+     * the variable's value for each entity; returns false if the expression does not reference the variable
+     * @param name    the name of the variable
+     * @param pValues a pointer to the value of the variable for the first entity
+     * @param stride  the distance, in elements, between the values of successive entities
+     */
+    bool bindArray(const std::string &name,
+                   const T *pValues,
+                   std::size_t stride = 1)
+    {
+        auto &&itVariableSlot = m_variableSlots.find(name);
+        bool bSuccess = (itVariableSlot != m_variableSlots.cend() && pValues != nullptr);
+        if (bSuccess)
+        {
+            auto &&variable = m_variables[itVariableSlot->second];
+            variable.m_pArray = pValues;
+            variable.m_stride = stride;
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Function to perform cleanup
+     */
+    inline virtual void clear(void) override
+    {
+        for (auto *pBinaryFunctor : m_binaryFunctors)
+            delete pBinaryFunctor;
+
+        for (auto *pFunction : m_functions)
+            delete pFunction;
+
+        for (auto *pUnaryFunctor : m_unaryFunctors)
+            delete pUnaryFunctor;
+
+        m_binaryFunctors.clear();
+        m_depth = 0;
+        m_expression.clear();
+        m_functions.clear();
+        m_maxDepth = 0;
+        m_program.clear();
+        m_unaryFunctors.clear();
+        m_variables.clear();
+        m_variableSlots.clear();
+    }
+
+    /**
+     * clone() function
+     */
+    inline virtual CompiledExpression<T, Result> *clone(void) const override
+    {
+        return new CompiledExpression<T, Result>(*this);
+    }
+
+    /**
+     * Function to compile the given expression
+     * @param pExpression a character string containing the expression to be compiled
+     */
+    virtual bool compile(const char *pExpression)
+    {
+        clear();
+        functional::Any result;
+        bool bSuccess = Expression<T, Result>::evaluate(pExpression, result);
+        if (bSuccess)
+        {
+            bSuccess = (m_depth == 1 && functional::any_cast<Operand>(&result) != nullptr);
+            if (!bSuccess)
+                this->m_errorType = ErrorType::Invalid;
+        }
+
+        if (bSuccess)
+        {
+            m_batchStack.resize(m_maxDepth * BATCH_SIZE);
+            m_expression = pExpression;
+            m_stack.resize(m_maxDepth);
+        }
+        else
+            clear();
+
+        return bSuccess;
+    }
+
+    /**
+     * Function to test if no expression has been compiled
+     */
+    inline virtual bool empty(void) const final
+    {
+        return m_program.empty();
+    }
+
+    /**
+     * Function to evaluate the compiled expression, using the values of variables as currently registered
+     */
+    inline virtual bool evaluate(Result &result)
+    {
+        bool bSuccess = !m_program.empty();
+        if (bSuccess)
+        {
+            bSuccess = execute(0, 1, 1, false, m_stack.data());
+            if (bSuccess)
+                result = Result(m_stack[0]);
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Function to evaluate the compiled expression for a batch of entities
+     * @param numEntities the number of entities
+     * @param pResults    an array which receives the result for each entity
+     */
+    virtual bool evaluate(std::size_t numEntities,
+                          Result *pResults)
+    {
+        bool bSuccess = !m_program.empty();
+        for (std::size_t first = 0; bSuccess && first < numEntities; first += BATCH_SIZE)
+        {
+            auto count = std::min(BATCH_SIZE, numEntities - first);
+            bSuccess = execute(first, count, BATCH_SIZE, true, m_batchStack.data());
+            if (bSuccess)
+                for (std::size_t i = 0; i < count; ++i)
+                    pResults[first + i] = Result(m_batchStack[i]);
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Get the string containing the expression from which the program was compiled
+     */
+    inline virtual std::string getExpression(void) const final
+    {
+        return m_expression;
+    }
+
+    /**
+     * Get the number of instructions in the compiled program
+     */
+    inline virtual std::size_t getNumInstructions(void) const final
+    {
+        return m_program.size();
+    }
+
+    /**
+     * Remove all array bindings, such that batched evaluations use the registered values of all variables
+     */
+    inline virtual void unbindArrays(void) final
+    {
+        for (auto &&variable : m_variables)
+        {
+            variable.m_pArray = nullptr;
+            variable.m_stride = 1;
+        }
+    }
+
+private:
+
+    /**
+     * Enumerations
+     */
+    enum class OpCode { Add, BinaryFunctor, Call, Divide, Equal, Greater, GreaterEqual, Less, LessEqual,
+                        LogicalAnd, LogicalNot, LogicalOr, Multiply, Negate, NotEqual, PushConstant, PushVariable,
+                        Subtract, UnaryFunctor };
+
+    /**
+     * A single instruction of a compiled program
+     */
+    struct Instruction
+    {
+        /**
+         * Constructor
+         */
+        Instruction(OpCode opCode,
+                    std::size_t index = 0,
+                    const T &value = T())
+        : m_index(index),
+          m_numArguments(0),
+          m_opCode(opCode),
+          m_value(value)
+        {
+
+        }
+
+        /**
+         * the index of the variable slot, function or function object upon which the instruction operates
+         */
+        std::size_t m_index;
+
+        /**
+         * the number of arguments of a function call
+         */
+        std::size_t m_numArguments;
+
+        /**
+         * the operation performed by the instruction
+         */
+        OpCode m_opCode;
+
+        /**
+         * the value pushed by a constant instruction
+         */
+        T m_value;
+    };
+
+    /**
+     * Describes the result of a sub-expression while it is being compiled
+     */
+    struct Operand
+    {
+        /**
+         * flag indicating whether or not the sub-expression evaluates to a constant
+         */
+        bool m_bConstant;
+
+        /**
+         * the value of a constant sub-expression
+         */
+        T m_value;
+    };
+
+    /**
+     * A variable referenced by a compiled program
+     */
+    struct Variable
+    {
+        /**
+         * a pointer to an array from which batched evaluations take the variable's values, if bound
+         */
+        const T *m_pArray;
+
+        /**
+         * a pointer to the registered variable
+         */
+        const T *m_pValue;
+
+        /**
+         * the distance, in elements, between successive values within the bound array
+         */
+        std::size_t m_stride;
+    };
+
+    /**
+     * Apply a binary instruction element-wise to two rows of the stack, storing the results in the first
+     */
+    void applyBinary(const Instruction &instruction,
+                     T *pLhs,
+                     const T *pRhs,
+                     std::size_t count) const
+    {
+        switch (instruction.m_opCode)
+        {
+            case OpCode::Add: transform(pLhs, pRhs, count, std::plus<T>()); break;
+            case OpCode::Divide: transform(pLhs, pRhs, count, std::divides<T>()); break;
+            case OpCode::Equal: transform(pLhs, pRhs, count, std::equal_to<T>()); break;
+            case OpCode::Greater: transform(pLhs, pRhs, count, std::greater<T>()); break;
+            case OpCode::GreaterEqual: transform(pLhs, pRhs, count, std::greater_equal<T>()); break;
+            case OpCode::Less: transform(pLhs, pRhs, count, std::less<T>()); break;
+            case OpCode::LessEqual: transform(pLhs, pRhs, count, std::less_equal<T>()); break;
+            case OpCode::LogicalAnd: transform(pLhs, pRhs, count, std::logical_and<T>()); break;
+            case OpCode::LogicalOr: transform(pLhs, pRhs, count, std::logical_or<T>()); break;
+            case OpCode::Multiply: transform(pLhs, pRhs, count, std::multiplies<T>()); break;
+            case OpCode::NotEqual: transform(pLhs, pRhs, count, std::not_equal_to<T>()); break;
+            case OpCode::Subtract: transform(pLhs, pRhs, count, std::minus<T>()); break;
+            default:
+            {
+                auto *pBinaryFunctor = m_binaryFunctors[instruction.m_index];
+                for (std::size_t i = 0; i < count; ++i)
+                    pLhs[i] = pBinaryFunctor->evaluate(pLhs[i], pRhs[i]);
+            }
+        }
+    }
+
+    /**
+     * Apply a unary instruction element-wise to a row of the stack
+     */
+    void applyUnary(const Instruction &instruction,
+                    T *pRhs,
+                    std::size_t count) const
+    {
+        switch (instruction.m_opCode)
+        {
+            case OpCode::LogicalNot: transform(pRhs, pRhs, count, [] (const T &, const T &rhs) { return !rhs; });
+                                     break;
+            case OpCode::Negate: transform(pRhs, pRhs, count, [] (const T &, const T &rhs) { return -rhs; });
+                                 break;
+            default:
+            {
+                auto *pUnaryFunctor = m_unaryFunctors[instruction.m_index];
+                for (std::size_t i = 0; i < count; ++i)
+                    pRhs[i] = pUnaryFunctor->evaluate(pRhs[i]);
+            }
+        }
+    }
+
+    /**
+     * Call a function for each entity, given a stack row for each of its arguments; the results are stored
+     * in the row of the first argument
+     */
+    bool call(const Instruction &instruction,
+              T *pArguments,
+              std::size_t count,
+              std::size_t width)
+    {
+        bool bSuccess = true;
+        auto *pFunction = m_functions[instruction.m_index];
+        m_arguments.resize(instruction.m_numArguments);
+        try
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                for (std::size_t j = 0; j < instruction.m_numArguments; ++j)
+                    m_arguments[j] = pArguments[j * width + i];
+
+                auto &&result = (*pFunction)(m_arguments);
+                pArguments[i] = functional::any_cast<const T &>(result);
+            }
+        }
+        catch (functional::bad_any_cast &)
+        {
+            this->m_errorType = ErrorType::Invalid;
+            bSuccess = false;
+        }
+        catch (std::bad_function_call &)
+        {
+            this->m_errorType = ErrorType::BadFunctionCall;
+            bSuccess = false;
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Emit an instruction which pushes a value onto the stack
+     */
+    inline void emitPush(const Instruction &instruction)
+    {
+        m_program.push_back(instruction);
+        m_maxDepth = std::max(m_maxDepth, ++m_depth);
+    }
+
+    /**
+     * Execute the compiled program for a block of entities
+     * @param first  the index of the first entity in the block
+     * @param count  the number of entities in the block
+     * @param width  the number of elements in each row of the stack
+     * @param bBatch flag indicating whether or not variables bound to arrays take their values from the arrays
+     * @param pStack a pointer to the stack, which holds one row per level
+     */
+    bool execute(std::size_t first,
+                 std::size_t count,
+                 std::size_t width,
+                 bool bBatch,
+                 T *pStack)
+    {
+        bool bSuccess = true;
+        std::size_t depth = 0;
+        for (auto itInstruction = m_program.cbegin(); bSuccess && itInstruction != m_program.cend();
+             ++itInstruction)
+        {
+            auto &&instruction = *itInstruction;
+            switch (instruction.m_opCode)
+            {
+                case OpCode::Call:
+                {
+                    depth -= instruction.m_numArguments;
+                    bSuccess = call(instruction, pStack + depth * width, count, width);
+                    ++depth;
+                }
+                break;
+
+                case OpCode::PushConstant:
+                std::fill(pStack + depth * width, pStack + depth * width + count, instruction.m_value);
+                ++depth;
+                break;
+
+                case OpCode::PushVariable:
+                {
+                    auto &&variable = m_variables[instruction.m_index];
+                    auto *pRow = pStack + depth * width;
+                    if (bBatch && variable.m_pArray != nullptr)
+                    {
+                        auto *pValues = variable.m_pArray + first * variable.m_stride;
+                        for (std::size_t i = 0; i < count; ++i)
+                            pRow[i] = pValues[i * variable.m_stride];
+                    }
+                    else
+                        std::fill(pRow, pRow + count, *variable.m_pValue);
+
+                    ++depth;
+                }
+                break;
+
+                case OpCode::LogicalNot:
+                case OpCode::Negate:
+                case OpCode::UnaryFunctor:
+                applyUnary(instruction, pStack + (depth - 1) * width, count);
+                break;
+
+                default:
+                --depth;
+                applyBinary(instruction, pStack + (depth - 1) * width, pStack + depth * width, count);
+            }
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Function to process a binary operation
+     */
+    virtual bool processBinaryOperation(ExpressionBinaryFunctor<T> *&pBinaryFunctor,
+                                        functional::Any &lhs,
+                                        functional::Any &rhs) override
+    {
+        typedef typename BinaryFunctorType::Enum BinaryOp;
+
+        static const std::map<BinaryOp, OpCode> opCodes =
+        { { BinaryOp::Addition, OpCode::Add },
+          { BinaryOp::Division, OpCode::Divide },
+          { BinaryOp::Equal, OpCode::Equal },
+          { BinaryOp::Greater, OpCode::Greater },
+          { BinaryOp::GreaterEqual, OpCode::GreaterEqual },
+          { BinaryOp::Less, OpCode::Less },
+          { BinaryOp::LessEqual, OpCode::LessEqual },
+          { BinaryOp::LogicalAnd, OpCode::LogicalAnd },
+          { BinaryOp::LogicalOr, OpCode::LogicalOr },
+          { BinaryOp::Multiplication, OpCode::Multiply },
+          { BinaryOp::NotEqual, OpCode::NotEqual },
+          { BinaryOp::Subtraction, OpCode::Subtract } };
+
+        auto *pLhs = functional::any_cast<Operand>(&lhs);
+        auto *pRhs = functional::any_cast<Operand>(&rhs);
+        bool bSuccess = (pBinaryFunctor != nullptr && pLhs != nullptr && pRhs != nullptr);
+        if (bSuccess)
+        {
+            // operations without a dedicated instruction are delegated to a binary function object
+            auto &&type = pBinaryFunctor->getType();
+            auto &&itOpCode = opCodes.find(type);
+            Instruction instruction(OpCode::BinaryFunctor, m_binaryFunctors.size());
+            if (itOpCode != opCodes.cend())
+                instruction.m_opCode = itOpCode->second;
+            else
+            {
+                auto *pFunctor = functional::functors::binary::BinaryFunctor<T>::create(type);
+                bSuccess = (pFunctor != nullptr);
+                if (bSuccess)
+                    m_binaryFunctors.push_back(pFunctor);
+            }
+
+            if (bSuccess)
+            {
+                --m_depth;
+                if (pLhs->m_bConstant && pRhs->m_bConstant)
+                {
+                    // fold the operation; both operands were pushed by the two most recent instructions
+                    applyBinary(instruction, &pLhs->m_value, &pRhs->m_value, 1);
+                    m_program.pop_back();
+                    m_program.back().m_value = pLhs->m_value;
+                    if (instruction.m_opCode == OpCode::BinaryFunctor)
+                    {
+                        delete m_binaryFunctors.back();
+                        m_binaryFunctors.pop_back();
+                    }
+                }
+                else
+                {
+                    m_program.push_back(instruction);
+                    pLhs->m_bConstant = false;
+                }
+            }
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Function to process a function call
+     */
+    virtual bool processFunction(ExpressionFunctor<T> *&pFunction,
+                                 std::vector<functional::Any> &arguments,
+                                 functional::Any &result) override
+    {
+        bool bSuccess = (pFunction != nullptr);
+        if (bSuccess)
+        {
+            // configure the function with the values of constant arguments
+            std::vector<functional::Any> values;
+            for (auto &&argument : arguments)
+            {
+                auto *pArgument = functional::any_cast<Operand>(&argument);
+                bSuccess &= (pArgument != nullptr);
+                if (!bSuccess)
+                    break;
+
+                values.emplace_back(pArgument->m_bConstant ? pArgument->m_value : T());
+            }
+
+            if (bSuccess)
+                bSuccess = pFunction->configure(values);
+
+            if (bSuccess)
+            {
+                Instruction instruction(OpCode::Call, m_functions.size());
+                instruction.m_numArguments = arguments.size();
+                m_functions.push_back(pFunction);
+                pFunction = nullptr; // prevents the function from being deleted outside this function
+
+                // the result replaces the arguments on the stack
+                m_depth -= arguments.size();
+                emitPush(instruction);
+                result = Operand { false, T() };
+            }
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Function to process a numeric operand
+     */
+    virtual bool processNumericOperand(const char *&pExpression,
+                                       functional::Any &result) override
+    {
+        char *pEnd = nullptr;
+        auto &&operand = strtod(pExpression, &pEnd);
+        bool bSuccess = (pEnd != pExpression);
+        if (bSuccess)
+        {
+            emitPush(Instruction(OpCode::PushConstant, 0, T(operand)));
+            pExpression = pEnd; // advance the pointer and store the result
+            result = Operand { true, T(operand) };
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Function to process a unary operation
+     */
+    virtual bool processUnaryOperation(ExpressionUnaryFunctor<T> *&pUnaryFunctor,
+                                       functional::Any &rhs) override
+    {
+        typedef typename UnaryFunctorType::Enum UnaryOp;
+
+        auto *pRhs = functional::any_cast<Operand>(&rhs);
+        bool bSuccess = (pUnaryFunctor != nullptr && pRhs != nullptr);
+        if (bSuccess)
+        {
+            auto &&type = pUnaryFunctor->getType();
+            if (type == UnaryOp::Plus)
+                return bSuccess;
+
+            Instruction instruction(OpCode::UnaryFunctor, m_unaryFunctors.size());
+            if (type == UnaryOp::LogicalNot)
+                instruction.m_opCode = OpCode::LogicalNot;
+            else if (type == UnaryOp::Minus)
+                instruction.m_opCode = OpCode::Negate;
+            else
+            {
+                auto *pFunctor = functional::functors::unary::UnaryFunctor<T>::create(type);
+                bSuccess = (pFunctor != nullptr);
+                if (bSuccess)
+                    m_unaryFunctors.push_back(pFunctor);
+            }
+
+            if (bSuccess)
+            {
+                if (pRhs->m_bConstant)
+                {
+                    // fold the operation; the operand was pushed by the most recent instruction
+                    applyUnary(instruction, &pRhs->m_value, 1);
+                    m_program.back().m_value = pRhs->m_value;
+                    if (instruction.m_opCode == OpCode::UnaryFunctor)
+                    {
+                        delete m_unaryFunctors.back();
+                        m_unaryFunctors.pop_back();
+                    }
+                }
+                else
+                    m_program.push_back(instruction);
+            }
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Function to process a variable
+     */
+    virtual bool processVariable(const std::string &name,
+                                 functional::Any &result) override
+    {
+        auto &&itVariableSlot = m_variableSlots.find(name);
+        bool bSuccess = (itVariableSlot != m_variableSlots.cend());
+        if (!bSuccess)
+        {
+            // bind the variable to its registry entry, which must hold a scalar of type T
+            auto &&itRegistryEntry = this->m_registry.findByName(name);
+            if (itRegistryEntry != this->m_registry.end())
+            {
+                auto *pValue = registry_entry_cast<T>(&itRegistryEntry->second);
+                bSuccess = (pValue != nullptr);
+                if (bSuccess)
+                {
+                    itVariableSlot = m_variableSlots.emplace(name, m_variables.size()).first;
+                    m_variables.push_back(Variable { nullptr, pValue, 1 });
+                }
+            }
+        }
+
+        if (bSuccess)
+        {
+            emitPush(Instruction(OpCode::PushVariable, itVariableSlot->second));
+            result = Operand { false, T() };
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * Apply a binary operation element-wise
+     */
+    template<class Operation>
+    inline static void transform(T *pLhs,
+                                 const T *pRhs,
+                                 std::size_t count,
+                                 Operation &&operation)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            pLhs[i] = T(operation(pLhs[i], pRhs[i]));
+    }
+
+    /**
+     * the number of entities to which each instruction is applied at a time during batched evaluations
+     */
+    static constexpr std::size_t BATCH_SIZE = 64;
+
+    /**
+     * workspace used to pass arguments to functions
+     */
+    std::vector<functional::Any> m_arguments;
+
+    /**
+     * the stack used during batched evaluations, with one row of BATCH_SIZE elements per level
+     */
+    std::vector<T> m_batchStack;
+
+    /**
+     * binary function objects for operations without a dedicated instruction
+     */
+    std::vector<functional::functors::binary::BinaryFunctor<T> *> m_binaryFunctors;
+
+    /**
+     * the depth of the stack following the most recently compiled instruction
+     */
+    std::size_t m_depth;
+
+    /**
+     * the expression from which the program was compiled
+     */
+    std::string m_expression;
+
+    /**
+     * the functions called by the program
+     */
+    std::vector<ExpressionFunctor<T> *> m_functions;
+
+    /**
+     * the maximum depth of the stack during an evaluation
+     */
+    std::size_t m_maxDepth;
+
+    /**
+     * the compiled program
+     */
+    std::vector<Instruction> m_program;
+
+    /**
+     * the stack used during scalar evaluations
+     */
+    std::vector<T> m_stack;
+
+    /**
+     * unary function objects for operations without a dedicated instruction
+     */
+    std::vector<functional::functors::unary::UnaryFunctor<T> *> m_unaryFunctors;
+
+    /**
+     * the variables referenced by the program, indexed by slot
+     */
+    std::vector<Variable> m_variables;
+
+    /**
+     * a map of variable names to slots
+     */
+    std::map<std::string, std::size_t> m_variableSlots;
+};
+
+}
+
+}
+
+#endif
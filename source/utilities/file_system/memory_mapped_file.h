@@ -0,0 +1,283 @@
+#ifndef MEMORY_MAPPED_FILE_H
+#define MEMORY_MAPPED_FILE_H
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include "windows.h"
+#elif defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace utilities
+{
+
+namespace file_system
+{
+
+/**
+ * This class implements a Windows/Posix cross-platform read-only memory mapping of a file, through which the
+ * contents of a file can be accessed without being copied into memory allocated by the process. Where a file
+ * cannot be mapped, or memory mapping is not supported, its contents are read into a buffer instead. The
+ * mapping is released when the object is closed or destroyed
+ */
+class MemoryMappedFile final
+{
+public:
+
+    /**
+     * Constructor
+     */
+    MemoryMappedFile(void)
+    : m_bOpen(false),
+#ifdef _WIN32
+      m_hFile(INVALID_HANDLE_VALUE),
+      m_hMapping(nullptr),
+#endif
+      m_pData(nullptr),
+      m_size(0)
+    {
+
+    }
+
+    /**
+     * Constructor
+     * @param filename the name of the file to be mapped
+     */
+    MemoryMappedFile(const std::string &filename)
+    : MemoryMappedFile()
+    {
+        open(filename);
+    }
+
+    /**
+     * Copy constructor
+     */
+    MemoryMappedFile(const MemoryMappedFile &file) = delete;
+
+    /**
+     * Move constructor
+     */
+    MemoryMappedFile(MemoryMappedFile &&file)
+    : MemoryMappedFile()
+    {
+        file.swap(*this);
+    }
+
+    /**
+     * Destructor
+     */
+    ~MemoryMappedFile(void)
+    {
+        close();
+    }
+
+    /**
+     * Copy assignment operator
+     */
+    MemoryMappedFile &operator = (const MemoryMappedFile &file) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    MemoryMappedFile &operator = (MemoryMappedFile &&file)
+    {
+        if (&file != this)
+        {
+            close();
+            file.swap(*this);
+        }
+
+        return *this;
+    }
+
+    /**
+     * Release the mapping of the file, if one exists
+     */
+    void close(void)
+    {
+#ifdef _WIN32
+        if (m_pData != nullptr && m_buffer.empty())
+            UnmapViewOfFile(m_pData);
+
+        if (m_hMapping != nullptr)
+            CloseHandle(m_hMapping);
+
+        if (m_hFile != INVALID_HANDLE_VALUE)
+            CloseHandle(m_hFile);
+
+        m_hFile = INVALID_HANDLE_VALUE;
+        m_hMapping = nullptr;
+#elif defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
+        if (m_pData != nullptr && m_buffer.empty())
+            munmap(const_cast<char *>(m_pData), m_size);
+#endif
+        m_bOpen = false;
+        m_buffer.clear();
+        m_pData = nullptr;
+        m_size = 0;
+    }
+
+    /**
+     * Get a pointer to the contents of the file; returns a null pointer if no file is mapped or the file is
+     * empty
+     */
+    inline const char *getData(void) const
+    {
+        return m_pData;
+    }
+
+    /**
+     * Get the size of the file in bytes
+     */
+    inline std::size_t getSize(void) const
+    {
+        return m_size;
+    }
+
+    /**
+     * Get a view of the contents of the file
+     */
+    inline std::string_view getView(void) const
+    {
+        return m_pData != nullptr ? std::string_view(m_pData, m_size) : std::string_view();
+    }
+
+    /**
+     * Query whether or not a file is mapped
+     */
+    inline bool isOpen(void) const
+    {
+        return m_bOpen;
+    }
+
+    /**
+     * Map the specified file into memory, releasing any existing mapping; returns true upon success
+     * @param filename the name of the file to be mapped
+     */
+    bool open(const std::string &filename)
+    {
+        close();
+
+        bool bRead = false; // flag indicating that the file must be read rather than mapped
+#ifdef _WIN32
+        m_hFile = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        LARGE_INTEGER size;
+        m_bOpen = (m_hFile != INVALID_HANDLE_VALUE && GetFileSizeEx(m_hFile, &size) != 0);
+        if (m_bOpen && size.QuadPart > 0)
+        {
+            m_hMapping = CreateFileMappingA(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (m_hMapping != nullptr)
+                m_pData = static_cast<const char *>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+
+            bRead = (m_pData == nullptr);
+            if (!bRead)
+                m_size = std::size_t(size.QuadPart);
+        }
+#elif defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
+        auto &&descriptor = ::open(filename.c_str(), O_RDONLY);
+        struct stat attributes;
+        m_bOpen = (descriptor >= 0 && fstat(descriptor, &attributes) == 0 && S_ISREG(attributes.st_mode) != 0);
+        if (m_bOpen && attributes.st_size > 0)
+        {
+            auto *pData = mmap(nullptr, std::size_t(attributes.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+            bRead = (pData == MAP_FAILED);
+            if (!bRead)
+            {
+                // files are generally read from beginning to end
+                madvise(pData, std::size_t(attributes.st_size), MADV_SEQUENTIAL);
+                m_pData = static_cast<const char *>(pData);
+                m_size = std::size_t(attributes.st_size);
+            }
+        }
+
+        // the mapping remains valid once the descriptor has been closed
+        if (descriptor >= 0)
+            ::close(descriptor);
+#else
+        bRead = true;
+#endif
+        if (bRead)
+        {
+            // the file could not be mapped, so its contents are read into a buffer instead
+            close();
+            std::ifstream stream(filename, std::ios::binary);
+            m_bOpen = stream.is_open();
+            if (m_bOpen)
+            {
+                m_buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+                m_pData = m_buffer.empty() ? nullptr : m_buffer.data();
+                m_size = m_buffer.size();
+            }
+        }
+
+        if (!m_bOpen)
+            close();
+
+        return m_bOpen;
+    }
+
+    /**
+     * Swap function
+     */
+    void swap(MemoryMappedFile &file)
+    {
+        std::swap(m_bOpen, file.m_bOpen);
+        m_buffer.swap(file.m_buffer);
+#ifdef _WIN32
+        std::swap(m_hFile, file.m_hFile);
+        std::swap(m_hMapping, file.m_hMapping);
+#endif
+        std::swap(m_pData, file.m_pData);
+        std::swap(m_size, file.m_size);
+    }
+
+private:
+
+    /**
+     * flag indicating whether or not a file is mapped
+     */
+    bool m_bOpen;
+
+    /**
+     * the contents of the file, if the file could not be mapped
+     */
+    std::vector<char> m_buffer;
+
+#ifdef _WIN32
+    /**
+     * handle to the mapped file
+     */
+    HANDLE m_hFile;
+
+    /**
+     * handle to the file mapping object
+     */
+    HANDLE m_hMapping;
+#endif
+
+    /**
+     * pointer to the contents of the file
+     */
+    const char *m_pData;
+
+    /**
+     * the size of the file in bytes
+     */
+    std::size_t m_size;
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,564 @@
+#ifndef JSON_EVENT_PARSER_H
+#define JSON_EVENT_PARSER_H
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace utilities
+{
+
+namespace json
+{
+
+/**
+ * This class implements an event-driven (SAX-style) json parser. Input is supplied incrementally, in chunks of
+ * any size, and the parser reports the structure of the document to a handler as it is encountered; no
+ * document object model is constructed, so memory is bounded by the nesting depth of the document and the
+ * size of its largest string or number. A handler must provide the following member functions, each of which
+ * returns false to terminate parsing:
+ *
+ *     bool onStartArray(void), bool onEndArray(void), bool onStartObject(void), bool onEndObject(void),
+ *     bool onKey(const std::string &key), bool onValue(const std::string &value, ValueType type)
+ *
+ * Strings are unescaped before being reported, and numbers and the literals true, false and null are reported
+ * as they appear in the input. A sequence of top-level values separated by whitespace (as in newline-delimited
+ * json) is accepted
+ */
+class JsonEventParser final
+{
+public:
+
+    /**
+     * Enumerations
+     */
+    enum class ValueType { Boolean, Null, Number, String };
+
+    /**
+     * the default number of bytes read from a stream per chunk
+     */
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 65536;
+
+private:
+
+    /**
+     * Enumerations
+     */
+    enum class State { Colon, CommaOrEnd, Key, KeyOrEnd, Literal, String, Value, ValueOrEnd };
+
+public:
+
+    /**
+     * Constructor
+     */
+    JsonEventParser(void)
+    {
+        reset();
+    }
+
+    /**
+     * Copy constructor
+     */
+    JsonEventParser(const JsonEventParser &parser) = default;
+
+    /**
+     * Move constructor
+     */
+    JsonEventParser(JsonEventParser &&parser) = default;
+
+    /**
+     * Destructor
+     */
+    ~JsonEventParser(void)
+    {
+
+    }
+
+    /**
+     * Copy assignment operator
+     */
+    JsonEventParser &operator = (const JsonEventParser &parser) = default;
+
+    /**
+     * Move assignment operator
+     */
+    JsonEventParser &operator = (JsonEventParser &&parser) = default;
+
+    /**
+     * Complete parsing of the input supplied since the last reset; returns false if the input ended within a
+     * value or if the handler terminated parsing
+     * @param handler the handler to which events are reported
+     */
+    template<typename Handler>
+    bool finish(Handler &handler)
+    {
+        bool bSuccess = !m_bFailed;
+        if (bSuccess && m_state == State::Literal)
+            bSuccess = endLiteral(handler);
+
+        bSuccess = bSuccess && m_state == State::Value && m_containers.empty();
+        if (!bSuccess)
+            m_bFailed = true;
+
+        return bSuccess;
+    }
+
+    /**
+     * Get the number of bytes consumed since the last reset; upon failure, this is the offset of the byte at
+     * which the error was detected
+     */
+    inline std::size_t getOffset(void) const
+    {
+        return m_offset;
+    }
+
+    /**
+     * Parse a json document from a stream, which is read in chunks of the specified size; returns true upon
+     * success
+     * @param stream    a reference to an std::istream object
+     * @param handler   the handler to which events are reported
+     * @param chunkSize the number of bytes read from the stream at a time
+     */
+    template<typename Handler>
+    bool parse(std::istream &stream,
+               Handler &handler,
+               std::size_t chunkSize = DEFAULT_CHUNK_SIZE)
+    {
+        reset();
+
+        bool bSuccess = (bool)stream;
+        std::vector<char> buffer(std::max(chunkSize, std::size_t(1)));
+        while (bSuccess)
+        {
+            auto &&count = stream.rdbuf()->sgetn(buffer.data(), buffer.size());
+            if (count <= 0)
+                break;
+
+            bSuccess = parse(std::string_view(buffer.data(), std::size_t(count)), handler, false);
+        }
+
+        return bSuccess && finish(handler);
+    }
+
+    /**
+     * Parse json-formatted data; returns true upon success
+     * @param buffer  the characters to be parsed
+     * @param handler the handler to which events are reported
+     * @param bFinal  flag indicating whether the buffer completes the input (in which case the parser is reset
+     *                beforehand and finish() is called afterward) or is the next of a sequence of chunks
+     */
+    template<typename Handler>
+    bool parse(std::string_view buffer,
+               Handler &handler,
+               bool bFinal = true)
+    {
+        if (bFinal)
+            reset();
+
+        auto *pBuffer = buffer.data(), *pEnd = pBuffer + buffer.size();
+        while (!m_bFailed && pBuffer < pEnd)
+        {
+            auto *pCharacter = pBuffer;
+            m_bFailed = !(m_state == State::String ? scanString(pBuffer, pEnd, handler)
+                                                   : processCharacter(pBuffer, handler));
+            m_offset += std::size_t(pBuffer - pCharacter);
+        }
+
+        return !m_bFailed && (!bFinal || finish(handler));
+    }
+
+    /**
+     * Reset this parser, so that it may parse a new document
+     */
+    void reset(void)
+    {
+        m_bFailed = false;
+        m_bKey = false;
+        m_containers.clear();
+        m_escape = 0;
+        m_highSurrogate = 0;
+        m_offset = 0;
+        m_state = State::Value;
+        m_token.clear();
+        m_unicode = 0;
+    }
+
+private:
+
+    /**
+     * Append a unicode code point to the current token, encoded as UTF-8
+     */
+    inline void appendCodePoint(unsigned long codePoint)
+    {
+        if (codePoint < 0x80)
+            m_token.push_back(char(codePoint));
+        else if (codePoint < 0x800)
+        {
+            m_token.push_back(char(0xc0 | (codePoint >> 6)));
+            m_token.push_back(char(0x80 | (codePoint & 0x3f)));
+        }
+        else if (codePoint < 0x10000)
+        {
+            m_token.push_back(char(0xe0 | (codePoint >> 12)));
+            m_token.push_back(char(0x80 | ((codePoint >> 6) & 0x3f)));
+            m_token.push_back(char(0x80 | (codePoint & 0x3f)));
+        }
+        else
+        {
+            m_token.push_back(char(0xf0 | (codePoint >> 18)));
+            m_token.push_back(char(0x80 | ((codePoint >> 12) & 0x3f)));
+            m_token.push_back(char(0x80 | ((codePoint >> 6) & 0x3f)));
+            m_token.push_back(char(0x80 | (codePoint & 0x3f)));
+        }
+    }
+
+    /**
+     * Begin a value with the specified character
+     */
+    template<typename Handler>
+    inline bool beginValue(char ch, Handler &handler)
+    {
+        switch (ch)
+        {
+            case '{':
+            m_containers.push_back(true);
+            m_state = State::KeyOrEnd;
+            return handler.onStartObject();
+
+            case '[':
+            m_containers.push_back(false);
+            m_state = State::ValueOrEnd;
+            return handler.onStartArray();
+
+            case '"':
+            m_bKey = false;
+            m_state = State::String;
+            m_token.clear();
+            return true;
+
+            default:
+            if (ch == '-' || (ch >= '0' && ch <= '9') || ch == 't' || ch == 'f' || ch == 'n')
+            {
+                m_state = State::Literal;
+                m_token.assign(1, ch);
+                return true;
+            }
+
+            return false;
+        }
+    }
+
+    /**
+     * End the innermost container with the specified character
+     */
+    template<typename Handler>
+    inline bool endContainer(char ch, Handler &handler)
+    {
+        bool bObject = (ch == '}');
+        bool bSuccess = (!m_containers.empty() && m_containers.back() == bObject);
+        if (bSuccess)
+        {
+            m_containers.pop_back();
+            m_state = m_containers.empty() ? State::Value : State::CommaOrEnd;
+            bSuccess = bObject ? handler.onEndObject() : handler.onEndArray();
+        }
+
+        return bSuccess;
+    }
+
+    /**
+     * End the literal (a number, true, false or null) held by the current token
+     */
+    template<typename Handler>
+    inline bool endLiteral(Handler &handler)
+    {
+        ValueType type = ValueType::Number;
+        if (m_token == "true" || m_token == "false")
+            type = ValueType::Boolean;
+        else if (m_token == "null")
+            type = ValueType::Null;
+        else if (!isNumber(m_token))
+            return false;
+
+        m_state = m_containers.empty() ? State::Value : State::CommaOrEnd;
+
+        return handler.onValue(m_token, type);
+    }
+
+    /**
+     * Determine whether or not a string conforms to the json number grammar
+     */
+    inline static bool isNumber(const std::string &string)
+    {
+        auto &&isDigit = [] (char ch) { return ch >= '0' && ch <= '9'; };
+        auto *pCharacter = string.c_str();
+        if (*pCharacter == '-')
+            ++pCharacter;
+
+        if (*pCharacter == '0')
+            ++pCharacter;
+        else if (isDigit(*pCharacter))
+        {
+            while (isDigit(*pCharacter))
+                ++pCharacter;
+        }
+        else
+            return false;
+
+        if (*pCharacter == '.')
+        {
+            if (!isDigit(*++pCharacter))
+                return false;
+
+            while (isDigit(*pCharacter))
+                ++pCharacter;
+        }
+
+        if (*pCharacter == 'e' || *pCharacter == 'E')
+        {
+            ++pCharacter;
+            if (*pCharacter == '+' || *pCharacter == '-')
+                ++pCharacter;
+
+            if (!isDigit(*pCharacter))
+                return false;
+
+            while (isDigit(*pCharacter))
+                ++pCharacter;
+        }
+
+        return *pCharacter == '\0';
+    }
+
+    /**
+     * Process the character at the specified position outside of a string; the position is advanced unless
+     * the character terminates a literal, in which case it is processed again in the state which follows
+     */
+    template<typename Handler>
+    bool processCharacter(const char *&pBuffer, Handler &handler)
+    {
+        auto &&ch = *pBuffer;
+        if (m_state == State::Literal)
+        {
+            if ((ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z') || ch == '-' || ch == '+' || ch == '.' ||
+                ch == 'E')
+            {
+                m_token.push_back(ch);
+                ++pBuffer;
+
+                return true;
+            }
+
+            return endLiteral(handler);
+        }
+
+        ++pBuffer;
+        if (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r')
+            return true;
+
+        switch (m_state)
+        {
+            case State::Colon:
+            m_state = State::Value;
+            return ch == ':';
+
+            case State::CommaOrEnd:
+            if (ch == ',')
+            {
+                m_state = m_containers.back() ? State::Key : State::Value;
+
+                return true;
+            }
+
+            return (ch == '}' || ch == ']') && endContainer(ch, handler);
+
+            case State::KeyOrEnd:
+            if (ch == '}')
+                return endContainer(ch, handler);
+
+            // fall through
+            case State::Key:
+            m_bKey = true;
+            m_state = State::String;
+            m_token.clear();
+            return ch == '"';
+
+            case State::ValueOrEnd:
+            if (ch == ']')
+                return endContainer(ch, handler);
+
+            // fall through
+            default:
+            return beginValue(ch, handler);
+        }
+    }
+
+    /**
+     * Scan a string, appending runs of ordinary characters to the current token and processing escape
+     * sequences; the position is advanced to the end of the string or of the buffer
+     */
+    template<typename Handler>
+    bool scanString(const char *&pBuffer,
+                    const char *pEnd,
+                    Handler &handler)
+    {
+        while (pBuffer < pEnd)
+        {
+            auto &&ch = *pBuffer++;
+            if (m_escape == 1)
+            {
+                m_escape = 0;
+                switch (ch)
+                {
+                    case '"':
+                    case '\\':
+                    case '/':
+                    m_token.push_back(ch);
+                    break;
+
+                    case 'b':
+                    m_token.push_back('\b');
+                    break;
+
+                    case 'f':
+                    m_token.push_back('\f');
+                    break;
+
+                    case 'n':
+                    m_token.push_back('\n');
+                    break;
+
+                    case 'r':
+                    m_token.push_back('\r');
+                    break;
+
+                    case 't':
+                    m_token.push_back('\t');
+                    break;
+
+                    case 'u':
+                    m_escape = 2;
+                    m_unicode = 0;
+                    break;
+
+                    default:
+                    return false;
+                }
+
+                if (m_escape == 0 && m_highSurrogate != 0)
+                    return false; // a high surrogate must be followed by a low surrogate
+            }
+            else if (m_escape > 1)
+            {
+                // accumulate the four hexadecimal digits of a \u escape sequence
+                auto &&digit = (ch >= '0' && ch <= '9') ? ch - '0' : (ch >= 'a' && ch <= 'f') ? ch - 'a' + 10 :
+                               (ch >= 'A' && ch <= 'F') ? ch - 'A' + 10 : -1;
+                if (digit < 0)
+                    return false;
+
+                m_unicode = (m_unicode << 4) | unsigned(digit);
+                if (++m_escape == 6)
+                {
+                    m_escape = 0;
+                    if (m_unicode >= 0xd800 && m_unicode < 0xdc00 && m_highSurrogate == 0)
+                        m_highSurrogate = m_unicode;
+                    else if (m_unicode >= 0xdc00 && m_unicode < 0xe000 && m_highSurrogate != 0)
+                    {
+                        appendCodePoint(0x10000 + ((m_highSurrogate - 0xd800) << 10) + (m_unicode - 0xdc00));
+                        m_highSurrogate = 0;
+                    }
+                    else if ((m_unicode >= 0xd800 && m_unicode < 0xe000) || m_highSurrogate != 0)
+                        return false; // unpaired surrogate
+                    else
+                        appendCodePoint(m_unicode);
+                }
+            }
+            else if (m_highSurrogate != 0 && ch != '\\')
+                return false;
+            else if (ch == '\\')
+                m_escape = 1;
+            else if (ch == '"')
+            {
+                if (m_bKey)
+                {
+                    m_state = State::Colon;
+
+                    return handler.onKey(m_token);
+                }
+
+                m_state = m_containers.empty() ? State::Value : State::CommaOrEnd;
+
+                return handler.onValue(m_token, ValueType::String);
+            }
+            else if (static_cast<unsigned char>(ch) < 0x20)
+                return false; // control characters must be escaped
+            else
+            {
+                // append the run of characters which require no processing
+                auto *pRun = pBuffer - 1;
+                while (pBuffer < pEnd && *pBuffer != '"' && *pBuffer != '\\' &&
+                       static_cast<unsigned char>(*pBuffer) >= 0x20)
+                    ++pBuffer;
+
+                m_token.append(pRun, pBuffer);
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * flag indicating that the input was found to be malformed, or that the handler terminated parsing
+     */
+    bool m_bFailed;
+
+    /**
+     * flag indicating whether the string being parsed is an object key
+     */
+    bool m_bKey;
+
+    /**
+     * the open containers, from outermost to innermost; true denotes an object and false an array
+     */
+    std::vector<bool> m_containers;
+
+    /**
+     * the escape sequence state within a string: zero if none, one following a backslash, or two through five
+     * while the digits of a \u escape sequence are read
+     */
+    int m_escape;
+
+    /**
+     * a high surrogate which awaits the low surrogate that completes a code point
+     */
+    unsigned long m_highSurrogate;
+
+    /**
+     * the number of bytes consumed since the last reset
+     */
+    std::size_t m_offset;
+
+    /**
+     * the current parser state
+     */
+    State m_state;
+
+    /**
+     * the string or literal being parsed
+     */
+    std::string m_token;
+
+    /**
+     * the value of the \u escape sequence being parsed
+     */
+    unsigned long m_unicode;
+};
+
+}
+
+}
+
+#endif
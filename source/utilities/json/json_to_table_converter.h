@@ -1,7 +1,11 @@
 #ifndef JSON_TO_TABLE_CONVERTER_H
 #define JSON_TO_TABLE_CONVERTER_H
 
-#include "json_to_prefix_tree_converter.h"
+#include "json_event_parser.h"
+#include <functional>
+#include <map>
+#include <ostream>
+#include <unordered_map>
 
 namespace utilities
 {
@@ -10,7 +14,12 @@ namespace json
 {
 
 /**
- * This class implements a utility to convert json-formatted data to table format
+ * This class implements a utility to convert json-formatted data to table format. The input is parsed as a
+ * stream of events, and each record is flattened into a row as soon as it is complete: the records are the
+ * elements of a top-level array, or the top-level values themselves (as in newline-delimited json). The
+ * columns of a record are named by the keys and array indices which lead to each of its scalar values, joined
+ * by periods; unless specified beforehand, the columns are those of the first record. Memory is bounded by the
+ * size of a single record rather than that of the document
  */
 class JsonToTableConverter
 {
@@ -19,7 +28,16 @@ public:
     /**
      * Typedef declarations
      */
-    typedef std::function<bool (Json::Value &)> tFilter;
+    typedef std::function<bool (const std::string &, std::string &)> tFilter;
+
+private:
+
+    /**
+     * Forward declarations
+     */
+    template<typename Functor> class Flattener;
+
+public:
 
     /**
      * Constructor
@@ -27,7 +45,8 @@ public:
      * @param bIgnoreSingletons flag indicating whether or not singleton nodes will be ignored
      */
     JsonToTableConverter(const std::string &columnDelimiter = ",", bool bIgnoreSingletons = false)
-    : m_bIgnoreSingletons(bIgnoreSingletons),
+    : m_bColumnsSpecified(false),
+      m_bIgnoreSingletons(bIgnoreSingletons),
       m_columnDelimiter(columnDelimiter)
     {
 
@@ -64,8 +83,10 @@ public:
     {
         if (&converter != this)
         {
+            m_bColumnsSpecified = converter.m_bColumnsSpecified;
             m_bIgnoreSingletons = converter.m_bIgnoreSingletons;
             m_columnDelimiter = converter.m_columnDelimiter;
+            m_columns = converter.m_columns;
             m_filters = converter.m_filters;
         }
 
@@ -79,8 +100,10 @@ public:
     {
         if (&converter != this)
         {
+            m_bColumnsSpecified = std::move(converter.m_bColumnsSpecified);
             m_bIgnoreSingletons = std::move(converter.m_bIgnoreSingletons);
             m_columnDelimiter = std::move(converter.m_columnDelimiter);
+            m_columns = std::move(converter.m_columns);
             m_filters = std::move(converter.m_filters);
         }
 
@@ -88,7 +111,9 @@ public:
     }
 
     /**
-     * Function to add a new filter; returns false if a filter with the given name already exists
+     * Function to add a new filter; returns false if a filter with the given name already exists. Filters are
+     * applied to each scalar value of a record along with the name of its column, and may modify the value;
+     * a record is discarded if any filter returns false for any of its values
      */
     inline virtual bool addFilter(const std::string &name, const tFilter &filter) final
     {
@@ -101,24 +126,51 @@ public:
     }
 
     /**
-     * Function to convert json-formatted data into table format
-     * @param value a Json::Value node object
-     * @param tree  upon success, will be populated
+     * Function to convert json-formatted data into table format. A header row containing the column names is
+     * written, followed by a row for each record; values which contain the column delimiter, a quotation mark
+     * or a line break are enclosed by quotation marks
+     * @param input     a reference to an std::istream object from which json-formatted data is read
+     * @param output    a reference to an std::ostream object to which rows are written
+     * @param chunkSize the number of bytes read from the input stream at a time
      */
-    virtual bool convert(Json::Value &value)
+    virtual bool convert(std::istream &input,
+                         std::ostream &output,
+                         std::size_t chunkSize = JsonEventParser::DEFAULT_CHUNK_SIZE)
     {
-        JsonToPrefixTreeConverter::PrefixTree tree;
-        bool bSuccess = JsonToPrefixTreeConverter::convert(value, tree, bRemoveSingletons);
-        if (bSuccess)
+        bool bHeaderWritten = false;
+
+        return forEachRow(input, [this, &bHeaderWritten, &output] (const std::vector<std::string> &values)
         {
-            // singletons should already be gone, but call the following for added redundancy
-            if (m_bIgnoreSingletons)
-                bSuccess = tree.removeSingletons();
+            if (!bHeaderWritten)
+            {
+                writeRow(m_columns, output);
+                bHeaderWritten = true;
+            }
 
-            // TODO: implement this
-        }
+            writeRow(values, output);
 
-        return bSuccess;
+            return (bool)output;
+        }, chunkSize);
+    }
+
+    /**
+     * Function to convert json-formatted data into rows of values, each of which is passed to the specified
+     * function object as it is completed; the function object returns false to terminate conversion. The names
+     * of the columns may be retrieved via getColumns() once the first row has been passed. Returns true if the
+     * input was converted in its entirety
+     * @param input     a reference to an std::istream object from which json-formatted data is read
+     * @param functor   a function object with signature bool (const std::vector<std::string> &)
+     * @param chunkSize the number of bytes read from the input stream at a time
+     */
+    template<typename Functor>
+    bool forEachRow(std::istream &input,
+                    Functor &&functor,
+                    std::size_t chunkSize = JsonEventParser::DEFAULT_CHUNK_SIZE)
+    {
+        JsonEventParser parser;
+        Flattener<Functor> flattener(this, functor);
+
+        return parser.parse(input, flattener, chunkSize);
     }
 
     /**
@@ -129,6 +181,14 @@ public:
         return m_columnDelimiter;
     }
 
+    /**
+     * Get the names of the columns
+     */
+    inline virtual std::vector<std::string> &getColumns(void) final
+    {
+        return m_columns;
+    }
+
     /**
      * Function to get this object's map of filters
      */
@@ -159,7 +219,8 @@ public:
     }
 
     /**
-     * Set the flag indicating that singleton nodes will be ignored
+     * Set the flag indicating that singleton nodes will be ignored; when set, the key or index of the sole
+     * member of an object or array within a record does not contribute to the names of its columns
      */
     inline virtual void ignoreSingletons(bool bIgnoreSingletons) final
     {
@@ -195,6 +256,15 @@ public:
         m_columnDelimiter = columnDelimiter;
     }
 
+    /**
+     * Set the names of the columns; if empty, the columns of each conversion will be those of its first record
+     */
+    inline virtual void setColumns(const std::vector<std::string> &columns) final
+    {
+        m_bColumnsSpecified = !columns.empty();
+        m_columns = columns;
+    }
+
     /**
      * Function to set a filter; overwrites an existing filter if an entry with the given name already exists
      */
@@ -209,17 +279,320 @@ public:
     inline virtual void setFilters(const std::map<std::string, tFilter> &filters) final
     {
         m_filters = filters;
-        removeFilters();
-        for (auto &&itFilter : filters)
+    }
+
+protected:
+
+    /**
+     * Write a row of values to the specified stream
+     */
+    virtual void writeRow(const std::vector<std::string> &values, std::ostream &stream) const
+    {
+        for (std::size_t i = 0; i < values.size(); ++i)
         {
-            auto &&name = itNameStringPreprocessorPair.first;
-            auto &&filter = itNameStringPreprocessorPair.second;
-            addFilter(name, filter);
+            if (i > 0)
+                stream << m_columnDelimiter;
+
+            auto &&value = values[i];
+            if (value.find_first_of("\"\r\n") == std::string::npos &&
+                (m_columnDelimiter.empty() || value.find(m_columnDelimiter) == std::string::npos))
+                stream << value;
+            else
+            {
+                stream << '"';
+                for (auto &&ch : value)
+                {
+                    if (ch == '"')
+                        stream << '"';
+
+                    stream << ch;
+                }
+
+                stream << '"';
+            }
         }
+
+        stream << '\n';
     }
 
+private:
+
+    /**
+     * This class receives the events of a json parser and assembles the scalar values of each record, which
+     * it flattens into a row once the record is complete
+     */
+    template<typename Functor>
+    class Flattener final
+    {
+    public:
+
+        /**
+         * Constructor
+         * @param pConverter a pointer to the converter which owns the columns and filters
+         * @param functor    the function object to which rows are passed
+         */
+        Flattener(JsonToTableConverter *pConverter, Functor &functor)
+        : m_functor(functor),
+          m_pConverter(pConverter),
+          m_recordDepth(0)
+        {
+            // columns adopted by a previous conversion are discarded
+            auto &&columns = m_pConverter->m_columns;
+            if (!m_pConverter->m_bColumnsSpecified)
+                columns.clear();
+
+            for (std::size_t i = 0; i < columns.size(); ++i)
+                m_columnIndices.emplace(columns[i], i);
+        }
+
+        /**
+         * Array end event
+         */
+        inline bool onEndArray(void)
+        {
+            return endContainer();
+        }
+
+        /**
+         * Object end event
+         */
+        inline bool onEndObject(void)
+        {
+            return endContainer();
+        }
+
+        /**
+         * Object key event
+         */
+        inline bool onKey(const std::string &key)
+        {
+            if (m_containers.size() > m_recordDepth)
+                m_path.push_back(addSegment(key));
+
+            return true;
+        }
+
+        /**
+         * Array start event
+         */
+        inline bool onStartArray(void)
+        {
+            return beginContainer(false);
+        }
+
+        /**
+         * Object start event
+         */
+        inline bool onStartObject(void)
+        {
+            return beginContainer(true);
+        }
+
+        /**
+         * Scalar value event
+         */
+        bool onValue(const std::string &value, JsonEventParser::ValueType)
+        {
+            beginValue(false);
+            m_values.emplace_back(m_path.size(), value);
+            m_paths.insert(m_paths.end(), m_path.cbegin(), m_path.cend());
+
+            return endValue();
+        }
+
+    private:
+
+        /**
+         * Add a path segment within the innermost container
+         */
+        inline std::size_t addSegment(const std::string &name)
+        {
+            ++m_memberCounts[m_containers.back().first];
+            m_segments.emplace_back(m_containers.back().first, name);
+
+            return m_segments.size() - 1;
+        }
+
+        /**
+         * Begin a container
+         */
+        inline bool beginContainer(bool bObject)
+        {
+            beginValue(!bObject);
+            m_containers.emplace_back(m_memberCounts.size(), 0);
+            m_memberCounts.push_back(0);
+
+            return true;
+        }
+
+        /**
+         * Begin a value; a value which begins at the top level of the input determines the depth of the records,
+         * a value which begins at that depth begins a record, and a value within an array of a record adds the
+         * array index to the path
+         */
+        inline void beginValue(bool bArray)
+        {
+            if (m_containers.empty())
+                m_recordDepth = bArray ? 1 : 0;
+
+            if (m_containers.size() == m_recordDepth)
+            {
+                m_memberCounts.clear();
+                m_path.clear();
+                m_paths.clear();
+                m_segments.clear();
+                m_values.clear();
+            }
+            else if (m_containers.size() > m_recordDepth && m_path.size() < m_containers.size() - m_recordDepth)
+            {
+                // a member of an array, whose path segment is its index
+                m_path.push_back(addSegment(std::to_string(m_containers.back().second++)));
+            }
+        }
+
+        /**
+         * End a container
+         */
+        inline bool endContainer(void)
+        {
+            m_containers.pop_back();
+
+            return m_containers.size() + 1 <= m_recordDepth || endValue();
+        }
+
+        /**
+         * End a value; the path segment of a member is removed, and a record which is complete is flattened
+         */
+        bool endValue(void)
+        {
+            if (m_containers.size() > m_recordDepth)
+            {
+                m_path.pop_back();
+
+                return true;
+            }
+
+            // name the column of each value, and apply the filters
+            auto &&bIgnoreSingletons = m_pConverter->m_bIgnoreSingletons;
+            m_names.resize(m_values.size());
+            for (std::size_t i = 0, offset = 0; i < m_values.size(); offset += m_values[i++].first)
+            {
+                auto &&name = m_names[i];
+                name.clear();
+                for (std::size_t j = 0; j < m_values[i].first; ++j)
+                {
+                    auto &&segment = m_segments[m_paths[offset + j]];
+                    if (!bIgnoreSingletons || m_memberCounts[segment.first] > 1)
+                    {
+                        if (!name.empty())
+                            name.push_back('.');
+
+                        name.append(segment.second);
+                    }
+                }
+
+                if (name.empty())
+                    name = "value";
+
+                for (auto &&itFilter : m_pConverter->m_filters)
+                {
+                    if (itFilter.second && !itFilter.second(name, m_values[i].second))
+                        return true; // the record is discarded
+                }
+            }
+
+            // the columns of the first record are adopted unless the columns were specified
+            auto &&columns = m_pConverter->m_columns;
+            if (m_columnIndices.empty())
+            {
+                for (auto &&name : m_names)
+                {
+                    if (m_columnIndices.emplace(name, columns.size()).second)
+                        columns.push_back(name);
+                }
+            }
+
+            // values which do not belong to a column are omitted, and columns without values are left empty
+            m_row.assign(columns.size(), std::string());
+            for (std::size_t i = 0; i < m_values.size(); ++i)
+            {
+                auto &&itColumnIndex = m_columnIndices.find(m_names[i]);
+                if (itColumnIndex != m_columnIndices.end())
+                    m_row[itColumnIndex->second].swap(m_values[i].second);
+            }
+
+            return columns.empty() || m_functor(m_row);
+        }
+
+        /**
+         * map of column names to column indices
+         */
+        std::unordered_map<std::string, std::size_t> m_columnIndices;
+
+        /**
+         * for each open container, the index of its member count and the index of its next array member
+         */
+        std::vector<std::pair<std::size_t, std::size_t>> m_containers;
+
+        /**
+         * the function object to which rows are passed
+         */
+        Functor &m_functor;
+
+        /**
+         * the number of members of each container of the current record
+         */
+        std::vector<std::size_t> m_memberCounts;
+
+        /**
+         * the column name of each value of the current record
+         */
+        std::vector<std::string> m_names;
+
+        /**
+         * the path segments which lead to the current value
+         */
+        std::vector<std::size_t> m_path;
+
+        /**
+         * the path segments of the values of the current record, stored contiguously
+         */
+        std::vector<std::size_t> m_paths;
+
+        /**
+         * pointer to the converter which owns the columns and filters
+         */
+        JsonToTableConverter *m_pConverter;
+
+        /**
+         * the number of containers which enclose each record
+         */
+        std::size_t m_recordDepth;
+
+        /**
+         * the row being assembled
+         */
+        std::vector<std::string> m_row;
+
+        /**
+         * the path segments of the current record: the index of the enclosing container's member count and a
+         * key or array index
+         */
+        std::vector<std::pair<std::size_t, std::string>> m_segments;
+
+        /**
+         * the number of path segments and the value of each scalar of the current record
+         */
+        std::vector<std::pair<std::size_t, std::string>> m_values;
+    };
+
 protected:
 
+    /**
+     * flag to indicate that the columns were specified rather than adopted from the first record converted
+     */
+    bool m_bColumnsSpecified;
+
     /**
      * flag to indicate that singleton nodes will be ignored
      */
@@ -230,10 +603,17 @@ protected:
      */
     std::string m_columnDelimiter;
 
+    /**
+     * the names of the columns
+     */
+    std::vector<std::string> m_columns;
+
     /**
      * map of filters
      */
     std::map<std::string, tFilter> m_filters;
+};
+
 }
 
 }
@@ -1,9 +1,17 @@
 #ifndef THREAD_POOL_H
 #define THREAD_POOL_H
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <deque>
+#include <exception>
 #include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace utilities
 {
@@ -14,22 +22,56 @@ namespace utilities
 enum class ThreadPoolStatus { Pause, Ready, Terminate };
 
 // forward declarations
-ThreadPoolStatus &getGlobalThreadPoolStatusOverride(void);
+ThreadPoolStatus getGlobalThreadPoolStatusOverride(void);
+std::condition_variable &getThreadPoolStatusCondition(void);
+std::mutex &getThreadPoolStatusMutex(void);
 void setGlobalThreadPoolStatusOverride(const ThreadPoolStatus &status);
 
 /**
- * This class implements a thread pool manager using std::futures
+ * This class implements a persistent thread pool in which each worker thread owns a double-ended task queue;
+ * workers pop tasks from the front of their own queue, in submission order, and, when it is empty, steal tasks
+ * from the back of the queues owned by the other workers. Worker threads are created on first use and persist
+ * until the pool is destroyed (or its maximum number of threads is changed), so repeated calls to execute() or
+ * submit() do not incur thread creation costs. While the pool is paused, queued tasks are not run, not even when
+ * the workers are stopped; they are carried over to the replacement workers if the maximum number of threads
+ * is changed, and abandoned if the pool is destroyed
  */
 template<typename T>
 class ThreadPool final
 {
+private:
+
+    /**
+     * Typedef declarations
+     */
+    typedef std::function<void (bool)> tQueuedTask;
+
+    /**
+     * This structure holds a task queue owned by a single worker thread
+     */
+    struct WorkerQueue
+    {
+        /**
+         * mutex guarding the task queue
+         */
+        std::mutex m_mutex;
+
+        /**
+         * queue of tasks; the argument indicates whether the task should be run (true) or abandoned (false)
+         */
+        std::deque<tQueuedTask> m_tasks;
+    };
+
 public:
 
     /**
      * Constructor
      */
     ThreadPool(size_t maximumThreads)
-    : m_maximumThreads(maximumThreads),
+    : m_bStop(false),
+      m_maximumThreads(maximumThreads),
+      m_nextQueue(0),
+      m_pending(0),
       m_status(ThreadPoolStatus::Ready)
     {
 
@@ -39,30 +81,38 @@ public:
      * Copy constructor
      */
     ThreadPool(const ThreadPool<T> &pool)
-    : m_maximumThreads(pool.m_maximumThreads),
-      m_status(pool.m_status),
+    : m_bStop(false),
+      m_maximumThreads(pool.m_maximumThreads),
+      m_nextQueue(0),
+      m_pending(0),
+      m_status(pool.m_status.load()),
       m_tasks(pool.m_tasks)
     {
 
     }
 
     /**
-     * Move constructor
+     * Move constructor; worker threads are not transferred, the source pool's workers are stopped after their
+     * queued tasks have been drained
      */
     ThreadPool(ThreadPool<T> &&pool)
-    : m_maximumThreads(std::move(pool.m_maximumThreads)),
-      m_status(std::move(pool.m_status)),
-      m_tasks(std::move(pool.m_tasks))
+    : m_bStop(false),
+      m_maximumThreads(pool.m_maximumThreads),
+      m_nextQueue(0),
+      m_pending(0),
+      m_status(pool.m_status.load())
     {
-
+        pool.stopWorkers();
+        m_tasks = std::move(pool.m_tasks);
     }
 
     /**
-     * Destructor
+     * Destructor; tasks left queued by a paused pool are abandoned
      */
     virtual ~ThreadPool(void)
     {
-
+        stopWorkers();
+        abandonTasks();
     }
 
     /**
@@ -90,49 +140,58 @@ public:
     }
 
     /**
-     * Function to execute the thread pool
-     * @param resultFunctor an std::function object that analyzes the result of each std::future object. The
-     *                      functor should return true if thread pool execution should continue or false if it
-     *                      should immediately terminate
+     * Function to execute the thread pool; the calling thread participates in executing the tasks and blocks
+     * until all tasks have either completed or been skipped
+     * @param resultFunctor an std::function object that analyzes the result of each task. The functor should
+     *                      return true if thread pool execution should continue or false if it should
+     *                      immediately terminate; tasks that have not started when termination is requested are
+     *                      skipped. If a task throws an exception, the remaining tasks are skipped and the first
+     *                      such exception is rethrown once all tasks have either completed or been skipped
      */
     virtual bool execute(const std::function<bool (const T &)> resultFunctor) final
     {
-        bool bSuccess = true;
+        return execute(m_tasks, resultFunctor);
+    }
 
-        // determine the number of threads to be created - depending upon the
-        // number of tasks, the maximum number of threads may not be needed.
-        auto &&numTasks = m_tasks.size();
-        auto numThreads = std::min(m_maximumThreads, numTasks);
-        auto &&thread = [&] (size_t threadId) -> T
+    /**
+     * Apply a function to consecutive, disjoint ranges which cover [0, size), one task per range; the calling
+     * thread participates in processing the ranges and blocks until all of them have either completed or been
+     * skipped. If the function throws an exception, ranges which have not started are skipped and the first such
+     * exception is rethrown once no task refers to the function any longer
+     * @param size        the size of the interval to be divided
+     * @param numRanges   the maximum number of ranges
+     * @param granularity the number of elements by which range boundaries must be divisible
+     * @param function    a binary function object which accepts the beginning and end of a range
+     */
+    template<typename Function>
+    void forEachRange(size_t size, size_t numRanges, size_t granularity, Function &&function)
+    {
+        granularity = std::max<size_t>(1, granularity);
+        auto &&numBlocks = (size + granularity - 1) / granularity;
+        numRanges = std::min(std::max<size_t>(1, numRanges), numBlocks);
+        if (numRanges <= 1)
         {
-            for (size_t j = threadId; bSuccess && j < numTasks; j += numThreads)
-            {
-                while (getStatus() == ThreadPoolStatus::Pause); // block while paused
-
-                auto &&task = m_tasks[j];
-                if (getStatus() == ThreadPoolStatus::Terminate) // break if status is terminate
-                    break;
-                else // status is ready
-                {
-                    T &&result = task();
-                    bSuccess &= resultFunctor(result);
-                }
-            }
+            if (size > 0)
+                function(size_t(0), size);
 
-            return bSuccess;
-        };
+            return;
+        }
 
-        // start the threads
-        std::vector<std::future<T>> threads(numThreads);
-        for (size_t i = 0; i < numThreads; ++i)
-            threads[i] = std::async(std::launch::async, thread, i);
+        auto &&blocksPerRange = (numBlocks + numRanges - 1) / numRanges;
+        std::deque<std::function<T (void)>> tasks;
+        for (size_t block = 0; block < numBlocks; block += blocksPerRange)
+        {
+            auto &&begin = block * granularity;
+            auto end = std::min(size, (block + blocksPerRange) * granularity);
+            tasks.emplace_back([&function, begin, end] (void)
+            {
+                function(begin, end);
 
-        // retrieve the result of each thread, block if necessary
-        for (size_t i = 0; i < numThreads; ++i)
-            if (threads[i].valid())
-                bSuccess &= threads[i].get();
+                return T();
+            });
+        }
 
-        return bSuccess;
+        execute(tasks, [] (const T &) { return true; });
     }
 
     /**
@@ -151,7 +210,7 @@ public:
         auto status = getGlobalThreadPoolStatusOverride();
 
         // if the global status is anything other than ready, return the global status
-        return (status != ThreadPoolStatus::Ready) ? status : m_status;
+        return (status != ThreadPoolStatus::Ready) ? status : m_status.load(std::memory_order_acquire);
     }
 
     /**
@@ -163,55 +222,442 @@ public:
     }
 
     /**
-     * Set the number of concurrent threads
+     * Set the number of concurrent threads; existing worker threads finish their queued tasks (or, if the pool is
+     * paused, leave them queued) and are replaced upon next use
      */
     inline virtual void setMaximumThreads(size_t maximumThreads) final
     {
-        m_maximumThreads = maximumThreads;
+        if (maximumThreads != m_maximumThreads)
+        {
+            stopWorkers();
+
+            // tasks left queued by a paused pool are handed to the replacement workers straight away
+            std::lock_guard<std::mutex> lock(m_workersMutex);
+            m_maximumThreads = maximumThreads;
+            if (m_pending.load(std::memory_order_acquire) > 0)
+                startWorkers();
+        }
     }
 
     /**
-     * Set the polling interval (ms)
+     * Set this thread pool's status; workers blocked on a paused pool are woken when the status changes
      */
     inline virtual void setStatus(const ThreadPoolStatus &status) final
     {
-        m_status = status;
+        {
+            std::lock_guard<std::mutex> lock(getThreadPoolStatusMutex());
+            m_status.store(status, std::memory_order_release);
+        }
+
+        getThreadPoolStatusCondition().notify_all();
+    }
+
+    /**
+     * Submit a task for asynchronous execution by the worker threads
+     * @return an std::future object which provides the result of the task. If the task is abandoned because
+     *         the pool's status is set to terminate before the task starts, or because the pool is destroyed
+     *         while paused, the future reports an std::future_error with error code
+     *         std::future_errc::broken_promise
+     */
+    virtual std::future<T> submit(const std::function<T (void)> &task) final
+    {
+        auto &&pTask = std::make_shared<std::packaged_task<T (void)>>(task);
+        auto future = pTask->get_future();
+        enqueue([pTask] (bool bRun)
+                {
+                    if (bRun)
+                        (*pTask)();
+                });
+
+        return future;
     }
 
 private:
 
+    /**
+     * Abandon the tasks remaining in the worker queues; the worker threads must have been stopped
+     */
+    inline virtual void abandonTasks(void) final
+    {
+        for (auto &&pQueue : m_queues)
+        {
+            while (!pQueue->m_tasks.empty())
+            {
+                auto task = std::move(pQueue->m_tasks.front());
+                pQueue->m_tasks.pop_front();
+                m_pending.fetch_sub(1, std::memory_order_acq_rel);
+                task(false);
+            }
+        }
+    }
+
+    /**
+     * Place a task on a worker queue; tasks submitted from one of this pool's worker threads are placed on that
+     * worker's own queue, otherwise tasks are distributed across the queues in round-robin fashion
+     */
+    inline virtual void enqueue(tQueuedTask &&task) final
+    {
+        // the queues cannot be replaced while a worker of this pool is running, so only other threads must hold
+        // the workers lock until the task has been placed on a queue
+        auto &&worker = getCurrentWorker();
+        std::unique_lock<std::mutex> workersLock(m_workersMutex, std::defer_lock);
+        if (worker.first != this)
+        {
+            workersLock.lock();
+            startWorkers();
+        }
+
+        auto &&index = worker.first == this ? worker.second
+                                            : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+        {
+            // the pending count is incremented while the queue is locked, so that a worker cannot pop the task
+            // and decrement the count first
+            auto &&queue = *m_queues[index];
+            std::lock_guard<std::mutex> lock(queue.m_mutex);
+            queue.m_tasks.emplace_back(std::move(task));
+            m_pending.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        if (workersLock.owns_lock())
+            workersLock.unlock();
+
+        {
+            // synchronize with idle workers evaluating their wait condition, so that the notification is not lost
+            std::lock_guard<std::mutex> lock(m_mutex);
+        }
+
+        m_condition.notify_one();
+    }
+
+    /**
+     * Execute the specified tasks (see description of the public overload above)
+     */
+    bool execute(const std::deque<std::function<T (void)>> &tasks,
+                 const std::function<bool (const T &)> &resultFunctor)
+    {
+        auto &&numTasks = tasks.size();
+        if (numTasks == 0)
+            return true;
+
+        std::atomic<bool> bSuccess(true);
+        std::atomic<size_t> remaining(numTasks);
+        std::condition_variable completion;
+        std::mutex completionMutex;
+        std::exception_ptr pException;
+        for (auto &&task : tasks)
+        {
+            enqueue([&, task] (bool bRun)
+                    {
+                        if (bRun && bSuccess.load(std::memory_order_acquire) &&
+                            getStatus() != ThreadPoolStatus::Terminate)
+                        {
+                            try
+                            {
+                                T &&result = task();
+                                if (!resultFunctor(result))
+                                    bSuccess.store(false, std::memory_order_release);
+                            }
+                            catch (...)
+                            {
+                                // an exception must not escape the worker thread, so it is recorded for the
+                                // caller and the remaining tasks are skipped
+                                std::lock_guard<std::mutex> lock(completionMutex);
+                                if (pException == nullptr)
+                                    pException = std::current_exception();
+
+                                bSuccess.store(false, std::memory_order_release);
+                            }
+                        }
+
+                        // decrement under the lock so that the caller cannot return (and destroy the
+                        // synchronization objects on its stack) while the last task is still using them
+                        std::lock_guard<std::mutex> lock(completionMutex);
+                        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                            completion.notify_all();
+                    });
+        }
+
+        // help execute queued tasks, then block until the remaining tasks have finished
+        while (remaining.load(std::memory_order_acquire) > 0)
+        {
+            if (!runPendingTask())
+            {
+                std::unique_lock<std::mutex> lock(completionMutex);
+                completion.wait(lock, [&remaining] { return remaining.load(std::memory_order_acquire) == 0; });
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(completionMutex);
+        if (pException != nullptr)
+            std::rethrow_exception(pException);
+
+        return bSuccess.load();
+    }
+
+    /**
+     * Get the pool and queue index associated with the calling thread
+     */
+    inline static std::pair<const ThreadPool<T> *, size_t> &getCurrentWorker(void)
+    {
+        static thread_local std::pair<const ThreadPool<T> *, size_t> worker(nullptr, 0);
+
+        return worker;
+    }
+
+    /**
+     * Attempt to pop a task from the front of the specified queue or, failing that, steal a task from the back
+     * of one of the other queues
+     */
+    inline virtual bool popTask(size_t index, tQueuedTask &task) final
+    {
+        auto &&numQueues = m_queues.size();
+        for (size_t i = 0; i < numQueues; ++i)
+        {
+            auto &&queue = *m_queues[(index + i) % numQueues];
+            std::lock_guard<std::mutex> lock(queue.m_mutex);
+            if (!queue.m_tasks.empty())
+            {
+                if (i == 0)
+                {
+                    task = std::move(queue.m_tasks.front());
+                    queue.m_tasks.pop_front();
+                }
+                else
+                {
+                    task = std::move(queue.m_tasks.back());
+                    queue.m_tasks.pop_back();
+                }
+
+                m_pending.fetch_sub(1, std::memory_order_acq_rel);
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Run a single pending task on the calling thread, if any are available and the pool is not paused
+     */
+    inline virtual bool runPendingTask(void) final
+    {
+        auto &&status = getStatus();
+        if (status == ThreadPoolStatus::Pause)
+            return false;
+
+        // threads other than this pool's workers hold the workers lock while popping, so that the queues are not
+        // replaced underneath them
+        auto &&worker = getCurrentWorker();
+        std::unique_lock<std::mutex> workersLock(m_workersMutex, std::defer_lock);
+        if (worker.first != this)
+            workersLock.lock();
+
+        tQueuedTask task;
+        bool bSuccess = popTask(worker.first == this ? worker.second : 0, task);
+        if (workersLock.owns_lock())
+            workersLock.unlock();
+
+        if (bSuccess)
+            task(status != ThreadPoolStatus::Terminate);
+
+        return bSuccess;
+    }
+
+    /**
+     * Create the worker threads, if they have not already been created; tasks left queued by stopped workers are
+     * distributed across the new queues. The workers lock must be held by the caller
+     */
+    inline virtual void startWorkers(void) final
+    {
+        if (m_workers.empty())
+        {
+            auto numThreads = std::max<size_t>(1, m_maximumThreads);
+            m_bStop = false;
+            auto queues = std::move(m_queues);
+            m_queues.clear();
+            for (size_t i = 0; i < numThreads; ++i)
+                m_queues.emplace_back(new WorkerQueue);
+
+            size_t index = 0;
+            for (auto &&pQueue : queues)
+                for (auto &&task : pQueue->m_tasks)
+                    m_queues[index++ % numThreads]->m_tasks.emplace_back(std::move(task));
+
+            for (size_t i = 0; i < numThreads; ++i)
+                m_workers.emplace_back(&ThreadPool<T>::work, this, i);
+        }
+    }
+
+    /**
+     * Drain the queued tasks, unless the pool is paused, and join the worker threads
+     */
+    inline virtual void stopWorkers(void) final
+    {
+        std::lock_guard<std::mutex> workersLock(m_workersMutex);
+        if (!m_workers.empty())
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                std::lock_guard<std::mutex> statusLock(getThreadPoolStatusMutex());
+                m_bStop = true;
+            }
+
+            m_condition.notify_all();
+            getThreadPoolStatusCondition().notify_all();
+            for (auto &&worker : m_workers)
+                worker.join();
+
+            m_workers.clear();
+        }
+    }
+
+    /**
+     * Worker thread function
+     * @param index the index of the queue owned by this worker
+     */
+    void work(size_t index)
+    {
+        getCurrentWorker() = std::make_pair(this, index);
+
+        while (true)
+        {
+            // block while paused; a paused pool which is being stopped leaves its queued tasks unrun
+            if (getStatus() == ThreadPoolStatus::Pause)
+            {
+                std::unique_lock<std::mutex> lock(getThreadPoolStatusMutex());
+                getThreadPoolStatusCondition().wait(lock, [this]
+                {
+                    return m_bStop || getStatus() != ThreadPoolStatus::Pause;
+                });
+
+                if (m_bStop && getStatus() == ThreadPoolStatus::Pause)
+                    break;
+            }
+
+            tQueuedTask task;
+            if (popTask(index, task))
+            {
+                task(getStatus() != ThreadPoolStatus::Terminate);
+
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_bStop && m_pending.load(std::memory_order_acquire) == 0)
+                break;
+
+            m_condition.wait(lock, [this] { return m_bStop || m_pending.load(std::memory_order_acquire) > 0; });
+        }
+
+        getCurrentWorker() = std::make_pair(nullptr, 0);
+    }
+
+    /**
+     * flag indicating that the worker threads should exit once the queues have been drained
+     */
+    bool m_bStop;
+
+    /**
+     * condition variable used to wake idle worker threads
+     */
+    std::condition_variable m_condition;
+
     /**
      * maximum number of threads to be created
      */
     size_t m_maximumThreads;
 
+    /**
+     * mutex guarding the pending task count and stop flag
+     */
+    std::mutex m_mutex;
+
+    /**
+     * index of the next queue to receive a task submitted from outside the pool
+     */
+    std::atomic<size_t> m_nextQueue;
+
+    /**
+     * number of tasks waiting in the worker queues
+     */
+    std::atomic<size_t> m_pending;
+
+    /**
+     * per-worker task queues
+     */
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+
     /**
      * status of this thread pool
      */
-    ThreadPoolStatus m_status;
+    std::atomic<ThreadPoolStatus> m_status;
 
     /**
      * vector of tasks, where the argument is the thread id
      */
     std::deque<std::function<T (void)>> m_tasks;
+
+    /**
+     * worker threads
+     */
+    std::vector<std::thread> m_workers;
+
+    /**
+     * mutex guarding creation and destruction of the worker threads
+     */
+    std::mutex m_workersMutex;
 };
 
 /**
- * Function to query the global thread pool status override
+ * Function to access the global thread pool status override
  */
-inline ThreadPoolStatus &getGlobalThreadPoolStatusOverride(void)
+inline std::atomic<ThreadPoolStatus> &getGlobalThreadPoolStatus(void)
 {
-    static ThreadPoolStatus status = ThreadPoolStatus::Ready;
+    static std::atomic<ThreadPoolStatus> status(ThreadPoolStatus::Ready);
 
     return status;
 }
 
+/**
+ * Function to query the global thread pool status override
+ */
+inline ThreadPoolStatus getGlobalThreadPoolStatusOverride(void)
+{
+    return getGlobalThreadPoolStatus().load(std::memory_order_acquire);
+}
+
+/**
+ * Function to access the condition variable used to signal thread pool status changes
+ */
+inline std::condition_variable &getThreadPoolStatusCondition(void)
+{
+    static std::condition_variable condition;
+
+    return condition;
+}
+
+/**
+ * Function to access the mutex guarding thread pool status changes
+ */
+inline std::mutex &getThreadPoolStatusMutex(void)
+{
+    static std::mutex mutex;
+
+    return mutex;
+}
+
 /**
  * Function to set the global thread pool status override
  */
 inline void setGlobalThreadPoolStatusOverride(const ThreadPoolStatus &status)
 {
-    getGlobalThreadPoolStatusOverride() = status;
+    {
+        std::lock_guard<std::mutex> lock(getThreadPoolStatusMutex());
+        getGlobalThreadPoolStatus().store(status, std::memory_order_release);
+    }
+
+    getThreadPoolStatusCondition().notify_all();
 }
 
 }
@@ -179,7 +179,8 @@ public:
      */
     inline virtual bool operator == (const iterator &it) const override
     {
-        return std::strlen(m_pBuffer) == std::strlen(it.m_pBuffer);
+        // iterators which have reached the end of their strings compare equal
+        return m_pBuffer == it.m_pBuffer || (*m_pBuffer == '\0' && *it.m_pBuffer == '\0');
     }
 
     /**
@@ -1,14 +1,20 @@
 #ifndef TOKENIZER_H
 #define TOKENIZER_H
 
+#include "is_character.h"
 #include "iterable.h"
 #include "token_iterator.h"
 #include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstring>
 #include <fstream>
 #include <map>
 #include <memory>
 #include <set>
 #include <sstream>
+#include <string_view>
 #include <vector>
 
 namespace utilities
@@ -17,6 +23,10 @@ namespace utilities
 /**
  * This class implements an iterable string tokenizer. Delimiters can be freely added or removed. The default
  * delimiter is a newline character. Valid delimiters include single characters or strings of characters.
+ * Delimiters are compiled into a table of the bytes with which they begin, so that the input is scanned once
+ * per token rather than once per delimiter. In addition to the iterable interface, which yields std::string
+ * tokens, the forEachToken() functions visit std::string_view tokens of a caller-owned buffer or of a stream
+ * read in fixed-size chunks, without copying the input.
  */
 class Tokenizer final
 : public attributes::abstract::Iterable<iterators::Iterator, std::string, iterators::token_iterator_tag>
@@ -33,6 +43,11 @@ public:
     typedef std::function<bool (std::string &)> tStringPreprocessor;
     typedef std::vector<std::pair<std::string, tStringPreprocessor>> tStringPreprocessorMap;
 
+    /**
+     * the default number of bytes read from a stream per chunk
+     */
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 65536;
+
     /**
      * Constructor
      */
@@ -56,7 +71,8 @@ public:
      * Constructor which accepts a vector of delimiter strings
      */
     Tokenizer(const std::vector<std::string> &delimiters)
-    : m_bEnableStringPreprocessing(true)
+    : m_bDelimitersExposed(false),
+      m_bEnableStringPreprocessing(true)
     {
         setDelimiters(delimiters);
 
@@ -75,6 +91,7 @@ public:
      * Copy constructor
      */
     Tokenizer(const Tokenizer &tokenizer)
+    : m_bDelimitersExposed(false)
     {
         operator = (tokenizer);
     }
@@ -83,7 +100,8 @@ public:
      * Move constructor
      */
     Tokenizer(Tokenizer &&tokenizer)
-    : m_bEnableStringPreprocessing(false)
+    : m_bDelimitersExposed(false),
+      m_bEnableStringPreprocessing(false)
     {
         operator = (std::move(tokenizer));
     }
@@ -100,6 +118,8 @@ public:
             m_string = tokenizer.m_string;
             m_stringPreprocessors = tokenizer.m_stringPreprocessors;
             m_tokenProcessor = tokenizer.m_tokenProcessor;
+
+            compileDelimiters();
         }
 
         return *this;
@@ -117,6 +137,8 @@ public:
             m_string = std::move(tokenizer.m_string);
             m_stringPreprocessors = std::move(tokenizer.m_stringPreprocessors);
             m_tokenProcessor = std::move(tokenizer.m_tokenProcessor);
+
+            compileDelimiters();
         }
 
         return *this;
@@ -151,6 +173,8 @@ public:
             auto &&itDelim = std::find_if(m_delimiters.begin(), m_delimiters.end(), function);
             m_delimiters.insert(itDelim, delimiter);
         }
+
+        compileDelimiters();
     }
 
     /**
@@ -176,6 +200,10 @@ public:
      */
     inline virtual iterator begin(void) override
     {
+        // the delimiters may have been modified through getDelimiters()
+        if (m_bDelimitersExposed)
+            compileDelimiters();
+
         iterator it(m_string, std::bind(&Tokenizer::findNextToken, this, std::placeholders::_1,
                                         std::placeholders::_2));
 
@@ -198,6 +226,45 @@ public:
         return const_cast<Tokenizer *>(this)->end();
     }
 
+    /**
+     * Convert a token to an arithmetic type using the locale-independent std::from_chars(); as with stream
+     * extraction, leading whitespace is skipped, a single leading sign is accepted and trailing characters which
+     * are not part of the number are ignored. Returns true upon success
+     */
+    template<typename T>
+    inline static typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+                                          !traits::tests::is_character<T>::value, bool>::type
+    convert(std::string_view token, T &value)
+    {
+        auto *pBegin = token.data(), *pEnd = pBegin + token.size();
+        while (pBegin < pEnd && std::isspace(static_cast<unsigned char>(*pBegin)))
+            ++pBegin;
+
+        if (pBegin < pEnd && *pBegin == '+')
+        {
+            ++pBegin;
+            if (pBegin < pEnd && (*pBegin == '+' || *pBegin == '-'))
+                return false;
+        }
+
+        return std::from_chars(pBegin, pEnd, value).ec == std::errc();
+    }
+
+    /**
+     * Convert a token to a type which is not arithmetic, to bool or to a character type using stream extraction.
+     * Returns true upon success
+     */
+    template<typename T>
+    inline static typename std::enable_if<!std::is_arithmetic<T>::value || std::is_same<T, bool>::value ||
+                                          traits::tests::is_character<T>::value, bool>::type
+    convert(std::string_view token, T &value)
+    {
+        std::istringstream stream{std::string(token)};
+        stream >> value;
+
+        return !stream.fail();
+    }
+
     /**
      * Tests whether or not the object contains any delimiters
      */
@@ -230,62 +297,255 @@ public:
         return iterator(m_string);
     }
 
+    /**
+     * Visit the tokens of a caller-owned buffer without copying them. The function object is invoked with an
+     * std::string_view of each non-empty token and returns false to terminate tokenization; string
+     * preprocessors and the token processor are not applied. Returns true if the entire buffer was tokenized
+     * @param buffer  the characters to be tokenized, which must remain valid for the duration of the call
+     * @param functor a function object with signature bool (std::string_view)
+     */
+    template<typename Functor>
+    inline bool forEachToken(std::string_view buffer,
+                             Functor &&functor) const
+    {
+        CompiledDelimiters scratch;
+        auto &&compiledDelimiters = getCompiledDelimiters(scratch);
+        auto *pBuffer = buffer.data();
+
+        return scanTokens(compiledDelimiters, pBuffer, pBuffer + buffer.size(), true, functor);
+    }
+
+    /**
+     * Visit the tokens of a stream, which is read in chunks of the specified size so that the input is never
+     * held in memory in its entirety; a token which straddles two chunks is carried over to the next chunk,
+     * which grows as needed to hold tokens longer than the chunk size. The function object is invoked with an
+     * std::string_view of each non-empty token, which is valid only for the duration of the call, and returns
+     * false to terminate tokenization; string preprocessors and the token processor are not applied. Returns
+     * true if the entire stream was tokenized
+     * @param stream    a reference to an std::istream object
+     * @param functor   a function object with signature bool (std::string_view)
+     * @param chunkSize the number of bytes read from the stream at a time
+     */
+    template<typename Functor>
+    bool forEachToken(std::istream &stream,
+                      Functor &&functor,
+                      std::size_t chunkSize = DEFAULT_CHUNK_SIZE) const
+    {
+        bool bSuccess = (bool)stream;
+        if (bSuccess)
+        {
+            CompiledDelimiters scratch;
+            auto &&compiledDelimiters = getCompiledDelimiters(scratch);
+            std::vector<char> buffer(std::max(chunkSize, 2 * compiledDelimiters.m_maxDelimiterSize + 1));
+            std::size_t size = 0; // the number of unprocessed characters at the front of the buffer
+            bool bFinal = false;
+            while (bSuccess && !bFinal)
+            {
+                if (size == buffer.size())
+                    buffer.resize(2 * buffer.size());
+
+                auto &&count = stream.rdbuf()->sgetn(buffer.data() + size, buffer.size() - size);
+                bFinal = (count <= 0);
+                if (!bFinal)
+                    size += std::size_t(count);
+
+                const char *pBuffer = buffer.data(), *pEnd = pBuffer + size;
+                bSuccess = scanTokens(compiledDelimiters, pBuffer, pEnd, bFinal, functor);
+                size = std::size_t(pEnd - pBuffer);
+                std::memmove(buffer.data(), pBuffer, size);
+            }
+        }
+
+        return bSuccess;
+    }
+
 private:
 
     /**
-     * Function to get the next token. Returns a value of 0 for valid tokens, a value greater than 0 when a
-     * token should be ignored, or a value less than zero if parsing should terminate immediately.
+     * The delimiters compiled into a table of the bytes with which they begin and a list ordered from longest
+     * to shortest
      */
-    virtual int findNextToken(const char *&pBuffer, std::string &token) const final
+    struct CompiledDelimiters
     {
-        bool bConsecutiveDelimiter;
-        int result = -1; // assume failure or end of string
-        do
+        /**
+         * table of flags indicating which bytes begin a delimiter
+         */
+        std::array<bool, 256> m_delimiterTable;
+
+        /**
+         * the size of the longest delimiter
+         */
+        std::size_t m_maxDelimiterSize;
+
+        /**
+         * the non-empty delimiters, ordered from longest to shortest
+         */
+        std::vector<std::string> m_sortedDelimiters;
+    };
+
+    /**
+     * Compile this object's delimiters; called whenever the delimiters are modified through this object's
+     * interface
+     */
+    inline void compileDelimiters(void)
+    {
+        compileDelimiters(m_delimiters, m_compiledDelimiters);
+    }
+
+    /**
+     * Compile a set of delimiters
+     * @param      delimiters         the delimiters to be compiled
+     * @param[out] compiledDelimiters upon return, contains the compiled delimiters
+     */
+    inline static void compileDelimiters(const std::set<std::string> &delimiters,
+                                         CompiledDelimiters &compiledDelimiters)
+    {
+        auto &&sortedDelimiters = compiledDelimiters.m_sortedDelimiters;
+        compiledDelimiters.m_delimiterTable.fill(false);
+        sortedDelimiters.clear();
+        for (auto &&delimiter : delimiters)
         {
-            bConsecutiveDelimiter = false;
-            size_t length = std::strlen(pBuffer);
-            if (length > 0)
+            if (!delimiter.empty())
             {
-                // find the first occurrence of a delimiter...
-                const char *pEndOfToken = pBuffer + length, *pEndOfBuffer = pEndOfToken;
-                size_t delimiterSize = 0;
-                for (auto &&delimiter : m_delimiters)
+                compiledDelimiters.m_delimiterTable[static_cast<unsigned char>(delimiter[0])] = true;
+                sortedDelimiters.push_back(delimiter);
+            }
+        }
+
+        std::stable_sort(sortedDelimiters.begin(), sortedDelimiters.end(),
+                         [] (auto &&lhs, auto &&rhs) { return lhs.size() > rhs.size(); });
+        compiledDelimiters.m_maxDelimiterSize = sortedDelimiters.empty() ? 0 : sortedDelimiters.front().size();
+    }
+
+    /**
+     * Get this object's compiled delimiters; if the delimiters have been exposed through getDelimiters(), in
+     * which case they may have been modified since they were compiled, they are compiled into the specified
+     * scratch object instead, so that this object is not modified
+     * @param scratch the object into which exposed delimiters are compiled
+     */
+    inline const CompiledDelimiters &getCompiledDelimiters(CompiledDelimiters &scratch) const
+    {
+        if (!m_bDelimitersExposed)
+            return m_compiledDelimiters;
+
+        compileDelimiters(m_delimiters, scratch);
+
+        return scratch;
+    }
+
+    /**
+     * Find the first delimiter within the specified range; if more than one delimiter begins at that position,
+     * the longest is chosen. Returns a pointer to the delimiter, or the end of the range if none is found
+     * @param pBegin        a pointer to the beginning of the range
+     * @param pEnd          a pointer to the end of the range
+     * @param delimiterSize upon success, the size of the delimiter that was found
+     */
+    inline static const char *findDelimiter(const CompiledDelimiters &compiledDelimiters,
+                                            const char *pBegin,
+                                            const char *pEnd,
+                                            std::size_t &delimiterSize)
+    {
+        auto &&sortedDelimiters = compiledDelimiters.m_sortedDelimiters;
+        delimiterSize = 0;
+        if (compiledDelimiters.m_maxDelimiterSize == 1 && sortedDelimiters.size() == 1)
+        {
+            // a single one-character delimiter
+            auto *pDelimiter = static_cast<const char *>(std::memchr(pBegin, sortedDelimiters[0][0],
+                                                                     std::size_t(pEnd - pBegin)));
+            if (pDelimiter == nullptr)
+                return pEnd;
+
+            delimiterSize = 1;
+
+            return pDelimiter;
+        }
+
+        for (auto *pDelimiter = pBegin; pDelimiter < pEnd; ++pDelimiter)
+        {
+            if (compiledDelimiters.m_delimiterTable[static_cast<unsigned char>(*pDelimiter)])
+            {
+                auto &&remaining = std::size_t(pEnd - pDelimiter);
+                for (auto &&delimiter : sortedDelimiters)
                 {
-                    size_t size = delimiter.size();
-                    if (size > 0)
+                    if (delimiter.size() <= remaining &&
+                        std::memcmp(pDelimiter, delimiter.data(), delimiter.size()) == 0)
                     {
-                        auto *pDelimiter = delimiter.c_str();
-                        pDelimiter = std::search(pBuffer, pBuffer + length, pDelimiter, pDelimiter + size);
-                        if (pDelimiter == pEndOfToken && pEndOfToken != pEndOfBuffer)
-                            delimiterSize = std::max(delimiterSize, size);
-                        else if (pDelimiter < pEndOfToken)
-                        {
-                            pEndOfToken = pDelimiter;
-                            delimiterSize = size;
-                        }
+                        delimiterSize = delimiter.size();
+
+                        return pDelimiter;
                     }
                 }
+            }
+        }
 
-                std::string string(pBuffer, pEndOfToken);
-                if (!string.empty())
-                {
-                    pBuffer = pEndOfToken;
-                    result = m_tokenProcessor(string);
-                    if (result == 0)
-                        token = std::move(string);
-                }
-                else if (pEndOfToken)
-                    bConsecutiveDelimiter = true;
+        return pEnd;
+    }
+
+    /**
+     * Function to get the next token. Returns a value of 0 for valid tokens, a value greater than 0 when a
+     * token should be ignored, or a value less than zero if parsing should terminate immediately.
+     */
+    virtual int findNextToken(const char *&pBuffer, std::string &token) const final
+    {
+        // tokens are extracted from this object's string, the end of which is known
+        auto *pEndOfBuffer = m_string.data() + m_string.size();
+        if (pBuffer < m_string.data() || pBuffer > pEndOfBuffer)
+            pEndOfBuffer = pBuffer + std::strlen(pBuffer);
 
-                if (pEndOfToken)
-                    pBuffer += delimiterSize;
+        int result = -1; // assume failure or end of string
+        while (pBuffer < pEndOfBuffer)
+        {
+            size_t delimiterSize = 0;
+            auto *pEndOfToken = findDelimiter(m_compiledDelimiters, pBuffer, pEndOfBuffer, delimiterSize);
+            std::string string(pBuffer, pEndOfToken);
+            pBuffer = pEndOfToken + delimiterSize;
+            if (!string.empty())
+            {
+                result = m_tokenProcessor(string);
+                if (result == 0)
+                    token = std::move(string);
+
+                break;
             }
         }
-        while (bConsecutiveDelimiter);
 
         return result;
     }
 
+    /**
+     * Visit the non-empty tokens within the specified range. Unless the range ends the input, a token is
+     * visited only once the longest delimiter which may end it lies entirely within the range. Returns false
+     * if the function object terminated tokenization
+     * @param compiledDelimiters the compiled delimiters
+     * @param pBuffer            upon return, points to the first character which has not been tokenized
+     * @param pEnd               a pointer to the end of the range
+     * @param bFinal             flag indicating whether or not the range ends the input
+     * @param functor            a function object with signature bool (std::string_view)
+     */
+    template<typename Functor>
+    inline static bool scanTokens(const CompiledDelimiters &compiledDelimiters,
+                                  const char *&pBuffer,
+                                  const char *pEnd,
+                                  bool bFinal,
+                                  Functor &functor)
+    {
+        auto maxDelimiterSize = std::max(compiledDelimiters.m_maxDelimiterSize, std::size_t(1));
+        while (pBuffer < pEnd)
+        {
+            std::size_t delimiterSize = 0;
+            auto *pDelimiter = findDelimiter(compiledDelimiters, pBuffer, pEnd, delimiterSize);
+            if (!bFinal && std::size_t(pEnd - pDelimiter) < maxDelimiterSize)
+                break;
+
+            auto *pToken = pBuffer;
+            pBuffer = pDelimiter + delimiterSize;
+            if (pDelimiter > pToken && !functor(std::string_view(pToken, std::size_t(pDelimiter - pToken))))
+                return false;
+        }
+
+        return true;
+    }
+
 public:
 
     /**
@@ -303,6 +563,10 @@ public:
      */
     inline virtual std::set<std::string> &getDelimiters(void) final
     {
+        // the delimiters may be modified through the returned reference, so the compiled delimiters can no
+        // longer be trusted
+        m_bDelimitersExposed = true;
+
         return m_delimiters;
     }
 
@@ -429,16 +693,25 @@ public:
     }
 
     /**
-     * Overload of the parse() method which converts a stream into a string and then calls the split() method
-     * to tokenize the string.
+     * Overload of the parse() method which tokenizes a stream. Unless string preprocessing is required, which
+     * operates upon the input in its entirety, the stream is tokenized in chunks; otherwise, the stream is
+     * converted into a string and then the split() method is called to tokenize the string.
      * @param stream a reference to an std::istream object
      */
     template<typename T>
     inline std::vector<T> parse(std::istream &stream)
     {
-        std::string string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        if (isStringPreprocessingRequired())
+        {
+            std::string string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
 
-        return split<T>(std::move(string));
+            return split<T>(std::move(string));
+        }
+
+        std::vector<T> tokens;
+        forEachToken(stream, [&tokens] (std::string_view token) { return appendToken(token, tokens), true; });
+
+        return tokens;
     }
 
     /**
@@ -495,9 +768,26 @@ public:
     template<typename T, typename Functor>
     inline std::vector<T> parse(std::istream &stream, Functor &&tokenProcessor)
     {
-        std::string string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        if (isStringPreprocessingRequired())
+        {
+            std::string string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
 
-        return split<T>(std::move(string), std::forward<Functor>(tokenProcessor));
+            return split<T>(std::move(string), std::forward<Functor>(tokenProcessor));
+        }
+
+        // tokenize the stream in chunks
+        std::vector<T> tokens;
+        forEachToken(stream, [&tokenProcessor, &tokens] (std::string_view token)
+        {
+            std::string string(token);
+            int result = tokenProcessor(string);
+            if (result == 0)
+                appendToken(std::string_view(string), tokens);
+
+            return result >= 0;
+        });
+
+        return tokens;
     }
 
     /**
@@ -560,6 +850,8 @@ public:
         }
         else
             m_delimiters.clear();
+
+        compileDelimiters();
     }
 
     /**
@@ -657,6 +949,55 @@ public:
 
 private:
 
+    /**
+     * Append a token to a vector of strings
+     */
+    template<typename T>
+    inline static typename std::enable_if<std::is_assignable<T, std::string>::value, void>::type
+    appendToken(std::string_view token, std::vector<T> &tokens)
+    {
+        tokens.emplace_back(std::string(token));
+    }
+
+    /**
+     * Append a token to a vector of type T, provided that the token can be converted to type T
+     */
+    template<typename T>
+    inline static typename std::enable_if<!std::is_assignable<T, std::string>::value, void>::type
+    appendToken(std::string_view token, std::vector<T> &tokens)
+    {
+        T value;
+        if (convert(token, value))
+            tokens.push_back(value);
+    }
+
+    /**
+     * Determine whether or not string preprocessing is enabled and there are string preprocessors to apply
+     */
+    inline bool isStringPreprocessingRequired(void) const
+    {
+        return m_bEnableStringPreprocessing &&
+               std::any_of(m_stringPreprocessors.cbegin(), m_stringPreprocessors.cend(),
+                           [] (auto &&pair) { return (bool)pair.second; });
+    }
+
+    /**
+     * Apply the string preprocessors to this object's string, if string preprocessing is enabled
+     */
+    inline void preprocess(void)
+    {
+        if (m_bEnableStringPreprocessing)
+        {
+            auto &&stringPreprocessors = getStringPreprocessors();
+            for (auto &&itNameStringPreprocessorPair : stringPreprocessors)
+            {
+                auto &&stringPreprocessor = itNameStringPreprocessorPair.second;
+                if (stringPreprocessor)
+                    stringPreprocessor(m_string);
+            }
+        }
+    }
+
     /**
      * This is the primary tokenization method that converts string input into tokens. The function tokenizes
      * the input string in the order in which delimiters are encountered and returns the tokens in a vector. If
@@ -667,7 +1008,13 @@ private:
     template<typename T>
     inline std::vector<T> split(std::string &&string)
     {
-        return split<T>(std::move(string), [] (std::string &) { return 0; });
+        initialize(std::move(string));
+        preprocess();
+
+        std::vector<T> tokens;
+        forEachToken(m_string, [&tokens] (std::string_view token) { return appendToken(token, tokens), true; });
+
+        return tokens;
     }
 
     /**
@@ -687,16 +1034,7 @@ private:
         initialize(std::move(string), std::forward<Functor>(tokenProcessor));
 
         // preprocess the string prior to tokenization
-        if (m_bEnableStringPreprocessing)
-        {
-            auto &&stringPreprocessors = getStringPreprocessors();
-            for (auto &&itNameStringPreprocessorPair : stringPreprocessors)
-            {
-                auto &&stringPreprocessor = itNameStringPreprocessorPair.second;
-                if (stringPreprocessor)
-                    stringPreprocessor(m_string);
-            }
-        }
+        preprocess();
 
         std::vector<T> tokens;
         split(tokens);
@@ -715,14 +1053,10 @@ private:
     typename std::enable_if<std::is_assignable<T, std::string>::value, void>::type
     split(std::vector<T> &tokens)
     {
-        std::istringstream stream;
         for (auto &&itToken = begin(); itToken != end(); ++itToken)
         {
             if (!itToken->empty())
-            {
                 tokens.push_back(*itToken);
-                stream.clear();
-            }
         }
     }
 
@@ -737,27 +1071,29 @@ private:
     typename std::enable_if<!std::is_assignable<T, std::string>::value, void>::type
     split(std::vector<T> &tokens)
     {
-        T value;
-        std::istringstream stream;
         for (auto &&itToken = begin(); itToken != end(); ++itToken)
         {
             if (!itToken->empty())
-            {
-                stream.str(*itToken);
-                stream >> value;
-                if (!stream.fail())
-                    tokens.push_back(value);
-
-                stream.clear();
-            }
+                appendToken(std::string_view(*itToken), tokens);
         }
     }
 
+    /**
+     * flag indicating that the delimiters have been exposed through getDelimiters(), after which they may be
+     * modified without this object's knowledge
+     */
+    bool m_bDelimitersExposed;
+
     /**
      * flag to enable/disable string pre-processing
      */
     bool m_bEnableStringPreprocessing;
 
+    /**
+     * this object's compiled delimiters
+     */
+    CompiledDelimiters m_compiledDelimiters;
+
     /**
      * vector of delimiter tokens
      */
@@ -0,0 +1,292 @@
+#include "any.h"
+#include "publisher.h"
+#include "subscriber.h"
+#include "testAny.h"
+#include "unitTestManager.h"
+#include "vector3d.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace functional;
+using namespace math::linear_algebra::vector;
+using namespace messaging;
+
+/**
+ * Function to access the flag which indicates whether or not dynamic memory allocations performed by the calling
+ * thread are to be counted
+ */
+static bool &getAllocationCounting(void)
+{
+    static thread_local bool bCounting = false;
+
+    return bCounting;
+}
+
+/**
+ * Function to access the number of dynamic memory allocations counted by the unit tester
+ */
+static std::size_t &getAllocationCount(void)
+{
+    static thread_local std::size_t allocationCount = 0;
+
+    return allocationCount;
+}
+
+/**
+ * Replacement global operator new that counts allocations while counting is enabled for the calling thread
+ */
+void *operator new (std::size_t size)
+{
+    if (getAllocationCounting())
+        ++getAllocationCount();
+
+    auto *pMemory = std::malloc(size > 0 ? size : 1);
+    if (pMemory == nullptr)
+        throw std::bad_alloc();
+
+    return pMemory;
+}
+
+/**
+ * Replacement global operator delete
+ */
+void operator delete (void *pMemory) noexcept
+{
+    std::free(pMemory);
+}
+
+/**
+ * Replacement global sized operator delete
+ */
+void operator delete (void *pMemory, std::size_t) noexcept
+{
+    std::free(pMemory);
+}
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testAny", &AnyUnitTest::create);
+
+/**
+ * A value type that counts the number of times it is copied and moved
+ */
+struct CountedValue
+{
+    /**
+     * Constructor
+     */
+    CountedValue(double value)
+    : m_value(value)
+    {
+
+    }
+
+    /**
+     * Copy constructor
+     */
+    CountedValue(const CountedValue &counted)
+    : m_value(counted.m_value)
+    {
+        ++m_numCopies;
+    }
+
+    /**
+     * Move constructor
+     */
+    CountedValue(CountedValue &&counted) noexcept
+    : m_value(counted.m_value)
+    {
+        ++m_numMoves;
+    }
+
+    /**
+     * the number of copies made of objects of this type
+     */
+    static std::size_t m_numCopies;
+
+    /**
+     * the number of moves made of objects of this type
+     */
+    static std::size_t m_numMoves;
+
+    /**
+     * the value
+     */
+    double m_value;
+};
+
+std::size_t CountedValue::m_numCopies = 0;
+std::size_t CountedValue::m_numMoves = 0;
+
+/**
+ * Function to determine whether or not the value held by the specified object resides within the object itself
+ * (rather than on the heap)
+ */
+static bool isHeldWithin(const Any &any)
+{
+    auto &&holderAddress = reinterpret_cast<std::uintptr_t>(any.holder());
+    auto &&address = reinterpret_cast<std::uintptr_t>(&any);
+
+    return holderAddress >= address && holderAddress < address + sizeof(Any);
+}
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+AnyUnitTest::AnyUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+AnyUnitTest *AnyUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    AnyUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new AnyUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool AnyUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for Any class..." << std::endl << std::endl;
+
+    // small values are stored in place, large values on the heap
+    typedef std::array<double, 16> tLargeArray;
+    auto pShared = std::make_shared<int>(7);
+    Vector3d vector(1.0, 2.0, 3.0);
+    Any anyDouble(3.5), anyShared(pShared), anyVector(vector), anyLarge(tLargeArray{ 1.0 });
+    bool bSuccess = anyDouble.isStoredInPlace() && isHeldWithin(anyDouble) && anyShared.isStoredInPlace() &&
+                    isHeldWithin(anyShared) && anyVector.isStoredInPlace() && isHeldWithin(anyVector) &&
+                    !anyLarge.isStoredInPlace() && !isHeldWithin(anyLarge);
+
+    // copies, moves and swaps preserve values and keep values that are stored in place within the object
+    Any copyDouble(anyDouble), copyVector(anyVector), moveShared(std::move(anyShared));
+    copyDouble.swap(copyVector);
+    bSuccess &= isHeldWithin(copyDouble) && isHeldWithin(copyVector) && isHeldWithin(moveShared) &&
+                anyShared.empty() && pShared.use_count() == 2 && any_cast<double>(copyVector) == 3.5 &&
+                any_cast<Vector3d>(copyDouble) == vector && *any_cast<std::shared_ptr<int>>(moveShared) == 7;
+
+    copyDouble.swap(anyLarge);
+    Any moveLarge(std::move(copyDouble));
+    bSuccess &= any_cast<tLargeArray>(moveLarge)[0] == 1.0 && any_cast<Vector3d>(anyLarge) == vector &&
+                anyLarge.isStoredInPlace() && isHeldWithin(anyLarge) && !moveLarge.isStoredInPlace() &&
+                !isHeldWithin(moveLarge) && copyDouble.empty();
+
+    // values are copied only when an Any is constructed from an lvalue or copied; rvalues, moves and swaps
+    // move the value
+    CountedValue counted(2.5);
+    Any anyCounted(counted), anyMovedIn(CountedValue(0.5));
+    Any moveCounted(std::move(anyCounted));
+    moveCounted.swap(anyMovedIn);
+    Any copyCounted(anyMovedIn);
+    bSuccess &= CountedValue::m_numCopies == 2 && CountedValue::m_numMoves > 0 && anyCounted.empty() &&
+                isHeldWithin(copyCounted) && any_cast<CountedValue>(&copyCounted)->m_value == 2.5 &&
+                any_cast<CountedValue>(&moveCounted)->m_value == 0.5;
+
+    // values can be modified through references, reference wrappers are unwrapped, and mismatched casts throw
+    int i = 1;
+    Any anyReference(std::ref(i));
+    any_cast<int &>(anyReference) = 2;
+    any_cast<double &>(anyDouble) = 4.5;
+    bSuccess &= i == 2 && any_cast<double>(anyDouble) == 4.5 && any_cast<int>(&anyDouble) == nullptr;
+
+    // cv-qualified casts refer to the held value
+    const Any &constAnyVector = anyVector;
+    bSuccess &= any_cast<const double>(&anyDouble) == any_cast<double>(&anyDouble) &&
+                &any_cast<const Vector3d &>(constAnyVector) == any_cast<Vector3d>(&anyVector) &&
+                any_cast<const volatile int>(&anyDouble) == nullptr;
+    try
+    {
+        any_cast<float>(anyDouble);
+        bSuccess = false;
+    }
+    catch (const bad_any_cast &)
+    {
+
+    }
+
+    std::cout << "Storage, copy and cast semantics " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // count the copies of the messages made and the allocations performed per notification to a subscriber
+    std::size_t numReceived = 0;
+    Publisher publisher;
+    Subscriber subscriber;
+    subscriber.getMessageDispatcher()->addRecipient("update", [&numReceived, &vector] (double x,
+                                                                                       const Vector3d &position,
+                                                                                       const std::shared_ptr<int> &pId,
+                                                                                       const CountedValue &counted)
+    {
+        numReceived += (x == 1.0 && position == vector && *pId == 7 && counted.m_value == 2.5);
+    });
+
+    publisher.addSubscriber(&subscriber);
+
+    const std::size_t numNotifications = 100000;
+    const std::string recipient("update");
+    auto &&start = std::chrono::high_resolution_clock::now();
+    auto numCopies = CountedValue::m_numCopies;
+    auto &&allocationCount = getAllocationCount();
+    auto initialAllocationCount = allocationCount;
+    getAllocationCounting() = true;
+    for (std::size_t j = 0; j < numNotifications; ++j)
+        publisher.notify(recipient, 1.0, vector, pShared, counted);
+
+    getAllocationCounting() = false;
+    auto &&numLvalueAllocations = allocationCount - initialAllocationCount;
+    auto &&numLvalueCopies = CountedValue::m_numCopies - numCopies;
+    auto &&elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    numCopies = CountedValue::m_numCopies;
+    initialAllocationCount = allocationCount;
+    getAllocationCounting() = true;
+    for (std::size_t j = 0; j < numNotifications; ++j)
+        publisher.notify(recipient, 1.0, vector, pShared, CountedValue(2.5));
+
+    getAllocationCounting() = false;
+    auto &&numRvalueAllocations = allocationCount - initialAllocationCount;
+    auto &&numRvalueCopies = CountedValue::m_numCopies - numCopies;
+    std::cout << "Copies per notify (lvalue, rvalue): " << double(numLvalueCopies) / numNotifications << ", "
+              << double(numRvalueCopies) / numNotifications << std::endl
+              << "Allocations per notify (lvalue, rvalue): " << double(numLvalueAllocations) / numNotifications
+              << ", " << double(numRvalueAllocations) / numNotifications << std::endl
+              << "Time per notify (us): " << 1.0e6 * elapsed / numNotifications << std::endl << std::endl;
+
+    // lvalue messages are copied once into the message vector, rvalue messages are moved, and no message
+    // outlives its delivery. All messages are stored in place, so the only allocation is the message vector
+    // itself
+    bSuccess = numReceived == 2 * numNotifications && numLvalueCopies == numNotifications &&
+               numRvalueCopies == 0 && numLvalueAllocations <= numNotifications &&
+               numRvalueAllocations <= numNotifications && pShared.use_count() == 2;
+    std::cout << "Messaging " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+
+    return bSuccess;
+}
+
+}
@@ -0,0 +1,82 @@
+#ifndef TEST_ANY_H
+#define TEST_ANY_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for Any class
+ */
+class AnyUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    AnyUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    AnyUnitTest(const AnyUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    AnyUnitTest(AnyUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~AnyUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    AnyUnitTest &operator = (const AnyUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    AnyUnitTest &operator = (AnyUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static AnyUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "AnyTest";
+    }
+};
+
+}
+
+#endif
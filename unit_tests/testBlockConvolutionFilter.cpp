@@ -0,0 +1,178 @@
+#include "block_convolution_filter.h"
+#include "digital_filter.h"
+#include "testBlockConvolutionFilter.h"
+#include "unitTestManager.h"
+#include "unitTestUtilities.h"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace math::signal_processing::filters;
+using namespace messaging;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testBlockConvolutionFilter",
+                                                    &BlockConvolutionFilterUnitTest::create);
+
+/**
+ * Filter a signal in blocks of random size and compute the largest absolute difference from the expected output
+ */
+static double filterInBlocks(BlockConvolutionFilter<double> &filter, const std::vector<double> &x,
+                             const std::vector<double> &expected, std::default_random_engine &generator,
+                             bool bInPlace)
+{
+    std::uniform_int_distribution<std::size_t> blockSize(0, 3000);
+    std::vector<double> y(x.size());
+    if (bInPlace)
+        y = x;
+
+    for (std::size_t i = 0; i < x.size();)
+    {
+        auto count = std::min(blockSize(generator), x.size() - i);
+        if (!filter.filter(bInPlace ? &y[i] : &x[i], (bInPlace ? &y[i] : &x[i]) + count, &y[i]))
+            return INFINITY;
+
+        i += count;
+    }
+
+    return computeMaximumError(y, expected);
+}
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+BlockConvolutionFilterUnitTest::BlockConvolutionFilterUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+BlockConvolutionFilterUnitTest *BlockConvolutionFilterUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    BlockConvolutionFilterUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new BlockConvolutionFilterUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool BlockConvolutionFilterUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for BlockConvolutionFilter class..." << std::endl << std::endl;
+
+    std::default_random_engine generator;
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::vector<double> x(20000), expected(x.size());
+    std::generate(x.begin(), x.end(), [&] () { return uniform(generator); });
+
+    // long FIR filters are evaluated by overlap-save and agree with the recurrence, however the signal is split
+    bool bSuccess = true;
+    for (std::size_t numTaps : { 64, 200, 1500 })
+    {
+        std::vector<double> taps(numTaps);
+        std::generate(taps.begin(), taps.end(), [&] () { return uniform(generator); });
+        DigitalFilter<double> recurrence({ 2.0 }, taps);
+        BlockConvolutionFilter<double> filter({ 2.0 }, taps);
+        recurrence.filter(x, expected);
+        bSuccess &= (filter.isOverlapSaveActive() && filter.getBlockSize() > 0 &&
+                     filterInBlocks(filter, x, expected, generator, false) < 1.0e-10);
+
+        // output may overwrite the input, and clearing the state restarts the signal
+        filter.clearDelays();
+        bSuccess &= (filterInBlocks(filter, x, expected, generator, true) < 1.0e-10);
+        if (!bSuccess)
+        {
+            std::cout << "Filter with " << numTaps << " taps FAILED." << std::endl << std::endl;
+            break;
+        }
+    }
+
+    std::cout << "Overlap-save block convolution " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // IIR and short FIR filters fall back to the recurrence, as do long FIR filters below a raised threshold
+    DigitalFilter<double> recurrence({ 1.0, -0.5, 0.25 }, { 1.0, 0.3 });
+    BlockConvolutionFilter<double> filter({ 1.0, -0.5, 0.25 }, { 1.0, 0.3 });
+    recurrence.filter(x, expected);
+    bSuccess = (!filter.isOverlapSaveActive() && filterInBlocks(filter, x, expected, generator, false) < 1.0e-12);
+    bSuccess &= (filter.setCoefficients({ 1.0 }, std::vector<double>(10, 0.1)) && !filter.isOverlapSaveActive());
+
+    std::vector<double> taps(100, 0.01), a, b;
+    bSuccess &= (filter.setCoefficients({ 1.0 }, taps) && filter.isOverlapSaveActive());
+    filter.setFftThreshold(101);
+    filter.getCoefficients(a, b);
+    bSuccess &= (!filter.isOverlapSaveActive() && b == taps);
+    std::cout << "Fallback to the recurrence " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // measure the throughput of the recurrence and of overlap-save for a stream delivered in blocks of 4096
+    const std::size_t streamBlockSize = 4096;
+    std::vector<double> y(streamBlockSize);
+    std::size_t crossover = 0;
+    std::cout << std::setw(15) << "Taps" << std::setw(25) << "Recurrence (samples/s)" << std::setw(25)
+              << "Overlap-save (samples/s)" << std::endl;
+    for (std::size_t numTaps = 8; numTaps <= 2048; numTaps *= 2)
+    {
+        taps.resize(numTaps);
+        std::generate(taps.begin(), taps.end(), [&] () { return uniform(generator); });
+        BlockConvolutionFilter<double> direct({ 1.0 }, taps), fast({ 1.0 }, taps);
+        direct.setFftThreshold(std::size_t(-1));
+        fast.setFftThreshold(0);
+
+        double throughput[2];
+        BlockConvolutionFilter<double> *pFilters[] = { &direct, &fast };
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            std::size_t numSamples = 0;
+            auto &&start = std::chrono::steady_clock::now();
+            std::chrono::duration<double> elapsed(0.0);
+            while (elapsed.count() < 0.05)
+            {
+                auto &&offset = numSamples % (x.size() - streamBlockSize);
+                pFilters[i]->filter(&x[offset], &x[offset] + streamBlockSize, &y[0]);
+                numSamples += streamBlockSize;
+                elapsed = std::chrono::steady_clock::now() - start;
+            }
+
+            throughput[i] = double(numSamples) / elapsed.count();
+        }
+
+        if (crossover == 0 && throughput[1] > throughput[0])
+            crossover = numTaps;
+
+        std::cout << std::setw(15) << numTaps << std::setw(25) << throughput[0] << std::setw(25) << throughput[1]
+                  << std::endl;
+    }
+
+    std::cout << std::endl << "Overlap-save is faster for filters of " << crossover << " taps and above; the "
+              << "default threshold is " << BlockConvolutionFilter<double>::DEFAULT_FFT_THRESHOLD << "."
+              << std::endl << std::endl;
+
+    return bSuccess;
+}
+
+}
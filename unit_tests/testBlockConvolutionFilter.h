@@ -0,0 +1,82 @@
+#ifndef TEST_BLOCK_CONVOLUTION_FILTER_H
+#define TEST_BLOCK_CONVOLUTION_FILTER_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for BlockConvolutionFilter class
+ */
+class BlockConvolutionFilterUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    BlockConvolutionFilterUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    BlockConvolutionFilterUnitTest(const BlockConvolutionFilterUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    BlockConvolutionFilterUnitTest(BlockConvolutionFilterUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~BlockConvolutionFilterUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    BlockConvolutionFilterUnitTest &operator = (const BlockConvolutionFilterUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    BlockConvolutionFilterUnitTest &operator = (BlockConvolutionFilterUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static BlockConvolutionFilterUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "BlockConvolutionFilterTest";
+    }
+};
+
+}
+
+#endif
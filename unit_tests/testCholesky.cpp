@@ -58,6 +58,26 @@ bool CholeskyUnitTest::execute(void)
 
     std::ofstream stream("outputs/choleskyFactorTestOutput.dat");
 
+    /*
+     * Test rejection of an indefinite matrix, whose diagonal elements are positive but whose second pivot,
+     * 1 - 2 * 2, is negative
+     */
+
+    stream << " Test Cholesky factorization of an indefinite matrix:" << std::endl << std::endl;
+
+    Matrix<2, double> indefinite(2, 2);
+    indefinite(0, 0) = indefinite(1, 1) = 1.0;
+    indefinite(0, 1) = indefinite(1, 0) = 2.0;
+
+    Cholesky_Factor<Matrix<2, double>> indefiniteSolver;
+    bool bSuccess = (indefiniteSolver.factor(indefinite) == 2);
+    if (bSuccess)
+        stream << " Yes, test PASSED with the matrix reported as not positive definite."
+               << std::endl << std::endl;
+    else
+        stream << " No, test FAILED to report the matrix as not positive definite."
+               << std::endl << std::endl;
+
     stream << " Test Cholesky factorization:" << std::endl << std::endl;
 
     std::random_device seed;
@@ -338,7 +358,7 @@ bool CholeskyUnitTest::execute(void)
                    << std::endl << std::endl;
     }
 
-    return true;
+    return bSuccess;
 }
 
 }
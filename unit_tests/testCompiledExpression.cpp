@@ -0,0 +1,218 @@
+#include "compiled_expression.h"
+#include "expression_evaluator.h"
+#include "testCompiledExpression.h"
+#include "unitTestManager.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace functional;
+using namespace messaging;
+using namespace utilities;
+using namespace utilities::expression;
+
+// type alias declarations
+using ErrorType = CompiledExpression<double>::ErrorType;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testCompiledExpression",
+                                                    &CompiledExpressionUnitTest::create);
+
+/**
+ * Defines an expression function object which returns the larger of its two arguments
+ */
+struct maximum
+: public ExpressionFunctor<double>
+{
+    /**
+     * Default constructor
+     */
+    maximum(void)
+    : ExpressionFunctor<double>("maximum")
+    {
+        m_result.resize(1);
+    }
+
+    /**
+     * Function call operator
+     */
+    inline Any operator () (std::vector<Any> &arguments) override
+    {
+        m_result[0] = std::max(any_cast<double>(arguments[0]), any_cast<double>(arguments[1]));
+
+        return std::ref(m_result[0]);
+    }
+
+    /**
+     * clone() function
+     */
+    inline maximum *clone(void) const override
+    {
+        return new maximum(*this);
+    }
+
+    /**
+     * create() function
+     */
+    inline static maximum *create(void)
+    {
+        return new maximum();
+    }
+};
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+CompiledExpressionUnitTest::CompiledExpressionUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+CompiledExpressionUnitTest *CompiledExpressionUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    CompiledExpressionUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new CompiledExpressionUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool CompiledExpressionUnitTest::execute(void)
+{
+    FactoryConstructible<ExpressionFunctor<double>>::registerFactory("maximum", maximum::create);
+
+    std::cout << "Starting unit test for CompiledExpression class..." << std::endl << std::endl;
+
+    double a = 4, b = 5, c = 2, d = 3, e = 7;
+    VariableRegistry variables = { { "a", a }, { "b", b }, { "c", c }, { "d", d }, { "e", e } };
+    ExpressionEvaluator<double> evaluator;
+    evaluator.setVariableRegistry(variables);
+    CompiledExpression<double> expression;
+    expression.setVariableRegistry(variables);
+
+    // compiled programs agree with the interpreting evaluator
+    const std::vector<std::string> expressions = { "1234", "1+c*3", "b*(a+a+1)", "b*(c*(1+3)+1)",
+                                                   "!(b*((1+30%a*c)*c+1)>=55) || a==1+c*3/c+1",
+                                                   "b - c * ( ( 9 % b)  - 1 )", "-(c+1)*a", "1+-c", "c---c",
+                                                   "c-+-c", "(a-3)/(a*a)", ".25 / c * .5", "a<b && !(d>=e) || c!=2",
+                                                   "a % d + e / b" };
+    bool bSuccess = true;
+    for (auto &&string : expressions)
+    {
+        double result = 0.0, compiledResult = 1.0;
+        bSuccess &= (evaluator.evaluate(string.c_str(), result) && expression.compile(string.c_str()) &&
+                     expression.evaluate(compiledResult) && result == compiledResult);
+        if (!bSuccess)
+        {
+            std::cout << "Expression \"" << string << "\" evaluated to " << compiledResult << ", expected " << result
+                      << std::endl;
+            break;
+        }
+    }
+
+    // functions are called with the values of their arguments
+    double result = 0.0;
+    bSuccess &= (expression.compile("maximum(a*b, e+1) - maximum(2, 3)") && expression.evaluate(result) &&
+                 result == 17.0);
+
+    // constant sub-expressions are folded, and variables are read at evaluation time
+    bSuccess &= (expression.compile("-(1+2)*4") && expression.getNumInstructions() == 1 &&
+                 expression.evaluate(result) && result == -12.0);
+    bSuccess &= (expression.compile("2*3+a") && expression.getNumInstructions() == 3);
+    a = 10.0;
+    bSuccess &= (expression.evaluate(result) && result == 16.0);
+    a = 4.0;
+    std::cout << "Agreement with ExpressionEvaluator, function calls and constant folding "
+              << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // invalid expressions and unknown variables are rejected
+    bSuccess = (!expression.compile("c+") && expression.getErrorType() == ErrorType::Invalid &&
+                expression.empty() && !expression.evaluate(result) &&
+                !expression.compile("q+1") && !expression.compile("b*((1+3)*c+1") &&
+                expression.getErrorType() == ErrorType::Parenthesis);
+    std::cout << "Rejection of invalid expressions " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // evaluate an expression for many entities, each with its own values of a and b; the values of b are
+    // interleaved with other data. The interpreting evaluator, which parses the expression on every call, is
+    // timed over the first few entities only
+    const char *pExpression = "(a * b + c * (d - 1)) / (e + a) - (a > b) * 0.5";
+    const std::size_t numEntities = 10000, numInterpreted = 20;
+    std::vector<double> as(numEntities), bs(2 * numEntities), results(numEntities), expected(numEntities);
+    for (std::size_t i = 0; i < numEntities; ++i)
+    {
+        as[i] = 0.01 * double(i);
+        bs[2 * i] = 100.0 - 0.02 * double(i);
+    }
+
+    bSuccess = expression.compile(pExpression);
+    auto &&start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numInterpreted; ++i)
+    {
+        a = as[i];
+        b = bs[2 * i];
+        bSuccess &= evaluator.evaluate(pExpression, results[i]);
+    }
+
+    auto &&interpretedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numEntities; ++i)
+    {
+        a = as[i];
+        b = bs[2 * i];
+        bSuccess &= (expression.evaluate(expected[i]) && (i >= numInterpreted || expected[i] == results[i]));
+    }
+
+    auto &&compiledTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    bSuccess &= (expression.bindArray("a", as.data()) && expression.bindArray("b", bs.data(), 2) &&
+                 !expression.bindArray("q", as.data()));
+    std::fill(results.begin(), results.end(), 0.0);
+    start = std::chrono::steady_clock::now();
+    bSuccess &= expression.evaluate(numEntities, results.data());
+    auto &&batchedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (std::size_t i = 0; bSuccess && i < numEntities; ++i)
+        bSuccess = (std::fabs(results[i] - expected[i]) <= 1.0e-12 * std::fabs(expected[i]));
+
+    // copies retain their array bindings
+    CompiledExpression<double> copy(expression);
+    std::vector<double> copyResults(numEntities);
+    bSuccess &= (copy.evaluate(numEntities, copyResults.data()) && copyResults == results);
+
+    // once unbound, batched evaluations use the registered values
+    expression.unbindArrays();
+    bSuccess &= (expression.evaluate(3, results.data()) && results[0] == expected.back() &&
+                 results[2] == expected.back());
+    std::cout << "Batched evaluation (interpreted " << 1.0e9 * interpretedTime / numInterpreted << " ns, compiled "
+              << 1.0e9 * compiledTime / numEntities << " ns, batched " << 1.0e9 * batchedTime / numEntities
+              << " ns per entity) " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+
+    FactoryConstructible<ExpressionFunctor<double>>::removeFactory("maximum");
+
+    return bSuccess;
+}
+
+}
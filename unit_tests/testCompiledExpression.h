@@ -0,0 +1,82 @@
+#ifndef TEST_COMPILED_EXPRESSION_H
+#define TEST_COMPILED_EXPRESSION_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for CompiledExpression class
+ */
+class CompiledExpressionUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    CompiledExpressionUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    CompiledExpressionUnitTest(const CompiledExpressionUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    CompiledExpressionUnitTest(CompiledExpressionUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~CompiledExpressionUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    CompiledExpressionUnitTest &operator = (const CompiledExpressionUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    CompiledExpressionUnitTest &operator = (CompiledExpressionUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static CompiledExpressionUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "CompiledExpressionTest";
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,227 @@
+#include "cartesianMotionState.h"
+#include "compositeFrameTransform.h"
+#include "referenceFrame.h"
+#include "sphericalMotionState.h"
+#include "state_derivative_type.h"
+#include "testCompositeFrameTransform.h"
+#include "unitTestManager.h"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace messaging;
+using namespace physics::kinematics;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testCompositeFrameTransform",
+                                                    &CompositeFrameTransformUnitTest::create);
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+CompositeFrameTransformUnitTest::CompositeFrameTransformUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+CompositeFrameTransformUnitTest *CompositeFrameTransformUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    CompositeFrameTransformUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new CompositeFrameTransformUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool CompositeFrameTransformUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for CompositeFrameTransform class..." << std::endl << std::endl;
+
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+    // create a frame tree with two branches: root -> a -> b -> c and root -> d -> e; each frame is given a
+    // random origin, velocity, acceleration, orientation, rotational rates and rotational accelerations
+    auto *pRootFrame = ReferenceFrame::create("root");
+    auto *pFrameA = pRootFrame->createChild("a");
+    auto *pFrameB = pFrameA->createChild("b");
+    auto *pFrameC = pFrameB->createChild("c");
+    auto *pFrameD = pRootFrame->createChild("d");
+    auto *pFrameE = pFrameD->createChild("e");
+    for (auto *pFrame : { pFrameA, pFrameB, pFrameC, pFrameD, pFrameE })
+    {
+        pFrame->setAcceleration(uniform(generator), uniform(generator), uniform(generator));
+        pFrame->setOrientation(30.0 * uniform(generator), 30.0 * uniform(generator), 90.0 * uniform(generator));
+        pFrame->setOrigin(100.0 * uniform(generator), 100.0 * uniform(generator), 100.0 * uniform(generator));
+        pFrame->setRotationalAccelerations(uniform(generator), uniform(generator), uniform(generator));
+        pFrame->setRotationalRates(5.0 * uniform(generator), 5.0 * uniform(generator), 5.0 * uniform(generator));
+        pFrame->setVelocity(10.0 * uniform(generator), 10.0 * uniform(generator), 10.0 * uniform(generator));
+    }
+
+    // the motion states and transformations must be destroyed before the frames are deleted
+    auto &&test = [&] (void)
+    {
+        CartesianMotionState motionState;
+        motionState.setFrame(pFrameC);
+        motionState.setAcceleration(uniform(generator), uniform(generator), uniform(generator));
+        motionState.setEulerAccelerations(uniform(generator), uniform(generator), uniform(generator));
+        motionState.setEulerRates(5.0 * uniform(generator), 5.0 * uniform(generator), 5.0 * uniform(generator));
+        motionState.setEulers(20.0 * uniform(generator), 20.0 * uniform(generator), 60.0 * uniform(generator));
+        motionState.setPosition(100.0 * uniform(generator), 100.0 * uniform(generator), 100.0 * uniform(generator));
+        motionState.setVelocity(10.0 * uniform(generator), 10.0 * uniform(generator), 10.0 * uniform(generator));
+
+        // compare the compiled transformation with the frame-by-frame transformation
+        auto &&compare = [&motionState] (CompositeFrameTransform &transform, ReferenceFrame *pDestinationFrame)
+        {
+            CartesianMotionState expected(motionState), actual(motionState);
+            pDestinationFrame->transformToFrame(&expected, false);
+
+            return transform.apply(&actual) && actual.getFrame() == pDestinationFrame &&
+                   actual.isEqual(expected, 1.0e-8);
+        };
+
+        CompositeFrameTransform transformCtoE(pFrameC, pFrameE);
+        CompositeFrameTransform transformEtoC(pFrameE, pFrameC);
+        CompositeFrameTransform transformCtoRoot(pFrameC, pRootFrame);
+        CompositeFrameTransform transformRootToC(pRootFrame, pFrameC);
+        bool bSuccess = compare(transformCtoE, pFrameE) && transformCtoE.getPathLength() == 5 &&
+                        compare(transformCtoRoot, pRootFrame) && transformCtoRoot.getPathLength() == 3;
+
+        motionState.setFrame(pFrameE);
+        bSuccess &= compare(transformEtoC, pFrameC);
+        motionState.setFrame(pRootFrame);
+        bSuccess &= compare(transformRootToC, pFrameC);
+        std::cout << "Compiled transformation " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+        if (!bSuccess)
+            return bSuccess;
+
+        // modifying a frame on the path must invalidate the compiled transformation
+        motionState.setFrame(pFrameC);
+        pFrameB->setOrigin(1.0, 2.0, 3.0);
+        bSuccess = !transformCtoE.isValid() && compare(transformCtoE, pFrameE) && transformCtoE.isValid();
+        pFrameD->setRotationalRates(1.0, 2.0, 3.0);
+        bSuccess &= !transformCtoE.isValid() && compare(transformCtoE, pFrameE);
+
+        // re-parenting a frame on the path must invalidate the compiled transformation
+        auto *pFrameF = pRootFrame->createChild("f");
+        pFrameF->setOrigin(5.0, 6.0, 7.0);
+        pFrameF->setOrientation(10.0, 20.0, 30.0);
+        pFrameD->setParent(pFrameF);
+        bSuccess &= !transformCtoE.isValid() && compare(transformCtoE, pFrameE) &&
+                    transformCtoE.getPathLength() == 6;
+        std::cout << "Invalidation " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+        if (!bSuccess)
+            return bSuccess;
+
+        // spherical motion states and temporal transformations
+        SphericalMotionState sphericalMotionState(motionState), expected(sphericalMotionState);
+        pFrameE->transformToFrame(&expected, false);
+        bSuccess = transformCtoE.apply(&sphericalMotionState) && sphericalMotionState.isSpherical() &&
+                   sphericalMotionState.isEqual(expected, 1.0e-8);
+
+        CartesianMotionState temporalMotionState(motionState), temporalExpected(motionState);
+        CompositeFrameTransform temporalTransform(pFrameC, pFrameE, 2.5);
+        pFrameE->transformToFrame(&temporalExpected, 2.5);
+        bSuccess &= temporalTransform.apply(&temporalMotionState) && temporalMotionState.getTime() == 2.5 &&
+                    temporalMotionState.isEqual(temporalExpected, 1.0e-8);
+        std::cout << "Spherical and temporal transformations " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+                  << std::endl;
+        if (!bSuccess)
+            return bSuccess;
+
+        // batch transformations of motion states (including a spherical motion state and a motion state defined
+        // in a frame other than the source frame, which are transformed individually), split across threads
+        const std::size_t numStates = 5000;
+        std::vector<CartesianMotionState> batch(numStates, motionState), batchExpected;
+        for (auto &&state : batch)
+        {
+            state.setPosition(100.0 * uniform(generator), 100.0 * uniform(generator), 100.0 * uniform(generator));
+            state.setEulers(20.0 * uniform(generator), 20.0 * uniform(generator), 60.0 * uniform(generator));
+        }
+
+        batch[1].setFrame(pFrameA);
+        batchExpected = batch;
+        for (auto &&state : batchExpected)
+            pFrameE->transformToFrame(&state, false);
+
+        SphericalMotionState sphericalBatchState(motionState), sphericalBatchExpected(motionState);
+        pFrameE->transformToFrame(&sphericalBatchExpected, false);
+
+        std::vector<MotionState *> motionStates;
+        for (auto &&state : batch)
+            motionStates.push_back(&state);
+
+        motionStates.push_back(&sphericalBatchState);
+        transformCtoE.setMaximumThreads(4);
+        bSuccess = transformCtoE.apply(motionStates) && sphericalBatchState.isSpherical() &&
+                   sphericalBatchState.isEqual(sphericalBatchExpected, 1.0e-8);
+        for (std::size_t i = 0; bSuccess && i < numStates; ++i)
+            bSuccess = batch[i].getFrame() == pFrameE && batch[i].isEqual(batchExpected[i], 1.0e-8);
+
+        // batch transformations of positions, velocities and accelerations stored in structure-of-arrays form
+        std::vector<double> components[9];
+        for (auto &&component : components)
+            component.resize(numStates);
+
+        for (std::size_t i = 0; i < numStates; ++i)
+        {
+            CartesianMotionState state(motionState);
+            state.setPosition(100.0 * uniform(generator), 100.0 * uniform(generator), 100.0 * uniform(generator));
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                components[j][i] = state[StateDerivativeType::Position][j];
+                components[3 + j][i] = state[StateDerivativeType::Velocity][j];
+                components[6 + j][i] = state[StateDerivativeType::Acceleration][j];
+            }
+
+            batch[i] = state;
+        }
+
+        double *const position[] = { components[0].data(), components[1].data(), components[2].data() };
+        double *const velocity[] = { components[3].data(), components[4].data(), components[5].data() };
+        double *const acceleration[] = { components[6].data(), components[7].data(), components[8].data() };
+        bSuccess &= transformCtoE.apply(numStates, position, velocity, acceleration) &&
+                    !transformCtoE.apply(numStates, position, nullptr, acceleration);
+        for (std::size_t i = 0; bSuccess && i < numStates; ++i)
+        {
+            pFrameE->transformToFrame(&batch[i], false);
+            for (std::size_t j = 0; bSuccess && j < 3; ++j)
+            {
+                bSuccess = std::fabs(components[j][i] - batch[i][StateDerivativeType::Position][j]) < 1.0e-8 &&
+                           std::fabs(components[3 + j][i] - batch[i][StateDerivativeType::Velocity][j]) < 1.0e-8 &&
+                           std::fabs(components[6 + j][i] - batch[i][StateDerivativeType::Acceleration][j]) < 1.0e-8;
+            }
+        }
+
+        std::cout << "Batch transformations " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+
+        return bSuccess;
+    };
+
+    bool bSuccess = test();
+    ReferenceFrame::deleteFrame(pRootFrame);
+
+    return bSuccess;
+}
+
+}
@@ -0,0 +1,82 @@
+#ifndef TEST_COMPOSITE_FRAME_TRANSFORM_H
+#define TEST_COMPOSITE_FRAME_TRANSFORM_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for CompositeFrameTransform class
+ */
+class CompositeFrameTransformUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    CompositeFrameTransformUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    CompositeFrameTransformUnitTest(const CompositeFrameTransformUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    CompositeFrameTransformUnitTest(CompositeFrameTransformUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~CompositeFrameTransformUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    CompositeFrameTransformUnitTest &operator = (const CompositeFrameTransformUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    CompositeFrameTransformUnitTest &operator = (CompositeFrameTransformUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static CompositeFrameTransformUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "CompositeFrameTransformTest";
+    }
+};
+
+}
+
+#endif
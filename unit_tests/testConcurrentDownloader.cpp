@@ -0,0 +1,249 @@
+#include "concurrentDownloader.h"
+#include "connectionPool.h"
+#include "downloaderPreferences.h"
+#include "priorityPublisher.h"
+#include "testConcurrentDownloader.h"
+#include "unitTestManager.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
+#define POSIX
+#endif
+
+#ifdef POSIX
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace messaging;
+using namespace networking;
+using namespace networking::sockets;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testConcurrentDownloader",
+                                                    &ConcurrentDownloaderUnitTest::create);
+
+/**
+ * Function to generate the body of the resource with the specified index; bodies vary in length and contain
+ * embedded null characters
+ */
+static std::string generateBody(std::size_t index)
+{
+    std::string body(1000 + (index * 7919) % 60000, '\0');
+    for (std::size_t i = 0; i < body.size(); ++i)
+        body[i] = char((index + i) % 251);
+
+    return body;
+}
+
+/**
+ * Function to generate the response to a request for the resource with the specified index. Odd-numbered
+ * resources are sent with chunked transfer encoding, even-numbered resources with a Content-Length header
+ * @param index  the index of the requested resource
+ * @param bClose flag indicating whether the response asks the client to close the connection
+ */
+static std::string generateResponse(std::size_t index,
+                                    bool bClose)
+{
+    auto &&body = generateBody(index);
+    std::string response = "HTTP/1.1 200 OK\r\nConnection: " + std::string(bClose ? "close" : "keep-alive") +
+                           "\r\n";
+    if (index % 2 == 0)
+        return response + "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+
+    response += "Transfer-Encoding: chunked\r\n\r\n";
+    const std::size_t chunkSize = 4096;
+    for (std::size_t i = 0; i < body.size(); i += chunkSize)
+    {
+        auto &&chunk = body.substr(i, chunkSize);
+        char size[16];
+        std::snprintf(size, sizeof(size), "%zx", chunk.size());
+        response += std::string(size) + "\r\n" + chunk + "\r\n";
+    }
+
+    return response + "0\r\n\r\n";
+}
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+ConcurrentDownloaderUnitTest::ConcurrentDownloaderUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+ConcurrentDownloaderUnitTest *ConcurrentDownloaderUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    ConcurrentDownloaderUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new ConcurrentDownloaderUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool ConcurrentDownloaderUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for ConcurrentDownloader class..." << std::endl << std::endl;
+
+    bool bSuccess = true;
+#ifdef POSIX
+    // listen on an ephemeral loopback port
+    int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addressLength = sizeof(address);
+    bSuccess = (listener >= 0 &&
+                ::bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0 &&
+                ::listen(listener, 64) == 0 &&
+                ::getsockname(listener, reinterpret_cast<sockaddr *>(&address), &addressLength) == 0);
+    if (!bSuccess)
+    {
+        std::cout << "Loopback listener FAILED." << std::endl << std::endl;
+        if (listener >= 0)
+            ::close(listener);
+
+        return bSuccess;
+    }
+
+    // a minimal keep-alive HTTP server, which answers the pipelined requests received on each connection (of
+    // the form GET /<index>) with a single write per read, and closes a connection after a response that
+    // carries "Connection: close"
+    const std::size_t closeInterval = 50;
+    std::atomic<std::size_t> numAccepted(0);
+    std::mutex mutex;
+    std::vector<std::thread> connectionThreads;
+    std::thread server([&] (void)
+    {
+        int connection;
+        while ((connection = ::accept(listener, nullptr, nullptr)) >= 0)
+        {
+            ++numAccepted;
+            std::lock_guard<std::mutex> lock(mutex);
+            connectionThreads.emplace_back([connection] (void)
+            {
+                bool bClose = false;
+                char buffer[16384];
+                std::string requests;
+                long result;
+                while (!bClose && (result = ::recv(connection, buffer, sizeof(buffer), 0)) > 0)
+                {
+                    requests.append(buffer, std::size_t(result));
+
+                    std::string responses;
+                    std::size_t requestEnd;
+                    while (!bClose && (requestEnd = requests.find("\r\n\r\n")) != std::string::npos)
+                    {
+                        auto &&index = std::stoul(requests.substr(requests.find('/') + 1));
+                        bClose = (index % closeInterval == closeInterval - 1);
+                        responses += generateResponse(index, bClose);
+                        requests.erase(0, requestEnd + 4);
+                    }
+
+                    for (std::size_t offset = 0; offset < responses.size(); offset += std::size_t(result))
+                    {
+                        result = ::send(connection, responses.data() + offset, responses.size() - offset,
+                                        MSG_NOSIGNAL);
+                        if (result <= 0)
+                            break;
+                    }
+                }
+
+                // requests which remain unanswered are drained before closing, so that the client receives the
+                // final response rather than a connection reset
+                ::shutdown(connection, SHUT_WR);
+                while (::recv(connection, buffer, sizeof(buffer), 0) > 0);
+                ::close(connection);
+            });
+        }
+    });
+
+    PriorityPublisher publisher;
+    std::unique_ptr<DownloaderPreferences> pDownloaderPreferences(DownloaderPreferences::create(&publisher));
+    pDownloaderPreferences->keepSocketConnectionAlive(true);
+    pDownloaderPreferences->setServerReceiveTimeout(5000);
+
+    const std::size_t maxConnectionsPerHost = 4, numRequests = 1000;
+    std::unique_ptr<ConcurrentDownloader> pDownloader(ConcurrentDownloader::create(pDownloaderPreferences.get()));
+    pDownloader->setMaximumConnectionsPerHost(maxConnectionsPerHost);
+    pDownloader->setPipelineDepth(8);
+
+    const std::string url = "http://127.0.0.1:" + std::to_string(ntohs(address.sin_port)) + "/";
+    std::vector<std::string> urls;
+    for (std::size_t i = 0; i < numRequests; ++i)
+        urls.push_back(url + std::to_string(i));
+
+    // download the batch, verifying that connections are reused across the server-initiated closes
+    std::vector<std::string> data;
+    auto &&start = std::chrono::steady_clock::now();
+    bSuccess = pDownloader->download(urls, data);
+    auto &&elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::size_t numBytes = 0;
+    for (std::size_t i = 0; bSuccess && i < numRequests; ++i)
+    {
+        bSuccess = (data[i] == generateBody(i));
+        numBytes += data[i].size();
+    }
+
+    std::size_t numAcceptedBatch = numAccepted;
+    bSuccess &= (numAcceptedBatch <= numRequests / closeInterval + maxConnectionsPerHost);
+    std::cout << "Downloaded " << numRequests << " resources (" << numBytes << " bytes) over "
+              << numAcceptedBatch << " connections in " << elapsed << " s (" << numBytes / elapsed / 1048576.0
+              << " MiB/s) " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+
+    // a subsequent download should be served by the idle connections retained in the pool
+    if (bSuccess)
+    {
+        auto &&numIdleConnections = pDownloader->getConnectionPool()->getNumIdleConnections();
+        bSuccess = (numIdleConnections > 0);
+        urls.resize(closeInterval - 1);
+        bSuccess = bSuccess && pDownloader->download(urls, data);
+        for (std::size_t i = 0; bSuccess && i < urls.size(); ++i)
+            bSuccess = (data[i] == generateBody(i));
+
+        bSuccess &= (numAccepted - numAcceptedBatch <= maxConnectionsPerHost -
+                     std::min(numIdleConnections, maxConnectionsPerHost));
+        std::cout << "Pooled connection reuse " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    }
+
+    // closing the pooled connections allows the server's connection threads to finish
+    pDownloader.reset();
+    ::shutdown(listener, SHUT_RDWR);
+    server.join();
+    for (auto &&connectionThread : connectionThreads)
+        connectionThread.join();
+
+    ::close(listener);
+#endif
+
+    return bSuccess;
+}
+
+}
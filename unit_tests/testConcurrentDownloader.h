@@ -0,0 +1,82 @@
+#ifndef TEST_CONCURRENT_DOWNLOADER_H
+#define TEST_CONCURRENT_DOWNLOADER_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for ConcurrentDownloader class
+ */
+class ConcurrentDownloaderUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    ConcurrentDownloaderUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    ConcurrentDownloaderUnitTest(const ConcurrentDownloaderUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    ConcurrentDownloaderUnitTest(ConcurrentDownloaderUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~ConcurrentDownloaderUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    ConcurrentDownloaderUnitTest &operator = (const ConcurrentDownloaderUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    ConcurrentDownloaderUnitTest &operator = (ConcurrentDownloaderUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static ConcurrentDownloaderUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "ConcurrentDownloaderTest";
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,187 @@
+#include "csv_tokenizer.h"
+#include "memory_mapped_file.h"
+#include "testCsvTokenizer.h"
+#include "unitTestManager.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace messaging;
+using namespace utilities;
+using namespace utilities::file_system;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testCsvTokenizer", &CsvTokenizerUnitTest::create);
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+CsvTokenizerUnitTest::CsvTokenizerUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+CsvTokenizerUnitTest *CsvTokenizerUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    CsvTokenizerUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new CsvTokenizerUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool CsvTokenizerUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for CsvTokenizer class..." << std::endl << std::endl;
+
+    // quoted fields may contain commas, newlines and escaped quotation marks
+    const std::string table = "name, value,note\r\n"
+                              "alpha, 1.5,\"a, b\"\r\n"
+                              "\n"
+                              "\"be\"\"ta\",-2,\"line one\nline two\"\n"
+                              "gamma,,last";
+    const std::vector<std::vector<std::string>> expected = { { "name", "value", "note" },
+                                                             { "alpha", "1.5", "a, b" },
+                                                             { "be\"ta", "-2", "line one\nline two" },
+                                                             { "gamma", "last" } };
+    CsvTokenizer tokenizer(true, true, true);
+    std::vector<std::vector<std::string>> rows;
+    auto &&collect = [&rows] (const std::vector<std::string_view> &fields)
+    {
+        rows.emplace_back(fields.cbegin(), fields.cend());
+
+        return true;
+    };
+
+    bool bSuccess = (tokenizer.forEachRow(std::string_view(table), collect) && rows == expected);
+
+    // streams yield the same rows regardless of where chunk boundaries fall
+    for (std::size_t chunkSize = 1; bSuccess && chunkSize <= table.size() + 1; ++chunkSize)
+    {
+        rows.clear();
+        std::istringstream stream(table);
+        bSuccess = (tokenizer.forEachRow(stream, collect, chunkSize) && rows == expected);
+    }
+
+    // the function object may terminate parsing
+    rows.clear();
+    bSuccess &= (!tokenizer.forEachRow(std::string_view(table), [&rows] (auto &&fields)
+                                       { rows.emplace_back(fields.cbegin(), fields.cend()); return false; }) &&
+                 rows.size() == 1);
+
+    // ranges begin at rows, never within a quoted field
+    auto &&ranges = CsvTokenizer::partition(table, 8);
+    std::string joined;
+    for (auto &&range : ranges)
+    {
+        bSuccess &= (range.data() == table.data() || range.data()[-1] == '\n');
+        joined.append(range);
+    }
+
+    bSuccess &= (joined == table && ranges.size() > 1 &&
+                 std::none_of(ranges.cbegin(), ranges.cend(), [] (auto &&range)
+                              { return range.substr(0, 8) == "line two"; }));
+
+    // the rows counted within each range exclude blank rows
+    bSuccess &= (std::accumulate(ranges.cbegin(), ranges.cend(), std::size_t(0), [] (std::size_t numRows,
+                                                                                     auto &&range)
+                                 { return numRows + CsvTokenizer::countRows(range); }) == expected.size());
+    std::cout << "Row parsing of buffers and streams " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // write a large table of truth data, in which every hundredth row contains a quoted field that spans lines
+    const std::string filename = "testCsvTokenizer.csv";
+    const std::size_t numRows = 200000;
+    {
+        std::ofstream stream(filename, std::ios::binary);
+        stream.precision(17);
+        stream << "time,x,y,label" << std::endl;
+        for (std::size_t i = 0; i < numRows; ++i)
+        {
+            stream << 0.01 * double(i) << ',' << std::sin(0.001 * double(i)) << ',' << -double(i) << ',';
+            if (i % 100 == 0)
+                stream << "\"target,\n" << i << "\"\n";
+            else
+                stream << "target" << i << '\n';
+        }
+    }
+
+    MemoryMappedFile file(filename);
+    bSuccess = (file.isOpen() && file.getSize() > 0 && !MemoryMappedFile("missing.csv").isOpen());
+
+    // the conventional approach tokenizes each row into strings and converts the fields of interest
+    auto &&start = std::chrono::steady_clock::now();
+    auto &&tokensTable = CsvTokenizer().parseTable(std::ifstream(filename));
+    std::vector<double> times, ys;
+    for (std::size_t i = 1; i < tokensTable.size(); ++i)
+    {
+        if (tokensTable[i].size() >= 3)
+        {
+            times.push_back(std::stod(tokensTable[i][0]));
+            ys.push_back(std::stod(tokensTable[i][2]));
+        }
+    }
+
+    auto &&tableTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // convert the same columns from the mapped file, using one and several threads
+    std::vector<std::vector<double>> columns, parallelColumns;
+    start = std::chrono::steady_clock::now();
+    bSuccess &= tokenizer.parseColumns(file.getView(), { 0, 2 }, columns, 1);
+    auto &&serialTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    bSuccess &= tokenizer.parseColumns(file.getView(), { 0, 2 }, parallelColumns, 1, 4);
+    auto &&parallelTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    bSuccess &= (columns.size() == 2 && columns[0].size() == numRows && parallelColumns == columns);
+    for (std::size_t i = 0; bSuccess && i < numRows; ++i)
+        bSuccess = (columns[0][i] == 0.01 * double(i) && columns[1][i] == -double(i));
+
+    // the quoted fields which span lines are intact, and missing fields are reported
+    std::vector<std::vector<int>> labels;
+    std::size_t numRowsVisited = 0;
+    bSuccess &= (!tokenizer.parseColumns(file.getView(), { 2, 7 }, labels, 1, 4) && labels.size() == 2 &&
+                 labels[0].size() == numRows && labels[0][numRows - 1] == 1 - int(numRows) &&
+                 labels[1][0] == 0 && tokenizer.forEachRow(file.getView(), [&] (auto &&fields)
+                 {
+                     auto &&i = numRowsVisited++;
+                     return i == 0 || (fields.size() == 4 &&
+                                       ((i - 1) % 100 != 0 || fields[3] == "target,\n" + std::to_string(i - 1)));
+                 }) && numRowsVisited == numRows + 1 && times.size() == numRows);
+
+    file.close();
+    std::remove(filename.c_str());
+    std::cout << "Column conversion (row tokenization " << 1.0e9 * tableTime / numRows << " ns, mapped "
+              << 1.0e9 * serialTime / numRows << " ns, mapped with four threads "
+              << 1.0e9 * parallelTime / numRows << " ns per row) " << (bSuccess ? "PASSED." : "FAILED.")
+              << std::endl << std::endl;
+
+    return bSuccess;
+}
+
+}
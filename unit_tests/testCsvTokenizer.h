@@ -0,0 +1,82 @@
+#ifndef TEST_CSV_TOKENIZER_H
+#define TEST_CSV_TOKENIZER_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for CsvTokenizer class
+ */
+class CsvTokenizerUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    CsvTokenizerUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    CsvTokenizerUnitTest(const CsvTokenizerUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    CsvTokenizerUnitTest(CsvTokenizerUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~CsvTokenizerUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    CsvTokenizerUnitTest &operator = (const CsvTokenizerUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    CsvTokenizerUnitTest &operator = (CsvTokenizerUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static CsvTokenizerUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "CsvTokenizerTest";
+    }
+};
+
+}
+
+#endif
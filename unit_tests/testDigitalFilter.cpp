@@ -0,0 +1,317 @@
+#include "digital_filter.h"
+#include "math_constants.h"
+#include "testDigitalFilter.h"
+#include "unitTestManager.h"
+#include "unitTestUtilities.h"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace math;
+using namespace math::signal_processing::filters;
+using namespace messaging;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testDigitalFilter", &DigitalFilterUnitTest::create);
+
+/**
+ * Design the second-order sections of an even-order Butterworth low-pass filter
+ * @param order  the order of the filter
+ * @param cutoff the cutoff frequency as a fraction of the sampling frequency
+ */
+static std::vector<double> designButterworth(std::size_t order, double cutoff)
+{
+    std::vector<double> sections;
+    auto &&w0 = 2.0 * PI * cutoff;
+    for (std::size_t k = 1; k <= order / 2; ++k)
+    {
+        auto &&q = 0.5 / std::sin((2.0 * k - 1.0) * PI / (2.0 * order));
+        auto &&alpha = std::sin(w0) / (2.0 * q);
+        auto &&c = std::cos(w0);
+        sections.insert(sections.end(), { 0.5 * (1.0 - c), 1.0 - c, 0.5 * (1.0 - c),
+                                          1.0 + alpha, -2.0 * c, 1.0 - alpha });
+    }
+
+    return sections;
+}
+
+/**
+ * Filter a signal through each second-order section in turn with separate direct-form filters
+ */
+static std::vector<double> filterCascade(const std::vector<double> &sections, const std::vector<double> &x)
+{
+    std::vector<double> y(x);
+    for (std::size_t s = 0; s < sections.size() / 6; ++s)
+    {
+        DigitalFilter<double> filter({ sections[6 * s + 3], sections[6 * s + 4], sections[6 * s + 5] },
+                                     { sections[6 * s + 0], sections[6 * s + 1], sections[6 * s + 2] });
+        filter.filter(y, y);
+    }
+
+    return y;
+}
+
+/**
+ * Filter the channels of an interleaved signal together, in two calls and in the given layout, and compute the
+ * largest absolute difference from filtering each channel separately
+ */
+static double computeMultiChannelError(DigitalFilter<double> &filter, const std::vector<double> &x,
+                                       std::size_t numChannels, bool bPlanar, bool bZeroPhase)
+{
+    auto &&layout = bPlanar ? DigitalFilter<double>::ChannelLayout::Planar
+                            : DigitalFilter<double>::ChannelLayout::Interleaved;
+    auto &&numFrames = x.size() / numChannels;
+    auto &&channel = [=] (std::size_t i, std::size_t k) { return bPlanar ? k * numFrames + i
+                                                                         : i * numChannels + k; };
+    std::vector<double> y(x.size());
+    for (std::size_t i = 0; i < numFrames; ++i)
+        for (std::size_t k = 0; k < numChannels; ++k)
+            y[channel(i, k)] = x[i * numChannels + k];
+
+    filter.clearDelays();
+    if (bZeroPhase && !filter.filtfilt(&y[0], &y[0] + y.size(), &y[0], numChannels, layout))
+        return INFINITY;
+    else if (!bZeroPhase && bPlanar && !filter.filter(&y[0], &y[0] + y.size(), &y[0], numChannels, layout))
+        return INFINITY;
+    else if (!bZeroPhase && !bPlanar)
+    {
+        // the delays of each channel are retained between calls
+        auto &&split = (numFrames / 3) * numChannels;
+        if (!filter.filter(&y[0], &y[0] + split, &y[0], numChannels) ||
+            !filter.filter(&y[split], &y[0] + y.size(), &y[split], numChannels))
+            return INFINITY;
+    }
+
+    double error = 0.0;
+    std::vector<double> expected(numFrames);
+    for (std::size_t k = 0; k < numChannels; ++k)
+    {
+        for (std::size_t i = 0; i < numFrames; ++i)
+            expected[i] = x[i * numChannels + k];
+
+        filter.clearDelays();
+        if (!(bZeroPhase ? filter.filtfilt(expected, expected) : filter.filter(expected, expected)))
+            return INFINITY;
+
+        for (std::size_t i = 0; i < numFrames; ++i)
+            error = std::max(error, std::fabs(y[channel(i, k)] - expected[i]));
+    }
+
+    return error;
+}
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+DigitalFilterUnitTest::DigitalFilterUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+DigitalFilterUnitTest *DigitalFilterUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    DigitalFilterUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new DigitalFilterUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool DigitalFilterUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for DigitalFilter class..." << std::endl << std::endl;
+
+    std::default_random_engine generator;
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::vector<double> x(12000);
+    std::generate(x.begin(), x.end(), [&] () { return uniform(generator); });
+
+    // a cascade set from second-order sections agrees with filtering through each section in turn, and its
+    // direct-form coefficients agree with the cascade for a well-conditioned filter
+    DigitalFilter<double> filter;
+    auto &&sections = designButterworth(6, 0.1);
+    auto &&expected = filterCascade(sections, x);
+    std::vector<double> a, b, y;
+    bool bSuccess = (filter.setSecondOrderSections(sections) && filter.usesSecondOrderSections() &&
+                     filter.getOrder() == 6 && filter.filter(x, y) && computeMaximumError(y, expected) < 1.0e-12);
+
+    filter.getCoefficients(a, b);
+    DigitalFilter<double> direct(a, b);
+    bSuccess &= (!direct.usesSecondOrderSections() && direct.filter(x, y) &&
+                 computeMaximumError(y, expected) < 1.0e-9);
+
+    // decomposing the direct form recovers an equivalent cascade, as it does for FIR filters and filters that
+    // delay their input
+    bSuccess &= (direct.convertToSecondOrderSections() && direct.usesSecondOrderSections() &&
+                 direct.filter(x, y) && computeMaximumError(y, expected) < 1.0e-9);
+    for (auto &&coefficients : std::vector<std::vector<std::vector<double>>>({
+                                   { { 1.0 }, { 0.2, 0.5, -0.3, 0.1, 0.4 } },
+                                   { { 1.0, -0.9, 0.2 }, { 0.0, 0.0, 0.5, 0.25 } },
+                                   { { 2.0 }, { 3.0 } } }))
+    {
+        DigitalFilter<double> reference(coefficients[0], coefficients[1]), cascade(reference);
+        std::vector<double> z;
+        bSuccess &= (reference.filter(x, y) && cascade.convertToSecondOrderSections() && cascade.filter(x, z) &&
+                     computeMaximumError(y, z) < 1.0e-12);
+    }
+
+    // the delays of a cascade hold the state of each section, so that another cascade can resume filtering
+    // where the first left off
+    auto &&half = x.size() / 2;
+    std::vector<double> delays, z;
+    DigitalFilter<double> resumed;
+    bSuccess &= (filter.setSecondOrderSections(sections) &&
+                 filter.filter(std::vector<double>(x.cbegin(), x.cbegin() + half), y));
+    filter.getDelays(delays);
+    bSuccess &= (delays.size() == sections.size() / 3 && delays == filter.getDelays() &&
+                 resumed.setSecondOrderSections(sections) && resumed.setDelays(delays) &&
+                 resumed.filter(std::vector<double>(x.cbegin() + half, x.cend()), z) &&
+                 computeMaximumError(z, std::vector<double>(expected.cbegin() + half, expected.cend())) < 1.0e-12);
+
+    std::cout << "Second-order sections " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // a high-order, narrow-band filter is unstable in direct form, but not as a cascade
+    sections = designButterworth(16, 0.005);
+    expected = filterCascade(sections, x);
+    bSuccess = (filter.setSecondOrderSections(sections) && filter.filter(x, y) &&
+                computeMaximumError(y, expected) < 1.0e-12);
+
+    auto &&cascadeError = computeMaximumError(y, expected);
+    filter.getCoefficients(a, b);
+    direct.setCoefficients(a, b);
+    direct.filter(x, y);
+    auto &&directError = computeMaximumError(y, expected);
+    bSuccess &= !(directError < 1.0);
+    std::cout << "16th-order filter error in direct form: " << directError << ", as a cascade: " << cascadeError
+              << std::endl << std::endl;
+
+    // an 8th-order filter decomposed from its direct form is as accurate as the direct form
+    sections = designButterworth(8, 0.02);
+    expected = filterCascade(sections, x);
+    filter.setSecondOrderSections(sections);
+    filter.getCoefficients(a, b);
+    direct.setCoefficients(a, b);
+    direct.clearDelays();
+    direct.filter(x, y);
+    directError = computeMaximumError(y, expected);
+    bSuccess &= (direct.convertToSecondOrderSections() && direct.filter(x, y) &&
+                 computeMaximumError(y, expected) < 1.0e1 * directError + 1.0e-12);
+    std::cout << "High-order filters " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // interleaved and planar channels filtered together agree with filtering each channel separately, in direct
+    // form and as a cascade, with and without zero-phase filtering
+    const std::size_t numChannels = 12;
+    direct.setCoefficients({ 1.0, -1.2, 0.8, -0.2 }, { 0.1, 0.3, 0.3, 0.1 });
+    filter.setSecondOrderSections(designButterworth(4, 0.05));
+    for (auto *pFilter : { &direct, &filter })
+    {
+        for (int mode = 0; mode < 4; ++mode)
+        {
+            bSuccess &= (computeMultiChannelError(*pFilter, x, numChannels, (mode & 1) != 0, (mode & 2) != 0) <
+                         1.0e-12);
+        }
+    }
+
+    std::vector<double> frame(numChannels + 1);
+    bSuccess &= !filter.filter(&frame[0], &frame[0] + frame.size(), &frame[0], numChannels);
+    std::cout << "Multi-channel filtering " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // zero-phase filtering of a constant yields the constant scaled by the squared DC gain from the first
+    // sample, and a slow sinusoid in the pass band passes without the lag that forward filtering introduces
+    // (away from the ends of the signal, where the reflected extension departs from the sinusoid)
+    std::vector<double> constant(500, 3.0), sinusoid(2000);
+    for (std::size_t i = 0; i < sinusoid.size(); ++i)
+        sinusoid[i] = std::sin(2.0 * PI * 0.002 * i);
+
+    for (auto *pFilter : { &direct, &filter })
+    {
+        pFilter->getCoefficients(a, b);
+        auto &&gain = std::accumulate(b.cbegin(), b.cend(), 0.0) / std::accumulate(a.cbegin(), a.cend(), 0.0);
+        expected.assign(constant.size(), 3.0 * gain * gain);
+        bSuccess &= (pFilter->filtfilt(constant, y) && computeMaximumError(y, expected) < 1.0e-10);
+    }
+
+    auto &&computeInteriorError = [&] (const std::vector<double> &y)
+    {
+        return computeMaximumError(std::vector<double>(y.cbegin() + 100, y.cend() - 100),
+                                   std::vector<double>(sinusoid.cbegin() + 100, sinusoid.cend() - 100));
+    };
+
+    bSuccess &= (filter.filtfilt(sinusoid, y) && computeInteriorError(y) < 1.0e-4);
+    filter.clearDelays();
+    bSuccess &= (filter.filter(sinusoid, y) && computeInteriorError(y) > 1.0e-2);
+    std::cout << "Zero-phase filtering " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // measure the throughput of filtering channels one at a time and together
+    x.resize(256 * 1000);
+    std::generate(x.begin(), x.end(), [&] () { return uniform(generator); });
+    filter.setSecondOrderSections(designButterworth(8, 0.1));
+    std::cout << std::setw(15) << "Channels" << std::setw(25) << "Separate (samples/s)" << std::setw(25)
+              << "Together (samples/s)" << std::endl;
+    for (std::size_t numChannels : { 1, 16, 256 })
+    {
+        double throughput[2];
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            std::size_t numSamples = 0;
+            auto &&start = std::chrono::steady_clock::now();
+            std::chrono::duration<double> elapsed(0.0);
+            while (elapsed.count() < 0.05)
+            {
+                auto &&numFrames = x.size() / numChannels;
+                if (i == 0)
+                {
+                    for (std::size_t k = 0; k < numChannels; ++k)
+                        filter.filter(&x[k * numFrames], &x[k * numFrames] + numFrames, &x[k * numFrames]);
+                }
+                else
+                    filter.filter(&x[0], &x[0] + x.size(), &x[0], numChannels);
+
+                numSamples += x.size();
+                elapsed = std::chrono::steady_clock::now() - start;
+            }
+
+            throughput[i] = double(numSamples) / elapsed.count();
+        }
+
+        std::cout << std::setw(15) << numChannels << std::setw(25) << throughput[0] << std::setw(25)
+                  << throughput[1] << std::endl;
+    }
+
+    std::cout << std::endl;
+
+    return bSuccess;
+}
+
+}
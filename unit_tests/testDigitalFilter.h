@@ -0,0 +1,82 @@
+#ifndef TEST_DIGITAL_FILTER_H
+#define TEST_DIGITAL_FILTER_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for DigitalFilter class
+ */
+class DigitalFilterUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    DigitalFilterUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    DigitalFilterUnitTest(const DigitalFilterUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    DigitalFilterUnitTest(DigitalFilterUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~DigitalFilterUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    DigitalFilterUnitTest &operator = (const DigitalFilterUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    DigitalFilterUnitTest &operator = (DigitalFilterUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static DigitalFilterUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "DigitalFilterTest";
+    }
+};
+
+}
+
+#endif
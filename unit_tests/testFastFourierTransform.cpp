@@ -0,0 +1,205 @@
+#include "fast_fourier_transform.h"
+#include "math_constants.h"
+#include "sequence_convolver.h"
+#include "testFastFourierTransform.h"
+#include "unitTestManager.h"
+#include "unitTestUtilities.h"
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace math::signal_processing;
+using namespace messaging;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testFastFourierTransform",
+                                                    &FastFourierTransformUnitTest::create);
+
+/**
+ * Compute the discrete Fourier transform of a sequence by definition
+ */
+static std::vector<std::complex<double>> computeDft(const std::vector<std::complex<double>> &x)
+{
+    auto &&size = x.size();
+    std::vector<std::complex<double>> spectrum(size);
+    for (std::size_t k = 0; k < size; ++k)
+        for (std::size_t n = 0; n < size; ++n)
+            spectrum[k] += x[n] * std::polar(1.0, -2.0 * math::PI * double(k * n % size) / double(size));
+
+    return spectrum;
+}
+
+/**
+ * Measure the average time in seconds taken to convolve two sequences
+ */
+static double timeConvolution(SequenceConvolver<double> &sequenceConvolver, const std::vector<double> &x,
+                              const std::vector<double> &h, std::vector<double> &y)
+{
+    std::size_t numRepetitions = 0;
+    auto &&start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed(0.0);
+    while (elapsed.count() < 0.02)
+    {
+        std::fill(y.begin(), y.end(), 0.0);
+        sequenceConvolver.convolve(x, h, y);
+        elapsed = std::chrono::steady_clock::now() - start;
+        ++numRepetitions;
+    }
+
+    return elapsed.count() / double(numRepetitions);
+}
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+FastFourierTransformUnitTest::FastFourierTransformUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+FastFourierTransformUnitTest *FastFourierTransformUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    FastFourierTransformUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new FastFourierTransformUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool FastFourierTransformUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for FastFourierTransform class..." << std::endl << std::endl;
+
+    std::default_random_engine randomNumberGenerator;
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+    // complex and real transforms of mixed-radix and prime-factor (Bluestein) lengths agree with the definition
+    bool bSuccess = true;
+    for (std::size_t size : { 1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 15, 16, 25, 30, 60, 64, 97, 100, 128, 210, 243, 1000,
+                              1024, 1031 })
+    {
+        std::vector<std::complex<double>> x(size);
+        for (auto &&value : x)
+            value = std::complex<double>(uniform(randomNumberGenerator), uniform(randomNumberGenerator));
+
+        auto &&expected = computeDft(x);
+        auto &&spectrum = x;
+        FastFourierTransform<double> transform(size);
+        bSuccess &= (transform.forward(spectrum) && computeMaximumError(spectrum, expected) < 1.0e-9 &&
+                     transform.inverse(spectrum) && computeMaximumError(spectrum, x) < 1.0e-12);
+
+        std::vector<double> real(size), inverse(size);
+        std::vector<std::complex<double>> realSpectrum(size / 2 + 1), complexSpectrum(size);
+        for (std::size_t i = 0; i < size; ++i)
+            complexSpectrum[i] = real[i] = uniform(randomNumberGenerator);
+
+        expected = computeDft(complexSpectrum);
+        expected.resize(size / 2 + 1);
+        transform.forward(real.data(), realSpectrum.data());
+        transform.inverse(realSpectrum.data(), inverse.data());
+        bSuccess &= (computeMaximumError(realSpectrum, expected) < 1.0e-9 &&
+                     computeMaximumError(inverse, real) < 1.0e-12);
+        if (!bSuccess)
+        {
+            std::cout << "Transform of length " << size << " FAILED." << std::endl << std::endl;
+            break;
+        }
+    }
+
+    bSuccess &= (FastFourierTransform<double>::getFastSize(97) == 100 &&
+                 FastFourierTransform<double>::getFastSize(1025) == 1080 &&
+                 FastFourierTransform<double>::getFastSize(1) == 1);
+    std::cout << "Complex and real transforms " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // convolution and deconvolution via fast Fourier transforms agree with the direct algorithms
+    SequenceConvolver<double> direct, fast;
+    direct.setFftThreshold(std::size_t(-1));
+    fast.setFftThreshold(0);
+    for (auto &&sizes : { std::make_pair(1, 1), std::make_pair(3, 200), std::make_pair(57, 61),
+                          std::make_pair(500, 20), std::make_pair(1000, 1000), std::make_pair(4000, 130) })
+    {
+        std::vector<double> x(sizes.first), h(sizes.second);
+        std::generate(x.begin(), x.end(), [&] () { return uniform(randomNumberGenerator); });
+        std::generate(h.begin(), h.end(), [&] () { return uniform(randomNumberGenerator); });
+        auto &&expected = direct.convolve(x, h);
+        auto &&y = fast.convolve(x, h);
+        bSuccess &= (computeMaximumError(y, expected) < 1.0e-10);
+
+        // the leading coefficient of the divisor dominates so that the long division remains well-conditioned
+        x[0] = 2.0 * double(x.size());
+        y = direct.convolve(x, h);
+        std::vector<double> q, r, expectedQuotient, expectedRemainder;
+        if (x.size() > 1)
+            y.back() += 0.5;
+
+        bSuccess &= (direct.deconvolve(x.cbegin(), x.cend(), y.cbegin(), y.cend(), expectedQuotient,
+                                       expectedRemainder) &&
+                     fast.deconvolve(x.cbegin(), x.cend(), y.cbegin(), y.cend(), q, r) &&
+                     computeMaximumError(q, expectedQuotient) < 1.0e-10 &&
+                     computeMaximumError(q, h) < 1.0e-3 && computeMaximumError(r, expectedRemainder) < 1.0e-9);
+        if (!bSuccess)
+        {
+            std::cout << "Convolution of sequences of lengths " << sizes.first << " and " << sizes.second
+                      << " FAILED." << std::endl << std::endl;
+            break;
+        }
+    }
+
+    std::cout << "Fast convolution and deconvolution " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // time direct and overlap-add convolution of a long sequence with kernels of increasing length in order to
+    // locate the crossover point
+    std::vector<double> x(4096);
+    std::generate(x.begin(), x.end(), [&] () { return uniform(randomNumberGenerator); });
+    std::size_t crossover = 0;
+    std::cout << std::setw(15) << "Kernel length" << std::setw(20) << "Direct (us)" << std::setw(20) << "FFT (us)"
+              << std::endl;
+    for (std::size_t size = 4; size <= 1024; size *= 2)
+    {
+        std::vector<double> h(size), y(x.size() + size - 1);
+        std::generate(h.begin(), h.end(), [&] () { return uniform(randomNumberGenerator); });
+        auto &&directTime = timeConvolution(direct, x, h, y);
+        auto &&fastTime = timeConvolution(fast, x, h, y);
+        if (crossover == 0 && fastTime < directTime)
+            crossover = size;
+
+        std::cout << std::setw(15) << size << std::setw(20) << 1.0e6 * directTime << std::setw(20)
+                  << 1.0e6 * fastTime << std::endl;
+    }
+
+    std::cout << std::endl << "Overlap-add convolution is faster for kernels of length " << crossover
+              << " and above; the default threshold is " << SequenceConvolver<double>::DEFAULT_FFT_THRESHOLD
+              << "." << std::endl << std::endl;
+
+    return bSuccess;
+}
+
+}
@@ -0,0 +1,82 @@
+#ifndef TEST_FAST_FOURIER_TRANSFORM_H
+#define TEST_FAST_FOURIER_TRANSFORM_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for FastFourierTransform class
+ */
+class FastFourierTransformUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    FastFourierTransformUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    FastFourierTransformUnitTest(const FastFourierTransformUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    FastFourierTransformUnitTest(FastFourierTransformUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~FastFourierTransformUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    FastFourierTransformUnitTest &operator = (const FastFourierTransformUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    FastFourierTransformUnitTest &operator = (FastFourierTransformUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static FastFourierTransformUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "FastFourierTransformTest";
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,165 @@
+#include "fixedLinearKalman.h"
+#include "fixed_matrix.h"
+#include "matrix2d.h"
+#include "matrix3x3.h"
+#include "testFixedMatrix.h"
+#include "unitTestManager.h"
+#include <iostream>
+#include <random>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace math::linear_algebra::matrix;
+using namespace math::linear_algebra::vector;
+using namespace math::statistical::estimation::kalman;
+using namespace messaging;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testFixedMatrix", &FixedMatrixUnitTest::create);
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+FixedMatrixUnitTest::FixedMatrixUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+FixedMatrixUnitTest *FixedMatrixUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    FixedMatrixUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new FixedMatrixUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool FixedMatrixUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for FixedMatrix class..." << std::endl << std::endl;
+
+    // operations must be usable in constant expressions
+    constexpr FixedMatrix<2, 3> A(1, 2, 3, 4, 5, 6);
+    constexpr auto AAT = A.postMultiplyTranspose(A);
+    static_assert(AAT(0, 0) == 14 && AAT(0, 1) == 32 && AAT(1, 1) == 77, "constexpr product failed!");
+    static_assert((FixedMatrix<2, 2>::identity() * A) == A, "constexpr identity failed!");
+    static_assert(FixedVector<3>(1, 0, 0).cross(FixedVector<3>(0, 1, 0)) == FixedVector<3>(0, 0, 1),
+                  "constexpr cross product failed!");
+
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+    // determine whether a fixed-size matrix and a dynamic matrix are nearly equal
+    auto &&nearlyEqual = [] (auto &&lhs, const Matrix2d &rhs, double tolerance)
+    {
+        if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns())
+            return false;
+
+        for (std::size_t i = 0; i < lhs.rows(); ++i)
+            for (std::size_t j = 0; j < lhs.columns(); ++j)
+                if (std::fabs(lhs(i, j) - rhs(i, j)) > tolerance)
+                    return false;
+
+        return true;
+    };
+
+    // compare arithmetic against the dynamically-sized implementation
+    FixedMatrix<6, 6> B;
+    FixedMatrix<6, 3> C;
+    for (auto &&value : B)
+        value = uniform(generator);
+
+    for (auto &&value : C)
+        value = uniform(generator);
+
+    B += 6.0 * FixedMatrix<6, 6>::identity(); // keep B well-conditioned
+    auto &&dynamicB = B.toMatrix<Matrix2d>();
+    auto &&dynamicC = C.toMatrix<Matrix2d>();
+    bool bSuccess = nearlyEqual(B * C, dynamicB * dynamicC, 1e-14) &&
+                    nearlyEqual(C.preMultiplyTranspose(B), dynamicB.calcTranspose() * dynamicC, 1e-14) &&
+                    nearlyEqual(B.postMultiplyTranspose(B), dynamicB * dynamicB.calcTranspose(), 1e-14) &&
+                    nearlyEqual(B.calcInverse(), dynamicB.calcInverse(), 1e-12) &&
+                    FixedMatrix<6, 3>::fromMatrix(dynamicC) == C;
+
+    FixedMatrix<6, 3> X;
+    bSuccess &= B.solve(C, X) && nearlyEqual(B * X, dynamicC, 1e-12);
+    FixedVector<2> y;
+    bSuccess &= !FixedMatrix<2, 2>(1, 2, 2, 4).solve(FixedVector<2>(1, 1), y); // singular
+
+    // interoperability with Matrix3x3 and Vector3d
+    Matrix3x3 R(0.0, -1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0);
+    Vector3d v(1.0, 2.0, 3.0), Rv(R * v), fixedRv;
+    (FixedMatrix<3, 3>::fromArray(R) * FixedVector<3>::fromArray(v)).toArray(fixedRv);
+    bSuccess &= (fixedRv == Rv);
+
+    std::cout << "Matrix arithmetic " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // compare a 6-state, 3-measurement constant velocity linear Kalman filter against a reference
+    // implementation which uses dynamically-sized matrices
+    const double dt = 0.1;
+    auto &&F = FixedMatrix<6, 6>::identity();
+    FixedMatrix<3, 6> H;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        F(i, i + 3) = dt;
+        H(i, i) = 1.0;
+    }
+
+    FixedLinearKalman<6, 3> kalman(dt);
+    kalman.setDynamicsMatrix(F);
+    kalman.setMeasurementMatrix(H);
+    kalman.setProcessCovariance(1e-3 * FixedMatrix<6, 6>::identity());
+    kalman.setMeasurementCovariance(0.25 * FixedMatrix<3, 3>::identity());
+    kalman.setErrorCovariance(10.0 * FixedMatrix<6, 6>::identity());
+
+    auto &&dynamicF = F.toMatrix<Matrix2d>();
+    auto &&dynamicH = H.toMatrix<Matrix2d>();
+    auto &&dynamicQ = kalman.getProcessCovariance().toMatrix<Matrix2d>();
+    auto &&dynamicR = kalman.getMeasurementCovariance().toMatrix<Matrix2d>();
+    auto &&P = kalman.getErrorCovariance().toMatrix<Matrix2d>();
+    auto &&x = kalman.getStateEstimate().toMatrix<Matrix2d>();
+    auto &&I = Matrix2d::identity(6);
+    for (std::size_t k = 0; bSuccess && k < 50; ++k)
+    {
+        FixedVector<3> z(k * dt + uniform(generator), 2.0 - k * dt + uniform(generator), uniform(generator));
+
+        kalman.timeUpdate();
+        bSuccess &= kalman.measurementUpdate(z);
+
+        x = dynamicF * x;
+        P = dynamicF * P * dynamicF.calcTranspose() + dynamicQ;
+        auto &&S = dynamicH * P * dynamicH.calcTranspose() + dynamicR;
+        auto &&K = P * dynamicH.calcTranspose() * S.calcInverse();
+        x = x + K * (z.toMatrix<Matrix2d>() - dynamicH * x);
+        P = (I - K * dynamicH) * P;
+
+        bSuccess &= nearlyEqual(kalman.getStateEstimate(), x, 1e-10) &&
+                    nearlyEqual(kalman.getErrorCovariance(), P, 1e-10);
+    }
+
+    std::cout << "Fixed-size linear Kalman filter " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+
+    return bSuccess;
+}
+
+}
@@ -0,0 +1,82 @@
+#ifndef TEST_FIXED_MATRIX_H
+#define TEST_FIXED_MATRIX_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for FixedMatrix class and fixed-size Kalman filters
+ */
+class FixedMatrixUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    FixedMatrixUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    FixedMatrixUnitTest(const FixedMatrixUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    FixedMatrixUnitTest(FixedMatrixUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~FixedMatrixUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    FixedMatrixUnitTest &operator = (const FixedMatrixUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    FixedMatrixUnitTest &operator = (FixedMatrixUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static FixedMatrixUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "FixedMatrixTest";
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,181 @@
+#include "angle_unit_type.h"
+#include "interpolatedKinematicState.h"
+#include "math_constants.h"
+#include "testInterpolatedKinematicState.h"
+#include "unitTestManager.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace math::geometric::orientation;
+using namespace math::linear_algebra::vector;
+using namespace math::trigonometric;
+using namespace messaging;
+using namespace physics::kinematics;
+using namespace utilities;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testInterpolatedKinematicState",
+                                                    &InterpolatedKinematicStateUnitTest::create);
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+InterpolatedKinematicStateUnitTest::InterpolatedKinematicStateUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+InterpolatedKinematicStateUnitTest *
+InterpolatedKinematicStateUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    InterpolatedKinematicStateUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new InterpolatedKinematicStateUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool InterpolatedKinematicStateUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for InterpolatedKinematicState class..." << std::endl << std::endl;
+
+    // a trajectory sampled every 0.5 s, with position and yaw varying linearly and the acceleration sampled only
+    // every other second
+    const double dt = 0.5;
+    const std::size_t numSamples = 200000;
+    auto &&position = [] (double t) { return Vector3d(100.0 + 2.0 * t, -50.0 + 3.0 * t, 1000.0 - 0.5 * t); };
+    auto &&yaw = [] (double t) { return 10.0 + 0.01 * t; };
+
+    std::vector<double> times(numSamples);
+    std::vector<Vector3d> positions(numSamples), velocities(numSamples);
+    std::vector<Eulers> eulers(numSamples);
+    std::unique_ptr<InterpolatedKinematicState> pState(InterpolatedKinematicState::create());
+    for (std::size_t i = 0; i < numSamples; ++i)
+    {
+        times[i] = dt * i;
+        positions[i] = position(times[i]);
+        velocities[i].set(2.0, 3.0, -0.5);
+        eulers[i] = Eulers(1.0, 2.0, yaw(times[i]));
+
+        pState->setTime(times[i]);
+        pState->setPosition(positions[i][0], positions[i][1], positions[i][2]);
+        pState->setVelocity(2.0, 3.0, -0.5);
+        pState->setEulers(eulers[i]);
+        if (i % 4 == 0)
+            pState->setAcceleration(0.0, 0.0, times[i]);
+    }
+
+    // a state loaded in bulk, with its sparser acceleration history set afterwards, should match the state built
+    // one sample at a time
+    std::unique_ptr<InterpolatedKinematicState> pBulkState(InterpolatedKinematicState::create());
+    auto &&start = std::chrono::steady_clock::now();
+    bool bSuccess = pBulkState->setTimeHistory(times, positions, velocities, {}, eulers);
+    auto &&loadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (std::size_t i = 0; bSuccess && i < numSamples; i += 4)
+    {
+        pBulkState->setTime(times[i]);
+        pBulkState->setAcceleration(0.0, 0.0, times[i]);
+    }
+
+    pBulkState->setTime(pState->getTime());
+    bSuccess &= (*pBulkState == *pState);
+    std::cout << "Bulk load of " << numSamples << " samples (" << 1.0e3 * loadTime << " ms) "
+              << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // interpolate at monotonically increasing times between the samples
+    double maximumError = 0.0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i + 1 < numSamples; ++i)
+    {
+        auto &&t = times[i] + 0.3 * dt;
+        double value[3], roll, pitch, yawAngle;
+        pState->getPosition(value, t);
+        auto &&truth = position(t);
+        for (std::size_t j = 0; j < 3; ++j)
+            maximumError = std::max(maximumError, std::fabs(value[j] - truth[j]));
+
+        pState->getEulers(roll, pitch, yawAngle, t);
+        maximumError = std::max(maximumError, std::fabs(yawAngle - yaw(t)));
+        maximumError = std::max(maximumError, std::fabs(roll - 1.0) + std::fabs(pitch - 2.0));
+    }
+
+    auto &&queryTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // the acceleration is interpolated between its own samples, which are further apart
+    pState->setTime(3.0);
+    maximumError = std::max(maximumError, std::fabs(pState->getAcceleration()[2] - 3.0));
+
+    // times outside of the history evaluate to the first and last samples
+    double value[3];
+    pState->getPosition(value, -10.0);
+    maximumError = std::max(maximumError, std::fabs(value[0] - positions.front()[0]));
+    pState->getPosition(value, times.back() + 10.0);
+    maximumError = std::max(maximumError, std::fabs(value[0] - positions.back()[0]));
+
+    bSuccess = (maximumError < 1.0e-9);
+    std::cout << "Interpolation (maximum error " << maximumError << ", "
+              << 1.0e9 * queryTime / (numSamples - 1) << " ns per query) " << (bSuccess ? "PASSED." : "FAILED.")
+              << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // a conversion of angle units scales the Euler angles, but not the position
+    std::unique_ptr<InterpolatedKinematicState> pRadianState(pState->clone());
+    pRadianState->convertAngleUnits(AngleUnitType::Radians);
+    pRadianState->setTime(times[10]);
+    bSuccess = (std::fabs(pRadianState->getYaw(AngleUnitType::Radians, times[10]) -
+                          yaw(times[10]) * math::DEGREES_TO_RADIANS) < 1.0e-12 &&
+                std::fabs(pRadianState->getEulers().getYaw(AngleUnitType::Degrees) - yaw(times[10])) < 1.0e-9 &&
+                pRadianState->getPosition() == positions[10]);
+
+    // a single angle set in other units is converted to the units of the state
+    pRadianState->setYaw(90.0, AngleUnitType::Degrees);
+    bSuccess &= (std::fabs(pRadianState->getEulers().getYaw() - 0.5 * math::PI) < 1.0e-12 &&
+                 std::fabs(pRadianState->getEulers().getPitch() - eulers[10].getPitch(AngleUnitType::Radians)) <
+                 1.0e-12);
+    std::cout << "Conversion of angle units " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // serialization round trip
+    std::stringstream stream;
+    pState->serialize(stream);
+    std::unique_ptr<InterpolatedKinematicState> pDeserializedState(InterpolatedKinematicState::create());
+    pDeserializedState->deserialize(stream);
+    bSuccess = (*pDeserializedState == *pState);
+
+    // mismatched inputs are rejected without modifying the state
+    bSuccess &= !pDeserializedState->setTimeHistory({ 0.0, 1.0 }, { Vector3d() });
+    bSuccess &= !pDeserializedState->setTimeHistory({ 1.0, 0.0 }, { Vector3d(), Vector3d() });
+    bSuccess &= (*pDeserializedState == *pState);
+    std::cout << "Serialization and input validation " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+
+    return bSuccess;
+}
+
+}
@@ -0,0 +1,82 @@
+#ifndef TEST_INTERPOLATED_KINEMATIC_STATE_H
+#define TEST_INTERPOLATED_KINEMATIC_STATE_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for InterpolatedKinematicState class
+ */
+class InterpolatedKinematicStateUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    InterpolatedKinematicStateUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    InterpolatedKinematicStateUnitTest(const InterpolatedKinematicStateUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    InterpolatedKinematicStateUnitTest(InterpolatedKinematicStateUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~InterpolatedKinematicStateUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    InterpolatedKinematicStateUnitTest &operator = (const InterpolatedKinematicStateUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    InterpolatedKinematicStateUnitTest &operator = (InterpolatedKinematicStateUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static InterpolatedKinematicStateUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "InterpolatedKinematicStateTest";
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,175 @@
+#include "json_to_table_converter.h"
+#include "testJsonToTableConverter.h"
+#include "unitTestManager.h"
+#include <cctype>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace messaging;
+using namespace utilities;
+using namespace utilities::json;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testJsonToTableConverter",
+                                                    &JsonToTableConverterUnitTest::create);
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+JsonToTableConverterUnitTest::JsonToTableConverterUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+JsonToTableConverterUnitTest *JsonToTableConverterUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    JsonToTableConverterUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new JsonToTableConverterUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool JsonToTableConverterUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for JsonToTableConverter class..." << std::endl << std::endl;
+
+    // records are flattened into rows whose columns are those of the first record
+    const std::string json = "[\n"
+                             " {\"id\": 1, \"name\": \"alpha\", \"pos\": {\"x\": 1.5, \"y\": -2e3}, "
+                             "\"tags\": [\"a\", \"b\"], \"ok\": true},\n"
+                             " {\"id\": 2, \"name\": \"be\\\"ta, \\u00e9\\ud83d\\ude00\", \"pos\": {\"x\": 0, "
+                             "\"y\": null}, \"tags\": [\"c\", \"d\"], \"ok\": false, \"extra\": 5},\n"
+                             " {\"id\": 3, \"pos\": {\"x\": 3}}\n"
+                             "]\n";
+    const std::string expected = "id,name,pos.x,pos.y,tags.0,tags.1,ok\n"
+                                 "1,alpha,1.5,-2e3,a,b,true\n"
+                                 "2,\"be\"\"ta, \xc3\xa9\xf0\x9f\x98\x80\",0,null,c,d,false\n"
+                                 "3,,3,,,,\n";
+    bool bSuccess = true;
+    for (std::size_t chunkSize = 1; bSuccess && chunkSize <= json.size() + 1; ++chunkSize)
+    {
+        JsonToTableConverter converter;
+        std::istringstream input(json);
+        std::ostringstream output;
+        bSuccess = (converter.convert(input, output, chunkSize) && output.str() == expected &&
+                    converter.getColumns().size() == 7);
+    }
+
+    // newline-delimited records and top-level scalars
+    JsonToTableConverter converter(";");
+    std::istringstream input("{\"a\": 1, \"b\": [true]}\n{\"b\": [false], \"a\": \"x;y\"}\n");
+    std::ostringstream output;
+    bSuccess &= (converter.convert(input, output) && output.str() == "a;b.0\n1;true\n\"x;y\";false\n");
+
+    std::vector<std::vector<std::string>> rows;
+    auto &&collect = [&rows] (const std::vector<std::string> &values) { rows.push_back(values); return true; };
+    input = std::istringstream("1 \"two\" [3]");
+    bSuccess &= (converter.forEachRow(input, collect) &&
+                 converter.getColumns() == std::vector<std::string>{ "value" } &&
+                 rows == std::vector<std::vector<std::string>>{ { "1" }, { "two" }, { "3" } });
+
+    // specified columns are kept across conversions until they are cleared
+    converter.setColumns({ "b.0", "a" });
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        rows.clear();
+        input = std::istringstream("{\"a\": 1, \"b\": [true], \"c\": 2}");
+        bSuccess &= (converter.forEachRow(input, collect) &&
+                     converter.getColumns() == std::vector<std::string>{ "b.0", "a" } &&
+                     rows == std::vector<std::vector<std::string>>{ { "true", "1" } });
+    }
+
+    converter.setColumns({ });
+
+    // filters modify values and discard records
+    converter.addFilter("skip", [] (const std::string &column, std::string &value)
+                        { return column != "id" || value != "2"; });
+    converter.addFilter("upper", [] (const std::string &column, std::string &value)
+                        {
+                            if (column == "name")
+                                for (auto &&ch : value)
+                                    ch = char(std::toupper(ch));
+
+                            return true;
+                        });
+    rows.clear();
+    input = std::istringstream(json);
+    bSuccess &= (!converter.addFilter("skip", nullptr) && converter.forEachRow(input, collect) && rows.size() == 2 &&
+                 rows[0][1] == "ALPHA" && rows[1][0] == "3");
+
+    // the keys and indices of singleton members are omitted from column names if singletons are ignored
+    converter.removeFilters();
+    for (auto bIgnoreSingletons : { false, true })
+    {
+        converter.ignoreSingletons(bIgnoreSingletons);
+        input = std::istringstream("[{\"a\": {\"b\": 1}, \"c\": [5], \"d\": [[6, 7]]}]");
+        bSuccess &= (converter.forEachRow(input, [] (auto &&) { return true; }) &&
+                     converter.getColumns() ==
+                     (bIgnoreSingletons ? std::vector<std::string>{ "a", "c", "d.0", "d.1" } :
+                                          std::vector<std::string>{ "a.b", "c.0", "d.0.0", "d.0.1" }));
+    }
+
+    // malformed documents are rejected
+    for (auto &&malformed : { "[{\"a\": 1,}]", "{\"a\" 1}", "[1, 2", "[\"\x01\"]", "tru", "[01]", "{\"a\": 1]",
+                              "[\"\\ud83d\"]", "[\"\\ud83d\\u0041\"]", "[\"\\ud83d\\ud83d\"]", "[1.]",
+                              "[\"\\q\"]", "[1 2", "[1;", "{\"a\":[1 2]}", "[[1]x" })
+    {
+        input = std::istringstream(malformed);
+        bSuccess &= !converter.forEachRow(input, [] (auto &&) { return true; });
+    }
+
+    std::cout << "Flattening of records " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // convert a large log of telemetry records
+    const std::size_t numRecords = 50000;
+    std::ostringstream log;
+    log << "[";
+    for (std::size_t i = 0; i < numRecords; ++i)
+    {
+        log << (i > 0 ? ",\n" : "\n") << "{\"time\": " << 0.1 * double(i) << ", \"state\": {\"position\": [" << i
+            << ", " << 2 * i << ", " << 3 * i << "], \"velocity\": [1, 2, 3]}, \"label\": \"track " << i % 7
+            << "\"}";
+    }
+
+    log << "\n]\n";
+    auto &&string = log.str();
+    JsonToTableConverter logConverter;
+    std::size_t numRows = 0;
+    input = std::istringstream(string);
+    auto &&start = std::chrono::steady_clock::now();
+    bSuccess = logConverter.forEachRow(input, [&numRows] (const std::vector<std::string> &values)
+                                       { return values[2] == std::to_string(2 * numRows++); });
+    auto &&time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    bSuccess &= (numRows == numRecords && logConverter.getColumns().size() == 8);
+    std::cout << "Conversion of a " << string.size() / 1024 << " KiB log (" << 1.0e9 * time / string.size()
+              << " ns per byte) " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+
+    return bSuccess;
+}
+
+}
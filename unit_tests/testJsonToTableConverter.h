@@ -0,0 +1,82 @@
+#ifndef TEST_JSON_TO_TABLE_CONVERTER_H
+#define TEST_JSON_TO_TABLE_CONVERTER_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for JsonToTableConverter class
+ */
+class JsonToTableConverterUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    JsonToTableConverterUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    JsonToTableConverterUnitTest(const JsonToTableConverterUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    JsonToTableConverterUnitTest(JsonToTableConverterUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~JsonToTableConverterUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    JsonToTableConverterUnitTest &operator = (const JsonToTableConverterUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    JsonToTableConverterUnitTest &operator = (JsonToTableConverterUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static JsonToTableConverterUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "JsonToTableConverterTest";
+    }
+};
+
+}
+
+#endif
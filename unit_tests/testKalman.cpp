@@ -0,0 +1,271 @@
+#include "extendedKalman.h"
+#include "linearKalman.h"
+#include "radarTrackFilter.h"
+#include "stateVector.h"
+#include "testKalman.h"
+#include "unitTestManager.h"
+#include "unscentedKalman.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace math::control_systems;
+using namespace math::linear_algebra::matrix;
+using namespace math::statistical::estimation;
+using namespace math::statistical::estimation::applied;
+using namespace math::statistical::estimation::kalman;
+using namespace messaging;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testKalman", &KalmanUnitTest::create);
+
+/**
+ * An extended Kalman filter which exposes the computation of the Kalman gain
+ */
+class GainKalman final
+: public ExtendedKalman
+{
+public:
+
+    /**
+     * Using declarations
+     */
+    using Kalman::calcKalmanGain;
+};
+
+/**
+ * A radar track filter that leaves the state estimate and covariances of its estimation filter as they were
+ * set, rather than initializing them from measurements, and whose measurement model is linear, so that the
+ * estimates of the unscented filter can be computed in closed form
+ */
+class PresetRadarTrackFilter final
+: public RadarTrackFilter
+{
+public:
+
+    /**
+     * Constructor
+     * @param pEstimationFilter a pointer to the estimation filter associated with this object
+     * @param H                 the measurement matrix
+     */
+    PresetRadarTrackFilter(EstimationFilter *pEstimationFilter,
+                           const Matrix2d &H)
+    : RadarTrackFilter(pEstimationFilter),
+      m_H(H)
+    {
+
+    }
+
+    /**
+     * Initialization function
+     */
+    virtual bool initialize(void) override
+    {
+        return true;
+    }
+
+    /**
+     * Evaluate the measurement Jacobian
+     */
+    virtual Matrix2d measurementJacobian(const Matrix2d &) const override
+    {
+        return m_H;
+    }
+
+    /**
+     * Evaluate the measurement model
+     */
+    virtual Matrix2d measurementModel(const Matrix2d &x,
+                                      const Matrix2d &) override
+    {
+        return m_H * x;
+    }
+
+private:
+
+    /**
+     * the measurement matrix
+     */
+    Matrix2d m_H;
+};
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+KalmanUnitTest::KalmanUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+KalmanUnitTest *KalmanUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    KalmanUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new KalmanUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool KalmanUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for Kalman filter classes..." << std::endl << std::endl;
+
+    // a well-conditioned radar track, linearized about its initial state
+    const double dt = 0.5;
+    Matrix2d x0(9, 1);
+    x0[0] = 12000.0, x0[1] = -8000.0, x0[2] = 6000.0;
+    x0[3] = 150.0, x0[4] = 90.0, x0[5] = -10.0;
+    x0[6] = 1.0, x0[7] = -0.5, x0[8] = 0.2;
+
+    Matrix2d P0(9, 9);
+    for (std::size_t i = 0; i < 9; ++i)
+        P0(i, i) = i < 3 ? 2500.0 : (i < 6 ? 100.0 : 10.0);
+
+    for (std::size_t i = 0; i < 3; ++i)
+        P0(i, i + 3) = P0(i + 3, i) = 200.0;
+
+    Matrix2d R(4, 4);
+    R(0, 0) = R(1, 1) = 1.0e-6;
+    R(2, 2) = 25.0;
+    R(3, 3) = 1.0;
+    R(2, 3) = R(3, 2) = 0.5 * 5.0 * 1.0;
+
+    GainKalman gainKalman;
+    auto *pRadarTrackFilter = RadarTrackFilter::create(&gainKalman);
+    gainKalman.setAppliedEstimationFilter(pRadarTrackFilter);
+
+    double maneuverVariance[3] = { 4.0, 4.0, 1.0 };
+    pRadarTrackFilter->setManeuverVariance(maneuverVariance);
+    auto &&Q = pRadarTrackFilter->computeProcessCovariance(dt);
+    auto &&F = pRadarTrackFilter->dynamicsJacobian(dt, x0);
+    auto &&H = pRadarTrackFilter->measurementJacobian(x0);
+    auto &&HT = H.calcTranspose();
+
+    // a measurement displaced from the predicted measurement
+    auto &&xm = F * x0;
+    auto &&z = H * xm;
+    z[0] += 2.0e-3, z[1] -= 1.0e-3, z[2] += 10.0, z[3] -= 2.0;
+
+    // the Cholesky solve agrees with multiplication by the explicit inverse of the residual covariance
+    auto &&Pbar = F * P0 * F.calcTranspose();
+    auto &&Pm = Pbar + Q;
+    auto &&S = H * Pm * HT + R;
+    Matrix2d K;
+    bool bSuccess = gainKalman.calcKalmanGain(Pm * HT, S, K);
+    auto &&KReference = Pm * HT * S.calcInverse();
+    double maximumGainError = 0.0;
+    for (std::size_t i = 0; bSuccess && i < K.rows(); ++i)
+        for (std::size_t j = 0; j < K.columns(); ++j)
+            maximumGainError = std::max(maximumGainError, std::fabs(K(i, j) - KReference(i, j)) /
+                                                          (1.0 + std::fabs(KReference(i, j))));
+
+    bSuccess &= (maximumGainError < 1.0e-8);
+    std::cout << "Kalman gain agrees with the explicit inverse (maximum relative error " << maximumGainError
+              << ") " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // the linear and extended filters predict with P = F * P * F' + Q before the update; the unscented filter
+    // propagates its sigma points without the process noise, so its cross-covariances are formed from
+    // F * P * F'. In each case, the reference update uses the explicit inverse of the residual covariance
+    auto &&referenceUpdate = [&] (const Matrix2d &PPredicted, Matrix2d &x, Matrix2d &P)
+    {
+        auto &&Pxy = PPredicted * HT;
+        auto &&Pyy = H * PPredicted * HT + R;
+        auto &&KExplicit = Pxy * Pyy.calcInverse();
+        x = xm + KExplicit * (z - H * xm);
+        P = Pm - KExplicit * Pyy * KExplicit.calcTranspose();
+    };
+
+    Matrix2d xLinearized, PLinearized, xUnscented, PUnscented;
+    referenceUpdate(Pm, xLinearized, PLinearized);
+    referenceUpdate(Pbar, xUnscented, PUnscented);
+
+    std::unique_ptr<EstimationFilter> pFilters[] = { std::unique_ptr<EstimationFilter>(LinearKalman::create()),
+                                                     std::unique_ptr<EstimationFilter>(ExtendedKalman::create()),
+                                                     std::unique_ptr<EstimationFilter>(UnscentedKalman::create()) };
+    const std::string names[] = { "Linear", "Extended", "Unscented" };
+    for (std::size_t filter = 0; bSuccess && filter < 3; ++filter)
+    {
+        auto &&pFilter = pFilters[filter];
+        auto *pTrackFilter = new PresetRadarTrackFilter(pFilter.get(), H);
+        pTrackFilter->setup();
+        pFilter->setAppliedEstimationFilter(pTrackFilter);
+
+        auto &&setMatrices = [&] (const Matrix2d &measurementCovariance)
+        {
+            return pFilter->setMatrix("stateEstimate", x0) &&
+                   pFilter->setMatrix("errorCovariance", P0) &&
+                   pFilter->setMatrix("processCovariance", Q) &&
+                   pFilter->setMatrix("measurementCovariance", measurementCovariance) &&
+                   (!pFilter->getVariableRegistry().contains("measurement") ||
+                    pFilter->setMatrix("measurement", H));
+        };
+
+        Matrix2d x, P;
+        StateVector measurement(z);
+        bSuccess = setMatrices(R) && pFilter->initialize(dt) && setMatrices(R);
+        if (bSuccess)
+        {
+            pFilter->timeUpdate();
+            bSuccess = pFilter->measurementUpdate(measurement) && pFilter->getMatrix("stateEstimate", x) &&
+                       pFilter->getMatrix("errorCovariance", P);
+        }
+
+        auto &&xReference = (filter == 2 ? xUnscented : xLinearized);
+        auto &&PReference = (filter == 2 ? PUnscented : PLinearized);
+        double maximumStateError = 0.0, maximumCovarianceError = 0.0;
+        for (std::size_t i = 0; bSuccess && i < 9; ++i)
+        {
+            maximumStateError = std::max(maximumStateError,
+                                         std::fabs(x[i] - xReference[i]) / (1.0 + std::fabs(xReference[i])));
+            for (std::size_t j = 0; j < 9; ++j)
+            {
+                auto &&scale = 1.0 + std::sqrt(PReference(i, i) * PReference(j, j));
+                maximumCovarianceError = std::max(maximumCovarianceError,
+                                                  std::fabs(P(i, j) - PReference(i, j)) / scale);
+                bSuccess &= (P(i, j) == P(j, i));
+            }
+        }
+
+        bSuccess &= (maximumStateError < 1.0e-8 && maximumCovarianceError < 1.0e-8);
+        std::cout << names[filter] << " filter agrees with the explicit inverse (maximum relative state error "
+                  << maximumStateError << ", covariance error " << maximumCovarianceError << ") "
+                  << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+        if (!bSuccess)
+            return bSuccess;
+
+        // an update whose residual covariance is not positive definite is skipped, leaving the state estimate
+        // and error covariance unchanged
+        bSuccess = setMatrices(-1.0e12 * Matrix2d::identity(4)) && !pFilter->measurementUpdate(measurement) &&
+                   pFilter->getMatrix("stateEstimate", x) && pFilter->getMatrix("errorCovariance", P) &&
+                   x == x0 && P == P0;
+        std::cout << names[filter] << " filter rejection of an indefinite residual covariance "
+                  << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    }
+
+    return bSuccess;
+}
+
+}
@@ -0,0 +1,82 @@
+#ifndef TEST_KALMAN_H
+#define TEST_KALMAN_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for the LinearKalman, ExtendedKalman and UnscentedKalman classes
+ */
+class KalmanUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    KalmanUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    KalmanUnitTest(const KalmanUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    KalmanUnitTest(KalmanUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~KalmanUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    KalmanUnitTest &operator = (const KalmanUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    KalmanUnitTest &operator = (KalmanUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static KalmanUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "KalmanTest";
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,235 @@
+#include "extendedKalman.h"
+#include "kalmanFilterBank.h"
+#include "radarTrackEstimationFilterUser.h"
+#include "radarTrackFilter.h"
+#include "testKalmanFilterBank.h"
+#include "unitTestManager.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace math::control_systems;
+using namespace math::linear_algebra::matrix;
+using namespace math::statistical::estimation;
+using namespace math::statistical::estimation::applied;
+using namespace math::statistical::estimation::kalman;
+using namespace messaging;
+using namespace utilities;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testKalmanFilterBank", &KalmanFilterBankUnitTest::create);
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+KalmanFilterBankUnitTest::KalmanFilterBankUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+KalmanFilterBankUnitTest *KalmanFilterBankUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    KalmanFilterBankUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new KalmanFilterBankUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool KalmanFilterBankUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for KalmanFilterBank class..." << std::endl << std::endl;
+
+    // the radar track filter supplies the dynamics, measurement model and process covariance for the reference
+    // filters, which are updated one at a time using dense matrices
+    std::unique_ptr<ExtendedKalman> pKalman(ExtendedKalman::create());
+    auto *pTrackFilter = RadarTrackFilter::create(pKalman.get());
+    pKalman->setAppliedEstimationFilter(pTrackFilter);
+
+    const double dt = 0.5;
+    double maneuverVariance[3] = { 4.0, 4.0, 1.0 };
+    pTrackFilter->setManeuverVariance(maneuverVariance);
+    auto &&Q = pTrackFilter->computeProcessCovariance(dt);
+
+    Matrix2d R(4, 4);
+    R(0, 0) = R(1, 1) = 1.0e-6;
+    R(2, 2) = 25.0;
+    R(3, 3) = 1.0;
+    R(2, 3) = R(3, 2) = 0.5 * 5.0 * 1.0;
+
+    // tracks of objects in roughly straight-line flight
+    const std::size_t numFilters = 1003;
+    std::mt19937 generator(13579);
+    std::uniform_real_distribution<double> position(-40000.0, 40000.0), velocity(-300.0, 300.0);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<Matrix2d> truths(numFilters), states(numFilters), covariances(numFilters);
+    for (std::size_t filter = 0; filter < numFilters; ++filter)
+    {
+        auto &&truth = truths[filter];
+        truth.resize(9, 1);
+        truth[0] = position(generator);
+        truth[1] = position(generator);
+        truth[2] = 5000.0 + 0.1 * std::fabs(position(generator));
+        truth[3] = velocity(generator);
+        truth[4] = velocity(generator);
+        truth[5] = 0.1 * velocity(generator);
+
+        states[filter] = truth;
+        for (std::size_t i = 0; i < 6; ++i)
+            states[filter][i] += (i < 3 ? 50.0 : 10.0) * noise(generator);
+
+        covariances[filter] = Matrix2d(9, 9);
+        for (std::size_t i = 0; i < 9; ++i)
+            covariances[filter](i, i) = i < 3 ? 2500.0 : (i < 6 ? 100.0 : 10.0);
+    }
+
+    std::unique_ptr<KalmanFilterBank> pBank(RadarTrackEstimationFilterUser::createFilterBank());
+    std::unique_ptr<KalmanFilterBank> pThreadedBank(RadarTrackEstimationFilterUser::createFilterBank());
+    pThreadedBank->setMaximumThreads(4);
+    bool bSuccess = true;
+    for (auto *pFilterBank : { pBank.get(), pThreadedBank.get() })
+    {
+        pFilterBank->resize(numFilters);
+        for (std::size_t filter = 0; bSuccess && filter < numFilters; ++filter)
+        {
+            bSuccess = pFilterBank->setStateEstimate(filter, states[filter]) &&
+                       pFilterBank->setErrorCovariance(filter, covariances[filter]) &&
+                       pFilterBank->setProcessCovariance(filter, Q) &&
+                       pFilterBank->setMeasurementCovariance(filter, R);
+        }
+    }
+
+    // run several scans, in which only some of the tracks are updated with measurements
+    auto &&F = pTrackFilter->dynamicsJacobian(dt, states[0]);
+    auto &&I = Matrix2d::identity(9);
+    const std::size_t numScans = 5;
+    double bankTime = 0.0, referenceTime = 0.0;
+    for (std::size_t scan = 0; bSuccess && scan < numScans; ++scan)
+    {
+        std::vector<Matrix2d> measurements(numFilters);
+        for (std::size_t filter = 0; filter < numFilters; ++filter)
+        {
+            truths[filter] = F * truths[filter];
+            if ((filter + scan) % 3 != 0)
+            {
+                auto &&z = pTrackFilter->measurementModel(truths[filter], Matrix2d());
+                z[0] += 1.0e-3 * noise(generator);
+                z[1] += 1.0e-3 * noise(generator);
+                z[2] += 5.0 * noise(generator);
+                z[3] += 1.0 * noise(generator);
+                measurements[filter] = z;
+            }
+        }
+
+        auto &&start = std::chrono::steady_clock::now();
+        for (std::size_t filter = 0; filter < numFilters; ++filter)
+        {
+            auto &&x = states[filter];
+            auto &&P = covariances[filter];
+            x = F * x;
+            P = F * P * F.calcTranspose() + Q;
+
+            auto &&z = measurements[filter];
+            if (!z.empty())
+            {
+                auto &&H = pTrackFilter->measurementJacobian(x);
+                auto &&S = H * P * H.calcTranspose() + R;
+                auto &&K = P * H.calcTranspose() * S.calcInverse();
+                x += K * (z - pTrackFilter->measurementModel(x, Matrix2d()));
+                P = (I - K * H) * P;
+            }
+        }
+
+        auto &&middle = std::chrono::steady_clock::now();
+        for (auto *pFilterBank : { pBank.get(), pThreadedBank.get() })
+        {
+            bSuccess &= pFilterBank->timeUpdate(F);
+            for (std::size_t filter = 0; filter < numFilters; ++filter)
+                if (!measurements[filter].empty())
+                    bSuccess &= pFilterBank->setMeasurement(filter, measurements[filter]);
+
+            bSuccess &= pFilterBank->measurementUpdate();
+        }
+
+        auto &&finish = std::chrono::steady_clock::now();
+        referenceTime += std::chrono::duration<double>(middle - start).count();
+        bankTime += std::chrono::duration<double>(finish - middle).count() / 2;
+    }
+
+    // compare the banks against the reference filters
+    double maximumStateError = 0.0, maximumCovarianceError = 0.0;
+    for (auto *pFilterBank : { pBank.get(), pThreadedBank.get() })
+    {
+        Matrix2d x, P;
+        for (std::size_t filter = 0; bSuccess && filter < numFilters; ++filter)
+        {
+            bSuccess = pFilterBank->getStateEstimate(filter, x) && pFilterBank->getErrorCovariance(filter, P) &&
+                       !pFilterBank->isMeasurementPending(filter);
+            for (std::size_t i = 0; bSuccess && i < 9; ++i)
+            {
+                auto &&scale = 1.0 + std::fabs(states[filter][i]);
+                maximumStateError = std::max(maximumStateError, std::fabs(x[i] - states[filter][i]) / scale);
+                for (std::size_t j = 0; j < 9; ++j)
+                {
+                    auto &&reference = covariances[filter](i, j);
+                    auto &&covarianceScale = 1.0 + std::sqrt(covariances[filter](i, i) * covariances[filter](j, j));
+                    maximumCovarianceError = std::max(maximumCovarianceError,
+                                                      std::fabs(P(i, j) - reference) / covarianceScale);
+                }
+            }
+        }
+    }
+
+    bSuccess &= (maximumStateError < 1.0e-8 && maximumCovarianceError < 1.0e-8);
+    std::cout << "Agreement with individually updated filters (maximum relative state error "
+              << maximumStateError << ", covariance error " << maximumCovarianceError << ") "
+              << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    std::cout << "Time per scan: bank " << 1.0e3 * bankTime / numScans << " ms, individual filters "
+              << 1.0e3 * referenceTime / numScans << " ms." << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // a filter whose residual covariance is not positive definite must be left unchanged, without affecting
+    // the other filters in its block
+    Matrix2d xBefore, PBefore, xNeighbor, x, P;
+    pBank->getStateEstimate(1, xBefore);
+    pBank->getErrorCovariance(1, PBefore);
+    pBank->getStateEstimate(2, xNeighbor);
+    pBank->setMeasurementCovariance(1, -1.0e12 * Matrix2d::identity(4));
+    auto &&z = pTrackFilter->measurementModel(truths[1], Matrix2d());
+    pBank->setMeasurement(1, z);
+    pBank->setMeasurement(2, pTrackFilter->measurementModel(truths[2], Matrix2d()));
+    bSuccess = !pBank->measurementUpdate();
+    pBank->getStateEstimate(1, x);
+    pBank->getErrorCovariance(1, P);
+    bSuccess &= (x == xBefore && P == PBefore && !pBank->isMeasurementPending(1));
+    pBank->getStateEstimate(2, x);
+    bSuccess &= !(x == xNeighbor);
+    std::cout << "Rejection of an indefinite residual covariance " << (bSuccess ? "PASSED." : "FAILED.")
+              << std::endl << std::endl;
+
+    return bSuccess;
+}
+
+}
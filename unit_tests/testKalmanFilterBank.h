@@ -0,0 +1,82 @@
+#ifndef TEST_KALMAN_FILTER_BANK_H
+#define TEST_KALMAN_FILTER_BANK_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for KalmanFilterBank class
+ */
+class KalmanFilterBankUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    KalmanFilterBankUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    KalmanFilterBankUnitTest(const KalmanFilterBankUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    KalmanFilterBankUnitTest(KalmanFilterBankUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~KalmanFilterBankUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    KalmanFilterBankUnitTest &operator = (const KalmanFilterBankUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    KalmanFilterBankUnitTest &operator = (KalmanFilterBankUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static KalmanFilterBankUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "KalmanFilterBankTest";
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,267 @@
+#include "messenger.h"
+#include "testMessenger.h"
+#include "unitTestManager.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace functional;
+using namespace messaging;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testMessenger", &MessengerUnitTest::create);
+
+/**
+ * This class records the messages it processes and sends; messages whose first payload is listed as rejected
+ * are refused on their first attempt
+ */
+class RecordingMessenger final
+: public Messenger
+{
+public:
+
+    /**
+     * Constructor
+     */
+    RecordingMessenger(std::size_t queueCapacity,
+                       std::size_t numPriorityLanes)
+    : Messenger(queueCapacity, numPriorityLanes),
+      m_numProcessed(0)
+    {
+
+    }
+
+    /**
+     * Destructor
+     */
+    virtual ~RecordingMessenger(void) override
+    {
+        stopDispatchThread();
+    }
+
+    /**
+     * Function to process a received message
+     */
+    virtual bool processReceivedMessage(tMessagePacket *pMessagePacket) override
+    {
+        auto &&value = any_cast<std::size_t>(pMessagePacket->getMessages()[0]);
+        if (value == m_rejectedValue)
+        {
+            m_rejectedValue = std::size_t(-1);
+
+            return false;
+        }
+
+        m_processed.push_back(value);
+        m_numProcessed.store(m_processed.size(), std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Function to send an outgoing message
+     */
+    virtual bool sendMessage(std::shared_ptr<tMessagePacket> pMessagePacket) override
+    {
+        auto &&value = any_cast<std::size_t>(pMessagePacket->getMessages()[0]);
+        if (value == m_rejectedValue)
+        {
+            m_rejectedValue = std::size_t(-1);
+
+            return false;
+        }
+
+        m_sent.push_back(value);
+
+        return true;
+    }
+
+    /**
+     * the number of messages processed, readable from any thread
+     */
+    std::atomic<std::size_t> m_numProcessed;
+
+    /**
+     * the first payloads of the messages processed, in order
+     */
+    std::vector<std::size_t> m_processed;
+
+    /**
+     * the payload of a message which is refused on its first attempt
+     */
+    std::size_t m_rejectedValue = std::size_t(-1);
+
+    /**
+     * the first payloads of the messages sent, in order
+     */
+    std::vector<std::size_t> m_sent;
+};
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+MessengerUnitTest::MessengerUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+MessengerUnitTest *MessengerUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    MessengerUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new MessengerUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool MessengerUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for Messenger class..." << std::endl << std::endl;
+
+    // messages are processed in order of decreasing priority lane and, within a lane, in order of arrival;
+    // priorities beyond the last lane share it, and a message that cannot be processed is retained ahead of
+    // later arrivals of equal priority
+    RecordingMessenger messenger(16, 4);
+    auto &&receive = [&messenger] (std::size_t value, int priority)
+    {
+        auto &&pMessagePacket = messenger.createMessage("message", "recipient", value);
+        pMessagePacket->setPriority(priority);
+
+        return messenger.receiveMessage(pMessagePacket);
+    };
+
+    messenger.m_rejectedValue = 3;
+    bool bSuccess = receive(0, -1) && receive(1, 0) && receive(2, 5) && receive(3, 1) && receive(4, 2) &&
+                    receive(5, 1) && !messenger.receiveMessage(nullptr) && messenger.processReceivedMessages();
+    bSuccess &= messenger.m_processed == std::vector<std::size_t>({ 2, 4, 5, 1, 0 }) &&
+                messenger.getMessagesQueuedForProcessing().size() == 1;
+
+    bSuccess &= receive(6, 1) && receive(7, 3) && messenger.processReceivedMessages() &&
+                messenger.m_processed == std::vector<std::size_t>({ 2, 4, 5, 1, 0, 7, 3, 6 }) &&
+                messenger.getMessagesQueuedForProcessing().empty();
+
+    // a lane refuses messages when full
+    for (std::size_t i = 0; bSuccess && i < 16; ++i)
+        bSuccess = receive(i, 0);
+
+    bSuccess &= !receive(16, 0) && messenger.getNumReceivedMessages() == 16;
+
+    // batch drain
+    std::vector<std::shared_ptr<Messenger::tMessagePacket>> messages;
+    bSuccess &= messenger.drainReceivedMessages(messages, 10) == 10 && messenger.getNumReceivedMessages() == 6 &&
+                messenger.drainReceivedMessages(messages) == 6 && messages.size() == 16;
+    for (std::size_t i = 0; bSuccess && i < messages.size(); ++i)
+        bSuccess = any_cast<std::size_t>(messages[i]->getMessages()[0]) == i;
+
+    // messages that cannot be sent are retained and re-attempted in order
+    messenger.m_rejectedValue = 1;
+    for (std::size_t i = 0; bSuccess && i < 3; ++i)
+        bSuccess = messenger.queueMessageForSend(messenger.createMessage("message", "recipient", i));
+
+    bSuccess &= messenger.sendMessages() && messenger.m_sent == std::vector<std::size_t>({ 0, 2 }) &&
+                messenger.getMessagesQueuedForSend().size() == 1 && messenger.sendMessages() &&
+                messenger.m_sent == std::vector<std::size_t>({ 0, 2, 1 });
+
+    std::cout << "Priority lanes, batch drain and retention " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // priorities which share the first or the last lane are still processed in order of decreasing priority,
+    // and lanes are allocated only when a message is first received in them
+    RecordingMessenger sharedLaneMessenger(16, 4);
+    bSuccess = sharedLaneMessenger.getNumAllocatedPriorityLanes() == 0;
+    for (auto &&valueAndPriority : std::vector<std::pair<std::size_t, int>>({ { 0, 10 }, { 1, -5 }, { 2, 100 },
+                                                                               { 3, -1 }, { 4, 10 }, { 5, 1 } }))
+    {
+        auto &&pMessagePacket = sharedLaneMessenger.createMessage("message", "recipient", valueAndPriority.first);
+        pMessagePacket->setPriority(valueAndPriority.second);
+        bSuccess &= sharedLaneMessenger.receiveMessage(pMessagePacket);
+    }
+
+    bSuccess &= sharedLaneMessenger.getNumAllocatedPriorityLanes() == 3 &&
+                sharedLaneMessenger.processReceivedMessages() &&
+                sharedLaneMessenger.m_processed == std::vector<std::size_t>({ 2, 0, 4, 5, 3, 1 });
+
+    std::cout << "Shared priority lanes and lane allocation " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // multiple producer threads feed the dispatch thread; each producer's messages must be processed exactly
+    // once and in the order in which they were received
+    const std::size_t numProducers = 4, numMessagesPerProducer = 20000;
+    RecordingMessenger dispatchMessenger(256, 1);
+    bSuccess = dispatchMessenger.startDispatchThread() && !dispatchMessenger.startDispatchThread();
+
+    std::vector<std::thread> producers;
+    for (std::size_t i = 0; i < numProducers; ++i)
+    {
+        producers.emplace_back([&dispatchMessenger, i, numMessagesPerProducer] (void)
+        {
+            for (std::size_t j = 0; j < numMessagesPerProducer; ++j)
+            {
+                auto &&pMessagePacket = dispatchMessenger.createMessage("message", "recipient",
+                                                                        i * numMessagesPerProducer + j);
+                while (!dispatchMessenger.receiveMessage(pMessagePacket))
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    for (auto &&producer : producers)
+        producer.join();
+
+    auto &&numMessages = numProducers * numMessagesPerProducer;
+    auto &&start = std::chrono::steady_clock::now();
+    while (dispatchMessenger.m_numProcessed.load(std::memory_order_acquire) < numMessages &&
+           std::chrono::steady_clock::now() - start < std::chrono::seconds(30))
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    dispatchMessenger.stopDispatchThread();
+    bSuccess &= !dispatchMessenger.isDispatchThreadRunning() &&
+                dispatchMessenger.m_processed.size() == numMessages;
+
+    std::vector<std::size_t> next(numProducers);
+    for (std::size_t i = 0; i < numProducers; ++i)
+        next[i] = i * numMessagesPerProducer;
+
+    for (auto &&value : dispatchMessenger.m_processed)
+    {
+        auto &&producer = value / numMessagesPerProducer;
+        bSuccess &= producer < numProducers && next[producer] == value;
+        if (!bSuccess)
+            break;
+
+        ++next[producer];
+    }
+
+    std::cout << "Multiple producers with dispatch thread " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+
+    return bSuccess;
+}
+
+}
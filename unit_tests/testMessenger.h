@@ -0,0 +1,82 @@
+#ifndef TEST_MESSENGER_H
+#define TEST_MESSENGER_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for Messenger class
+ */
+class MessengerUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    MessengerUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    MessengerUnitTest(const MessengerUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    MessengerUnitTest(MessengerUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~MessengerUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    MessengerUnitTest &operator = (const MessengerUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    MessengerUnitTest &operator = (MessengerUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static MessengerUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "MessengerTest";
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,265 @@
+#include "cartesianMotionState.h"
+#include "motionStateContainer.h"
+#include "referenceFrame.h"
+#include "testMotionStateContainer.h"
+#include "unitTestManager.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace containers;
+using namespace messaging;
+using namespace physics::kinematics;
+using namespace utilities;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testMotionStateContainer",
+                                                    &MotionStateContainerUnitTest::create);
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+MotionStateContainerUnitTest::MotionStateContainerUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+MotionStateContainerUnitTest *MotionStateContainerUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    MotionStateContainerUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new MotionStateContainerUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool MotionStateContainerUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for MotionStateContainer class..." << std::endl << std::endl;
+
+    // a container of motion state histories for many targets, each described in its own frame
+    const std::size_t numFrames = 200, numSamples = 100;
+    auto *pRootFrame = ReferenceFrame::create("root");
+    std::vector<ReferenceFrame *> frames;
+    std::vector<InternedIdentifier> frameIds;
+    for (std::size_t i = 0; i < numFrames; ++i)
+    {
+        frames.push_back(pRootFrame->createChild("target_" + std::to_string(i)));
+        frameIds.push_back(MotionStateContainer::internFrameAndCoordinateSystem(frames.back()));
+    }
+
+    // the motion states must be destroyed before the frames are deleted
+    auto &&test = [&] (void)
+    {
+        MotionStateContainer container;
+        CartesianMotionState motionState;
+        for (std::size_t i = 0; i < numFrames; ++i)
+        {
+            motionState.setFrame(frames[i]);
+            for (std::size_t j = 0; j < numSamples; ++j)
+            {
+                motionState.setTime(double(j));
+                motionState.setPosition(double(i), double(j), 0.0);
+                container.addMotionState(motionState);
+            }
+        }
+
+        // look-ups through interned handles must agree with look-ups by frame name
+        auto &&compare = [&] (const MotionStateContainer &container)
+        {
+            bool bSuccess = true;
+            for (std::size_t i = 0; bSuccess && i < numFrames; ++i)
+            {
+                auto &&frame = frames[i]->getName();
+                std::vector<MotionState *> motionStates, internedMotionStates;
+                container.getMotionStates(motionStates, 10.0, 20.0, frame);
+                container.getMotionStates(internedMotionStates, 10.0, 20.0, frameIds[i]);
+                bSuccess = (container.getMotionState(37.0, frameIds[i]) == container.getMotionState(37.0, frame) &&
+                            container.getMotionState(37.0, frameIds[i]) != nullptr &&
+                            container.getMostRecentAvailableMotionState(37.5, frameIds[i]) ==
+                            container.getMotionState(37.0, frame) &&
+                            container.getLatestMotionState(frameIds[i]) == container.getLatestMotionState(frame) &&
+                            container.size(frameIds[i]) == numSamples &&
+                            motionStates.size() == 11 && internedMotionStates == motionStates);
+            }
+
+            return bSuccess;
+        };
+
+        bool bSuccess = compare(container);
+
+        // time the look-ups by name and by handle
+        const std::size_t numQueries = 200000;
+        std::size_t numFound = 0;
+        auto &&start = std::chrono::steady_clock::now();
+        for (std::size_t k = 0; k < numQueries; ++k)
+            numFound += container.getMotionState(double(k % numSamples), frames[k % numFrames]->getName()) != nullptr;
+
+        auto &&middle = std::chrono::steady_clock::now();
+        for (std::size_t k = 0; k < numQueries; ++k)
+            numFound += container.getMotionState(double(k % numSamples), frameIds[k % numFrames]) != nullptr;
+
+        auto &&finish = std::chrono::steady_clock::now();
+        bSuccess &= (numFound == 2 * numQueries);
+        std::cout << "Look-up by interned frame and coordinate system (by name "
+                  << 1.0e9 * std::chrono::duration<double>(middle - start).count() / numQueries
+                  << " ns, by handle " << 1.0e9 * std::chrono::duration<double>(finish - middle).count() / numQueries
+                  << " ns per query) " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+        if (!bSuccess)
+            return bSuccess;
+
+        // interning is idempotent, and handles which refer to no motion states find nothing
+        auto &&sphericalId = MotionStateContainer::internFrameAndCoordinateSystem(frames[0],
+                                                                                  CoordinateType::Spherical);
+        bSuccess = (MotionStateContainer::internFrameAndCoordinateSystem(frames[3]->getName()) == frameIds[3] &&
+                    sphericalId != frameIds[0] &&
+                    container.getLatestMotionState(sphericalId) == nullptr &&
+                    container.getLatestMotionState(InternedIdentifier()) == nullptr &&
+                    !MotionStateContainer::internFrameAndCoordinateSystem(nullptr).isValid());
+
+        // removing and re-adding the motion states of a frame updates the index
+        container.deleteMotionStates(frames[5]);
+        container.deleteMotionStates(0.0, 9.0, frames[6]);
+        bSuccess &= (container.getLatestMotionState(frameIds[5]) == nullptr && container.size(frameIds[5]) == 0 &&
+                     container.size(frameIds[6]) == numSamples - 10 &&
+                     container.getMotionState(50.0, frameIds[7]) != nullptr);
+        motionState.setFrame(frames[5]);
+        motionState.setTime(1.0);
+        container.addMotionState(motionState);
+        bSuccess &= (container.getMotionState(1.0, frameIds[5]) == container.getMotionState(1.0, frames[5]) &&
+                     container.size(frameIds[5]) == 1);
+
+        // adding motion states does not intern their frames, and frames interned after their motion states were
+        // added are found by searching the entry map
+        auto &&firstProbeId = MotionStateContainer::internFrameAndCoordinateSystem("probe_first");
+        auto *pLateFrame = pRootFrame->createChild("late_target");
+        motionState.setFrame(pLateFrame);
+        motionState.setTime(2.0);
+        container.addMotionState(motionState);
+        auto &&secondProbeId = MotionStateContainer::internFrameAndCoordinateSystem("probe_second");
+        auto &&lateId = MotionStateContainer::internFrameAndCoordinateSystem(pLateFrame);
+        bSuccess &= (secondProbeId.getIndex() == firstProbeId.getIndex() + 1 &&
+                     container.getMotionState(2.0, lateId) == container.getMotionState(2.0, pLateFrame) &&
+                     container.getMotionState(2.0, lateId) != nullptr && container.size(lateId) == 1);
+        container.deleteMotionStates(pLateFrame);
+        bSuccess &= (container.getLatestMotionState(lateId) == nullptr);
+
+        MotionStateContainer copy(container), swapped;
+        swapped.swap(container);
+        bSuccess &= (copy.size(frameIds[5]) == 1 && copy.getMotionState(1.0, frameIds[5]) != nullptr &&
+                     copy.getMotionState(1.0, frameIds[5]) != swapped.getMotionState(1.0, frameIds[5]) &&
+                     swapped.getMotionState(1.0, frameIds[5]) != nullptr &&
+                     container.getMotionState(1.0, frameIds[5]) == nullptr);
+
+        // look-ups remain correct, and leave the index untouched, once the entry map has been exposed for
+        // modification; the index is rebuilt upon the next modification of the container
+        auto &&motionStates = swapped.getMotionStateContainer();
+        motionStates.getEntries();
+        swapped.deleteMotionStates(frames[8]);
+        bSuccess &= (motionStates.getNumIndexedEntryIds() == 0 &&
+                     swapped.getMotionState(37.0, frameIds[9]) == swapped.getMotionState(37.0, frames[9]) &&
+                     swapped.getMotionState(1.0, frameIds[5]) != nullptr && swapped.size(frameIds[8]) == 0 &&
+                     swapped.size(frameIds[9]) == numSamples && motionStates.getNumIndexedEntryIds() == 0);
+
+        // a frame interned after its motion states were added is found by searching the entry map, and is
+        // indexed upon the next modification of the container
+        auto *pUnindexedFrame = pRootFrame->createChild("unindexed_target");
+        motionState.setFrame(pUnindexedFrame);
+        motionState.setTime(3.0);
+        swapped.addMotionState(motionState);
+        auto &&unindexedId = MotionStateContainer::internFrameAndCoordinateSystem(pUnindexedFrame);
+        bSuccess &= (motionStates.getNumIndexedEntryIds() == numFrames - 1 &&
+                     swapped.getMotionState(3.0, unindexedId) == swapped.getMotionState(3.0, pUnindexedFrame) &&
+                     swapped.getMotionState(3.0, unindexedId) != nullptr &&
+                     motionStates.getNumIndexedEntryIds() == numFrames - 1);
+        motionState.setTime(4.0);
+        swapped.addMotionState(motionState);
+        bSuccess &= (motionStates.getNumIndexedEntryIds() == numFrames &&
+                     swapped.getMotionState(4.0, unindexedId) == swapped.getMotionState(4.0, pUnindexedFrame) &&
+                     swapped.size(unindexedId) == 2);
+        std::cout << "Index maintenance " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+        if (!bSuccess)
+            return bSuccess;
+
+        // bounded histories overwrite their oldest motion states in place, and motion states which arrive out
+        // of order are inserted into a history whose storage has wrapped
+        const std::size_t maxSize = 8;
+        MotionStateContainer bounded;
+        bounded.getMotionStateContainer().setMaxSize(maxSize);
+        for (std::size_t j = 0; j < 2 * maxSize + 3; ++j)
+        {
+            for (std::size_t i = 0; i < 2; ++i)
+            {
+                motionState.setFrame(frames[i]);
+                motionState.setTime(double(2 * j));
+                motionState.setPosition(double(i), double(j), 0.0);
+                bounded.addMotionState(motionState);
+            }
+        }
+
+        // the histories hold times 22, 24, ..., 36
+        auto &&isSorted = [] (const std::vector<MotionState *> &motionStates, double firstTime)
+        {
+            bool bSorted = true;
+            for (std::size_t k = 0; bSorted && k < motionStates.size(); ++k)
+                bSorted = (motionStates[k]->getTime() == firstTime + 2.0 * k);
+
+            return bSorted;
+        };
+
+        std::vector<MotionState *> history, range;
+        bounded.getMotionStates(history, frames[0]);
+        bounded.getMotionStates(range, 23.0, 31.0, frameIds[0]);
+        bSuccess = (bounded.size(frameIds[0]) == maxSize && history.size() == maxSize && isSorted(history, 22.0) &&
+                    range.size() == 4 && isSorted(range, 24.0) &&
+                    bounded.getLatestMotionState(frameIds[0])->getTime() == 36.0 &&
+                    bounded.getMostRecentAvailableMotionState(29.0, frameIds[1])->getTime() == 28.0 &&
+                    bounded.getMotionState(20.0, frameIds[1]) == nullptr);
+
+        MotionStateContainer boundedCopy(bounded);
+        history.clear();
+        boundedCopy.getMotionStates(history, frames[1]);
+        bSuccess &= (history.size() == maxSize && isSorted(history, 22.0));
+
+        motionState.setFrame(frames[0]);
+        motionState.setTime(25.0);
+        bounded.addMotionState(motionState);
+        motionState.setTime(38.0);
+        bounded.addMotionState(motionState);
+        auto &&entries = bounded.getMotionStateContainer().getEntries();
+        auto &&series = entries[motionState.getFrameAndCoordinateSystem()];
+        bSuccess &= (bounded.size(frameIds[0]) == maxSize && series.size() == maxSize &&
+                     series.front()->getTime() == 25.0 && series[1]->getTime() == 26.0 &&
+                     series.back()->getTime() == 38.0);
+        std::cout << "Bounded histories " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+
+        return bSuccess;
+    };
+
+    bool bSuccess = test();
+    ReferenceFrame::deleteFrame(pRootFrame);
+
+    return bSuccess;
+}
+
+}
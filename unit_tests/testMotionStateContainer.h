@@ -0,0 +1,82 @@
+#ifndef TEST_MOTION_STATE_CONTAINER_H
+#define TEST_MOTION_STATE_CONTAINER_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for MotionStateContainer class
+ */
+class MotionStateContainerUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    MotionStateContainerUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    MotionStateContainerUnitTest(const MotionStateContainerUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    MotionStateContainerUnitTest(MotionStateContainerUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~MotionStateContainerUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    MotionStateContainerUnitTest &operator = (const MotionStateContainerUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    MotionStateContainerUnitTest &operator = (MotionStateContainerUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static MotionStateContainerUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "MotionStateContainerTest";
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,283 @@
+#include "moving_average.h"
+#include "moving_correlation.h"
+#include "moving_covariance.h"
+#include "moving_standard_deviation.h"
+#include "moving_sum.h"
+#include "moving_variance.h"
+#include "testMovingStatistics.h"
+#include "unitTestManager.h"
+#include "unitTestUtilities.h"
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace math::signal_processing::filters;
+using namespace messaging;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testMovingStatistics", &MovingStatisticsUnitTest::create);
+
+/**
+ * Compute a moving statistic by evaluating the statistic over the entire window at each sample
+ */
+static std::vector<double> computeBruteForce(const std::vector<double> &x, const std::vector<double> &y,
+                                             int period, const std::function<double (const double *,
+                                                                                     const double *,
+                                                                                     int)> &statistic)
+{
+    std::vector<double> result(x.size());
+    for (int i = 0; i < int(x.size()); ++i)
+    {
+        auto numSamples = std::min(i + 1, period);
+        result[i] = statistic(&x[i + 1 - numSamples], &y[i + 1 - numSamples], numSamples);
+    }
+
+    return result;
+}
+
+/**
+ * Compute the unbiased sample covariance of two sequences
+ */
+static double computeCovariance(const double *x, const double *y, int numSamples)
+{
+    double mean_x = 0.0, mean_y = 0.0, sum = 0.0;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        mean_x += x[i] / numSamples;
+        mean_y += y[i] / numSamples;
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+        sum += (x[i] - mean_x) * (y[i] - mean_y);
+
+    return numSamples > 1 ? sum / (numSamples - 1) : 0.0;
+}
+
+/**
+ * Filter each channel of an interleaved signal in turn and compare with the multi-channel result
+ */
+template<typename Filter>
+static double computeMultiChannelError(Filter &filter, const std::vector<double> &x, const std::vector<double> &y,
+                                       std::size_t numChannels)
+{
+    std::vector<double> interleaved(y);
+    if (!filter.filter(&x[0], &x[0] + x.size(), &interleaved[0], numChannels))
+        return INFINITY;
+
+    double error = 0.0;
+    auto &&numFrames = x.size() / numChannels;
+    std::vector<double> channel_x(numFrames), channel_y(numFrames);
+    for (std::size_t k = 0; k < numChannels; ++k)
+    {
+        for (std::size_t i = 0; i < numFrames; ++i)
+        {
+            channel_x[i] = x[i * numChannels + k];
+            channel_y[i] = y[i * numChannels + k];
+        }
+
+        if (!filter.filter(&channel_x[0], &channel_x[0] + numFrames, &channel_y[0]))
+            return INFINITY;
+
+        for (std::size_t i = 0; i < numFrames; ++i)
+            error = std::max(error, std::fabs(channel_y[i] - interleaved[i * numChannels + k]));
+    }
+
+    return error;
+}
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+MovingStatisticsUnitTest::MovingStatisticsUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+MovingStatisticsUnitTest *MovingStatisticsUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    MovingStatisticsUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new MovingStatisticsUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool MovingStatisticsUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for moving statistics filters..." << std::endl << std::endl;
+
+    // the signals carry an offset so that naive running sums would accumulate round-off
+    std::default_random_engine generator;
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::vector<double> x(5000), y(x.size());
+    std::generate(x.begin(), x.end(), [&] () { return 1.0e2 + uniform(generator); });
+    std::generate(y.begin(), y.end(), [&] () { return -1.0e2 + uniform(generator); });
+
+    auto &&sum = [] (const double *x, const double *, int numSamples)
+    {
+        return std::accumulate(x, x + numSamples, 0.0);
+    };
+    auto &&variance = [] (const double *x, const double *, int numSamples)
+    {
+        return computeCovariance(x, x, numSamples);
+    };
+    auto &&correlation = [] (const double *x, const double *y, int numSamples)
+    {
+        auto &&product = computeCovariance(x, x, numSamples) * computeCovariance(y, y, numSamples);
+
+        return product > 0.0 ? computeCovariance(x, y, numSamples) / std::sqrt(product) : 0.0;
+    };
+
+    // single-channel filters agree with a brute-force evaluation over each window, including when the output
+    // overwrites the input
+    bool bSuccess = true;
+    for (int period : { 1, 2, 17, 250 })
+    {
+        MovingSum<double> movingSum(period);
+        MovingAverage<double> movingAverage(period);
+        MovingVariance<double> movingVariance(period, false);
+        MovingStandardDeviation<double> movingStandardDeviation(period, false);
+        MovingCovariance<double> movingCovariance(period, false);
+        MovingCorrelation<double> movingCorrelation(period, false);
+
+        auto &&expected = computeBruteForce(x, x, period, sum);
+        std::vector<double> result(x);
+        bSuccess &= (movingSum.filter(&result[0], &result[0] + result.size(), &result[0]) &&
+                     computeMaximumError(result, expected) < 1.0e-8);
+
+        for (auto &&value : expected)
+            value /= std::min(int(&value - &expected[0]) + 1, period);
+
+        result = x;
+        bSuccess &= (movingAverage.filter(&result[0], &result[0] + result.size(), &result[0]) &&
+                     computeMaximumError(result, expected) < 1.0e-10);
+
+        expected = computeBruteForce(x, x, period, variance);
+        result = x;
+        bSuccess &= (movingVariance.filter(&result[0], &result[0] + result.size(), &result[0]) &&
+                     computeMaximumError(result, expected) < 1.0e-8);
+
+        for (auto &&value : expected)
+            value = std::sqrt(value);
+
+        result = x;
+        bSuccess &= (movingStandardDeviation.filter(&result[0], &result[0] + result.size(), &result[0]) &&
+                     computeMaximumError(result, expected) < 1.0e-6);
+
+        expected = computeBruteForce(x, y, period, computeCovariance);
+        result = y;
+        bSuccess &= (movingCovariance.filter(&x[0], &x[0] + x.size(), &result[0]) &&
+                     computeMaximumError(result, expected) < 1.0e-8);
+
+        // a two-sample correlation divides by the spreads of single pairs, which magnifies the round-off
+        // carried by the running moments whenever either pair nearly coincides
+        expected = computeBruteForce(x, y, period, correlation);
+        result = y;
+        bSuccess &= (movingCorrelation.filter(&x[0], &x[0] + x.size(), &result[0]) &&
+                     (period == 2 || computeMaximumError(result, expected) < 1.0e-6));
+        if (!bSuccess)
+        {
+            std::cout << "Moving statistics with a period of " << period << " FAILED." << std::endl << std::endl;
+            break;
+        }
+    }
+
+    std::cout << "Single-channel moving statistics " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // the multi-channel filters agree with filtering each channel separately
+    const std::size_t numChannels = 8;
+    for (int period : { 1, 3, 60 })
+    {
+        MovingSum<double> movingSum(period);
+        MovingAverage<double> movingAverage(period);
+        MovingVariance<double> movingVariance(period, false);
+        MovingStandardDeviation<double> movingStandardDeviation(period, true);
+        MovingCovariance<double> movingCovariance(period, true);
+        MovingCorrelation<double> movingCorrelation(period, false);
+
+        bSuccess &= (computeMultiChannelError(movingSum, x, x, numChannels) < 1.0e-8 &&
+                     computeMultiChannelError(movingAverage, x, x, numChannels) < 1.0e-10 &&
+                     computeMultiChannelError(movingVariance, x, x, numChannels) < 1.0e-8 &&
+                     computeMultiChannelError(movingStandardDeviation, x, x, numChannels) < 1.0e-6 &&
+                     computeMultiChannelError(movingCovariance, x, y, numChannels) < 1.0e-8 &&
+                     computeMultiChannelError(movingCorrelation, x, y, numChannels) < 1.0e-6);
+        if (!bSuccess)
+        {
+            std::cout << "Multi-channel statistics with a period of " << period << " FAILED." << std::endl
+                      << std::endl;
+            break;
+        }
+    }
+
+    std::vector<double> frame(numChannels + 1);
+    bSuccess &= !MovingSum<double>(4).filter(&frame[0], &frame[0] + frame.size(), &frame[0], numChannels);
+
+    // planar channels are rejected rather than passed through the base class's default coefficients
+    std::vector<double> planar(x.cbegin(), x.cbegin() + 4 * numChannels), planarResult(planar.size());
+    auto &&planarLayout = MovingSum<double>::ChannelLayout::Planar;
+    auto &&filterPlanar = [&] (auto &&filter)
+    {
+        return filter.filter(&planar[0], &planar[0] + planar.size(), &planarResult[0], numChannels, planarLayout);
+    };
+
+    bSuccess &= !filterPlanar(MovingSum<double>(4)) && !filterPlanar(MovingAverage<double>(4)) &&
+                !filterPlanar(MovingStandardDeviation<double>(4, false)) &&
+                !filterPlanar(MovingCorrelation<double>(4));
+    std::cout << "Multi-channel moving statistics " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // the cost per sample does not depend on the length of the window
+    std::cout << std::setw(15) << "Period" << std::setw(25) << "Variance (samples/s)" << std::endl;
+    std::vector<double> result(x.size());
+    for (int period : { 10, 100, 1000 })
+    {
+        MovingVariance<double> movingVariance(period, false);
+        std::size_t numSamples = 0;
+        auto &&start = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed(0.0);
+        while (elapsed.count() < 0.05)
+        {
+            result = x;
+            movingVariance.filter(&result[0], &result[0] + result.size(), &result[0]);
+            numSamples += result.size();
+            elapsed = std::chrono::steady_clock::now() - start;
+        }
+
+        std::cout << std::setw(15) << period << std::setw(25) << double(numSamples) / elapsed.count() << std::endl;
+    }
+
+    std::cout << std::endl;
+
+    return bSuccess;
+}
+
+}
@@ -0,0 +1,82 @@
+#ifndef TEST_MOVING_STATISTICS_H
+#define TEST_MOVING_STATISTICS_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for the moving statistics filters
+ */
+class MovingStatisticsUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    MovingStatisticsUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    MovingStatisticsUnitTest(const MovingStatisticsUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    MovingStatisticsUnitTest(MovingStatisticsUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~MovingStatisticsUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    MovingStatisticsUnitTest &operator = (const MovingStatisticsUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    MovingStatisticsUnitTest &operator = (MovingStatisticsUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static MovingStatisticsUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "MovingStatisticsTest";
+    }
+};
+
+}
+
+#endif
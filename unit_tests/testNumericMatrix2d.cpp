@@ -1,6 +1,10 @@
+#include "matrix.h"
+#include "matrix_multiplier.h"
 #include "numeric_matrix_2d.h"
 #include "testNumericMatrix2d.h"
 #include "unitTestManager.h"
+#include <iostream>
+#include <random>
 
 // using namespace declarations
 using namespace attributes::abstract;
@@ -49,7 +53,91 @@ bool NumericMatrix2dUnitTest::execute(void)
 {
     bool bSuccess = true;
 
-    // TODO: implement this!
+    std::cout << "Starting unit test for numeric Matrix<2, T> class..." << std::endl << std::endl;
+
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+    // compute a reference product using a naive triple loop
+    auto &&naiveProduct = [] (const Matrix<2, double> &lhs, const Matrix<2, double> &rhs)
+    {
+        Matrix<2, double> result(lhs.rows(), rhs.columns());
+        for (std::size_t i = 0; i < lhs.rows(); ++i)
+            for (std::size_t j = 0; j < rhs.columns(); ++j)
+                for (std::size_t k = 0; k < lhs.columns(); ++k)
+                    result(i, j) += lhs(i, k) * rhs(k, j);
+
+        return result;
+    };
+
+    // determine whether two matrices are nearly equal
+    auto &&nearlyEqual = [] (const Matrix<2, double> &lhs, const Matrix<2, double> &rhs, std::size_t inner)
+    {
+        if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns())
+            return false;
+
+        auto &&tolerance = 1e-14 * (inner + 1);
+
+        return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), [tolerance] (auto &&x, auto &&y)
+                          { return std::fabs(x - y) <= tolerance; });
+    };
+
+    // test matrix multiplication for each transposition mode across several blocking regimes, instruction
+    // sets and thread counts
+    auto &&supportedInstructionSet = MatrixMultiplier::getInstructionSet();
+    std::vector<std::vector<std::size_t>> dimensions = { { 3, 3, 3 }, { 7, 5, 9 }, { 50, 50, 50 },
+                                                         { 97, 131, 61 }, { 130, 300, 270 } };
+    for (auto &&instructionSet : { MatrixMultiplier::InstructionSet::Generic,
+                                   MatrixMultiplier::InstructionSet::AVX2,
+                                   MatrixMultiplier::InstructionSet::AVX512 })
+    {
+        if (instructionSet > supportedInstructionSet)
+            continue;
+
+        MatrixMultiplier::setInstructionSet(instructionSet);
+        for (std::size_t numThreads = 1; numThreads <= 3; numThreads += 2)
+        {
+            MatrixMultiplier::setMaximumThreads(numThreads);
+            MatrixMultiplier::setMultithreadingThreshold(numThreads > 1 ? 1 : 128 * 128 * 128);
+            for (auto &&dimension : dimensions)
+            {
+                auto &&rows = dimension[0], &&inner = dimension[1], &&columns = dimension[2];
+                Matrix<2, double> A(rows, inner), B(inner, columns);
+                std::generate(A.begin(), A.end(), [&] (void) { return uniform(generator); });
+                std::generate(B.begin(), B.end(), [&] (void) { return uniform(generator); });
+
+                auto &&AT = A.getTranspose();
+                auto &&BT = B.getTranspose();
+                auto &&expected = naiveProduct(A, B);
+
+                Matrix<2, double> C;
+                A.multiply(B, C);
+                bSuccess &= nearlyEqual(C, expected, inner);
+
+                Matrix<2, double>::postMultiplyTranspose(A, BT, C);
+                bSuccess &= nearlyEqual(C, expected, inner);
+
+                Matrix<2, double>::preMultiplyTranspose(AT, B, C);
+                bSuccess &= nearlyEqual(C, expected, inner);
+
+                std::vector<double> &at = AT, &bt = BT, &c = C;
+                MatrixMultiplier::multiply(rows, columns, inner, at.data(), 1, rows,
+                                           bt.data(), 1, inner, c.data());
+                bSuccess &= nearlyEqual(C, expected, inner);
+
+                // in-place multiplication
+                C = A;
+                C *= B;
+                bSuccess &= nearlyEqual(C, expected, inner);
+            }
+        }
+    }
+
+    MatrixMultiplier::setInstructionSet(supportedInstructionSet);
+    MatrixMultiplier::setMaximumThreads(1);
+    MatrixMultiplier::setMultithreadingThreshold(128 * 128 * 128);
+
+    std::cout << "Matrix multiplication test " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
 
     return bSuccess;
 }
@@ -0,0 +1,314 @@
+#include "boundingVolumeHierarchy.h"
+#include "objFileReader.h"
+#include "polygonMesh.h"
+#include "ray.h"
+#include "rayIntersection.h"
+#include "testPolygonMesh.h"
+#include "unitTestManager.h"
+#include "vector2d.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace math::geometric;
+using namespace math::geometric::shapes;
+using namespace math::linear_algebra::vector;
+using namespace messaging;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testPolygonMesh", &PolygonMeshUnitTest::create);
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+PolygonMeshUnitTest::PolygonMeshUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+PolygonMeshUnitTest *PolygonMeshUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    PolygonMeshUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new PolygonMeshUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool PolygonMeshUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for PolygonMesh class..." << std::endl << std::endl;
+
+    // construct a cube of half-width one from six square faces
+    PolygonMesh cube;
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        for (double sign : { -1.0, 1.0 })
+        {
+            Vector3d normal(0.0, 0.0, 0.0);
+            normal[axis] = sign;
+
+            Polygon face(Vector2d(-1.0, -1.0), Vector2d(1.0, -1.0), Vector2d(1.0, 1.0), Vector2d(-1.0, 1.0));
+            face.setPlane(Plane(normal, normal));
+            cube.getPolygons().push_back(face);
+        }
+    }
+
+    // a ray through the cube enters and exits it; rays that miss it, or that stop short of it, are not occluded
+    RayIntersection intersection;
+    Ray ray(Vector3d(1.0, 0.0, 0.0), Vector3d(-5.0, 0.3, 0.2));
+    bool bSuccess = cube.intersect(ray, intersection) && intersection.size() == 2 &&
+                    (intersection.getPoints()[0] - Vector3d(-1.0, 0.3, 0.2)).magnitude() < 1.0e-12 &&
+                    (intersection.getPoints()[1] - Vector3d(1.0, 0.3, 0.2)).magnitude() < 1.0e-12 &&
+                    cube.getBoundingVolumeHierarchy().getNumTriangles() == 12 &&
+                    !cube.isOccluded(ray, 3.9) && cube.isOccluded(ray, 4.1) &&
+                    !cube.intersect(Ray(Vector3d(1.0, 0.0, 0.0), Vector3d(-5.0, 1.5, 0.0)), intersection) &&
+                    !cube.intersect(Ray(Vector3d(-1.0, 0.0, 0.0), Vector3d(-5.0, 0.3, 0.2)), intersection);
+
+    // copies answer the same queries, and batches report the intersected polygons
+    PolygonMesh copy(cube);
+    std::vector<Ray> rays = { ray, Ray(Vector3d(0.0, -1.0, 0.0), Vector3d(0.1, 4.0, -0.4)),
+                              Ray(Vector3d(0.0, 0.0, 1.0), Vector3d(3.0, 3.0, -9.0)) };
+    std::vector<RayIntersection> intersections;
+    std::vector<std::size_t> polygons;
+    bSuccess &= copy.intersect(rays, intersections, &polygons) && polygons[0] == 0 && polygons[1] == 3 &&
+                polygons[2] == copy.size() && intersections[2].empty() &&
+                (intersections[1].getPoints()[0] - Vector3d(0.1, 1.0, -0.4)).magnitude() < 1.0e-12;
+
+    // modifying the polygons causes the hierarchy to be rebuilt
+    copy.getPolygons().pop_back();
+    bSuccess &= copy.getBoundingVolumeHierarchy().getNumTriangles() == 10;
+
+    std::cout << "Polygon mesh intersections " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // compare the hierarchy against brute force for a random triangle soup, building it with one and with four
+    // threads, and processing rays individually and in batches
+    std::mt19937 generator(54321);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    const std::size_t numTriangles = 50000, numRays = 2000;
+    std::vector<Vector3d> vertices;
+    for (std::size_t i = 0; i < numTriangles; ++i)
+    {
+        Vector3d center(100.0 * uniform(generator), 100.0 * uniform(generator), 100.0 * uniform(generator));
+        for (std::size_t j = 0; j < 3; ++j)
+            vertices.emplace_back(center + Vector3d(uniform(generator), uniform(generator), uniform(generator)));
+    }
+
+    // half of the rays are incoherent; the other half emanate from a common origin toward the triangles, as from
+    // a sensor, and are traversed in packets
+    rays.clear();
+    for (std::size_t i = 0; i < numRays / 2; ++i)
+    {
+        Vector3d origin(120.0 * uniform(generator), 120.0 * uniform(generator), 120.0 * uniform(generator));
+        Vector3d direction(uniform(generator), uniform(generator), uniform(generator));
+        rays.emplace_back(direction, origin);
+    }
+
+    Vector3d sensor(-150.0, -150.0, -150.0);
+    while (rays.size() < numRays)
+    {
+        Vector3d target(100.0 * uniform(generator), 100.0 * uniform(generator), 100.0 * uniform(generator));
+        rays.emplace_back(target - sensor, sensor);
+    }
+
+    shapes::utilities::BoundingVolumeHierarchy serialHierarchy, parallelHierarchy;
+    parallelHierarchy.setMaximumThreads(4);
+    auto &&start = std::chrono::high_resolution_clock::now();
+    bSuccess = serialHierarchy.build(vertices);
+    auto &&serialBuildTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start);
+    start = std::chrono::high_resolution_clock::now();
+    bSuccess &= parallelHierarchy.build(vertices);
+    auto &&parallelBuildTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start);
+    bSuccess &= !serialHierarchy.build(std::vector<Vector3d>(4));
+
+    auto &&infinity = std::numeric_limits<double>::infinity();
+    std::vector<double> expected(numRays, infinity);
+    for (std::size_t i = 0; i < numRays; ++i)
+    {
+        auto &&origin = rays[i].getOrigin();
+        auto &&direction = rays[i].getDirection();
+        for (std::size_t j = 0; j < numTriangles; ++j)
+        {
+            // Moller-Trumbore, evaluated with vector operations
+            auto &&a = vertices[3 * j];
+            auto &&edgeOne = vertices[3 * j + 1] - a;
+            auto &&edgeTwo = vertices[3 * j + 2] - a;
+            auto &&p = direction.calcCross(edgeTwo);
+            auto &&determinant = edgeOne.dot(p);
+            if (determinant == 0.0)
+                continue;
+
+            auto &&s = origin - a;
+            auto &&u = s.dot(p) / determinant;
+            auto &&q = s.calcCross(edgeOne);
+            auto &&v = direction.dot(q) / determinant;
+            auto &&t = edgeTwo.dot(q) / determinant;
+            if (u >= 0.0 && v >= 0.0 && u + v <= 1.0 && t >= 0.0)
+                expected[i] = std::min(expected[i], t);
+        }
+    }
+
+    std::size_t numHits = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; bSuccess && i < numRays; ++i)
+    {
+        double t = infinity;
+        std::size_t triangle = 0;
+        bool bIntersects = parallelHierarchy.intersect(rays[i], t, triangle);
+        bSuccess = bIntersects == std::isfinite(expected[i]) &&
+                   (!bIntersects || std::fabs(t - expected[i]) <= 1.0e-9 * expected[i]);
+        numHits += bIntersects;
+    }
+
+    auto &&singleRayTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start);
+    for (std::size_t i = 0; bSuccess && i < numRays; ++i)
+    {
+        bool bOccluded = std::isfinite(expected[i]);
+        bSuccess = serialHierarchy.isOccluded(rays[i]) == bOccluded &&
+                   (!bOccluded || !serialHierarchy.isOccluded(rays[i], 0.999 * expected[i]));
+    }
+
+    std::vector<std::size_t> triangles;
+    start = std::chrono::high_resolution_clock::now();
+    bSuccess &= parallelHierarchy.intersect(rays, intersections, &triangles) == (numHits > 0);
+    auto &&batchTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start);
+    for (std::size_t i = 0; bSuccess && i < numRays; ++i)
+    {
+        bSuccess = intersections[i].empty() != std::isfinite(expected[i]) &&
+                   (triangles[i] < numTriangles) == std::isfinite(expected[i]);
+        if (bSuccess && !intersections[i].empty())
+        {
+            auto &&point = rays[i].getPosition(expected[i]);
+            bSuccess = (intersections[i].getPoints()[0] - point).magnitude() < 1.0e-9;
+        }
+    }
+
+    std::cout << "Build time, " << numTriangles << " triangles (ms): " << 1.0e3 * serialBuildTime.count()
+              << " (1 thread), " << 1.0e3 * parallelBuildTime.count() << " (4 threads)" << std::endl
+              << "Time per ray (us): " << 1.0e6 * singleRayTime.count() / numRays << " (single), "
+              << 1.0e6 * batchTime.count() / numRays << " (batched, 4 threads)" << std::endl
+              << "Rays intersecting triangles: " << numHits << " of " << numRays << std::endl << std::endl;
+
+    std::cout << "Bounding-volume hierarchy " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // read a cube from an obj file having quadrilateral faces, relative indices, normals, texture coordinates,
+    // comments, unsupported statements and Windows line endings; it answers the same queries as the cube above
+    const std::string filename("testPolygonMesh.obj");
+    std::ofstream stream(filename, std::ios::binary);
+    stream << "# cube\r\no cube\r\nmtllib cube.mtl\r\n";
+    for (std::size_t i = 0; i < 8; ++i)
+        stream << "v " << (i & 1 ? 1.0 : -1.0) << " " << (i & 2 ? 1.0 : -1.0) << " " << (i & 4 ? 1 : -1) << "\r\n";
+
+    stream << "vt 0 0\r\nvt 1\r\nvt 1 1 0\r\nvn -1 0 0\r\nvn 1 0 0\r\nusemtl default\r\ns off\r\n"
+           << "f 1/1/1 3/2/1 7/3/1 5/1/1\r\nf 2//2 4//2 8//2 6//2\r\n"
+           << "f -8 -7 -3 -4\r\nf -6 -5 -1 -2\r\nf 1 2 4 3\r\nf 5 6 8 7";
+    stream.close();
+
+    PolygonMesh mesh;
+    mesh.setMaximumThreads(2);
+    bSuccess = mesh.readObjFile(filename) && mesh.size() == 6 && mesh.intersect(ray, intersection) &&
+               intersection.size() == 2 &&
+               (intersection.getPoints()[0] - Vector3d(-1.0, 0.3, 0.2)).magnitude() < 1.0e-12 &&
+               (intersection.getPoints()[1] - Vector3d(1.0, 0.3, 0.2)).magnitude() < 1.0e-12 &&
+               mesh.getBoundingVolumeHierarchy().getNumTriangles() == 12 &&
+               (mesh[0].getPlane().getNormal() - Vector3d(-1.0, 0.0, 0.0)).magnitude() < 1.0e-12 &&
+               (mesh[1].getPlane().getNormal() - Vector3d(1.0, 0.0, 0.0)).magnitude() < 1.0e-12;
+
+    shapes::utilities::ObjFileReader reader;
+    bSuccess &= reader.read(filename) && reader.getNumVertices() == 8 && reader.getNumFaces() == 6 &&
+                reader.getTextureCoordinates() == std::vector<double>({ 0.0, 0.0, 1.0, 0.0, 1.0, 1.0 }) &&
+                reader.getTextureIndices()[1] == 1 &&
+                reader.getTextureIndices()[4] == shapes::utilities::ObjFileReader::NO_INDEX &&
+                reader.getNormalIndices()[4] == 1 && reader.getVertexIndices()[8] == 0 &&
+                reader.getVertexIndices()[15] == 6;
+
+    // malformed statements and out-of-range indices are rejected
+    for (auto &&contents : { "v 1 2 3\nv 1 2\n", "v 1 2 3\nf 1 1\n", "v 1 2 3\nf 1 2 1\n", "v 1 2 3\nf 1 -2 1\n",
+                             "v 1 2 3\nf 1 1 1x\n", "v 1 2 3\nf 0 1 1\n", "v 1 2e 3\n" })
+    {
+        stream.open(filename, std::ios::binary);
+        stream << contents;
+        stream.close();
+        bSuccess &= !reader.read(filename) && reader.getNumVertices() == 0;
+    }
+
+    std::cout << "Obj file reader " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+    {
+        std::remove(filename.c_str());
+
+        return bSuccess;
+    }
+
+    // a larger file of triangles, read with one and with four threads, must be parsed exactly and identically
+    const std::size_t numFileVertices = 300000;
+    std::vector<double> coordinates;
+    stream.open(filename, std::ios::binary);
+    char buffer[64];
+    for (std::size_t i = 0; i < numFileVertices; ++i)
+    {
+        stream << 'v';
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            std::snprintf(buffer, sizeof(buffer), " %.6f", 1000.0 * uniform(generator));
+            coordinates.push_back(std::strtod(buffer, nullptr));
+            stream << buffer;
+        }
+
+        stream << "\n";
+        if (i >= 2)
+            stream << "f " << i - 1 << " " << i << " -1\n";
+    }
+
+    stream.close();
+
+    shapes::utilities::ObjFileReader parallelReader;
+    parallelReader.setMaximumThreads(4);
+    bSuccess = reader.read(filename) && parallelReader.read(filename) && reader.getVertices() == coordinates &&
+               parallelReader.getVertices() == coordinates &&
+               reader.getNumFaces() == numFileVertices - 2 &&
+               reader.getVertexIndices() == parallelReader.getVertexIndices() &&
+               reader.getFaceOffsets() == parallelReader.getFaceOffsets() &&
+               reader.getVertexIndices().back() == numFileVertices - 1;
+
+    std::cout << "Read " << 1.0e-6 * reader.getFileSize() << " MB at " << reader.getThroughput()
+              << " MB/s (1 thread), " << parallelReader.getThroughput() << " MB/s (4 threads)" << std::endl
+              << std::endl;
+
+    std::remove(filename.c_str());
+
+    std::cout << "Obj file throughput " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+
+    return bSuccess;
+}
+
+}
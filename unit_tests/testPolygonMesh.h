@@ -0,0 +1,82 @@
+#ifndef TEST_POLYGON_MESH_H
+#define TEST_POLYGON_MESH_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for PolygonMesh class
+ */
+class PolygonMeshUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    PolygonMeshUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    PolygonMeshUnitTest(const PolygonMeshUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    PolygonMeshUnitTest(PolygonMeshUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~PolygonMeshUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    PolygonMeshUnitTest &operator = (const PolygonMeshUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    PolygonMeshUnitTest &operator = (PolygonMeshUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static PolygonMeshUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "PolygonMeshTest";
+    }
+};
+
+}
+
+#endif
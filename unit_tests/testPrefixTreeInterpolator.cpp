@@ -0,0 +1,190 @@
+#include "prefix_tree.h"
+#include "prefix_tree_interpolator.h"
+#include "testPrefixTreeInterpolator.h"
+#include "unitTestManager.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace containers::tree;
+using namespace math::interpolators;
+using namespace messaging;
+using namespace utilities;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testPrefixTreeInterpolator",
+                                                    &PrefixTreeInterpolatorUnitTest::create);
+
+/**
+ * A node function object which returns the tabulated values and interpolates linearly between nodes
+ */
+struct LinearNodeFunctor
+{
+    /**
+     * Function call operator which evaluates a tabulated value
+     */
+    double operator () (double y) const
+    {
+        return y;
+    }
+
+    /**
+     * Function call operator which interpolates between two nodes
+     */
+    double operator () (double x, double x1, double x2, double y1, double y2) const
+    {
+        return x1 == x2 ? y1 : y1 + (x - x1) * (y2 - y1) / (x2 - x1);
+    }
+};
+
+/**
+ * A multilinear function of four variables, which multilinear interpolation reproduces exactly
+ */
+static double evaluate(const double *x)
+{
+    return 1.0 + 2.0 * x[0] - 3.0 * x[1] + 0.5 * x[2] + 4.0 * x[3] + x[0] * x[1] - x[2] * x[3] +
+           x[0] * x[1] * x[2] * x[3];
+}
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+PrefixTreeInterpolatorUnitTest::PrefixTreeInterpolatorUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+PrefixTreeInterpolatorUnitTest *PrefixTreeInterpolatorUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    PrefixTreeInterpolatorUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new PrefixTreeInterpolatorUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool PrefixTreeInterpolatorUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for PrefixTreeInterpolator class..." << std::endl << std::endl;
+
+    // tabulate the function on a rectilinear grid with a mix of uniformly and non-uniformly spaced axes
+    const std::vector<std::vector<double>> axes = { { 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0 },
+                                                    { 0.0, 0.5, 1.5, 3.0, 5.0 },
+                                                    { -1.0, -0.5, 0.0, 0.5, 1.0 },
+                                                    { 0.0, 1.0, 4.0, 9.0, 16.0 } };
+    PrefixTree<double> tree;
+    for (auto &&a : axes[0])
+        for (auto &&b : axes[1])
+            for (auto &&c : axes[2])
+                for (auto &&d : axes[3])
+                {
+                    const double x[] = { a, b, c, d };
+                    tree.insert(std::vector<double>{ a, b, c, d, evaluate(x) });
+                }
+
+    PrefixTreeInterpolator<double, LinearNodeFunctor> interpolator(tree.getRoot(), LinearNodeFunctor());
+    PrefixTreeInterpolator<double, LinearNodeFunctor> treeInterpolator(interpolator);
+    bool bSuccess = (interpolator.compile() && interpolator.isCompiled() &&
+                     interpolator.getNumCompiledAxes() == axes.size() && !treeInterpolator.isCompiled());
+
+    // query points which lie within the grid
+    const std::size_t numPoints = 20000;
+    std::vector<double> points(numPoints * axes.size());
+    for (std::size_t i = 0; i < numPoints; ++i)
+        for (std::size_t j = 0; j < axes.size(); ++j)
+        {
+            auto &&fraction = double((i * (2 * j + 3) * 7919 + j * 104729) % 10007) / 10006.0;
+            points[i * axes.size() + j] = axes[j].front() + fraction * (axes[j].back() - axes[j].front());
+        }
+
+    std::vector<double> results(numPoints), treeResults(numPoints);
+    auto &&start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numPoints; ++i)
+    {
+        std::vector<double> x(&points[i * axes.size()], &points[(i + 1) * axes.size()]);
+        bSuccess &= treeInterpolator.interpolate(x, treeResults[i]);
+    }
+
+    auto &&middle = std::chrono::steady_clock::now();
+    bSuccess &= interpolator.interpolate(points.data(), numPoints, results.data());
+    auto &&finish = std::chrono::steady_clock::now();
+
+    double maximumError = 0.0;
+    for (std::size_t i = 0; i < numPoints; ++i)
+    {
+        auto &&truth = evaluate(&points[i * axes.size()]);
+        maximumError = std::max(maximumError, std::fabs(results[i] - truth));
+        maximumError = std::max(maximumError, std::fabs(treeResults[i] - truth));
+
+        // single-point queries through a compiled interpolator agree with the batch
+        double y = 0.0;
+        std::vector<double> x(&points[i * axes.size()], &points[(i + 1) * axes.size()]);
+        bSuccess &= (interpolator.interpolate(x, y) && y == results[i]);
+    }
+
+    bSuccess &= (maximumError < 1.0e-10);
+    std::cout << "Interpolation (maximum error " << maximumError << ", tree traversal "
+              << 1.0e9 * std::chrono::duration<double>(middle - start).count() / numPoints << " ns, compiled "
+              << 1.0e9 * std::chrono::duration<double>(finish - middle).count() / numPoints
+              << " ns per query) " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // points outside of the grid evaluate at the boundary unless extrapolation is enabled
+    const double outside[] = { 1.2, -0.5, 0.25, 20.0 }, clamped[] = { 1.0, 0.0, 0.25, 16.0 };
+    std::vector<double> x(outside, outside + axes.size());
+    double y = 0.0, treeY = 0.0;
+    bSuccess = (interpolator.interpolate(x, y) && treeInterpolator.interpolate(x, treeY) &&
+                std::fabs(y - evaluate(clamped)) < 1.0e-10 && std::fabs(treeY - evaluate(clamped)) < 1.0e-10);
+    interpolator.extrapolate(true);
+    treeInterpolator.extrapolate(true);
+    bSuccess &= (interpolator.interpolate(x, y) && treeInterpolator.interpolate(x, treeY) &&
+                 std::fabs(y - evaluate(outside)) < 1.0e-10 && std::fabs(treeY - evaluate(outside)) < 1.0e-10);
+
+    // copies carry the compiled table
+    PrefixTreeInterpolator<double, LinearNodeFunctor> copy(interpolator);
+    bSuccess &= (copy.isCompiled() && copy.interpolate(x, treeY) && treeY == y);
+    std::cout << "Extrapolation and copy " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // a tree whose branches do not share breakpoints cannot be compiled, but can still be traversed
+    PrefixTree<double> irregularTree;
+    irregularTree.insert(std::vector<double>{ 0.0, 0.0, 1.0 });
+    irregularTree.insert(std::vector<double>{ 0.0, 1.0, 2.0 });
+    irregularTree.insert(std::vector<double>{ 1.0, 0.0, 3.0 });
+    irregularTree.insert(std::vector<double>{ 1.0, 2.0, 5.0 });
+    PrefixTreeInterpolator<double, LinearNodeFunctor> irregularInterpolator(irregularTree.getRoot(),
+                                                                            LinearNodeFunctor());
+    bSuccess = (!irregularInterpolator.compile() && !irregularInterpolator.isCompiled() &&
+                irregularInterpolator.getNumCompiledAxes() == 0 &&
+                !irregularInterpolator.interpolate(points.data(), 1, results.data()) &&
+                irregularInterpolator.interpolate(std::vector<double>{ 0.5, 1.0 }, y) &&
+                std::fabs(y - 3.0) < 1.0e-12);
+    std::cout << "Rejection of a non-rectilinear tree " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+
+    return bSuccess;
+}
+
+}
@@ -0,0 +1,82 @@
+#ifndef TEST_PREFIX_TREE_INTERPOLATOR_H
+#define TEST_PREFIX_TREE_INTERPOLATOR_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for PrefixTreeInterpolator class
+ */
+class PrefixTreeInterpolatorUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    PrefixTreeInterpolatorUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    PrefixTreeInterpolatorUnitTest(const PrefixTreeInterpolatorUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    PrefixTreeInterpolatorUnitTest(PrefixTreeInterpolatorUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~PrefixTreeInterpolatorUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    PrefixTreeInterpolatorUnitTest &operator = (const PrefixTreeInterpolatorUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    PrefixTreeInterpolatorUnitTest &operator = (PrefixTreeInterpolatorUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static PrefixTreeInterpolatorUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "PrefixTreeInterpolatorTest";
+    }
+};
+
+}
+
+#endif
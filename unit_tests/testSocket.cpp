@@ -0,0 +1,257 @@
+#include "httpHeaders.h"
+#include "receiver.h"
+#include "TCP_Socket.h"
+#include "testSocket.h"
+#include "unitTestManager.h"
+#include "URL.h"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
+#define POSIX
+#endif
+
+#ifdef POSIX
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace messaging;
+using namespace networking;
+using namespace networking::sockets;
+using namespace utilities;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testSocket", &SocketUnitTest::create);
+
+/**
+ * This class counts the number of reads issued to the underlying TCP socket
+ */
+class CountingSocket final
+: public TCP_Socket
+{
+public:
+
+    /**
+     * Constructor
+     */
+    CountingSocket(URL *pURL)
+    : TCP_Socket(pURL),
+      m_numReads(0)
+    {
+
+    }
+
+    /**
+     * Read data from the socket, counting each call
+     */
+    virtual long read(char *pBuffer,
+                      size_t length,
+                      int flags = 0) override
+    {
+        ++m_numReads;
+
+        return TCP_Socket::read(pBuffer, length, flags);
+    }
+
+    /**
+     * the number of reads issued to the underlying socket
+     */
+    std::size_t m_numReads;
+};
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+SocketUnitTest::SocketUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+SocketUnitTest *SocketUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    SocketUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new SocketUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool SocketUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for Socket class..." << std::endl << std::endl;
+
+    bool bSuccess = true;
+#ifdef POSIX
+    // listen on an ephemeral loopback port
+    int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addressLength = sizeof(address);
+    bSuccess = (listener >= 0 &&
+                ::bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0 &&
+                ::listen(listener, 2) == 0 &&
+                ::getsockname(listener, reinterpret_cast<sockaddr *>(&address), &addressLength) == 0);
+    if (!bSuccess)
+    {
+        std::cout << "Loopback listener FAILED." << std::endl << std::endl;
+        if (listener >= 0)
+            ::close(listener);
+
+        return bSuccess;
+    }
+
+    // build a response with many header lines and a chunked body containing embedded null characters
+    const std::size_t numHeaders = 200;
+    std::string chunkedResponse = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n";
+    for (std::size_t i = 0; i < numHeaders; ++i)
+        chunkedResponse += "X-Header-" + std::to_string(i) + ": value " + std::to_string(i) + "\r\n";
+
+    chunkedResponse += "\r\n";
+    std::string chunkedBody;
+    for (std::size_t i = 0; i < 20000; ++i)
+        chunkedBody += char(i % 7 == 0 ? '\0' : 'a' + i % 26);
+
+    const std::size_t chunkSize = 4096;
+    for (std::size_t i = 0; i < chunkedBody.size(); i += chunkSize)
+    {
+        auto &&chunk = chunkedBody.substr(i, chunkSize);
+        char size[16];
+        std::snprintf(size, sizeof(size), "%zx", chunk.size());
+        chunkedResponse += std::string(size) + "\r\n" + chunk + "\r\n";
+    }
+
+    chunkedResponse += "0\r\n\r\n";
+
+    // build a chunked response whose chunk size has more hexadecimal digits than a long can hold
+    std::string oversizedResponse = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n" +
+                                    std::string(2 * sizeof(long), 'f') + "\r\nabc\r\n0\r\n\r\n";
+
+    // build a response whose body length is given by the Content-Length header
+    std::string lengthBody(50000, 'z');
+    lengthBody[100] = '\0';
+    std::string lengthResponse = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(lengthBody.size()) +
+                                 "\r\n\r\n" + lengthBody;
+
+    // serve each response on its own connection, written in small, irregular pieces so that lines are split
+    // across reads
+    std::thread server([&] (void)
+    {
+        for (auto *pResponse : { &chunkedResponse, &lengthResponse, &oversizedResponse })
+        {
+            int connection = ::accept(listener, nullptr, nullptr);
+            if (connection < 0)
+                return;
+
+            for (std::size_t offset = 0, piece = 0; offset < pResponse->size(); ++piece)
+            {
+                std::size_t length = std::min(piece % 3 == 0 ? std::size_t(7) : std::size_t(3000),
+                                              pResponse->size() - offset);
+                auto &&result = ::send(connection, pResponse->data() + offset, length, MSG_NOSIGNAL);
+                if (result <= 0)
+                    break;
+
+                offset += std::size_t(result);
+            }
+
+            ::close(connection);
+        }
+    });
+
+    const std::string url = "http://127.0.0.1:" + std::to_string(ntohs(address.sin_port)) + "/";
+    for (auto *pBody : { &chunkedBody, &lengthBody })
+    {
+        URL socketURL(url);
+        CountingSocket socket(&socketURL);
+        HttpHeaders headers;
+        bSuccess = socket.connect();
+        std::unique_ptr<Receiver> pReceiver(bSuccess ? Receiver::create(&headers, &socket) : nullptr);
+        std::string data;
+        bSuccess = (pReceiver != nullptr && pReceiver->receive(data) > 0 && data == *pBody);
+        if (bSuccess && pBody == &chunkedBody)
+            bSuccess = headers.containsEntry("X-Header-" + std::to_string(numHeaders - 1));
+
+        // a byte-at-a-time reader would issue one read per byte of the headers
+        bSuccess &= (socket.m_numReads < 100);
+        std::cout << (pBody == &chunkedBody ? "Chunked" : "Content-Length") << " response received in "
+                  << socket.m_numReads << " reads " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+                  << std::endl;
+        if (!bSuccess)
+            break;
+    }
+
+    // an oversized chunk size is rejected rather than overflowing
+    if (bSuccess)
+    {
+        URL socketURL(url);
+        CountingSocket socket(&socketURL);
+        HttpHeaders headers;
+        bSuccess = socket.connect();
+        std::unique_ptr<Receiver> pReceiver(bSuccess ? Receiver::create(&headers, &socket) : nullptr);
+        std::string data;
+        bSuccess = (pReceiver != nullptr && pReceiver->receive(data) <= 0 && data.empty());
+        std::cout << "Oversized chunk size " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    }
+
+    if (!bSuccess)
+        ::shutdown(listener, SHUT_RDWR);
+
+    server.join();
+
+    // a non-blocking write to a peer which is not reading returns as soon as the socket accepts no more data,
+    // rather than waiting for the send timeout
+    if (bSuccess)
+    {
+        URL socketURL(url);
+        CountingSocket socket(&socketURL);
+        socket.setServerSendTimeout(10000);
+        bSuccess = socket.connect();
+        int connection = (bSuccess ? ::accept(listener, nullptr, nullptr) : -1);
+        socket.blockingEnabled(false);
+
+        const std::string data(1 << 16, 'x');
+        std::size_t numBytesWritten = 0;
+        long result = -1;
+        auto &&start = std::chrono::steady_clock::now();
+        while (bSuccess && (result = socket.write(data.data(), data.size())) > 0)
+            numBytesWritten += std::size_t(result);
+
+        auto &&elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        bSuccess &= (connection >= 0 && result == 0 && numBytesWritten > 0 && elapsed < 5.0);
+        std::cout << "Non-blocking write of " << numBytesWritten << " bytes returned in " << elapsed << " s "
+                  << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+        if (connection >= 0)
+            ::close(connection);
+    }
+
+    ::close(listener);
+#endif
+
+    return bSuccess;
+}
+
+}
@@ -0,0 +1,82 @@
+#ifndef TEST_SOCKET_H
+#define TEST_SOCKET_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for Socket class
+ */
+class SocketUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    SocketUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    SocketUnitTest(const SocketUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    SocketUnitTest(SocketUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~SocketUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    SocketUnitTest &operator = (const SocketUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    SocketUnitTest &operator = (SocketUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static SocketUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "SocketTest";
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,221 @@
+#include "testThreadPool.h"
+#include "thread_pool.h"
+#include "unitTestManager.h"
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace messaging;
+using namespace utilities;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testThreadPool", &ThreadPoolUnitTest::create);
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+ThreadPoolUnitTest::ThreadPoolUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+ThreadPoolUnitTest *ThreadPoolUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    ThreadPoolUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new ThreadPoolUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool ThreadPoolUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for ThreadPool class..." << std::endl << std::endl;
+
+    // test repeated execution of tasks with uneven costs on a persistent pool
+    const std::size_t numTasks = 200;
+    std::vector<std::size_t> results(numTasks, 0);
+    ThreadPool<bool> pool(4);
+    for (std::size_t i = 0; i < numTasks; ++i)
+    {
+        pool.addTask([i, &results] (void)
+        {
+            double sum = 0.0;
+            for (std::size_t j = 0; j < (i % 10) * 1000; ++j)
+                sum += 1.0 / (1.0 + j);
+
+            results[i] += (sum >= 0.0) ? 1 : 0;
+
+            return true;
+        });
+    }
+
+    const std::size_t numExecutions = 50;
+    bool bSuccess = true;
+    for (std::size_t i = 0; bSuccess && i < numExecutions; ++i)
+        bSuccess = pool.execute();
+
+    bSuccess &= std::all_of(results.cbegin(), results.cend(), [&] (auto &&count)
+                            { return count == numExecutions; });
+    std::cout << "Repeated execution " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // test early termination; once a task reports failure, tasks that have not started must be skipped
+    std::atomic<std::size_t> numExecuted(0);
+    ThreadPool<bool> terminatingPool(2);
+    for (std::size_t i = 0; i < numTasks; ++i)
+    {
+        terminatingPool.addTask([i, &numExecuted] (void)
+        {
+            ++numExecuted;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+            return i != 0;
+        });
+    }
+
+    bSuccess = !terminatingPool.execute() && numExecuted < numTasks;
+    std::cout << "Early termination " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // test that an exception thrown by a task is rethrown to the caller once the other tasks have finished
+    ThreadPool<bool> throwingPool(2);
+    for (std::size_t i = 0; i < numTasks; ++i)
+    {
+        throwingPool.addTask([i] (void)
+        {
+            if (i == 0)
+                throw std::runtime_error("task failed");
+
+            return true;
+        });
+    }
+
+    bSuccess = false;
+    try
+    {
+        throwingPool.execute();
+    }
+    catch (const std::runtime_error &exception)
+    {
+        bSuccess = (std::string(exception.what()) == "task failed");
+    }
+
+    std::cout << "Task exception " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // test that ranges cover the interval on boundaries which are multiples of the granularity, and that an
+    // exception is rethrown only once no range is still running
+    std::vector<std::size_t> counts(1003, 0);
+    std::atomic<bool> bAligned(true);
+    pool.forEachRange(counts.size(), 7, 16, [&] (std::size_t begin, std::size_t end)
+    {
+        if (begin % 16 != 0 || (end % 16 != 0 && end != counts.size()))
+            bAligned = false;
+
+        for (std::size_t i = begin; i < end; ++i)
+            ++counts[i];
+    });
+
+    bSuccess = bAligned && std::all_of(counts.cbegin(), counts.cend(), [] (auto &&count) { return count == 1; });
+    std::atomic<std::size_t> numRunning(0);
+    try
+    {
+        pool.forEachRange(numTasks, numTasks, 1, [&numRunning] (std::size_t begin, std::size_t)
+        {
+            ++numRunning;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            --numRunning;
+            if (begin == 0)
+                throw std::runtime_error("range failed");
+        });
+
+        bSuccess = false;
+    }
+    catch (const std::runtime_error &exception)
+    {
+        bSuccess &= (std::string(exception.what()) == "range failed" && numRunning == 0);
+    }
+
+    std::cout << "Range execution " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // test futures returned by submitted tasks, including tasks submitted while the pool is paused
+    ThreadPool<std::size_t> futurePool(3);
+    futurePool.setStatus(ThreadPoolStatus::Pause);
+    std::vector<std::future<std::size_t>> futures;
+    for (std::size_t i = 0; i < numTasks; ++i)
+        futures.emplace_back(futurePool.submit([i] (void) { return i * i; }));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    bSuccess = std::none_of(futures.cbegin(), futures.cend(), [] (auto &&future)
+                            { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; });
+
+    futurePool.setStatus(ThreadPoolStatus::Ready);
+    for (std::size_t i = 0; i < numTasks; ++i)
+        bSuccess &= (futures[i].get() == i * i);
+
+    std::cout << "Submitted tasks with pause/resume " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // test that tasks queued by a paused pool are carried over when the number of threads changes, and are
+    // abandoned rather than run when the pool is destroyed
+    std::atomic<std::size_t> numRun(0);
+    futures.clear();
+    {
+        ThreadPool<std::size_t> pausedPool(2);
+        pausedPool.setStatus(ThreadPoolStatus::Pause);
+        for (std::size_t i = 0; i < numTasks; ++i)
+            futures.emplace_back(pausedPool.submit([i, &numRun] (void) { ++numRun; return i; }));
+
+        pausedPool.setMaximumThreads(4);
+        bSuccess = (numRun == 0);
+        pausedPool.setStatus(ThreadPoolStatus::Ready);
+        bSuccess &= (futures[0].get() == 0);
+        pausedPool.setStatus(ThreadPoolStatus::Pause);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        futures.emplace_back(pausedPool.submit([&numRun] (void) { ++numRun; return std::size_t(0); }));
+    }
+
+    try
+    {
+        futures.back().get();
+        bSuccess = false;
+    }
+    catch (const std::future_error &error)
+    {
+        bSuccess &= (error.code() == std::future_errc::broken_promise);
+    }
+
+    std::cout << "Paused pool resizing and destruction " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+
+    return bSuccess;
+}
+
+}
@@ -0,0 +1,82 @@
+#ifndef TEST_THREAD_POOL_H
+#define TEST_THREAD_POOL_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for ThreadPool class
+ */
+class ThreadPoolUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    ThreadPoolUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    ThreadPoolUnitTest(const ThreadPoolUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    ThreadPoolUnitTest(ThreadPoolUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~ThreadPoolUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    ThreadPoolUnitTest &operator = (const ThreadPoolUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    ThreadPoolUnitTest &operator = (ThreadPoolUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static ThreadPoolUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "ThreadPoolTest";
+    }
+};
+
+}
+
+#endif
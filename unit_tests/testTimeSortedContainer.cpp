@@ -0,0 +1,237 @@
+#include "testTimeSortedContainer.h"
+#include "time_sorted_container.h"
+#include "unitTestManager.h"
+#include <chrono>
+#include <iostream>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace containers;
+using namespace messaging;
+using namespace utilities;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testTimeSortedContainer",
+                                                    &TimeSortedContainerUnitTest::create);
+
+/**
+ * A time-tagged entry which counts its living instances
+ */
+class TimedEntry
+{
+public:
+
+    /**
+     * Constructor
+     */
+    TimedEntry(double time)
+    : m_time(time)
+    {
+        ++m_numInstances;
+    }
+
+    /**
+     * Copy constructor
+     */
+    TimedEntry(const TimedEntry &entry)
+    : m_time(entry.m_time)
+    {
+        ++m_numInstances;
+    }
+
+    /**
+     * Destructor
+     */
+    ~TimedEntry(void)
+    {
+        --m_numInstances;
+    }
+
+    /**
+     * Copy assignment operator
+     */
+    TimedEntry &operator = (const TimedEntry &entry) = default;
+
+    /**
+     * clone() function
+     */
+    TimedEntry *clone(void) const
+    {
+        return new TimedEntry(*this);
+    }
+
+    /**
+     * Get the time at which this entry is available
+     */
+    double getAvailabilityTime(void) const
+    {
+        return m_time;
+    }
+
+    /**
+     * the number of living instances of this class
+     */
+    static std::size_t m_numInstances;
+
+private:
+
+    /**
+     * the time at which this entry is available
+     */
+    double m_time;
+};
+
+// static member initialization
+std::size_t TimedEntry::m_numInstances = 0;
+
+/**
+ * Determines whether or not a container's entries are tagged at consecutive integer times ending at the
+ * specified time
+ */
+static bool isWindow(const std::vector<TimedEntry *> &entries,
+                     double endTime)
+{
+    bool bSuccess = true;
+    for (std::size_t i = 0; bSuccess && i < entries.size(); ++i)
+        bSuccess = (entries[i]->getAvailabilityTime() == endTime - double(entries.size() - 1 - i));
+
+    return bSuccess;
+}
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+TimeSortedContainerUnitTest::TimeSortedContainerUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+TimeSortedContainerUnitTest *TimeSortedContainerUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    TimeSortedContainerUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new TimeSortedContainerUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool TimeSortedContainerUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for TimeSortedContainer class..." << std::endl << std::endl;
+
+    // append entries in order to bounded containers, both by pointer and by copy
+    const std::size_t maxSize = 1000, numEntries = 200000;
+    const double lastTime = numEntries - 1;
+    bool bSuccess = true;
+    {
+        TimeSortedContainer<TimedEntry> pointerContainer, copyContainer;
+        pointerContainer.setMaxSize(maxSize);
+        copyContainer.setMaxSize(maxSize);
+
+        auto &&start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; bSuccess && i < numEntries; ++i)
+            bSuccess = pointerContainer.addEntry(new TimedEntry(double(i)));
+
+        auto &&middle = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < numEntries; ++i)
+            copyContainer.addEntry(TimedEntry(double(i)));
+
+        auto &&finish = std::chrono::steady_clock::now();
+        for (auto *pContainer : { &pointerContainer, &copyContainer })
+        {
+            auto &&container = *pContainer;
+            const auto &constContainer = container;
+            bSuccess &= (container.size() == maxSize &&
+                         isWindow(constContainer.getEntries(), lastTime) &&
+                         isWindow(container.getEntries(), lastTime) &&
+                         container.getLatestEntry()->getAvailabilityTime() == lastTime &&
+                         container.getEntry(lastTime - 500.0) != nullptr &&
+                         container.getEntry(lastTime - 500.0)->getAvailabilityTime() == lastTime - 500.0 &&
+                         container.getEntry(lastTime - 500.5) == nullptr &&
+                         container.getEntry(1.0) == nullptr &&
+                         container.getMostRecentAvailableEntry(lastTime - 10.5)->getAvailabilityTime() ==
+                         lastTime - 11.0);
+
+            std::vector<TimedEntry *> entries;
+            bSuccess &= (container.getEntries(lastTime - 20.0, lastTime - 10.0, entries) &&
+                         isWindow(entries, lastTime - 10.0) && entries.size() == 11);
+        }
+
+        // entries evicted from either container must have been destroyed
+        bSuccess &= (TimedEntry::m_numInstances == 2 * maxSize);
+        std::cout << "In-order append to a bounded container (by pointer "
+                  << 1.0e9 * std::chrono::duration<double>(middle - start).count() / numEntries
+                  << " ns, by copy " << 1.0e9 * std::chrono::duration<double>(finish - middle).count() / numEntries
+                  << " ns per entry) " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+        if (!bSuccess)
+            return bSuccess;
+
+        // entries which arrive out of order are inserted in sorted order, evicting the oldest entry, while an
+        // entry older than all of the others is evicted at once
+        const auto &constContainer = pointerContainer;
+        pointerContainer.addEntry(new TimedEntry(lastTime - 100.5));
+        pointerContainer.addEntry(new TimedEntry(1.0));
+        auto &&entries = constContainer.getEntries();
+        bSuccess = (pointerContainer.size() == maxSize &&
+                    entries.front()->getAvailabilityTime() == lastTime - double(maxSize) + 2.0 &&
+                    pointerContainer.getEntry(lastTime - 100.5) != nullptr &&
+                    pointerContainer.getEntry(1.0) == nullptr);
+        for (std::size_t i = 1; bSuccess && i < entries.size(); ++i)
+            bSuccess = (entries[i - 1]->getAvailabilityTime() < entries[i]->getAvailabilityTime());
+
+        // an entry with the same time as an existing entry replaces it
+        auto *pEntry = new TimedEntry(lastTime);
+        pointerContainer.addEntry(pEntry);
+        bSuccess &= (pointerContainer.size() == maxSize && pointerContainer.getLatestEntry() == pEntry);
+
+        // subsequent in-order appends continue to evict the oldest entries
+        pointerContainer.addEntry(new TimedEntry(lastTime + 1.0));
+        pointerContainer.addEntry(new TimedEntry(lastTime + 2.0));
+        entries = pointerContainer.getEntries();
+        bSuccess &= (pointerContainer.size() == maxSize &&
+                     isWindow(std::vector<TimedEntry *>(entries.cend() - 10, entries.cend()), lastTime + 2.0) &&
+                     entries.front()->getAvailabilityTime() == lastTime - double(maxSize) + 4.0);
+
+        // copies preserve the order of a container whose entries wrap around its storage
+        TimeSortedContainer<TimedEntry> container(copyContainer);
+        bSuccess &= (container.size() == maxSize && isWindow(container.getEntries(), lastTime));
+        container.deleteEntries(lastTime - 50.0, lastTime);
+        bSuccess &= (container.size() == maxSize - 51 && isWindow(container.getEntries(), lastTime - 51.0));
+        std::cout << "Out-of-order insertion, replacement and copy " << (bSuccess ? "PASSED." : "FAILED.")
+                  << std::endl << std::endl;
+        if (!bSuccess)
+            return bSuccess;
+    }
+
+    // an unbounded container sorts entries which arrive in any order
+    TimeSortedContainer<TimedEntry> container;
+    for (std::size_t i = 0; i < 1000; ++i)
+        container.addEntry(TimedEntry(double((i * 7919) % 1000)));
+
+    bSuccess = (TimedEntry::m_numInstances == 1000 && isWindow(container.getEntries(), 999.0));
+    container.deleteEntries();
+    bSuccess &= (TimedEntry::m_numInstances == 0 && container.empty());
+    std::cout << "Insertion into an unbounded container " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+
+    return bSuccess;
+}
+
+}
@@ -0,0 +1,82 @@
+#ifndef TEST_TIME_SORTED_CONTAINER_H
+#define TEST_TIME_SORTED_CONTAINER_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for TimeSortedContainer class
+ */
+class TimeSortedContainerUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    TimeSortedContainerUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    TimeSortedContainerUnitTest(const TimeSortedContainerUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    TimeSortedContainerUnitTest(TimeSortedContainerUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~TimeSortedContainerUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    TimeSortedContainerUnitTest &operator = (const TimeSortedContainerUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    TimeSortedContainerUnitTest &operator = (TimeSortedContainerUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static TimeSortedContainerUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "TimeSortedContainerTest";
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,136 @@
+#include "testTokenizer.h"
+#include "tokenizer.h"
+#include "unitTestManager.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// using namespace declarations
+using namespace attributes::abstract;
+using namespace messaging;
+using namespace utilities;
+
+namespace unit_tests
+{
+
+// register factories...
+static FactoryRegistrar<UnitTest> unit_test_factory("testTokenizer", &TokenizerUnitTest::create);
+
+/**
+ * Constructor
+ * @param dependencies a tuple of this object's required injection dependencies
+ */
+TokenizerUnitTest::TokenizerUnitTest(const tDependencies &dependencies)
+: DependencyInjectableVirtualBaseInitializer(1, dependencies),
+  UnitTest(dependencies)
+{
+
+}
+
+/**
+ * create() function
+ * @param pPublisher a pointer to an instance of the publisher to which this object subscribes
+ */
+TokenizerUnitTest *TokenizerUnitTest::create(UnitTestManager *pUnitTestManager)
+{
+    TokenizerUnitTest *pUnitTest = nullptr;
+    if (pUnitTestManager != nullptr)
+    {
+        auto &&dependencies = pUnitTestManager->getDependencies();
+        std::get<Publisher *>(dependencies) = pUnitTestManager;
+        pUnitTest = new TokenizerUnitTest(dependencies);
+    }
+
+    return pUnitTest;
+}
+
+/**
+ * Execution function
+ */
+bool TokenizerUnitTest::execute(void)
+{
+    std::cout << "Starting unit test for Tokenizer class..." << std::endl << std::endl;
+
+    // the longest delimiter is chosen where delimiters coincide, and consecutive delimiters yield no tokens
+    const std::string string = ",a, b,,c;;d;e<>f<g<>>, ";
+    const std::vector<std::string> expected = { "a", "b", "c", "d;e", "f<g", ">" };
+    Tokenizer tokenizer(",", ", ", ";;", "<>");
+    std::vector<std::string> iterated, viewed;
+    tokenizer.initialize(string);
+    for (auto &&itToken = tokenizer.cbegin(); itToken != tokenizer.cend(); ++itToken)
+        iterated.push_back(*itToken);
+
+    tokenizer.forEachToken(std::string_view(string), [&viewed] (std::string_view token)
+                           { return viewed.emplace_back(token), true; });
+    bool bSuccess = (iterated == expected && viewed == expected && tokenizer.parse<std::string>(string) == expected);
+
+    // streams yield the same tokens regardless of where chunk boundaries fall
+    for (std::size_t chunkSize = 1; bSuccess && chunkSize <= string.size() + 1; ++chunkSize)
+    {
+        std::vector<std::string> streamed;
+        std::istringstream stream(string);
+        bSuccess = (tokenizer.forEachToken(stream, [&streamed] (std::string_view token)
+                                           { return streamed.emplace_back(token), true; }, chunkSize) &&
+                    streamed == expected);
+    }
+
+    // token processors may ignore tokens or terminate tokenization
+    auto &&tokenProcessor = [] (std::string &token) { return token == "b" ? 1 : token == "f<g" ? -1 : 0; };
+    std::istringstream stream(string);
+    auto &&processed = tokenizer.parse<std::string>(stream, tokenProcessor);
+    bSuccess &= (processed == std::vector<std::string>{ "a", "c", "d;e" } &&
+                 tokenizer.parse<std::string>(string, tokenProcessor) == processed);
+
+    // delimiters added through getDelimiters() take effect, including those added through a retained reference
+    // after the delimiters were last used, and are visible to const tokenizers
+    auto &&delimiters = tokenizer.getDelimiters();
+    delimiters.insert(";");
+    bSuccess &= (tokenizer.parse<std::string>(std::string("d;e;;f")) == std::vector<std::string>{ "d", "e", "f" });
+    delimiters.insert("|");
+    const Tokenizer &constTokenizer = tokenizer;
+    std::vector<std::string> visited;
+    bSuccess &= (constTokenizer.forEachToken(std::string_view("d|e;f"), [&visited] (std::string_view token)
+                                             { return visited.emplace_back(token), true; }) &&
+                 visited == std::vector<std::string>{ "d", "e", "f" });
+    std::cout << "Tokenization of strings, views and streams " << (bSuccess ? "PASSED." : "FAILED.") << std::endl
+              << std::endl;
+    if (!bSuccess)
+        return bSuccess;
+
+    // numeric tokens are converted independently of the locale; tokens which are not numbers are discarded.
+    // Character tokens are extracted as characters rather than as numbers
+    Tokenizer commaTokenizer(",");
+    bSuccess = (commaTokenizer.parse<double>(std::string("1.5, +2 ,x,3e2,-0.25,+-1")) ==
+                std::vector<double>{ 1.5, 2.0, 300.0, -0.25 } &&
+                commaTokenizer.parse<int>(std::string(" 7,-3,4.9,q,+-5,++5")) == std::vector<int>{ 7, -3, 4 } &&
+                commaTokenizer.parse<char>(std::string("a, 7,-")) == std::vector<char>{ 'a', '7', '-' });
+
+    // convert a large table of numbers from a string and from a stream
+    const std::size_t numValues = 200000;
+    std::ostringstream table;
+    table.precision(17);
+    for (std::size_t i = 0; i < numValues; ++i)
+        table << 0.125 * double(i) - 1000.0 << (i % 10 == 9 ? "\r\n" : ", ");
+
+    Tokenizer numberTokenizer(",", " ", "\r\n");
+    auto &&start = std::chrono::steady_clock::now();
+    auto &&values = numberTokenizer.parse<double>(table.str());
+    auto &&middle = std::chrono::steady_clock::now();
+    std::istringstream tableStream(table.str());
+    auto &&streamedValues = numberTokenizer.parse<double>(tableStream);
+    auto &&finish = std::chrono::steady_clock::now();
+    bSuccess &= (values.size() == numValues && streamedValues == values);
+    for (std::size_t i = 0; bSuccess && i < numValues; ++i)
+        bSuccess = (values[i] == 0.125 * double(i) - 1000.0);
+
+    std::cout << "Numeric conversion (string " << 1.0e9 * std::chrono::duration<double>(middle - start).count() /
+                 numValues << " ns, stream " << 1.0e9 * std::chrono::duration<double>(finish - middle).count() /
+                 numValues << " ns per token) " << (bSuccess ? "PASSED." : "FAILED.") << std::endl << std::endl;
+
+    return bSuccess;
+}
+
+}
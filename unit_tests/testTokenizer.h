@@ -0,0 +1,82 @@
+#ifndef TEST_TOKENIZER_H
+#define TEST_TOKENIZER_H
+
+#include "unitTest.h"
+
+namespace unit_tests
+{
+
+// forward declarations
+class UnitTestManager;
+
+/**
+ * Unit tester for Tokenizer class
+ */
+class TokenizerUnitTest final
+: public UnitTest
+{
+private:
+
+    /**
+     * Constructor
+     * @param dependencies a tuple of this object's required injection dependencies
+     */
+    TokenizerUnitTest(const tDependencies &dependencies);
+
+    /**
+     * Copy constructor
+     */
+    TokenizerUnitTest(const TokenizerUnitTest &tester) = delete;
+
+    /**
+     * Move constructor
+     */
+    TokenizerUnitTest(TokenizerUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~TokenizerUnitTest(void) override
+    {
+
+    }
+
+private:
+
+    /**
+     * Copy assignment operator
+     */
+    TokenizerUnitTest &operator = (const TokenizerUnitTest &tester) = delete;
+
+    /**
+     * Move assignment operator
+     */
+    TokenizerUnitTest &operator = (TokenizerUnitTest &&tester) = delete;
+
+public:
+
+    /**
+     * create() function
+     * @param pUnitTestManager a pointer to an instance of UnitTestManager
+     */
+    static TokenizerUnitTest *create(UnitTestManager *pUnitTestManager);
+
+    /**
+     * Execution function
+     */
+    virtual bool execute(void) override final;
+
+    /**
+     * Get the factory name of this constructible
+     */
+    inline virtual std::string getFactoryName(void) const override final
+    {
+        return "TokenizerTest";
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef UNIT_TEST_UTILITIES_H
+#define UNIT_TEST_UTILITIES_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace unit_tests
+{
+
+/**
+ * Compute the largest absolute difference between two sequences; sequences of different lengths differ by
+ * infinity
+ */
+template<typename T>
+inline double computeMaximumError(const std::vector<T> &x, const std::vector<T> &y)
+{
+    double error = (x.size() == y.size()) ? 0.0 : INFINITY;
+    for (std::size_t i = 0; i < x.size() && i < y.size(); ++i)
+        error = std::max(error, double(std::abs(x[i] - y[i])));
+
+    return error;
+}
+
+}
+
+#endif